@@ -0,0 +1,44 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: compile_basis.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// Converts a JSON basis-set file into the indexed format read by BasisLibrary (run at build time).
+
+#include <iostream>
+#include <src/util/input/basisformat.h>
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "usage: " << argv[0] << " basis.json basis.bbs" << std::endl;
+    return 1;
+  }
+  try {
+    boost::property_tree::ptree basis;
+    boost::property_tree::json_parser::read_json(argv[1], basis);
+    bagel::basis_format::write(basis, argv[2]);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
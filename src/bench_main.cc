@@ -0,0 +1,100 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: bench_main.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Stand-alone benchmarks of computational kernels; built by "make check" next to the TestSuite.
+//
+//   Benchmark [-o out.json] [-l lmax] [-t seconds] [-b batch]...
+//
+// "-b" selects a section (an integral batch type such as "eri" or "nai", "eripost" or "roots"); by default all are run.
+// Timings of the integral batches are written to the JSON file for comparison between builds.
+
+#include <fstream>
+#include <src/global.h>
+
+using namespace std;
+using namespace bagel;
+
+#include <src/benchimpl/bench_eripost.cc>
+#include <src/benchimpl/bench_integral.cc>
+#include <src/benchimpl/bench_roots.cc>
+
+int main(int argc, char** argv) {
+  static_variables();
+
+  string output = "benchmark.json";
+  int lmax = 4;
+  double min_time = 0.02;
+  vector<string> sections;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      const string opt = argv[i];
+      if (i+1 == argc)
+        throw runtime_error("missing argument for " + opt);
+      if (opt == "-o")
+        output = argv[++i];
+      else if (opt == "-l")
+        lmax = stoi(argv[++i]);
+      else if (opt == "-t")
+        min_time = stod(argv[++i]);
+      else if (opt == "-b")
+        sections.push_back(argv[++i]);
+      else
+        throw runtime_error("unknown option " + opt);
+    }
+    if (lmax < 0 || lmax > 6)
+      throw runtime_error("lmax should be between 0 and 6");
+    if (sections.empty()) {
+      sections = IntegralBench::batches();
+      sections.push_back("eripost");
+      sections.push_back("roots");
+    }
+
+    IntegralBench bench(lmax, min_time);
+    bool integral = false;
+    for (auto& s : sections) {
+      if (s == "eripost") {
+        bench_eripost(cout);
+      } else if (s == "roots") {
+        bench_roots(cout);
+      } else {
+        bench.run_batch(s);
+        integral = true;
+      }
+    }
+    if (integral) {
+      bench.print(cout);
+      ofstream fs(output);
+      if (!fs.is_open())
+        throw runtime_error("could not open " + output);
+      bench.write_json(fs);
+      cout << "  timings written to " << output << endl;
+    }
+  } catch (const exception& e) {
+    cout << "  ERROR: " << e.what() << endl;
+    return 1;
+  }
+  return 0;
+}
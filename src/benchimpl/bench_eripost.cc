@@ -0,0 +1,92 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: bench_eripost.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// HRR, cartesian-to-spherical transformation and sorting of ERIBatch: the fused single pass (FusedPost)
+// against the separate passes, per angular momentum class.
+
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <src/integral/fusedpost.h>
+#include <src/integral/rys/eribatch.h>
+
+namespace {
+
+std::shared_ptr<const Shell> bench_shell(const int l, const std::array<double,3>& position) {
+  // generally contracted shell with 3 primitives and 2 contracted functions
+  const std::vector<double> exponents{4.5, 1.2, 0.35};
+  const std::vector<std::vector<double>> contractions{{0.3, 0.5, 0.3}, {0.0, 0.4, 0.7}};
+  const std::vector<std::pair<int,int>> ranges{{0, 3}, {1, 3}};
+  return std::make_shared<const Shell>(true, position, l, exponents, contractions, ranges);
+}
+
+// wall time per batch in microseconds; the integrals of the last batch are copied to out
+double time_eribatch(const std::array<std::shared_ptr<const Shell>,4>& shells, const int nrepeat, std::vector<double>& out) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i != nrepeat; ++i) {
+    ERIBatch eri(shells, 1.0);
+    eri.compute();
+    if (i == nrepeat-1)
+      out.assign(eri.data(), eri.data()+eri.data_size());
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / nrepeat;
+}
+
+}
+
+void bench_eripost(std::ostream& os) {
+  const std::array<std::array<double,3>,4> positions{{{{0.0, 0.0, 0.0}}, {{0.0, 0.4, 1.3}}, {{1.1, -0.3, 0.2}}, {{0.9, 0.8, -1.0}}}};
+  const int lmax = FusedPost::max_angular;
+
+  os << "  === ERIBatch post-processing: separate passes vs fused (usec/batch) ===" << std::endl;
+  os << "     class       separate      fused    speedup     max diff" << std::endl;
+  double logspeedup = 0.0;
+  int nclass = 0;
+  for (int l0 = 0; l0 <= lmax; ++l0)
+    for (int l1 = 0; l1 <= l0; ++l1)
+      for (int l2 = 0; l2 <= l0; ++l2)
+        for (int l3 = 0; l3 <= l2; ++l3) {
+          const std::array<std::shared_ptr<const Shell>,4> shells{{bench_shell(l0, positions[0]), bench_shell(l1, positions[1]),
+                                                                   bench_shell(l2, positions[2]), bench_shell(l3, positions[3])}};
+          const int nrepeat = std::max(20, 20000 >> (l0+l1+l2+l3));
+          std::vector<double> ref, fused;
+          set_fused_post(false);
+          const double tsep = time_eribatch(shells, nrepeat, ref);
+          set_fused_post(true);
+          const double tfused = time_eribatch(shells, nrepeat, fused);
+          double diff = 0.0;
+          for (size_t i = 0; i != ref.size(); ++i)
+            diff = std::max(diff, std::fabs(ref[i] - fused[i]));
+
+          logspeedup += std::log(tsep/tfused);
+          ++nclass;
+          os << "     (" << l0 << l1 << "|" << l2 << l3 << ")" << std::fixed << std::setprecision(2)
+             << std::setw(13) << tsep << std::setw(11) << tfused << std::setw(11) << tsep/tfused
+             << std::scientific << std::setprecision(2) << std::setw(13) << diff << std::endl;
+        }
+  os << "     geometric mean of the speedup: " << std::fixed << std::setprecision(2) << std::exp(logspeedup/nclass) << std::endl << std::endl;
+  set_fused_post(true);
+}
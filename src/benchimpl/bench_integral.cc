@@ -0,0 +1,239 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: bench_integral.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Microbenchmarks of the integral engines. Every batch type is run over synthetic shells for all angular momentum
+// classes up to lmax; wall time and hardware counters are collected per class and written as JSON, so that kernel
+// changes can be compared class by class.
+
+#include <chrono>
+#include <iomanip>
+#include <src/benchimpl/perfcounter.h>
+#include <src/molecule/molecule.h>
+#include <src/integral/rys/eribatch.h>
+#include <src/integral/rys/slaterbatch.h>
+#include <src/integral/rys/breitbatch.h>
+#include <src/integral/rys/smalleribatch.h>
+#include <src/integral/rys/gradbatch.h>
+#include <src/integral/rys/naibatch.h>
+#include <src/integral/comprys/complexeribatch.h>
+#include <src/integral/os/overlapbatch.h>
+#include <src/integral/os/kineticbatch.h>
+
+class IntegralBench {
+  public:
+    struct Record {
+      std::string batch;
+      std::vector<int> angular;
+      size_t nintegral;
+      int nrepeat;
+      double seconds;
+      std::array<long long,PerfCounter::NEvent> counters;
+    };
+
+  protected:
+    const int lmax_;
+    const double min_time_;
+    std::vector<std::array<double,3>> positions_;
+    PerfCounter counter_;
+    std::vector<Record> records_;
+
+    // Contraction depths modeled after triple-zeta sets: s and p are generally contracted from 8 and 4 primitives,
+    // d from 3, and f and higher are single primitives. London or relativistic shells are set up on request.
+    std::shared_ptr<const Shell> shell(const int l, const int center, const bool london = false, const bool relativistic = false) const {
+      const std::array<int,7> nprim{{8, 4, 3, 1, 1, 1, 1}};
+      const std::array<int,7> ncont{{2, 2, 1, 1, 1, 1, 1}};
+      std::vector<double> exponents(nprim[l]);
+      for (int i = 0; i != nprim[l]; ++i)
+        exponents[i] = 0.15 * std::pow(3.2, nprim[l]-1-i) * (1.0 + 0.3*l);
+      std::vector<std::vector<double>> contractions;
+      std::vector<std::pair<int,int>> ranges;
+      for (int j = 0; j != ncont[l]; ++j) {
+        // the second function is the tighter half of the first one
+        std::vector<double> coeff(nprim[l], 0.0);
+        const int start = j == 0 ? 0 : nprim[l]/2;
+        for (int i = start; i != nprim[l]; ++i)
+          coeff[i] = 0.1 + 0.9 * (i+1) / nprim[l];
+        contractions.push_back(coeff);
+        ranges.push_back({start, nprim[l]});
+      }
+      auto out = std::make_shared<Shell>(true, positions_[center], l, exponents, contractions, ranges);
+      if (london) {
+        const std::array<double,3> field{{0.0, 0.0, 0.1}};
+        const std::array<double,3>& r = positions_[center];
+        const std::array<double,3> potential{{0.5*(field[1]*r[2]-field[2]*r[1]), 0.5*(field[2]*r[0]-field[0]*r[2]), 0.5*(field[0]*r[1]-field[1]*r[0])}};
+        out->add_phase(potential, field, true);
+      }
+      if (relativistic)
+        out->init_relativistic();
+      return out;
+    }
+
+    // canonical four-center classes (ab|cd) with a >= b, c >= d and ab >= cd
+    std::vector<std::array<int,4>> quartets(const int lmax) const {
+      std::vector<std::array<int,4>> out;
+      for (int a = 0; a <= lmax; ++a)
+        for (int b = 0; b <= a; ++b)
+          for (int c = 0; c <= a; ++c)
+            for (int d = 0; d <= c; ++d)
+              if (a*(a+1)/2+b >= c*(c+1)/2+d)
+                out.push_back({{a, b, c, d}});
+      return out;
+    }
+
+    std::array<std::shared_ptr<const Shell>,4> shells(const std::array<int,4>& l, const bool london = false) const {
+      return {{shell(l[0], 0, london), shell(l[1], 1, london), shell(l[2], 2, london), shell(l[3], 3, london)}};
+    }
+
+    static size_t nbasis(const std::array<std::shared_ptr<const Shell>,4>& s) {
+      return static_cast<size_t>(s[0]->nbasis()) * s[1]->nbasis() * s[2]->nbasis() * s[3]->nbasis();
+    }
+
+    // repeats compute() until min_time_ has passed (after one call to warm up) and records the averages
+    template<typename Func>
+    void run(const std::string& batch, const std::vector<int>& angular, const size_t nintegral, Func compute) {
+      compute();
+      int nrepeat = 0;
+      auto start = std::chrono::steady_clock::now();
+      std::chrono::duration<double> elapsed(0.0);
+      counter_.start();
+      do {
+        compute();
+        ++nrepeat;
+        elapsed = std::chrono::steady_clock::now() - start;
+      } while (elapsed.count() < min_time_);
+      records_.push_back({batch, angular, nintegral, nrepeat, elapsed.count(), counter_.stop()});
+    }
+
+  public:
+    IntegralBench(const int lmax, const double min_time) : lmax_(lmax), min_time_(min_time),
+      positions_{{{0.0, 0.0, 0.0}}, {{0.0, 0.4, 1.3}}, {{1.1, -0.3, 0.2}}, {{0.9, 0.8, -1.0}}} { }
+
+    // the names accepted by run_batch
+    static std::vector<std::string> batches() {
+      return {"eri", "slater", "breit", "smalleri", "complexeri", "grad", "nai", "overlap", "kinetic"};
+    }
+
+    void run_batch(const std::string& name) {
+      if (name == "eri") {
+        for (auto& l : quartets(lmax_)) {
+          const auto s = shells(l);
+          run("ERIBatch", {l.begin(), l.end()}, nbasis(s), [&]() { ERIBatch eri(s, 1.0); eri.compute(); });
+        }
+      } else if (name == "slater") {
+#ifdef HAVE_LIBSLATER
+        for (auto& l : quartets(lmax_)) {
+          const auto s = shells(l);
+          run("SlaterBatch", {l.begin(), l.end()}, nbasis(s), [&]() { SlaterBatch slater(s, 1.0, 1.5); slater.compute(); });
+        }
+#endif
+      } else if (name == "breit") {
+        // the Breit operator needs one more unit of angular momentum
+        for (auto& l : quartets(std::min(lmax_, 5))) {
+          const auto s = shells(l);
+          run("BreitBatch", {l.begin(), l.end()}, 6*nbasis(s), [&]() { BreitBatch breit(s, 1.0); breit.compute(); });
+        }
+      } else if (name == "smalleri") {
+        // three-center integrals of the small component; the auxiliary shells carry l+1
+        for (int a = 0; a <= lmax_; ++a)
+          for (int b = 0; b <= std::min(lmax_, 5); ++b)
+            for (int c = 0; c <= b; ++c) {
+              const std::array<std::shared_ptr<const Shell>,4> s{{std::make_shared<const Shell>(true), shell(a, 0), shell(b, 1, false, true), shell(c, 2, false, true)}};
+              const size_t n = static_cast<size_t>(s[1]->nbasis()) * s[2]->nbasis() * s[3]->nbasis();
+              run("SmallERIBatch", {a, b, c}, 6*n, [&]() { SmallERIBatch small(s, 0.0); small.compute(); });
+            }
+      } else if (name == "complexeri") {
+        for (auto& l : quartets(lmax_)) {
+          const auto s = shells(l, true);
+          run("ComplexERIBatch", {l.begin(), l.end()}, nbasis(s), [&]() { ComplexERIBatch eri(s, 1.0); eri.compute(); });
+        }
+      } else if (name == "grad") {
+        // derivative integrals need one more unit of angular momentum
+        for (auto& l : quartets(std::min(lmax_, 5))) {
+          const auto s = shells(l);
+          run("GradBatch", {l.begin(), l.end()}, 12*nbasis(s), [&]() { GradBatch grad(s, 1.0); grad.compute(); });
+        }
+      } else if (name == "nai" || name == "overlap" || name == "kinetic") {
+        std::vector<std::shared_ptr<const Atom>> atoms;
+        for (auto& p : positions_)
+          atoms.push_back(std::make_shared<const Atom>(true, "C", p, 6.0));
+        auto mol = std::make_shared<const Molecule>(atoms, std::vector<std::shared_ptr<const Atom>>{});
+
+        for (int a = 0; a <= lmax_; ++a)
+          for (int b = 0; b <= a; ++b) {
+            const std::array<std::shared_ptr<const Shell>,2> s{{shell(a, 0), shell(b, 1)}};
+            const size_t n = static_cast<size_t>(s[0]->nbasis()) * s[1]->nbasis();
+            if (name == "nai")
+              run("NAIBatch", {a, b}, n, [&]() { NAIBatch nai(s, mol); nai.compute(); });
+            else if (name == "overlap")
+              run("OverlapBatch", {a, b}, n, [&]() { OverlapBatch overlap(s); overlap.compute(); });
+            else
+              run("KineticBatch", {a, b}, n, [&]() { KineticBatch kinetic(s); kinetic.compute(); });
+          }
+      } else {
+        throw std::runtime_error("unknown batch type in the benchmark: " + name);
+      }
+    }
+
+    void print(std::ostream& os) const {
+      const std::string am = "spdfghi";
+      std::string current;
+      for (auto& r : records_) {
+        if (r.batch != current) {
+          current = r.batch;
+          os << "  === " << current << " ===" << std::endl;
+          os << "     class          ns/integral   usec/batch     repeat" << std::endl;
+        }
+        // (ab|cd), (a|bc) or (a|b)
+        const size_t nbra = r.angular.size() == 3 ? 1 : r.angular.size()/2;
+        std::string label = "(";
+        for (size_t i = 0; i != r.angular.size(); ++i)
+          label += std::string(i == nbra ? "|" : "") + am[r.angular[i]];
+        label += ")";
+        os << "     " << std::left << std::setw(12) << label << std::right << std::fixed << std::setprecision(3)
+           << std::setw(14) << r.seconds / r.nrepeat / r.nintegral * 1.0e9
+           << std::setw(13) << r.seconds / r.nrepeat * 1.0e6 << std::setw(11) << r.nrepeat << std::endl;
+      }
+    }
+
+    // one object per class; counters are per batch and null when not available
+    void write_json(std::ostream& os) const {
+      auto value = [](const long long c, const int n) { return c < 0 ? std::string("null") : std::to_string(static_cast<double>(c) / n); };
+      os << "[" << std::endl;
+      for (auto r = records_.begin(); r != records_.end(); ++r) {
+        os << "  {\"batch\": \"" << r->batch << "\", \"angular\": [";
+        for (auto i = r->angular.begin(); i != r->angular.end(); ++i)
+          os << *i << (i+1 == r->angular.end() ? "" : ", ");
+        os << "], \"integrals\": " << r->nintegral << ", \"repeat\": " << r->nrepeat
+           << std::scientific << std::setprecision(6)
+           << ", \"seconds_per_batch\": " << r->seconds / r->nrepeat
+           << ", \"ns_per_integral\": " << r->seconds / r->nrepeat / r->nintegral * 1.0e9;
+        for (int i = 0; i != PerfCounter::NEvent; ++i)
+          os << ", \"" << PerfCounter::name(i) << "\": " << value(r->counters[i], r->nrepeat);
+        os << ", \"flops\": " << value(PerfCounter::flops(r->counters), r->nrepeat);
+        os << "}" << (r+1 == records_.end() ? "" : ",") << std::endl;
+      }
+      os << "]" << std::endl;
+    }
+};
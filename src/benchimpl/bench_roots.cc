@@ -0,0 +1,75 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: bench_roots.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// Rys roots and weights from the Chebyshev tables (see chebyshevroot.h) per family and number of roots,
+// for single values of T and for batches as they come from a contracted shell quartet.
+
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <src/integral/rys/erirootlist.h>
+#include <src/integral/rys/breitrootlist.h>
+#include <src/integral/rys/spin2rootlist.h>
+#include <src/integral/rys/r2rootlist.h>
+
+namespace {
+
+// wall time per value of T in nanoseconds when the values in ta are passed n at a time
+template<class RootList>
+double time_roots(const RootList& list, const int nroot, const std::vector<double>& ta, const int n) {
+  std::vector<double> rr(ta.size()*nroot), ww(ta.size()*nroot);
+  const int nrepeat = std::max(1, 200000 / static_cast<int>(ta.size()*nroot));
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r != nrepeat; ++r)
+    for (size_t i = 0; i+n <= ta.size(); i += n)
+      list.root(nroot, ta.data()+i, rr.data()+i*nroot, ww.data()+i*nroot, n);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / (nrepeat * (ta.size()/n*n));
+}
+
+}
+
+void bench_roots(std::ostream& os) {
+  // T is mostly in the interpolated range [0, 64), with some values in the asymptotic region
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  std::vector<double> ta(1024);
+  for (size_t i = 0; i != ta.size(); ++i)
+    ta[i] = i % 8 == 0 ? 64.0 / dist(gen) : 64.0 * dist(gen);
+
+  os << "  === Rys roots and weights (nsec/T) ===" << std::endl;
+  os << "     family   nroot     single    batch of 81" << std::endl;
+  auto print = [&os](const std::string family, const int nroot, const double single, const double batch) {
+    os << "     " << std::left << std::setw(8) << family << std::right << std::setw(6) << nroot << std::fixed << std::setprecision(2)
+       << std::setw(11) << single << std::setw(15) << batch << std::endl;
+  };
+  for (const int nroot : {1, 2, 3, 4, 5, 7, 9, 13, 20, 30, 50})
+    print("eri", nroot, time_roots(eriroot__, nroot, ta, 1), time_roots(eriroot__, nroot, ta, 81));
+  for (const int nroot : {1, 3, 5, 9, 13}) {
+    print("breit", nroot, time_roots(breitroot__, nroot, ta, 1), time_roots(breitroot__, nroot, ta, 81));
+    print("spin2", nroot, time_roots(spin2root__, nroot, ta, 1), time_roots(spin2root__, nroot, ta, 81));
+    print("r2", nroot, time_roots(r2root__, nroot, ta, 1), time_roots(r2root__, nroot, ta, 81));
+  }
+  os << std::endl;
+}
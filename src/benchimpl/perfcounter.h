@@ -0,0 +1,151 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: perfcounter.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Hardware performance counters of the calling thread through perf_event_open (Linux only).
+// Counters that cannot be opened (other platforms, virtual machines, perf_event_paranoid) report -1.
+
+#ifndef __SRC_BENCHIMPL_PERFCOUNTER_H
+#define __SRC_BENCHIMPL_PERFCOUNTER_H
+
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#ifdef __linux__
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+#if defined(__x86_64__) && defined(__GNUC__)
+  #include <cpuid.h>
+#endif
+
+class PerfCounter {
+  public:
+    // double-precision FP operations are counted with the FP_ARITH_INST_RETIRED events of Intel processors
+    // (scalar, 128, 256 and 512-bit packed), which have no generic perf equivalent
+    enum Event { Cycles, Instructions, CacheMisses, L1DMisses, FPScalar, FP128, FP256, FP512, NEvent };
+
+    static std::string name(const int i) {
+      const std::array<std::string,NEvent> names{{"cycles", "instructions", "cache_misses", "l1d_misses", "fp_scalar", "fp_128", "fp_256", "fp_512"}};
+      return names[i];
+    }
+
+  private:
+    std::array<int,NEvent> fd_;
+
+#ifdef __linux__
+    static int open_event(const unsigned int type, const unsigned long long config) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(perf_event_attr));
+      attr.size = sizeof(perf_event_attr);
+      attr.type = type;
+      attr.config = config;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+
+    static bool intel() {
+#if defined(__x86_64__) && defined(__GNUC__)
+      unsigned int eax, ebx, ecx, edx;
+      if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx))
+        return false;
+      char vendor[13];
+      std::memcpy(vendor, &ebx, 4);
+      std::memcpy(vendor+4, &edx, 4);
+      std::memcpy(vendor+8, &ecx, 4);
+      vendor[12] = '\0';
+      return std::string(vendor) == "GenuineIntel";
+#else
+      return false;
+#endif
+    }
+
+  public:
+    PerfCounter() {
+      fd_.fill(-1);
+#ifdef __linux__
+      fd_[Cycles] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+      fd_[Instructions] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+      fd_[CacheMisses] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+      fd_[L1DMisses] = open_event(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+      if (intel()) {
+        // event 0xc7 with the umask selecting the vector width
+        fd_[FPScalar] = open_event(PERF_TYPE_RAW, 0x01c7);
+        fd_[FP128] = open_event(PERF_TYPE_RAW, 0x04c7);
+        fd_[FP256] = open_event(PERF_TYPE_RAW, 0x10c7);
+        fd_[FP512] = open_event(PERF_TYPE_RAW, 0x40c7);
+      }
+#endif
+    }
+
+    ~PerfCounter() {
+#ifdef __linux__
+      for (auto& i : fd_)
+        if (i >= 0) close(i);
+#endif
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    void start() {
+#ifdef __linux__
+      for (auto& i : fd_)
+        if (i >= 0) {
+          ioctl(i, PERF_EVENT_IOC_RESET, 0);
+          ioctl(i, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    std::array<long long,NEvent> stop() {
+      std::array<long long,NEvent> out;
+      out.fill(-1);
+#ifdef __linux__
+      for (int i = 0; i != NEvent; ++i)
+        if (fd_[i] >= 0) {
+          ioctl(fd_[i], PERF_EVENT_IOC_DISABLE, 0);
+          long long count;
+          if (read(fd_[i], &count, sizeof(long long)) == sizeof(long long))
+            out[i] = count;
+        }
+#endif
+      return out;
+    }
+
+    // double-precision flops from the FP events, or -1
+    static long long flops(const std::array<long long,NEvent>& c) {
+      if (c[FPScalar] < 0 || c[FP128] < 0 || c[FP256] < 0)
+        return -1;
+      return c[FPScalar] + 2*c[FP128] + 4*c[FP256] + 8*std::max(c[FP512], 0LL);
+    }
+};
+
+#endif
@@ -27,6 +27,7 @@
 #define BAGEL_FCI_CIVEC_H
 
 #include <list>
+#include <boost/serialization/version.hpp>
 #include <src/util/math/algo.h>
 #include <src/util/f77.h>
 #include <src/util/parallel/staticdist.h>
@@ -69,14 +70,18 @@ class Civector {
     void save(Archive& ar, const unsigned int) const {
       if (!cc_.get())
         throw std::logic_error("illegal call of Civector<T>::save");
-      ar << det_ << lena_ << lenb_ << make_array(cc(), size());
+      ar << det_ << lena_ << lenb_ << make_section(cc(), size());
     }
     template<class Archive>
-    void load(Archive& ar, const unsigned int) {
+    void load(Archive& ar, const unsigned int version) {
       ar >> det_ >> lena_ >> lenb_;
       cc_ = std::unique_ptr<DataType[]>(new DataType[size()]);
       cc_ptr_ = cc_.get();
-      ar >> make_array(cc(), size());
+      // version 0 stores the coefficients inline
+      if (version == 0)
+        ar >> make_array(cc(), size());
+      else
+        ar >> make_section(cc(), size());
     }
 
   public:
@@ -218,4 +223,7 @@ using CASDvec = Dvector_base<Civec>;
 extern template class bagel::Civector<double>;
 extern template class bagel::Civector<std::complex<double>>;
 
+BOOST_CLASS_VERSION(bagel::Civector<double>, 1)
+BOOST_CLASS_VERSION(bagel::Civector<std::complex<double>>, 1)
+
 #endif
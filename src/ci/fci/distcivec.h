@@ -84,6 +84,7 @@ class DistCivector : public RMAWindow<DataType> {
     size_t aend() const { return aend_; }
     size_t asize() const { return aend_ - astart_; }
 
+    DataType* data() { return local_data(); }
     const DataType* data() const { return local_data(); }
 
     void synchronize(const int root = 0) { /* do nothing */ }
@@ -51,6 +51,9 @@ void DistFCI::common_init() {
   max_iter_ = idata_->get<int>("maxiter", 100);
   max_iter_ = idata_->get<int>("maxiter_fci", max_iter_);
   davidson_subspace_ = idata_->get<int>("davidson_subspace", 20);
+  davidson_incore_ = idata_->get<int>("davidson_incore", -1);
+  davidson_single_ = idata_->get<bool>("davidson_single", false);
+  davidson_scratch_ = idata_->get<string>("davidson_scratch", ".");
   thresh_ = idata_->get<double>("thresh", 1.0e-10);
   thresh_ = idata_->get<double>("thresh_fci", thresh_);
   print_thresh_ = idata_->get<double>("print_thresh", 0.05);
@@ -383,6 +386,7 @@ void DistFCI::compute() {
 
   // Davidson utility
   DavidsonDiag<DistCivec> davidson(nstate_, davidson_subspace_);
+  davidson.set_spill(davidson_incore_, davidson_single_, davidson_scratch_, thresh_);
 
   // main iteration starts here
   cout << "  === FCI iteration ===" << endl << endl;
@@ -30,6 +30,7 @@
 #include <src/util/combination.hpp>
 #include <src/util/exception.h>
 #include <src/prop/multipole.h>
+#include <src/mat1e/overlap.h>
 
 using namespace std;
 using namespace bagel;
@@ -38,7 +39,7 @@ BOOST_CLASS_EXPORT_IMPLEMENT(FCI)
 
 FCI::FCI(shared_ptr<const PTree> idat, shared_ptr<const Geometry> g, shared_ptr<const Reference> r,
          const int ncore, const int norb, const int nstate, const bool store)
- : FCI_base(idat, g, r, ncore, norb, nstate, store) {
+ : FCI_base(idat, g, r, ncore, norb, nstate, store), irrep_(-1) {
   common_init();
 }
 
@@ -95,6 +96,9 @@ void FCI::common_init() {
   max_iter_ = idata_->get<int>("maxiter", 100);
   max_iter_ = idata_->get<int>("maxiter_fci", max_iter_);
   davidson_subspace_ = idata_->get<int>("davidson_subspace", 20);
+  davidson_incore_ = idata_->get<int>("davidson_incore", -1);
+  davidson_single_ = idata_->get<bool>("davidson_single", false);
+  davidson_scratch_ = idata_->get<string>("davidson_scratch", ".");
   thresh_ = idata_->get<double>("thresh", 1.0e-10);
   thresh_ = idata_->get<double>("thresh_fci", thresh_);
   print_thresh_ = idata_->get<double>("print_thresh", 0.05);
@@ -144,16 +148,70 @@ void FCI::common_init() {
   // construct a determinant space in which this FCI will be performed.
   det_ = make_shared<const Determinants>(norb_, nelea_, neleb_);
 
+  // only determinants in the target irrep are used when point-group symmetry is available
+  const string irrep = to_lower(idata_->get<string>("irrep", ""));
+  if (!irrep.empty()) {
+    if (geom_->nirrep() == 1)
+      throw runtime_error("Target irrep is specified for FCI, but point-group symmetry is not used");
+    for (int i = 0; i != geom_->nirrep(); ++i)
+      if (geom_->plist()->irrep_name(i) == irrep)
+        irrep_ = i;
+    if (irrep_ < 0)
+      throw runtime_error("Irrep " + irrep + " is not found in point group " + geom_->plist()->sym());
+  }
+}
+
+
+void FCI::init_symmetry(shared_ptr<const Matrix> coeff) {
+  shared_ptr<const Petite> plist = geom_->plist();
+  orbital_irrep_ = plist->orbital_irreps(geom_->atoms(), *coeff->slice_copy(ncore_, ncore_+norb_), Overlap(geom_));
+
+  auto parity = [&](const bitset<nbit__>& bit) {
+    int out = 0;
+    for (int i = 0; i != norb_; ++i)
+      if (bit[i]) out ^= plist->irrep_parity(orbital_irrep_[i]);
+    return out;
+  };
+  parity_a_.clear();
+  parity_b_.clear();
+  for (auto& i : det()->string_bits_a()) parity_a_.push_back(parity(i));
+  for (auto& i : det()->string_bits_b()) parity_b_.push_back(parity(i));
+
+  size_t ndet = 0;
+  for (size_t ia = 0; ia != parity_a_.size(); ++ia)
+    for (size_t ib = 0; ib != parity_b_.size(); ++ib)
+      ndet += in_irrep(ia, ib);
+  cout << "    * Determinants are restricted to irrep " << plist->irrep_name(irrep_) << " (" << ndet << " out of "
+       << parity_a_.size()*parity_b_.size() << ")" << endl << endl;
+}
+
+
+bool FCI::in_irrep(const size_t ia, const size_t ib) const {
+  return irrep_ < 0 || geom_->plist()->irrep(parity_a_[ia] ^ parity_b_[ib]) == irrep_;
+}
+
+
+void FCI::project_irrep(shared_ptr<Civec> cc) const {
+  if (irrep_ < 0) return;
+  for (size_t ia = 0; ia != cc->lena(); ++ia)
+    for (size_t ib = 0; ib != cc->lenb(); ++ib)
+      if (!in_irrep(ia, ib))
+        cc->element(ib, ia) = 0.0;
 }
 
 
 void FCI::model_guess(shared_ptr<Dvec> out) {
   multimap<double, pair<bitset<nbit__>, bitset<nbit__>>> ordered_elements;
   const double* d = denom_->data();
+  size_t ia = 0;
   for (auto& abit : det_->string_bits_a()) {
+    size_t ib = 0;
     for (auto& bbit : det_->string_bits_b()) {
-      ordered_elements.emplace(*d++, make_pair(abit, bbit));
+      if (in_irrep(ia, ib++))
+        ordered_elements.emplace(*d, make_pair(abit, bbit));
+      ++d;
     }
+    ++ia;
   }
 
   vector<pair<bitset<nbit__>, bitset<nbit__>>> basis;
@@ -266,15 +324,19 @@ vector<pair<bitset<nbit__> , bitset<nbit__>>> FCI::detseeds(const int ndet) cons
   for (int i = 0; i != ndet; ++i) tmp.emplace(-1.0e10*(1+i), make_pair(bitset<nbit__>(0),bitset<nbit__>(0)));
 
   double* diter = denom_->data();
+  size_t ia = 0;
   for (auto& aiter : det()->string_bits_a()) {
+    size_t ib = 0;
     for (auto& biter : det()->string_bits_b()) {
       const double din = -(*diter);
-      if (tmp.begin()->first < din) {
+      if (tmp.begin()->first < din && in_irrep(ia, ib)) {
         tmp.emplace(din, make_pair(biter, aiter));
         tmp.erase(tmp.begin());
       }
       ++diter;
+      ++ib;
     }
+    ++ia;
   }
   assert(tmp.size() == ndet || ndet > det()->string_bits_a().size()*det()->string_bits_b().size());
   vector<pair<bitset<nbit__> , bitset<nbit__>>> out;
@@ -299,6 +361,9 @@ shared_ptr<const CIWfn> FCI::conv_to_ciwfn() const {
 void FCI::compute() {
   Timer pdebug(3);
 
+  if (irrep_ >= 0)
+    init_symmetry(jop_->coeff());
+
   if (!restarted_) {
     // Creating an initial CI vector
     cc_ = make_shared<Dvec>(det_, nstate_); // B runs first
@@ -313,6 +378,7 @@ void FCI::compute() {
     // Davidson utility
     davidson_ = make_shared<DavidsonDiag<Civec>>(nstate_, davidson_subspace_);
   }
+  davidson_->set_spill(davidson_incore_, davidson_single_, davidson_scratch_, thresh_);
 
   // nuclear energy retrieved from geometry
   const double nuc_core = geom_->nuclear_repulsion() + jop_->core_energy();
@@ -366,6 +432,7 @@ void FCI::compute() {
         for (size_t i = 0; i != size; ++i) {
           target_array[i] = source_array[i] / min(en - denom_array[i], -0.1);
         }
+        project_irrep(cc_->data(ist));
         cc_->data(ist)->normalize();
         cc_->data(ist)->spin_decontaminate();
         cc_->data(ist)->synchronize();
@@ -38,6 +38,16 @@ class FCI : public FCI_base {
 
     bool dipoles_;
 
+    // target irrep when point-group symmetry is used (-1 otherwise)
+    int irrep_;
+    // irreps of the active orbitals, and parities of alpha and beta strings (see Petite)
+    std::vector<int> orbital_irrep_;
+    std::vector<int> parity_a_;
+    std::vector<int> parity_b_;
+    void init_symmetry(std::shared_ptr<const Matrix> coeff);
+    bool in_irrep(const size_t ia, const size_t ib) const;
+    void project_irrep(std::shared_ptr<Civec> cc) const;
+
   private:
     // serialization
     friend class boost::serialization::access;
@@ -50,15 +60,18 @@ class FCI : public FCI_base {
       ar << boost::serialization::base_object<Method>(*this);
       ar << max_iter_ << davidson_subspace_ << nguess_ << thresh_ << print_thresh_
          << nelea_ << neleb_ << ncore_ << norb_ << nstate_ << det_
-         << energy_ << cc_ << rdm1_ << rdm2_ << weight_ << rdm1_av_ << rdm2_av_ << davidson_;
+         << energy_ << cc_ << rdm1_ << rdm2_ << weight_ << rdm1_av_ << rdm2_av_ << davidson_ << irrep_;
     }
     template<class Archive>
-    void load(Archive& ar, const unsigned int) {
+    void load(Archive& ar, const unsigned int version) {
       // jop_ and denom_ will be constructed in derived classes
       ar >> boost::serialization::base_object<Method>(*this);
       ar >> max_iter_ >> davidson_subspace_ >> nguess_ >> thresh_ >> print_thresh_
          >> nelea_ >> neleb_ >> ncore_ >> norb_ >> nstate_ >> det_
          >> energy_ >> cc_ >> rdm1_ >> rdm2_ >> weight_ >> rdm1_av_ >> rdm2_av_ >> davidson_;
+      // archives of version 0 predate point-group symmetry
+      if (version > 0)
+        ar >> irrep_;
       restarted_ = true;
     }
 
@@ -81,7 +94,7 @@ class FCI : public FCI_base {
     void print_header() const override;
 
   public:
-    FCI() { }
+    FCI() : irrep_(-1) { }
 
     // this constructor is ugly... to be fixed some day...
     FCI(std::shared_ptr<const PTree>, std::shared_ptr<const Geometry>, std::shared_ptr<const Reference>,
@@ -159,7 +172,9 @@ class FCI_bare : public FCI {
 }
 
 #include <src/util/archive.h>
+#include <boost/serialization/version.hpp>
 BOOST_CLASS_EXPORT_KEY(bagel::FCI)
+BOOST_CLASS_VERSION(bagel::FCI, 1)
 
 namespace bagel {
   template <class T>
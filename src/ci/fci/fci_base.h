@@ -40,6 +40,10 @@ class FCI_base : public Method {
     // Options
     int max_iter_;
     int davidson_subspace_;
+    // Davidson basis pairs kept in memory (negative for all) and options for the others spilled to disk
+    int davidson_incore_;
+    bool davidson_single_;
+    std::string davidson_scratch_;
     int nguess_;
     double thresh_;
     double print_thresh_;
@@ -85,10 +89,10 @@ class FCI_base : public Method {
     // this constructor is ugly... to be fixed some day...
     FCI_base(std::shared_ptr<const PTree> idat, std::shared_ptr<const Geometry> g, std::shared_ptr<const Reference> r,
              const int ncore = -1, const int norb = -1, const int nstate = -1, const bool store = false)
-      : Method(idat, g, r), ncore_(ncore), norb_(norb), nstate_(nstate), restarted_(false), store_half_ints_(store) {
+      : Method(idat, g, r), davidson_incore_(-1), davidson_single_(false), ncore_(ncore), norb_(norb), nstate_(nstate), restarted_(false), store_half_ints_(store) {
     }
 
-    FCI_base() { }
+    FCI_base() : davidson_incore_(-1), davidson_single_(false) { }
     virtual ~FCI_base() { }
 
     // FCI compute function
@@ -24,6 +24,7 @@
 
 #include <src/ci/fci/harrison.h>
 #include <src/ci/fci/hztasks.h>
+#include <src/ci/fci/irrepblocks.h>
 #include <src/util/taskqueue.h>
 #include <src/util/prim_op.h>
 
@@ -147,7 +148,39 @@ void HarrisonZarrabian::sigma_2ab_1(shared_ptr<const Civec> cc, shared_ptr<Dvec>
 void HarrisonZarrabian::sigma_2ab_2(shared_ptr<Dvec> d, shared_ptr<Dvec> e, shared_ptr<const MOFile> jop) const {
   const int ij = d->ij();
   const int lenab = d->lena() * d->lenb();
-  dgemm_("n", "n", lenab, ij, ij, 1.0, d->data(), lenab, jop->mo2e_ptr(), ij, 0.0, e->data(), lenab);
+  if (irrep_ < 0 || jop != jop_ || orbital_irrep_.empty()) {
+    dgemm_("n", "n", lenab, ij, ij, 1.0, d->data(), lenab, jop->mo2e_ptr(), ij, 0.0, e->data(), lenab);
+    return;
+  }
+
+  // With a target irrep, D(kl) only has determinants of the target irrep times that of kl, and (ij|kl) is
+  // block diagonal in the irreps of the pairs. The multiplication is done for each block in compact storage.
+  const IrrepBlocks blocks(d->det(), orbital_irrep_, geom_->plist());
+  vector<vector<int>> pairs(blocks.nirrep());
+  for (int k = 0; k != norb_; ++k)
+    for (int l = 0; l != norb_; ++l)
+      pairs[blocks.product(orbital_irrep_[k], orbital_irrep_[l])].push_back(k*norb_ + l);
+
+  e->zero();
+  for (int g = 0; g != blocks.nirrep(); ++g) {
+    const vector<int>& pair = pairs[g];
+    const int dirrep = blocks.product(irrep_, g);
+    const size_t nd = blocks.size(dirrep);
+    const int np = pair.size();
+    if (nd == 0 || np == 0) continue;
+
+    Matrix dblock(nd, np, true);
+    Matrix g2(np, np, true);
+    for (int k = 0; k != np; ++k) {
+      blocks.gather(dirrep, d->data(pair[k])->data(), dblock.element_ptr(0, k));
+      for (int l = 0; l != np; ++l)
+        g2(l, k) = jop->mo2e_ptr()[pair[l] + pair[k]*ij];
+    }
+    Matrix eblock(nd, np, true);
+    dgemm_("n", "n", nd, np, np, 1.0, dblock.data(), nd, g2.data(), np, 0.0, eblock.data(), nd);
+    for (int k = 0; k != np; ++k)
+      blocks.scatter(dirrep, eblock.element_ptr(0, k), e->data(pair[k])->data());
+  }
 }
 
 
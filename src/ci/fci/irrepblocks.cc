@@ -0,0 +1,76 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: irrepblocks.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <src/ci/fci/irrepblocks.h>
+
+using namespace std;
+using namespace bagel;
+
+IrrepBlocks::IrrepBlocks(shared_ptr<const Determinants> det, const vector<int>& orbital, shared_ptr<const Petite> plist)
+ : det_(det), nirrep_(plist->nirrep()), product_(nirrep_, vector<int>(nirrep_)), beta_(nirrep_), offset_(nirrep_, vector<size_t>(det->lena()+1)) {
+  assert(orbital.size() == det->norb());
+
+  for (int i = 0; i != nirrep_; ++i)
+    for (int j = 0; j != nirrep_; ++j)
+      product_[i][j] = plist->product(i, j);
+
+  auto irrep = [&](const bitset<nbit__>& bit) {
+    int parity = 0;
+    for (int i = 0; i != det->norb(); ++i)
+      if (bit[i]) parity ^= plist->irrep_parity(orbital[i]);
+    return plist->irrep(parity);
+  };
+  for (auto& i : det->string_bits_a()) irrep_a_.push_back(irrep(i));
+  for (auto& i : det->string_bits_b()) irrep_b_.push_back(irrep(i));
+
+  position_b_.resize(irrep_b_.size());
+  for (size_t ib = 0; ib != irrep_b_.size(); ++ib) {
+    position_b_[ib] = beta_[irrep_b_[ib]].size();
+    beta_[irrep_b_[ib]].push_back(ib);
+  }
+
+  for (int ir = 0; ir != nirrep_; ++ir)
+    for (size_t ia = 0; ia != irrep_a_.size(); ++ia)
+      offset_[ir][ia+1] = offset_[ir][ia] + beta(ir, ia).size();
+}
+
+
+void IrrepBlocks::gather(const int irrep, const double* cc, double* out) const {
+  const size_t lb = det_->lenb();
+  for (size_t ia = 0; ia != irrep_a_.size(); ++ia) {
+    const double* source = cc + ia*lb;
+    for (auto& ib : beta(irrep, ia))
+      *out++ = source[ib];
+  }
+}
+
+
+void IrrepBlocks::scatter(const int irrep, const double* in, double* cc) const {
+  const size_t lb = det_->lenb();
+  for (size_t ia = 0; ia != irrep_a_.size(); ++ia) {
+    double* target = cc + ia*lb;
+    for (auto& ib : beta(irrep, ia))
+      target[ib] = *in++;
+  }
+}
@@ -0,0 +1,75 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: irrepblocks.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __SRC_FCI_IRREPBLOCKS_H
+#define __SRC_FCI_IRREPBLOCKS_H
+
+#include <src/ci/fci/civec.h>
+#include <src/molecule/petite.h>
+
+namespace bagel {
+
+// Compact storage of the determinants of one irrep of an Abelian point group.
+// For every alpha string, the beta strings that complete a determinant of the irrep are stored
+// contiguously (in their lexical order), and alpha strings follow each other in lexical order.
+class IrrepBlocks {
+  protected:
+    std::shared_ptr<const Determinants> det_;
+    int nirrep_;
+    // direct products of irreps
+    std::vector<std::vector<int>> product_;
+    // irreps of alpha and beta strings
+    std::vector<int> irrep_a_;
+    std::vector<int> irrep_b_;
+    // beta strings of each irrep, and the position of each beta string therein
+    std::vector<std::vector<size_t>> beta_;
+    std::vector<size_t> position_b_;
+    // offset_[irrep][ia] is the start of the segment of alpha string ia (size lena+1)
+    std::vector<std::vector<size_t>> offset_;
+
+  public:
+    // orbital holds the irreps of the active orbitals
+    IrrepBlocks(std::shared_ptr<const Determinants> det, const std::vector<int>& orbital, std::shared_ptr<const Petite> plist);
+
+    int nirrep() const { return nirrep_; }
+    int product(const int i, const int j) const { return product_[i][j]; }
+    int irrep_a(const size_t ia) const { return irrep_a_[ia]; }
+    int irrep_b(const size_t ib) const { return irrep_b_[ib]; }
+
+    // beta strings that form determinants of the irrep with alpha string ia
+    const std::vector<size_t>& beta(const int irrep, const size_t ia) const { return beta_[product_[irrep][irrep_a_[ia]]]; }
+    size_t position(const size_t ib) const { return position_b_[ib]; }
+    size_t offset(const int irrep, const size_t ia) const { return offset_[irrep][ia]; }
+    // number of determinants in the irrep
+    size_t size(const int irrep) const { return offset_[irrep].back(); }
+
+    // copies the elements of cc in the irrep to out (of size size(irrep))
+    void gather(const int irrep, const double* cc, double* out) const;
+    // copies in (of size size(irrep)) to the elements of cc in the irrep; other elements are not touched
+    void scatter(const int irrep, const double* in, double* cc) const;
+};
+
+}
+
+#endif
@@ -41,6 +41,8 @@ class KnowlesHandy : public FCI {
 
     // virtual application of Hamiltonian
     std::shared_ptr<Dvec> form_sigma(std::shared_ptr<const Dvec> c, std::shared_ptr<const MOFile> jop, const std::vector<int>& conv) const override;
+    // restricted to the determinants of irrep_
+    std::shared_ptr<Dvec> form_sigma_irrep(std::shared_ptr<const Dvec> c, std::shared_ptr<const MOFile> jop, const std::vector<int>& conv) const;
 
     // run-time functions
     void sigma_1(std::shared_ptr<const Civec> cc, std::shared_ptr<Civec> sigma, std::shared_ptr<const MOFile> jop) const;
@@ -23,6 +23,7 @@
 //
 
 #include <src/ci/fci/knowles.h>
+#include <src/ci/fci/irrepblocks.h>
 
 // toggle for timing print out.
 static const bool tprint = false;
@@ -35,6 +36,10 @@ using namespace bagel;
 shared_ptr<Dvec> KnowlesHandy::form_sigma(shared_ptr<const Dvec> ccvec, shared_ptr<const MOFile> jop,
                      const vector<int>& conv) const { // d and e are scratch area for D and E intermediates
 
+  // with a target irrep, the Hamiltonian of this FCI is applied within the irrep
+  if (irrep_ >= 0 && jop == jop_ && !orbital_irrep_.empty())
+    return form_sigma_irrep(ccvec, jop, conv);
+
   const int ij = (norb_*(norb_+1))/2;
 
   const int nstate = ccvec->ij();
@@ -87,6 +92,116 @@ shared_ptr<Dvec> KnowlesHandy::form_sigma(shared_ptr<const Dvec> ccvec, shared_p
   return sigmavec;
 }
 
+// Same as form_sigma, but only the determinants of the target irrep are kept in C and sigma, and only those
+// that contribute to them in D and E. Orbital pairs are blocked by their irreps, in which (ij|kl) is block diagonal,
+// so that step (e) becomes a dgemm for each block.
+shared_ptr<Dvec> KnowlesHandy::form_sigma_irrep(shared_ptr<const Dvec> ccvec, shared_ptr<const MOFile> jop, const vector<int>& conv) const {
+  const int ij = (norb_*(norb_+1))/2;
+  const int nstate = ccvec->ij();
+  shared_ptr<const Determinants> det = ccvec->det();
+  const size_t la = det->lena();
+
+  const IrrepBlocks blocks(det, orbital_irrep_, geom_->plist());
+  const int nirrep = blocks.nirrep();
+  const int totsym = blocks.product(irrep_, irrep_);
+
+  // orbital pairs (in the order of phia and phib) for each irrep
+  vector<vector<int>> pairs(nirrep);
+  for (int i = 0, ip = 0; i != norb_; ++i)
+    for (int j = 0; j <= i; ++j, ++ip)
+      pairs[blocks.product(orbital_irrep_[i], orbital_irrep_[j])].push_back(ip);
+
+  // beta excitations sorted by the irrep of the target string
+  vector<vector<vector<DetMap>>> phib(ij, vector<vector<DetMap>>(nirrep));
+  for (int ip = 0; ip != ij; ++ip)
+    for (auto& iter : det->phib(ip))
+      phib[ip][blocks.irrep_b(iter.target)].push_back(iter);
+
+  auto sigmavec = make_shared<Dvec>(det, nstate);
+  sigmavec->zero();
+
+  VectorB cc(blocks.size(irrep_));
+  VectorB sigma(blocks.size(irrep_));
+
+  for (int istate = 0; istate != nstate; ++istate) {
+    Timer pdebug(3);
+    if (conv[istate]) continue;
+    blocks.gather(irrep_, ccvec->data(istate)->data(), cc.data());
+    sigma.fill(0.0);
+
+    // (task1, task3) one-electron terms, in which only totally symmetric pairs appear
+    for (auto& ip : pairs[totsym]) {
+      const double h = jop->mo1e(ip);
+      for (auto& iter : det->phia(ip))
+        blas::ax_plus_y_n(h * iter.sign, cc.data() + blocks.offset(irrep_, iter.source), blocks.beta(irrep_, iter.source).size(),
+                          sigma.data() + blocks.offset(irrep_, iter.target));
+      for (size_t ia = 0; ia != la; ++ia) {
+        const size_t offset = blocks.offset(irrep_, ia);
+        for (auto& iter : phib[ip][blocks.product(irrep_, blocks.irrep_a(ia))])
+          sigma(offset + blocks.position(iter.target)) += h * iter.sign * cc(offset + blocks.position(iter.source));
+      }
+    }
+    pdebug.tick_print("task1,3");
+
+    // (task2) two electron contributions for each irrep of the pairs
+    for (int g = 0; g != nirrep; ++g) {
+      const vector<int>& pair = pairs[g];
+      // irrep of the determinants in D and E
+      const int dirrep = blocks.product(irrep_, g);
+      const size_t nd = blocks.size(dirrep);
+      const int np = pair.size();
+      if (nd == 0 || np == 0) continue;
+
+      Matrix d(nd, np, true);
+      // step (c) (task2a-1) D(Phib, Phia, ij) += sign C(Psib, Phi'a)
+      for (int k = 0; k != np; ++k)
+        for (auto& iter : det->phia(pair[k]))
+          blas::ax_plus_y_n(static_cast<double>(iter.sign), cc.data() + blocks.offset(irrep_, iter.target), blocks.beta(dirrep, iter.source).size(),
+                            d.element_ptr(blocks.offset(dirrep, iter.source), k));
+
+      // step (d) (task2a-2) D(Phib, Phia, ij) += sign C(Psib', Phia)
+      for (size_t ia = 0; ia != la; ++ia) {
+        const size_t coffset = blocks.offset(irrep_, ia);
+        const size_t doffset = blocks.offset(dirrep, ia);
+        const int tirrep = blocks.product(irrep_, blocks.irrep_a(ia));
+        for (int k = 0; k != np; ++k)
+          for (auto& iter : phib[pair[k]][tirrep])
+            d(doffset + blocks.position(iter.source), k) += iter.sign * cc(coffset + blocks.position(iter.target));
+      }
+
+      // step (e) (task2b) E(Phib, Phia, kl) = D(Psib, Phia, ij) (ij|kl)
+      Matrix g2(np, np, true);
+      for (int l = 0; l != np; ++l)
+        for (int k = 0; k != np; ++k)
+          g2(k, l) = jop->mo2e_ptr()[pair[k] + pair[l]*ij];
+      Matrix e(nd, np, true);
+      dgemm_("n", "n", nd, np, np, 0.5, d.data(), nd, g2.data(), np, 0.0, e.data(), nd);
+
+      // step (f) (task2c-1) sigma(Phib, Phia') += sign E(Psib, Phia, kl)
+      for (int k = 0; k != np; ++k)
+        for (auto& iter : det->phia(pair[k]))
+          blas::ax_plus_y_n(static_cast<double>(iter.sign), e.element_ptr(blocks.offset(dirrep, iter.source), k), blocks.beta(dirrep, iter.source).size(),
+                            sigma.data() + blocks.offset(irrep_, iter.target));
+
+      // step (g) (task2c-2) sigma(Phib', Phia) += sign E(Psib, Phia, kl)
+      for (size_t ia = 0; ia != la; ++ia) {
+        const size_t soffset = blocks.offset(irrep_, ia);
+        const size_t eoffset = blocks.offset(dirrep, ia);
+        const int tirrep = blocks.product(irrep_, blocks.irrep_a(ia));
+        for (int k = 0; k != np; ++k)
+          for (auto& iter : phib[pair[k]][tirrep])
+            sigma(soffset + blocks.position(iter.target)) += iter.sign * e(eoffset + blocks.position(iter.source), k);
+      }
+    }
+    pdebug.tick_print("task2");
+
+    blocks.scatter(irrep_, sigma.data(), sigmavec->data(istate)->data());
+  }
+
+  return sigmavec;
+}
+
+
 // The first two are a part of Base because they are needed in the RDM parts
 void FCI::sigma_2a1(shared_ptr<const Civec> cc, shared_ptr<Dvec> d) const {
   assert(d->det() == cc->det());
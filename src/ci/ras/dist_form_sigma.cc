@@ -0,0 +1,351 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: ras/dist_form_sigma.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <map>
+#include <set>
+#include <src/ci/ras/dist_form_sigma.h>
+
+using namespace std;
+using namespace bagel;
+
+namespace {
+  // whether two string spaces of the same spin can be connected by n electron replacements
+  bool connected(shared_ptr<const RASString> a, shared_ptr<const RASString> b, const int n) {
+    return abs(a->nholes() - b->nholes()) <= n && abs(a->nparticles() - b->nparticles()) <= n;
+  }
+
+  // index of the (alpha, beta) block in det->blockinfo()
+  int block_index(shared_ptr<const RASDeterminants> det, shared_ptr<const RASString> sa, shared_ptr<const RASString> sb) {
+    return det->block_address(sa->nholes(), sb->nholes(), sa->nparticles(), sb->nparticles());
+  }
+}
+
+
+vector<shared_ptr<DistRASCivec>> DistFormSigmaRAS::operator()(const vector<shared_ptr<DistRASCivec>>& ccvec, shared_ptr<const MOFile> jop, const vector<int>& conv) const {
+  return operator()(ccvec, jop->mo1e()->matrix(), jop->mo2e(), conv);
+}
+
+
+vector<shared_ptr<DistRASCivec>> DistFormSigmaRAS::operator()(const vector<shared_ptr<DistRASCivec>>& ccvec, shared_ptr<const Matrix> mo1e, shared_ptr<const Matrix> mo2e,
+                                                              const vector<int>& conv) const {
+  const int norb = ccvec.front()->det()->norb();
+
+  auto mo2e_hz = [&norb, &mo2e] (const int i, const int j, const int k, const int l) { return mo2e->element(i + norb*j, k + norb*l); };
+
+  // same one-electron part as in FormSigmaRAS
+  Matrix g(*mo1e);
+  for (int k = 0; k < norb; ++k) {
+    for (int l = 0; l < k; ++l) {
+      double val = -mo2e_hz(k, k, k, l);
+      for (int j = 0; j < k; ++j) val -= mo2e_hz(k,j,j,l);
+      g(l,k) += val;
+
+      val = 0.0;
+      for (int j = 0; j < l; ++j) val -= mo2e_hz(l,j,j,k);
+      g(k,l) += val;
+    }
+    double val = -0.5*mo2e_hz(k,k,k,k);
+    for (int j = 0; j < k; ++j) val -= mo2e_hz(k,j,j,k);
+    g(k,k) += val;
+  }
+
+  vector<shared_ptr<DistRASCivec>> sigmavec;
+  vector<TaskGroup> groups;
+  unique_ptr<Sparse_IJ> sparseij;
+
+  for (int istate = 0; istate != ccvec.size(); ++istate) {
+    if (conv[istate]) {
+      sigmavec.push_back(nullptr);
+      continue;
+    }
+    Timer pdebug(2);
+    shared_ptr<const DistRASCivec> cc = ccvec[istate];
+    shared_ptr<DistRASCivec> sigma = cc->clone();
+
+    // the task list only depends on the determinant space
+    if (groups.empty()) {
+      sparseij = unique_ptr<Sparse_IJ>(new Sparse_IJ(cc->det()->stringspaceb(), cc->det()->stringspaceb()));
+      groups = make_groups(sigma, *sparseij);
+    }
+
+    // the last group that uses each remote block; the buffer is released afterwards
+    map<int, int> last_use;
+    for (int ig = 0; ig != groups.size(); ++ig)
+      for (auto& s : groups[ig].sources)
+        last_use[s] = ig;
+
+    // fence is collective; local pointers are taken once
+    const double* cdata = cc->local_data();
+    unique_ptr<double[]> out(new double[max(sigma->size(), size_t(1))]);
+    fill_n(out.get(), sigma->size(), 0.0);
+
+    map<int, unique_ptr<double[]>> buffers;
+    map<int, shared_ptr<RMATask<double>>> requests;
+    auto request = [&](const TaskGroup& group) {
+      for (auto& s : group.sources)
+        if (!buffers.count(s)) {
+          buffers.emplace(s, unique_ptr<double[]>(new double[cc->blockinfo(s)->size()]));
+          requests.emplace(s, cc->rma_rget(buffers[s].get(), s));
+        }
+    };
+    auto source = [&](const int iblock) -> const double* {
+      return cc->is_local(iblock) ? cdata + cc->local_offset(iblock) : buffers.at(iblock).get();
+    };
+
+    if (!groups.empty())
+      request(groups.front());
+
+    for (int ig = 0; ig != groups.size(); ++ig) {
+      // communication for the next group overlaps with the computation of this one
+      if (ig+1 != groups.size())
+        request(groups[ig+1]);
+      for (auto& s : groups[ig].sources) {
+        auto r = requests.find(s);
+        if (r != requests.end()) {
+          r->second->wait();
+          requests.erase(r);
+        }
+      }
+
+      sigma_aa(groups[ig], source, sigma, out.get(), g.data(), mo2e->data());
+      sigma_bb(groups[ig], source, sigma, out.get(), g.data(), mo2e->data());
+      sigma_ab(groups[ig], source, sigma, out.get(), mo2e->data(), *sparseij);
+
+      for (auto& s : groups[ig].sources)
+        if (last_use[s] == ig)
+          buffers.erase(s);
+    }
+    pdebug.tick_print("local sigma blocks");
+
+    sigma->accumulate_buffer(1.0, out);
+    sigmavec.push_back(sigma);
+  }
+
+  return sigmavec;
+}
+
+
+vector<DistFormSigmaRAS::TaskGroup> DistFormSigmaRAS::make_groups(shared_ptr<const DistRASCivec> sigma, const Sparse_IJ& sparseij) const {
+  shared_ptr<const RASDeterminants> det = sigma->det();
+  const int norb = det->norb();
+
+  vector<TaskGroup> out;
+  for (auto& ta : *det->stringspacea()) {
+    TaskGroup group;
+    group.ta = ta;
+    for (auto& i : sigma->local_blocks())
+      if (sigma->blockinfo(i)->stringsa()->tag() == ta->tag())
+        group.targets.push_back(i);
+    if (group.targets.empty()) continue;
+
+    // alpha excitations into ta, in the order of det->phia_ij(ij)
+    group.phi.resize(norb*(norb+1)/2);
+    for (int ij = 0; ij != group.phi.size(); ++ij) {
+      for (auto& phiblock : det->phia_ij(ij)) {
+        vector<tuple<size_t, int, size_t>> reduced_phi;
+        if (connected(phiblock.source_space(), ta, 1))
+          for (auto& phi : phiblock)
+            if (phi.target >= ta->offset() && phi.target < ta->offset() + ta->size())
+              reduced_phi.emplace_back(phi.source, phi.sign, phi.target - ta->offset());
+        group.phi[ij].push_back(move(reduced_phi));
+      }
+    }
+
+    set<int> sources;
+    auto add = [&](shared_ptr<const RASString> sa, shared_ptr<const RASString> sb) {
+      if (!det->allowed(sa, sb)) return;
+      const int iblock = block_index(det, sa, sb);
+      if (sigma->owner(iblock) >= 0 && !sigma->is_local(iblock))
+        sources.insert(iblock);
+    };
+
+    // alpha spaces that actually appear in the alpha-beta part
+    set<shared_ptr<const RASString>> sa_ab;
+    for (int ij = 0; ij != group.phi.size(); ++ij)
+      for (int k = 0; k != group.phi[ij].size(); ++k)
+        if (!group.phi[ij][k].empty())
+          sa_ab.insert(det->phia_ij(ij)[k].source_space());
+
+    for (auto& t : group.targets) {
+      shared_ptr<const RASString> tb = sigma->blockinfo(t)->stringsb();
+      for (auto& sa : *det->stringspacea())
+        if (connected(sa, ta, 2)) add(sa, tb);
+      for (auto& sb : *det->stringspaceb())
+        if (connected(sb, tb, 2)) add(ta, sb);
+      for (auto& sa : sa_ab)
+        for (auto& sb : *det->stringspaceb())
+          if (sparseij.sparse_matrix(tb->tag(), sb->tag())) add(sa, sb);
+    }
+    group.sources.assign(sources.begin(), sources.end());
+    out.push_back(move(group));
+  }
+  return out;
+}
+
+
+// sigma_2 in the Olsen paper, restricted to the target blocks of a group
+template <class SourceFunc>
+void DistFormSigmaRAS::sigma_aa(const TaskGroup& group, SourceFunc source, shared_ptr<const DistRASCivec> sigma, double* out, const double* g, const double* mo2e) const {
+  shared_ptr<const RASDeterminants> det = sigma->det();
+  const int norb = det->norb();
+  shared_ptr<const RASString> ta = group.ta;
+
+  Matrix F(det->lena(), batchsize_);
+
+  const int nbatches = (ta->size() - 1)/batchsize_ + 1;
+  for (int batch = 0; batch < nbatches; ++batch) {
+    const size_t batchstart = batch * batchsize_;
+    const size_t batchlength = min(static_cast<size_t>(batchsize_), ta->size() - batchstart);
+
+    F.zero();
+    for (size_t ia = 0; ia < batchlength; ++ia) {
+      double* const fdata = F.element_ptr(0, ia);
+      for (auto& iterkl : det->phia(ia + batchstart + ta->offset())) {
+        fdata[iterkl.source] += static_cast<double>(iterkl.sign) * g[iterkl.ij];
+        for (auto& iterij : det->phia(iterkl.source)) {
+          if (iterij.ij < iterkl.ij) continue;
+          const int ii = iterij.ij/norb;
+          const int jj = iterij.ij%norb;
+          const int kk = iterkl.ij/norb;
+          const int ll = iterkl.ij%norb;
+          fdata[iterij.source] += static_cast<double>(iterkl.sign*iterij.sign) * (iterkl.ij == iterij.ij ? 0.5 : 1.0) * mo2e[ii + kk*norb + norb*norb*(jj + ll * norb)];
+        }
+      }
+    }
+
+    // S(beta, alpha) += C(beta, alpha') * F(alpha', alpha) for every target block in this group
+    for (auto& t : group.targets) {
+      shared_ptr<const RASString> tb = sigma->blockinfo(t)->stringsb();
+      const size_t tlb = tb->size();
+      double* target = out + sigma->local_offset(t);
+      for (auto& sa : *det->stringspacea()) {
+        if (!connected(sa, ta, 2) || !det->allowed(sa, tb)) continue;
+        dgemm_("N", "N", tlb, batchlength, sa->size(), 1.0, source(block_index(det, sa, tb)), tlb,
+                         F.element_ptr(sa->offset(), 0), F.ndim(), 1.0, target + batchstart*tlb, tlb);
+      }
+    }
+  }
+}
+
+
+// sigma_1 in the Olsen paper. Instead of transposing the vector (as FormSigmaRAS does), F is contracted from the left.
+template <class SourceFunc>
+void DistFormSigmaRAS::sigma_bb(const TaskGroup& group, SourceFunc source, shared_ptr<const DistRASCivec> sigma, double* out, const double* g, const double* mo2e) const {
+  shared_ptr<const RASDeterminants> det = sigma->det();
+  const int norb = det->norb();
+  shared_ptr<const RASString> ta = group.ta;
+  const size_t tla = ta->size();
+
+  Matrix F(det->lenb(), batchsize_);
+
+  for (auto& t : group.targets) {
+    shared_ptr<const RASString> tb = sigma->blockinfo(t)->stringsb();
+    const size_t tlb = tb->size();
+    double* target = out + sigma->local_offset(t);
+
+    const int nbatches = (tlb - 1)/batchsize_ + 1;
+    for (int batch = 0; batch < nbatches; ++batch) {
+      const size_t batchstart = batch * batchsize_;
+      const size_t batchlength = min(static_cast<size_t>(batchsize_), tlb - batchstart);
+
+      F.zero();
+      for (size_t ib = 0; ib < batchlength; ++ib) {
+        double* const fdata = F.element_ptr(0, ib);
+        for (auto& iterkl : det->phib(ib + batchstart + tb->offset())) {
+          fdata[iterkl.source] += static_cast<double>(iterkl.sign) * g[iterkl.ij];
+          for (auto& iterij : det->phib(iterkl.source)) {
+            if (iterij.ij < iterkl.ij) continue;
+            const int ii = iterij.ij/norb;
+            const int jj = iterij.ij%norb;
+            const int kk = iterkl.ij/norb;
+            const int ll = iterkl.ij%norb;
+            fdata[iterij.source] += static_cast<double>(iterkl.sign*iterij.sign) * (iterkl.ij == iterij.ij ? 0.5 : 1.0) * mo2e[ii + kk*norb + norb*norb*(jj + ll * norb)];
+          }
+        }
+      }
+
+      // S(beta, alpha) += F(beta', beta)^T * C(beta', alpha)
+      for (auto& sb : *det->stringspaceb()) {
+        if (!connected(sb, tb, 2) || !det->allowed(ta, sb)) continue;
+        dgemm_("T", "N", batchlength, tla, sb->size(), 1.0, F.element_ptr(sb->offset(), 0), F.ndim(),
+                         source(block_index(det, ta, sb)), sb->size(), 1.0, target + batchstart, tlb);
+      }
+    }
+  }
+}
+
+
+template <class SourceFunc>
+void DistFormSigmaRAS::sigma_ab(const TaskGroup& group, SourceFunc source, shared_ptr<const DistRASCivec> sigma, double* out, const double* mo2e, const Sparse_IJ& sparseij) const {
+  shared_ptr<const RASDeterminants> det = sigma->det();
+  const int norb = det->norb();
+
+  vector<double> cprime;
+  vector<double> V;
+
+  for (int i = 0, ij = 0; i < norb; ++i) {
+    for (int j = 0; j <= i; ++j, ++ij) {
+      const double* mo2e_ij = mo2e + i + norb*norb*j;
+      for (auto& t : group.targets) {
+        shared_ptr<const RASString> tb = sigma->blockinfo(t)->stringsb();
+        const size_t tlb = tb->size();
+        double* target = out + sigma->local_offset(t);
+
+        for (int k = 0; k != group.phi[ij].size(); ++k) {
+          const vector<tuple<size_t, int, size_t>>& reduced_phi = group.phi[ij][k];
+          if (reduced_phi.empty()) continue;
+          shared_ptr<const RASString> sa = det->phia_ij(ij)[k].source_space();
+
+          for (auto& sb : *det->stringspaceb()) {
+            if (!det->allowed(sa, sb)) continue;
+            // F matrix in sparse format
+            const shared_ptr<SparseMatrix>& sparseF = sparseij.sparse_matrix(tb->tag(), sb->tag());
+            if (!sparseF) continue;
+            const size_t slb = sb->size();
+            const double* sdata = source(block_index(det, sa, sb));
+
+            sparseF->zero();
+            for (auto& iter : sparseij.sparse_data(tb->tag(), sb->tag()))
+              *iter.ptr += static_cast<double>(iter.sign) * mo2e_ij[norb*(iter.i + norb*norb*iter.j)];
+
+            // gather to fill in C'
+            cprime.assign(slb * reduced_phi.size(), 0.0);
+            int current = 0;
+            for (auto& p : reduced_phi)
+              blas::ax_plus_y_n(get<1>(p), sdata + slb*get<0>(p), slb, cprime.data() + current++*slb);
+
+            // compute V = F * C'
+            V.resize(tlb * reduced_phi.size());
+            dcsrmm_("N", tlb, reduced_phi.size(), slb, 1.0, sparseF->data(), sparseF->cols(), sparseF->rind(), cprime.data(), slb, 0.0, V.data(), tlb);
+
+            // scatter to add V to sigma
+            current = 0;
+            for (auto& p : reduced_phi)
+              blas::ax_plus_y_n(1.0, V.data() + tlb*current++, tlb, target + tlb*get<2>(p));
+          }
+        }
+      }
+    }
+  }
+}
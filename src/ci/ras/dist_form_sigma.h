@@ -0,0 +1,73 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: ras/dist_form_sigma.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __BAGEL_RAS_DIST_FORM_SIGMA_H
+#define __BAGEL_RAS_DIST_FORM_SIGMA_H
+
+#include <src/ci/ras/distcivector.h>
+#include <src/ci/ras/sparse_ij.h>
+#include <src/ci/fci/mofile.h>
+
+namespace bagel {
+
+// Sigma vector for block-distributed RAS CI vectors. Each process forms the sigma blocks it owns,
+// pulling only the remote CI blocks that are connected to them by the Hamiltonian. The target blocks
+// are processed in groups that share an alpha string space; the blocks needed by the next group
+// are requested (MPI_Rget) before the current group is computed.
+class DistFormSigmaRAS {
+  protected:
+    int batchsize_;
+
+    // target blocks sharing one alpha string space, and the remote blocks they need
+    struct TaskGroup {
+      std::shared_ptr<const RASString> ta;
+      std::vector<int> targets;
+      std::vector<int> sources;
+      // alpha excitations (source, sign, row of target) into ta for each ij and each element of phia_ij(ij)
+      std::vector<std::vector<std::vector<std::tuple<size_t, int, size_t>>>> phi;
+    };
+
+    std::vector<TaskGroup> make_groups(std::shared_ptr<const DistRASCivec> sigma, const Sparse_IJ& sparseij) const;
+
+    // Helper functions for sigma formation; source returns the data of a (local or fetched) block
+    template <class SourceFunc>
+    void sigma_aa(const TaskGroup& group, SourceFunc source, std::shared_ptr<const DistRASCivec> sigma, double* out, const double* g, const double* mo2e) const;
+    template <class SourceFunc>
+    void sigma_bb(const TaskGroup& group, SourceFunc source, std::shared_ptr<const DistRASCivec> sigma, double* out, const double* g, const double* mo2e) const;
+    template <class SourceFunc>
+    void sigma_ab(const TaskGroup& group, SourceFunc source, std::shared_ptr<const DistRASCivec> sigma, double* out, const double* mo2e, const Sparse_IJ& sparseij) const;
+
+  public:
+    DistFormSigmaRAS(const int b = 512) : batchsize_(b) {}
+
+    /// Applies Hamiltonian to cc using the provided MOFile, skipping the vectors marked as converged
+    std::vector<std::shared_ptr<DistRASCivec>> operator()(const std::vector<std::shared_ptr<DistRASCivec>>& ccvec, std::shared_ptr<const MOFile> jop, const std::vector<int>& conv) const;
+    /// Applies Hamiltonian to cc using the provided 1e and 2e integrals, skipping the vectors marked as converged
+    std::vector<std::shared_ptr<DistRASCivec>> operator()(const std::vector<std::shared_ptr<DistRASCivec>>& ccvec, std::shared_ptr<const Matrix> mo1e,
+                                                          std::shared_ptr<const Matrix> mo2e, const std::vector<int>& conv) const;
+};
+
+}
+
+#endif
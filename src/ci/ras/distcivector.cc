@@ -0,0 +1,252 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: ras/distcivector.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <map>
+#include <iomanip>
+#include <src/ci/ras/distcivector.h>
+
+using namespace std;
+using namespace bagel;
+
+
+template<typename DataType>
+DistRASCivector<DataType>::DistRASCivector(shared_ptr<const RASDeterminants> det) : RMAWindow<DataType>(), det_(det) {
+  distribute();
+  this->initialize();
+}
+
+
+template<typename DataType>
+DistRASCivector<DataType>::DistRASCivector(shared_ptr<const RASCivector<DataType>> civ) : RMAWindow<DataType>(), det_(civ->det()) {
+  distribute();
+  this->initialize();
+  // every process has the whole vector; just copy the local blocks
+  DataType* ldata = local_data();
+  for (auto& i : local_blocks_)
+    copy_n(civ->blocks()[i]->data(), civ->blocks()[i]->size(), ldata + offset_[i]);
+  fence_local();
+  mpi__->barrier();
+}
+
+
+// Blocks are assigned to processes largest first, each to the least loaded process.
+// The result is deterministic so that every process arrives at the same table.
+template<typename DataType>
+void DistRASCivector<DataType>::distribute() {
+  const int nblock = det_->blockinfo().size();
+  owner_.resize(nblock, -1);
+  offset_.resize(nblock, 0);
+
+  vector<int> order;
+  for (int i = 0; i != nblock; ++i)
+    if (!det_->blockinfo(i)->empty())
+      order.push_back(i);
+  stable_sort(order.begin(), order.end(), [this](const int a, const int b) { return det_->blockinfo(a)->size() > det_->blockinfo(b)->size(); });
+
+  vector<size_t> load(mpi__->size(), 0);
+  for (auto& i : order) {
+    const int rank = min_element(load.begin(), load.end()) - load.begin();
+    owner_[i] = rank;
+    load[rank] += det_->blockinfo(i)->size();
+  }
+
+  // local offsets are in the order of block indices
+  vector<size_t> current(mpi__->size(), 0);
+  for (int i = 0; i != nblock; ++i) {
+    if (owner_[i] < 0) continue;
+    offset_[i] = current[owner_[i]];
+    current[owner_[i]] += det_->blockinfo(i)->size();
+    if (owner_[i] == mpi__->rank())
+      local_blocks_.push_back(i);
+  }
+  localsize_ = load[mpi__->rank()];
+}
+
+
+template<typename DataType>
+tuple<size_t, size_t, size_t> DistRASCivector<DataType>::locate(const size_t iblock) const {
+  assert(owner_[iblock] >= 0);
+  return make_tuple(static_cast<size_t>(owner_[iblock]), offset_[iblock], det_->blockinfo(iblock)->size());
+}
+
+
+template<typename DataType>
+shared_ptr<RASCivector<DataType>> DistRASCivector<DataType>::civec() const {
+  auto out = make_shared<RASCivector<DataType>>(det_);
+  const DataType* ldata = local_data();
+  for (auto& i : local_blocks_)
+    copy_n(ldata + offset_[i], out->blocks()[i]->size(), out->blocks()[i]->data());
+  mpi__->allreduce(out->data(), global_size());
+  return out;
+}
+
+
+template<typename DataType>
+void DistRASCivector<DataType>::set_local(const bitset<nbit__>& abit, const bitset<nbit__>& bbit, const DataType a) {
+  const int iblock = block_index(abit, bbit);
+  if (!is_local(iblock)) return;
+  shared_ptr<const CIBlockInfo<RASString>> info = det_->blockinfo(iblock);
+  this->set_element(mpi__->rank(), offset_[iblock] + info->stringsa()->lexical_zero(abit) * info->lenb() + info->stringsb()->lexical_zero(bbit), a);
+}
+
+
+// Same as RAS::spin_impl, but only for the local blocks
+template<typename DataType>
+shared_ptr<DistRASCivector<DataType>> DistRASCivector<DataType>::spin() const {
+  const int norb = det_->norb();
+  auto connected = [](shared_ptr<const RASString> a, shared_ptr<const RASString> b) {
+    return abs(a->nholes() - b->nholes()) <= 1 && abs(a->nparticles() - b->nparticles()) <= 1;
+  };
+
+  auto out = make_shared<DistRASCivector<DataType>>(det_);
+  const DataType* cdata = local_data();
+  unique_ptr<DataType[]> buf(new DataType[max(localsize_, size_t(1))]);
+  fill_n(buf.get(), localsize_, 0.0);
+
+  for (auto& t : local_blocks_) {
+    shared_ptr<const RASString> ta = det_->blockinfo(t)->stringsa();
+    shared_ptr<const RASString> tb = det_->blockinfo(t)->stringsb();
+
+    // remote blocks that are connected to this block
+    map<int, unique_ptr<DataType[]>> buffers;
+    list<shared_ptr<RMATask<DataType>>> requests;
+    for (auto& sa : *det_->stringspacea())
+      for (auto& sb : *det_->stringspaceb()) {
+        if (!connected(sa, ta) || !connected(sb, tb) || !det_->allowed(sa, sb)) continue;
+        const int iblock = det_->block_address(sa->nholes(), sb->nholes(), sa->nparticles(), sb->nparticles());
+        if (owner_[iblock] < 0 || is_local(iblock)) continue;
+        buffers.emplace(iblock, unique_ptr<DataType[]>(new DataType[det_->blockinfo(iblock)->size()]));
+        requests.push_back(this->rma_rget(buffers[iblock].get(), iblock));
+      }
+    for (auto& r : requests)
+      r->wait();
+
+    DataType* target = buf.get() + offset_[t];
+    for (auto& abit : *ta) {
+      for (auto& iter : det_->phia(det_->template lexical_offset<0>(abit))) {
+        const int ii = iter.ij / norb;
+        const int jj = iter.ij % norb;
+        bitset<nbit__> mask1; mask1.set(ii); mask1.set(jj);
+        bitset<nbit__> mask2; mask2.set(ii);
+        bitset<nbit__> maskij; maskij.set(ii); maskij.flip(jj);
+
+        const bitset<nbit__> sabit = det_->string_bits_a(iter.source);
+        DataType* outelement = target + ta->lexical_zero(abit) * tb->size();
+        for (auto& btstring : *tb) {
+          if (((btstring & mask1) ^ mask2).none()) { // equivalent to "btstring[ii] && (ii == jj || !btstring[jj])"
+            const bitset<nbit__> bsostring = btstring ^ maskij;
+            if (det_->allowed(sabit, bsostring)) {
+              const int iblock = block_index(sabit, bsostring);
+              shared_ptr<const CIBlockInfo<RASString>> info = det_->blockinfo(iblock);
+              const DataType* source = is_local(iblock) ? cdata + offset_[iblock] : buffers.at(iblock).get();
+              *outelement -= static_cast<double>(iter.sign * det_->sign(bsostring, ii, jj))
+                           * source[info->stringsa()->lexical_zero(sabit) * info->lenb() + info->stringsb()->lexical_zero(bsostring)];
+            }
+          }
+          ++outelement;
+        }
+      }
+    }
+  }
+  out->accumulate_buffer(1.0, buf);
+
+  const double sz = static_cast<double>(det_->nspin()) * 0.5;
+  out->ax_plus_y(sz*sz + sz + static_cast<double>(det_->neleb()), *this);
+  return out;
+}
+
+
+template<typename DataType>
+void DistRASCivector<DataType>::spin_decontaminate(const double thresh) {
+  const int nspin = det_->nspin();
+  const int max_spin = det_->nelea() + det_->neleb();
+  const double expectation = static_cast<double>(nspin * (nspin + 2)) * 0.25;
+
+  shared_ptr<DistRASCivector<DataType>> S2 = spin();
+
+  int k = nspin + 2;
+  while (fabs(detail::real(dot_product(*S2)) - expectation) > thresh) {
+    if (k > max_spin) throw runtime_error("Spin decontamination failed.");
+    const double factor = -4.0/(static_cast<double>(k*(k+2)));
+    ax_plus_y(factor, *S2);
+    normalize();
+
+    S2 = spin();
+    k += 2;
+  }
+}
+
+
+// elements above the threshold are collected on rank 0 (as in DistCivector::print)
+template<typename DataType>
+void DistRASCivector<DataType>::print(const double thresh) const {
+  vector<DataType> data;
+  vector<size_t> abits;
+  vector<size_t> bbits;
+
+  const DataType* d = local_data();
+  for (auto& i : local_blocks_) {
+    const DataType* element = d + offset_[i];
+    for (auto& abit : *det_->blockinfo(i)->stringsa())
+      for (auto& bbit : *det_->blockinfo(i)->stringsb()) {
+        if (abs(*element) > thresh) {
+          data.push_back(*element);
+          abits.push_back(det_->template lexical_offset<0>(abit));
+          bbits.push_back(det_->template lexical_offset<1>(bbit));
+        }
+        ++element;
+      }
+  }
+
+  vector<size_t> nelements(mpi__->size(), 0);
+  const size_t nn = data.size();
+  mpi__->allgather(&nn, 1, nelements.data(), 1);
+
+  const size_t chunk = *max_element(nelements.begin(), nelements.end());
+  data.resize(chunk, 0);
+  abits.resize(chunk, 0);
+  bbits.resize(chunk, 0);
+
+  vector<DataType> alldata(chunk * mpi__->size());
+  mpi__->allgather(data.data(), chunk, alldata.data(), chunk);
+  vector<size_t> allabits(chunk * mpi__->size());
+  mpi__->allgather(abits.data(), chunk, allabits.data(), chunk);
+  vector<size_t> allbbits(chunk * mpi__->size());
+  mpi__->allgather(bbits.data(), chunk, allbbits.data(), chunk);
+
+  if (mpi__->rank() == 0) {
+    multimap<double, tuple<DataType, bitset<nbit__>, bitset<nbit__>>> tmp;
+    for (size_t i = 0; i != chunk * mpi__->size(); ++i)
+      if (alldata[i] != 0.0)
+        tmp.emplace(-abs(alldata[i]), make_tuple(alldata[i], det_->string_bits_a(allabits[i]), det_->string_bits_b(allbbits[i])));
+
+    for (auto& i : tmp)
+      cout << "       " << print_bit(get<1>(i.second), get<2>(i.second), det_->ras(0))
+                << "-" << print_bit(get<1>(i.second), get<2>(i.second), det_->ras(0), det_->ras(0)+det_->ras(1))
+                << "-" << print_bit(get<1>(i.second), get<2>(i.second), det_->ras(0)+det_->ras(1), det_->norb())
+                << "  " << setprecision(10) << setw(15) << get<0>(i.second) << endl;
+  }
+}
+
+template class bagel::DistRASCivector<double>;
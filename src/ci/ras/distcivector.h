@@ -0,0 +1,142 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: ras/distcivector.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __BAGEL_RAS_DISTCIVECTOR_H
+#define __BAGEL_RAS_DISTCIVECTOR_H
+
+#include <bagel_config.h>
+#include <src/ci/ras/civector.h>
+#include <src/util/parallel/mpi_interface.h>
+#include <src/util/parallel/rmawindow.h>
+
+namespace bagel {
+
+// RAS CI vector whose blocks (see RASCivector) are distributed over processes.
+// Each block is owned by one process as a whole; the key used in the RMA functions is the block index in det->blockinfo().
+template<typename DataType>
+class DistRASCivector : public RMAWindow<DataType> {
+  public:
+    using DetType = RASDeterminants;
+    using LocalizedType = std::false_type;
+
+    using RMAWindow<DataType>::scale;
+    using RMAWindow<DataType>::ax_plus_y;
+    using RMAWindow<DataType>::dot_product;
+    using RMAWindow<DataType>::fence;
+    using RMAWindow<DataType>::fence_local;
+    using RMAWindow<DataType>::local_data;
+
+  protected:
+    mutable std::shared_ptr<const RASDeterminants> det_;
+
+    // owner of each block (-1 for empty blocks) and the offset of the block in the buffer of the owner
+    std::vector<int> owner_;
+    std::vector<size_t> offset_;
+    // blocks owned by this process
+    std::vector<int> local_blocks_;
+    size_t localsize_;
+
+    void distribute();
+
+  public:
+    DistRASCivector(std::shared_ptr<const RASDeterminants> det);
+    DistRASCivector(std::shared_ptr<const RASCivector<DataType>> civ);
+
+    DistRASCivector(const DistRASCivector<DataType>& o) : DistRASCivector(o.det()) { RMAWindow<DataType>::operator=(o); }
+    DistRASCivector(std::shared_ptr<const DistRASCivector<DataType>> o) : DistRASCivector(*o) {}
+
+    // functions required by RMAWindow
+    bool is_local(const size_t iblock) const override { return owner_[iblock] == mpi__->rank(); }
+    std::tuple<size_t, size_t, size_t> locate(const size_t iblock) const override;
+    size_t localsize() const override { return localsize_; }
+
+    std::shared_ptr<DistRASCivector<DataType>> clone() const { return std::make_shared<DistRASCivector<DataType>>(det_); }
+    std::shared_ptr<DistRASCivector<DataType>> copy() const { return std::make_shared<DistRASCivector<DataType>>(*this); }
+
+    size_t size() const { return localsize_; }
+    size_t global_size() const { return det_->size(); }
+
+    int nblocks() const { return owner_.size(); }
+    int owner(const int iblock) const { return owner_[iblock]; }
+    // offset of a local block in local_data()
+    size_t local_offset(const int iblock) const { assert(is_local(iblock)); return offset_[iblock]; }
+    const std::vector<int>& local_blocks() const { return local_blocks_; }
+    std::shared_ptr<const CIBlockInfo<RASString>> blockinfo(const int iblock) const { return det_->blockinfo(iblock); }
+    // index of the block to which a determinant belongs
+    int block_index(const std::bitset<nbit__>& abit, const std::bitset<nbit__>& bbit) const {
+      return det_->block_address(det_->nholes(abit), det_->nholes(bbit), det_->nparticles(abit), det_->nparticles(bbit));
+    }
+    // sets an element if the determinant is in a local block; not collective
+    void set_local(const std::bitset<nbit__>& abit, const std::bitset<nbit__>& bbit, const DataType a);
+
+    DataType* data() { return local_data(); }
+    const DataType* data() const { return local_data(); }
+
+    void synchronize(const int root = 0) { /* do nothing */ }
+
+    // gathers the whole vector on every process (collective)
+    std::shared_ptr<RASCivector<DataType>> civec() const;
+    std::shared_ptr<const RASDeterminants> det() const { return det_; }
+    void set_det(std::shared_ptr<const RASDeterminants> d) { det_ = d; }
+
+    // utility functions
+    double norm() const { return std::sqrt(detail::real(dot_product(*this))); }
+    double variance() const { return detail::real(dot_product(*this)) / global_size(); }
+    double rms() const { return std::sqrt(variance()); }
+    void project_out(std::shared_ptr<const DistRASCivector<DataType>> o) { ax_plus_y(-detail::conj(dot_product(*o)), *o); }
+
+    double orthog(std::list<std::shared_ptr<const DistRASCivector<DataType>>> c) {
+      for (auto& iter : c)
+        project_out(iter);
+      return normalize();
+    }
+
+    double orthog(std::shared_ptr<const DistRASCivector<DataType>> o) {
+      return orthog(std::list<std::shared_ptr<const DistRASCivector<DataType>>>{o});
+    }
+
+    double normalize() {
+      const double norm = this->norm();
+      const double scal = (norm*norm<1.0e-60 ? 0.0 : 1.0/norm);
+      scale(static_cast<DataType>(scal));
+      return norm;
+    }
+
+    // spin operators act across blocks; each process forms its own blocks, fetching the remote blocks
+    // that are connected to them by one replacement in each of alpha and beta strings (collective)
+    std::shared_ptr<DistRASCivector<DataType>> spin() const;
+    DataType spin_expectation() const { return dot_product(*spin()); }
+    void spin_decontaminate(const double thresh = 1.0e-8);
+
+    void print(const double thresh = 0.05) const;
+};
+
+extern template class DistRASCivector<double>;
+
+using DistRASCivec = DistRASCivector<double>;
+using DistRASDvec = Dvector_base<DistRASCivec>;
+
+}
+
+#endif
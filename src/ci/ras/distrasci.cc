@@ -0,0 +1,411 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: ras/distrasci.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <src/ci/fci/modelci.h>
+#include <src/ci/ras/distrasci.h>
+#include <src/ci/ras/dist_form_sigma.h>
+#include <src/ci/ras/denomtask.h>
+#include <src/util/math/davidson.h>
+
+using namespace std;
+using namespace bagel;
+
+DistRASCI::DistRASCI(shared_ptr<const PTree> idat, shared_ptr<const Geometry> g, shared_ptr<const Reference> r) : RASCI(idat, g, r, false) {
+#ifndef HAVE_MPI_H
+  throw logic_error("DistRASCI can be used only with MPI");
+#endif
+  cout << "    * Parallel algorithm will be used." << endl << endl;
+  update(ref_->coeff());
+}
+
+
+// same as RASCI::const_denom except that only the local blocks are made
+void DistRASCI::const_denom() {
+  Timer denom_t;
+  unique_ptr<double[]> h(new double[norb_]);
+  unique_ptr<double[]> jop(new double[norb_*norb_]);
+  unique_ptr<double[]> kop(new double[norb_*norb_]);
+
+  for (int i = 0; i != norb_; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      jop[i*norb_+j] = jop[j*norb_+i] = 0.5*jop_->mo2e_hz(j, i, j, i);
+      kop[i*norb_+j] = kop[j*norb_+i] = 0.5*jop_->mo2e_hz(j, i, i, j);
+    }
+    h[i] = jop_->mo1e(i,i);
+  }
+  denom_t.tick_print("jop, kop");
+
+  dist_denom_ = make_shared<DistRASCivec>(det_);
+  unique_ptr<double[]> buf(new double[max(dist_denom_->size(), size_t(1))]);
+
+  size_t tasksize = 0;
+  for (auto& i : dist_denom_->local_blocks()) tasksize += dist_denom_->blockinfo(i)->lena();
+  TaskQueue<RAS::DenomTask> tasks(tasksize);
+
+  for (auto& i : dist_denom_->local_blocks()) {
+    double* iter = buf.get() + dist_denom_->local_offset(i);
+    for (auto& ia : *dist_denom_->blockinfo(i)->stringsa()) {
+      tasks.emplace_back(iter, ia, dist_denom_->blockinfo(i)->stringsb(), jop.get(), kop.get(), h.get());
+      iter += dist_denom_->blockinfo(i)->lenb();
+    }
+  }
+  tasks.compute();
+
+  dist_denom_->accumulate_buffer(1.0, buf);
+  denom_t.tick_print("denom");
+}
+
+
+// returns seed determinants for initial guess; each process looks into its blocks, and the results are merged (see DistFCI::detseeds)
+vector<pair<bitset<nbit__>, bitset<nbit__>>> DistRASCI::detseeds(const int ndet) const {
+  // lexical offsets of beta and alpha strings; negative energies mark the empty slots
+  multimap<double, pair<size_t, size_t>> tmp;
+  for (int i = 0; i != ndet; ++i)
+    tmp.emplace(-1.0e10*(1+i), make_pair(0, 0));
+
+  const double* denom = dist_denom_->local_data();
+  for (auto& i : dist_denom_->local_blocks()) {
+    const double* diter = denom + dist_denom_->local_offset(i);
+    for (auto& abit : *dist_denom_->blockinfo(i)->stringsa()) {
+      for (auto& bbit : *dist_denom_->blockinfo(i)->stringsb()) {
+        const double din = -*diter++;
+        if (tmp.begin()->first < din && in_irrep(abit, bbit)) {
+          tmp.emplace(din, make_pair(det_->lexical_offset<1>(bbit), det_->lexical_offset<0>(abit)));
+          tmp.erase(tmp.begin());
+        }
+      }
+    }
+  }
+
+  vector<size_t> aarray, barray;
+  vector<double> en;
+  for (auto iter = tmp.rbegin(); iter != tmp.rend(); ++iter) {
+    aarray.push_back(iter->second.second);
+    barray.push_back(iter->second.first);
+    en.push_back(iter->first);
+  }
+
+  vector<size_t> aall(mpi__->size()*ndet);
+  vector<size_t> ball(mpi__->size()*ndet);
+  vector<double> eall(mpi__->size()*ndet);
+  mpi__->allgather(aarray.data(), ndet, aall.data(), ndet);
+  mpi__->allgather(barray.data(), ndet, ball.data(), ndet);
+  mpi__->allgather(en.data(),     ndet, eall.data(), ndet);
+
+  tmp.clear();
+  for (int i = 0; i != aall.size(); ++i)
+    tmp.emplace(eall[i], make_pair(ball[i], aall[i]));
+
+  // sync'ing to make sure the consistency
+  vector<double> eout(ndet);
+  auto c = tmp.rbegin();
+  for (int i = 0; i != ndet; ++i, ++c) {
+    ball[i] = c->second.first;
+    aall[i] = c->second.second;
+    eout[i] = c->first;
+  }
+  mpi__->broadcast(aall.data(), ndet, 0);
+  mpi__->broadcast(ball.data(), ndet, 0);
+  mpi__->broadcast(eout.data(), ndet, 0);
+
+  // empty slots are returned as empty strings, as in RASCI::detseeds
+  vector<pair<bitset<nbit__>, bitset<nbit__>>> out;
+  for (int i = 0; i != ndet; ++i)
+    if (eout[i] > -1.0e10)
+      out.push_back({det_->string_bits_b(ball[i]), det_->string_bits_a(aall[i])});
+    else
+      out.push_back({bitset<nbit__>(0), bitset<nbit__>(0)});
+  return out;
+}
+
+
+// same as RASCI::generate_guess, but the elements are set in the local blocks
+void DistRASCI::generate_guess(const int nspin, const int nstate, vector<shared_ptr<DistRASCivec>>& out) {
+  int ndet = nstate_*10;
+  start_over:
+  vector<pair<bitset<nbit__>, bitset<nbit__>>> bits = detseeds(ndet);
+
+  // Spin adapt detseeds
+  int oindex = 0;
+  vector<bitset<nbit__>> done;
+  for (auto& it : bits) {
+    bitset<nbit__> alpha = it.second;
+    bitset<nbit__> beta = it.first;
+    bitset<nbit__> open_bit = (alpha^beta);
+
+    // This can happen if all possible determinants are checked without finding nstate acceptable ones.
+    if (alpha.count() + beta.count() != nelea_ + neleb_)
+      throw logic_error("DistRASCI::generate_guess produced an invalid determinant.  Check the number of states being requested.");
+
+    // make sure that we have enough unpaired alpha
+    const int unpairalpha = (alpha ^ (alpha & beta)).count();
+    const int unpairbeta  = (beta ^ (alpha & beta)).count();
+    if (unpairalpha-unpairbeta < nelea_-neleb_) continue;
+
+    // check if this orbital configuration is already used
+    if (find(done.begin(), done.end(), open_bit) != done.end()) continue;
+    done.push_back(open_bit);
+
+    pair<vector<tuple<bitset<nbit__>, bitset<nbit__>, int>>, double> adapt = det()->spin_adapt(nelea_-neleb_, alpha, beta);
+    const double fac = adapt.second;
+    for (auto& iter : adapt.first)
+      out[oindex]->set_local(get<1>(iter), get<0>(iter), get<2>(iter)*fac);
+    out[oindex]->spin_decontaminate();
+
+    cout << "     guess " << setw(3) << oindex << ":   closed " <<
+          setw(20) << left << print_bit(alpha&beta, det()->norb()) << " open " << setw(20) << print_bit(open_bit, det()->norb()) << right << endl;
+
+    ++oindex;
+    if (oindex == nstate) break;
+  }
+  if (oindex < nstate) {
+    for (auto& io : out) io->zero();
+    ndet *= 4;
+    goto start_over;
+  }
+  cout << endl;
+}
+
+
+// same as RASCI::model_guess; the lowest diagonal elements are collected from all processes (see DistFCI::model_guess)
+void DistRASCI::model_guess(vector<shared_ptr<DistRASCivec>>& out) {
+  multimap<double, pair<size_t, size_t>> ordered_elements;
+  const double* denom = dist_denom_->local_data();
+  for (auto& i : dist_denom_->local_blocks()) {
+    const double* d = denom + dist_denom_->local_offset(i);
+    for (auto& abit : *dist_denom_->blockinfo(i)->stringsa())
+      for (auto& bbit : *dist_denom_->blockinfo(i)->stringsb()) {
+        if (in_irrep(abit, bbit))
+          ordered_elements.emplace(*d, make_pair(det_->lexical_offset<0>(abit), det_->lexical_offset<1>(bbit)));
+        ++d;
+      }
+  }
+
+  vector<double> energies;
+  vector<size_t> aarray, barray;
+  double last_value = 0.0;
+  for (auto& p : ordered_elements) {
+    if (energies.size() >= nguess_ && p.first != last_value)
+      break;
+    energies.push_back(p.first);
+    aarray.push_back(p.second.first);
+    barray.push_back(p.second.second);
+  }
+
+  vector<size_t> nelements(mpi__->size(), 0);
+  const size_t nn = energies.size();
+  mpi__->allgather(&nn, 1, nelements.data(), 1);
+
+  const size_t chunk = *max_element(nelements.begin(), nelements.end());
+  energies.resize(chunk, 0.0);
+  aarray.resize(chunk, 0);
+  barray.resize(chunk, 0);
+
+  vector<double> allenergies(chunk * mpi__->size(), 0.0);
+  mpi__->allgather(energies.data(), chunk, allenergies.data(), chunk);
+  vector<size_t> allalpha(chunk * mpi__->size());
+  mpi__->allgather(aarray.data(), chunk, allalpha.data(), chunk);
+  vector<size_t> allbeta(chunk * mpi__->size());
+  mpi__->allgather(barray.data(), chunk, allbeta.data(), chunk);
+
+  ordered_elements.clear();
+  for (int rank = 0; rank != mpi__->size(); ++rank)
+    for (size_t i = rank*chunk; i != rank*chunk + nelements[rank]; ++i)
+      ordered_elements.emplace(allenergies[i], make_pair(allalpha[i], allbeta[i]));
+
+  vector<pair<bitset<nbit__>, bitset<nbit__>>> basis;
+  last_value = 0.0;
+  for (auto& p : ordered_elements) {
+    if (basis.size() >= nguess_ && p.first != last_value)
+      break;
+    basis.emplace_back(det_->string_bits_a(p.second.first), det_->string_bits_b(p.second.second));
+  }
+  const int nguess = basis.size();
+
+  shared_ptr<Matrix> spin = make_shared<CISpin>(basis, norb_);
+  VectorB eigs(nguess);
+  spin->diagonalize(eigs);
+
+  int start, end;
+  const double target_spin = 0.25 * static_cast<double>(det_->nspin()*(det_->nspin()+2));
+  for (start = 0; start < nguess; ++start)
+    if (fabs(eigs(start) - target_spin) < 1.0e-8) break;
+  for (end = start; end < nguess; ++end)
+    if (fabs(eigs(end) - target_spin) > 1.0e-8) break;
+
+  if ((end-start) >= nstate_) {
+    const MatView coeffs = spin->slice(start, end);
+
+    shared_ptr<Matrix> hamiltonian = make_shared<CIHamiltonian>(basis, jop_);
+    hamiltonian = make_shared<Matrix>(coeffs % *hamiltonian * coeffs);
+    hamiltonian->diagonalize(eigs);
+
+    auto coeffs1 = (coeffs * *hamiltonian).slice_copy(0, nstate_);
+    mpi__->broadcast(coeffs1->data(), coeffs1->ndim() * coeffs1->mdim(), 0);
+    for (int i = 0; i < nguess; ++i)
+      for (int j = 0; j < nstate_; ++j)
+        out[j]->set_local(basis[i].first, basis[i].second, coeffs1->element(i, j));
+  }
+  else if (nguess_ >= det_->size()) {
+    stringstream message;
+    message << "Asking for " << nstate_ << " states, but there seems to only be " << end-start << " states with the right spin.";
+    throw runtime_error(message.str());
+  }
+  else {
+    nguess_ *= 2;
+    model_guess(out);
+  }
+}
+
+
+void DistRASCI::project_irrep(shared_ptr<DistRASCivec> cc) const {
+  if (irrep_ < 0) return;
+  unique_ptr<double[]> buf(new double[max(cc->size(), size_t(1))]);
+  copy_n(cc->local_data(), cc->size(), buf.get());
+  for (auto& i : cc->local_blocks()) {
+    double* d = buf.get() + cc->local_offset(i);
+    for (auto& abit : *cc->blockinfo(i)->stringsa())
+      for (auto& bbit : *cc->blockinfo(i)->stringsb()) {
+        if (!in_irrep(abit, bbit)) *d = 0.0;
+        ++d;
+      }
+  }
+  cc->zero();
+  cc->accumulate_buffer(1.0, buf);
+}
+
+
+void DistRASCI::compute() {
+  Timer pdebug(0);
+
+  if (irrep_ >= 0)
+    init_symmetry(jop_->coeff());
+
+  // Creating an initial CI vector
+  vector<shared_ptr<DistRASCivec>> cc(nstate_);
+  for (auto& i : cc)
+    i = make_shared<DistRASCivec>(det_);
+
+  // find determinants that have small diagonal energies
+  if (nguess_ <= nstate_)
+    generate_guess(nelea_-neleb_, nstate_, cc);
+  else
+    model_guess(cc);
+  pdebug.tick_print("guess generation");
+
+  // nuclear energy retrieved from geometry
+  const double nuc_core = geom_->nuclear_repulsion() + jop_->core_energy();
+
+  // Davidson utility
+  DavidsonDiag<DistRASCivec> davidson(nstate_, davidson_subspace_);
+  davidson.set_spill(davidson_incore_, davidson_single_, davidson_scratch_, thresh_);
+
+  // Object in charge of forming sigma vector
+  DistFormSigmaRAS form_sigma(batchsize_);
+
+  // main iteration starts here
+  cout << "  === RAS-CI iteration ===" << endl << endl;
+  // 0 means not converged
+  vector<int> conv(nstate_,0);
+
+  for (int iter = 0; iter != max_iter_; ++iter) {
+    Timer fcitime;
+
+    // form a sigma vector given cc
+    vector<shared_ptr<DistRASCivec>> sigma = form_sigma(cc, jop_, conv);
+    pdebug.tick_print("sigma vector");
+
+    vector<shared_ptr<const DistRASCivec>> ccn, sigman;
+    for (int i = 0; i < nstate_; ++i) {
+      ccn.push_back(conv[i] ? nullptr : cc[i]);
+      sigman.push_back(conv[i] ? nullptr : sigma[i]);
+    }
+    const vector<double> energies = davidson.compute(ccn, sigman);
+
+    // get residual and new vectors
+    vector<shared_ptr<DistRASCivec>> errvec = davidson.residual();
+    pdebug.tick_print("davidson");
+
+    // compute errors
+    vector<double> errors;
+    for (int i = 0; i != nstate_; ++i) {
+      errors.push_back(errvec[i]->rms());
+      conv[i] = static_cast<int>(errors[i] < thresh_);
+    }
+    pdebug.tick_print("error");
+
+    if (!*min_element(conv.begin(), conv.end())) {
+      // denominator scaling on the local blocks
+      for (int ist = 0; ist != nstate_; ++ist) {
+        if (conv[ist]) continue;
+        shared_ptr<DistRASCivec> c = errvec[ist]->clone();
+        const size_t size = c->size();
+        unique_ptr<double[]> target_array(new double[max(size, size_t(1))]);
+        const double* source_array = errvec[ist]->local_data();
+        const double* denom_array = dist_denom_->local_data();
+        const double en = energies[ist];
+        transform(source_array, source_array + size, denom_array, target_array.get(), [&en] (const double cc, const double den) { return cc / min(en - den, -0.1); });
+        c->accumulate_buffer(1.0, target_array);
+        project_irrep(c);
+        c->normalize();
+        c->spin_decontaminate();
+        cc[ist] = c;
+      }
+    }
+    pdebug.tick_print("denominator");
+
+    // printing out
+    if (nstate_ != 1 && iter) cout << endl;
+    for (int i = 0; i != nstate_; ++i) {
+      cout << setw(7) << iter << setw(3) << i << setw(2) << (conv[i] ? "*" : " ")
+                              << setw(17) << fixed << setprecision(8) << energies[i]+nuc_core << "   "
+                              << setw(10) << scientific << setprecision(2) << errors[i] << fixed << setw(10) << setprecision(2)
+                              << fcitime.tick() << endl;
+      energy_[i] = energies[i]+nuc_core;
+    }
+    if (*min_element(conv.begin(), conv.end())) break;
+  }
+  // main iteration ends here
+
+  dist_cc_ = davidson.civec();
+  for (int istate = 0; istate < nstate_; ++istate) {
+    const double s2 = dist_cc_[istate]->spin_expectation();
+    cout << endl << "     * ci vector " << setw(3) << istate << ", <S^2> = " << setw(6) << setprecision(4) << s2
+                 << ", E = " << setw(17) << fixed << setprecision(8) << energy_[istate] << endl;
+    dist_cc_[istate]->print(print_thresh_);
+  }
+}
+
+
+shared_ptr<const RASCivec> DistRASCI::denom() const {
+  return dist_denom_->civec();
+}
+
+
+shared_ptr<RASDvec> DistRASCI::civectors() const {
+  vector<shared_ptr<RASCivec>> civecs;
+  for (auto& i : dist_cc_)
+    civecs.push_back(i->civec());
+  return make_shared<RASDvec>(civecs);
+}
@@ -0,0 +1,63 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: ras/distrasci.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __BAGEL_RAS_DISTRASCI_H
+#define __BAGEL_RAS_DISTRASCI_H
+
+#include <src/ci/ras/rasci.h>
+#include <src/ci/ras/distcivector.h>
+
+namespace bagel {
+
+// Parallel RASCI in which the CI vectors are distributed over processes block by block (see DistRASCivector and DistFormSigmaRAS).
+// As in DistFCI, the denominator, guess vectors and converged vectors are also distributed; the integrals are replicated.
+class DistRASCI : public RASCI {
+  protected:
+    std::shared_ptr<DistRASCivec> dist_denom_;
+    std::vector<std::shared_ptr<DistRASCivec>> dist_cc_;
+
+    // makes the denominator only for the local blocks
+    void const_denom() override;
+
+    // guess vectors from the local parts of the denominator
+    void generate_guess(const int nspin, const int nstate, std::vector<std::shared_ptr<DistRASCivec>>& out);
+    void model_guess(std::vector<std::shared_ptr<DistRASCivec>>& out);
+    std::vector<std::pair<std::bitset<nbit__>, std::bitset<nbit__>>> detseeds(const int ndet) const;
+
+    // zero out determinants outside of the target irrep in the local blocks
+    void project_irrep(std::shared_ptr<DistRASCivec> cc) const;
+
+  public:
+    DistRASCI(std::shared_ptr<const PTree>, std::shared_ptr<const Geometry>, std::shared_ptr<const Reference>);
+
+    void compute() override;
+
+    // these gather the distributed vectors on every process (collective)
+    std::shared_ptr<const RASCivec> denom() const override;
+    std::shared_ptr<RASDvec> civectors() const override;
+};
+
+}
+
+#endif
@@ -27,14 +27,16 @@
 #include <src/ci/ras/form_sigma.h>
 #include <src/util/combination.hpp>
 #include <src/util/math/davidson.h>
+#include <src/mat1e/overlap.h>
 
 using namespace std;
 using namespace bagel;
 
-RASCI::RASCI(shared_ptr<const PTree> idat, shared_ptr<const Geometry> g, shared_ptr<const Reference> r)
- : Method(idat, g, r) {
+RASCI::RASCI(shared_ptr<const PTree> idat, shared_ptr<const Geometry> g, shared_ptr<const Reference> r, const bool update_ints)
+ : Method(idat, g, r), irrep_(-1) {
   common_init();
-  update(ref_->coeff());
+  if (update_ints)
+    update(ref_->coeff());
 }
 
 void RASCI::common_init() {
@@ -43,6 +45,9 @@ void RASCI::common_init() {
 //const bool frozen = idata_->get<bool>("frozen", false);
   max_iter_ = idata_->get<int>("maxiter", 100);
   davidson_subspace_ = idata_->get<int>("davidson_subspace", 20);
+  davidson_incore_ = idata_->get<int>("davidson_incore", -1);
+  davidson_single_ = idata_->get<bool>("davidson_single", false);
+  davidson_scratch_ = idata_->get<string>("davidson_scratch", ".");
   thresh_ = idata_->get<double>("thresh", 1.0e-8);
   print_thresh_ = idata_->get<double>("print_thresh", 0.05);
 
@@ -104,6 +109,50 @@ void RASCI::common_init() {
 
   // construct a determinant space in which this RASCI will be performed.
   det_ = make_shared<const RASDeterminants>(ras_, nelea_, neleb_, max_holes_, max_particles_);
+
+  // only determinants in the target irrep are used when point-group symmetry is available
+  const string irrep = to_lower(idata_->get<string>("irrep", ""));
+  if (!irrep.empty()) {
+    if (geom_->nirrep() == 1)
+      throw runtime_error("Target irrep is specified for RASCI, but point-group symmetry is not used");
+    for (int i = 0; i != geom_->nirrep(); ++i)
+      if (geom_->plist()->irrep_name(i) == irrep)
+        irrep_ = i;
+    if (irrep_ < 0)
+      throw runtime_error("Irrep " + irrep + " is not found in point group " + geom_->plist()->sym());
+  }
+}
+
+
+void RASCI::init_symmetry(shared_ptr<const Matrix> coeff) {
+  shared_ptr<const Petite> plist = geom_->plist();
+  orbital_parity_.clear();
+  for (auto& i : plist->orbital_irreps(geom_->atoms(), *coeff->slice_copy(ncore_, ncore_+norb_), Overlap(geom_)))
+    orbital_parity_.push_back(plist->irrep_parity(i));
+  cout << "    * Determinants are restricted to irrep " << plist->irrep_name(irrep_) << endl << endl;
+}
+
+
+bool RASCI::in_irrep(const bitset<nbit__>& abit, const bitset<nbit__>& bbit) const {
+  if (irrep_ < 0) return true;
+  int parity = 0;
+  for (int i = 0; i != norb_; ++i)
+    parity ^= (abit[i] ? orbital_parity_[i] : 0) ^ (bbit[i] ? orbital_parity_[i] : 0);
+  return geom_->plist()->irrep(parity) == irrep_;
+}
+
+
+void RASCI::project_irrep(shared_ptr<RASCivec> cc) const {
+  if (irrep_ < 0) return;
+  for (auto& b : cc->blocks()) {
+    if (!b) continue;
+    double* d = b->data();
+    for (auto& abit : *b->stringsa())
+      for (auto& bbit : *b->stringsb()) {
+        if (!in_irrep(abit, bbit)) *d = 0.0;
+        ++d;
+      }
+  }
 }
 
 void RASCI::model_guess(shared_ptr<RASDvec>& out) {
@@ -113,7 +162,9 @@ void RASCI::model_guess(shared_ptr<RASDvec>& out) {
     const double* d = b->data();
     for (auto& abit : *b->stringsa()) {
       for (auto& bbit : *b->stringsb()) {
-        ordered_elements.emplace(*d++, make_pair(abit, bbit));
+        if (in_irrep(abit, bbit))
+          ordered_elements.emplace(*d, make_pair(abit, bbit));
+        ++d;
       }
     }
   }
@@ -235,7 +286,7 @@ vector<pair<bitset<nbit__> , bitset<nbit__>>> RASCI::detseeds(const int ndet) {
     for (auto& aiter : *iblock->stringsa()) {
       for (auto& biter : *iblock->stringsb()) {
         const double din = -(*diter);
-        if (tmp.begin()->first < din) {
+        if (tmp.begin()->first < din && in_irrep(aiter, biter)) {
           tmp.emplace(din, make_pair(biter, aiter));
           tmp.erase(tmp.begin());
         }
@@ -260,6 +311,9 @@ void RASCI::print_header() const {
 void RASCI::compute() {
   Timer pdebug(0);
 
+  if (irrep_ >= 0)
+    init_symmetry(jop_->coeff());
+
   // Creating an initial CI vector
   cc_ = make_shared<RASDvec>(det_, nstate_);
 
@@ -275,6 +329,7 @@ void RASCI::compute() {
 
   // Davidson utility
   DavidsonDiag<RASCivec> davidson(nstate_, davidson_subspace_);
+  davidson.set_spill(davidson_incore_, davidson_single_, davidson_scratch_, thresh_);
 
   // Object in charge of forming sigma vector
   FormSigmaRAS form_sigma(batchsize_);
@@ -327,6 +382,7 @@ void RASCI::compute() {
         double* denom_array = denom_->data();
         const double en = energies.at(ist);
         transform(source_array, source_array + size, denom_array, target_array, [&en] (const double cc, const double den) { return cc / min(en - den, -0.1); });
+        project_irrep(cc_->data(ist));
         cc_->data(ist)->normalize();
         cc_->data(ist)->spin_decontaminate();
         cc_->data(ist)->synchronize();
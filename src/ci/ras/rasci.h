@@ -39,6 +39,10 @@ class RASCI : public Method {
     // max #iteration
     int max_iter_;
     int davidson_subspace_;
+    // Davidson basis pairs kept in memory (negative for all) and options for the others spilled to disk
+    int davidson_incore_;
+    bool davidson_single_;
+    std::string davidson_scratch_;
     int nguess_;
 
     // threshold for variants
@@ -85,6 +89,13 @@ class RASCI : public Method {
     // denominator
     std::shared_ptr<RASCivec> denom_;
 
+    // target irrep when point-group symmetry is used (-1 otherwise), and parities of active orbitals (see Petite)
+    int irrep_;
+    std::vector<int> orbital_parity_;
+    void init_symmetry(std::shared_ptr<const Matrix> coeff);
+    bool in_irrep(const std::bitset<nbit__>& abit, const std::bitset<nbit__>& bbit) const;
+    void project_irrep(std::shared_ptr<RASCivec> cc) const;
+
     // some init functions
     void common_init(); // may end up unnecessary
     void create_Jiiii();
@@ -95,7 +106,7 @@ class RASCI : public Method {
     std::vector<std::pair<std::bitset<nbit__>, std::bitset<nbit__>>> detseeds(const int ndet);
 
     // denominator
-    void const_denom();
+    virtual void const_denom();
 
     // functions related to natural orbitals
     void update_rdms(const std::shared_ptr<Matrix>& coeff);
@@ -109,9 +120,12 @@ class RASCI : public Method {
     // print functions
     void print_header() const;
 
+    // derived classes that make their own denominator call update() in their constructors
+    RASCI(std::shared_ptr<const PTree>, std::shared_ptr<const Geometry>, std::shared_ptr<const Reference>, const bool update_ints);
+
   public:
     // this constructor is ugly... to be fixed some day...
-    RASCI(std::shared_ptr<const PTree>, std::shared_ptr<const Geometry>, std::shared_ptr<const Reference>);
+    RASCI(std::shared_ptr<const PTree> idat, std::shared_ptr<const Geometry> g, std::shared_ptr<const Reference> r) : RASCI(idat, g, r, true) { }
 
     void compute() override;
 
@@ -163,14 +177,14 @@ class RASCI : public Method {
     std::shared_ptr<const MOFile> jop() const { return jop_; }
 
     // returns a denominator
-    std::shared_ptr<const RASCivec> denom() const { return denom_; }
+    virtual std::shared_ptr<const RASCivec> denom() const { return denom_; }
 
     // returns total energy
     std::vector<double> energy() const { return energy_; }
     double energy(const int i) const { return energy_.at(i); }
 
     // returns CI vectors
-    std::shared_ptr<RASDvec> civectors() const { return cc_; }
+    virtual std::shared_ptr<RASDvec> civectors() const { return cc_; }
 
     std::shared_ptr<const Reference> conv_to_ref() const override { return nullptr; }
 };
@@ -145,22 +145,23 @@ class ZHarrison : public Method {
     void sigma_2e_create_bb(std::shared_ptr<ZCivec> sigma, std::shared_ptr<const ZDvec> e) const;
     void sigma_2e_create_ab(std::shared_ptr<ZCivec> sigma, std::shared_ptr<const ZDvec> e) const;
 
-    void sigma_2e_h0101_h1001(std::shared_ptr<const ZDvec> d, std::shared_ptr<ZDvec> e, std::shared_ptr<const ZMOFile> jop) const;
-
-    template<int i, int j, int k, int l,
-             class = typename std::enable_if<i/2 == 0 and j/2 == 0 and k/2 == 0 and l/2 == 0>::type
-            >
-    void sigma_2e_h(std::shared_ptr<const ZDvec> d, std::shared_ptr<ZDvec> e, std::shared_ptr<const ZMOFile> jop, const bool trans, const std::complex<double> fac = 1.0) const {
-      std::bitset<4> bit4((i<<3)+(j<<2)+(k<<1)+l);
-      btas::contract(fac, *d, {0,1,2}, *jop->mo2e(trans ? ~bit4 : bit4), {3,2}, std::complex<double>(0.0), *e, {0,1,3});
-    }
-
-    void sigma_one(std::shared_ptr<const ZCivec> cc, std::shared_ptr<RelZDvec> sigmavec, std::shared_ptr<const ZMOFile> jop,
-                   const int istate, const bool diag, const bool trans) const;
-#ifdef HAVE_MPI_H
-    int sigma_one_parallel(const int icnt, std::shared_ptr<const ZCivec> cc, std::shared_ptr<RelZDvec> sigmavec, std::shared_ptr<const ZMOFile> jop,
-                           const int istate, const bool diag, const bool trans) const;
-#endif
+    // e(k) = fac * sum_l h(k,l) d(l) for a batch of states, performed as one GEMM
+    void sigma_2e_h_batch(const std::vector<std::shared_ptr<ZDvec>>& d, std::vector<std::shared_ptr<ZDvec>>& e, const ZMatrix& h, const std::complex<double> fac = 1.0) const;
+
+    // Terms of the Hamiltonian applied to a Kramers sector (nelea, neleb) or to its transpose.
+    // Each task is one term for a batch of states; form_sigma distributes the tasks over processes using their estimated cost.
+    enum class SigmaTerm { aa, ab, ab_plus1, aa_plus1, aa_plus2 };
+    struct SigmaTask {
+      int nelea;
+      int neleb;
+      bool trans;
+      SigmaTerm term;
+      std::vector<int> states;
+      double cost;
+    };
+    std::vector<SigmaTask> sigma_tasks(const std::vector<int>& conv) const;
+    void sigma_task(const SigmaTask& task, std::shared_ptr<const RelZDvec> ccvec, std::shared_ptr<RelZDvec> sigmavec, std::shared_ptr<RelZDvec> sigmavec_trans,
+                    std::shared_ptr<const ZMOFile> jop) const;
 
     // protected functions for RDM computation. Annihilate two electrons from the reference
     std::shared_ptr<Kramers<1,ZDvec>> one_down_from_civec(const int nelea, const int neleb, const int istate, std::shared_ptr<const RelSpace>) const;
@@ -32,26 +32,22 @@ using namespace std;
 using namespace bagel;
 
 /* Implementing the method as described by Harrison and Zarrabian */
-#ifndef HAVE_MPI_H
 shared_ptr<RelZDvec> ZHarrison::form_sigma(shared_ptr<const RelZDvec> ccvec, shared_ptr<const ZMOFile> jop, const vector<int>& conv) const {
+  Timer pdebug(2);
   auto sigmavec = make_shared<RelZDvec>(space_, nstate_);
   auto sigmavec_trans = sigmavec->clone(); // important note: the space stays the same after transposition
 
-  for (auto& isp : space_->detmap()) {
-    shared_ptr<const Determinants> base_det = isp.second;
-    const int nelea = base_det->nelea();
-    const int neleb = base_det->neleb();
-
-    for (int istate = 0; istate != nstate_; ++istate) {
-      if (conv[istate]) continue;
-
-      shared_ptr<const ZCivec> cc = ccvec->find(nelea, neleb)->data(istate);
-      sigma_one(cc, sigmavec, jop, istate, /*diag*/true, /*transpose*/false);
-
-      shared_ptr<const ZCivec> cc_trans = cc->transpose();
-      sigma_one(cc_trans, sigmavec_trans, jop, istate, /*diag*/false, /*transpose*/true);
-    }
+  // Kramers sectors differ greatly in size; tasks are assigned to processes largest first, each to the least loaded process.
+  // Within a process, the tasks are threaded internally.
+  vector<SigmaTask> tasks = sigma_tasks(conv);
+  vector<double> load(mpi__->size(), 0.0);
+  for (auto& task : tasks) {
+    const int rank = min_element(load.begin(), load.end()) - load.begin();
+    load[rank] += task.cost;
+    if (rank == mpi__->rank())
+      sigma_task(task, ccvec, sigmavec, sigmavec_trans, jop);
   }
+  pdebug.tick_print("sigma tasks");
 
   for (auto& isp : space_->detmap()) {
     const int nelea = isp.second->nelea();
@@ -63,136 +59,161 @@ shared_ptr<RelZDvec> ZHarrison::form_sigma(shared_ptr<const RelZDvec> ccvec, sha
     for (int ist = 0; ist != nstate_; ++ist) {
       if (conv[ist]) continue;
       sigma->data(ist)->ax_plus_y(1.0, *sigma_trans->data(ist)->transpose());
+      mpi__->allreduce(sigma->data(ist)->data(), sigma->data(ist)->size());
     }
   }
+  pdebug.tick_print("reduction");
 
   return sigmavec;
 }
 
-#else
 
-shared_ptr<RelZDvec> ZHarrison::form_sigma(shared_ptr<const RelZDvec> ccvec, shared_ptr<const ZMOFile> jop, const vector<int>& conv) const {
-  auto sigmavec = make_shared<RelZDvec>(space_, nstate_);
-  auto sigmavec_trans = sigmavec->clone(); // important note: the space stays the same after transposition
-
-  int icnt = 0;
-  for (auto& isp : space_->detmap()) {
-    shared_ptr<const Determinants> base_det = isp.second;
-    const int nelea = base_det->nelea();
-    const int neleb = base_det->neleb();
+vector<ZHarrison::SigmaTask> ZHarrison::sigma_tasks(const vector<int>& conv) const {
+  vector<int> states;
+  for (int ist = 0; ist != nstate_; ++ist)
+    if (!conv[ist]) states.push_back(ist);
+  if (states.empty())
+    return vector<SigmaTask>();
 
-    for (int istate = 0; istate != nstate_; ++istate) {
-      if (conv[istate]) continue;
-
-      shared_ptr<const ZCivec> cc = ccvec->find(nelea, neleb)->data(istate);
-      icnt = sigma_one_parallel(icnt, cc, sigmavec, jop, istate, /*diag*/true, /*transpose*/false);
-
-      shared_ptr<const ZCivec> cc_trans = cc->transpose();
-      icnt = sigma_one_parallel(icnt, cc_trans, sigmavec_trans, jop, istate, /*diag*/false, /*transpose*/true);
-    }
-  }
+  const double n2 = norb_*norb_;
+  auto size = [this](shared_ptr<const RelSpace> sp, const int nelea, const int neleb) {
+    shared_ptr<const Determinants> det = sp->finddet(nelea, neleb);
+    return static_cast<double>(det->lena()*det->lenb());
+  };
 
+  // a term applied to one state; the cost is an estimate of the number of floating-point operations
+  vector<SigmaTask> terms;
   for (auto& isp : space_->detmap()) {
     const int nelea = isp.second->nelea();
     const int neleb = isp.second->neleb();
-    shared_ptr<ZDvec> sigma = sigmavec->find(nelea, neleb);
-    shared_ptr<ZDvec> sigma_trans = sigmavec_trans->find(neleb, nelea);
-
-    // daxpy for each Civec
-    for (int ist = 0; ist != nstate_; ++ist) {
-      if (conv[ist]) continue;
-      sigma->data(ist)->ax_plus_y(1.0, *sigma_trans->data(ist)->transpose());
-      mpi__->allreduce(sigma->data(ist)->data(), sigma->data(ist)->size());
+    const double size0 = static_cast<double>(isp.second->lena()*isp.second->lenb());
+
+    for (int trans = 0; trans != 2; ++trans) {
+      // the transposed vector has the roles of alpha and beta swapped
+      const int na = trans ? neleb : nelea;
+      const int nb = trans ? nelea : neleb;
+
+      const bool noab = (na == 0 || nb == 0);
+      const bool noaa = na <= 1 || nb+1 > norb_;
+      const bool output1 = na-1 >= 0 && nb+1 <= norb_;
+
+      const double nv = norb_ - na;
+      terms.push_back({na, nb, static_cast<bool>(trans), SigmaTerm::aa, {}, size0 * (na*nv + 0.25*na*na*nv*nv)});
+      if (!noab && !trans) {
+        const double sizeab = size(int_space_, na-1, nb-1);
+        terms.push_back({na, nb, false, SigmaTerm::ab, {}, sizeab * (8.0*n2*n2 + 2.0*n2)});
+      }
+      if (output1)
+        terms.push_back({na, nb, static_cast<bool>(trans), SigmaTerm::ab_plus1, {}, size0 * n2 + (noab ? 0.0 : size(int_space_, na-1, nb-1) * (8.0*n2*n2 + 2.0*n2))});
+      if (!noaa) {
+        const double sizeaa = size(int_space_, na-2, nb);
+        terms.push_back({na, nb, static_cast<bool>(trans), SigmaTerm::aa_plus1, {}, sizeaa * (8.0*n2*n2 + 2.0*n2)});
+        if (nb+2 <= norb_)
+          terms.push_back({na, nb, static_cast<bool>(trans), SigmaTerm::aa_plus2, {}, sizeaa * (8.0*n2*n2 + 2.0*n2)});
+      }
     }
   }
 
-  return sigmavec;
+  // States are batched so that small sectors give reasonably sized GEMMs, while keeping enough tasks to keep all processes busy.
+  const int nproc = mpi__->size();
+  const int nsplit = min(static_cast<int>(states.size()), max(1, (2*nproc + static_cast<int>(terms.size()) - 1) / static_cast<int>(terms.size())));
+  const double maxrows = 1 << 16;
+
+  vector<SigmaTask> out;
+  for (auto& t : terms) {
+    shared_ptr<const Determinants> det = space_->finddet(t.nelea, t.neleb);
+    const int maxbatch = max(1, static_cast<int>(maxrows / (det->lena()*det->lenb())));
+    const int batch = min(maxbatch, static_cast<int>((states.size()-1) / nsplit + 1));
+    for (int i = 0; i < states.size(); i += batch) {
+      SigmaTask task = t;
+      task.states.assign(states.begin()+i, states.begin()+min(i+batch, static_cast<int>(states.size())));
+      task.cost *= task.states.size();
+      out.push_back(task);
+    }
+  }
+  stable_sort(out.begin(), out.end(), [](const SigmaTask& a, const SigmaTask& b) { return a.cost > b.cost; });
+  return out;
 }
-#endif
 
 
-void ZHarrison::sigma_one(shared_ptr<const ZCivec> cc, shared_ptr<RelZDvec> sigmavec, shared_ptr<const ZMOFile> jop,
-                          const int istate, const bool diag, const bool trans) const {
-  Timer pdebug(2);
-
+void ZHarrison::sigma_task(const SigmaTask& task, shared_ptr<const RelZDvec> ccvec, shared_ptr<RelZDvec> sigmavec, shared_ptr<RelZDvec> sigmavec_trans,
+                           shared_ptr<const ZMOFile> jop) const {
   const int ij = norb_*norb_;
-  shared_ptr<const Determinants> base_det = cc->det();
-  // diagonal output
-  const int nelea = base_det->nelea();
-  const int neleb = base_det->neleb();
-  shared_ptr<ZCivec> sigma = sigmavec->find(nelea, neleb)->data(istate);
-
-  sigma_aa(cc, sigma, jop, trans);
-  pdebug.tick_print("taskaa");
-
-  const bool noab = (base_det->nelea() == 0 || base_det->neleb() == 0);
-  const bool noaa =  base_det->nelea() <= 1 || base_det->neleb()+1 > norb_;
-
-  const bool output1 = base_det->nelea()-1 >= 0 && base_det->neleb()+1 <= norb_;
+  const int nelea = task.nelea;
+  const int neleb = task.neleb;
+  const bool trans = task.trans;
+
+  // sector (nelea, neleb) of the (transposed) vectors
+  shared_ptr<RelZDvec> target = trans ? sigmavec_trans : sigmavec;
+  vector<shared_ptr<const ZCivec>> cc;
+  for (auto& ist : task.states) {
+    shared_ptr<const ZCivec> c = trans ? ccvec->find(neleb, nelea)->data(ist) : ccvec->find(nelea, neleb)->data(ist);
+    cc.push_back(trans ? c->transpose() : c);
+  }
 
-  if (!noab && (diag || output1)) {
-    shared_ptr<const Determinants> int_det = int_space_->finddet(nelea-1, neleb-1);
-    auto d = make_shared<ZDvec>(int_det, ij);
-    auto e = make_shared<ZDvec>(int_det, ij);
+  if (task.term == SigmaTerm::aa) {
+    for (int i = 0; i != cc.size(); ++i)
+      sigma_aa(cc[i], target->find(nelea, neleb)->data(task.states[i]), jop, trans);
+    return;
+  }
 
-    // (2ab) alpha-beta contributions
-    /* Resembles more the Knowles & Handy FCI terms */
+  if (task.term == SigmaTerm::ab_plus1) {
+    // (b^+ a) contribution
+    for (int i = 0; i != cc.size(); ++i)
+      sigma_1e_ab(cc[i], target->find(nelea-1, neleb+1)->data(task.states[i]), jop, trans);
+    if (nelea == 0 || neleb == 0)
+      return;
+  }
 
-    sigma_2e_annih_ab(cc, d);
-    pdebug.tick_print("task2ab-1");
+  // two-electron terms through the intermediate space
+  const bool ab = task.term == SigmaTerm::ab || task.term == SigmaTerm::ab_plus1;
+  shared_ptr<const Determinants> int_det = ab ? int_space_->finddet(nelea-1, neleb-1) : int_space_->finddet(nelea-2, neleb);
+  vector<shared_ptr<ZDvec>> d, e;
+  for (auto& c : cc) {
+    d.push_back(make_shared<ZDvec>(int_det, ij));
+    e.push_back(make_shared<ZDvec>(int_det, ij));
+    if (ab)
+      sigma_2e_annih_ab(c, d.back());
+    else
+      sigma_2e_annih_aa(c, d.back());
+  }
 
-    if (diag) {
+  switch (task.term) {
+    case SigmaTerm::ab: {
       // (a^+ b^+ b a) and (a^+ b^+ a b) contributions
-      sigma_2e_h0101_h1001(d, e, jop);
-      pdebug.tick_print("task2ab-2 (0)");
-
-      sigma_2e_create_ab(sigma, e);
-      pdebug.tick_print("task2ab-3 (0)");
+      ZMatrix tmp(*jop->mo2e("0101"));
+      sort_indices<1,0,2,3,1,1,-1,1>(jop->mo2e("1001")->data(), tmp.data(), norb_, norb_, norb_, norb_);
+      sigma_2e_h_batch(d, e, tmp);
+      for (int i = 0; i != cc.size(); ++i)
+        sigma_2e_create_ab(target->find(nelea, neleb)->data(task.states[i]), e[i]);
+      break;
     }
-
-    if (output1) {
-      // output area
-      shared_ptr<ZCivec> sigma_1 = sigmavec->find(nelea-1, neleb+1)->data(istate);
-
+    case SigmaTerm::ab_plus1: {
       // (b^+b^+ b a) contribution
-      sigma_2e_h<1,1,0,1>(d, e, jop, trans);
-      pdebug.tick_print("task2ab-2 (+1)");
-      sigma_2e_create_bb(sigma_1, e);
-      pdebug.tick_print("task2ab-3 (+1)");
+      bitset<4> bit4("1101");
+      sigma_2e_h_batch(d, e, *jop->mo2e(trans ? ~bit4 : bit4));
+      for (int i = 0; i != cc.size(); ++i)
+        sigma_2e_create_bb(target->find(nelea-1, neleb+1)->data(task.states[i]), e[i]);
+      break;
     }
-  }
-
-  if (output1) {
-    // output area
-    shared_ptr<ZCivec> sigma_1 = sigmavec->find(nelea-1, neleb+1)->data(istate);
-
-    // (b^+ a) contribution
-    sigma_1e_ab(cc, sigma_1, jop, trans);
-  }
-
-  if (!noaa) {
-    shared_ptr<const Determinants> int_det = int_space_->finddet(nelea-2, neleb);
-    auto d = make_shared<ZDvec>(int_det, ij);
-    auto e = make_shared<ZDvec>(int_det, ij);
-
-    sigma_2e_annih_aa(cc, d);
-    pdebug.tick_print("task2aa-1 (2)");
-
-    // (a^+ b^+ a a) contribution
-    sigma_2e_h<0,1,0,0>(d, e, jop, trans);
-
-    assert(neleb+1 <= norb_);
-    // +1 sector
-    shared_ptr<ZCivec> sigma_1 = sigmavec->find(nelea-1, neleb+1)->data(istate);
-    sigma_2e_create_ab(sigma_1, e);
-
-    // +2 sector
-    if (base_det->neleb()+2 <= norb_) {
-      shared_ptr<ZCivec> sigma_2 = sigmavec->find(nelea-2, neleb+2)->data(istate);
-      // reusing
-      sigma_2e_h<1,1,0,0>(d, e, jop, trans, 0.5);
-      sigma_2e_create_bb(sigma_2, e);
+    case SigmaTerm::aa_plus1: {
+      // (a^+ b^+ a a) contribution
+      bitset<4> bit4("0100");
+      sigma_2e_h_batch(d, e, *jop->mo2e(trans ? ~bit4 : bit4));
+      for (int i = 0; i != cc.size(); ++i)
+        sigma_2e_create_ab(target->find(nelea-1, neleb+1)->data(task.states[i]), e[i]);
+      break;
+    }
+    case SigmaTerm::aa_plus2: {
+      // (b^+ b^+ a a) contribution
+      bitset<4> bit4("1100");
+      sigma_2e_h_batch(d, e, *jop->mo2e(trans ? ~bit4 : bit4), 0.5);
+      for (int i = 0; i != cc.size(); ++i)
+        sigma_2e_create_bb(target->find(nelea-2, neleb+2)->data(task.states[i]), e[i]);
+      break;
     }
+    default:
+      throw logic_error("unexpected SigmaTerm in ZHarrison::sigma_task");
   }
 }
 
@@ -394,8 +415,27 @@ void ZHarrison::sigma_2e_create_bb(shared_ptr<ZCivec> sigma, shared_ptr<const ZD
 
 //////////////// functions for multiplication of the Hamiltonian ///////////////
 
-void ZHarrison::sigma_2e_h0101_h1001(shared_ptr<const ZDvec> d, shared_ptr<ZDvec> e, shared_ptr<const ZMOFile> jop) const {
-  ZMatrix tmp(*jop->mo2e("0101"));
-  sort_indices<1,0,2,3,1,1,-1,1>(jop->mo2e("1001")->data(), tmp.data(), norb_, norb_, norb_, norb_);
-  contract(1.0, *d, {0,1,2}, tmp, {3,2}, 0.0, *e, {0,1,3});
+void ZHarrison::sigma_2e_h_batch(const vector<shared_ptr<ZDvec>>& d, vector<shared_ptr<ZDvec>>& e, const ZMatrix& h, const complex<double> fac) const {
+  assert(d.size() == e.size() && !d.empty());
+  const int ij = norb_*norb_;
+  const size_t len = d.front()->lena() * d.front()->lenb();
+  const int nbatch = d.size();
+  if (nbatch == 1) {
+    zgemm3m_("N", "T", len, ij, ij, fac, d.front()->data(), len, h.data(), ij, 0.0, e.front()->data(), len);
+    return;
+  }
+
+  // e(x, k) = sum_l d(x, l) h(k, l), where the rows x of all the states are stacked
+  const size_t rows = len * nbatch;
+  unique_ptr<complex<double>[]> dbuf(new complex<double>[rows*ij]);
+  unique_ptr<complex<double>[]> ebuf(new complex<double>[rows*ij]);
+  for (int i = 0; i != nbatch; ++i)
+    for (int l = 0; l != ij; ++l)
+      copy_n(d[i]->data() + l*len, len, dbuf.get() + l*rows + i*len);
+
+  zgemm3m_("N", "T", rows, ij, ij, fac, dbuf.get(), rows, h.data(), ij, 0.0, ebuf.get(), rows);
+
+  for (int i = 0; i != nbatch; ++i)
+    for (int k = 0; k != ij; ++k)
+      copy_n(ebuf.get() + k*rows + i*len, len, e[i]->data() + k*len);
 }
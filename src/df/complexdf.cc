@@ -31,7 +31,7 @@ using namespace bagel;
 
 
 // Default constructor
-ComplexDFDist::ComplexDFDist(const int nbas, const int naux, const array<shared_ptr<DFBlock>,2> blocks, shared_ptr<const ParallelDF> df, shared_ptr<Matrix> data2)
+ComplexDFDist::ComplexDFDist(const int nbas, const int naux, const array<shared_ptr<DFBlock>,2> blocks, shared_ptr<const ParallelDF> df, shared_ptr<const Matrix> data2)
   : DFDist (nbas, naux, nullptr, df, data2), ComplexDF_base() {
   assert((blocks[0] && blocks[1]) || (!blocks[0] && !blocks[1]));
   if (blocks[0]) {
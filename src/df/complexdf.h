@@ -42,7 +42,7 @@ class ComplexDFFullDist;
 class ComplexDFDist : public DFDist, public ComplexDF_base {
   public:
     ComplexDFDist(const int nbas, const int naux, const std::array<std::shared_ptr<DFBlock>,2> block = std::array<std::shared_ptr<DFBlock>,2>{{nullptr, nullptr}},
-                  std::shared_ptr<const ParallelDF> df = nullptr, std::shared_ptr<Matrix> data2 = nullptr);
+                  std::shared_ptr<const ParallelDF> df = nullptr, std::shared_ptr<const Matrix> data2 = nullptr);
 
     ComplexDFDist(const std::shared_ptr<const ParallelDF> df) : DFDist(df), ComplexDF_base() { }
 
@@ -114,7 +114,7 @@ class ComplexDFDist_ints : public ComplexDFDist {
 
   public:
     ComplexDFDist_ints(const int nbas, const int naux, const std::vector<std::shared_ptr<const Atom>>& atoms, const std::vector<std::shared_ptr<const Atom>>& aux_atoms,
-                       const double thr, const bool inverse, const double dum, const bool average = false, const std::shared_ptr<Matrix> data2 = nullptr) : ComplexDFDist(nbas, naux) {
+                       const double thr, const bool inverse, const double dum, const bool average = false, const std::shared_ptr<const Matrix> data2 = nullptr) : ComplexDFDist(nbas, naux) {
 
       // 3index Integral is now made in DFBlock.
       std::vector<std::shared_ptr<const Shell>> ashell, b1shell, b2shell;
@@ -25,6 +25,7 @@
 
 #include <src/df/df.h>
 #include <src/df/dfdistt.h>
+#include <src/util/parallel/sharedmemory.h>
 #include <src/integral/rys/eribatch.h>
 #include <src/integral/libint/libint.h>
 
@@ -82,7 +83,7 @@ void DFDist::compute_2index(const vector<shared_ptr<const Shell>>& ashell, const
   // generates a task of integral evaluations
   TaskQueue<DFIntTask_OLD<DFDist>> tasks(ashell.size()*ashell.size());
 
-  data2_ = make_shared<Matrix>(naux_, naux_, serial_);
+  auto data2 = make_shared<Matrix>(naux_, naux_, serial_);
   auto b3 = make_shared<const Shell>(ashell.front()->spherical());
 
   // naive static distribution
@@ -92,7 +93,7 @@ void DFDist::compute_2index(const vector<shared_ptr<const Shell>>& ashell, const
     int o1 = 0;
     for (auto& b1 : ashell) {
       if (o0 <= o1 && ((u++ % mpi__->size() == mpi__->rank()) || serial_))
-        tasks.emplace_back(array<shared_ptr<const Shell>,4>{{b1, b3, b0, b3}}, array<int,2>{{o0, o1}}, this);
+        tasks.emplace_back(array<shared_ptr<const Shell>,4>{{b1, b3, b0, b3}}, array<int,2>{{o0, o1}}, this, data2->data());
       o1 += b1->nbasis();
     }
     o0 += b0->nbasis();
@@ -102,16 +103,19 @@ void DFDist::compute_2index(const vector<shared_ptr<const Shell>>& ashell, const
   tasks.compute();
 
   if (!serial_)
-    data2_->allreduce();
+    mpi__->node_allreduce(data2->data(), data2->size());
 
   time.tick_print("2-index ints");
 
   if (compute_inverse) {
-    data2_->inverse_half(throverlap);
-    // will use data2_ within node
-    data2_->localize();
+    data2->inverse_half(throverlap);
+    // will use data2_ within node; one copy per node is kept
+    data2->localize();
+    if (!serial_)
+      data2 = make_shared<SharedMatrix>(*data2);
     time.tick_print("computing inverse");
   }
+  data2_ = data2;
 }
 
 
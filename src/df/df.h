@@ -27,12 +27,40 @@
 
 #include <src/df/paralleldf.h>
 #include <src/molecule/atom.h>
+#include <src/molecule/petite.h>
+#include <src/molecule/shellpair.h>
 
 namespace bagel {
 
 class DFHalfDist;
 class DFFullDist;
 
+// Layout of the 3-index integrals: the basis shell pairs that are computed and the auxiliary shells on this process.
+// It depends only on the screening, and is reused when the geometry changes only slightly.
+class DFLayout {
+  protected:
+    // significant basis shell pairs (k1, k2) with k1 <= k2
+    std::vector<std::pair<int,int>> pairs_;
+    // auxiliary shells [ashell_start, ashell_start+nashell) are local
+    int ashell_start_;
+    int nashell_;
+    int astart_;
+    std::shared_ptr<const StaticDist> table_;
+    bool serial_;
+
+  public:
+    DFLayout(const std::vector<std::pair<int,int>>& p, const int as, const int na, const int a, std::shared_ptr<const StaticDist> t, const bool s)
+      : pairs_(p), ashell_start_(as), nashell_(na), astart_(a), table_(t), serial_(s) { }
+
+    const std::vector<std::pair<int,int>>& pairs() const { return pairs_; }
+    int ashell_start() const { return ashell_start_; }
+    int nashell() const { return nashell_; }
+    int astart() const { return astart_; }
+    std::shared_ptr<const StaticDist> table() const { return table_; }
+    bool serial() const { return serial_; }
+};
+
+
 class DFDist : public ParallelDF {
   friend class DFIntTask_OLD<DFDist>;
   friend class PDFIntTask_2index;
@@ -45,8 +73,10 @@ class DFDist : public ParallelDF {
 
     std::tuple<int, std::vector<std::shared_ptr<const Shell>>> get_ashell(const std::vector<std::shared_ptr<const Shell>>& all);
 
+    std::shared_ptr<const DFLayout> layout_;
+
   public:
-    DFDist(const int nbas, const int naux, const std::shared_ptr<DFBlock> block = nullptr, std::shared_ptr<const ParallelDF> df = nullptr, std::shared_ptr<Matrix> data2 = nullptr,
+    DFDist(const int nbas, const int naux, const std::shared_ptr<DFBlock> block = nullptr, std::shared_ptr<const ParallelDF> df = nullptr, std::shared_ptr<const Matrix> data2 = nullptr,
            const bool serial = false) : ParallelDF(naux, nbas, nbas, df, data2, serial) {
       if (block)
         block_.push_back(block);
@@ -55,6 +85,7 @@ class DFDist : public ParallelDF {
     DFDist(const std::shared_ptr<const ParallelDF> df) : ParallelDF(df->naux(), df->nindex1(), df->nindex2(), df) { }
 
     bool has_2index() const { return data2_.get() != nullptr; }
+    std::shared_ptr<const DFLayout> layout() const { return layout_; }
     size_t nbasis0() const { return nindex2_; }
     size_t nbasis1() const { return nindex1_; }
     size_t naux() const { return naux_; }
@@ -90,9 +121,35 @@ class DFDist_ints : public DFDist {
                         const std::vector<std::shared_ptr<const Shell>>& b1shell,
                         const std::vector<std::shared_ptr<const Shell>>& b2shell,
                         const size_t asize, const size_t b1size, const size_t b2size,
-                        const size_t astart, const double thresh, const bool compute_inv) {
+                        const size_t astart, const double thresh, const bool compute_inv,
+                        const std::vector<std::vector<int>>& amap = {}, const std::vector<std::vector<int>>& bmap = {},
+                        std::shared_ptr<const Petite> plist = nullptr, const std::vector<std::pair<int,int>>& pairs = {}) {
       Timer time;
 
+      // when symmetry is used, only the shell triples that are the smallest in their orbits (among those whose auxiliary shell is local)
+      // are computed, and the others are copied from them; amap and bmap are the images of the local auxiliary shells (-1 if not local) and of the basis shells.
+      const bool symmetric = plist && plist->nirrep() > 1 && TBatch::Nblocks() == 1;
+      const size_t nb = b1shell.size();
+      std::vector<std::tuple<int,int,int,int>> images;
+      auto unique = [&](const int ka, const int k1, const int k2) {
+        size_t key = (ka * nb + k1) * nb + k2;
+        int op = 0;
+        for (int iop = 1; iop != plist->nsymop(); ++iop) {
+          const int ga = amap[ka][iop];
+          if (ga < 0) continue;
+          const int g1 = std::min(bmap[k1][iop], bmap[k2][iop]);
+          const int g2 = std::max(bmap[k1][iop], bmap[k2][iop]);
+          if ((ga * nb + g1) * nb + g2 < key) {
+            key = (ga * nb + g1) * nb + g2;
+            op = iop;
+          }
+        }
+        // the smallest image is always computed
+        if (op != 0)
+          images.emplace_back(ka, k1, k2, op);
+        return op == 0;
+      };
+
       // making a task list
       TaskQueue<DFIntTask<TBatch,TBatch::Nblocks()>> tasks(b1shell.size()*b2shell.size()*ashell.size());
 
@@ -102,30 +159,92 @@ class DFDist_ints : public DFDist {
       std::array<std::shared_ptr<DFBlock>,TBatch::Nblocks()> blk;
       for (int i = 0; i != TBatch::Nblocks(); ++i) blk[i] = block_[i];
 
-      int j2 = 0;
-      for (auto& i2 : b2shell) {
-        int j1 = 0;
-        for (auto& i1 : b1shell) {
-          if (TBatch::Nblocks() > 1 || j1 <= j2) {
-            int j0 = 0;
-            for (auto& i0 : ashell) {
-              tasks.emplace_back((std::array<std::shared_ptr<const Shell>,4>{{i3, i0, i1, i2}}), (std::array<int,3>{{j2, j1, j0}}), blk);
-              j0 += i0->nbasis();
+      if (!pairs.empty()) {
+        // only the significant shell pairs; the others are zero
+        assert(!symmetric && TBatch::Nblocks() == 1);
+        for (auto& i : block_)
+          i->zero();
+        std::vector<int> boff;
+        int cnt = 0;
+        for (auto& i : b1shell) {
+          boff.push_back(cnt);
+          cnt += i->nbasis();
+        }
+        for (auto& p : pairs) {
+          int j0 = 0;
+          for (auto& i0 : ashell) {
+            tasks.emplace_back((std::array<std::shared_ptr<const Shell>,4>{{i3, i0, b1shell[p.first], b2shell[p.second]}}),
+                               (std::array<int,3>{{boff[p.second], boff[p.first], j0}}), blk);
+            j0 += i0->nbasis();
+          }
+        }
+      } else {
+        int j2 = 0;
+        for (auto& i2 : b2shell) {
+          int j1 = 0;
+          for (auto& i1 : b1shell) {
+            if (TBatch::Nblocks() > 1 || j1 <= j2) {
+              int j0 = 0;
+              for (auto& i0 : ashell) {
+                if (!symmetric || unique(&i0-&ashell.front(), &i1-&b1shell.front(), &i2-&b2shell.front()))
+                  tasks.emplace_back((std::array<std::shared_ptr<const Shell>,4>{{i3, i0, i1, i2}}), (std::array<int,3>{{j2, j1, j0}}), blk);
+                j0 += i0->nbasis();
+              }
             }
+            j1 += i1->nbasis();
           }
-          j1 += i1->nbasis();
+          j2 += i2->nbasis();
         }
-        j2 += i2->nbasis();
       }
       time.tick_print("3-index ints prep");
       tasks.compute();
       time.tick_print("3-index ints");
 
+      if (symmetric) {
+        // (P|ij) = s_P s_i s_j (gP|gi gj)
+        auto offsets = [](const std::vector<std::shared_ptr<const Shell>>& shells) {
+          std::vector<int> out;
+          int cnt = 0;
+          for (auto& i : shells) {
+            out.push_back(cnt);
+            cnt += i->nbasis();
+          }
+          return out;
+        };
+        const std::vector<int> aoff = offsets(ashell);
+        const std::vector<int> boff = offsets(b1shell);
+        std::vector<std::vector<int>> apar, bpar;
+        for (auto& i : ashell)  apar.push_back(Petite::parity(*i));
+        for (auto& i : b1shell) bpar.push_back(Petite::parity(*i));
+
+        double* const data = block_[0]->data();
+        for (auto& i : images) {
+          int ka, k1, k2, iop;
+          std::tie(ka, k1, k2, iop) = i;
+          const int ga = amap[ka][iop];
+          const int g1 = bmap[k1][iop];
+          const int g2 = bmap[k2][iop];
+          for (int n = 0; n != bpar[k2].size(); ++n) {
+            const int sn = plist->character(bpar[k2][n], iop);
+            for (int m = 0; m != bpar[k1].size(); ++m) {
+              const int smn = sn * plist->character(bpar[k1][m], iop);
+              const double* source = data + aoff[ga] + asize*(boff[g1]+m + b1size*(boff[g2]+n));
+              double* target1 = data + aoff[ka] + asize*(boff[k1]+m + b1size*(boff[k2]+n));
+              double* target2 = data + aoff[ka] + asize*(boff[k2]+n + b1size*(boff[k1]+m));
+              for (int p = 0; p != apar[ka].size(); ++p)
+                target1[p] = target2[p] = smn * plist->character(apar[ka][p], iop) * source[p];
+            }
+          }
+        }
+        time.tick_print("3-index ints (symmetry)");
+      }
     }
 
   public:
     DFDist_ints(const int nbas, const int naux, const std::vector<std::shared_ptr<const Atom>>& atoms, const std::vector<std::shared_ptr<const Atom>>& aux_atoms,
-                const double thr, const bool inverse, const double dum, const bool average = false, const std::shared_ptr<Matrix> data2 = nullptr, const bool serial = false)
+                const double thr, const bool inverse, const double dum, const bool average = false, const std::shared_ptr<const Matrix> data2 = nullptr, const bool serial = false,
+                const std::shared_ptr<const Petite> plist = nullptr, std::shared_ptr<const DFLayout> layout = nullptr,
+                std::shared_ptr<const ShellPairList> shellpairs = nullptr)
       : DFDist(nbas, naux, nullptr, nullptr, nullptr, serial) {
 
       // 3index Integral is now made in DFBlock.
@@ -134,12 +253,39 @@ class DFDist_ints : public DFDist {
       for (auto& i : atoms)     b1shell.insert(b1shell.end(), i->shells().begin(), i->shells().end());
       for (auto& i : atoms)     b2shell.insert(b2shell.end(), i->shells().begin(), i->shells().end());
 
+      const bool use_symmetry = plist && plist->nirrep() > 1;
+      if (layout && (use_symmetry || TBatch::Nblocks() != 1))
+        throw std::logic_error("DFLayout cannot be used with symmetry or multi-block integrals");
+
       // distribute auxiliary shells to each nodes
       int astart;
       std::vector<std::shared_ptr<const Shell>> myashell;
-      std::tie(astart, myashell) = get_ashell(ashell);
+      std::shared_ptr<const StaticDist> adist_shell;
+      if (layout) {
+        astart = layout->astart();
+        serial_ = layout->serial();
+        myashell.assign(ashell.begin() + layout->ashell_start(), ashell.begin() + layout->ashell_start() + layout->nashell());
+        adist_shell = layout->table();
+      } else {
+        std::tie(astart, myashell) = get_ashell(ashell);
+        adist_shell = make_table(astart);
+      }
 
-      std::shared_ptr<const StaticDist> adist_shell = make_table(astart);
+      // significant shell pairs, screened with the same bound as the one-electron integrals (the molecule's list when it is passed)
+      std::vector<std::pair<int,int>> pairs;
+      if (layout) {
+        pairs = layout->pairs();
+      } else if (!use_symmetry && TBatch::Nblocks() == 1) {
+        assert(!shellpairs || shellpairs->atoms() == atoms);
+        std::shared_ptr<const ShellPairList> list = shellpairs ? shellpairs : std::make_shared<const ShellPairList>(atoms);
+        for (auto& i : list->index())
+          if (i.second <= i.first)
+            pairs.emplace_back(i.second, i.first);
+      }
+      if (!use_symmetry && TBatch::Nblocks() == 1) {
+        const int ashell_start = myashell.empty() ? 0 : std::find(ashell.begin(), ashell.end(), myashell.front()) - ashell.begin();
+        layout_ = std::make_shared<const DFLayout>(pairs, ashell_start, myashell.size(), astart, adist_shell, serial_);
+      }
       std::shared_ptr<const StaticDist> adist_averaged = std::make_shared<const StaticDist>(naux_, mpi__->size());
 
       // make empty dfblocks
@@ -149,8 +295,22 @@ class DFDist_ints : public DFDist {
       for (int i = 0; i != TBatch::Nblocks(); ++i)
         block_.push_back(std::make_shared<DFBlock>(adist_shell, adist_averaged, asize, b1size, b2size, astart, 0, 0));
 
+      // images of the shells under symmetry operations
+      std::vector<std::vector<int>> amap, bmap;
+      if (plist && plist->nirrep() > 1 && !myashell.empty()) {
+        const int ashell_start = std::find(ashell.begin(), ashell.end(), myashell.front()) - ashell.begin();
+        const std::vector<std::vector<int>> all = plist->shellmap(aux_atoms);
+        for (int i = ashell_start; i != ashell_start + myashell.size(); ++i) {
+          std::vector<int> tmp;
+          for (auto& g : all[i])
+            tmp.push_back(g >= ashell_start && g < ashell_start + myashell.size() ? g - ashell_start : -1);
+          amap.push_back(tmp);
+        }
+        bmap = plist->shellmap(atoms);
+      }
+
       // 3-index integrals
-      compute_3index(myashell, b1shell, b2shell, asize, b1size, b2size, astart, thr, inverse);
+      compute_3index(myashell, b1shell, b2shell, asize, b1size, b2size, astart, thr, inverse, amap, bmap, amap.empty() ? nullptr : plist, pairs);
 
       // 2-index integrals
       if (data2)
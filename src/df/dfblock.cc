@@ -371,6 +371,25 @@ shared_ptr<Matrix> DFBlock::form_2index(const shared_ptr<const DFBlock> o, const
 }
 
 
+vector<shared_ptr<Matrix>> DFBlock::form_2index_batch(const shared_ptr<const DFBlock> o, const double a, const int nbatch) const {
+  if (asize() != o->asize() || b1size() != nbatch*o->b1size()) throw logic_error("illegal call of DFBlock::form_2index_batch");
+  // (P,i,s,r) is viewed as a (P i, s r) matrix so that all the batches are contracted at once
+  const size_t nb1 = o->b1size();
+  Matrix target(nbatch*b2size(), o->b2size());
+  dgemm_("T", "N", nbatch*b2size(), o->b2size(), asize()*nb1, a, data(), asize()*nb1, o->data(), asize()*nb1, 0.0, target.data(), nbatch*b2size());
+
+  vector<shared_ptr<Matrix>> out;
+  for (int s = 0; s != nbatch; ++s) {
+    auto tmp = make_shared<Matrix>(b2size(), o->b2size());
+    for (size_t j = 0; j != o->b2size(); ++j)
+      for (size_t r = 0; r != b2size(); ++r)
+        (*tmp)(r, j) = target(s+nbatch*r, j);
+    out.push_back(tmp);
+  }
+  return out;
+}
+
+
 shared_ptr<Matrix> DFBlock::form_4index(const shared_ptr<const DFBlock> o, const double a) const {
   if (asize() != o->asize()) throw logic_error("illegal call of DFBlock::form_4index");
   auto target = make_shared<Matrix>(b1size()*b2size(), o->b1size()*o->b2size());
@@ -431,6 +450,14 @@ shared_ptr<Matrix> DFBlock::form_mat(const Tensor1<double>& fit) const {
 }
 
 
+shared_ptr<Matrix> DFBlock::form_mat(const Matrix& fit) const {
+  assert(fit.ndim() == asize());
+  auto out = make_shared<Matrix>(b1size()*b2size(), fit.mdim());
+  contract(1.0, group(*this,1,3), {1,0}, fit, {1,2}, 0.0, *out, {0,2});
+  return out;
+}
+
+
 void DFBlock::contrib_apply_J(const shared_ptr<const DFBlock> o, const shared_ptr<const Matrix> d) {
   if (b1size() != o->b1size() || b2size() != o->b2size()) throw logic_error("illegal call of DFBlock::contrib_apply_J");
   assert(astart_ == 0 && o->astart_ == 0);
@@ -140,6 +140,8 @@ class DFBlock : public btas::Tensor3<double> {
 
     // Form 2- and 4-index integrals
     std::shared_ptr<Matrix> form_2index(const std::shared_ptr<const DFBlock> o, const double a) const;
+    // b1 of this is nbatch consecutive copies of b1 of o (batch index slowest); one (b2, o->b2) matrix per batch from a single GEMM
+    std::vector<std::shared_ptr<Matrix>> form_2index_batch(const std::shared_ptr<const DFBlock> o, const double a, const int nbatch) const;
     std::shared_ptr<Matrix> form_4index(const std::shared_ptr<const DFBlock> o, const double a) const;
     // slowest index of o is fixed to n
     std::shared_ptr<Matrix> form_4index_1fixed(const std::shared_ptr<const DFBlock> o, const double a, const size_t n) const;
@@ -149,6 +151,8 @@ class DFBlock : public btas::Tensor3<double> {
 
     std::shared_ptr<VectorB> form_vec(const std::shared_ptr<const Matrix> den) const;
     std::shared_ptr<Matrix> form_mat(const btas::Tensor1<double>& fit) const;
+    // multiple fitting vectors stored as columns; returns (b1*b2, fit.mdim())
+    std::shared_ptr<Matrix> form_mat(const Matrix& fit) const;
 
     void contrib_apply_J(const std::shared_ptr<const DFBlock> o, const std::shared_ptr<const Matrix> mat);
 
@@ -37,10 +37,12 @@ class DFIntTask_OLD {
     std::array<int,2> offset_; // at most 3 elements
     int rank_;
     T* df_;
+    // (naux, naux) matrix that receives the 2-index integrals
+    double* data2_;
 
   public:
-    DFIntTask_OLD(std::array<std::shared_ptr<const Shell>,4>&& a, std::array<int,2>&& b, T* df)
-     : shell_(a), offset_(b), rank_(offset_.size()), df_(df) { }
+    DFIntTask_OLD(std::array<std::shared_ptr<const Shell>,4>&& a, std::array<int,2>&& b, T* df, double* data2)
+     : shell_(a), offset_(b), rank_(offset_.size()), df_(df), data2_(data2) { }
 
     void compute() {
 
@@ -50,7 +52,7 @@ class DFIntTask_OLD {
       const size_t naux = df_->naux();
       // all slot in
       if (rank_ == 2) {
-        double* const data = df_->data2_->data();
+        double* const data = data2_;
         for (int j0 = offset_[0]; j0 != offset_[0] + shell_[2]->nbasis(); ++j0)
           for (int j1 = offset_[1]; j1 != offset_[1] + shell_[0]->nbasis(); ++j1, ++ppt)
             data[j1+j0*naux] = data[j0+j1*naux] = *ppt;
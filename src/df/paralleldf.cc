@@ -29,7 +29,7 @@ using namespace std;
 using namespace bagel;
 
 
-ParallelDF::ParallelDF(const size_t naux, const size_t nb1, const size_t nb2, shared_ptr<const ParallelDF> df, shared_ptr<Matrix> dat, const bool serial)
+ParallelDF::ParallelDF(const size_t naux, const size_t nb1, const size_t nb2, shared_ptr<const ParallelDF> df, shared_ptr<const Matrix> dat, const bool serial)
  : naux_(naux), nindex1_(nb1), nindex2_(nb2), df_(df), data2_(dat), serial_(df ? df->serial_ : serial) {
 
 }
@@ -44,6 +44,16 @@ shared_ptr<Matrix> ParallelDF::form_2index(shared_ptr<const ParallelDF> o, const
 }
 
 
+vector<shared_ptr<Matrix>> ParallelDF::form_2index_batch(shared_ptr<const ParallelDF> o, const double a, const int nbatch) const {
+  if (block_.size() != 1 || o->block_.size() != 1) throw logic_error("so far assumes block_.size() == 1");
+  vector<shared_ptr<Matrix>> out = block_[0]->form_2index_batch(o->block_[0], a, nbatch);
+  if (!serial_)
+    for (auto& i : out)
+      i->allreduce();
+  return out;
+}
+
+
 shared_ptr<Matrix> ParallelDF::form_4index(shared_ptr<const ParallelDF> o, const double a, const bool swap) const {
   if (block_.size() != 1 || o->block_.size() != 1) throw logic_error("so far assumes block_.size() == 1");
   shared_ptr<Matrix> out = (!swap) ? block_[0]->form_4index(o->block_[0], a) : o->block_[0]->form_4index(block_[0], a);
@@ -127,9 +137,9 @@ shared_ptr<btas::Tensor3<double>> ParallelDF::get_block(const int i, const int i
 shared_ptr<Matrix> ParallelDF::compute_Jop_from_cd(shared_ptr<const VectorB> tmp0) const {
   if (block_.size() != 1) throw logic_error("compute_Jop so far assumes block_.size() == 1");
   shared_ptr<Matrix> out = block_[0]->form_mat(tmp0->slice(block_[0]->astart(), block_[0]->astart()+block_[0]->asize()));
-  // all reduce
+  // all reduce (within a node first)
   if (!serial_)
-    out->allreduce();
+    mpi__->node_allreduce(out->data(), out->size());
   return out;
 }
 
@@ -146,18 +156,99 @@ shared_ptr<VectorB> ParallelDF::compute_cd(const shared_ptr<const Matrix> den, s
   copy_n(tmp->data(), block_[0]->asize(), tmp0->data()+block_[0]->astart());
   // All reduce
   if (!serial_)
-    tmp0->allreduce();
+    mpi__->node_allreduce(tmp0->data(), tmp0->size());
 
-  if (number_of_j == 1)
+  if (number_of_j < 0 || number_of_j > 2)
+    throw logic_error("wrong number of J in ParallelDF::compute_cd");
+
+  if (use_J_node(number_of_j))
+    apply_J_node(dat2, tmp0->data(), 1, number_of_j);
+  else if (number_of_j == 1)
     *tmp0 = *dat2 * *tmp0;
   else if (number_of_j == 2)
     *tmp0 = *dat2 * (*dat2 * *tmp0);
-  else if (number_of_j != 0)
-    throw logic_error("wrong number of J in ParallelDF::compute_cd");
   return tmp0;
 }
 
 
+bool ParallelDF::use_J_node(const int number_of_j) const {
+  // a buffer made before mpi__->split() or merge() changed the node communicator cannot be used collectively;
+  // it is not reallocated either (its destruction is collective over the processes that made it)
+  return !serial_ && mpi__->node_size() > 1 && number_of_j != 0 && (!cd_buffer_ || cd_buffer_->current());
+}
+
+
+void ParallelDF::apply_J_node(shared_ptr<const Matrix> dat2, double* cd, const int ncol, const int number_of_j) const {
+  // J^-1/2 is held once per node; the processes on a node each multiply a block of rows into a node-shared buffer
+  if (!cd_buffer_ || cd_buffer_->size() < naux_*ncol)
+    cd_buffer_ = make_shared<SharedMemory<double>>(naux_*ncol);
+  SharedMemory<double>& buf = *cd_buffer_;
+  const size_t nrow = (naux_-1) / buf.node_size() + 1;
+  const size_t rstart = min(naux_, nrow * buf.node_rank());
+  const size_t rsize = min(naux_, rstart + nrow) - rstart;
+  for (int j = 0; j != number_of_j; ++j) {
+    if (rsize)
+      dgemm_("N", "N", rsize, ncol, naux_, 1.0, dat2->element_ptr(rstart, 0), naux_, cd, naux_, 0.0, buf.data()+rstart, naux_);
+    buf.sync();
+    copy_n(buf.data(), naux_*ncol, cd);
+    buf.sync();
+  }
+}
+
+
+vector<shared_ptr<Matrix>> ParallelDF::compute_Jop_from_cd(shared_ptr<const Matrix> cd) const {
+  if (block_.size() != 1) throw logic_error("compute_Jop so far assumes block_.size() == 1");
+  shared_ptr<Matrix> tmp = block_[0]->form_mat(*cd->cut(block_[0]->astart(), block_[0]->astart()+block_[0]->asize()));
+  if (!serial_)
+    mpi__->node_allreduce(tmp->data(), tmp->size());
+
+  const size_t nb1 = block_[0]->b1size();
+  const size_t nb2 = block_[0]->b2size();
+  vector<shared_ptr<Matrix>> out;
+  for (int i = 0; i != cd->mdim(); ++i) {
+    out.push_back(make_shared<Matrix>(nb1, nb2));
+    copy_n(tmp->element_ptr(0, i), nb1*nb2, out.back()->data());
+  }
+  return out;
+}
+
+
+shared_ptr<Matrix> ParallelDF::compute_cd(const vector<shared_ptr<const Matrix>>& den, shared_ptr<const Matrix> dat2, const int number_of_j) const {
+  if (!dat2 && !data2_) throw logic_error("ParallelDF::compute_cd was called without 2-index integrals");
+  if (!dat2) dat2 = data2_;
+  if (number_of_j < 0 || number_of_j > 2)
+    throw logic_error("wrong number of J in ParallelDF::compute_cd");
+  if (block_.size() != 1) throw logic_error("compute_Jop so far assumes block_.size() == 1");
+
+  // densities are stacked so that (D|rs)*d_rs is a single GEMM
+  const size_t nb12 = block_[0]->b1size()*block_[0]->b2size();
+  Matrix dens(nb12, den.size());
+  for (int i = 0; i != den.size(); ++i) {
+    assert(den[i]->size() == nb12);
+    copy_n(den[i]->data(), nb12, dens.element_ptr(0, i));
+  }
+  shared_ptr<Matrix> tmp = block_[0]->form_Dj(make_shared<const Matrix>(move(dens)), den.size());
+
+  auto out = make_shared<Matrix>(naux_, den.size());
+  out->copy_block(block_[0]->astart(), 0, block_[0]->asize(), den.size(), tmp);
+  if (!serial_)
+    mpi__->node_allreduce(out->data(), out->size());
+
+  if (use_J_node(number_of_j))
+    apply_J_node(dat2, out->data(), den.size(), number_of_j);
+  else
+    for (int j = 0; j != number_of_j; ++j)
+      *out = *dat2 * *out;
+  return out;
+}
+
+
+vector<shared_ptr<Matrix>> ParallelDF::compute_Jop(const shared_ptr<const ParallelDF> o, const vector<shared_ptr<const Matrix>>& den, const bool onlyonce) const {
+  shared_ptr<const Matrix> tmp0 = o->compute_cd(den, data2_, onlyonce ? 1 : 2);
+  return compute_Jop_from_cd(tmp0);
+}
+
+
 shared_ptr<Matrix> ParallelDF::compute_Jop(const shared_ptr<const Matrix> den) const {
   return compute_Jop(this->shared_from_this(), den);
 }
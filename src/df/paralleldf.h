@@ -29,6 +29,7 @@
 #include <src/df/dfinttask_old.h>
 #include <src/df/dfinttask.h>
 #include <src/df/dfblock.h>
+#include <src/util/parallel/sharedmemory.h>
 
 namespace bagel {
 
@@ -44,13 +45,21 @@ class ParallelDF : public std::enable_shared_from_this<ParallelDF> {
 
     std::shared_ptr<const ParallelDF> df_;
     // data2_ is usually empty (except for the original DFDist)
-    // AO two-index integrals ^ -1/2
-    std::shared_ptr<Matrix> data2_;
+    // AO two-index integrals ^ -1/2 (a SharedMatrix, i.e., one copy per node, unless serial).
+    // It is read only since the processes on a node share the elements; its destruction is collective within a node.
+    std::shared_ptr<const Matrix> data2_;
+    // node-shared buffer used by compute_cd to apply J^-1/2; allocated on first use (grown for larger batches) and kept for the lifetime of this object
+    mutable std::shared_ptr<SharedMemory<double>> cd_buffer_;
+
+    // whether compute_cd applies J^-1/2 with apply_J_node
+    bool use_J_node(const int number_of_j) const;
+    // cd (naux, ncol) = dat2^number_of_j cd, with the rows split over the processes on a node (collective within a node)
+    void apply_J_node(std::shared_ptr<const Matrix> dat2, double* cd, const int ncol, const int number_of_j) const;
 
     bool serial_;
 
   public:
-    ParallelDF(const size_t, const size_t, const size_t, std::shared_ptr<const ParallelDF> = nullptr, std::shared_ptr<Matrix> = nullptr, const bool serial = false);
+    ParallelDF(const size_t, const size_t, const size_t, std::shared_ptr<const ParallelDF> = nullptr, std::shared_ptr<const Matrix> = nullptr, const bool serial = false);
     virtual ~ParallelDF() { }
 
     size_t naux() const { return naux_; }
@@ -70,6 +79,7 @@ class ParallelDF : public std::enable_shared_from_this<ParallelDF> {
     void add_block(std::shared_ptr<DFBlock> o);
 
     std::shared_ptr<Matrix> form_2index(std::shared_ptr<const ParallelDF> o, const double a, const bool swap = false) const;
+    std::vector<std::shared_ptr<Matrix>> form_2index_batch(std::shared_ptr<const ParallelDF> o, const double a, const int nbatch) const;
     std::shared_ptr<Matrix> form_4index(std::shared_ptr<const ParallelDF> o, const double a, const bool swap = false) const;
     std::shared_ptr<Matrix> form_aux_2index(std::shared_ptr<const ParallelDF> o, const double a) const;
 
@@ -92,6 +102,11 @@ class ParallelDF : public std::enable_shared_from_this<ParallelDF> {
     std::shared_ptr<Matrix> compute_Jop_from_cd(std::shared_ptr<const VectorB> cd) const;
     std::shared_ptr<VectorB> compute_cd(const std::shared_ptr<const Matrix> den, std::shared_ptr<const Matrix> dat2 = nullptr, const int number_of_j = 2) const;
 
+    // batched versions: one pass over the 3-index integrals for all the densities; cd vectors are the columns of (naux, nden)
+    std::vector<std::shared_ptr<Matrix>> compute_Jop(const std::shared_ptr<const ParallelDF> o, const std::vector<std::shared_ptr<const Matrix>>& den, const bool onlyonce = false) const;
+    std::vector<std::shared_ptr<Matrix>> compute_Jop_from_cd(std::shared_ptr<const Matrix> cd) const;
+    std::shared_ptr<Matrix> compute_cd(const std::vector<std::shared_ptr<const Matrix>>& den, std::shared_ptr<const Matrix> dat2 = nullptr, const int number_of_j = 2) const;
+
     void average_3index() {
       Timer time;
       if (!serial_)
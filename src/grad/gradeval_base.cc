@@ -28,11 +28,139 @@
 #include <src/util/taskqueue.h>
 #include <src/util/parallel/resources.h>
 #include <src/util/parallel/mpi_interface.h>
+#include <src/integral/rys/eribatch.h>
+#include <src/integral/libint/libint.h>
 #include <array>
 
 using namespace std;
 using namespace bagel;
 
+namespace {
+// globally unique tags so that a thread can tell whether its cached buffer slot belongs to the current round of tasks
+atomic<size_t> grad_generation(0);
+}
+
+
+GradEval_base::GradEval_base(const shared_ptr<const Geometry> g)
+ : geom_(g), grad_(make_shared<GradFile>(g->natom())), mutex_(g->natom()), nthread_(0), generation_(++grad_generation) {
+  for (int i = 0; i != resources__->max_num_threads(); ++i)
+    grad_thread_.push_back(make_shared<GradFile>(g->natom()));
+}
+
+
+GradFile* GradEval_base::thread_grad() {
+  static thread_local size_t generation = 0;
+  static thread_local int slot = -1;
+  if (generation != generation_) {
+    generation = generation_;
+    slot = nthread_++;
+  }
+  return slot < static_cast<int>(grad_thread_.size()) ? grad_thread_[slot].get() : nullptr;
+}
+
+
+void GradEval_base::add_grad(const int iatom, const array<double,3>& g) {
+  GradFile* buf = thread_grad();
+  if (buf) {
+    for (int icart = 0; icart != 3; ++icart)
+      buf->element(icart, iatom) += g[icart];
+  } else {
+    // more threads than buffers (should not happen)
+    lock_guard<mutex> lock(mutex_[iatom]);
+    for (int icart = 0; icart != 3; ++icart)
+      grad_->element(icart, iatom) += g[icart];
+  }
+}
+
+
+void GradEval_base::add_grad(const GradFile& g) {
+  GradFile* buf = thread_grad();
+  if (buf) {
+    *buf += g;
+  } else {
+    for (int iatom = 0; iatom != g.mdim(); ++iatom)
+      add_grad(iatom, {{g.element(0, iatom), g.element(1, iatom), g.element(2, iatom)}});
+  }
+}
+
+
+void GradEval_base::compute_tasks(vector<shared_ptr<GradTask>>&& task) {
+  TaskQueue<shared_ptr<GradTask>> tq(move(task));
+  tq.compute();
+
+  const int n = min(nthread_.load(), static_cast<int>(grad_thread_.size()));
+  for (int i = 0; i != n; ++i) {
+    *grad_ += *grad_thread_[i];
+    grad_thread_[i]->zero();
+  }
+  nthread_ = 0;
+  generation_ = ++grad_generation;
+}
+
+
+void GradEval_base::init_schwarz(const shared_ptr<const Geometry> geom) {
+  if (schwarz_geom_ == geom) return;
+  schwarz_geom_ = geom;
+
+  vector<shared_ptr<const Shell>> basis;
+  for (auto& a : geom->atoms())
+    basis.insert(basis.end(), a->shells().begin(), a->shells().end());
+  // shells of dummy auxiliary atoms are kept as nullptr so that the indices match
+  vector<shared_ptr<const Shell>> aux;
+  for (auto& a : geom->aux_atoms())
+    for (auto& b : a->shells())
+      aux.push_back(a->dummy() ? nullptr : b);
+
+  const int size = basis.size();
+  schwarz_.resize(size*size);
+  schwarz_aux_.assign(aux.size(), 0.0);
+
+  // the norm of the gradient of a normalized primitive r^l Y_lm exp(-alpha r^2) is sqrt(alpha (2l+3))
+  auto deriv = [](const shared_ptr<const Shell>& b) {
+    return b ? sqrt(*max_element(b->exponents().begin(), b->exponents().end()) * (2*b->angular_number()+3)) : 0.0;
+  };
+  deriv_.resize(size);
+  transform(basis.begin(), basis.end(), deriv_.begin(), deriv);
+  deriv_aux_.resize(aux.size());
+  transform(aux.begin(), aux.end(), deriv_aux_.begin(), deriv);
+
+  auto maxabs = [](const double* data, const int n) {
+    double out = 0.0;
+    for (int i = 0; i != n; ++i)
+      out = max(out, sqrt(fabs(data[i])));
+    return out;
+  };
+
+  TaskQueue<function<void(void)>> tasks(size*(size+1)/2 + aux.size());
+  for (int i0 = 0; i0 != size; ++i0)
+    for (int i1 = i0; i1 != size; ++i1)
+      tasks.emplace_back([&, i0, i1]() {
+        array<shared_ptr<const Shell>,4> input = {{basis[i1], basis[i0], basis[i1], basis[i0]}};
+#ifdef LIBINT_INTERFACE
+        Libint eribatch(input);
+#else
+        ERIBatch eribatch(input, 0.0);
+#endif
+        eribatch.compute();
+        schwarz_[i0*size+i1] = schwarz_[i1*size+i0] = maxabs(eribatch.data(), eribatch.data_size());
+      });
+  for (int i = 0; i != static_cast<int>(aux.size()); ++i)
+    if (aux[i])
+      tasks.emplace_back([&, i]() {
+        auto b3 = make_shared<const Shell>(aux[i]->spherical());
+        array<shared_ptr<const Shell>,4> input = {{aux[i], b3, aux[i], b3}};
+#ifdef LIBINT_INTERFACE
+        Libint eribatch(input);
+#else
+        ERIBatch eribatch(input, 0.0);
+#endif
+        eribatch.compute();
+        schwarz_aux_[i] = maxabs(eribatch.data(), eribatch.data_size());
+      });
+  tasks.compute();
+}
+
+
 shared_ptr<GradFile> GradEval_base::contract_gradient(const shared_ptr<const Matrix> d, const shared_ptr<const Matrix> w,
                                                       const shared_ptr<const DFDist> o, const shared_ptr<const Matrix> o2,
                                                       const shared_ptr<const Matrix> v, const bool numerical,
@@ -40,6 +168,10 @@ shared_ptr<GradFile> GradEval_base::contract_gradient(const shared_ptr<const Mat
   grad_->zero();
 
   if (!numerical) {
+    // the derivative integrals of the point charges are exact, and so must be the energy
+    if (geom_->hcoreinfo()->charge_thresh() > 0.0 && any_of(geom_->atoms().begin(), geom_->atoms().end(), [](shared_ptr<const Atom> a) { return a->name() == "q"; }))
+      throw runtime_error("Analytical gradients require exact point-charge integrals. Set charge_thresh to zero or use numerical gradients.");
+
     vector<shared_ptr<GradTask>> task  = contract_grad2e(o);
 
     vector<shared_ptr<GradTask>> task2;
@@ -67,13 +199,10 @@ shared_ptr<GradFile> GradEval_base::contract_gradient(const shared_ptr<const Mat
       task.insert(task.end(), task0.begin(), task0.end());
     }
 
-    TaskQueue<shared_ptr<GradTask>> tq(move(task));
-    tq.compute();
+    compute_tasks(move(task));
   } else {
     vector<shared_ptr<GradTask>> task = contract_grad1e<GradTask1s>(v, v);
-
-    TaskQueue<shared_ptr<GradTask>> tq(move(task));
-    tq.compute();
+    compute_tasks(move(task));
   }
 
   if (!v)
@@ -318,6 +447,17 @@ vector<shared_ptr<GradTask>> GradEval_base::contract_grad2e(const shared_ptr<con
 
   out.reserve(nshell*(nshell+1)*nshell2/2);
 
+  // Schwarz factors for screening with the density blocks; the task is skipped when Q_ij Q_P max(d_i, d_j, d_P) max|D|
+  // is below schwarz_thresh, where d are the derivative bounds of the three shells
+  init_schwarz(cgeom);
+  const double thresh = cgeom->schwarz_thresh();
+  vector<int> shell_start(1, 0);
+  for (auto& a : cgeom->atoms())
+    shell_start.push_back(shell_start.back() + a->shells().size());
+  vector<int> aux_start(1, 0);
+  for (auto& a : cgeom->aux_atoms())
+    aux_start.push_back(aux_start.back() + a->shells().size());
+
   // loop over atoms (using symmetry b0 <-> b1)
   int iatom0 = 0;
   auto oa0 = cgeom->offsets().begin();
@@ -333,19 +473,27 @@ vector<shared_ptr<GradTask>> GradEval_base::contract_grad2e(const shared_ptr<con
         auto b3 = make_shared<const Shell>((*a2)->shells().front()->spherical());
 
         auto o0 = oa0->begin();
-        for (auto b0 = (*a0)->shells().begin(); b0 != (*a0)->shells().end(); ++b0, ++o0) {
+        int i0 = shell_start[iatom0];
+        for (auto b0 = (*a0)->shells().begin(); b0 != (*a0)->shells().end(); ++b0, ++o0, ++i0) {
           auto o1 = a0!=a1 ? oa1->begin() : o0;
-          for (auto b1 = (a0!=a1 ? (*a1)->shells().begin() : b0); b1 != (*a1)->shells().end(); ++b1, ++o1) {
+          int i1 = a0!=a1 ? shell_start[iatom1] : i0;
+          for (auto b1 = (a0!=a1 ? (*a1)->shells().begin() : b0); b1 != (*a1)->shells().end(); ++b1, ++o1, ++i1) {
+            const double q01 = schwarz_[i0*shell_start.back()+i1];
+            const double d01 = max(deriv_[i0], deriv_[i1]);
             auto o2 = oa2->begin();
-            for (auto b2 = (*a2)->shells().begin(); b2 != (*a2)->shells().end(); ++b2, ++o2) {
+            int i2 = aux_start[iatom2];
+            for (auto b2 = (*a2)->shells().begin(); b2 != (*a2)->shells().end(); ++b2, ++o2, ++i2) {
               tuple<size_t, size_t> info = o->adist_now()->locate(*o2);
               if (get<0>(info) != mpi__->rank()) continue;
 
+              const double q = q01 * schwarz_aux_[i2] * max(d01, deriv_aux_[i2]);
+              if (q < numeric_limits<double>::min()) continue;
+
               array<shared_ptr<const Shell>,4> input = {{b3, *b2, *b1, *b0}};
               vector<int> atoms = {iatom0, iatom1, iatom2};
               vector<int> offs = {*o0, *o1, *o2};
 
-              out.push_back(make_shared<GradTask3>(input, atoms, offs, o, this));
+              out.push_back(make_shared<GradTask3>(input, atoms, offs, o, this, thresh/q));
             }
           }
         }
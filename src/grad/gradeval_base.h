@@ -26,6 +26,7 @@
 #define __SRC_GRAD_GRADEVAL_BASE_H
 
 #include <mutex>
+#include <atomic>
 #include <src/util/math/xyzfile.h>
 #include <src/wfn/geometry.h>
 
@@ -68,8 +69,29 @@ class GradEval_base {
     std::shared_ptr<GradFile> grad_;
     std::vector<std::mutex> mutex_;
 
+    // per-thread gradient buffers; tasks add to them without locks and compute_tasks sums them into grad_
+    std::vector<std::shared_ptr<GradFile>> grad_thread_;
+    std::atomic<int> nthread_;
+    size_t generation_;
+    GradFile* thread_grad();
+    void add_grad(const int iatom, const std::array<double,3>& g);
+    void add_grad(const GradFile& g);
+
+    // runs the tasks using threads and reduces the per-thread buffers into grad_
+    void compute_tasks(std::vector<std::shared_ptr<GradTask>>&& task);
+
+    // Schwarz factors used to screen 3-index derivative integrals: max|(ij|ij)|^1/2 for basis-shell pairs and max|(P|P)|^1/2 for auxiliary shells
+    std::shared_ptr<const Geometry> schwarz_geom_;
+    std::vector<double> schwarz_;
+    std::vector<double> schwarz_aux_;
+    // bounds on the derivative of the basis functions relative to the functions themselves, sqrt(alpha_max (2l+3)) per shell,
+    // which multiply the Schwarz factors above since they are computed from undifferentiated integrals
+    std::vector<double> deriv_;
+    std::vector<double> deriv_aux_;
+    void init_schwarz(const std::shared_ptr<const Geometry> geom);
+
   public:
-    GradEval_base(const std::shared_ptr<const Geometry> g) : geom_(g), grad_(std::make_shared<GradFile>(g->natom())), mutex_(g->natom()) { }
+    GradEval_base(const std::shared_ptr<const Geometry> g);
 
     /// compute gradient given density matrices
     std::shared_ptr<GradFile> contract_gradient(const std::shared_ptr<const Matrix> d, const std::shared_ptr<const Matrix> w,
@@ -30,7 +30,6 @@
 #include <src/integral/rys/gsmalleribatch.h>
 #include <src/integral/os/goverlapbatch.h>
 #include <src/integral/os/gkineticbatch.h>
-#include <src/util/prim_op.h>
 #ifdef LIBINT_INTERFACE
   #include <src/integral/libint/glibint.h>
 #endif
@@ -40,14 +39,36 @@ using namespace bagel;
 
 
 void GradTask3::compute() {
+  assert(den_->block().size() == 1);
+  const DFBlock& blk = *den_->block(0);
+  const int na = shell_[1]->nbasis();
+  const int n2 = shell_[2]->nbasis();
+  const int n3 = shell_[3]->nbasis();
+  const size_t ia = offset_[2] - blk.astart();
+
+  // density blocks (a, j, k) and (a, k, j) are read in place; they are contiguous along the auxiliary index
+  auto den = [&](const int j, const int k) { return &blk(ia, offset_[1]+j-blk.b1start(), offset_[0]+k-blk.b2start()); };
+  auto dent = [&](const int j, const int k) { return &blk(ia, offset_[0]+k-blk.b1start(), offset_[1]+j-blk.b2start()); };
+
+  if (dthresh_ > 0.0) {
+    double dmax = 0.0;
+    for (int k = 0; k != n3; ++k)
+      for (int j = 0; j != n2; ++j) {
+        const double* d1 = den(j, k);
+        const double* d2 = dent(j, k);
+        for (int a = 0; a != na; ++a)
+          dmax = max(dmax, fabs(d1[a] + d2[a]));
+      }
+    if (dmax < dthresh_) return;
+  }
+
 #ifdef LIBINT_INTERFACE
   GLibint gradbatch(shell_);
 #else
   GradBatch gradbatch(shell_, 0.0);
 #endif
   gradbatch.compute();
-  const size_t sblock = shell_[1]->nbasis()*shell_[2]->nbasis()*shell_[3]->nbasis();
-  assert(sblock <= gradbatch.size_block());
+  assert(static_cast<size_t>(na*n2*n3) <= gradbatch.size_block());
 
   // unfortunately the convention is different...
   array<int,4> jatom = {{-1, atomindex_[2], atomindex_[1], atomindex_[0]}};
@@ -55,20 +76,18 @@ void GradTask3::compute() {
   if (gradbatch.swap01()) swap(jatom[0], jatom[1]);
   if (gradbatch.swap23()) swap(jatom[2], jatom[3]);
 
-  shared_ptr<btas::Tensor3<double>> db1 = den_->get_block(offset_[2], shell_[1]->nbasis(), offset_[1], shell_[2]->nbasis(), offset_[0], shell_[3]->nbasis());
-  shared_ptr<btas::Tensor3<double>> db2 = den_->get_block(offset_[2], shell_[1]->nbasis(), offset_[0], shell_[3]->nbasis(), offset_[1], shell_[2]->nbasis());
-  sort_indices<0,2,1,1,1,1,1>(db2->data(), db1->data(), shell_[1]->nbasis(), shell_[3]->nbasis(), shell_[2]->nbasis());
-
+  const double fac = 0.5 * (shell_[2] == shell_[3] ? 1.0 : 2.0);
   for (int iatom = 0; iatom != 4; ++iatom) {
     if (jatom[iatom] < 0) continue;
     array<double,3> sum = {{0.0, 0.0, 0.0}};
     for (int icart = 0; icart != 3; ++icart) {
       const double* ppt = gradbatch.data(icart+iatom*3);
-      sum[icart] += blas::dot_product(ppt, sblock, db1->data());
+      for (int k = 0; k != n3; ++k)
+        for (int j = 0; j != n2; ++j, ppt += na)
+          sum[icart] += blas::dot_product(ppt, na, den(j, k)) + blas::dot_product(ppt, na, dent(j, k));
+      sum[icart] *= fac;
     }
-    lock_guard<mutex> lock(ge_->mutex_[jatom[iatom]]);
-    for (int icart = 0; icart != 3; ++icart)
-      ge_->grad_->element(icart, jatom[iatom]) += 0.5 * sum[icart] * (shell_[2] == shell_[3] ? 1.0 : 2.0);
+    ge_->add_grad(jatom[iatom], sum);
   }
 }
 
@@ -101,9 +120,7 @@ void GradTask1f::compute() {
       const double* ppt = gradbatch.data(icart+iatom*3);
       sum[icart] += blas::dot_product(ppt, sblock, db1->data());
     }
-    lock_guard<mutex> lock(ge_->mutex_[jatom[iatom]]);
-    for (int icart = 0; icart != 3; ++icart)
-      ge_->grad_->element(icart, jatom[iatom]) += sum[icart];
+    ge_->add_grad(jatom[iatom], sum);
   }
 }
 
@@ -136,10 +153,10 @@ void GradTask2::compute() {
         }
       }
     }
-    lock_guard<mutex> lock(ge_->mutex_[jatom[iatom]]);
     // first 0.5 from symmetrization. second 0.5 from the Hamiltonian
     for (int icart = 0; icart != 3; ++icart)
-      ge_->grad_->element(icart, jatom[iatom]) -= 0.5 * sum[icart] * 0.5 * (shell_[0] == shell_[2] ? 1.0 : 2.0);
+      sum[icart] *= -0.5 * 0.5 * (shell_[0] == shell_[2] ? 1.0 : 2.0);
+    ge_->add_grad(jatom[iatom], sum);
   }
 }
 
@@ -152,12 +169,7 @@ void GradTask1::compute() {
   *grad_local += *compute_os<GKineticBatch>(den3_);
   *grad_local -= *compute_os<GOverlapBatch>(eden_);
 
-  for (int iatom = 0; iatom != ge_->geom_->natom(); ++iatom) {
-    lock_guard<mutex> lock(ge_->mutex_[iatom]);
-    ge_->grad_->element(0, iatom) += grad_local->element(0, iatom);
-    ge_->grad_->element(1, iatom) += grad_local->element(1, iatom);
-    ge_->grad_->element(2, iatom) += grad_local->element(2, iatom);
-  }
+  ge_->add_grad(*grad_local);
 }
 
 
@@ -175,12 +187,7 @@ void GradTask1s::compute() {
   auto grad_local = make_shared<GradFile>(ge_->geom_->natom());
   *grad_local += *compute_os<GDerivOverBatch>(eden_);
 
-  for (int iatom = 0; iatom != ge_->geom_->natom(); ++iatom) {
-    lock_guard<mutex> lock(ge_->mutex_[iatom]);
-    ge_->grad_->element(0, iatom) += grad_local->element(0, iatom);
-    ge_->grad_->element(1, iatom) += grad_local->element(1, iatom);
-    ge_->grad_->element(2, iatom) += grad_local->element(2, iatom);
-  }
+  ge_->add_grad(*grad_local);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -193,10 +200,7 @@ void GradTask3r::compute() {
     if (find(done.begin(), done.end(), iatom) != done.end()) continue; // should not add twice
     done.push_back(iatom);
 
-    lock_guard<mutex> lock(ge_->mutex_[iatom]);
-    ge_->grad_->element(0, iatom) += grad_local->element(0, iatom);
-    ge_->grad_->element(1, iatom) += grad_local->element(1, iatom);
-    ge_->grad_->element(2, iatom) += grad_local->element(2, iatom);
+    ge_->add_grad(iatom, {{grad_local->element(0, iatom), grad_local->element(1, iatom), grad_local->element(2, iatom)}});
   }
 }
 
@@ -225,10 +229,7 @@ void GradTask1rf::compute() {
     if (find(done.begin(), done.end(), iatom) != done.end()) continue; // should not add twice
     done.push_back(iatom);
 
-    lock_guard<mutex> lock(ge_->mutex_[iatom]);
-    ge_->grad_->element(0, iatom) += grad_local->element(0, iatom);
-    ge_->grad_->element(1, iatom) += grad_local->element(1, iatom);
-    ge_->grad_->element(2, iatom) += grad_local->element(2, iatom);
+    ge_->add_grad(iatom, {{grad_local->element(0, iatom), grad_local->element(1, iatom), grad_local->element(2, iatom)}});
   }
 }
 
@@ -254,12 +255,7 @@ shared_ptr<GradFile> GradTask1rf::compute_smalleri() const {
 
 void GradTask1r::compute() {
   shared_ptr<GradFile> grad_local = compute_smallnai();
-  for (int iatom = 0; iatom != ge_->geom_->natom(); ++iatom) {
-    lock_guard<mutex> lock(ge_->mutex_[iatom]);
-    ge_->grad_->element(0, iatom) += grad_local->element(0, iatom);
-    ge_->grad_->element(1, iatom) += grad_local->element(1, iatom);
-    ge_->grad_->element(2, iatom) += grad_local->element(2, iatom);
-  }
+  ge_->add_grad(*grad_local);
 }
 
 
@@ -288,12 +284,7 @@ void GradTask1d::compute() {
   *grad_local += *compute_os<GKineticBatch>(den_[0]);
   *grad_local += *compute_os<GOverlapBatch>(den_[3]);
 
-  for (int iatom = 0; iatom != ge_->geom_->natom(); ++iatom) {
-    lock_guard<mutex> lock(ge_->mutex_[iatom]);
-    ge_->grad_->element(0, iatom) += grad_local->element(0, iatom);
-    ge_->grad_->element(1, iatom) += grad_local->element(1, iatom);
-    ge_->grad_->element(2, iatom) += grad_local->element(2, iatom);
-  }
+  ge_->add_grad(*grad_local);
 }
 
 
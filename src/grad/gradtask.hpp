@@ -56,10 +56,12 @@ class GradTask3 : public GradTask {
   private:
     std::array<std::shared_ptr<const Shell>, 4> shell_;
     std::shared_ptr<const DFDist> den_;
+    // the task is skipped when max|density block| is below this value
+    double dthresh_;
   public:
     GradTask3(const std::array<std::shared_ptr<const Shell>,4>& s, const std::vector<int>& a, const std::vector<int>& o,
-              const std::shared_ptr<const DFDist> d, GradEval_base* p)
-      : GradTask(a, o, p), shell_(s), den_(d) { }
+              const std::shared_ptr<const DFDist> d, GradEval_base* p, const double dthresh = 0.0)
+      : GradTask(a, o, p), shell_(s), den_(d), dthresh_(dthresh) { }
     void compute();
 };
 
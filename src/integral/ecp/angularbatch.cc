@@ -36,14 +36,27 @@ using namespace std;
 const static SphUSPList sphusplist;
 const static DoubleFactorial df;
 
+namespace {
+// Cartesian components in the order used by ECPBatch
+vector<array<int, 3>> cartesian_components(const int l) {
+  vector<array<int, 3>> out;
+  for (int z = 0; z <= l; ++z)
+    for (int y = 0; y <= l - z; ++y)
+      out.push_back({{l - y - z, y, z}});
+  return out;
+}
+int ncomponents(const shared_ptr<const Shell>& sh) {
+  const int l = sh->angular_number();
+  return (l+1) * (l+2) / 2 * sh->num_contracted();
+}
+}
+
 AngularBatch::AngularBatch(const shared_ptr<const ECP> _ecp, const array<shared_ptr<const Shell>,2>& _info,
-                           const int contA, const int contC, const array<int, 3> angA, const array<int, 3> angC,
                            const bool print, const int max_iter, const double thresh_int)
- : RadialInt(1, print, max_iter, thresh_int),
-   basisinfo_(_info), ecp_(_ecp), cont0_(contA), cont1_(contC), ang0_(angA), ang1_(angC) {
+ : RadialInt(ncomponents(_info[0]) * ncomponents(_info[1]), print, max_iter, thresh_int), basisinfo_(_info), ecp_(_ecp) {
 
-  init();
   map_angular_number();
+  init();
 
 }
 
@@ -80,161 +93,158 @@ void AngularBatch::map_angular_number() {
 
 }
 
-vector<double> AngularBatch::project_AB(const int l, const vector<double> usp, const vector<double> r) {
-  const static MSphBesselI msbessel;
-
-  vector<vector<double>> rbessel(r.size());
-
-  const int begin0 = basisinfo_[0]->contraction_ranges(cont0_).first;
-  const int end0   = basisinfo_[0]->contraction_ranges(cont0_).second;
-  for (int ir = 0; ir != r.size(); ++ir) {
-    vector<double> bessel(l0_+l+1);
-    for (int i0 = begin0; i0 != end0; ++i0) {
-      const double coef0 = basisinfo_[0]->contractions()[cont0_][i0];
-      const double exp0  = basisinfo_[0]->exponents(i0);
-      const double fac = coef0 * exp(-exp0 * pow(dAB_-r[ir], 2));
-      for (int i = 0; i <= l0_+l; ++i)
-        bessel[i] += fac * msbessel.compute(i, 2.0 * exp0 * dAB_ * r[ir]);
-    }
-    rbessel[ir] = bessel;
-  }
-
-  vector<double> out(r.size(), 0.0);
-  for (int j = 0; j != usp.size(); ++j) {
-    if (usp[j] != 0.0) {
-      map<int, array<int, 3>>::const_iterator pj = map_[l].find(j);
-      assert (pj != map_[l].end());
-      const array<int, 3> kj = pj->second;
-
-      for (int kx = 0; kx <= ang0_[0]; ++kx)
-      for (int ky = 0; ky <= ang0_[1]; ++ky)
-      for (int kz = 0; kz <= ang0_[2]; ++kz) {
-        const int lk = kx + ky + kz;
-        const int index = kx * ANG_HRR_END * ANG_HRR_END + ky * ANG_HRR_END + kz;
-        const double coeff = c0_[index] * pow(-1.0, lk - l0_);
-        if (abs(coeff) > 1e-15) {
-        for (int ld = max(l-lk, 0); ld <= l+lk; ++ld) {
-            if ((l + lk - ld) % 2 == 0) {
-              double smu = 0.0;
-              for (int mu = 0; mu <= 2 * ld; ++mu) {
-
-                const vector<double> usp1 = sphusplist.sphuspfunc_call(ld, mu-ld);
-                double sAB = 0.0;
-                for (int i = 0; i != usp1.size(); ++i) {
-                  if (usp1[i] != 0.0) {
-                    map<int, array<int, 3>>::const_iterator p = map_[ld].find(i);
-                    assert (p != map_[ld].end());
-                    const array<int, 3> ki = p->second;
-                    const int x = ki[0] + kj[0] + kx;
-                    const int y = ki[1] + kj[1] + ky;
-                    const int z = ki[2] + kj[2] + kz;
-                    const double xyz = (x % 2 == 0 && y % 2 == 0 && z % 2 == 0) ? (4.0 * pi__ * df(x-1) * df(y-1) * df(z-1) / df(x+y+z+1)) : 0.0;
-                    sAB += usp1[i] * usp[j] * xyz;
-                  }
-                }
-                smu += zAB_[ld][mu] * sAB;
-              }
-              for (int ir = 0; ir != r.size(); ++ir) out[ir] += smu * rbessel[ir][ld] * coeff * pow(r[ir], lk);
-            }
+vector<double> AngularBatch::angular(const int l, const int m, const int lshell, const vector<array<int, 3>>& ang,
+                                     const array<double, 3>& AB, const vector<vector<double>>& zAB) const {
+  const static Comb c;
+  const vector<double> usp = sphusplist.sphuspfunc_call(l, m-l);
+  const int nld = l + lshell + 1;
+
+  // sum_mu Z_{ld,mu}(AB) <lm | x^k | ld mu> for every x^k with |k| <= lshell; shared by all the Cartesian components
+  vector<double> smu(ANG_HRR_END*ANG_HRR_END*ANG_HRR_END*nld, 0.0);
+  for (int kx = 0; kx <= lshell; ++kx)
+  for (int ky = 0; ky <= lshell - kx; ++ky)
+  for (int kz = 0; kz <= lshell - kx - ky; ++kz) {
+    const int lk = kx + ky + kz;
+    const int index = kx * ANG_HRR_END * ANG_HRR_END + ky * ANG_HRR_END + kz;
+    for (int ld = max(l-lk, 0); ld <= l+lk; ++ld) {
+      if ((l + lk - ld) % 2 != 0) continue;
+      double sum = 0.0;
+      for (int mu = 0; mu <= 2 * ld; ++mu) {
+        const vector<double> usp1 = sphusplist.sphuspfunc_call(ld, mu-ld);
+        double sAB = 0.0;
+        for (int j = 0; j != usp.size(); ++j) {
+          if (usp[j] == 0.0) continue;
+          const array<int, 3>& kj = map_[l].at(j);
+          for (int i = 0; i != usp1.size(); ++i) {
+            if (usp1[i] == 0.0) continue;
+            const array<int, 3>& ki = map_[ld].at(i);
+            const int x = ki[0] + kj[0] + kx;
+            const int y = ki[1] + kj[1] + ky;
+            const int z = ki[2] + kj[2] + kz;
+            if (x % 2 == 0 && y % 2 == 0 && z % 2 == 0)
+              sAB += usp1[i] * usp[j] * 4.0 * pi__ * df(x-1) * df(y-1) * df(z-1) / df(x+y+z+1);
           }
         }
+        sum += zAB[ld][mu] * sAB;
       }
+      smu[index*nld + ld] = sum;
     }
   }
 
+  // binomial expansion of each Cartesian component around the ECP centre
+  vector<double> out(ang.size() * (lshell+1) * nld, 0.0);
+  for (int icomp = 0; icomp != ang.size(); ++icomp) {
+    const array<int, 3>& a = ang[icomp];
+    for (int kx = 0; kx <= a[0]; ++kx)
+    for (int ky = 0; ky <= a[1]; ++ky)
+    for (int kz = 0; kz <= a[2]; ++kz) {
+      const int lk = kx + ky + kz;
+      const double coeff = c(a[0], kx) * pow(AB[0], a[0] - kx) * c(a[1], ky) * pow(AB[1], a[1] - ky) * c(a[2], kz) * pow(AB[2], a[2] - kz)
+                         * pow(-1.0, lk - lshell);
+      if (abs(coeff) <= 1e-15) continue;
+      const int index = kx * ANG_HRR_END * ANG_HRR_END + ky * ANG_HRR_END + kz;
+      for (int ld = 0; ld != nld; ++ld)
+        out[(icomp * (lshell+1) + lk) * nld + ld] += coeff * smu[index*nld + ld];
+    }
+  }
   return out;
-
 }
 
-vector<double> AngularBatch::project_CB(const int l, const vector<double> usp, const vector<double> r) {
+vector<vector<double>> AngularBatch::radial(const int side, const int nld, const vector<double>& r) const {
   const static MSphBesselI msbessel;
-
-  vector<vector<double>> rbessel(r.size());
-
-  const int begin1 = basisinfo_[1]->contraction_ranges(cont1_).first;
-  const int end1   = basisinfo_[1]->contraction_ranges(cont1_).second;
-  for (int ir = 0; ir != r.size(); ++ir) {
-    vector<double> bessel(l1_+l+1);
-    for (int i1 = begin1; i1 != end1; ++i1) {
-      const double coef1 = basisinfo_[1]->contractions()[cont1_][i1];
-      const double exp1  = basisinfo_[1]->exponents(i1);
-      const double fac = coef1 * exp(-exp1 * pow(dCB_-r[ir], 2));
-      for (int i = 0; i <= l1_+l; ++i)
-        bessel[i] += fac * msbessel.compute(i, 2.0 * exp1 * dCB_ * r[ir]);
+  const shared_ptr<const Shell>& shell = basisinfo_[side];
+  const double dist = side == 0 ? dAB_ : dCB_;
+
+  // sum_i c_i exp(-a_i (d-r)^2) i_ld(2 a_i d r) for each contraction; [icont * nld + ld][ir]
+  vector<vector<double>> out(shell->num_contracted() * nld, vector<double>(r.size(), 0.0));
+  for (int icont = 0; icont != shell->num_contracted(); ++icont) {
+    const int begin = shell->contraction_ranges(icont).first;
+    const int end   = shell->contraction_ranges(icont).second;
+    for (int i = begin; i != end; ++i) {
+      const double coef = shell->contractions()[icont][i];
+      const double expo = shell->exponents(i);
+      for (int ir = 0; ir != r.size(); ++ir) {
+        const double fac = coef * exp(-expo * pow(dist-r[ir], 2));
+        for (int ld = 0; ld != nld; ++ld)
+          out[icont * nld + ld][ir] += fac * msbessel.compute(ld, 2.0 * expo * dist * r[ir]);
+      }
     }
-    rbessel[ir] = bessel;
   }
+  return out;
+}
 
-  vector<double> out(r.size(), 0.0);
-  for (int j = 0; j != usp.size(); ++j) {
-    if (usp[j] != 0.0) {
-      map<int, array<int, 3>>::const_iterator pj = map_[l].find(j);
-      assert (pj != map_[l].end());
-      const array<int, 3> kj = pj->second;
-
-      for (int kx = 0; kx <= ang1_[0]; ++kx)
-      for (int ky = 0; ky <= ang1_[1]; ++ky)
-      for (int kz = 0; kz <= ang1_[2]; ++kz) {
-        const int lk = kx + ky + kz;
-        const int index = kx * ANG_HRR_END * ANG_HRR_END + ky * ANG_HRR_END + kz;
-        const double coeff = c1_[index] * pow(-1.0, lk - l1_);
-        if (abs(coeff) > 1e-15) {
-          for (int ld = max(l-lk, 0); ld <= l+lk; ++ld) {
-            if ((l + lk - ld) % 2 == 0) {
-              double smu = 0.0;
-              for (int mu = 0; mu <= 2 * ld; ++mu) {
-
-                const vector<double> usp1 = sphusplist.sphuspfunc_call(ld, mu-ld);
-                double sCB = 0.0;
-                for (int i = 0; i != usp1.size(); ++i) {
-                  if (usp1[i] != 0.0) {
-                    map<int, array<int, 3>>::const_iterator p = map_[ld].find(i);
-                    assert (p != map_[ld].end());
-                    const array<int, 3> ki = p->second;
-                    const int x = ki[0] + kj[0] + kx;
-                    const int y = ki[1] + kj[1] + ky;
-                    const int z = ki[2] + kj[2] + kz;
-                    const double xyz = (x % 2 == 0 && y % 2 == 0 && z % 2 == 0) ? (4.0 * pi__ * df(x-1) * df(y-1) * df(z-1) / df(x+y+z+1)) : 0.0;
-                    sCB += usp1[i] * usp[j] * xyz;
-                  }
-                }
-                smu += zCB_[ld][mu] * sCB;
-              }
-              for (int ir = 0; ir != r.size(); ++ir) out[ir] += smu * rbessel[ir][ld] * coeff * pow(r[ir], lk);
-            }
-          }
+vector<double> AngularBatch::project(const int side, const int l, const int m, const vector<double>& r,
+                                     const vector<vector<double>>& rbessel, const vector<vector<double>>& rpow) const {
+  const int lshell = side == 0 ? l0_ : l1_;
+  const int ncomp = side == 0 ? ang0_.size() : ang1_.size();
+  const int ncont = basisinfo_[side]->num_contracted();
+  const int nld = l + lshell + 1;
+  const int nldall = lshell + ecp_->ecp_maxl();
+  const vector<double>& ang = side == 0 ? angA_[l][m] : angC_[l][m];
+  const size_t nr = r.size();
+
+  vector<double> out(ncomp * ncont * nr, 0.0);
+  for (int icomp = 0; icomp != ncomp; ++icomp)
+    for (int lk = 0; lk <= lshell; ++lk)
+      for (int ld = 0; ld != nld; ++ld) {
+        const double a = ang[(icomp * (lshell+1) + lk) * nld + ld];
+        if (a == 0.0) continue;
+        for (int icont = 0; icont != ncont; ++icont) {
+          double* target = out.data() + (icomp * ncont + icont) * nr;
+          const double* bessel = rbessel[icont * nldall + ld].data();
+          const double* rl = rpow[lk].data();
+          for (int ir = 0; ir != nr; ++ir)
+            target[ir] += a * bessel[ir] * rl[ir];
         }
       }
-    }
-  }
-
   return out;
-
 }
 
 vector<double> AngularBatch::compute(const vector<double> r) {
-
-  vector<shared_ptr<const Shell_ECP>> shells_ecp = ecp_->shells_ecp();
-  vector<double> out(r.size(), 0.0);
-
-  for (auto& ishecp : shells_ecp) {
+  const size_t nr = r.size();
+  const int ncont0 = basisinfo_[0]->num_contracted();
+  const int ncont1 = basisinfo_[1]->num_contracted();
+  const int ncomp0 = ang0_.size();
+  const int ncomp1 = ang1_.size();
+  vector<double> out(nc_ * nr, 0.0);
+
+  // quantities shared by all the components and contractions on this grid
+  vector<vector<double>> rpow(max(l0_, l1_) + 1, vector<double>(nr, 1.0));
+  for (int lk = 1; lk != rpow.size(); ++lk)
+    for (int ir = 0; ir != nr; ++ir)
+      rpow[lk][ir] = rpow[lk-1][ir] * r[ir];
+  const vector<vector<double>> rbesselA = radial(0, l0_ + ecp_->ecp_maxl(), r);
+  const vector<vector<double>> rbesselC = radial(1, l1_ + ecp_->ecp_maxl(), r);
+
+  for (auto& ishecp : ecp_->shells_ecp()) {
     const int l = ishecp->angular_number();
-    if (l != ecp_->ecp_maxl()) {
-      for (int m = 0; m <= 2*l; ++m) {
-        const vector<double> usp = sphusplist.sphuspfunc_call(l, m-l);
-        vector<double> pA = project_AB(l, usp, r);
-        vector<double> pC = project_CB(l, usp, r);
-        for (int i = 0; i != ishecp->ecp_exponents().size(); ++i)
-          if (ishecp->ecp_coefficients(i) != 0) {
-            const double coeff = 16.0 * pi__ * pi__ * ishecp->ecp_coefficients(i);
-            for (int ir = 0; ir != r.size(); ++ir)
-              out[ir] += coeff * pow(r[ir], ishecp->ecp_r_power(i)) * exp(-ishecp->ecp_exponents(i) * r[ir] * r[ir]) * pA[ir] * pC[ir];
-          }
+    if (l == ecp_->ecp_maxl()) continue;
+
+    vector<double> potential(nr, 0.0);
+    for (int i = 0; i != ishecp->ecp_exponents().size(); ++i)
+      if (ishecp->ecp_coefficients(i) != 0) {
+        const double coeff = 16.0 * pi__ * pi__ * ishecp->ecp_coefficients(i);
+        for (int ir = 0; ir != nr; ++ir)
+          potential[ir] += coeff * pow(r[ir], ishecp->ecp_r_power(i)) * exp(-ishecp->ecp_exponents(i) * r[ir] * r[ir]);
       }
+
+    for (int m = 0; m <= 2*l; ++m) {
+      const vector<double> pA = project(0, l, m, r, rbesselA, rpow);
+      const vector<double> pC = project(1, l, m, r, rbesselC, rpow);
+      for (int icont0 = 0; icont0 != ncont0; ++icont0)
+        for (int icont1 = 0; icont1 != ncont1; ++icont1)
+          for (int icomp0 = 0; icomp0 != ncomp0; ++icomp0) {
+            const double* a = pA.data() + (icomp0 * ncont0 + icont0) * nr;
+            for (int icomp1 = 0; icomp1 != ncomp1; ++icomp1) {
+              const double* c = pC.data() + (icomp1 * ncont1 + icont1) * nr;
+              double* target = out.data() + (((icont0 * ncont1 + icont1) * ncomp0 + icomp0) * ncomp1 + icomp1) * nr;
+              for (int ir = 0; ir != nr; ++ir)
+                target[ir] += potential[ir] * a[ir] * c[ir];
+            }
+          }
     }
   }
 
-
   return out;
 
 }
@@ -248,37 +258,10 @@ void AngularBatch::init() {
   dAB_ = sqrt(pow(AB_[0], 2) + pow(AB_[1], 2) + pow(AB_[2], 2));
   dCB_ = sqrt(pow(CB_[0], 2) + pow(CB_[1], 2) + pow(CB_[2], 2));
 
-  c0_.resize(ANG_HRR_END*ANG_HRR_END*ANG_HRR_END);
-  c1_.resize(ANG_HRR_END*ANG_HRR_END*ANG_HRR_END);
-
-  const static Comb c;
-
-  for (int kx = 0; kx <= ang0_[0]; ++kx) {
-    const double ckx = c(ang0_[0], kx) * pow(AB_[0], ang0_[0] - kx);
-    for (int ky = 0; ky <= ang0_[1]; ++ky) {
-      const double cky = c(ang0_[1], ky) * pow(AB_[1], ang0_[1] - ky);
-      for (int kz = 0; kz <= ang0_[2]; ++kz) {
-        const double ckz = c(ang0_[2], kz) * pow(AB_[2], ang0_[2] - kz);
-        const int index = kx * ANG_HRR_END * ANG_HRR_END + ky * ANG_HRR_END + kz;
-        c0_[index] = ckx * cky * ckz;
-      }
-    }
-  }
-
-  for (int kx = 0; kx <= ang1_[0]; ++kx) {
-    const double ckx = c(ang1_[0], kx) * pow(CB_[0], ang1_[0] - kx);
-    for (int ky = 0; ky <= ang1_[1]; ++ky) {
-      const double cky = c(ang1_[1], ky) * pow(CB_[1], ang1_[1] - ky);
-      for (int kz = 0; kz <= ang1_[2]; ++kz) {
-        const double ckz = c(ang1_[2], kz) * pow(CB_[2], ang1_[2] - kz);
-        const int index = kx * ANG_HRR_END * ANG_HRR_END + ky * ANG_HRR_END + kz;
-        c1_[index] = ckx * cky * ckz;
-      }
-    }
-  }
-
-  l0_ = ang0_[0] + ang0_[1] + ang0_[2];
-  l1_ = ang1_[0] + ang1_[1] + ang1_[2];
+  l0_ = basisinfo_[0]->angular_number();
+  l1_ = basisinfo_[1]->angular_number();
+  ang0_ = cartesian_components(l0_);
+  ang1_ = cartesian_components(l1_);
 
   for (int l = 0; l != max(l0_, l1_) + ecp_->ecp_maxl(); ++l) {
     vector<double> zAB_l(2*l+1, 0.0), zCB_l(2*l+1, 0.0);
@@ -292,6 +275,18 @@ void AngularBatch::init() {
     zCB_.push_back(zCB_l);
   }
 
+  // angular factors do not depend on the grid and are reused through the refinement of the quadrature
+  angA_.resize(ecp_->ecp_maxl());
+  angC_.resize(ecp_->ecp_maxl());
+  for (auto& ishecp : ecp_->shells_ecp()) {
+    const int l = ishecp->angular_number();
+    if (l == ecp_->ecp_maxl() || !angA_[l].empty()) continue;
+    for (int m = 0; m <= 2*l; ++m) {
+      angA_[l].push_back(angular(l, m, l0_, ang0_, AB_, zAB_));
+      angC_[l].push_back(angular(l, m, l1_, ang1_, CB_, zCB_));
+    }
+  }
+
 }
 
 void AngularBatch::print() const {
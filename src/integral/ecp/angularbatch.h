@@ -33,30 +33,37 @@
 
 namespace bagel {
 
+// Semi-local ECP integrals < shell_0 | lm > U_l(r) < lm | shell_1 > around one ECP centre. All Cartesian components and contractions
+// of the shell pair are integrated together on one radial grid, so that the angular factors and the Bessel functions on each grid
+// point are computed once per batch. Integrals are stored as ((contA * ncontC + contC) * ncompA + compA) * ncompC + compC.
 class AngularBatch : public RadialInt {
   protected:
 
     std::array<std::shared_ptr<const Shell>,2> basisinfo_;
     std::shared_ptr<const ECP> ecp_;
-    int cont0_, cont1_;
-    std::array<int, 3> ang0_, ang1_;
     std::array<double, 3> AB_, CB_;
     double dAB_, dCB_;
-    std::vector<double> c0_, c1_;
     std::vector<std::map<int, std::array<int, 3>>> map_;
 
     int l0_, l1_;
+    std::vector<std::array<int, 3>> ang0_, ang1_;
     std::vector<std::vector<double>> zAB_, zCB_;
 
+    // r-independent factors of the projections; [l][m][(icomp * (lshell+1) + lk) * (l+lshell+1) + ld]
+    std::vector<std::vector<std::vector<double>>> angA_, angC_;
+
     void map_angular_number();
 
     double integrate3SHs(std::array<std::pair<int, int>, 3> lm) const;
-    std::vector<double> project_AB(const int l, const std::vector<double> usp, const std::vector<double> r);
-    std::vector<double> project_CB(const int l, const std::vector<double> usp, const std::vector<double> r);
+    std::vector<double> angular(const int l, const int m, const int lshell, const std::vector<std::array<int, 3>>& ang,
+                                const std::array<double, 3>& AB, const std::vector<std::vector<double>>& zAB) const;
+    // returns projections onto |lm> on the grid, [(icomp * ncont + icont) * r.size() + ir]
+    std::vector<double> project(const int side, const int l, const int m, const std::vector<double>& r,
+                                const std::vector<std::vector<double>>& rbessel, const std::vector<std::vector<double>>& rpow) const;
+    std::vector<std::vector<double>> radial(const int side, const int nld, const std::vector<double>& r) const;
 
   public:
     AngularBatch(const std::shared_ptr<const ECP> _ecp, const std::array<std::shared_ptr<const Shell>,2>& _info,
-                 const int contA, const int contC, const std::array<int, 3> angA, const std::array<int, 3> angC,
                  const bool print = false, const int max_iter = 100, const double thresh_int = PRIM_SCREEN_THRESH);
 
     ~AngularBatch() {}
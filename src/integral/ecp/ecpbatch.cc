@@ -67,30 +67,18 @@ void ECPBatch::compute() {
   fill_n(intermediate_c, size_alloc_, 0.0);
   double* const current_data = intermediate_c;
 
-  int i = 0;
-  for (int izA = 0; izA <= ang0_; ++izA)
-  for (int iyA = 0; iyA <= ang0_ - izA; ++iyA) {
-    const int ixA = ang0_ - izA - iyA;
-    const array<int, 3> lA = {ixA, iyA, izA};
-    for (int izC = 0; izC <= ang1_; ++izC)
-    for (int iyC = 0; iyC <= ang1_ - izC; ++iyC) {
-      const int ixC = ang1_ - izC - iyC;
-      const array<int, 3> lC = {ixC, iyC, izC};
-      for (int contA = 0; contA != cont0_; ++contA)
-      for (int contC = 0; contC != cont1_; ++contC) {
-        double tmp = 0.0;
-        for (auto& aiter : mol_->atoms()) {
-          shared_ptr<const ECP> aiter_ecp = aiter->ecp_parameters();
-
-          AngularBatch radint(aiter_ecp, basisinfo_, contA, contC, lA, lC, false, max_iter_, integral_thresh_);
-          radint.integrate();
-          tmp += radint.integral(0);
-        }
-        const int index = contA * cont1_ * asize_ + contC * asize_ + i;
-        current_data[index] = tmp;
-      }
-      ++i;
-    }
+  // all the Cartesian components and contractions are integrated together around each ECP centre
+  for (auto& aiter : mol_->atoms()) {
+    shared_ptr<const ECP> aiter_ecp = aiter->ecp_parameters();
+    const vector<shared_ptr<const Shell_ECP>> shells = aiter_ecp->shells_ecp();
+    if (none_of(shells.begin(), shells.end(), [&aiter_ecp](shared_ptr<const Shell_ECP> s) { return s->angular_number() != aiter_ecp->ecp_maxl(); }))
+      continue;
+
+    AngularBatch radint(aiter_ecp, basisinfo_, false, max_iter_, integral_thresh_);
+    radint.integrate();
+    const vector<double> integral = radint.integral();
+    assert(integral.size() == size_alloc_);
+    blas::ax_plus_y_n(1.0, integral.data(), size_alloc_, current_data);
   }
 
   get_data(current_data, data_);
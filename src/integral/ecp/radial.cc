@@ -44,8 +44,7 @@ void RadialInt::integrate() {
 
   vector<double> previous(nc_, 0.0);
   for (int ic = 0; ic != nc_; ++ic)
-    for (int i = 0; i != n0; ++i) previous[ic] = f[ic*n0+i] * w_[i];
-    //previous[ic] = inner_product(f.begin()+ic*n0, f.begin()+(ic+1)*n0-1, w_.begin(), 0);
+    for (int i = 0; i != n0; ++i) previous[ic] += f[ic*n0+i] * w_[i];
 
   int n1 = n0*2+1;
 
@@ -55,9 +55,11 @@ class RadialInt {
 
     ~RadialInt() {}
 
+    // The grid is refined adaptively (doubled up to max_iter_ times) until all nc_ integrals converge; it is not
+    // precomputed per ECP centre. All the components of a shell pair share one grid (see AngularBatch).
     void integrate();
     std::vector<double> integral() const { return integral_; }
-    double integral(const int ic = 0) const { return integral_.at(ic); }
+    double integral(const int ic) const { return integral_.at(ic); }
 
     virtual std::vector<double> compute(const std::vector<double> r) = 0;
 
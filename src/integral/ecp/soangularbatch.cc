@@ -192,6 +192,33 @@ double SOBatch::angularC(const int h, const int ld, const vector<double> usp) {
 
 }
 
+const array<double, 3>& SOBatch::angular_sum(const int l, const int ld0, const int ld1, const int g) {
+  const array<int, 4> key = {{l, ld0, ld1, g}};
+  auto iter = angular_sums_.find(key);
+  if (iter != angular_sums_.end())
+    return iter->second;
+
+  vector<vector<double>> usp(2*l+1);
+  for (int m = 0; m <= 2*l; ++m) usp[m] = sphusplist.sphuspfunc_call(l, m-l);
+
+  const int c0 = l0_ - (l0_ - abs(ld0-l))%2;
+  const int c1 = l1_ - (l1_ - abs(ld1-l))%2;
+  const int hmin = max(abs(ld0-l), g - c1);
+  const int hmax = min(c0, g - abs(ld1-l));
+
+  array<double, 3> sum = {{0.0, 0.0, 0.0}};
+  for (int i = 0; i != fm0lm1_[l-1].size(); ++i) {
+    tuple<int, int, int, double> fmm = fm0lm1_[l-1][i];
+    const int id = get<0>(fmm);
+    const int m0 = get<1>(fmm);
+    const int m1 = get<2>(fmm);
+    const double f = get<3>(fmm);
+    for (int h = hmin; h <= hmax; h += 2)
+      sum[id] += (angularA(h, ld0, usp[m0]) * angularC(g-h, ld1, usp[m1]) - angularA(h, ld0, usp[m1]) * angularC(g-h, ld1, usp[m0]))*f;
+  }
+  return angular_sums_.emplace(key, sum).first->second;
+}
+
 vector<double> SOBatch::project(const int l, const vector<double> r) {
 
   const static MSphBesselI msbessel;
@@ -225,9 +252,6 @@ vector<double> SOBatch::project(const int l, const vector<double> r) {
     rbessel1[ir] = b1;
   }
 
-  vector<vector<double>> usp(2*l+1);
-  for (int m = 0; m <= 2*l; ++m) usp[m] = sphusplist.sphuspfunc_call(l, m-l);
-
   vector<double> out(3*r.size(), 0.0);
 
   for (int ld0 = max(0, l-l0_); ld0 <= l+l0_; ++ld0) {
@@ -238,19 +262,7 @@ vector<double> SOBatch::project(const int l, const vector<double> r) {
       const int gmin = abs(ld0-l)+abs(ld1-l);
       const int gmax = c0 + c1;
       for (int g = gmin; g <= gmax; g += 2) {
-        array<double, 3> sum = {{0.0, 0.0, 0.0}};
-
-        const int hmin = max(abs(ld0-l), g - c1);
-        const int hmax = min(c0, g - abs(ld1-l));
-        for (int i = 0; i != fm0lm1_[l-1].size(); ++i) {
-          tuple<int, int, int, double> fmm = fm0lm1_[l-1][i];
-          const int id = get<0>(fmm);
-          const int m0 = get<1>(fmm);
-          const int m1 = get<2>(fmm);
-          const double f = get<3>(fmm);
-          for (int h = hmin; h <= hmax; h += 2)
-            sum[id] += (angularA(h, ld0, usp[m0]) * angularC(g-h, ld1, usp[m1]) - angularA(h, ld0, usp[m1]) * angularC(g-h, ld1, usp[m0]))*f;
-        }
+        const array<double, 3>& sum = angular_sum(l, ld0, ld1, g);
         for (int ir = 0; ir != r.size(); ++ir) {
           const double p = rbessel0[ir][ld0] * rbessel1[ir][ld1] * pow(r[ir], g);
           for (int id = 0; id != 3; ++id) {
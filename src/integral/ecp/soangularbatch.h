@@ -48,6 +48,8 @@ class SOBatch : public RadialInt {
     int l0_, l1_;
     std::vector<std::vector<double>> zAB_, zCB_;
     std::vector<std::vector<std::tuple<int, int, int, double>>> fm0lm1_; // li, m0, m1, fmm
+    // angular sums of project() keyed by (l, ld0, ld1, g); they do not depend on the radial grid
+    std::map<std::array<int, 4>, std::array<double, 3>> angular_sums_;
 
     void map_angular_number();
     std::complex<double> theta(const int m) const;
@@ -56,6 +58,7 @@ class SOBatch : public RadialInt {
     std::vector<double> project(const int l, const std::vector<double> r);
     double angularA(const int h, const int ld, const std::vector<double> usp);
     double angularC(const int h, const int ld, const std::vector<double> usp);
+    const std::array<double, 3>& angular_sum(const int l, const int ld0, const int ld1, const int g);
 
   public:
     SOBatch(const std::shared_ptr<const SOECP> _so, const std::array<std::shared_ptr<const Shell>,2>& _info,
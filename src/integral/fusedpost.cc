@@ -0,0 +1,165 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: fusedpost.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <algorithm>
+#include <src/integral/fusedpost.h>
+#include <src/integral/hrrlist.h>
+#include <src/integral/carsphlist.h>
+#include <src/integral/sortlist.h>
+
+using namespace std;
+using namespace bagel;
+
+namespace {
+  bool fused_post = true;
+
+  const HRRList hrr;
+  const CarSphList carsphlist;
+  const SortList sort_cart(false);
+  const SortList sort_sph(true);
+
+  int ncart(const int l) { return (l+1)*(l+2)/2; }
+
+  // target(i, j) = source(j, i) for a m x n column block of a target with leading dimension ld
+  void transpose_block(const double* source, const int m, const int n, double* target, const int ld) {
+    for (int j = 0; j != m; ++j)
+      for (int i = 0; i != n; ++i)
+        target[i + ld*j] = source[j + m*i];
+  }
+
+  // the same with the columns scattered to target(order[i], j)
+  void transpose_block(const double* source, const int m, const int n, double* target, const int ld, const int* order) {
+    for (int j = 0; j != m; ++j)
+      for (int i = 0; i != n; ++i)
+        target[order[i] + ld*j] = source[j + m*i];
+  }
+}
+
+
+bool bagel::fused_post_enabled() {
+  return fused_post;
+}
+
+
+void bagel::set_fused_post(const bool enabled) {
+  fused_post = enabled;
+}
+
+
+const double* FusedPost::hrr_carsph(const int n, const double* source, const int ang0, const int ang1, const bool spherical,
+                                    const array<double,3>& AB, double* buf1, double* buf2) const {
+  const int index = ang0 * ANG_HRR_END + ang1;
+  const double* current = source;
+  if (ang1 != 0) {
+    hrr.hrrfunc_call(index, n, current, AB, buf1);
+    current = buf1;
+  }
+  if (spherical && ang0 > 1) {
+    double* out = current == buf1 ? buf2 : buf1;
+    carsphlist.carsphfunc_call(index, n, current, out);
+    current = out;
+  }
+  return current;
+}
+
+
+void FusedPost::bra(const double* source, double* target, const int ang0, const int ang1, const bool spherical, const array<double,3>& AB,
+                    const int ncont01, const int nloop) const {
+  int in = 0;
+  for (int l = ang0; l <= ang0+ang1; ++l)
+    in += ncart(l);
+  const int cart = ncart(ang0) * ncart(ang1);
+  const int out = spherical && ang0 > 1 ? (2*ang0+1) * (2*ang1+1) : cart;
+
+  const int chunk = max(1, min(nloop, chunk_size / cart));
+  double* const buf = stack_->get(2*chunk*cart);
+
+  for (int i = 0; i != ncont01; ++i) {
+    const double* src = source + static_cast<size_t>(i)*nloop*in;
+    double* tgt = target + static_cast<size_t>(i)*nloop*out;
+    for (int j = 0; j < nloop; j += chunk) {
+      const int n = min(chunk, nloop-j);
+      const double* current = hrr_carsph(n, src+j*in, ang0, ang1, spherical, AB, buf, buf+chunk*cart);
+      transpose_block(current, out, n, tgt+j, nloop);
+    }
+  }
+
+  stack_->release(2*chunk*cart, buf);
+}
+
+
+void FusedPost::ket(const double* source, double* target, const int ang2, const int ang3, const bool spherical, const array<double,3>& CD,
+                    const int ngroup, const int cont2, const int cont3, const bool swap23, const bool transpose, const int* order) const {
+  int in = 0;
+  for (int l = ang2; l <= ang2+ang3; ++l)
+    in += ncart(l);
+  const int cart = ncart(ang2) * ncart(ang3);
+  const int out = spherical && ang2 > 1 ? (2*ang2+1) * (2*ang3+1) : cart;
+  const int cont23 = cont2 * cont3;
+  const int m = cont23 * out;
+  const SortList& sort = spherical ? sort_sph : sort_cart;
+  const unsigned int sort_index = ang3 * ANG_HRR_END + ang2;
+
+  // a chunk consists of whole groups of cont23 loops, which is the unit of the sort kernels
+  const int chunk = max(1, min(ngroup, chunk_size / (cont23*cart)));
+  const size_t bufsize = static_cast<size_t>(chunk)*cont23*cart;
+  double* const buf = stack_->get(2*bufsize);
+
+  for (int g = 0; g < ngroup; g += chunk) {
+    const int n = min(chunk, ngroup-g);
+    const double* current = hrr_carsph(n*cont23, source+static_cast<size_t>(g)*cont23*in, ang2, ang3, spherical, CD, buf, buf+bufsize);
+    if (ang2 != 0) {
+      double* sorted = current == buf ? buf+bufsize : buf;
+      sort.sortfunc_call(sort_index, sorted, current, cont3, cont2, n, swap23);
+      current = sorted;
+    }
+    if (transpose && order)
+      transpose_block(current, m, n, target, ngroup, order+g);
+    else if (transpose)
+      transpose_block(current, m, n, target+g, ngroup);
+    else
+      copy_n(current, static_cast<size_t>(m)*n, target+static_cast<size_t>(g)*m);
+  }
+
+  stack_->release(2*bufsize, buf);
+}
+
+
+vector<int> FusedPost::sort_order(const int ang0, const int ang1, const bool spherical, const int cont0, const int cont1, const bool swap01) {
+  const int ab = spherical ? (2*ang0+1) * (2*ang1+1) : ncart(ang0) * ncart(ang1);
+  const int n = cont0 * cont1 * ab;
+  // let the sort kernel move the indices around
+  vector<double> index(n);
+  vector<double> sorted(n);
+  for (int i = 0; i != n; ++i)
+    index[i] = i;
+  const SortList& sort = spherical ? sort_sph : sort_cart;
+  sort.sortfunc_call(ang1 * ANG_HRR_END + ang0, sorted.data(), index.data(), cont1, cont0, 1, swap01);
+
+  vector<int> out(n);
+  for (int i = 0; i != n; ++i)
+    out[static_cast<int>(sorted[i])] = i;
+  return out;
+}
@@ -0,0 +1,81 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: fusedpost.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+//
+// HRR, cartesian-to-spherical transformation and reordering of a contracted ERI batch in one pass.
+// The loop over contracted functions is cut into chunks that stay in cache; every chunk runs through the
+// generated kernels of HRRList, CarSphList and SortList back to back and is written to the target once,
+// instead of each step streaming the whole batch through the stack memory.
+//
+
+#ifndef __SRC_INTEGRAL_FUSEDPOST_H
+#define __SRC_INTEGRAL_FUSEDPOST_H
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <src/util/parallel/resources.h>
+
+namespace bagel {
+
+// on by default; switched off to benchmark against the separate passes
+bool fused_post_enabled();
+void set_fused_post(const bool enabled);
+
+class FusedPost {
+  protected:
+    std::shared_ptr<StackMem> stack_;
+
+    // HRR and cartesian-to-spherical transformation of n consecutive loops. Returns a pointer to the result,
+    // which is source itself, buf1 or buf2.
+    const double* hrr_carsph(const int n, const double* source, const int ang0, const int ang1, const bool spherical,
+                             const std::array<double,3>& AB, double* buf1, double* buf2) const;
+
+  public:
+    // the largest angular momentum for which the fused path is used (g functions)
+    static constexpr int max_angular = 4;
+    // the number of doubles in a chunk
+    static constexpr int chunk_size = 2048;
+
+    FusedPost(std::shared_ptr<StackMem> stack) : stack_(stack) { }
+
+    // bra side. source: cont01{ cont23{ xyzf{ xyz(a..a+b) } } }, target: cont01{ xyzab{ cont23{ xyzf } } }
+    void bra(const double* source, double* target, const int ang0, const int ang1, const bool spherical, const std::array<double,3>& AB,
+             const int ncont01, const int nloop) const;
+
+    // ket side including the transposition to bra-fastest order (unless transpose is false).
+    // source: cont01{ xyzab{ cont23{ xyz(c..c+d) } } }, target: cont3d{ cont2c{ cont01{ xyzab } } }
+    // If order is given, group g (one cont01 and xyzab) is written to position order[g] in the bra-fastest index,
+    // which absorbs the final sort of the bra indices into the transposition.
+    void ket(const double* source, double* target, const int ang2, const int ang3, const bool spherical, const std::array<double,3>& CD,
+             const int ngroup, const int cont2, const int cont3, const bool swap23, const bool transpose, const int* order = nullptr) const;
+
+    // position of each group cont01{ xyzab } after sorting by SortList (the inverse of the sort as a permutation)
+    static std::vector<int> sort_order(const int ang0, const int ang1, const bool spherical, const int cont0, const int cont1, const bool swap01);
+};
+
+}
+
+#endif
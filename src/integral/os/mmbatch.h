@@ -44,6 +44,8 @@ class MMBatch : public OSInt {
   public:
     MMBatch(const std::array<std::shared_ptr<const Shell>,2>& basis, std::shared_ptr<const Molecule> c, const int lmax)
      : OSInt(basis), center_(c->charge_center()), lmax_(lmax) { common_init(); }
+    MMBatch(const std::array<std::shared_ptr<const Shell>,2>& basis, const std::array<double,3>& center, const int lmax)
+     : OSInt(basis), center_(center), lmax_(lmax) { common_init(); }
 
     void compute() override;
 
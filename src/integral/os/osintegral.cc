@@ -23,6 +23,7 @@
 //
 
 #include <src/integral/os/osintegral.h>
+#include <src/molecule/shellpair.h>
 
 using namespace std;
 using namespace bagel;
@@ -71,6 +72,10 @@ void OSIntegral<DataType, IntType>::common_init() {
   AB_[1] = basisinfo_[0]->position(1) - basisinfo_[1]->position(1);
   AB_[2] = basisinfo_[0]->position(2) - basisinfo_[1]->position(2);
 
+  // primitive-pair data precomputed for the shell pair, if available
+  bool pair_swapped = false;
+  const ShellPair* pair = IntType == Int_t::Standard && is_same<DataType,double>::value ? ShellPair::find(basisinfo_, pair_swapped) : nullptr;
+
   vector<double>::const_iterator expi0, expi1;
   P_.reserve(3 * prim0_ * prim1_);
   xa_.reserve(prim0_ * prim1_);
@@ -88,19 +93,30 @@ void OSIntegral<DataType, IntType>::common_init() {
       xb_.push_back(*expi1);
       const double cxp = *expi0 + *expi1;
       const double cxp_inv = 1.0 / cxp;
+      const double tmp = pisqrt__ * sqrt(cxp_inv);
 
-      const DataType px = get_P(basisinfo_[0]->position(0), basisinfo_[1]->position(0), *expi0, *expi1, cxp_inv, 0, swap01_);
-      const DataType py = get_P(basisinfo_[0]->position(1), basisinfo_[1]->position(1), *expi0, *expi1, cxp_inv, 1, swap01_);
-      const DataType pz = get_P(basisinfo_[0]->position(2), basisinfo_[1]->position(2), *expi0, *expi1, cxp_inv, 2, swap01_);
+      DataType px, py, pz, coeffsx, coeffsy, coeffsz;
+      if (pair) {
+        const int ij = pair->index(expi0 - exponents0.begin(), expi1 - exponents1.begin(), pair_swapped);
+        px = pair->P(ij)[0];
+        py = pair->P(ij)[1];
+        pz = pair->P(ij)[2];
+        coeffsx = tmp * pair->K(ij)[0];
+        coeffsy = tmp * pair->K(ij)[1];
+        coeffsz = tmp * pair->K(ij)[2];
+      } else {
+        px = get_P(basisinfo_[0]->position(0), basisinfo_[1]->position(0), *expi0, *expi1, cxp_inv, 0, swap01_);
+        py = get_P(basisinfo_[0]->position(1), basisinfo_[1]->position(1), *expi0, *expi1, cxp_inv, 1, swap01_);
+        pz = get_P(basisinfo_[0]->position(2), basisinfo_[1]->position(2), *expi0, *expi1, cxp_inv, 2, swap01_);
+        coeffsx = tmp * exp(- *expi0 * *expi1 * cxp_inv * (AB_[0] * AB_[0]));
+        coeffsy = tmp * exp(- *expi0 * *expi1 * cxp_inv * (AB_[1] * AB_[1]));
+        coeffsz = tmp * exp(- *expi0 * *expi1 * cxp_inv * (AB_[2] * AB_[2]));
+      }
 
       xp_.push_back(cxp);
       P_.push_back(px);
       P_.push_back(py);
       P_.push_back(pz);
-      const double tmp = pisqrt__ * sqrt(cxp_inv);
-      DataType coeffsx = tmp * exp(- *expi0 * *expi1 * cxp_inv * (AB_[0] * AB_[0]));
-      DataType coeffsy = tmp * exp(- *expi0 * *expi1 * cxp_inv * (AB_[1] * AB_[1]));
-      DataType coeffsz = tmp * exp(- *expi0 * *expi1 * cxp_inv * (AB_[2] * AB_[2]));
       if (IntType == Int_t::London) {
         DataType factor_x;
         DataType factor_y;
@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/breitrootlist.h>
 
 using namespace std;
@@ -31,9 +30,9 @@ using namespace bagel;
 
 void BreitRootList::breitroot1(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[1] = {1.500000000000000e+00};
-  constexpr double aw[1] = {4.431134627263790e-01};
-  constexpr double x[384] = {  1.057986693394197e+00, -7.144282222753716e-02, -2.054859453327102e-04,  2.331146756779162e-04,  1.331077830017425e-06,
+  static constexpr double ax[1] = {1.500000000000000e+00};
+  static constexpr double aw[1] = {4.431134627263790e-01};
+  static constexpr double x[384] = {  1.057986693394197e+00, -7.144282222753716e-02, -2.054859453327102e-04,  2.331146756779162e-04,  1.331077830017425e-06,
  -1.115171509111191e-06, -8.999527162393619e-09,  5.640469957441268e-09,  5.868492293682324e-11, -2.886120987688697e-11, -3.681089987315752e-13,  1.487463219474723e-13,
   7.851220690400758e-01, -6.306370112940925e-02,  2.077090515664856e-03,  1.107583656237493e-04, -1.277451547927649e-05, -1.044487389335647e-08,  6.009838083002671e-08,
  -2.175115414441252e-09, -2.080059059032380e-10,  1.804354748413915e-11,  3.447550363921192e-13, -9.980335735361091e-14,  5.700728455141461e-01, -4.424389871474052e-02,
@@ -89,7 +88,7 @@ void BreitRootList::breitroot1(const double* ta, double* rr, double* ww, const i
  -8.220040223452146e-21,  6.738190601767012e-23, -5.523107050623459e-25,  4.762504762507144e-02, -3.780003795005700e-04,  3.000192000382501e-06, -2.381254762508930e-08,
   1.890003787507110e-10, -1.500097500289126e-12,  1.190628571883334e-14, -9.450028387566298e-17,  7.500495001942498e-19, -5.953148812565445e-21,  4.725018900051778e-23,
  -3.750015000040365e-25  };
-  constexpr double w[384] = {  4.135653584758195e-01, -1.066439704592393e-01,  1.752146780833233e-02, -2.154035108083543e-03,  2.123679824895491e-04,
+  static constexpr double w[384] = {  4.135653584758195e-01, -1.066439704592393e-01,  1.752146780833233e-02, -2.154035108083543e-03,  2.123679824895491e-04,
  -1.749369492647350e-05,  1.237819265129784e-06, -7.676522952021522e-08,  4.237208259260642e-09, -2.107052960597916e-10,  9.532877171342738e-12, -3.950665544868368e-13,
   1.599461505363333e-01, -3.096198038212439e-02,  4.255772773271153e-03, -4.654909238812563e-04,  4.233489892280168e-05, -3.289699797763587e-06,  2.227993127460179e-07,
  -1.335652563041112e-08,  7.176391768087074e-10, -3.491410473430721e-11,  1.551298009286964e-12, -6.332303946483246e-14,  8.026264548904928e-02, -1.133995737427459e-02,
@@ -145,51 +144,5 @@ void BreitRootList::breitroot1(const double* ta, double* rr, double* ww, const i
  -1.095702660121998e-21,  9.430857108371231e-24, -8.081536494792655e-26,  1.772705991748090e-03, -2.110447363715505e-05,  2.093813188035964e-07, -1.938830412437076e-09,
   1.731203545102832e-11, -1.511461004080499e-13,  1.299616981265166e-15, -1.105185166202646e-17,  9.320098747539451e-20, -7.808330630379991e-22,  6.507349278507902e-24,
  -5.399286049308797e-26  };
-  int offset = -1;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 1;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 1, 0.5);
-      fill_n(ww+offset, 1, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 1; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=1; ++j) {
-        const int boxof = it*12+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(1, 3, ax, aw, x, w, ta, rr, ww, n);
 }
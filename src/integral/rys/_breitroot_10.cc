@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/breitrootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void BreitRootList::breitroot10(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[10] = {9.244815469866574e-01,2.298729805186562e-01,2.099410462708798e+00,3.782880873707290e+00,6.019918027701461e+00,
+  static constexpr double ax[10] = {9.244815469866574e-01,2.298729805186562e-01,2.099410462708798e+00,3.782880873707290e+00,6.019918027701461e+00,
     8.880347597996709e+00,1.247483240483620e+01,1.699084729354255e+01,2.279100289494895e+01,3.080640591705273e+01};
-  constexpr double aw[10] = {1.776116944010360e-01,8.773540752333013e-02,1.263417798378390e-01,4.317805134766631e-02,7.554889017430406e-03,
+  static constexpr double aw[10] = {1.776116944010360e-01,8.773540752333013e-02,1.263417798378390e-01,4.317805134766631e-02,7.554889017430406e-03,
     6.641078141817820e-04,2.709390010585172e-05,4.368737934593573e-07,2.009849943469898e-09,1.146110765102355e-12};
-  constexpr double x[3840] = {  4.053948391343153e-02, -9.035021462501904e-04,  1.479715756639795e-05, -2.094216742045265e-07,  2.673169487355093e-09,
+  static constexpr double x[3840] = {  4.053948391343153e-02, -9.035021462501904e-04,  1.479715756639795e-05, -2.094216742045265e-07,  2.673169487355093e-09,
  -3.105452753755934e-11,  3.241923081903109e-13, -2.909066723307717e-15,  1.931323595594027e-17, -1.780335343128166e-20, -2.380958351785062e-21,  5.591177027748569e-23,
   1.591335736557223e-01, -3.340780642341213e-03,  4.817254951501345e-05, -5.347233996382659e-07,  4.181211531778449e-09, -8.693044177703693e-12, -4.229250857685557e-13,
   9.471972479857691e-15, -1.189902107993423e-16,  8.016581966366944e-19,  4.289057476132382e-21, -2.310557014952281e-22,  3.468498630702582e-01, -6.566732118290088e-03,
@@ -584,7 +583,7 @@ void BreitRootList::breitroot10(const double* ta, double* rr, double* ww, const
   2.855536435700434e-09, -2.183432790635792e-11,  1.347795622335084e-13,  4.046551735251470e-16, -5.024506757835347e-17,  1.648588145438778e-18, -4.029195100541210e-20,
   7.797034718236190e-22,  9.781042939502198e-01, -7.763199782192137e-03,  6.161323867172760e-05, -4.886863340760369e-07,  3.853453279636794e-09, -2.911208636998036e-11,
   1.614809520488494e-13,  1.440964513285398e-15, -1.007618681111275e-16,  3.265017515856196e-18, -8.267181805668256e-20,  1.713295532402658e-21  };
-  constexpr double w[3840] = {  5.629250115892034e-03, -2.401330843367014e-04,  7.267677378819661e-06, -1.892747373514604e-07,  4.495819264454951e-09,
+  static constexpr double w[3840] = {  5.629250115892034e-03, -2.401330843367014e-04,  7.267677378819661e-06, -1.892747373514604e-07,  4.495819264454951e-09,
  -9.993879637808899e-11,  2.109168192887102e-12, -4.265344293651548e-14,  8.318767682228398e-16, -1.572098595204205e-17,  2.889196049301503e-19, -5.176545511865152e-21,
   2.031968579266112e-02, -1.377345316337403e-03,  6.475608245116094e-05, -2.505714673191730e-06,  8.503821906579541e-08, -2.616884771471862e-09,  7.450500223352682e-11,
  -1.988834702964491e-12,  5.024537180908511e-14, -1.209707454493543e-15,  2.790261709128665e-17, -6.188673645194597e-19,  3.870575658677620e-02, -4.163488029676414e-03,
@@ -1133,51 +1132,5 @@ void BreitRootList::breitroot10(const double* ta, double* rr, double* ww, const
   8.243128890479458e-20, -9.210159942872772e-22,  1.741024687118912e-23, -5.178263515181010e-25,  1.640776018877657e-26, -4.655889089676279e-28,  1.126925099174483e-29,
  -2.253888758673018e-31,  4.585104826915357e-15, -5.458961929439783e-17,  5.420423977043757e-19, -5.065222008516059e-21,  4.870360442321074e-23, -6.305691023733065e-25,
   1.526117007628878e-26, -5.207778201850839e-28,  1.744514941799589e-29, -5.138454584684381e-31,  1.296745438773946e-32, -2.754074636620748e-34  };
-  int offset = -10;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 10;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 10, 0.5);
-      fill_n(ww+offset, 10, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 10; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=10; ++j) {
-        const int boxof = it*120+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(10, 3, ax, aw, x, w, ta, rr, ww, n);
 }
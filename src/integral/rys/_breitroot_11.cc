@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/breitrootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void BreitRootList::breitroot11(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[11] = {8.448394164252124e-01,2.102574184831798e-01,1.915565574736173e+00,3.443537268140795e+00,5.461644772694418e+00,
+  static constexpr double ax[11] = {8.448394164252124e-01,2.102574184831798e-01,1.915565574736173e+00,3.443537268140795e+00,5.461644772694418e+00,
     8.019112688782045e+00,1.118987571617644e+01,1.508912822002115e+01,1.991025764276847e+01,2.602565538189142e+01,3.439012589988069e+01};
-  constexpr double aw[11] = {1.678230401905021e-01,7.824599992321335e-02,1.319638668639710e-01,5.236616050918886e-02,1.130324456601507e-02,
+  static constexpr double aw[11] = {1.678230401905021e-01,7.824599992321335e-02,1.319638668639710e-01,5.236616050918886e-02,1.130324456601507e-02,
     1.327657922364920e-03,8.111872035223047e-05,2.346871456312215e-06,2.707057663826872e-08,8.870360814858491e-11,3.494169062949084e-14};
-  constexpr double x[4224] = {  3.409593792617322e-02, -6.987154848340618e-04,  1.055662393877348e-05, -1.384821596218973e-07,  1.649829484072803e-09,
+  static constexpr double x[4224] = {  3.409593792617322e-02, -6.987154848340618e-04,  1.055662393877348e-05, -1.384821596218973e-07,  1.649829484072803e-09,
  -1.808068309075306e-11,  1.813960904650297e-13, -1.626429395668988e-15,  1.216022134867250e-17, -5.761238110677237e-20, -2.687760468536493e-22,  1.252075064261680e-23,
   1.342314375128877e-01, -2.616000650497985e-03,  3.555243277946640e-05, -3.829598186562049e-07,  3.148105216541321e-09, -1.413901948370435e-11, -1.125276001800013e-13,
   3.786101496435379e-15, -5.520769181154719e-17,  5.193596108024787e-19, -2.081199966738336e-21, -3.551548411474326e-23,  2.940380475449568e-01, -5.256869567203616e-03,
@@ -639,7 +638,7 @@ void BreitRootList::breitroot11(const double* ta, double* rr, double* ww, const
  -1.648191894083835e-11, -1.943623803165397e-13,  1.194187413327458e-14, -3.565177165589995e-16,  7.703356489905379e-18, -1.122865372572252e-19,  4.198366347783382e-22,
   1.091886431770579e+00, -8.665986000336466e-03,  6.873596577939446e-05, -5.412999433401747e-07,  4.009353498280084e-09, -1.691107462113876e-11, -4.821131794819134e-13,
   2.437086218427935e-14, -7.436066305294126e-16,  1.735045753344733e-17, -3.014549325194599e-19,  3.015172235488250e-21  };
-  constexpr double w[4224] = {  4.358786931872724e-03, -1.680823644922114e-04,  4.592632342334975e-06, -1.080959176965074e-07,  2.324687350321602e-09,
+  static constexpr double w[4224] = {  4.358786931872724e-03, -1.680823644922114e-04,  4.592632342334975e-06, -1.080959176965074e-07,  2.324687350321602e-09,
  -4.687587243266272e-11,  8.989812422733138e-13, -1.654684161652163e-14,  2.941594792313995e-16, -5.074159712310583e-18,  8.522889262940078e-20, -1.397449918783613e-21,
   1.598288903610141e-02, -9.602695847974504e-04,  4.029271038381483e-05, -1.399480601227076e-06,  4.281748058598985e-08, -1.192043485616412e-09,  3.079698888073209e-11,
  -7.480118406003576e-13,  1.723701550960656e-14, -3.793984658019891e-16,  8.017591767210354e-18, -1.632670793912228e-19,  3.121674248187837e-02, -2.948120505378151e-03,
@@ -1243,51 +1242,5 @@ void BreitRootList::breitroot11(const double* ta, double* rr, double* ww, const
  -1.352575509422977e-22,  4.758121763579341e-24, -1.582704096429707e-25,  4.402146220619089e-27, -9.747693294610909e-29,  1.572281552597417e-30, -1.231343603501797e-32,
   1.397913588048152e-16, -1.665568186039014e-18,  1.671338024973044e-20, -1.724563250857740e-22,  2.748054999018832e-24, -8.769075929623229e-26,  3.430602342727548e-27,
  -1.201732401387652e-28,  3.515110977627300e-30, -8.374063612657969e-32,  1.554614983525869e-33, -1.960160004868361e-35  };
-  int offset = -11;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 11;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 11, 0.5);
-      fill_n(ww+offset, 11, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 11; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=11; ++j) {
-        const int boxof = it*132+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(11, 3, ax, aw, x, w, ta, rr, ww, n);
 }
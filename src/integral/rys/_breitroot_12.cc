@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/breitrootlist.h>
 
 using namespace std;
@@ -31,13 +30,13 @@ using namespace bagel;
 
 void BreitRootList::breitroot12(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[12] = {7.778935822585290e-01,1.937296445047622e-01,1.761674062095619e+00,3.161287998144161e+00,5.001574999064721e+00,
+  static constexpr double ax[12] = {7.778935822585290e-01,1.937296445047622e-01,1.761674062095619e+00,3.161287998144161e+00,5.001574999064721e+00,
     7.318757585657917e+00,1.016522452511489e+01,1.361818771226726e+01,1.779666564426749e+01,2.289929101819602e+01,2.930745858720969e+01,3.799825464121894e+01
     };
-  constexpr double aw[12] = {1.583955754340995e-01,7.034110081601171e-02,1.354533484618175e-01,6.083297780644745e-02,1.558345083894831e-02,
+  static constexpr double aw[12] = {1.583955754340995e-01,7.034110081601171e-02,1.354533484618175e-01,6.083297780644745e-02,1.558345083894831e-02,
     2.306020771185211e-03,1.922851122223677e-04,8.520944310255042e-06,1.809988968805279e-07,1.538749556641047e-09,3.689266812234077e-12,1.030483602539409e-15
     };
-  constexpr double x[4608] = {  2.907326061095377e-02, -5.512804066293672e-04,  7.726550089856604e-06, -9.436503632218625e-08,  1.052113566593385e-09,
+  static constexpr double x[4608] = {  2.907326061095377e-02, -5.512804066293672e-04,  7.726550089856604e-06, -9.436503632218625e-08,  1.052113566593385e-09,
  -1.087328602018583e-11,  1.041503825953468e-13, -9.122194973305781e-16,  7.035412501944907e-18, -4.277468252583174e-20,  1.050960899722452e-22,  2.359594712614998e-24,
   1.147198632747022e-01, -2.084137995071522e-03,  2.670807641096085e-05, -2.769535178732359e-07,  2.300456611516345e-09, -1.298490391953411e-11, -5.414407155085109e-15,
   1.431023063206354e-15, -2.421892396158952e-17,  2.640404416109162e-19, -1.867472366140853e-21,  1.786528567658592e-24,  2.522777677855296e-01, -4.259887703371825e-03,
@@ -696,7 +695,7 @@ void BreitRootList::breitroot12(const double* ta, double* rr, double* ww, const
  -1.876676796455649e-12,  5.190707543156628e-14, -8.914235360500916e-16,  3.714270583160349e-18,  3.375693855723314e-19, -1.275563766579176e-20,  1.206431951690764e+00,
  -9.571884541017494e-03,  7.551349178996915e-05, -5.614367266029782e-07,  2.213250472443390e-09,  8.213248479226194e-11, -4.034854289837753e-12,  1.178053016825919e-13,
  -2.387254418667510e-15,  2.573562798233277e-17,  3.157531710032717e-19, -2.336835626195216e-20  };
-  constexpr double w[4608] = {  3.442465393653664e-03, -1.210298795175669e-04,  3.010813711966053e-06, -6.456217737576152e-08,  1.266800787752804e-09,
+  static constexpr double w[4608] = {  3.442465393653664e-03, -1.210298795175669e-04,  3.010813711966053e-06, -6.456217737576152e-08,  1.266800787752804e-09,
  -2.334269079821682e-11,  4.096902013137839e-13, -6.910568632371031e-15,  1.127240248739431e-16, -1.786219504272633e-18,  2.759095505550824e-20, -4.164767946378918e-22,
   1.277995614453423e-02, -6.873771152252260e-04,  2.596608715403702e-05, -8.159832509394941e-07,  2.267257116039867e-08, -5.749794236551812e-10,  1.356664897829017e-11,
  -3.016287609441882e-13,  6.375742827453551e-15, -1.289748571878381e-16,  2.509447809859902e-18, -4.713290664134862e-20,  2.545986474131717e-02, -2.131485094977980e-03,
@@ -1355,51 +1354,5 @@ void BreitRootList::breitroot12(const double* ta, double* rr, double* ww, const
   1.026643799421586e-24, -2.739221910266986e-26,  5.219805563964151e-28, -5.164995540050391e-30, -5.979497397009053e-32,  3.439388971589880e-33,  4.124182615571051e-18,
  -4.952694455175226e-20,  5.468980772064472e-22, -9.717677609988691e-24,  3.664299138432582e-25, -1.587980226871179e-26,  5.793495861763477e-28, -1.675501351971822e-29,
   3.708649107175430e-31, -5.774114027816084e-33,  4.668959537275396e-35,  1.442217903844189e-37  };
-  int offset = -12;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 12;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 12, 0.5);
-      fill_n(ww+offset, 12, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 12; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=12; ++j) {
-        const int boxof = it*144+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(12, 3, ax, aw, x, w, ta, rr, ww, n);
 }
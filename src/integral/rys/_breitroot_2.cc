@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/breitrootlist.h>
 
 using namespace std;
@@ -31,9 +30,9 @@ using namespace bagel;
 
 void BreitRootList::breitroot2(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[2] = {9.188611699158103e-01,4.081138830084189e+00};
-  constexpr double aw[2] = {3.616815117731377e-01,8.143195095324129e-02};
-  constexpr double x[768] = {  5.115590067861033e-01, -3.307842995243011e-02,  1.090593163356171e-03, -2.614955387247384e-06, -1.857935327442760e-06,
+  static constexpr double ax[2] = {9.188611699158103e-01,4.081138830084189e+00};
+  static constexpr double aw[2] = {3.616815117731377e-01,8.143195095324129e-02};
+  static constexpr double x[768] = {  5.115590067861033e-01, -3.307842995243011e-02,  1.090593163356171e-03, -2.614955387247384e-06, -1.857935327442760e-06,
   8.655863904704325e-08,  7.270258092075956e-10, -2.215785346351861e-10,  7.054575966183911e-12,  2.019714551696680e-13, -2.484631690486642e-14,  5.601207484665491e-16,
   1.581464307536534e+00, -3.170168030388232e-02, -1.286925682891906e-03, -1.314833535308483e-05,  1.980723941005067e-06,  1.254497201763767e-07,  9.328379319924865e-10,
  -2.682190090794000e-10, -1.450242705105992e-11,  8.186642101764643e-17,  3.670224988683985e-14,  1.708331143869597e-15,  3.959534126894955e-01, -2.485531660507064e-02,
@@ -144,7 +143,7 @@ void BreitRootList::breitroot2(const double* ta, double* rr, double* ww, const i
   2.894424262857003e-23, -2.297162113166462e-25,  1.295762874315252e-01, -1.028448017710891e-03,  8.162800046979323e-06, -6.478820850398733e-08,  5.142245230800969e-10,
  -4.081404104894783e-12,  3.239413664613812e-14, -2.571125186526123e-16,  2.040704093150861e-18, -1.619708452009371e-20,  1.285563873697060e-22, -1.020288788548092e-24
   };
-  constexpr double w[768] = {  1.945043469069972e-01, -3.639789063247634e-02,  4.617254554322831e-03, -4.674613687886327e-04,  4.001970673928960e-05,
+  static constexpr double w[768] = {  1.945043469069972e-01, -3.639789063247634e-02,  4.617254554322831e-03, -4.674613687886327e-04,  4.001970673928960e-05,
  -2.988425295773276e-06,  1.984401020181226e-07, -1.185837473569078e-08,  6.426832379165732e-10, -3.175258101924518e-11,  1.434952667389169e-12, -5.940276724692428e-14,
   2.190610115688224e-01, -7.024607982676291e-02,  1.290421325400950e-02, -1.686573739294910e-03,  1.723482757502595e-04, -1.450526963070022e-05,  1.039379163111662e-06,
  -6.490685478452444e-08,  3.594525021344069e-09, -1.789527150405464e-10,  8.097924503953570e-12, -3.356637872399126e-13,  9.823321403533526e-02, -1.430188915304775e-02,
@@ -255,51 +254,5 @@ void BreitRootList::breitroot2(const double* ta, double* rr, double* ww, const i
   5.311479164268176e-24, -4.407047190027845e-26,  3.257741402988833e-04, -3.878416267338733e-06,  3.847847271087756e-08, -3.563031962080570e-10,  3.181471429631173e-12,
  -2.777645652983068e-14,  2.388335159695547e-16, -2.031023469581252e-18,  1.712775367779763e-20, -1.434954363628171e-22,  1.195870114239727e-24, -9.922388592809519e-27
   };
-  int offset = -2;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 2;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 2, 0.5);
-      fill_n(ww+offset, 2, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 2; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=2; ++j) {
-        const int boxof = it*24+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(2, 3, ax, aw, x, w, ta, rr, ww, n);
 }
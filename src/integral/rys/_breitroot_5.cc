@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/breitrootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void BreitRootList::breitroot5(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[5] = {4.313988071478515e-01,1.759753698423697e+00,4.104465362828315e+00,7.746703779542557e+00,1.345767835205758e+01
+  static constexpr double ax[5] = {4.313988071478515e-01,1.759753698423697e+00,4.104465362828315e+00,7.746703779542557e+00,1.345767835205758e+01
     };
-  constexpr double aw[5] = {1.852252850037293e-01,2.062921868847264e-01,4.888991002659035e-02,2.686707670585993e-03,1.937314074696786e-05
+  static constexpr double aw[5] = {1.852252850037293e-01,2.062921868847264e-01,4.888991002659035e-02,2.686707670585993e-03,1.937314074696786e-05
     };
-  constexpr double x[1920] = {  1.345015754586262e-01, -5.256134243437009e-03,  1.434259022232678e-04, -3.112703161984571e-06,  5.186105352634832e-08,
+  static constexpr double x[1920] = {  1.345015754586262e-01, -5.256134243437009e-03,  1.434259022232678e-04, -3.112703161984571e-06,  5.186105352634832e-08,
  -4.887037473709479e-10, -6.643392396540148e-12,  4.842321961203824e-13, -1.456146255045210e-14,  2.828748746290356e-16, -2.663936376533926e-18, -6.277879455500483e-20,
   5.062362055756694e-01, -1.608417761939236e-02,  2.584901742387758e-04, -1.304659737936685e-07, -1.073762051090822e-07,  2.326154731143053e-09,  1.068839018942707e-11,
  -1.695319480247359e-12,  3.198758129048375e-14,  4.090069527627482e-16, -3.297045308980945e-17,  4.928596961452547e-19,  1.022808726793804e+00, -2.173085537145793e-02,
@@ -310,7 +309,7 @@ void BreitRootList::breitroot5(const double* ta, double* rr, double* ww, const i
   6.148964406017759e-14, -4.880437056674638e-16,  3.873602433714777e-18, -3.074462014370840e-20,  2.440125723812852e-22, -1.936329206188239e-24,  4.272817149597563e-01,
  -3.391338349516063e-03,  2.691707929033792e-05, -2.136410711156949e-07,  1.695670869872388e-09, -1.345855305702084e-11,  1.068206391229161e-13, -8.478360889285412e-16,
   6.729273200348205e-18, -5.340991130053487e-20,  4.238994927472005e-22, -3.363723890980869e-24  };
-  constexpr double w[1920] = {  3.222481016858012e-02, -2.799687087204800e-03,  1.721992594069735e-04, -8.948252983996153e-06,  4.152741280337745e-07,
+  static constexpr double w[1920] = {  3.222481016858012e-02, -2.799687087204800e-03,  1.721992594069735e-04, -8.948252983996153e-06,  4.152741280337745e-07,
  -1.768293453780783e-08,  7.020306440856274e-10, -2.626272988628988e-11,  9.326233977529248e-13, -3.160818146966764e-14,  1.026488728131407e-15, -3.201343671211179e-17,
   9.355696169730054e-02, -1.448458419793693e-02,  1.451824639688134e-03, -1.137235542987913e-04,  7.505271333003097e-06, -4.341666556234885e-07,  2.255071657337470e-08,
  -1.068610961092618e-09,  4.672476399643016e-11, -1.900996590163446e-12,  7.242890358512030e-14, -2.594577248886418e-15,  1.259535666664971e-01, -3.130100240634434e-02,
@@ -585,51 +584,5 @@ void BreitRootList::breitroot5(const double* ta, double* rr, double* ww, const i
   7.879903035592978e-18, -6.701016690242658e-20,  5.651023511744401e-22, -4.734454095860610e-24,  3.945850842103595e-26, -3.274779878423276e-28,  7.750358671078346e-08,
  -9.226980729671972e-10,  9.154255287226560e-12, -8.476662893216249e-14,  7.568907924592079e-16, -6.608182709072318e-18,  5.681990743090076e-20, -4.831928854860360e-22,
   4.074816556948018e-24, -3.413948156547539e-26,  2.845491668415090e-28, -2.362273104656162e-30  };
-  int offset = -5;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 5;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 5, 0.5);
-      fill_n(ww+offset, 5, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 5; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=5; ++j) {
-        const int boxof = it*60+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(5, 3, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/breitrootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void BreitRootList::breitroot6(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[6] = {3.669498773083708e-01,1.488534292310453e+00,3.434007968424071e+00,6.349067925680379e+00,1.054046985844834e+01,
+  static constexpr double ax[6] = {3.669498773083708e-01,1.488534292310453e+00,3.434007968424071e+00,6.349067925680379e+00,1.054046985844834e+01,
     1.682097007782838e+01};
-  constexpr double aw[6] = {1.547120484181300e-01,2.088760748535111e-01,7.164293661048844e-02,7.666245511316917e-03,2.153455980219705e-04,
+  static constexpr double aw[6] = {1.547120484181300e-01,2.088760748535111e-01,7.164293661048844e-02,7.666245511316917e-03,2.153455980219705e-04,
     8.117349105370354e-07};
-  constexpr double x[2304] = {  9.929098614615624e-02, -3.381830948200347e-03,  8.204498930983277e-05, -1.638884360339702e-06,  2.715366444138695e-08,
+  static constexpr double x[2304] = {  9.929098614615624e-02, -3.381830948200347e-03,  8.204498930983277e-05, -1.638884360339702e-06,  2.715366444138695e-08,
  -3.424448388823469e-10,  1.880793763192049e-12,  5.927377703887094e-14, -2.638567412320496e-15,  6.488299291422863e-17, -1.141551239526719e-18,  1.222472051386591e-20,
   3.796452612901541e-01, -1.113218042029527e-02,  1.895458797612936e-04, -1.418527487599696e-06, -2.663443067270095e-08,  1.091794940570644e-09, -1.430262831919667e-11,
  -1.372993884893544e-13,  9.859654759575024e-15, -1.761276203129458e-16, -5.343115903697559e-19,  1.028714989527362e-19,  7.899094074747147e-01, -1.755419407266807e-02,
@@ -365,7 +364,7 @@ void BreitRootList::breitroot6(const double* ta, double* rr, double* ww, const i
  -6.640446630699801e-16,  5.270244019913087e-18, -4.181805032977663e-20,  3.314637757497178e-22, -2.615636033499997e-24,  5.340663340376092e-01, -4.238888715308278e-03,
   3.364409324088445e-05, -2.670334336214272e-07,  2.119446434007411e-09, -1.682206000468171e-11,  1.335166228170353e-13, -1.059711443296357e-15,  8.410409060293928e-18,
  -6.673114140365197e-20,  5.288038587573102e-22, -4.168337674709388e-24  };
-  constexpr double w[2304] = {  2.085082415819945e-02, -1.511395846242854e-03,  7.778210620091832e-05, -3.404881890050269e-06,  1.340383066056370e-07,
+  static constexpr double w[2304] = {  2.085082415819945e-02, -1.511395846242854e-03,  7.778210620091832e-05, -3.404881890050269e-06,  1.340383066056370e-07,
  -4.872376619575428e-09,  1.661031155269000e-10, -5.365148971277916e-12,  1.653707983946835e-13, -4.889743996659297e-15,  1.392432805908890e-16, -3.827841962352628e-18,
   6.557127583373057e-02, -8.276551224807806e-03,  6.906641351300671e-04, -4.574173356439457e-05,  2.583849337191257e-06, -1.292940047189776e-07,  5.864216779212933e-09,
  -2.447772169158536e-10,  9.504451102055357e-12, -3.460383627726575e-13,  1.188490990754055e-14, -3.865561355011252e-16,  1.004324706144519e-01, -2.054523138234190e-02,
@@ -695,51 +694,5 @@ void BreitRootList::breitroot6(const double* ta, double* rr, double* ww, const i
  -5.371181114553161e-21,  4.530246433561752e-23, -3.798368577297405e-25,  3.176699598978278e-27, -2.673957736435137e-29,  3.247401536320282e-09, -3.866106417766365e-11,
   3.835634448438338e-13, -3.551723162689505e-15,  3.171374046574878e-17, -2.768832864621895e-19,  2.380776707209795e-21, -2.024702503752845e-23,  1.707961493325324e-25,
  -1.433128557809822e-27,  1.202765540542856e-29, -1.026839414994186e-31  };
-  int offset = -6;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 6;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 6, 0.5);
-      fill_n(ww+offset, 6, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 6; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=6; ++j) {
-        const int boxof = it*72+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(6, 3, ax, aw, x, w, ta, rr, ww, n);
 }
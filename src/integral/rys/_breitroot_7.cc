@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/breitrootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void BreitRootList::breitroot7(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[7] = {1.290758622959153e+00,3.193036339206300e-01,2.958374458696650e+00,5.409031597244433e+00,8.804079578056776e+00,
+  static constexpr double ax[7] = {1.290758622959153e+00,3.193036339206300e-01,2.958374458696650e+00,5.409031597244433e+00,8.804079578056776e+00,
     1.346853574325148e+01,2.024991636587088e+01};
-  constexpr double aw[7] = {2.045709347070511e-01,1.315622571979460e-01,9.105886604635807e-02,1.502666215063549e-02,8.804470587700310e-04,
+  static constexpr double aw[7] = {2.045709347070511e-01,1.315622571979460e-01,9.105886604635807e-02,1.502666215063549e-02,8.804470587700310e-04,
     1.426473561057987e-05,3.083000770519572e-08};
-  constexpr double x[2688] = {  7.626105300631937e-02, -2.297680865367110e-03,  4.992996836187280e-05, -9.115929245811886e-07,  1.433924331460779e-08,
+  static constexpr double x[2688] = {  7.626105300631937e-02, -2.297680865367110e-03,  4.992996836187280e-05, -9.115929245811886e-07,  1.433924331460779e-08,
  -1.885928755571862e-10,  1.796970016495297e-12, -2.539027424945077e-15, -4.164575922253494e-16,  1.302146733991937e-17, -2.680180880937858e-19,  4.180933855945523e-21,
   2.945988907709758e-01, -7.921419134961364e-03,  1.330747683068267e-04, -1.346954329213732e-06, -1.448572818301468e-09,  3.832586165399999e-10, -8.132211005126539e-12,
   6.511718010895692e-14,  1.199814834967816e-15, -5.156172690956731e-17,  8.133162016263621e-19, -7.302541403159779e-22,  6.244042762448027e-01, -1.368241189752649e-02,
@@ -420,7 +419,7 @@ void BreitRootList::breitroot7(const double* ta, double* rr, double* ww, const i
   6.720931597804500e-18, -5.289964942104859e-20,  4.044775775673435e-22, -2.734130938747200e-24,  6.429354875495866e-01, -5.102984046483832e-03,  4.050242454618378e-05,
  -3.214680424303914e-07,  2.551492411778095e-09, -2.025106935876635e-11,  1.607239987225948e-13, -1.275207366950988e-15,  1.010072089399473e-17, -7.935896404478111e-20,
   6.015676759913902e-22, -3.890177122710269e-24  };
-  constexpr double w[2688] = {  1.422219632149992e-02, -8.809313586612736e-04,  3.878106677147227e-05, -1.458883805114201e-06,  4.960436534672944e-08,
+  static constexpr double w[2688] = {  1.422219632149992e-02, -8.809313586612736e-04,  3.878106677147227e-05, -1.458883805114201e-06,  4.960436534672944e-08,
  -1.564718131778548e-09,  4.648719853727578e-11, -1.313767031287693e-12,  3.556365200098930e-14, -9.268548589257909e-16,  2.334575680460601e-17, -5.697172391463011e-19,
   4.716643790513612e-02, -4.965603049131822e-03,  3.512904084562386e-04, -1.996170605594829e-05,  9.765615421255696e-07, -4.265839610390732e-08,  1.700958189374576e-09,
  -6.282238451528747e-11,  2.171418115710504e-12, -7.077577005225311e-14,  2.188068008421802e-15, -6.440525834600635e-17,  7.858251613261233e-02, -1.340901823422675e-02,
@@ -805,51 +804,5 @@ void BreitRootList::breitroot7(const double* ta, double* rr, double* ww, const i
   3.023823347775695e-24, -2.609317739226239e-26,  2.441324056512529e-28, -2.863279971757333e-30,  1.233375737502166e-10, -1.468362261757083e-12,  1.456788949232116e-14,
  -1.348959084335191e-16,  1.204507945929115e-18, -1.051672493394916e-20,  9.046002970640206e-23, -7.709849431044660e-25,  6.579678316421132e-27, -5.822723340911084e-29,
   5.950745070744271e-31, -8.416646944687777e-33  };
-  int offset = -7;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 7;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 7, 0.5);
-      fill_n(ww+offset, 7, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 7; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=7; ++j) {
-        const int boxof = it*84+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(7, 3, ax, aw, x, w, ta, rr, ww, n);
 }
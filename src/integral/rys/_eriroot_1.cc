@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -31,9 +30,9 @@ using namespace bagel;
 
 void ERIRootList::eriroot1(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[1] = {5.000000000000001e-01};
-  constexpr double aw[1] = {8.862269254527578e-01};
-  constexpr double x[384] = {  5.171465726991715e-01, -6.993957190985554e-02,  4.840058220865065e-03, -1.150363449702610e-05, -2.907148502366769e-05,
+  static constexpr double ax[1] = {5.000000000000001e-01};
+  static constexpr double aw[1] = {8.862269254527578e-01};
+  static constexpr double x[384] = {  5.171465726991715e-01, -6.993957190985554e-02,  4.840058220865065e-03, -1.150363449702610e-05, -2.907148502366769e-05,
   2.089950639734219e-06,  5.569301247750100e-08, -1.819896138117327e-08,  8.424257279799340e-10,  6.952983398979138e-11, -1.051616340890578e-11,  2.289204674733831e-13,
   3.068308595618962e-01, -3.663366103151805e-02,  3.204194498529495e-03, -1.801636190077208e-04,  2.596641029029815e-06,  6.441354100889876e-07, -7.234650334089614e-08,
   3.297196958331875e-09,  7.075647620350099e-11, -2.307094000000719e-11,  1.702473651147752e-12, -3.579235178778108e-14,  1.995727553949685e-01, -1.842332683812269e-02,
@@ -89,7 +88,7 @@ void ERIRootList::eriroot1(const double* ta, double* rr, double* ww, const int n
  -2.740013407817476e-21,  2.246063533922800e-23, -1.841035683543226e-25,  1.587501587502381e-02, -1.260001265001900e-04,  1.000064000127500e-06, -7.937515875029766e-09,
   6.300012625023700e-11, -5.000325000963752e-13,  3.968761906277781e-15, -3.150009462522100e-17,  2.500165000647502e-19, -1.984382937521828e-21,  1.575006300017323e-23,
  -1.250005000013741e-25  };
-  constexpr double w[384] = {  1.545361991220441e+00, -1.980219453337436e-01,  2.612248383778893e-02, -2.884849970973796e-03,  2.670676766446337e-04,
+  static constexpr double w[384] = {  1.545361991220441e+00, -1.980219453337436e-01,  2.612248383778893e-02, -2.884849970973796e-03,  2.670676766446337e-04,
  -2.111301632244193e-05,  1.451410808079440e-06, -8.811300406217861e-08,  4.784657763957309e-09, -2.348708529668016e-10,  1.051546525094701e-11, -4.320417435690969e-13,
   1.023820359281469e+00, -7.784518888153107e-02,  7.624122364560783e-03, -7.022396457247253e-04,  5.777515301043659e-05, -4.211209961005566e-06,  2.730286060110980e-07,
  -1.586297668351469e-08,  8.326007203467479e-10, -3.978265968632050e-11,  1.742531851719414e-12, -7.031246318392537e-14,  7.970079097052309e-01, -3.950969305784869e-02,
@@ -145,51 +144,5 @@ void ERIRootList::eriroot1(const double* ta, double* rr, double* ww, const int n
  -7.034571727399329e-21,  5.478109173434597e-23, -4.286174152758887e-25,  2.233187460129850e-01, -8.862483052146431e-04,  5.275633701685654e-06, -3.489400112802422e-08,
   2.423349082920835e-10, -1.731073583404705e-12,  1.259458737969899e-14, -9.282312716269219e-17,  6.906919268102137e-19, -5.177471118114867e-21,  3.903895319350381e-23,
  -2.957511436211931e-25  };
-  int offset = -1;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 1;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 1, 0.5);
-      fill_n(ww+offset, 1, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 1; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=1; ++j) {
-        const int boxof = it*12+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(1, 1, ax, aw, x, w, ta, rr, ww, n);
 }
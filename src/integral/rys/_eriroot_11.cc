@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void ERIRootList::eriroot11(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[11] = {5.483986957881850e-02,4.951741233503565e-01,1.384655740084600e+00,2.741919940106704e+00,4.597737700485708e+00,
+  static constexpr double ax[11] = {5.483986957881850e-02,4.951741233503565e-01,1.384655740084600e+00,2.741919940106704e+00,4.597737700485708e+00,
     6.999397469528837e+00,1.001890827595723e+01,1.376930586610168e+01,1.844111968097818e+01,2.440196124238707e+01,3.259498009144084e+01};
-  constexpr double aw[11] = {4.435452264349594e-01,2.869714332469075e-01,1.191023609587828e-01,3.114037088442390e-02,4.978399335051669e-03,
+  static constexpr double aw[11] = {4.435452264349594e-01,2.869714332469075e-01,1.191023609587828e-01,3.114037088442390e-02,4.978399335051669e-03,
     4.648850508842522e-04,2.365512855251061e-05,5.884287563300994e-07,5.966990986059663e-09,1.744339007547982e-11,6.167183424404054e-15};
-  constexpr double x[4224] = {  9.317228321983215e-03, -2.016470781270720e-04,  3.257873113172606e-06, -4.650557794732631e-08,  6.174625018523698e-10,
+  static constexpr double x[4224] = {  9.317228321983215e-03, -2.016470781270720e-04,  3.257873113172606e-06, -4.650557794732631e-08,  6.174625018523698e-10,
  -7.794956063138119e-12,  9.454276911663593e-14, -1.107377254450525e-15,  1.254554484784902e-17, -1.373699244544964e-19,  1.448345789301863e-21, -1.459954863498270e-23,
   8.289832655768302e-02, -1.730514327203232e-03,  2.595111196782076e-05, -3.247729291447446e-07,  3.461843558776383e-09, -3.005347405745891e-11,  1.711269962643137e-13,
   4.206195111936129e-16, -3.126304816906775e-17,  5.802721757581708e-19, -7.527226131806782e-21,  7.194846602217419e-23,  2.250039047047882e-01, -4.362075582505461e-03,
@@ -639,7 +638,7 @@ void ERIRootList::eriroot11(const double* ta, double* rr, double* ww, const int
  -2.122106992924976e-11,  4.978323618830116e-14,  3.798574322753848e-15, -1.511926782222090e-16,  4.006620761245479e-18, -8.103896976879977e-20,  1.155402665566031e-21,
   1.034891353079890e+00, -8.213853457534776e-03,  6.518050943352014e-05, -5.160855761970281e-07,  4.007100820795060e-09, -2.688265001466905e-11, -5.267259563001336e-15,
   8.000903849724942e-15, -3.026195665186772e-16,  8.288205641005192e-18, -1.806389259749858e-19,  3.022793911429047e-21,  };
-  constexpr double w[4224] = {  2.713690595932859e-01, -3.515595142922015e-03,  5.096316735419691e-05, -7.727706863407616e-07,  1.179685663078811e-08,
+  static constexpr double w[4224] = {  2.713690595932859e-01, -3.515595142922015e-03,  5.096316735419691e-05, -7.727706863407616e-07,  1.179685663078811e-08,
  -1.784689776348988e-10,  2.661210992490681e-12, -3.908109947159908e-14,  5.655159247646613e-16, -8.072456888719508e-18,  1.137830189791741e-19, -1.584982762912131e-21,
   2.574596996933166e-01, -7.579423084117414e-03,  2.260356512085413e-04, -6.038040180281354e-06,  1.482358697461374e-07, -3.411862397913002e-09,  7.452882621615894e-11,
  -1.557715022668532e-12,  3.133402129835432e-14, -6.092753018830919e-16,  1.149106172128771e-17, -2.107164375320740e-19,  2.324127659903851e-01, -1.426138469126863e-02,
@@ -1243,52 +1242,5 @@ void ERIRootList::eriroot11(const double* ta, double* rr, double* ww, const int
  -4.214111124844773e-22,  1.737969972230046e-23, -6.207973364164232e-25,  1.837458308478975e-26, -4.422520465432120e-28,  8.271041245027484e-30, -1.027226795532867e-31,
   1.554071526329496e-15, -6.171456009610050e-18,  3.732922851682545e-20, -3.034033102697287e-22,  6.052914753256556e-24, -2.568979079073573e-25,  1.114358209433801e-26,
  -4.106890309874288e-28,  1.260151109880082e-29, -3.192604885056949e-31,  6.510972294548831e-33, -9.892023866540979e-35,  };
-  int offset = -11;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 11;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 11, 0.5);
-      fill_n(ww+offset, 11, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 11; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=11; ++j) {
-        const int boxof = it*132+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(11, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -31,13 +30,13 @@ using namespace bagel;
 
 void ERIRootList::eriroot13(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[13] = {4.656008324502489e-02,4.200274064012138e-01,1.172310773277779e+00,2.314540864349432e+00,3.864585038228160e+00,
+  static constexpr double ax[13] = {4.656008324502489e-02,4.200274064012138e-01,1.172310773277779e+00,2.314540864349432e+00,3.864585038228160e+00,
     5.848734811306344e+00,8.304553489985892e+00,1.128575099351763e+01,1.487096037752541e+01,1.918091948561044e+01,2.441669233305652e+01,3.096393827474679e+01,
     3.981042606874936e+01};
-  constexpr double aw[13] = {4.120436505903693e-01,2.846322411767841e-01,1.351133279117879e-01,4.359822721725099e-02,9.397901291159517e-03,
+  static constexpr double aw[13] = {4.120436505903693e-01,2.846322411767841e-01,1.351133279117879e-01,4.359822721725099e-02,9.397901291159517e-03,
     1.319064722323857e-03,1.162297016031097e-04,6.103291717396045e-06,1.770106337397341e-07,2.524494034490568e-09,1.460999933981603e-11,2.383148659372180e-14,
     4.396916094753844e-18};
-  constexpr double x[4992] = {  6.763244749183432e-03, -1.248379441866770e-04,  1.722376060891350e-06, -2.103080710074614e-08,  2.393736891651011e-10,
+  static constexpr double x[4992] = {  6.763244749183432e-03, -1.248379441866770e-04,  1.722376060891350e-06, -2.103080710074614e-08,  2.393736891651011e-10,
  -2.597641617293236e-12,  2.717721174595044e-14, -2.757850315267350e-16,  2.722223940890498e-18, -2.616501228371319e-20,  2.446949527404646e-22, -2.221336165099678e-24,
   6.035894227004335e-02, -1.085223746022034e-03,  1.418812106328045e-05, -1.577783318447202e-07,  1.544309788392325e-09, -1.318913660284050e-11,  9.257775810694212e-14,
  -4.157494074616188e-16, -1.374093119053075e-18,  6.445602831734677e-20, -1.015354857869172e-21,  1.173682528336322e-23,  1.648483930799589e-01, -2.809579390326239e-03,
@@ -751,7 +750,7 @@ void ERIRootList::eriroot13(const double* ta, double* rr, double* ww, const int
   7.146108831122723e-14, -4.638051180505161e-16, -2.473369047610522e-17,  1.037355735108023e-18, -1.816296571800232e-20,  1.263939404027908e+00, -1.002133906423633e-02,
   7.826066315283095e-05, -5.223404180658210e-07, -1.239923883761344e-09,  2.253094127962032e-10, -8.080142380080356e-12,  1.865864144558251e-13, -2.320569197559113e-15,
  -2.250802768454128e-17,  2.034685773279837e-18, -5.505106225484532e-20,  };
-  constexpr double w[4992] = {  2.315806620512299e-01, -2.500733233052667e-03,  2.996954589428386e-05, -3.766231163718286e-07,  4.790158315795040e-09,
+  static constexpr double w[4992] = {  2.315806620512299e-01, -2.500733233052667e-03,  2.996954589428386e-05, -3.766231163718286e-07,  4.790158315795040e-09,
  -6.065645599434770e-11,  7.597102703756305e-13, -9.395457855878426e-15,  1.147285944387986e-16, -1.384339364035127e-18,  1.651882957066130e-20, -1.950766001950411e-22,
   2.228182459016555e-01, -5.125275484411538e-03,  1.232923661569682e-04, -2.696995857703739e-06,  5.462568649356539e-08, -1.043028259267972e-09,  1.898998053297344e-11,
  -3.321794380983343e-13,  5.612958900184470e-15, -9.199201966542450e-17,  1.466978618579625e-18, -2.281459852101302e-20,  2.066100213216586e-01, -9.677376430544372e-03,
@@ -1465,52 +1464,5 @@ void ERIRootList::eriroot13(const double* ta, double* rr, double* ww, const int
  -1.129200540952884e-26,  8.652814890172974e-29,  2.224481243514419e-30, -7.491688140686269e-32, -1.030183839337417e-34,  1.109386600507817e-18, -4.750798825273097e-21,
   6.965478654711203e-23, -3.591815072058894e-24,  1.917933168559231e-25, -7.897305387942315e-27,  2.454763104527654e-28, -5.615299367380067e-30,  8.742373201218913e-32,
  -7.851103281599205e-34,  1.009209287855130e-35, -8.383324560134541e-37,  };
-  int offset = -13;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 13;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 13, 0.5);
-      fill_n(ww+offset, 13, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 13; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=13; ++j) {
-        const int boxof = it*156+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(13, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,13 +31,13 @@ using namespace bagel;
 
 void ERIRootList::eriroot17(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[17] = {3.576185855633747e-02,3.223028970154079e-01,8.977874382442501e-01,1.767133009504831e+00,2.938010436924722e+00,
+  static constexpr double ax[17] = {3.576185855633747e-02,3.223028970154079e-01,8.977874382442501e-01,1.767133009504831e+00,2.938010436924722e+00,
     4.421236648583512e+00,6.231373602508013e+00,8.387620778171520e+00,1.091515015247613e+01,1.384714511079395e+01,1.722802494768479e+01,2.111880175525220e+01,
     2.560659579591730e+01,3.082316423852849e+01,3.698606526093494e+01,4.451103562790855e+01,5.446279044099501e+01};
-  constexpr double aw[17] = {3.649924469966446e-01,2.746277156351368e-01,1.551104166233093e-01,6.544513410875273e-02,2.047315172701939e-02,
+  static constexpr double aw[17] = {3.649924469966446e-01,2.746277156351368e-01,1.551104166233093e-01,6.544513410875273e-02,2.047315172701939e-02,
     4.698463629266589e-03,7.798175996231924e-04,9.186118982872301e-05,7.493448783302285e-06,4.097974035224618e-07,1.438773291253986e-08,3.056252041915478e-10,
     3.609881747486046e-12,2.087840373116021e-14,4.799901997894967e-17,2.956708922360592e-20,1.813800111959740e-24};
-  constexpr double x[6528] = {  4.026240143647612e-03, -5.740535841783749e-05,  6.126161432004804e-07, -5.796143374385052e-09,  5.123822914691198e-11,
+  static constexpr double x[6528] = {  4.026240143647612e-03, -5.740535841783749e-05,  6.126161432004804e-07, -5.796143374385052e-09,  5.123822914691198e-11,
  -4.330765783046556e-13,  3.541526279012360e-15, -2.821039236987832e-17,  2.197434819173199e-19, -1.677701215292747e-21,  1.256837728093071e-23, -9.240936751190407e-26,
   3.605235737786457e-02, -5.060081385011388e-04,  5.230317321647526e-06, -4.685924149854957e-08,  3.803862449519052e-10, -2.830101386435453e-12,  1.916089105394783e-14,
  -1.145431055212881e-16,  5.525695103427682e-19, -1.386634723439960e-21, -1.163463103273540e-23,  2.435142835706440e-25,  9.912897156970975e-02, -1.347825649402261e-03,
@@ -971,7 +970,7 @@ void ERIRootList::eriroot17(const double* ta, double* rr, double* ww, const int
  -1.473292358267948e-09, -3.543020597872438e-10, -5.400722901540886e-12,  1.836413245089102e-13,  7.063871666837774e-15, -9.714213443268445e-17, -6.715646824725874e-18,
   2.949064287243174e-20,  1.703875779540648e+00, -1.033838712049519e-02, -7.178790243727275e-05,  3.108425294720631e-06,  2.383049026602894e-08, -2.070467694140076e-09,
  -1.248373933438836e-11,  1.566140669033533e-12,  8.900078183521053e-15, -1.225263687731381e-15, -7.744422049613245e-18,  9.693062616585531e-19,  };
-  constexpr double w[6528] = {  1.789953244950015e-01, -1.446170682553805e-03,  1.278756405960936e-05, -1.187028412022730e-07,  1.122563970133637e-09,
+  static constexpr double w[6528] = {  1.789953244950015e-01, -1.446170682553805e-03,  1.278756405960936e-05, -1.187028412022730e-07,  1.122563970133637e-09,
  -1.063932792680963e-11,  1.002683962079018e-13, -9.367874833357893e-16,  8.668385374054127e-18, -7.945392866285748e-20,  7.217113072401306e-22, -6.500057463956412e-24,
   1.748809514102090e-01, -2.715773765940973e-03,  4.605621030227956e-05, -7.277674728721081e-07,  1.076837937793378e-08, -1.513718357253331e-10,  2.041940392252876e-12,
  -2.661206926044938e-14,  3.366964407836813e-16, -4.150384134850675e-18,  4.998586613254055e-20, -5.894323607433529e-22,  1.670375204482480e-01, -5.047321615460571e-03,
@@ -1904,52 +1903,5 @@ void ERIRootList::eriroot17(const double* ta, double* rr, double* ww, const int
   6.501652530148776e-26, -2.454820378413627e-27,  8.527109199712394e-29, -2.679494484548381e-30,  7.927376910117855e-32, -2.253755779129816e-33,  5.984765954917564e-35,
  -1.488067596054276e-36,  9.575998192651344e-25, -9.103866918354351e-26,  8.480398192074260e-27, -5.988475633727825e-28,  3.614631393285720e-29, -1.940811329455215e-30,
   9.365526124460031e-32, -4.115361811072700e-33,  1.668730677343531e-34, -6.288404480890519e-36,  2.212148465406702e-37, -7.300227933338514e-39,  };
-  int offset = -17;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 17;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 17, 0.5);
-      fill_n(ww+offset, 17, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 17; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=17; ++j) {
-        const int boxof = it*204+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(17, 1, ax, aw, x, w, ta, rr, ww, n);
 }
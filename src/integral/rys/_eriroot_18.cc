@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,13 +31,13 @@ using namespace bagel;
 
 void ERIRootList::eriroot18(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[18] = {3.380206059614466e-02,3.045951920680225e-01,8.482074788245103e-01,1.668775553329836e+00,2.772724528639121e+00,
+  static constexpr double ax[18] = {3.380206059614466e-02,3.045951920680225e-01,8.482074788245103e-01,1.668775553329836e+00,2.772724528639121e+00,
     4.169058247501773e+00,5.869795294527881e+00,7.890605917460938e+00,1.025174061640137e+01,1.297940302833536e+01,1.610783362121137e+01,1.968259409656978e+01,
     2.376601473315190e+01,2.844686341618787e+01,3.385916986557835e+01,4.022405046954309e+01,4.796392137388955e+01,5.816084450618310e+01};
-  constexpr double aw[18] = {3.555400742737078e-01,2.717012470095276e-01,1.583554537511661e-01,7.010475010517786e-02,2.342576750973172e-02,
+  static constexpr double aw[18] = {3.555400742737078e-01,2.717012470095276e-01,1.583554537511661e-01,7.010475010517786e-02,2.342576750973172e-02,
     5.856425986559556e-03,1.082534756686802e-03,1.456961596263603e-04,1.399702922032880e-05,9.355570089773111e-07,4.207491323109042e-08,1.217867820955731e-09,
     2.135354181784506e-11,2.080912674286899e-13,9.902901686906247e-16,1.861597987807984e-18,9.256403083558327e-22,4.447153417575597e-26};
-  constexpr double x[6912] = {  3.602934140130130e-03, -4.860305000612312e-05,  4.908467154486721e-07, -4.396040701317578e-09,  3.679909002930177e-11,
+  static constexpr double x[6912] = {  3.602934140130130e-03, -4.860305000612312e-05,  4.908467154486721e-07, -4.396040701317578e-09,  3.679909002930177e-11,
  -2.946562350424312e-13,  2.283909299013023e-15, -1.725468981891191e-17,  1.275710762987889e-19, -9.252980111398992e-22,  6.592610497473004e-24, -4.616336705655325e-26,
   3.227877730498518e-02, -4.293456273104157e-04,  4.213915709125832e-06, -3.594752847952827e-08,  2.789705707197382e-10, -1.996301733961926e-12,  1.313172991821198e-14,
  -7.780239905725162e-17,  3.921176377792969e-19, -1.372831884196288e-21, -1.319080796293971e-24,  8.735857149059108e-26,  8.884652624300850e-02, -1.148657320977989e-03,
@@ -1026,7 +1025,7 @@ void ERIRootList::eriroot18(const double* ta, double* rr, double* ww, const int
  -4.913986716934039e-11, -3.777966949226051e-12, -1.306558895006943e-13,  7.580157431472808e-16,  1.213557646904844e-16,  1.390062351744286e-18, -6.048887884135418e-20,
   1.785706592893636e+00, -8.302123078967417e-03, -1.189517509469178e-04,  1.265977963182181e-06,  6.505187790047707e-08, -1.482265669238172e-10, -4.254356426090270e-11,
  -3.508174400732869e-13,  2.516977133563000e-14,  5.358371516951144e-16, -1.123903819453404e-17, -5.166894523338153e-19,  };
-  constexpr double w[6912] = {  1.693712153054142e-01, -1.286904891142592e-03,  1.066944677592611e-05, -9.284830755802758e-08,  8.240568920529712e-10,
+  static constexpr double w[6912] = {  1.693712153054142e-01, -1.286904891142592e-03,  1.066944677592611e-05, -9.284830755802758e-08,  8.240568920529712e-10,
  -7.339058859275079e-12,  6.506315638622089e-14, -5.722874546045780e-16,  4.988712949997466e-18, -4.309807302322692e-20,  3.691269638578896e-22, -3.135842872058637e-24,
   1.658753338103501e-01, -2.371154576189881e-03,  3.730676862543504e-05, -5.497835946616177e-07,  7.604397122363451e-09, -1.000754430735439e-10,  1.265373736736954e-12,
  -1.547398158021668e-14,  1.838706147012919e-16, -2.130468087762007e-18,  2.413670074931832e-20, -2.679298215932899e-22,  1.591788441882896e-01, -4.380034679876163e-03,
@@ -2014,52 +2013,5 @@ void ERIRootList::eriroot18(const double* ta, double* rr, double* ww, const int
  -4.055876976777204e-28,  1.567921804352422e-29, -5.559788566274762e-31,  1.831141356124100e-32, -5.631913722654302e-34,  1.629285280930598e-35, -4.460027751766319e-37,
   6.623440391354479e-26, -1.122970612005986e-26,  1.298046683348592e-27, -1.134243057843812e-28,  8.183445225752071e-30, -5.074628766517576e-31,  2.774303148668595e-32,
  -1.361566114879146e-33,  6.076628838133945e-35, -2.490406605417122e-36,  9.446041512748429e-38, -3.333371549473733e-39,  };
-  int offset = -18;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 18;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 18, 0.5);
-      fill_n(ww+offset, 18, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 18; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=18; ++j) {
-        const int boxof = it*216+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(18, 1, ax, aw, x, w, ta, rr, ww, n);
 }
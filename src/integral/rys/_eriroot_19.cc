@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,15 +31,15 @@ using namespace bagel;
 
 void ERIRootList::eriroot19(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[19] = {3.204591312825304e-02,2.887340723468645e-01,8.038347993954951e-01,1.580861457509691e+00,2.625251397291487e+00,
+  static constexpr double ax[19] = {3.204591312825304e-02,2.887340723468645e-01,8.038347993954951e-01,1.580861457509691e+00,2.625251397291487e+00,
     3.944584383931721e+00,5.548906636814555e+00,7.451196374737413e+00,9.668028267502336e+00,1.222052992938617e+01,1.513578608474423e+01,1.844896140646318e+01,
     2.220663960653552e+01,2.647235572714690e+01,3.133641179615084e+01,3.693498528005443e+01,4.349259161844164e+01,5.143807076938222e+01,6.187022447903700e+01
     };
-  constexpr double aw[19] = {3.467841178687803e-01,2.687237600289276e-01,1.610879714954811e-01,7.444398336823849e-02,2.638053352048692e-02,
+  static constexpr double aw[19] = {3.467841178687803e-01,2.687237600289276e-01,1.610879714954811e-01,7.444398336823849e-02,2.638053352048692e-02,
     7.115236826134048e-03,1.446307121562705e-03,2.187575953393917e-04,2.422341512093562e-05,1.923465686732354e-06,1.066586570440940e-07,3.990652885688871e-09,
     9.627029292605650e-11,1.407633343845225e-12,1.142861675025690e-14,4.517371223604765e-17,7.007843330558407e-20,2.838738753209343e-23,1.078718882074127e-27
     };
-  constexpr double x[7296] = {  3.243030629141147e-03, -4.151169348671088e-05,  3.978718493532683e-07, -3.382598251495552e-09,  2.688740854508611e-11,
+  static constexpr double x[7296] = {  3.243030629141147e-03, -4.151169348671088e-05,  3.978718493532683e-07, -3.382598251495552e-09,  2.688740854508611e-11,
  -2.045076310944256e-13,  1.506427888866165e-15, -1.082133503758774e-17,  7.612093604788456e-20, -5.256982188414674e-22,  3.569507049057003e-24, -2.384636679637934e-26,
   2.906734228265174e-02, -3.673781480316636e-04,  3.431815502375254e-06, -2.792893953592130e-08,  2.074604832488249e-10, -1.427966863966275e-12,  9.105940019393373e-15,
  -5.305368916119473e-17,  2.717500392305831e-19, -1.091586684536077e-21,  1.676664638221318e-24,  2.818996184094430e-26,  8.007886844950526e-02, -9.865482477286940e-04,
@@ -1083,7 +1082,7 @@ void ERIRootList::eriroot19(const double* ta, double* rr, double* ww, const int
   1.046153372483518e-12, -2.494510165814494e-14, -2.004958140271741e-15, -1.699809282729660e-17,  8.539801010811324e-19,  2.468969672739984e-20,  1.846747298309468e+00,
  -6.072592759099016e-03, -1.182758239128948e-04, -4.599220856863207e-07,  3.857092801395729e-08,  8.821010512686866e-10, -4.475225921276757e-12, -5.713041184040059e-13,
  -8.263003571767245e-15,  1.716724426200655e-16,  8.178403982870358e-18,  6.053040940509039e-20,  };
-  constexpr double w[7296] = {  1.607270146226080e-01, -1.152456439036995e-03,  8.991298534576949e-06, -7.361109565036572e-08,  6.152057376864908e-10,
+  static constexpr double w[7296] = {  1.607270146226080e-01, -1.152456439036995e-03,  8.991298534576949e-06, -7.361109565036572e-08,  6.152057376864908e-10,
  -5.165254148293829e-12,  4.321202167669540e-14, -3.589517490668044e-16,  2.956791632223359e-18, -2.414912603376052e-20,  1.956119406249434e-22, -1.572143335166722e-24,
   1.577318807318815e-01, -2.085563258609347e-03,  3.056301733849760e-05, -4.215899612888634e-07,  5.470306042846908e-09, -6.762766519594566e-11,  8.041633682197977e-13,
  -9.256966568359651e-15,  1.036299391513728e-16, -1.132093982699304e-18,  1.210093575994196e-20, -1.268168690407992e-22,  1.519708905633569e-01, -3.827499971744535e-03,
@@ -2126,52 +2125,5 @@ void ERIRootList::eriroot19(const double* ta, double* rr, double* ww, const int
   3.465123598111496e-30, -1.362401557584272e-31,  4.920925018664205e-33, -1.648488649178603e-34,  5.160503425679942e-36, -1.517419952060361e-37,  8.393835245669767e-27,
  -2.035483818398821e-27,  2.895557322633492e-28, -3.000254042795119e-29,  2.486131020489728e-30, -1.731468550462621e-31,  1.045557649092927e-32, -5.591786386433952e-34,
   2.689751975192568e-35, -1.177367713677348e-36,  4.733031514881550e-38, -1.758444956855349e-39,  };
-  int offset = -19;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 19;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 19, 0.5);
-      fill_n(ww+offset, 19, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 19; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=19; ++j) {
-        const int boxof = it*228+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(19, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,15 +31,15 @@ using namespace bagel;
 
 void ERIRootList::eriroot23(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[23] = {2.653218387609836e-02,2.389716199993339e-01,6.648260832562888e-01,1.306071615803997e+00,2.165735979535348e+00,
+  static constexpr double ax[23] = {2.653218387609836e-02,2.389716199993339e-01,6.648260832562888e-01,1.306071615803997e+00,2.165735979535348e+00,
     3.247979609296123e+00,4.558211647594767e+00,6.103249261459857e+00,7.891532362130975e+00,9.933411571882624e+00,1.224153595127313e+01,1.483138058862574e+01,
     1.772197621399749e+01,2.093694020760516e+01,2.450597390184634e+01,2.846711245452768e+01,3.287025236104362e+01,3.778298740536300e+01,4.330095920116128e+01,
     4.956801284212563e+01,5.682101866501256e+01,6.551242711227015e+01,7.680290116031279e+01};
-  constexpr double aw[23] = {3.172743849181671e-01,2.568445435065200e-01,1.681601273621231e-01,8.886822756600514e-02,3.779583099224686e-02,
+  static constexpr double aw[23] = {3.172743849181671e-01,2.568445435065200e-01,1.681601273621231e-01,8.886822756600514e-02,3.779583099224686e-02,
     1.288348755977721e-02,3.501057850522795e-03,7.533967345431294e-04,1.273198375510694e-04,1.672593592065391e-05,1.686946839735520e-06,1.286532413056337e-07,
     7.281634756563973e-09,2.988545587992385e-10,8.639140291448407e-12,1.694707616774984e-13,2.148647282367977e-15,1.648444738950766e-17,6.973799596694894e-20,
     1.415504201675422e-22,1.097655801996775e-25,2.113201496269695e-29,3.411379229909481e-34};
-  constexpr double x[8832] = {  2.233276443804096e-03, -2.373231831940797e-05,  1.889343188909143e-07, -1.335056012122436e-09,  8.827709309771545e-12,
+  static constexpr double x[8832] = {  2.233276443804096e-03, -2.373231831940797e-05,  1.889343188909143e-07, -1.335056012122436e-09,  8.827709309771545e-12,
  -5.591152949676807e-14,  3.433752199032877e-16, -2.059481875055814e-18,  1.211662233227607e-20, -7.012670824701344e-23,  3.999969295648870e-25, -2.251126551555626e-27,
   2.004212297484025e-02, -2.111222514272325e-04,  1.651274625987462e-06, -1.132453032684587e-08,  7.152301904779432e-11, -4.238661114803884e-13,  2.371257301554280e-15,
  -1.249825136385738e-17,  6.141967201386315e-20, -2.745230554929187e-22,  1.049064024353715e-24, -2.749266294466378e-27,  5.535475601081648e-02, -5.729163505159661e-04,
@@ -1303,7 +1302,7 @@ void ERIRootList::eriroot23(const double* ta, double* rr, double* ww, const int
   3.664014641314278e-20,  5.698398367008433e-23,  1.952151824779048e+00, -1.417693970963723e-03, -2.888555276784019e-05, -4.614601715004582e-07, -5.623258213637179e-09,
  -4.021655018635264e-11,  2.589501267307183e-13,  1.537184527574259e-14,  3.089639456412093e-16,  3.744811275365976e-18,  1.482377268894064e-20, -5.656394261519637e-22,
   };
-  constexpr double w[8832] = {  1.334663456484316e-01, -7.805615800915129e-04,  4.918753362310107e-06, -3.247049218770353e-08,  2.193701966566969e-10,
+  static constexpr double w[8832] = {  1.334663456484316e-01, -7.805615800915129e-04,  4.918753362310107e-06, -3.247049218770353e-08,  2.193701966566969e-10,
  -1.494224687957581e-12,  1.017488284782228e-14, -6.897799299431677e-17,  4.646662541538394e-19, -3.108600569579059e-21,  2.065214844241805e-23, -1.362839704994196e-25,
   1.317379343473204e-01, -1.326367052776038e-03,  1.511272309922405e-05, -1.649277218719746e-07,  1.706358500156431e-09, -1.689928501193165e-11,  1.615618617120367e-13,
  -1.499858667960557e-15,  1.357792126464576e-17, -1.202414468384216e-19,  1.044177080256813e-21, -8.908660883412219e-24,  1.283741257210984e-01, -2.367149731726697e-03,
@@ -2566,52 +2565,5 @@ void ERIRootList::eriroot23(const double* ta, double* rr, double* ww, const int
   1.899423118322742e-37, -6.861443746681925e-39,  1.345939356969969e-28, -5.179177574650302e-29,  1.065922641950807e-29, -1.502063719977479e-30,  1.614387024950558e-31,
  -1.405707971009661e-32,  1.030513871613349e-33, -6.531844094866749e-35,  3.650019310901606e-36, -1.825077551472210e-37,  8.261764291871763e-39, -3.413417147698009e-40,
   };
-  int offset = -23;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 23;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 23, 0.5);
-      fill_n(ww+offset, 23, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 23; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=23; ++j) {
-        const int boxof = it*276+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(23, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,15 +31,15 @@ using namespace bagel;
 
 void ERIRootList::eriroot24(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[24] = {2.543799658568947e-02,2.291023164926246e-01,6.372902787326692e-01,1.251740632362747e+00,2.075112909852380e+00,
+  static constexpr double ax[24] = {2.543799658568947e-02,2.291023164926246e-01,6.372902787326692e-01,1.251740632362747e+00,2.075112909852380e+00,
     3.111052455147712e+00,4.364283076935299e+00,5.840733271323610e+00,7.547704680023458e+00,9.494095330026482e+00,1.169069592605607e+01,1.415058618728575e+01,
     1.688967192852710e+01,1.992742587524246e+01,2.328793282487991e+01,2.700140605647238e+01,3.110646470904661e+01,3.565370351632816e+01,4.071159818554305e+01,
     4.637697955754001e+01,5.279543252728354e+01,6.020666696305724e+01,6.906860197530438e+01,8.055628081995049e+01};
-  constexpr double aw[24] = {3.110010303779634e-01,2.539615426647586e-01,1.692044719456415e-01,9.182229707928535e-02,4.047967698460383e-02,
+  static constexpr double aw[24] = {3.110010303779634e-01,2.539615426647586e-01,1.692044719456415e-01,9.182229707928535e-02,4.047967698460383e-02,
     1.444496157498107e-02,4.153004911977566e-03,9.563923198194101e-04,1.751504318011728e-04,2.528599027748500e-05,2.847258691734871e-06,2.468658993669740e-07,
     1.622514135895753e-08,7.930467495165331e-10,2.815296537838210e-11,7.046932581545919e-13,1.197589865479171e-14,1.315159622658434e-16,8.730159601186705e-19,
     3.188387323505206e-21,5.564577468902242e-24,3.685036080150508e-27,5.984612693314022e-31,7.935551460773836e-36};
-  constexpr double x[9216] = {  2.054737563136536e-03, -2.094562714673068e-05,  1.599713715613638e-07, -1.084574219912362e-09,  6.881786680973879e-12,
+  static constexpr double x[9216] = {  2.054737563136536e-03, -2.094562714673068e-05,  1.599713715613638e-07, -1.084574219912362e-09,  6.881786680973879e-12,
  -4.183365428266447e-14,  2.466370546073325e-16, -1.420434724372305e-18,  8.026877322734496e-21, -4.463728781584769e-23,  2.447330398953701e-25, -1.324520211816894e-27,
   1.844399518383118e-02, -1.865033698560047e-04,  1.401406733535115e-06, -9.243654720621435e-09,  5.623505117577527e-11, -3.216783291911322e-13,  1.742052185745600e-15,
  -8.926791691744026e-18,  4.295245939720174e-20, -1.904979762477717e-22,  7.457959551901994e-25, -2.268609290987141e-27,  5.096378104582430e-02, -5.070486567020802e-04,
@@ -1357,7 +1356,7 @@ void ERIRootList::eriroot24(const double* ta, double* rr, double* ww, const int
   1.544288394642338e-09,  4.178447357446905e-11,  2.211612624555713e-13, -4.189236822794798e-15, -8.460538791964179e-17, -1.967390783141093e-19,  1.471813161640405e-20,
   2.452940625862473e-22,  1.961971834441351e+00, -1.026520639672552e-03, -1.949978877182688e-05, -3.011455615934587e-07, -3.813008905270353e-09, -3.634037784149027e-11,
  -1.531820979614132e-13,  3.240207944624110e-15,  1.041191145736177e-16,  1.764973961434570e-18,  1.991618991763302e-20,  1.030441581213195e-22,  };
-  constexpr double w[9216] = {  1.280352917258108e-01, -7.157219019508455e-04,  4.301800513305075e-06, -2.707174617184253e-08,  1.744269273111122e-10,
+  static constexpr double w[9216] = {  1.280352917258108e-01, -7.157219019508455e-04,  4.301800513305075e-06, -2.707174617184253e-08,  1.744269273111122e-10,
  -1.133872406465170e-12,  7.373759793615857e-15, -4.776715945239790e-17,  3.076208314846978e-19, -1.968106350051550e-21,  1.250779248339483e-23, -7.897579719901675e-26,
   1.265071219389021e-01, -1.199546669203801e-03,  1.292163728977991e-05, -1.338310884216596e-07,  1.316395821869719e-09, -1.240721731996495e-11,  1.129692289985611e-13,
  -9.994504785049029e-16,  8.627304580818685e-18, -7.288577674308892e-20,  6.040945091259476e-22, -4.921151550458088e-24,  1.235267432123466e-01, -2.125622221615186e-03,
@@ -2674,52 +2673,5 @@ void ERIRootList::eriroot24(const double* ta, double* rr, double* ww, const int
   4.581306598637498e-30, -3.423307384317550e-31,  2.176672915847082e-32, -1.208235098934984e-33,  5.964729965257562e-35, -2.655968949928215e-36,  1.078524680276152e-37,
  -4.025025131370438e-39,  8.088821854986015e-29, -3.214359608592741e-29,  6.825100307757294e-30, -9.893096681397570e-31,  1.090559032277841e-31, -9.714280432106602e-33,
   7.268805656080240e-34, -4.693378027759226e-35,  2.667110523244678e-36, -1.354163776885334e-37,  6.216312595000703e-39, -2.601352122334601e-40,  };
-  int offset = -24;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 24;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 24, 0.5);
-      fill_n(ww+offset, 24, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 24; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=24; ++j) {
-        const int boxof = it*288+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(24, 1, ax, aw, x, w, ta, rr, ww, n);
 }
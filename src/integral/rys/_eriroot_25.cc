@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,15 +31,15 @@ using namespace bagel;
 
 void ERIRootList::eriroot25(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[25] = {2.443048616413472e-02,2.200163986518768e-01,6.119490588603562e-01,1.201766537740989e+00,1.991817805291175e+00,
+  static constexpr double ax[25] = {2.443048616413472e-02,2.200163986518768e-01,6.119490588603562e-01,1.201766537740989e+00,1.991817805291175e+00,
     2.985315465638807e+00,4.186410501044280e+00,5.600293399082735e+00,7.233327963732224e+00,9.093226798308924e+00,1.118928132171246e+01,1.353266493027597e+01,
     1.613683670538979e+01,1.901808690620518e+01,2.219628800888456e+01,2.569595308971719e+01,2.954777038606832e+01,3.379090709646603e+01,3.847661995637610e+01,
     4.367422804234256e+01,4.948170724011150e+01,5.604632615155951e+01,6.361055216022205e+01,7.263762604545185e+01,8.431659754470152e+01};
-  constexpr double aw[25] = {3.050851292043992e-01,2.511308563320018e-01,1.700324556771637e-01,9.454893547708650e-02,4.307915915676566e-02,
+  static constexpr double aw[25] = {3.050851292043992e-01,2.511308563320018e-01,1.700324556771637e-01,9.454893547708650e-02,4.307915915676566e-02,
     1.603194106841214e-02,4.853263826171954e-03,1.189011781749646e-03,2.342698921092547e-04,3.684019053780712e-05,4.581682707955464e-06,4.457029966817791e-07,
     3.346793404021368e-08,1.909040543811879e-09,8.111877364930081e-11,2.506655523899630e-12,5.465944031815584e-14,8.094261893465156e-16,7.742382957043270e-18,
     4.470984365408032e-20,1.417093599573452e-22,2.137658308360210e-25,1.215244123404523e-28,1.673801667907695e-32,1.833794048573428e-37};
-  constexpr double x[9600] = {  1.896781561611456e-03, -1.857862178993128e-05,  1.363502617601414e-07, -8.884049261644665e-10,  5.418116619675158e-12,
+  static constexpr double x[9600] = {  1.896781561611456e-03, -1.857862178993128e-05,  1.363502617601414e-07, -8.884049261644665e-10,  5.418116619675158e-12,
  -3.166191532470170e-14,  1.794802138027642e-16, -9.940822957225779e-19,  5.403842404475196e-21, -2.891597888304857e-23,  1.526043086483505e-25, -7.953185239124377e-28,
   1.702951684343407e-02, -1.655619938565035e-04,  1.196946777298350e-06, -7.603603215968863e-09,  4.460924178476160e-11, -2.465223217870516e-13,  1.292959104345135e-15,
  -6.439751390806934e-18,  3.028853272191614e-20, -1.326457638459068e-22,  5.241400578106242e-25, -1.721941996366103e-27,  4.707411878771993e-02, -4.508548942252892e-04,
@@ -1412,7 +1411,7 @@ void ERIRootList::eriroot25(const double* ta, double* rr, double* ww, const int
   2.647353004375357e-11,  2.851262972551947e-13, -1.537992985030880e-16, -4.432457686630712e-17, -5.511104887206387e-19,  6.345363635636923e-26,  9.630671535057338e-23,
   1.969143620402358e+00, -7.613983524556544e-04, -1.342892960611900e-05, -1.970739755834852e-07, -2.468229540254631e-09, -2.556545422410093e-11, -1.893813841413394e-13,
  -1.893645172467621e-16,  2.594789236650806e-17,  5.989991867097754e-19,  8.826932765915790e-21,  9.292147249579999e-23,  };
-  constexpr double w[9600] = {  1.230283907446598e-01, -6.586150474127330e-04,  3.783351741309412e-06, -2.274296584048054e-08,  1.400217252686490e-10,
+  static constexpr double w[9600] = {  1.230283907446598e-01, -6.586150474127330e-04,  3.783351741309412e-06, -2.274296584048054e-08,  1.400217252686490e-10,
  -8.703090793560206e-13,  5.415078030764665e-15, -3.358042976329905e-17,  2.071099255926054e-19, -1.269429431532944e-21,  7.730945796859055e-24, -4.678803471988207e-26,
   1.216707292538252e-01, -1.089471584378110e-03,  1.112063361602183e-05, -1.095400081113149e-07,  1.026462132608195e-09, -9.225439575438047e-12,  8.015568856358639e-14,
  -6.771001393217433e-16,  5.583530666653537e-18, -4.508370702547086e-20,  3.572781885960463e-22, -2.783950940677009e-24,  1.190179258256433e-01, -1.916918817104627e-03,
@@ -2784,52 +2783,5 @@ void ERIRootList::eriroot25(const double* ta, double* rr, double* ww, const int
  -1.760073961216165e-31,  1.166664684761148e-32, -6.725948689495931e-34,  3.437359930400959e-35, -1.579936920083893e-36,  6.605722430142686e-38, -2.532321014797904e-39,
   5.345955879876385e-29, -2.172150804520625e-29,  4.715470142608072e-30, -6.976097695346811e-31,  7.834261834941438e-32, -7.097338289528192e-33,  5.392989512916768e-34,
  -3.531455799308841e-35,  2.032812186690757e-36, -1.044382200912587e-37,  4.846711753761645e-39, -2.048642921550962e-40,  };
-  int offset = -25;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 25;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 25, 0.5);
-      fill_n(ww+offset, 25, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 25; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=25; ++j) {
-        const int boxof = it*300+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(25, 1, ax, aw, x, w, ta, rr, ww, n);
 }
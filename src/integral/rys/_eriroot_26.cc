@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,17 +31,17 @@ using namespace bagel;
 
 void ERIRootList::eriroot26(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[26] = {2.349974545174797e-02,2.116240977285072e-01,5.885496556564078e-01,1.155643612882639e+00,1.914991132120140e+00,
+  static constexpr double ax[26] = {2.349974545174797e-02,2.116240977285072e-01,5.885496556564078e-01,1.155643612882639e+00,1.914991132120140e+00,
     2.869438484833211e+00,4.022653911405096e+00,5.379209465144435e+00,6.944688490705934e+00,8.725825284829721e+00,1.073068616496011e+01,1.296890505651272e+01,
     1.545199249871947e+01,1.819374583298205e+01,2.121080231179406e+01,2.452339962178934e+01,2.815644675773867e+01,3.214107595384169e+01,3.651697198370508e+01,
     4.133602235846507e+01,4.666835574052357e+01,5.261305366416475e+01,5.931901757410574e+01,6.703139692639424e+01,7.621861753824244e+01,8.808338613530340e+01
     };
-  constexpr double aw[26] = {2.994940248515846e-01,2.483568853742081e-01,1.706718293444080e-01,9.706405557285901e-02,4.559018410343905e-02,
+  static constexpr double aw[26] = {2.994940248515846e-01,2.483568853742081e-01,1.706718293444080e-01,9.706405557285901e-02,4.559018410343905e-02,
     1.763516696573325e-02,5.597702267934169e-03,1.451447997862572e-03,3.057462468111910e-04,5.197599808292613e-05,7.074100498758235e-06,7.635568040303801e-07,
     6.462305217288649e-08,4.230668577428514e-09,2.107639018467193e-10,7.832644757121313e-12,2.118953962618635e-13,4.047376824044675e-15,5.250311740906098e-17,
     4.396697003627440e-19,2.219693930944449e-21,6.135380360042425e-24,8.037881303841061e-27,3.941595136916281e-30,4.627164501280460e-34,4.211542061410119e-39
     };
-  constexpr double x[9984] = {  1.756362211867407e-03, -1.655519000170758e-05,  1.169314051873375e-07, -7.332973932231346e-10,  4.304895383376631e-12,
+  static constexpr double x[9984] = {  1.756362211867407e-03, -1.655519000170758e-05,  1.169314051873375e-07, -7.332973932231346e-10,  4.304895383376631e-12,
  -2.421907588751466e-14,  1.321954029016061e-16, -7.051579460861764e-19,  3.692581274486186e-21, -1.903891511506527e-23,  9.684551834724806e-26, -4.866472692035428e-28,
   1.577161007175028e-02, -1.476373461054047e-04,  1.028365874581264e-06, -6.299540335185296e-09,  3.568115603535063e-11, -1.906650580550383e-13,  9.689997093063546e-16,
  -4.690813573582685e-18,  2.154339673740953e-20, -9.285682412333101e-23,  3.668606810877186e-25, -1.256147468046960e-27,  4.361241988484578e-02, -4.026305107102939e-04,
@@ -1469,7 +1468,7 @@ void ERIRootList::eriroot26(const double* ta, double* rr, double* ww, const int
   2.198117644571437e-13,  1.244219853025131e-15, -1.161228372696419e-17, -3.282266256632628e-19, -2.958268725676770e-21,  5.757479911705967e-24,  1.974509539432262e+00,
  -5.775814334965198e-04, -9.456170202642011e-06, -1.308406664256432e-07, -1.583650262745763e-09, -1.662281649800610e-11, -1.426693457342139e-13, -7.855799074259593e-16,
   2.757044469346162e-18,  1.638726322165223e-19,  3.010871094431803e-21,  3.932154486847005e-23,  };
-  constexpr double w[9984] = {  1.183978805210559e-01, -6.080615436321836e-04,  3.344586320871367e-06, -1.924073525009431e-08,  1.133964840455872e-10,
+  static constexpr double w[9984] = {  1.183978805210559e-01, -6.080615436321836e-04,  3.344586320871367e-06, -1.924073525009431e-08,  1.133964840455872e-10,
  -6.750854474973296e-13,  4.025609176651033e-15, -2.393740862700941e-17,  1.416232312092055e-19, -8.329618879317011e-22,  4.869050132518723e-24, -2.829005300125891e-26,
   1.171863074315817e-01, -9.933866808075006e-04,  9.628582988658506e-06, -9.037633777724473e-08,  8.083247865635263e-10, -6.940450210475864e-12,  5.764742948487420e-14,
  -4.657823711084283e-16,  3.675644861200308e-18, -2.841360530707023e-20,  2.156576606937622e-22, -1.610009883627995e-24,  1.148149909023815e-01, -1.735593376062562e-03,
@@ -2896,52 +2895,5 @@ void ERIRootList::eriroot26(const double* ta, double* rr, double* ww, const int
   6.829415327222304e-33, -4.059985678235232e-34,  2.134216206874875e-35, -1.006757322354049e-36,  4.311307220139801e-38, -1.689705257547569e-39,  3.785160804357765e-29,
  -1.562679347916802e-29,  3.447829339597813e-30, -5.178643444220023e-31,  5.897485828914486e-32, -5.411760625980814e-33,  4.161014106814993e-34, -2.754524831438325e-35,
   1.601590265287811e-36, -8.305192310192709e-38,  3.887594029184990e-39, -1.656421447172600e-40,  };
-  int offset = -26;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 26;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 26, 0.5);
-      fill_n(ww+offset, 26, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 26; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=26; ++j) {
-        const int boxof = it*312+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(26, 1, ax, aw, x, w, ta, rr, ww, n);
 }
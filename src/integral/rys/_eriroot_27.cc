@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,17 +31,17 @@ using namespace bagel;
 
 void ERIRootList::eriroot27(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[27] = {2.263732176449042e-02,2.038488635891013e-01,5.668767469899755e-01,1.112941744910869e+00,1.843903453122593e+00,
+  static constexpr double ax[27] = {2.263732176449042e-02,2.038488635891013e-01,5.668767469899755e-01,1.112941744910869e+00,1.843903453122593e+00,
     2.762295863481947e+00,3.871377342395919e+00,5.175197479643673e+00,6.678684287340594e+00,8.387756591898460e+00,1.030946834886564e+01,1.245219429240160e+01,
     1.482587023797262e+01,1.744230719122206e+01,2.031560736029375e+01,2.346272427950778e+01,2.690423223934055e+01,3.066540906177898e+01,3.477780474783739e+01,
     3.928159547665958e+01,4.422927233419712e+01,4.969174367338356e+01,5.576916124966562e+01,6.261201291367177e+01,7.046806044069685e+01,7.981078721503174e+01,
     9.185622924233597e+01};
-  constexpr double aw[27] = {2.941990845272923e-01,2.456424705042449e-01,1.711465279960141e-01,9.938278716047312e-02,4.801030616129554e-02,
+  static constexpr double aw[27] = {2.941990845272923e-01,2.456424705042449e-01,1.711465279960141e-01,9.938278716047312e-02,4.801030616129554e-02,
     1.924644137053955e-02,6.382059417046439e-03,1.743525421965474e-03,3.905161726631575e-04,7.129434727248519e-05,1.053544444182569e-05,1.249810028411287e-06,
     1.178618846581908e-07,8.733444835833852e-09,5.014739870473486e-10,2.194398467681038e-11,7.171344997855355e-13,1.707340673346895e-14,2.870989263205070e-16,
     3.278251969789967e-18,2.414691999972660e-20,1.070649058642177e-22,2.592337155745628e-25,2.962627587149390e-28,1.258780869112919e-31,1.265320076017024e-35,
     9.616569769829973e-41};
-  constexpr double x[10368] = {  1.630976633131293e-03, -1.481519821598573e-05,  1.008489656509862e-07, -6.095687018757674e-10,  3.449474602480023e-12,
+  static constexpr double x[10368] = {  1.630976633131293e-03, -1.481519821598573e-05,  1.008489656509862e-07, -6.095687018757674e-10,  3.449474602480023e-12,
  -1.870898433159756e-14,  9.846378924071529e-17, -5.065119031630056e-19,  2.558375315163007e-21, -1.272646715417766e-23,  6.247304154418891e-26, -3.030458924534935e-28,
   1.464800640953668e-02, -1.322059533619503e-04,  8.883833504645183e-07, -5.254085867147650e-09,  2.876157518653370e-11, -1.487388080138116e-13,  7.329216292286241e-16,
  -3.448933006380475e-18,  1.545708092433097e-20, -6.542403620710513e-23,  2.568364192598408e-25, -8.982713988249669e-28,  4.051824952143713e-02, -3.610174041649359e-04,
@@ -1524,7 +1523,7 @@ void ERIRootList::eriroot27(const double* ta, double* rr, double* ww, const int
   1.268348952064781e-15,  2.294459676684663e-18, -1.166133046077606e-19, -1.944555380079477e-21, -1.354413759791693e-23,  1.978613697877350e+00, -4.471370176007718e-04,
  -6.807339141757635e-06, -8.854499854304096e-08, -1.023993708860165e-09, -1.055807154832179e-11, -9.449840848362515e-14, -6.708503192489034e-16, -2.397939025873736e-18,
   3.042824614961426e-20,  8.748281684863730e-22,  1.347630201269261e-23,  };
-  constexpr double w[10368] = {  1.141029027335057e-01, -5.630980392362554e-04,  2.970824440623628e-06, -1.638360096318181e-08,  9.258451346530860e-11,
+  static constexpr double w[10368] = {  1.141029027335057e-01, -5.630980392362554e-04,  2.970824440623628e-06, -1.638360096318181e-08,  9.258451346530860e-11,
  -5.287829441187923e-13,  3.026731170264823e-15, -1.728437747029296e-17,  9.824631244399729e-20, -5.553242009241246e-22,  3.120418937385393e-24, -1.743162255431679e-26,
   1.130172129021143e-01, -9.090713806597601e-04,  8.383456050268183e-06, -7.511863252926600e-08,  6.423916790555062e-10, -5.278402336231045e-12,  4.198239051494675e-14,
  -3.249881225150638e-16,  2.458170074550060e-18, -1.822108955234336e-20,  1.326603740391616e-22, -9.503418318570050e-25,  1.108890900944287e-01, -1.577251050610969e-03,
@@ -3006,52 +3005,5 @@ void ERIRootList::eriroot27(const double* ta, double* rr, double* ww, const int
  -2.621227166454378e-34,  1.409950221899020e-35, -6.793966871931026e-37,  2.967314184920001e-38, -1.184381697044031e-39,  2.821033505725428e-29, -1.178466541229983e-29,
   2.632033138341891e-30, -3.999209892330345e-31,  4.603531723934198e-32, -4.266684365427584e-33,  3.311042321368148e-34, -2.210746317457565e-35,  1.295715296555684e-36,
  -6.769197055210187e-38,  3.190676042728668e-39, -1.368309039171802e-40,  };
-  int offset = -27;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 27;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 27, 0.5);
-      fill_n(ww+offset, 27, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 27; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=27; ++j) {
-        const int boxof = it*324+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(27, 1, ax, aw, x, w, ta, rr, ww, n);
 }
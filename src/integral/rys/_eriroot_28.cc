@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,17 +31,17 @@ using namespace bagel;
 
 void ERIRootList::eriroot28(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[28] = {2.183595942166431e-02,1.966250167560543e-01,5.467457595545777e-01,1.073292764692550e+00,1.777931588693515e+00,
+  static constexpr double ax[28] = {2.183595942166431e-02,1.966250167560543e-01,5.467457595545777e-01,1.073292764692550e+00,1.777931588693515e+00,
     2.662928318424790e+00,3.731190935013963e+00,4.986324374557585e+00,6.432701921917825e+00,8.075556568667009e+00,9.921097319421310e+00,1.197665731809708e+01,
     1.425088335946147e+01,1.675398028533747e+01,1.949802964803647e+01,2.249741105007468e+01,2.576936881615252e+01,2.933478986909120e+01,3.321929791927003e+01,
     3.745483826846005e+01,4.208205580020668e+01,4.715402124877787e+01,5.274239597000209e+01,5.894836984291936e+01,6.592397447421155e+01,7.391951917335301e+01,
     8.341342556883905e+01,9.563475086058828e+01};
-  constexpr double aw[28] = {2.891750843351486e-01,2.429892709927226e-01,1.714772476212722e-01,1.015193927179864e-01,5.033839742481598e-02,
+  static constexpr double aw[28] = {2.891750843351486e-01,2.429892709927226e-01,1.714772476212722e-01,1.015193927179864e-01,5.033839742481598e-02,
     2.085857414015774e-02,7.202052232041110e-03,2.064747563603152e-03,4.893729356570477e-04,9.539599104777372e-05,1.520108149228440e-05,1.965753400400977e-06,
     2.045446453646060e-07,1.695432425599157e-08,1.106200697688220e-09,5.601397850468629e-11,2.164192588501250e-12,6.250445629752320e-14,1.315856125139690e-15,
     1.956926178564817e-17,1.975666811539116e-19,1.285536389704850e-21,5.027099918729589e-24,1.070671358964358e-26,1.071799388321034e-29,3.962154089895823e-33,
     3.424984084388311e-37,2.183947379620196e-42};
-  constexpr double x[10752] = {  1.518553016346517e-03, -1.331071149913149e-05,  8.743823026424275e-08, -5.100588626113865e-10,  2.785859311137760e-12,
+  static constexpr double x[10752] = {  1.518553016346517e-03, -1.331071149913149e-05,  8.743823026424275e-08, -5.100588626113865e-10,  2.785859311137760e-12,
  -1.458524788327101e-14,  7.410643243900884e-17, -3.680884936098844e-19,  1.795512479434817e-21, -8.627461794042155e-24,  4.091868769500638e-26, -1.918268041937369e-28,
   1.364025762318776e-02, -1.188495251864893e-04,  7.713817599846461e-07, -4.409510618774793e-09,  2.335234869225965e-11, -1.169746622915920e-13,  5.592103287385049e-16,
  -2.558692505794175e-18,  1.118624332370740e-20, -4.642361829523618e-23,  1.803225506106816e-25, -6.362318124332815e-28,  3.774145682550425e-02, -3.249248432530768e-04,
@@ -1579,7 +1578,7 @@ void ERIRootList::eriroot28(const double* ta, double* rr, double* ww, const int
   5.349963055609900e-18, -1.611047340777447e-20, -7.950639428724977e-22, -9.738937577418448e-24,  1.981815152518099e+00, -3.524886805239976e-04, -5.003596201770509e-06,
  -6.116120299286696e-08, -6.722008286947231e-10, -6.704265296616856e-12, -5.996995343245617e-14, -4.611337855105130e-16, -2.654800281330390e-18, -3.386877829875403e-21,
   2.031440266211291e-22,  4.085898777778214e-24,  };
-  constexpr double w[10752] = {  1.101083002710989e-01, -5.229315545248714e-04,  2.650505109786504e-06, -1.403474513095300e-08,  7.616491251243493e-11,
+  static constexpr double w[10752] = {  1.101083002710989e-01, -5.229315545248714e-04,  2.650505109786504e-06, -1.403474513095300e-08,  7.616491251243493e-11,
  -4.179494882106981e-13,  2.299735423438397e-15, -1.263035340831650e-17,  6.907153969108551e-20, -3.757334492420048e-22,  2.032356237573327e-24, -1.093107677243421e-26,
   1.091316605787018e-01, -8.347214850669470e-04,  7.337342823160817e-06, -6.286704211652996e-08,  5.148757800660510e-10, -4.055056731742003e-12,  3.093220261933089e-14,
  -2.297587707585042e-16,  1.668254411965510e-18, -1.187504848582271e-20,  8.305426076077502e-23, -5.717387772924907e-25,  1.072147096015184e-01, -1.438319368233177e-03,
@@ -3116,52 +3115,5 @@ void ERIRootList::eriroot28(const double* ta, double* rr, double* ww, const int
   9.807626584699709e-36, -4.809253739458701e-37,  2.134925745248620e-38, -8.651264528828809e-40,  2.186353054685017e-29, -9.215737580157245e-30,  2.077741004019361e-30,
  -3.185512056016753e-31,  3.697963306724279e-32, -3.454532103898169e-33,  2.700629722562446e-34, -1.815649702822248e-35,  1.071035513184836e-36, -5.629332973852683e-38,
   2.668499295902048e-39, -1.150481388683532e-40,  };
-  int offset = -28;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 28;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 28, 0.5);
-      fill_n(ww+offset, 28, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 28; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=28; ++j) {
-        const int boxof = it*336+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(28, 1, ax, aw, x, w, ta, rr, ww, n);
 }
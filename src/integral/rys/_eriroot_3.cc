@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -31,9 +30,9 @@ using namespace bagel;
 
 void ERIRootList::eriroot3(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[3] = {1.901635091934882e-01,1.784492748543252e+00,5.525343742263258e+00};
-  constexpr double aw[3] = {7.246295952243923e-01,1.570673203228564e-01,4.530009905508835e-03};
-  constexpr double x[1152] = {  9.957336692678102e-02, -6.807050304362282e-03,  3.315467872729337e-04, -1.337533485322937e-05,  4.481947944382823e-07,
+  static constexpr double ax[3] = {1.901635091934882e-01,1.784492748543252e+00,5.525343742263258e+00};
+  static constexpr double aw[3] = {7.246295952243923e-01,1.570673203228564e-01,4.530009905508835e-03};
+  static constexpr double x[1152] = {  9.957336692678102e-02, -6.807050304362282e-03,  3.315467872729337e-04, -1.337533485322937e-05,  4.481947944382823e-07,
  -1.174035642547162e-08,  1.504657191624295e-10,  7.815869916112967e-12, -6.464553859558240e-13,  2.518229791745552e-14, -6.699963604170288e-16,  9.397072500392028e-18,
   8.009402920832142e-01, -3.630254641170549e-02,  4.533944042960137e-04,  2.715421822468478e-05, -1.109509718946611e-06, -2.705823332383892e-08,  2.579273061161046e-09,
   1.097427914412889e-11, -5.051970776979857e-12,  5.991129367847380e-14,  8.500272771356826e-15, -2.624032320632680e-16,  1.699191937284420e+00, -2.075327538745137e-02,
@@ -198,7 +197,7 @@ void ERIRootList::eriroot3(const double* ta, double* rr, double* ww, const int n
   2.248465369017143e-10, -1.784608740915842e-12,  1.416445368489272e-14, -1.124233808741286e-16,  8.923052627554069e-19, -7.082233924267074e-21,  5.621174640656443e-23,
  -4.461249708221315e-25,  1.754298392467855e-01, -1.392388020964408e-03,  1.105139472993450e-05, -8.771500733842200e-08,  6.961947066770838e-10, -5.525702890671431e-12,
   4.385754752676263e-14, -3.480977014358734e-16,  2.762854208163995e-18, -2.192879569079999e-20,  1.740490240122605e-22, -1.381341458212410e-24,  };
-  constexpr double w[1152] = {  8.415079282350717e-01, -4.434506447476264e-02,  2.651658347560889e-03, -1.543373592882430e-04,  8.451059587317178e-06,
+  static constexpr double w[1152] = {  8.415079282350717e-01, -4.434506447476264e-02,  2.651658347560889e-03, -1.543373592882430e-04,  8.451059587317178e-06,
  -4.368360283177318e-07,  2.134392984422344e-08, -9.881021190964115e-10,  4.393508610769244e-11, -1.880346639941242e-12,  7.723123299114189e-14, -3.053092913667579e-15,
   5.148136078628335e-01, -9.048699873900845e-02,  1.160437656742711e-02, -1.159187110487530e-03,  9.674918630166984e-05, -6.984743592730345e-06,  4.458391608886033e-07,
  -2.553804413998085e-08,  1.326749937060782e-09, -6.306859122288812e-11,  2.763989509867213e-12, -1.122506522392878e-13,  1.890404551225362e-01, -6.318988211997251e-02,
@@ -363,52 +362,5 @@ void ERIRootList::eriroot3(const double* ta, double* rr, double* ww, const int n
   4.294937738060408e-11, -3.068007540937389e-13,  2.232157513485930e-15, -1.645118132704395e-17,  1.224123607653399e-19, -9.176109318174950e-22,  6.918931939189582e-24,
  -5.241641710777890e-26,  1.141509135493495e-03, -4.530119189632737e-06,  2.696676465146090e-08, -1.783630876166750e-10,  1.238711557373305e-12, -8.848501726557420e-15,
   6.437809995094648e-17, -4.744718011187238e-19,  3.530519307128173e-21, -2.646499989216545e-23,  1.995502971596638e-25, -1.511752397611969e-27,  };
-  int offset = -3;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 3;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 3, 0.5);
-      fill_n(ww+offset, 3, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 3; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=3; ++j) {
-        const int boxof = it*36+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(3, 1, ax, aw, x, w, ta, rr, ww, n);
 }
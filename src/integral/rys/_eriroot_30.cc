@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,17 +31,17 @@ using namespace bagel;
 
 void ERIRootList::eriroot30(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[30] = {2.039219377523641e-02,1.836123050370817e-01,5.104942191359663e-01,1.001927927452841e+00,1.659265178006093e+00,
+  static constexpr double ax[30] = {2.039219377523641e-02,1.836123050370817e-01,5.104942191359663e-01,1.001927927452841e+00,1.659265178006093e+00,
     2.484340277790551e+00,3.479499028142790e+00,4.647636927026094e+00,5.992248202365616e+00,7.517487792929006e+00,9.228249121765884e+00,1.113026149035258e+01,
     1.323021227607870e+01,1.553590101922874e+01,1.805643521479969e+01,2.080248162057934e+01,2.378659287819636e+01,2.702363843538688e+01,3.053138327336318e+01,
     3.433128160556164e+01,3.844959271751057e+01,4.291899667402598e+01,4.778101844655198e+01,5.308982661003707e+01,5.891851874619501e+01,6.537027557479708e+01,
     7.260010092544880e+01,8.086322181567139e+01,9.064760682696567e+01,1.032075006758217e+02};
-  constexpr double aw[30] = {2.798531175228286e-01,2.378689049586587e-01,1.717761569188846e-01,1.052987636977852e-01,5.471897093218286e-02,
+  static constexpr double aw[30] = {2.798531175228286e-01,2.378689049586587e-01,1.717761569188846e-01,1.052987636977852e-01,5.471897093218286e-02,
     2.406127276610964e-02,8.932178360307843e-03,2.791324828953048e-03,7.317735569655050e-04,1.602773346818449e-04,2.918741904155569e-05,4.394286936267073e-06,
     5.433516134204974e-07,5.475554619276744e-08,4.456822775225963e-09,2.899359012807761e-10,1.488957349062788e-11,5.948430516056168e-13,1.816624576259683e-14,
     4.152444109693820e-16,6.923247909577666e-18,8.153640473024067e-20,6.512567257496230e-22,3.345756955752609e-24,1.029405997165105e-26,1.715573147671849e-29,
     1.332559611764192e-32,3.771626727120554e-36,2.439747588145120e-40,1.109587247968322e-45};
-  constexpr double x[11520] = {  1.325962532681286e-03, -1.086146296693472e-05,  6.668316501892944e-08, -3.635943483739178e-10,  1.856555592920640e-12,
+  static constexpr double x[11520] = {  1.325962532681286e-03, -1.086146296693472e-05,  6.668316501892944e-08, -3.635943483739178e-10,  1.856555592920640e-12,
  -9.088621401280543e-15,  4.318921066382197e-17, -2.006881930254230e-19,  9.160971347007441e-22, -4.120702981761218e-24,  1.830285551684701e-26, -8.039215959518773e-29,
   1.191324433708726e-02, -9.707734025402471e-05,  5.897656897104480e-07, -3.159404124636112e-09,  1.570469356914364e-11, -7.398737939840205e-14,  3.335571408403331e-16,
  -1.444484583789420e-18,  6.007646223263538e-21, -2.390310151536357e-23,  9.017562317232521e-26, -3.168466830384452e-28,  3.297910853447907e-02, -2.659345586518591e-04,
@@ -1689,7 +1688,7 @@ void ERIRootList::eriroot30(const double* ta, double* rr, double* ww, const int
   5.737585159035590e-24, -1.400607579090672e-24,  1.986404959971767e+00, -2.294881515860486e-04, -2.858355523305996e-06, -3.097201628715912e-08, -3.060324137256023e-10,
  -2.801035284496068e-12, -2.377118131608563e-14, -1.848931716850375e-16, -1.276273144356067e-18, -7.146741708643233e-21, -2.117510589020075e-23,  1.958080281291657e-25,
   };
-  constexpr double w[11520] = {  1.029025267046880e-01, -4.544684831573169e-04,  2.135273977325504e-06, -1.046885617843379e-08,  5.261680290093145e-11,
+  static constexpr double w[11520] = {  1.029025267046880e-01, -4.544684831573169e-04,  2.135273977325504e-06, -1.046885617843379e-08,  5.261680290093145e-11,
  -2.676272340682671e-13,  1.366263779582665e-15, -6.967755845672489e-18,  3.540818716156698e-20, -1.790835151111668e-22,  9.010359355239102e-25, -4.509528399182888e-27,
   1.021038551219453e-01, -7.102696978595553e-04,  5.700708851765153e-06, -4.486623007420780e-08,  3.385185820574527e-10, -2.460087285404680e-12,  1.733467853145158e-14,
  -1.190466994087405e-16,  7.998089317359906e-19, -5.271567915327181e-21,  3.416009824751203e-23, -2.180010064118179e-25,  1.005325777609573e-01, -1.207507230264758e-03,
@@ -3336,52 +3335,5 @@ void ERIRootList::eriroot30(const double* ta, double* rr, double* ww, const int
   1.228008405942729e-38, -5.092847050155732e-40,  1.430316718209970e-29, -6.105341610335709e-30,  1.395036850330896e-30, -2.166665564599304e-31,  2.546266367057709e-32,
  -2.406346547554554e-33,  1.901830318347396e-34, -1.291826398407065e-35,  7.694632193557529e-37, -4.081482303854467e-38,  1.951585516448672e-39, -8.482986065990789e-41,
   };
-  int offset = -30;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 30;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 30, 0.5);
-      fill_n(ww+offset, 30, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 30; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=30; ++j) {
-        const int boxof = it*360+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(30, 1, ax, aw, x, w, ta, rr, ww, n);
 }
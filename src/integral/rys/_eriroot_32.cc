@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,17 +31,17 @@ using namespace bagel;
 
 void ERIRootList::eriroot32(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[32] = {1.912751096844681e-02,1.722157241453954e-01,4.787564772774879e-01,9.394832145007335e-01,1.555508231478936e+00,
+  static constexpr double ax[32] = {1.912751096844681e-02,1.722157241453954e-01,4.787564772774879e-01,9.394832145007335e-01,1.555508231478936e+00,
     2.328337668210397e+00,3.259892256456943e+00,4.352534529330142e+00,5.609103457496148e+00,7.032957798283900e+00,8.628029857405931e+00,1.039889190555262e+01,
     1.235083821771476e+01,1.448998669078027e+01,1.682340536295370e+01,1.935927108726876e+01,2.210707038220600e+01,2.507785654419803e+01,2.828458319497047e+01,
     3.174254379061666e+01,3.546996139617324e+01,3.948879712336818e+01,4.382588636990388e+01,4.851458386741599e+01,5.359723182614860e+01,5.912902793439174e+01,
     6.518442637613580e+01,7.186849935955155e+01,7.933908652882313e+01,8.785611994313348e+01,9.791671642606245e+01,1.107992689470757e+02};
-  constexpr double aw[32] = {2.713774249413026e-01,2.329947860626777e-01,1.716858423490840e-01,1.084983493061871e-01,5.873998196409935e-02,
+  static constexpr double aw[32] = {2.713774249413026e-01,2.329947860626777e-01,1.716858423490840e-01,1.084983493061871e-01,5.873998196409935e-02,
     2.720312895368893e-02,1.075604050987915e-02,3.622586978534457e-03,1.036329099507577e-03,2.509836985130608e-04,5.125929135786279e-05,8.788499230850367e-06,
     1.258340251031190e-06,1.495532936727246e-07,1.465125316476094e-08,1.173616742321534e-09,7.615217250145460e-11,3.959177766947724e-12,1.628340730709826e-13,
     5.218623726590694e-15,1.280093391322481e-16,2.351884710675810e-18,3.152254566503851e-20,2.982862784279876e-22,1.911706883300574e-24,7.861797788926411e-27,
     1.929103595464950e-29,2.549660899112834e-32,1.557390624629720e-35,3.421138011256267e-39,1.679747990108173e-43,5.535706535856872e-49};
-  constexpr double x[12288] = {  1.167813462640008e-03, -8.978019385235082e-06,  5.173601091605041e-08, -2.648030004505717e-10,  1.269405021392980e-12,
+  static constexpr double x[12288] = {  1.167813462640008e-03, -8.978019385235082e-06,  5.173601091605041e-08, -2.648030004505717e-10,  1.269405021392980e-12,
  -5.835058172145710e-15,  2.604108168884081e-17, -1.136674592684661e-19,  4.875228890583071e-22, -2.061043023851998e-24,  8.606710936748330e-27, -3.555446262555106e-29,
   1.049445112170177e-02, -8.030942810620415e-05,  4.585178715213314e-07, -2.310633330810880e-09,  1.081823399115808e-11, -4.808343170378255e-14,  2.049458573123094e-16,
  -8.414508670315632e-19,  3.330702848015635e-21, -1.268281383535203e-23,  4.619047188819734e-26, -1.590689462693390e-28,  2.906322413327617e-02, -2.203635249981727e-04,
@@ -1798,7 +1797,7 @@ void ERIRootList::eriroot32(const double* ta, double* rr, double* ww, const int
  -1.936312001293074e-12, -3.601894415967397e-15,  5.937586029998652e-17,  9.413868372382301e-19,  8.352278321761395e-21,  4.871586726172793e-23,  9.766430054666063e-26,
   1.989464120499304e+00, -1.572461925174864e-04, -1.739607888969362e-06, -1.684502700069412e-08, -1.499545441371524e-10, -1.250297574703548e-12, -9.822339229791717e-15,
  -7.254845382875351e-17, -4.984045969092107e-19, -3.104261352893489e-21, -1.644228295085991e-23, -5.870105185858452e-26,  };
-  constexpr double w[12288] = {  9.658121525564139e-02, -3.985964204607261e-04,  1.744961070475971e-06, -7.962360390123817e-09,  3.725011000352792e-11,
+  static constexpr double w[12288] = {  9.658121525564139e-02, -3.985964204607261e-04,  1.744961070475971e-06, -7.962360390123817e-09,  3.725011000352792e-11,
  -1.764792502406116e-13,  8.398872026356534e-16, -3.996110138319957e-18,  1.895780930509703e-20, -8.955848583622127e-23,  4.210580892060379e-25, -1.969826803577066e-27,
   9.591980347425187e-02, -6.110280834138857e-04,  4.504646850122998e-06, -3.274375072406957e-08,  2.288102896769343e-10, -1.542315429141962e-12,  1.009031036185971e-14,
  -6.439054745665624e-17,  4.022628127541391e-19, -2.466902488388525e-21,  1.488206045891749e-23, -8.846222960648285e-26,  9.461606997079115e-02, -1.025353338108072e-03,
@@ -3554,52 +3553,5 @@ void ERIRootList::eriroot32(const double* ta, double* rr, double* ww, const int
  -1.154000759190169e-32,  8.777754836383984e-34, -5.747994319371278e-35,  3.306033964044021e-36, -1.695970013580999e-37,  7.854319740974188e-39, -3.311562007689925e-40,
   1.013740182336422e-29, -4.363107294720098e-30,  1.005889075396415e-30, -1.575976288030318e-31,  1.867665374715695e-32, -1.779183534914989e-33,  1.416881229103029e-34,
  -9.694018276885164e-36,  5.813976921470794e-37, -3.104174227461841e-38,  1.493566072734357e-39, -6.530729370422616e-41,  };
-  int offset = -32;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 32;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 32, 0.5);
-      fill_n(ww+offset, 32, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 32; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=32; ++j) {
-        const int boxof = it*384+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(32, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,19 +31,19 @@ using namespace bagel;
 
 void ERIRootList::eriroot33(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[33] = {1.855222618056198e-02,1.670321941188209e-01,4.643244925475531e-01,9.110979560398486e-01,1.508366233501695e+00,
+  static constexpr double ax[33] = {1.855222618056198e-02,1.670321941188209e-01,4.643244925475531e-01,9.110979560398486e-01,1.508366233501695e+00,
     2.257500616913155e+00,3.160247754575606e+00,4.218752814451578e+00,5.435588864603597e+00,6.813793487276037e+00,8.356913959982837e+00,1.006906274759950e+01,
     1.195498559144905e+01,1.402014520885833e+01,1.627082460919169e+01,1.871425540902916e+01,2.135877847180310e+01,2.421404698949139e+01,2.729128621874753e+01,
     3.060363022289268e+01,3.416656540478311e+01,3.799852551994479e+01,4.212170716337780e+01,4.656321582263151e+01,5.135672509620531e+01,5.654496614935641e+01,
     6.218362931592237e+01,6.834782121814082e+01,7.514352697150539e+01,8.272995836692951e+01,9.136932782071482e+01,1.015631899531887e+02,1.146016551280458e+02
     };
-  constexpr double aw[33] = {2.674182693914649e-01,2.306479519911901e-01,1.715235179844312e-01,1.099070531338047e-01,6.062045914959792e-02,
+  static constexpr double aw[33] = {2.674182693914649e-01,2.306479519911901e-01,1.715235179844312e-01,1.099070531338047e-01,6.062045914959792e-02,
     2.874185509873280e-02,1.169394485127456e-02,4.074134947858974e-03,1.212359660023294e-03,3.072156112196417e-04,6.606113021988665e-05,1.200527834425012e-05,
     1.835197922109159e-06,2.347099657371962e-07,2.495859186183891e-08,2.191009567643582e-09,1.574798821673825e-10,9.179567058508876e-12,4.291642055815669e-13,
     1.588553267628721e-14,4.584863443711685e-16,1.013236235241152e-17,1.677515186381405e-19,2.025903860076360e-21,1.726654820633059e-23,9.959264561605881e-26,
     3.681349235478935e-28,8.103684036750887e-31,9.581157150898418e-34,5.213309240720354e-37,1.013560915043634e-40,4.356574890965814e-45,1.228776879713511e-50
     };
-  constexpr double x[12672] = {  1.099144062344638e-03, -8.198129980245287e-06,  4.583479802665874e-08, -2.276212185937735e-10,  1.058771995132634e-12,
+  static constexpr double x[12672] = {  1.099144062344638e-03, -8.198129980245287e-06,  4.583479802665874e-08, -2.276212185937735e-10,  1.058771995132634e-12,
  -4.722690774973654e-15,  2.045412054332527e-17, -8.665150250334849e-20,  3.607447434565098e-22, -1.480506001548603e-24,  6.002591085090272e-27, -2.407921754268054e-29,
   9.878225169354542e-03, -7.335939563803956e-05,  4.065834014962050e-07, -1.989806574577067e-09,  9.052335898564596e-12, -3.912265260471289e-14,  1.622896510981707e-16,
  -6.492436243826585e-19,  2.507990734904774e-21, -9.340679013939495e-24,  3.338343495096877e-26, -1.134349527160025e-28,  2.736145569677046e-02, -2.014374169822094e-04,
@@ -1855,7 +1854,7 @@ void ERIRootList::eriroot33(const double* ta, double* rr, double* ww, const int
  -4.965780011413799e-15,  1.896379620509908e-17,  4.779678675144767e-19,  4.826955717337254e-21,  3.344607771801191e-23,  1.449809267294073e-25,  1.990622392251553e+00,
  -1.322455483527405e-04, -1.384642052469915e-06, -1.271681384464795e-08, -1.076729992384393e-10, -8.570663445427105e-13, -6.460759507354993e-15, -4.613125248587002e-17,
  -3.100426192955329e-19, -1.931088639666194e-21, -1.076236564855963e-23, -4.882324686852969e-26,  };
-  constexpr double w[12672] = {  9.370289772471747e-02, -3.744403548723544e-04,  1.585024452783533e-06, -6.989568145749841e-09,  3.160113307873448e-11,
+  static constexpr double w[12672] = {  9.370289772471747e-02, -3.744403548723544e-04,  1.585024452783533e-06, -6.989568145749841e-09,  3.160113307873448e-11,
  -1.447321545240400e-13,  6.661212428630931e-16, -3.066099222979898e-18,  1.407621437810248e-20, -6.436665222204380e-23,  2.929808787440554e-25, -1.327207616938276e-27,
   9.309843472265703e-02, -5.688254005423968e-04,  4.027150661491769e-06, -2.818399525289786e-08,  1.898744514837169e-10, -1.234779557666069e-12,  7.797421895589683e-15,
  -4.804646439213860e-17,  2.899225570083475e-19, -1.717834821704989e-21,  1.001525547723247e-23, -5.754790130690257e-26,  9.190595955338177e-02, -9.485075303785982e-04,
@@ -3666,52 +3665,5 @@ void ERIRootList::eriroot33(const double* ta, double* rr, double* ww, const int
   7.022346091808665e-34, -4.635937441645284e-35,  2.686940221729123e-36, -1.388410394865261e-37,  6.474239605428017e-39, -2.747445528461814e-40,  8.722153707606089e-30,
  -3.765746843878720e-30,  8.711348367958876e-31, -1.369440272437970e-31,  1.628170915071065e-32, -1.555864581135794e-33,  1.242729940404246e-34, -8.526745699143181e-36,
   5.127850678922456e-37, -2.744984938000199e-38,  1.324043181754696e-39, -5.803300780498078e-41,  };
-  int offset = -33;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 33;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 33, 0.5);
-      fill_n(ww+offset, 33, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 33; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=33; ++j) {
-        const int boxof = it*396+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(33, 1, ax, aw, x, w, ta, rr, ww, n);
 }
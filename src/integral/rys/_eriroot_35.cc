@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,19 +31,19 @@ using namespace bagel;
 
 void ERIRootList::eriroot35(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[35] = {1.749958242808220e-02,1.575484042859406e-01,4.379248825101927e-01,8.591897511576237e-01,1.422191855664142e+00,
+  static constexpr double ax[35] = {1.749958242808220e-02,1.575484042859406e-01,4.379248825101927e-01,8.591897511576237e-01,1.422191855664142e+00,
     2.128077678990523e+00,2.978304443737644e+00,3.974657159383102e+00,5.119270110765249e+00,6.414653438173411e+00,7.863725651125991e+00,9.469853160927341e+00,
     1.123689823037098e+01,1.316927714908235e+01,1.527203098782228e+01,1.755091201939778e+01,2.001248989832001e+01,2.266428308692950e+01,2.551492298714163e+01,
     2.857436107256040e+01,3.185413347588226e+01,3.536770372552119e+01,3.913091391474387e+01,4.316258973977563e+01,4.748536955673771e+01,5.212686940447470e+01,
     5.712136968778990e+01,6.251234600798013e+01,6.835643606745100e+01,7.473000587570237e+01,8.174080775359022e+01,8.955071509834151e+01,9.842636942882824e+01,
     1.088779508236660e+02,1.222183478887410e+02};
-  constexpr double aw[35] = {2.599931062031600e-01,2.261284438373461e-01,1.710101529360384e-01,1.123881650198194e-01,6.413364098536906e-02,
+  static constexpr double aw[35] = {2.599931062031600e-01,2.261284438373461e-01,1.710101529360384e-01,1.123881650198194e-01,6.413364098536906e-02,
     3.174127819005061e-02,1.360532756061864e-02,5.041636747637913e-03,1.611735395355833e-03,4.433999966333339e-04,1.046699428500667e-04,2.113123326730634e-05,
     3.634490404718271e-06,5.302485633505246e-07,6.529293418948361e-08,6.747331288132626e-09,5.813734448427968e-10,4.145791033248680e-11,2.425962302235481e-12,
     1.153495256018320e-13,4.406117539795009e-15,1.334243468124816e-16,3.153321059872526e-18,5.709512432304647e-20,7.745473674517019e-22,7.661592397261393e-24,
     5.343021620962718e-26,2.517269378501885e-28,7.579831860430619e-31,1.353842810777554e-33,1.291378802533876e-36,5.621622224396045e-40,8.632811368706500e-44,
     2.868816891233346e-48,5.985609246693381e-54};
-  constexpr double x[13440] = {  9.788014554498177e-04, -6.889644201801367e-06,  3.635344917614209e-08, -1.703982979997241e-10,  7.481709575808662e-13,
+  static constexpr double x[13440] = {  9.788014554498177e-04, -6.889644201801367e-06,  3.635344917614209e-08, -1.703982979997241e-10,  7.481709575808662e-13,
  -3.150545879754670e-15,  1.288359063304725e-17, -5.154221957870396e-20,  2.026748165218917e-22, -7.858056016205990e-25,  3.010604244780962e-27, -1.141525326719528e-29,
   8.798035619779212e-03, -6.168926060346429e-05,  3.229873262785214e-07, -1.494333161413318e-09,  6.432987417642506e-12, -2.634042558421065e-14,  1.036808791127966e-16,
  -3.943598514838237e-19,  1.452216237009922e-21, -5.174592063675769e-24,  1.778718139976302e-26, -5.861220814213943e-29,  2.437697342626468e-02, -1.696054190072637e-04,
@@ -1965,7 +1964,7 @@ void ERIRootList::eriroot35(const double* ta, double* rr, double* ww, const int
   9.372917576587157e-20,  1.381910757701341e-21,  1.176121976108124e-23,  7.411329657155185e-26,  1.992433929096272e+00, -9.605953688255811e-05, -9.076642690574186e-07,
  -7.547028317665420e-09, -5.808931352905931e-11, -4.225747134267016e-13, -2.931814106942252e-15, -1.945651947752212e-17, -1.233170404203779e-19, -7.417928583219392e-22,
  -4.177940518369535e-24, -2.141278797627961e-26,  };
-  constexpr double w[13440] = {  8.843164921144533e-02, -3.322679351798259e-04,  1.319145852258457e-06, -5.449817071116689e-09,  2.308332322810035e-11,
+  static constexpr double w[13440] = {  8.843164921144533e-02, -3.322679351798259e-04,  1.319145852258457e-06, -5.449817071116689e-09,  2.308332322810035e-11,
  -9.909444530010226e-14,  4.277850963841704e-16, -1.848143999723799e-18,  7.968240729436222e-21, -3.423487214730246e-23,  1.464682693050645e-25, -6.238413081610476e-28,
   8.792289530538626e-02, -4.962475809982721e-04,  3.251882879109601e-06, -2.116689333454370e-08,  1.329703064435082e-10, -8.074265384153446e-13,  4.765161411647583e-15,
  -2.746025865717421e-17,  1.550607948847126e-19, -8.602194697141871e-22,  4.697924298357113e-24, -2.529767847603363e-26,  8.691775870484607e-02, -8.173633701841819e-04,
@@ -3886,52 +3885,5 @@ void ERIRootList::eriroot35(const double* ta, double* rr, double* ww, const int
   1.870626339907155e-36, -9.778438197315268e-38,  4.610131216909789e-39, -1.976879420237493e-40,  6.673237286990326e-30, -2.895343396735832e-30,  6.734076354828644e-31,
  -1.064283777618493e-31,  1.271940722062003e-32, -1.221545992731918e-33,  9.803982778669973e-35, -6.757951406641600e-36,  4.082200834959005e-37, -2.194578094603444e-38,
   1.062903465985381e-39, -4.677079001939348e-41,  };
-  int offset = -35;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 35;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 35, 0.5);
-      fill_n(ww+offset, 35, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 35; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=35; ++j) {
-        const int boxof = it*420+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(35, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,19 +31,19 @@ using namespace bagel;
 
 void ERIRootList::eriroot36(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[36] = {1.701682030786294e-02,1.531993443541016e-01,4.258207394435934e-01,8.353963631572779e-01,1.382705977968209e+00,
+  static constexpr double ax[36] = {1.701682030786294e-02,1.531993443541016e-01,4.258207394435934e-01,8.353963631572779e-01,1.382705977968209e+00,
     2.068802013658777e+00,2.895020911958181e+00,3.862997854545114e+00,4.974685277546449e+00,6.232375698446639e+00,7.638729532506021e+00,9.196808765492420e+00,
     1.091011759151622e+01,1.278265143803660e+01,1.481895621137477e+01,1.702420014340631e+01,1.940426135867573e+01,2.196583529224571e+01,2.471656749400496e+01,
     2.766521934111706e+01,3.082187703740853e+01,3.419821847086066e+01,3.780785878836020e+01,4.166680521232595e+01,4.579406689835668e+01,5.021249054596233e+01,
     5.494993461162085e+01,6.004096932514831e+01,6.552942763185496e+01,7.147240386350147e+01,7.794687302909200e+01,8.506144411451777e+01,9.297928299344353e+01,
     1.019691843478137e+02,1.125455238418826e+02,1.260322711180887e+02};
-  constexpr double aw[36] = {2.565050262603475e-01,2.239528539567135e-01,1.706741212270929e-01,1.134768369502365e-01,6.577177108772145e-02,
+  static constexpr double aw[36] = {2.565050262603475e-01,2.239528539567135e-01,1.706741212270929e-01,1.134768369502365e-01,6.577177108772145e-02,
     3.319797174509760e-02,1.457296656606504e-02,5.554499781136583e-03,1.834687915559234e-03,5.239781182130335e-04,1.290485370032876e-04,2.732528526822099e-05,
     4.957249020873694e-06,7.674727375189976e-07,1.009431516889197e-07,1.122175891149605e-08,1.048308842089190e-09,8.174958986801377e-11,5.281614965927222e-12,
     2.802669328967043e-13,1.209409465038828e-14,4.195302407355946e-16,1.154266755648343e-17,2.479396376616585e-19,4.080813569324274e-21,5.031977590646028e-23,
     4.522938813265549e-25,2.864454299009973e-27,1.224405814762339e-29,3.340299656230092e-32,5.394480517090200e-35,4.639214221043844e-38,1.813239398249085e-41,
     2.484322377845049e-45,7.288876060071841e-50,1.314020063575881e-55};
-  constexpr double x[13824] = {  9.259098430971102e-04, -6.338954268099771e-06,  3.253304691002131e-08, -1.483260964424024e-10,  6.334984476976308e-13,
+  static constexpr double x[13824] = {  9.259098430971102e-04, -6.338954268099771e-06,  3.253304691002131e-08, -1.483260964424024e-10,  6.334984476976308e-13,
  -2.595050152504610e-15,  1.032379262776963e-17, -4.018269450360870e-20,  1.537393858844583e-22, -5.800297611321348e-25,  2.162640470397383e-27, -7.981107583509379e-30,
   8.323178778222218e-03, -5.677406296859716e-05,  2.892451178683120e-07, -1.302590554549916e-09,  5.460525712160138e-12, -2.178387157360828e-14,  8.359709404768460e-17,
  -3.102662257045011e-19,  1.116101466398748e-21, -3.890698322443030e-24,  1.311156602703818e-26, -4.249268140330924e-29,  2.306440138094074e-02, -1.561781060377036e-04,
@@ -2020,7 +2019,7 @@ void ERIRootList::eriroot36(const double* ta, double* rr, double* ww, const int
   6.903147067727966e-22,  6.496383106387443e-24,  4.457279332540335e-26,  1.993149594300423e+00, -8.282881229596286e-05, -7.460271123698241e-07, -5.919852607513360e-09,
  -4.355092282587391e-11, -3.033976746997078e-13, -2.020879695891303e-15, -1.291857122599686e-17, -7.924015234824862e-20, -4.645297950751722e-22, -2.579363190770752e-24,
  -1.332293239194363e-26,  };
-  constexpr double w[13824] = {  8.601219706481898e-02, -3.138005274928349e-04,  1.208247149503499e-06, -4.838487358655930e-09,  1.986432801037984e-11,
+  static constexpr double w[13824] = {  8.601219706481898e-02, -3.138005274928349e-04,  1.208247149503499e-06, -4.838487358655930e-09,  1.986432801037984e-11,
  -8.267408578605809e-14,  3.461197585140237e-16, -1.450613298890146e-18,  6.068915808778118e-21, -2.530738662797991e-23,  1.051068440442633e-25, -4.346450467364567e-28,
   8.554378781504247e-02, -4.649327527677540e-04,  2.936072798598366e-06, -1.845932781591411e-08,  1.121444443314038e-10, -6.589844368550836e-13,  3.765152515727601e-15,
  -2.101283518446117e-17,  1.149418962917386e-19, -6.178590653239378e-22,  3.270294067327298e-24, -1.707068204671262e-26,  8.461776023054551e-02, -7.612242217454324e-04,
@@ -3996,52 +3995,5 @@ void ERIRootList::eriroot36(const double* ta, double* rr, double* ww, const int
  -8.375672855685991e-38,  3.966327165735458e-39, -1.707999417422422e-40,  5.916418599692611e-30, -2.572023986724875e-30,  5.995067234291946e-31, -9.495335163280613e-32,
   1.137189414137987e-32, -1.094358656632585e-33,  8.800470698199103e-35, -6.077735436051165e-36,  3.678029416346763e-37, -1.980787319537023e-38,  9.609918256237742e-40,
  -4.235570626062832e-41,  };
-  int offset = -36;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 36;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 36, 0.5);
-      fill_n(ww+offset, 36, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 36; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=36; ++j) {
-        const int boxof = it*432+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(36, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,19 +31,19 @@ using namespace bagel;
 
 void ERIRootList::eriroot37(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[37] = {1.655997946274130e-02,1.490840151837081e-01,4.143683016504360e-01,8.128875925516243e-01,1.345359882948675e+00,
+  static constexpr double ax[37] = {1.655997946274130e-02,1.490840151837081e-01,4.143683016504360e-01,8.128875925516243e-01,1.345359882948675e+00,
     2.012753604351883e+00,2.816297488373125e+00,3.757493346088624e+00,4.838132092738009e+00,6.060313445881383e+00,7.426469845335770e+00,8.939395292626559e+00,
     1.060227999640221e+01,1.241875195203916e+01,1.439292689759376e+01,1.652946850117982e+01,1.883366118508870e+01,2.131149873507376e+01,2.396979286105532e+01,
     2.681630729082503e+01,2.985992497878047e+01,3.311085889016670e+01,3.658092104547190e+01,4.028387084589512e+01,4.423587344119896e+01,4.845611429518804e+01,
     5.296764121319868e+01,5.779854756745025e+01,6.298368540192268e+01,6.856723612980355e+01,7.460674041940034e+01,8.117976965763060e+01,8.839577291261112e+01,
     9.641918476190364e+01,1.055209147624170e+02,1.162194608436121e+02,1.298496805268988e+02};
-  constexpr double aw[37] = {2.531535801616495e-01,2.218313079154654e-01,1.702937255822022e-01,1.144740498862206e-01,6.733468872828437e-02,
+  static constexpr double aw[37] = {2.531535801616495e-01,2.218313079154654e-01,1.702937255822022e-01,1.144740498862206e-01,6.733468872828437e-02,
     3.462398613371497e-02,1.554506744609088e-02,6.084696208937837e-03,2.072740531869709e-03,6.132067059485523e-04,1.571729634858562e-04,3.480610375550448e-05,
     6.638454061426746e-06,1.086555082832821e-06,1.519986077632926e-07,1.808944154744511e-08,1.821950937683603e-09,1.543825612781230e-10,1.093159052133599e-11,
     6.418857138048059e-13,3.098188619564303e-14,1.216890058133903e-15,3.844343085546422e-17,9.636567816848030e-19,1.886372778227056e-20,2.829601860304904e-22,
     3.179499828670935e-24,2.603304950305458e-26,1.500897322805704e-28,5.834567530416297e-31,1.445502443700035e-33,2.115682212372438e-36,1.644241467794919e-39,
     5.783615262462852e-43,7.086972183663917e-47,1.840430346388145e-51,2.875027572792207e-57};
-  constexpr double x[14208] = {  8.771922152876884e-04, -5.845418948192864e-06,  2.920151431349345e-08, -1.295968790002941e-10,  5.388111225038518e-13,
+  static constexpr double x[14208] = {  8.771922152876884e-04, -5.845418948192864e-06,  2.920151431349345e-08, -1.295968790002941e-10,  5.388111225038518e-13,
  -2.148680329179673e-15,  8.321955423333099e-18, -3.153652979951116e-20,  1.174847920095721e-22, -4.316239465942218e-25,  1.567257001594431e-27, -5.633350934502826e-30,
   7.885739226861336e-03, -5.236706264572075e-05,  2.597911807761383e-07, -1.139580530189390e-09,  4.654969009821622e-12, -1.810391753035376e-14,  6.777163160159664e-17,
  -2.455528211906544e-19,  8.631775818843514e-22, -2.944326347365442e-24,  9.726943193439467e-27, -3.098716408009964e-29,  2.185494294693359e-02, -1.441283966561805e-04,
@@ -2075,7 +2074,7 @@ void ERIRootList::eriroot37(const double* ta, double* rr, double* ww, const int
   3.479522996062468e-24,  2.559686478700765e-26,  1.993768635986598e+00, -7.191075541264857e-05, -6.186469931855524e-07, -4.693626518525968e-09, -3.305640020066237e-11,
  -2.208143108305507e-13, -1.413189574100497e-15, -8.703235789489285e-18, -5.161747354143523e-20, -2.941172383168496e-22, -1.600315645930430e-24, -8.215260904773807e-27,
   };
-  constexpr double w[14208] = {  8.372152836843015e-02, -2.968286955433387e-04,  1.109402771903882e-06, -4.310176748370014e-09,  1.716674551311504e-11,
+  static constexpr double w[14208] = {  8.372152836843015e-02, -2.968286955433387e-04,  1.109402771903882e-06, -4.310176748370014e-09,  1.716674551311504e-11,
  -6.932654065537256e-14,  2.817087611075364e-16, -1.146298276448894e-18,  4.657387454312406e-21, -1.886504290956534e-23,  7.611975289432560e-26, -3.058577426991582e-28,
   8.328931111315717e-02, -4.364194296870723e-04,  2.658726514271770e-06, -1.616079687243204e-08,  9.503624842989322e-11, -5.409152652833072e-13,  2.994725691972886e-15,
  -1.620004023508829e-17,  8.591771319715043e-20, -4.478879115031417e-22,  2.299507059015667e-24, -1.164532352776345e-26,  8.243432318686006e-02, -7.103690097049174e-04,
@@ -4106,52 +4105,5 @@ void ERIRootList::eriroot37(const double* ta, double* rr, double* ww, const int
   3.449321080187616e-39, -1.490869171160909e-40,  5.284812220806605e-30, -2.301387813605307e-30,  5.374436318661164e-31, -8.528482151378641e-32,  1.023288330264791e-32,
  -9.865176988788509e-34,  7.947051449648806e-35, -5.497583320892571e-36,  3.332350932436273e-37, -1.797443844866290e-38,  8.733664680685299e-40, -3.855002005721792e-41,
   };
-  int offset = -37;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 37;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 37, 0.5);
-      fill_n(ww+offset, 37, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 37; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=37; ++j) {
-        const int boxof = it*444+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(37, 1, ax, aw, x, w, ta, rr, ww, n);
 }
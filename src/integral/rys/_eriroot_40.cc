@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,21 +31,21 @@ using namespace bagel;
 
 void ERIRootList::eriroot40(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[40] = {1.532566333150724e-02,1.379660017410287e-01,3.834338413928863e-01,7.521050835315969e-01,1.244547551113196e+00,
+  static constexpr double ax[40] = {1.532566333150724e-02,1.379660017410287e-01,3.834338413928863e-01,7.521050835315969e-01,1.244547551113196e+00,
     1.861525845317158e+00,2.604007976597420e+00,3.473173911352792e+00,4.470426220642336e+00,5.597403070341604e+00,6.855993855270501e+00,8.248357856369756e+00,
     9.776946394184975e+00,1.144452906931765e+01,1.325422482860261e+01,1.520953878471803e+01,1.731440596067107e+01,1.957324344853186e+01,2.199101289125942e+01,
     2.457329575657723e+01,2.732638462934105e+01,3.025739478733612e+01,3.337440177041390e+01,3.668661269614475e+01,4.020458201618327e+01,4.394048672461555e+01,
     4.790848250650809e+01,5.212517227328459e+01,5.661023427257749e+01,6.138728263943344e+01,6.648507669810708e+01,7.193927199441563e+01,7.779504829211943e+01,
     8.411123004209786e+01,9.096710928165746e+01,9.847456447306584e+01,1.068017050462992e+02,1.162255725808030e+02,1.272766232323530e+02,1.413213000323780e+02
     };
-  constexpr double aw[40] = {2.438358538072127e-01,2.157749462743306e-01,1.689379692759015e-01,1.169807338042997e-01,7.160074769184323e-02,
+  static constexpr double aw[40] = {2.438358538072127e-01,2.157749462743306e-01,1.689379692759015e-01,1.169807338042997e-01,7.160074769184323e-02,
     3.870859991483797e-02,1.846575115442782e-02,7.764039405399679e-03,2.873197533089709e-03,9.343176869611799e-04,2.664778866933501e-04,6.651741241815240e-05,
     1.449644419112967e-05,2.750724627401225e-06,4.530535565861284e-07,6.454462950119771e-08,7.922923289150186e-09,8.343055926086519e-10,7.499719914657961e-11,
     5.723279718501904e-12,3.684849820159061e-13,1.987520834698484e-14,8.909461040666795e-16,3.289162014364627e-17,9.896528989619841e-19,2.397840275617894e-20,
     4.613471074553798e-22,6.934119819528937e-24,7.985187198172654e-26,6.883457043633996e-28,4.317817343022007e-30,1.902990610032016e-32,5.637192779477887e-35,
     1.059514692827928e-37,1.169207699819791e-40,6.792433016154473e-44,1.764205704338837e-47,1.567156493775333e-51,2.862184585732656e-56,2.955774603297982e-62
     };
-  constexpr double x[15360] = {  7.520637480269354e-04, -4.640645665053360e-06,  2.146833645343528e-08, -8.823748052175707e-11,  3.397864457199843e-13,
+  static constexpr double x[15360] = {  7.520637480269354e-04, -4.640645665053360e-06,  2.146833645343528e-08, -8.823748052175707e-11,  3.397864457199843e-13,
  -1.255180670972599e-15,  4.503901553531340e-18, -1.581539150924483e-20,  5.460526077028441e-23, -1.859687033016193e-25,  6.261275518521060e-28, -2.087360301892404e-30,
   6.761952041738006e-03, -4.160105708964155e-05,  1.913071291867909e-07, -7.784702253688065e-10,  2.952769088809497e-12, -1.067664199757103e-14,  3.721568939535535e-17,
  -1.257981732888275e-19,  4.135667040919875e-22, -1.323543967693355e-24,  4.120238584655877e-27, -1.244539142775437e-29,  1.874645138004542e-02, -1.146473906185071e-04,
@@ -2241,7 +2240,7 @@ void ERIRootList::eriroot40(const double* ta, double* rr, double* ww, const int
  -1.475089826157295e-15, -5.730092056497521e-18, -1.606828265661320e-20, -9.446831958527307e-25,  4.282888769655377e-25,  4.166544619268165e-27,  1.995195655117597e+00,
  -4.875880615076047e-05, -3.695164595397844e-07, -2.475018532402775e-09, -1.543125774941837e-11, -9.156772638373429e-14, -5.228236330576259e-16, -2.888377469754537e-18,
  -1.547744309731002e-20, -8.046162523436699e-23, -4.050832295533247e-25, -1.966719793999248e-27,  };
-  constexpr double w[15360] = {  7.752705267573286e-02, -2.534137294754843e-04,  8.704741649558953e-07, -3.103417682645463e-09,  1.133990966340630e-11,
+  static constexpr double w[15360] = {  7.752705267573286e-02, -2.534137294754843e-04,  8.704741649558953e-07, -3.103417682645463e-09,  1.133990966340630e-11,
  -4.203502530048043e-14,  1.569064861021942e-16, -5.869716629549832e-19,  2.194096922612237e-21, -8.181438044286415e-24,  3.040498608935787e-26, -1.125693360667038e-28,
   7.718333154162280e-02, -3.647127890611929e-04,  2.006265043944457e-06, -1.107815656077442e-08,  5.938617767590113e-11, -3.086839295159401e-13,  1.562546290094926e-15,
  -7.735044477264056e-18,  3.756817945755180e-20, -1.794650363176910e-22,  8.448360767083052e-25, -3.925085571584852e-27,  7.650235431466899e-02, -5.837247908415225e-04,
@@ -4436,52 +4435,5 @@ void ERIRootList::eriroot40(const double* ta, double* rr, double* ww, const int
   2.295312256190472e-34, -1.565667787651330e-35,  9.361998354321391e-37, -4.983753432114527e-38,  2.390940889467822e-39, -1.042472943167409e-40,  3.907214995576327e-30,
  -1.708359997546058e-30,  4.007493959464167e-31, -6.388033041790077e-32,  7.698605669316939e-33, -7.453980062737266e-34,  6.029836338177207e-35, -4.188261808405613e-36,
   2.548721875619808e-37, -1.380020242948234e-38,  6.730316502258867e-40, -2.981399762606597e-41,  };
-  int offset = -40;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 40;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 40, 0.5);
-      fill_n(ww+offset, 40, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 40; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=40; ++j) {
-        const int boxof = it*480+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(40, 1, ax, aw, x, w, ta, rr, ww, n);
 }
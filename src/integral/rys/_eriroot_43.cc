@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,21 +31,21 @@ using namespace bagel;
 
 void ERIRootList::eriroot43(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[43] = {1.426258777782621e-02,1.283915237081303e-01,3.568002033807567e-01,6.997913412113433e-01,1.157821775192210e+00,
+  static constexpr double ax[43] = {1.426258777782621e-02,1.283915237081303e-01,3.568002033807567e-01,6.997913412113433e-01,1.157821775192210e+00,
     1.731505841456103e+00,2.421619967150520e+00,3.229108565674753e+00,4.155091344523005e+00,5.200872166021917e+00,6.367949636363226e+00,7.658029640022649e+00,
     9.073040086841704e+00,1.061514820019272e+01,1.228678074995874e+01,1.409064772776473e+01,1.602977007962204e+01,1.810751226047194e+01,2.032762056634084e+01,
     2.269426844714387e+01,2.521211032635819e+01,2.788634588071833e+01,3.072279730365451e+01,3.372800284827631e+01,3.690933100466788e+01,4.027512114018172e+01,
     4.383485851612566e+01,4.759939459548447e+01,5.158122796253278e+01,5.579486778684822e+01,6.025731193114589e+01,6.498868787506589e+01,7.001313085081209e+01,
     7.536001795590981e+01,8.106575532568164e+01,8.717646077656829e+01,9.375217070623445e+01,1.008738075119675e+02,1.086555578806382e+02,1.172690294356232e+02,
     1.269971077732338e+02,1.383816515706110e+02,1.528192203308403e+02};
-  constexpr double aw[43] = {2.354761530400102e-01,2.101477122383245e-01,1.673459142985755e-01,1.188742415350856e-01,7.529144666132209e-02,
+  static constexpr double aw[43] = {2.354761530400102e-01,2.101477122383245e-01,1.673459142985755e-01,1.188742415350856e-01,7.529144666132209e-02,
     4.249363723989420e-02,2.135442231953533e-02,9.546194547879545e-03,3.792002394490030e-03,1.336721046210252e-03,4.175427354854966e-04,1.153755734390231e-04,
     2.814808395266499e-05,6.050232141409069e-06,1.142978302485967e-06,1.892689346408208e-07,2.739018738039680e-08,3.452519916383315e-09,3.776504323563274e-10,
     3.569931854671538e-11,2.902972807299139e-12,2.020235351444652e-13,1.196279387759704e-14,5.988574617048902e-16,2.515979389219083e-17,8.798325007697671e-19,
     2.537044116717297e-20,5.968046428770866e-22,1.131225287180773e-23,1.703162410675256e-25,2.002938790748378e-27,1.803696413432014e-29,1.214548767136704e-31,
     5.941043927414663e-34,2.036854118874406e-36,4.677768845419749e-39,6.784808497979015e-42,5.742116416618364e-45,2.536583356400502e-48,4.949857686869416e-52,
     3.245015342920119e-56,4.247738285372129e-61,2.962904515147007e-67};
-  constexpr double x[16512] = {  6.519167249251522e-04, -3.745441272445724e-06,  1.613362694299856e-08, -6.174815797865894e-11,  2.214372019354118e-13,
+  static constexpr double x[16512] = {  6.519167249251522e-04, -3.745441272445724e-06,  1.613362694299856e-08, -6.174815797865894e-11,  2.214372019354118e-13,
  -7.618466983648579e-16,  2.546351098509868e-18, -8.329827645687222e-21,  2.679688543462093e-23, -8.504694593369975e-26,  2.668918370633010e-28, -8.295032354066725e-31,
   5.862266484323309e-03, -3.359356520099631e-05,  1.439582174692016e-07, -5.462155160075992e-10,  1.933332287158811e-12, -6.529626097981379e-15,  2.128520887633950e-17,
  -6.738594435506514e-20,  2.078695511794800e-22, -6.256954021027813e-25,  1.837708746703487e-27, -5.259365963700324e-30,  1.625640978688441e-02, -9.267687084262684e-05,
@@ -2406,7 +2405,7 @@ void ERIRootList::eriroot43(const double* ta, double* rr, double* ww, const int
  -2.351665230075343e-23,  2.081247406513929e-27,  5.325773237643295e-28,  1.996183917868514e+00, -3.455157009610743e-05, -2.338550434657240e-07, -1.400876623335018e-09,
  -7.825220343426049e-12, -4.169211766185226e-14, -2.143080777170528e-16, -1.069386308050086e-18, -5.197122250398497e-21, -2.463356416685788e-23, -1.138675658696043e-25,
  -5.125599829894205e-28,  };
-  constexpr double w[16512] = {  7.218567281902774e-02, -2.188612894972682e-04,  6.953792037798706e-07, -2.289846170232396e-09,  7.725704362475621e-12,
+  static constexpr double w[16512] = {  7.218567281902774e-02, -2.188612894972682e-04,  6.953792037798706e-07, -2.289846170232396e-09,  7.725704362475621e-12,
  -2.645181298627928e-14,  9.126017015142256e-17, -3.157608592268133e-19,  1.092394107238100e-21, -3.772040480039224e-24,  1.298717340485783e-26, -4.456331452949312e-29,
   7.190785771144186e-02, -3.090186544869631e-04,  1.546722522124852e-06, -7.812851083844009e-09,  3.843675703589410e-11, -1.836726493297038e-13,  8.556491585132425e-16,
  -3.901218688205679e-18,  1.746291198796861e-20, -7.692812616589292e-23,  3.341265728489503e-25, -1.432934232588827e-27,  7.135677144698878e-02, -4.868095894117139e-04,
@@ -4766,52 +4765,5 @@ void ERIRootList::eriroot43(const double* ta, double* rr, double* ww, const int
  -3.645640949344450e-38,  1.760364123796225e-39, -7.723386340275558e-41,  3.014641375795854e-30, -1.321932353816510e-30,  3.111117916309906e-31, -4.975491847142362e-32,
   6.015706683862083e-33, -5.843044701384150e-34,  4.741330834483536e-35, -3.303229424282846e-36,  2.016063015504483e-37, -1.094740112822141e-38,  5.353933941831287e-40,
  -2.378127955118267e-41,  };
-  int offset = -43;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 43;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 43, 0.5);
-      fill_n(ww+offset, 43, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 43; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=43; ++j) {
-        const int boxof = it*516+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(43, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,7 +31,7 @@ using namespace bagel;
 
 void ERIRootList::eriroot47(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[47] = {1.305515013125343e-02,1.175180025752869e-01,3.265593280368458e-01,6.404110729936394e-01,1.059422930904129e+00,
+  static constexpr double ax[47] = {1.305515013125343e-02,1.175180025752869e-01,3.265593280368458e-01,6.404110729936394e-01,1.059422930904129e+00,
     1.584064500142716e+00,2.214928211181823e+00,2.952733067582333e+00,3.798329258784967e+00,4.752703717801292e+00,5.816986714180142e+00,6.992459592672030e+00,
     8.280563791571433e+00,9.682911302704166e+00,1.120129676860915e+01,1.283771145312411e+01,1.459435937123215e+01,1.647367592514004e+01,1.847834946939599e+01,
     2.061134632270739e+01,2.287593986374059e+01,2.527574450030938e+01,2.781475549654652e+01,3.049739589543077e+01,3.332857210467152e+01,3.631374015101746e+01,
@@ -40,7 +39,7 @@ void ERIRootList::eriroot47(const double* ta, double* rr, double* ww, const int
     6.665768169372780e+01,7.142323736942693e+01,7.645893917399606e+01,8.178956284611218e+01,8.744525018712591e+01,9.346334201875047e+01,9.989113009426819e+01,
     1.067901735806911e+02,1.142434497130025e+02,1.223680610067415e+02,1.313400409943002e+02,1.414496758849499e+02,1.532532691757077e+02,1.681855266899249e+02
     };
-  constexpr double aw[47] = {2.255595142545266e-01,2.032420488894175e-01,1.649941365520042e-01,1.206496106072594e-01,7.943921517210567e-02,
+  static constexpr double aw[47] = {2.255595142545266e-01,2.032420488894175e-01,1.649941365520042e-01,1.206496106072594e-01,7.943921517210567e-02,
     4.707528821179732e-02,2.509253201516196e-02,1.202207095066536e-02,5.172859200829822e-03,1.996976286940151e-03,6.909053409296403e-04,2.139513219971487e-04,
     5.921620546142635e-05,1.462514745736820e-05,3.217512378236771e-06,6.292772352983083e-07,1.091730772425100e-07,1.676066012388592e-08,2.270963504317804e-09,
     2.707662235924643e-10,2.831612790978552e-11,2.588042390934693e-12,2.059142599411916e-13,1.419954809596533e-14,8.445465399310963e-16,4.309089409252813e-17,
@@ -48,7 +47,7 @@ void ERIRootList::eriroot47(const double* ta, double* rr, double* ww, const int
     3.193603995328041e-30,2.774926548053356e-32,1.844063569752035e-34,9.146355819266344e-37,3.286828103995520e-39,8.249169834951546e-42,1.380291946286455e-44,
     1.449562336634452e-47,8.809113969446201e-51,2.763116491256896e-54,3.769132436919883e-58,1.687960399559856e-62,1.453890194705030e-67,6.187316729259933e-74
     };
-  constexpr double x[18048] = {  5.467511021237293e-04, -2.876859366954057e-06,  1.134981492953782e-08, -3.978795271221758e-11,  1.307034783129944e-13,
+  static constexpr double x[18048] = {  5.467511021237293e-04, -2.876859366954057e-06,  1.134981492953782e-08, -3.978795271221758e-11,  1.307034783129944e-13,
  -4.119632245224067e-16,  1.261586874891134e-18, -3.781850026583832e-21,  1.115044394053330e-23, -3.244028307963330e-26,  9.333989307661844e-29, -2.660445124027756e-31,
   4.917247423175959e-03, -2.581728830387726e-05,  1.014131008104515e-07, -3.529396165164045e-10,  1.146765874300654e-12, -3.558983788844206e-15,  1.067386590616553e-17,
  -3.113686869048336e-20,  8.866774201574975e-23, -2.469528259204516e-25,  6.731139592536547e-28, -1.794704243378801e-30,  1.363952189723162e-02, -7.130249000567684e-05,
@@ -2627,7 +2626,7 @@ void ERIRootList::eriroot47(const double* ta, double* rr, double* ww, const int
  -2.847399568220364e-16, -1.078835233902259e-18, -3.749184494642025e-21, -1.146614615243658e-23, -2.730970654372247e-26, -2.192882516921769e-29,  1.997089787024559e+00,
  -2.303052837260420e-05, -1.363679451049055e-07, -7.155129793269352e-10, -3.506052833404263e-12, -1.641631205301755e-14, -7.432258565941722e-17, -3.275197255045287e-19,
  -1.410251040975960e-21, -5.946060665578924e-24, -2.457294445674164e-26, -9.953757266281675e-29,  };
-  constexpr double w[18048] = {  6.611199734704135e-02, -1.827808339464814e-04,  5.278285910382121e-07, -1.576917595695845e-09,  4.824501282383287e-12,
+  static constexpr double w[18048] = {  6.611199734704135e-02, -1.827808339464814e-04,  5.278285910382121e-07, -1.576917595695845e-09,  4.824501282383287e-12,
  -1.498350413574845e-14,  4.692275281346493e-17, -1.474860086971515e-19,  4.638662320091613e-22, -1.457133760663297e-24,  4.566575123127105e-27, -1.426947248003276e-29,
   6.589826704350721e-02, -2.523131032213969e-04,  1.124878271742986e-06, -5.092716897909727e-09,  2.254565597756018e-11, -9.715706666700591e-14,  4.087041169655313e-16,
  -1.684253417534452e-18,  6.819508246094553e-21, -2.719212745032130e-23,  1.069677580018514e-25, -4.157109862773525e-28,  6.547374860986856e-02, -3.897411175858421e-04,
@@ -5206,52 +5205,5 @@ void ERIRootList::eriroot47(const double* ta, double* rr, double* ww, const int
   1.138633550312815e-34, -7.875864095465004e-36,  4.773340179618514e-37, -2.574366110382319e-38,  1.250702421527169e-39, -5.519820093656416e-41,  2.238664120988080e-30,
  -9.844168449813287e-31,  2.324113186455808e-31, -3.728769102274541e-32,  4.522638148195451e-33, -4.406535080327395e-34,  3.586613269710501e-35, -2.506232924697931e-36,
   1.534112046182266e-37, -8.354230092487985e-39,  4.097165169320203e-40, -1.824864029906199e-41,  };
-  int offset = -47;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 47;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 47, 0.5);
-      fill_n(ww+offset, 47, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 47; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=47; ++j) {
-        const int boxof = it*564+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(47, 1, ax, aw, x, w, ta, rr, ww, n);
 }
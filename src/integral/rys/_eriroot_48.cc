@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,7 +31,7 @@ using namespace bagel;
 
 void ERIRootList::eriroot48(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[48] = {1.278457233711677e-02,1.150814835883784e-01,3.197838782794324e-01,6.271095358567564e-01,1.037386722154059e+00,
+  static constexpr double ax[48] = {1.278457233711677e-02,1.150814835883784e-01,3.197838782794324e-01,6.271095358567564e-01,1.037386722154059e+00,
     1.551056130796248e+00,2.168673514794828e+00,2.890913046694420e+00,3.718571457109681e+00,4.652573014347396e+00,5.693975422442692e+00,6.843976731833512e+00,
     8.103923376645341e+00,9.475319475891899e+00,1.095983756373465e+01,1.255933094744859e+01,1.427584793239958e+01,1.611164820306394e+01,1.806922171040873e+01,
     2.015131049206163e+01,2.236093394696520e+01,2.470141820639561e+01,2.717643039612807e+01,2.979001878075745e+01,3.254666003534945e+01,3.545131522209265e+01,
@@ -40,7 +39,7 @@ void ERIRootList::eriroot48(const double* ta, double* rr, double* ww, const int
     6.484071625728610e+01,6.942851158904251e+01,7.426601568870360e+01,7.937403318479174e+01,8.477749189328024e+01,9.050671591661330e+01,9.659926966194310e+01,
     1.031027264892598e+02,1.100790116733375e+02,1.176115973344115e+02,1.258182891223084e+02,1.348761887561338e+02,1.450773694312892e+02,1.569816231036405e+02,
     1.720328667451659e+02};
-  constexpr double aw[48] = {2.232700234975347e-01,2.016130134792332e-01,1.643796305984981e-01,1.209831168625153e-01,8.035395008064218e-02,
+  static constexpr double aw[48] = {2.232700234975347e-01,2.016130134792332e-01,1.643796305984981e-01,1.209831168625153e-01,8.035395008064218e-02,
     4.813990673108975e-02,2.600034027124422e-02,1.265137511280014e-02,5.541631289439057e-03,2.183131976096716e-03,7.726958216816570e-04,2.454180927305260e-04,
     6.985432444541545e-05,1.779180591822015e-05,4.048233178777142e-06,8.213544547832802e-07,1.482969405004983e-07,2.377366214757480e-08,3.375584731127748e-09,
     4.233593783511151e-10,4.676010385985022e-11,4.533303374583738e-12,3.843681724876702e-13,2.838767395169384e-14,1.818169130493162e-15,1.004905149157448e-16,
@@ -48,7 +47,7 @@ void ERIRootList::eriroot48(const double* ta, double* rr, double* ww, const int
     1.919970706794752e-29,1.989546894269612e-31,1.608873207938431e-33,9.946800059221377e-36,4.587401665857948e-38,1.531798964711274e-40,3.568938561780834e-43,
     5.537064819782368e-46,5.383222506970748e-49,3.022293931502664e-52,8.733732835917374e-56,1.093382473751864e-59,4.468702421681184e-64,3.480841387717738e-69,
     1.315337147701315e-75};
-  constexpr double x[18432] = {  5.244387063139485e-04, -2.702591090876076e-06,  1.044268109326164e-08, -3.585441629954200e-11,  1.153597038786709e-13,
+  static constexpr double x[18432] = {  5.244387063139485e-04, -2.702591090876076e-06,  1.044268109326164e-08, -3.585441629954200e-11,  1.153597038786709e-13,
  -3.561319791575014e-16,  1.068234524892018e-18, -3.136632785003688e-21,  9.058917438579652e-24, -2.581725946128817e-26,  7.277006020748978e-29, -2.031984233048707e-31,
   4.716715293408959e-03, -2.425621686919572e-05,  9.333506724673027e-08, -3.182350026681900e-10,  1.013196526194819e-12, -3.081828715036118e-15,  9.061085488115897e-18,
  -2.592064299789048e-20,  7.241275291609930e-23, -1.979459377606847e-25,  5.298596630870050e-28, -1.388462131702539e-30,  1.308403886689045e-02, -6.700678810605272e-05,
@@ -2682,7 +2681,7 @@ void ERIRootList::eriroot48(const double* ta, double* rr, double* ww, const int
  -8.517651891795715e-19, -2.938906994531304e-21, -9.090773775997504e-24, -2.317272039692960e-26, -3.341866869640416e-29,  1.997265821547645e+00, -2.097619266697437e-05,
  -1.204287434003869e-07, -6.128124609764453e-10, -2.913007604821459e-12, -1.323605443218721e-14, -5.817538861024362e-17, -2.490010481259114e-19, -1.041972362580104e-21,
  -4.272555349399880e-24, -1.718636773151114e-26, -6.783345934325050e-29,  };
-  constexpr double w[18432] = {  6.474992797897361e-02, -1.751545278250026e-04,  4.945268529876320e-07, -1.443868713638180e-09,  4.316517857950237e-12,
+  static constexpr double w[18432] = {  6.474992797897361e-02, -1.751545278250026e-04,  4.945268529876320e-07, -1.443868713638180e-09,  4.316517857950237e-12,
  -1.310024536429339e-14,  4.009575951707571e-17, -1.231946480987671e-19,  3.788221065685845e-22, -1.163618204970220e-24,  3.566376954403747e-27, -1.089977844460235e-29,
   6.454907364267129e-02, -2.405338079209657e-04,  1.043461349378794e-06, -4.603302349408848e-09,  1.987656688031714e-11, -8.358647628604560e-14,  3.432329417211307e-16,
  -1.381024928369615e-18,  5.460577437674060e-21, -2.126606352708637e-23,  8.171751664449290e-26, -3.102607371335908e-28,  6.415001911986308e-02, -3.698155737187582e-04,
@@ -5316,52 +5315,5 @@ void ERIRootList::eriroot48(const double* ta, double* rr, double* ww, const int
  -7.270361346289983e-36,  4.412023554801977e-37, -2.382471763893159e-38,  1.158879336792351e-39, -5.120585925228957e-41,  2.092417270729122e-30, -9.206287791738575e-31,
   2.174909176014556e-31, -3.491660958735918e-32,  4.237788288661877e-33, -4.131631041973487e-34,  3.364968360750964e-35, -2.352799607943975e-36,  1.441061475693827e-37,
  -7.852150930490630e-39,  3.853162984403972e-40, -1.717158578088405e-41,  };
-  int offset = -48;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 48;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 48, 0.5);
-      fill_n(ww+offset, 48, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 48; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=48; ++j) {
-        const int boxof = it*576+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(48, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,7 +31,7 @@ using namespace bagel;
 
 void ERIRootList::eriroot49(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[49] = {1.252498275336912e-02,1.127439634746335e-01,3.132840103182815e-01,6.143498671308711e-01,1.016250090077344e+00,
+  static constexpr double ax[49] = {1.252498275336912e-02,1.127439634746335e-01,3.132840103182815e-01,6.143498671308711e-01,1.016250090077344e+00,
     1.519398798105510e+00,2.124318044139960e+00,2.831640840132535e+00,3.642114878943241e+00,4.556607007007854e+00,5.576108514194526e+00,6.701741321551700e+00,
     7.934765164280741e+00,9.276585886813690e+00,1.072876499007044e+01,1.229303059872703e+01,1.397129004981336e+01,1.576564434466372e+01,1.767840475609137e+01,
     1.971211194415016e+01,2.186955801026534e+01,2.415381201520954e+01,2.656824960717427e+01,2.911658755986999e+01,3.180292421786316e+01,3.463178710191168e+01,
@@ -40,7 +39,7 @@ void ERIRootList::eriroot49(const double* ta, double* rr, double* ww, const int
     6.313570000018330e+01,6.756151760892536e+01,7.221960841783434e+01,7.712766928685110e+01,8.230663166776230e+01,8.778157261780036e+01,9.358299538268564e+01,
     9.974868433207851e+01,1.063264901285885e+02,1.133786988279350e+02,1.209892705139735e+02,1.292767044240934e+02,1.384191562500957e+02,1.487104626593072e+02,
     1.607138582999204e+02,1.758823498831879e+02};
-  constexpr double aw[49] = {2.210488382772323e-01,2.000203503447396e-01,1.637578107296366e-01,1.212783844396225e-01,8.122414932703971e-02,
+  static constexpr double aw[49] = {2.210488382772323e-01,2.000203503447396e-01,1.637578107296366e-01,1.212783844396225e-01,8.122414932703971e-02,
     4.917321790564288e-02,2.689605026021618e-02,1.328286216996388e-02,5.918552360985582e-03,2.377310922221486e-03,8.599544844304291e-04,2.798336444627272e-04,
     8.181180069055645e-05,2.145937790443935e-05,5.042314887726511e-06,1.059520014394322e-06,1.987157227190031e-07,3.319657223217434e-08,4.928284075350579e-09,
     6.485515200581754e-10,7.544596901897571e-11,7.734776903096704e-12,6.965065881420261e-13,5.488670354937545e-14,3.769713169605182e-15,2.246461695281105e-16,
@@ -48,7 +47,7 @@ void ERIRootList::eriroot49(const double* ta, double* rr, double* ww, const int
     1.033518299989048e-28,1.257502779892585e-30,1.214736916927656e-32,9.154814171674804e-35,5.272805188722617e-37,2.264237394060745e-39,7.034647443887613e-42,
     1.523554920090092e-44,2.194572489761186e-47,1.977790194675830e-50,1.027180426413359e-53,2.738329786124213e-57,3.150504845494649e-61,1.176773685663440e-65,
     8.302078221246393e-71,2.790452511867978e-77};
-  constexpr double x[18816] = {  5.034647466839481e-04, -2.542117918356894e-06,  9.624384939967254e-09, -3.237838395174360e-11,  1.020765062622235e-13,
+  static constexpr double x[18816] = {  5.034647466839481e-04, -2.542117918356894e-06,  9.624384939967254e-09, -3.237838395174360e-11,  1.020765062622235e-13,
  -3.087811827279703e-16,  9.075809084351108e-19, -2.611400748515524e-21,  7.390795592695413e-24, -2.064170888109112e-26,  5.701987830197023e-29, -1.560455189526798e-31,
   4.528201846620745e-03, -2.281844920084828e-05,  8.604501908346864e-08, -2.875421744139239e-10,  8.974083201950995e-13, -2.676295784838829e-15,  7.716854322235320e-18,
  -2.165547016860057e-20,  5.936812856696620e-23, -1.593275618904194e-25,  4.189357795404431e-28, -1.079105588986780e-30,  1.256178994767941e-02, -6.304889065815446e-05,
@@ -2737,7 +2736,7 @@ void ERIRootList::eriroot49(const double* ta, double* rr, double* ww, const int
  -2.305389282778559e-21, -7.162018803825110e-24, -1.903679591567479e-26, -3.492935023915445e-29,  1.997426368025983e+00, -1.915881034191338e-05, -1.067483474397412e-07,
  -5.272722969690334e-10, -2.433513945286388e-12, -1.073908027059776e-14, -4.585865354900290e-17, -1.907846737899695e-19, -7.763923544616661e-22, -3.097862346043076e-24,
  -1.213476299631843e-26, -4.668348156635147e-29,  };
-  constexpr double w[18816] = {  6.344282951268558e-02, -1.679953048206630e-04,  4.639633094692903e-07, -1.324520861813877e-09,  3.871162286403559e-12,
+  static constexpr double w[18816] = {  6.344282951268558e-02, -1.679953048206630e-04,  4.639633094692903e-07, -1.324520861813877e-09,  3.871162286403559e-12,
  -1.148637348592557e-14,  3.437618320981948e-17, -1.032952827617871e-19,  3.106892621809219e-22, -9.336170531889348e-25,  2.799680438625916e-27, -8.372754323262569e-30,
   6.325383771569196e-02, -2.295455838340484e-04,  9.695287913911517e-07, -4.170009303659093e-09,  1.757085246172615e-11, -7.214269887222062e-14,  2.893229574824865e-16,
  -1.137172719237925e-18,  4.393083533853619e-21, -1.671817190283450e-23,  6.278350739792815e-26, -2.329908318258202e-28,  6.287825341312621e-02, -3.513107405127893e-04,
@@ -5426,52 +5425,5 @@ void ERIRootList::eriroot49(const double* ta, double* rr, double* ww, const int
   4.091488438149759e-37, -2.211917950156094e-38,  1.077119040915294e-39, -4.764473061944422e-41,  1.960304603630141e-30, -8.629544386298437e-31,  2.039870533235932e-31,
  -3.276845866933894e-32,  3.979460059755804e-33, -3.882074969847188e-34,  3.163564235171460e-35, -2.213244478211205e-36,  1.356347997321430e-37, -7.394636440448088e-39,
   3.630618159997171e-40, -1.618838191866085e-41,  };
-  int offset = -49;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 49;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 49, 0.5);
-      fill_n(ww+offset, 49, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 49; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=49; ++j) {
-        const int boxof = it*588+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(49, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void ERIRootList::eriroot5(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[5] = {1.175813202117782e-01,1.074562012436904e+00,3.085937443717551e+00,6.414729733662032e+00,1.180718948997173e+01
+  static constexpr double ax[5] = {1.175813202117782e-01,1.074562012436904e+00,3.085937443717551e+00,6.414729733662032e+00,1.180718948997173e+01
     };
-  constexpr double aw[5] = {6.108626337353256e-01,2.401386110823146e-01,3.387439445548104e-02,1.343645746781236e-03,7.640432855232646e-06
+  static constexpr double aw[5] = {6.108626337353256e-01,2.401386110823146e-01,3.387439445548104e-02,1.343645746781236e-03,7.640432855232646e-06
     };
-  constexpr double x[1920] = {  4.058358437870611e-02, -1.810678466366126e-03,  5.936951645218651e-05, -1.684476592591675e-06,  4.312953239145675e-08,
+  static constexpr double x[1920] = {  4.058358437870611e-02, -1.810678466366126e-03,  5.936951645218651e-05, -1.684476592591675e-06,  4.312953239145675e-08,
  -1.007349208066596e-09,  2.118072581995054e-11, -3.860556235070740e-13,  5.278150623010092e-15, -1.882544570761491e-17, -2.223259728516612e-18,  1.207841045011638e-19,
   3.484811057708894e-01, -1.328418381772604e-02,  3.033269445756231e-04, -3.552795480592078e-06, -4.534461376700926e-08,  3.371801960725916e-09, -7.442873513890367e-11,
  -6.547940389986966e-15,  5.463917502775690e-14, -1.812753752790780e-15,  1.655795260954178e-17,  1.003809627892172e-18,  8.764106730908152e-01, -2.328598228461027e-02,
@@ -310,7 +309,7 @@ void ERIRootList::eriroot5(const double* ta, double* rr, double* ww, const int n
   5.091706985464273e-14, -4.041291776245057e-16,  3.207576044471410e-18, -2.545853650293342e-20,  2.020637842436722e-22, -1.603650310344900e-24,  3.748786411854312e-01,
  -2.975414738696289e-03,  2.361589030320558e-05, -1.874395080317779e-07,  1.487708857004518e-09, -1.180795695502667e-11,  9.371984741191759e-14, -7.438551525918514e-16,
   5.903983329290623e-18, -4.685992096093620e-20,  3.719258507496097e-22, -2.951728596415393e-24,  };
-  constexpr double w[1920] = {  5.556471639830202e-01, -1.707743567554543e-02,  6.010297533195059e-04, -2.141050577561195e-05,  7.411885932341078e-07,
+  static constexpr double w[1920] = {  5.556471639830202e-01, -1.707743567554543e-02,  6.010297533195059e-04, -2.141050577561195e-05,  7.411885932341078e-07,
  -2.477415246769695e-08,  8.000210532424675e-10, -2.505045109383974e-11,  7.617657068347102e-13, -2.257919159670135e-14,  6.522815734076673e-16, -1.832784545034155e-17,
   4.490360159053517e-01, -4.133350951223668e-02,  3.197563458385448e-03, -2.054437774592271e-04,  1.157734416333559e-05, -5.885694466689300e-07,  2.745674027615711e-08,
  -1.188816881791059e-09,  4.816612998847584e-11, -1.837202228959463e-12,  6.628083240048359e-14, -2.267663929128982e-15,  3.020000558977205e-01, -5.983961037079307e-02,
@@ -585,52 +584,5 @@ void ERIRootList::eriroot5(const double* ta, double* rr, double* ww, const int n
   1.909518267242844e-17, -1.407331154737591e-19,  1.047191465062962e-21, -7.849990721222062e-24,  5.919733918273290e-26, -4.487300262315514e-28,  1.925299079979168e-06,
  -7.640617176687169e-09,  4.548284858994723e-11, -3.008318355448097e-13,  2.089243222777508e-15, -1.492411403795182e-17,  1.085817997802414e-19, -8.002575616153480e-22,
   5.954721082374492e-24, -4.463913033358954e-26,  3.366741954199881e-28, -2.553820468689320e-30,  };
-  int offset = -5;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 5;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 5, 0.5);
-      fill_n(ww+offset, 5, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 5; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=5; ++j) {
-        const int boxof = it*60+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(5, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -23,8 +23,7 @@
 // the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -32,7 +31,7 @@ using namespace bagel;
 
 void ERIRootList::eriroot50(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[50] = {1.227572534584943e-02,1.104995276849810e-01,3.070432377239684e-01,6.020995843347335e-01,9.959589629609481e-01,
+  static constexpr double ax[50] = {1.227572534584943e-02,1.104995276849810e-01,3.070432377239684e-01,6.020995843347335e-01,9.959589629609481e-01,
     1.489011017270010e+00,2.081746780329551e+00,2.774761404004785e+00,3.568757513748134e+00,4.464549235369023e+00,5.463066950997876e+00,6.565362853611610e+00,
     7.772617383554726e+00,9.086146646940419e+00,1.050741093523498e+01,1.203802448844218e+01,1.367976667203497e+01,1.543459477129267e+01,1.730465864749188e+01,
     1.929231755040027e+01,2.140015944324129e+01,2.363102327305128e+01,2.598802471548128e+01,2.847458604447447e+01,3.109447093172170e+01,3.385182517911479e+01,
@@ -40,7 +39,7 @@ void ERIRootList::eriroot50(const double* ta, double* rr, double* ww, const int
     6.153119728068543e+01,6.580855643746800e+01,7.030314278262583e+01,7.503017761677704e+01,8.000746519453865e+01,8.525606133593571e+01,9.080118966333674e+01,
     9.667352957294236e+01,1.029110819489893e+02,1.095619706447716e+02,1.166888373905969e+02,1.243761235796182e+02,1.327430128374924e+02,1.419687011082473e+02,
     1.523487658067936e+02,1.644498400149637e+02,1.797339027478397e+02};
-  constexpr double aw[50] = {2.188926295874399e-01,1.984628502541860e-01,1.631300305027832e-01,1.215379868441046e-01,8.205182739122448e-02,
+  static constexpr double aw[50] = {2.188926295874399e-01,1.984628502541860e-01,1.631300305027832e-01,1.215379868441046e-01,8.205182739122448e-02,
     5.017581267742848e-02,2.777912738593345e-02,1.391566522023190e-02,6.303000285608035e-03,2.579273260059096e-03,9.526921885486120e-04,3.172919710433074e-04,
     9.517162778550828e-05,2.567615938454918e-05,6.221524817777905e-06,1.351797159110391e-06,2.629097483753724e-07,4.568127508484856e-08,7.075857283889764e-09,
     9.747921253871742e-10,1.191300634929084e-10,1.287903825731522e-11,1.227878514410092e-12,1.028874937350992e-13,7.548896877915489e-15,4.829835321703164e-16,
@@ -48,7 +47,7 @@ void ERIRootList::eriroot50(const double* ta, double* rr, double* ww, const int
     5.037791166213254e-28,7.101812226385031e-30,8.067434278709596e-32,7.274572596887510e-34,5.116232604385560e-36,2.748784884356988e-38,1.100470682714277e-40,
     3.185217877835713e-43,6.420725205349163e-46,8.597563954826037e-49,7.191529463464289e-52,3.459477936476291e-55,8.518883081761946e-59,9.019222303694199e-63,
     3.083028990003705e-67,1.972860574879405e-72,5.908067865031421e-79};
-  constexpr double x[19200] = {  4.837242770240790e-04, -2.394101458393913e-06,  8.884688620916540e-09, -2.929896910284767e-11,  9.054366606006879e-14,
+  static constexpr double x[19200] = {  4.837242770240790e-04, -2.394101458393913e-06,  8.884688620916540e-09, -2.929896910284767e-11,  9.054366606006879e-14,
  -2.684891342141428e-16,  7.735972511156270e-19, -2.182067901888464e-21,  6.054303731684645e-24, -1.657721544321097e-26,  4.489536505537981e-29, -1.204630909496350e-31,
   4.350765692804069e-03, -2.149205294619122e-05,  7.945255237344139e-08, -2.603308559160188e-10,  7.967499413813981e-13, -2.330531962949151e-15,  6.592481568047511e-18,
  -1.815444499811414e-20,  4.885619786487812e-23, -1.287609479055161e-25,  3.326487094701153e-28, -8.424100988992931e-31,  1.207017749965583e-02, -5.939627623312518e-05,
@@ -2792,7 +2791,7 @@ void ERIRootList::eriroot50(const double* ta, double* rr, double* ww, const int
  -5.623469600916152e-24, -1.533648122748484e-26, -3.203156151550814e-29,  1.997573189666590e+00, -1.754522346527641e-05, -9.495388616699227e-08, -4.556447551344365e-10,
  -2.043444391539059e-12, -8.764999534039958e-15, -3.639175370333998e-17, -1.472615074187144e-19, -5.831621052641900e-22, -2.265524258628583e-24, -8.646114535916254e-27,
  -3.243277421174475e-29,  };
-  constexpr double w[19200] = {  6.218744110310599e-02, -1.612658189081749e-04,  4.358626929424168e-07, -1.217219478912463e-09,  3.479636105559668e-12,
+  static constexpr double w[19200] = {  6.218744110310599e-02, -1.612658189081749e-04,  4.358626929424168e-07, -1.217219478912463e-09,  3.479636105559668e-12,
  -1.009888319133585e-14,  2.956666474409280e-17, -8.692604496420499e-20,  2.558531317038882e-22, -7.524740416545892e-25,  2.208735479937350e-27, -6.466385390237101e-30,
   6.200939615429494e-02, -2.192801217118969e-04,  9.022549397108891e-07, -3.785414677171466e-09,  1.557289982665915e-11, -6.245781030829301e-14,  2.447514225297103e-16,
  -9.401732588749116e-19,  3.550282272692212e-21, -1.320860456486174e-23,  4.850031032200594e-26, -1.760028463342531e-28,  6.165547948604001e-02, -3.340987903697785e-04,
@@ -5536,52 +5535,5 @@ void ERIRootList::eriroot50(const double* ta, double* rr, double* ww, const int
  -2.059613319466313e-38,  1.003983857777640e-39, -4.445404487607493e-41,  1.840536636795450e-30, -8.106262353283957e-31,  1.917235606260324e-31, -3.081578293822115e-32,
   3.744418967103268e-33, -3.654805512765575e-34,  2.979979924969262e-35, -2.085923465912121e-36,  1.278993327142963e-37, -6.976506469607985e-39,  3.427059716778682e-40,
  -1.528832036756302e-41,  };
-  int offset = -50;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 50;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 50, 0.5);
-      fill_n(ww+offset, 50, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 50; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=50; ++j) {
-        const int boxof = it*600+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(50, 1, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/erirootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void ERIRootList::eriroot7(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[7] = {8.511544299759415e-02,7.721379200427774e-01,2.180591888450458e+00,4.389792886731011e+00,7.554091326101782e+00,
+  static constexpr double ax[7] = {8.511544299759415e-02,7.721379200427774e-01,2.180591888450458e+00,4.389792886731011e+00,7.554091326101782e+00,
     1.198999303982387e+01,1.852827749585251e+01};
-  constexpr double aw[7] = {5.364059097120906e-01,2.731056090642467e-01,6.850553422346542e-02,7.850054726457971e-03,3.550926135519249e-04,
+  static constexpr double aw[7] = {5.364059097120906e-01,2.731056090642467e-01,6.850553422346542e-02,7.850054726457971e-03,3.550926135519249e-04,
     4.716484355018926e-06,8.628591168125084e-09};
-  constexpr double x[2688] = {  2.187235449243685e-02, -7.216449908844757e-04,  1.766322980898774e-05, -3.788598193822189e-07,  7.472865435056214e-09,
+  static constexpr double x[2688] = {  2.187235449243685e-02, -7.216449908844757e-04,  1.766322980898774e-05, -3.788598193822189e-07,  7.472865435056214e-09,
  -1.381072040123164e-10,  2.402904284587878e-12, -3.925318517977418e-14,  5.937257612886869e-16, -8.068773109352462e-18,  9.035027649788086e-20, -5.809925062741621e-22,
   1.917916231932218e-01, -5.816314014756365e-03,  1.187707192919499e-04, -1.791317024252973e-06,  1.643625989010003e-08,  7.390060250982390e-11, -7.100367954512990e-12,
   1.704941632551193e-13, -2.272358399805795e-15,  1.601474004149456e-18,  8.259441143270304e-19, -2.497754871034135e-20,  5.050466488132147e-01, -1.279423859250741e-02,
@@ -420,7 +419,7 @@ void ERIRootList::eriroot7(const double* ta, double* rr, double* ww, const int n
   5.993101946200996e-18, -4.748999134262410e-20,  3.741389978841693e-22, -2.879123456167680e-24,  5.882733987666567e-01, -4.669130616485231e-03,  3.705892659059861e-05,
  -2.941369902229406e-07,  2.334567321464840e-09, -1.852945687519475e-11,  1.470670372292606e-13, -1.167196946240989e-15,  9.260560362391869e-18, -7.335865322981485e-20,
   5.770705625197388e-22, -4.411124094889345e-24,  };
-  constexpr double w[2688] = {  4.125397897105281e-01, -8.775915291518570e-03,  2.125993707836983e-04, -5.309630852812400e-06,  1.310764936618184e-07,
+  static constexpr double w[2688] = {  4.125397897105281e-01, -8.775915291518570e-03,  2.125993707836983e-04, -5.309630852812400e-06,  1.310764936618184e-07,
  -3.162089900106441e-09,  7.440512041499163e-11, -1.710621198990803e-12,  3.849017915444706e-14, -8.493420932834433e-16,  1.840128523080625e-17, -3.918882324036007e-19,
   3.662103066131541e-01, -2.094515240235570e-02,  1.096740961093201e-03, -4.934749164344090e-05,  1.992870668618686e-06, -7.403456751818108e-08,  2.567732998169028e-09,
  -8.396991180205459e-11,  2.607582041283766e-12, -7.730266742319673e-14,  2.196678398422178e-15, -5.998741240062789e-17,  2.921270295484196e-01, -3.617674168787876e-02,
@@ -805,52 +804,5 @@ void ERIRootList::eriroot7(const double* ta, double* rr, double* ww, const int n
   3.748974399982793e-24, -3.055916026379188e-26,  3.176935494366977e-28, -5.183472604090657e-30,  2.174303334961637e-09, -8.628799336801262e-12,  5.136527280747257e-14,
  -3.397394565065319e-16,  2.359470831100877e-18, -1.685582582122128e-20,  1.227225217647791e-22, -9.090315940241099e-25,  6.972388906813923e-27, -6.064342249533804e-29,
   7.569364469177684e-31, -1.534184566388393e-32,  };
-  int offset = -7;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 7;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 7, 0.5);
-      fill_n(ww+offset, 7, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 7; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-
-      const double t2 = t * 2.0;
-      for (int j=1; j <=7; ++j) {
-        const int boxof = it*84+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(7, 1, ax, aw, x, w, ta, rr, ww, n);
 }
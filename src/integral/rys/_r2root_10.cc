@@ -22,9 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <iostream>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/r2rootlist.h>
 
 using namespace std;
@@ -32,11 +30,11 @@ using namespace bagel;
 
 void R2RootList::r2root10(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[10] = {7.294573323927575e-01,1.377939962252648e-01,1.808349800647653e+00,3.401446674552232e+00,5.552517323382231e+00,
+  static constexpr double ax[10] = {7.294573323927575e-01,1.377939962252648e-01,1.808349800647653e+00,3.401446674552232e+00,5.552517323382231e+00,
     8.330184527452614e+00,1.184383102419147e+01,1.627931994088821e+01,2.199666973638226e+01,2.992081117328652e+01};
-  constexpr double aw[10] = {2.005607296769464e-01,1.542211462307546e-01,1.090345597185418e-01,3.104384645250268e-02,4.750776604522325e-03,
+  static constexpr double aw[10] = {2.005607296769464e-01,1.542211462307546e-01,1.090345597185418e-01,3.104384645250268e-02,4.750776604522325e-03,
     3.765056297965012e-04,1.412967060645209e-05,2.124665088519353e-07,9.197859153802983e-10,4.955932475689653e-13};
-  constexpr double x[5270] = {  1.231314330331845e-02,  3.058325179565262e-04,  5.660252004981631e-06,  9.232534545476095e-08,  1.396154020217023e-09,
+  static constexpr double x[5270] = {  1.231314330331845e-02,  3.058325179565262e-04,  5.660252004981631e-06,  9.232534545476095e-08,  1.396154020217023e-09,
   1.999062003070671e-11,  2.735352880239360e-13,  3.589097183447625e-15,  4.511607528874182e-17,  5.406090800582931e-19,  6.105871311867447e-21,  6.353202708379518e-23,
   1.088191615587825e-01,  2.565276251364583e-03,  4.265768742639376e-05,  5.743993883979386e-07,  6.210376619072652e-09,  4.612127497153146e-11, -4.143189875396804e-15,
  -8.000283749734498e-15, -1.780791045459392e-16, -2.532118004869565e-18, -2.344829418936979e-20, -3.615060698655242e-23,  2.915106381238800e-01,  6.179445795196289e-03,
@@ -790,7 +788,7 @@ void R2RootList::r2root10(const double* ta, double* rr, double* ww, const int n)
      0.999872890986397,     0.999819276791044,     0.999751596342948,       0.9996643561754,     0.999543442911079,     0.999994434682217,     0.999998948715239,
       0.99998620338592,     0.999974049021343,     0.999957637654698,     0.999936445735722,     0.999909638740355,     0.999875798645471,     0.999832178728208,
      0.999771722326864  };
-  constexpr double w[5270] = {  1.447408175739011e-01, -6.301402915342401e-02,  1.472048628282835e-02, -2.338046142119721e-03,  2.809295324118172e-04,
+  static constexpr double w[5270] = {  1.447408175739011e-01, -6.301402915342401e-02,  1.472048628282835e-02, -2.338046142119721e-03,  2.809295324118172e-04,
  -2.713460381177472e-05,  2.190899460068657e-06, -1.519653361843289e-07,  9.238903068650614e-09, -4.999734260581985e-10,  2.437928900530449e-11, -1.080128529260118e-12,
   1.450498450698614e-01, -6.069032000860901e-02,  1.361078785383966e-02, -2.080993870227430e-03,  2.414691461322428e-04, -2.259353907099960e-05,  1.772275385107807e-06,
  -1.197412111179425e-07,  7.107993596846282e-09, -3.763926830757755e-10,  1.799431136308051e-11, -7.830746738395398e-13,  1.454061942848960e-01, -5.600324416769113e-02,
@@ -1544,67 +1542,5 @@ void R2RootList::r2root10(const double* ta, double* rr, double* ww, const int n)
   5.74504186714141e-09,  2.15602483846339e-10,  3.24199396786132e-12,  1.40348725610762e-14,  7.56218149211604e-18,   1.5301569341808e-06,  1.17661396965603e-06,
   8.31867673633895e-07,  2.36845752353689e-07,  3.62455490457331e-08,  2.87250999295426e-09,  1.07800831653229e-10,  1.62099082070873e-12,  7.01740963272322e-15,
   3.78107641272709e-18  };
-  int offset = -10;
-  const int ibox0 = static_cast<int>(log(64.0) / log(2.0));
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 10;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 10, 0.5);
-      fill_n(ww+offset, 10, 0.0);
-    } else if (t >= 131072.0) {
-      for (int r = 0; r != 10; ++r) {
-        ww[offset+r] = aw[10-r-1] / t;
-        rr[offset+r] = 1.0 - ax[10-r-1] / t;
-      }
-    } else {
-      assert(t >= 0);
-      int it;
-      double bigT = 0.0;
-      if (t >= 64.0 && t < 131072.0) {
-        bigT = t;
-        it = static_cast<int>(log(bigT) / log(2.0) + 32 - ibox0);
-        t = (t - 1.5 * pow(2.0, it + ibox0 - 32))* 2/pow(2.0, it + ibox0 - 32);
-      } else {
-        it = static_cast<int>(t*   0.500000000000000);
-        t = (t - it *2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      }
-      const double t2 = t * 2.0;
-      for (int j=1; j <=10; ++j) {
-        const int boxof = it*120+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-        if (64.0 <= bigT && bigT < 131072.0) {
-          const int iref = 5160 + (it - 32) * 10 + 10 - j;
-          double rr_infty = x[iref];
-          double ww_infty = w[iref];
-          double Tref = pow(2.0, it + ibox0 + 1 - 32);
-          ww[offset+j-1] = ww[offset+j-1] * ww_infty * Tref / bigT;
-          rr[offset+j-1] = 1.0 + rr[offset+j-1] * (1.0 - rr_infty) * Tref /bigT;
-        }
-      }
-    }
-  }
+  chebyshev_roots_r2(10, ax, aw, x, w, ta, rr, ww, n);
 }
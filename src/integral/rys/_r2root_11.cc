@@ -22,9 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <iostream>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/r2rootlist.h>
 
 using namespace std;
@@ -32,11 +30,11 @@ using namespace bagel;
 
 void R2RootList::r2root11(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[11] = {6.654207944473094e-01,1.257969221074837e-01,1.647156829867703e+00,3.091149936010304e+00,5.029303588902189e+00,
+  static constexpr double ax[11] = {6.654207944473094e-01,1.257969221074837e-01,1.647156829867703e+00,3.091149936010304e+00,5.029303588902189e+00,
     7.509916515199427e+00,1.060599146338118e+01,1.443166881837418e+01,1.917893057680273e+01,2.521780555566961e+01,3.349732065685939e+01};
-  constexpr double aw[11] = {1.948611881259652e-01,1.424671499583614e-01,1.163913599026633e-01,3.828237278540672e-02,7.196668828134485e-03,
+  static constexpr double aw[11] = {1.948611881259652e-01,1.424671499583614e-01,1.163913599026633e-01,3.828237278540672e-02,7.196668828134485e-03,
     7.594433187997459e-04,4.256577442916053e-05,1.146206307544775e-06,1.243181586873306e-08,3.856328149133933e-11,1.441893420266434e-14};
-  constexpr double x[5797] = {  1.017973083189129e-02,  2.301229857440546e-04,  3.880791374334135e-06,  5.776687581848900e-08,  7.988188238501501e-10,
+  static constexpr double x[5797] = {  1.017973083189129e-02,  2.301229857440546e-04,  3.880791374334135e-06,  5.776687581848900e-08,  7.988188238501501e-10,
   1.048642861887981e-11,  1.320007959344018e-13,  1.600524723969812e-15,  1.870812480460042e-17,  2.103575160945323e-19,  2.262034690717785e-21,  2.299778560549371e-23,
   9.026167576680563e-02,  1.954701046995387e-03,  3.020126581230056e-05,  3.851878245452195e-07,  4.102355324572027e-09,  3.388460799153311e-11,  1.417517420525233e-13,
  -1.819869738720160e-15, -5.837892171029294e-17, -9.492496045507116e-19, -1.100542407285730e-20, -8.299348276401257e-23,  2.433797631647369e-01,  4.830936951385680e-03,
@@ -865,7 +863,7 @@ void R2RootList::r2root11(const double* ta, double* rr, double* ww, const int n)
      0.999885407330727,     0.999838164795869,      0.99977978936928,     0.999707351626976,     0.999615205355716,     0.999488869498861,      0.99999492324223,
       0.99999904024565,      0.99998743319069,     0.999976416397583,     0.999961629458703,     0.999942703884009,     0.999919082706731,      0.99988989510484,
      0.999853676371942,     0.999807603412203,     0.999744435724969  };
-  constexpr double w[5797] = {  1.317097209024177e-01, -5.749599646783941e-02,  1.347003343013137e-02, -2.145339474264363e-03,  2.584445287678098e-04,
+  static constexpr double w[5797] = {  1.317097209024177e-01, -5.749599646783941e-02,  1.347003343013137e-02, -2.145339474264363e-03,  2.584445287678098e-04,
  -2.502361192703431e-05,  2.025064528525298e-06, -1.407632238279794e-07,  8.575052444526969e-09, -4.649254155466762e-10,  2.271067867521844e-11, -1.007887181303703e-12,
   1.319513924357754e-01, -5.574583913773534e-02,  1.262234653962428e-02, -1.946711364517878e-03,  2.276435104847937e-04, -2.144675835765975e-05,  1.692598837548693e-06,
  -1.149775323033427e-07,  6.858031121008297e-09, -3.647073726877185e-10,  1.750188043355877e-11, -7.642124174222454e-13,  1.322778254695906e-01, -5.221528824324315e-02,
@@ -1694,67 +1692,5 @@ void R2RootList::r2root11(const double* ta, double* rr, double* ww, const int n)
   1.15882295440621e-08,  6.49504645303199e-10,  1.74897867734605e-11,  1.89695176490302e-13,  5.88431209507049e-16,  2.20016308262294e-19,  1.48667288304112e-06,
    1.0869380947751e-06,   8.8799560472613e-07,  2.92071325572256e-07,  5.49062258005866e-08,  5.79409270324513e-09,  3.24751086648258e-10,  8.74486013446636e-12,
    9.4847228002419e-14,  2.94214488917079e-16,  1.10007737752261e-19  };
-  int offset = -11;
-  const int ibox0 = static_cast<int>(log(64.0) / log(2.0));
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 11;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 11, 0.5);
-      fill_n(ww+offset, 11, 0.0);
-    } else if (t >= 131072.0) {
-      for (int r = 0; r != 11; ++r) {
-        ww[offset+r] = aw[11-r-1] / t;
-        rr[offset+r] = 1.0 - ax[11-r-1] / t;
-      }
-    } else {
-      assert(t >= 0);
-      int it;
-      double bigT = 0.0;
-      if (t >= 64.0 && t < 131072.0) {
-        bigT = t;
-        it = static_cast<int>(log(bigT) / log(2.0) + 32 - ibox0);
-        t = (t - 1.5 * pow(2.0, it + ibox0 - 32))* 2/pow(2.0, it + ibox0 - 32);
-      } else {
-        it = static_cast<int>(t*   0.500000000000000);
-        t = (t - it *2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      }
-      const double t2 = t * 2.0;
-      for (int j=1; j <=11; ++j) {
-        const int boxof = it*132+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-        if (64.0 <= bigT && bigT < 131072.0) {
-          const int iref = 5676 + (it - 32) * 11 + 11 - j;
-          double rr_infty = x[iref];
-          double ww_infty = w[iref];
-          double Tref = pow(2.0, it + ibox0 + 1 - 32);
-          ww[offset+j-1] = ww[offset+j-1] * ww_infty * Tref / bigT;
-          rr[offset+j-1] = 1.0 + rr[offset+j-1] * (1.0 - rr_infty) * Tref /bigT;
-        }
-      }
-    }
-  }
+  chebyshev_roots_r2(11, ax, aw, x, w, ta, rr, ww, n);
 }
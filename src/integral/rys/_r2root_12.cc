@@ -22,9 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <iostream>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/r2rootlist.h>
 
 using namespace std;
@@ -32,13 +30,13 @@ using namespace bagel;
 
 void R2RootList::r2root12(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[12] = {6.117598184216843e-01,1.157225588468522e-01,1.512616040532386e+00,2.833762148836217e+00,4.599245186127769e+00,
+  static constexpr double ax[12] = {6.117598184216843e-01,1.157225588468522e-01,1.512616040532386e+00,2.833762148836217e+00,4.599245186127769e+00,
     6.844551566179677e+00,9.621353549856169e+00,1.300610461485263e+01,1.711692049382484e+01,2.215117489462539e+01,2.848807594654846e+01,3.709926260045671e+01
     };
-  constexpr double aw[12] = {1.888803584880023e-01,1.323661905077027e-01,1.220414711938146e-01,4.522478359825252e-02,1.005122890789416e-02,
+  static constexpr double aw[12] = {1.888803584880023e-01,1.323661905077027e-01,1.220414711938146e-01,4.522478359825252e-02,1.005122890789416e-02,
     1.331991849510925e-03,1.016161836761476e-04,4.182543866858831e-06,8.342501162049512e-08,6.711980709414892e-10,1.530806643037629e-12,4.074054225872852e-16
     };
-  constexpr double x[6324] = {  8.556059077382223e-03,  1.774548803092799e-04,  2.747996582493804e-06,  3.760480783549002e-08,  4.787861644833646e-10,
+  static constexpr double x[6324] = {  8.556059077382223e-03,  1.774548803092799e-04,  2.747996582493804e-06,  3.760480783549002e-08,  4.787861644833646e-10,
   5.798061638560898e-12,  6.749347740287941e-14,  7.591936191192867e-16,  8.267230100357389e-18,  8.710926722882186e-20,  8.853651385109047e-22,  8.625525090814263e-24,
   7.605297891760691e-02,  1.521713724288045e-03,  2.190698811364138e-05,  2.639181632755442e-07,  2.722978429450082e-09,  2.318327973613955e-11,  1.367331269842075e-13,
  -7.069330236121908e-17, -1.781602701209171e-17, -3.385839364361933e-19, -4.379922693991793e-21, -4.236582609389194e-23,  2.060784478219854e-01,  3.834119424530152e-03,
@@ -942,7 +940,7 @@ void R2RootList::r2root12(const double* ta, double* rr, double* ww, const int n)
      0.999895560032871,     0.999853189235424,     0.999801541835767,     0.999738815523961,     0.999661998604722,     0.999565304799083,     0.999433908016592,
      0.999995332642987,     0.999999117106942,     0.999988459655452,     0.999978380110559,     0.999964910543929,     0.999947780215712,     0.999926594897844,
      0.999900771296579,     0.999869408260393,     0.999830999947398,     0.999782653229168,     0.999716955088803  };
-  constexpr double w[6324] = {  1.208315003771029e-01, -5.286273680068900e-02,  1.241365257595397e-02, -1.981589906171037e-03,  2.392336027769725e-04,
+  static constexpr double w[6324] = {  1.208315003771029e-01, -5.286273680068900e-02,  1.241365257595397e-02, -1.981589906171037e-03,  2.392336027769725e-04,
  -2.321078948168457e-05,  1.881974700775441e-06, -1.310545720938012e-07,  7.997316387437043e-09, -4.343052582147692e-10,  2.124756243861990e-11, -9.443263284625017e-13,
   1.210231797341685e-01, -5.151199151274930e-02,  1.175195199960199e-02, -1.825083242788676e-03,  2.147613524507657e-04, -2.034730801238170e-05,  1.613963914484455e-06,
  -1.101344491501664e-07,  6.595991399686935e-09, -3.520604709227569e-10,  1.695080847082133e-11, -7.423477141411771e-13,  1.213078794878861e-01, -4.878803941438747e-02,
@@ -1846,67 +1844,5 @@ void R2RootList::r2root12(const double* ta, double* rr, double* ww, const int n)
   2.03246600798125e-08,  1.55054581364116e-09,  6.38207973027252e-11,  1.27296949036268e-12,  1.02417086360469e-14,  2.33583441237611e-17,  6.21653689548609e-21,
    1.4410427741089e-06,  1.00987388998186e-06,  9.31102532911793e-07,  3.45037716661472e-07,  7.66847908622296e-08,  1.01622913323282e-08,  7.75269956025296e-10,
    3.1910277304526e-11,  6.36482327426873e-13,  5.12083489182655e-15,  1.16791278307925e-17,  3.10825670308903e-21  };
-  int offset = -12;
-  const int ibox0 = static_cast<int>(log(64.0) / log(2.0));
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 12;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 12, 0.5);
-      fill_n(ww+offset, 12, 0.0);
-    } else if (t >= 131072.0) {
-      for (int r = 0; r != 12; ++r) {
-        ww[offset+r] = aw[12-r-1] / t;
-        rr[offset+r] = 1.0 - ax[12-r-1] / t;
-      }
-    } else {
-      assert(t >= 0);
-      int it;
-      double bigT = 0.0;
-      if (t >= 64.0 && t < 131072.0) {
-        bigT = t;
-        it = static_cast<int>(log(bigT) / log(2.0) + 32 - ibox0);
-        t = (t - 1.5 * pow(2.0, it + ibox0 - 32))* 2/pow(2.0, it + ibox0 - 32);
-      } else {
-        it = static_cast<int>(t*   0.500000000000000);
-        t = (t - it *2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      }
-      const double t2 = t * 2.0;
-      for (int j=1; j <=12; ++j) {
-        const int boxof = it*144+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-        if (64.0 <= bigT && bigT < 131072.0) {
-          const int iref = 6192 + (it - 32) * 12 + 12 - j;
-          double rr_infty = x[iref];
-          double ww_infty = w[iref];
-          double Tref = pow(2.0, it + ibox0 + 1 - 32);
-          ww[offset+j-1] = ww[offset+j-1] * ww_infty * Tref / bigT;
-          rr[offset+j-1] = 1.0 + rr[offset+j-1] * (1.0 - rr_infty) * Tref /bigT;
-        }
-      }
-    }
-  }
+  chebyshev_roots_r2(12, ax, aw, x, w, ta, rr, ww, n);
 }
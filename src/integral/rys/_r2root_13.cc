@@ -22,9 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <iostream>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/r2rootlist.h>
 
 using namespace std;
@@ -32,13 +30,13 @@ using namespace bagel;
 
 void R2RootList::r2root13(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[13] = {5.661340588975947e-01,1.071427972318604e-01,1.398569672149007e+00,2.616607091098259e+00,4.238862100920015e+00,
+  static constexpr double ax[13] = {5.661340588975947e-01,1.071427972318604e-01,1.398569672149007e+00,2.616607091098259e+00,4.238862100920015e+00,
     6.292280277333457e+00,8.815035572474203e+00,1.186144884335685e+01,1.551082121638828e+01,1.988471153160454e+01,2.518535995833174e+01,3.180050763847425e+01,
     4.072316405595257e+01};
-  constexpr double aw[13] = {1.828451089831869e-01,1.235948257355774e-01,1.262816917406144e-01,5.173557633872573e-02,1.321642760925927e-02,
+  static constexpr double aw[13] = {1.828451089831869e-01,1.235948257355774e-01,1.262816917406144e-01,5.173557633872573e-02,1.321642760925927e-02,
     2.110206065922282e-03,2.059416702618249e-04,1.175778179702481e-05,3.658669747628742e-07,5.544229240135393e-09,3.385426230780610e-11,5.799921859627044e-14,
     1.122550867941830e-17};
-  constexpr double x[6851] = {  7.291850316246106e-03,  1.396957335135578e-04,  1.999562486050905e-06,  2.531466228978526e-08,  2.985293612068409e-10,
+  static constexpr double x[6851] = {  7.291850316246106e-03,  1.396957335135578e-04,  1.999562486050905e-06,  2.531466228978526e-08,  2.985293612068409e-10,
   3.353344979581788e-12,  3.627501603071741e-14,  3.800652881608797e-16,  3.866649834873157e-18,  3.821635304642107e-20,  3.663943238003051e-22,  3.395037465196105e-24,
   6.493945880174758e-02,  1.206742977708125e-03,  1.623882119711686e-05,  1.847221098338755e-07,  1.831218218317748e-09,  1.554327479336491e-11,  1.031921047883912e-13,
   3.257065051286789e-16, -4.564870715009902e-18, -1.170553574906267e-19, -1.658916054993814e-21, -1.781864064731409e-23,  1.766336697066981e-01,  3.086117898484807e-03,
@@ -1018,7 +1016,7 @@ void R2RootList::r2root13(const double* ta, double* rr, double* ww, const int n)
      0.999378611457456,     0.999995680739907,     0.999999182565329,     0.999989329760192,     0.999980036872169,     0.999967660048669,     0.999951993711263,
      0.999932746615811,     0.999909504327062,     0.999881661825436,     0.999848291690585,     0.999807850952466,     0.999757381380932,     0.999689306914856
   };
-  constexpr double w[6851] = {  1.116133016257935e-01, -4.891802710352082e-02,  1.150976554808129e-02, -1.840803958150150e-03,  2.226416033465179e-04,
+  static constexpr double w[6851] = {  1.116133016257935e-01, -4.891802710352082e-02,  1.150976554808129e-02, -1.840803958150150e-03,  2.226416033465179e-04,
  -2.163840238489090e-05,  1.757364307488664e-06, -1.225678368004388e-07,  7.490500518659115e-09, -4.073540945156029e-10,  1.995570143095647e-11, -8.880385529860223e-13,
   1.117674409201738e-01, -4.785388530871020e-02,  1.098359689398272e-02, -1.715384333029625e-03,  2.028931525440889e-04, -1.931285069192372e-05,  1.538413358324488e-06,
  -1.053831627285839e-07,  6.333483385868834e-09, -3.391214925548738e-10,  1.637490292073283e-11, -7.190020631341384e-13,  1.120111804922040e-01, -4.570897605438827e-02,
@@ -1998,67 +1996,5 @@ void R2RootList::r2root13(const double* ta, double* rr, double* ww, const int n)
   1.71288315055781e-22,  1.39499747454214e-06,  9.42953687557811e-07,  9.63452848362842e-07,  3.94711123189741e-07,  1.00833340524744e-07,   1.6099594619158e-08,
   1.57121025285206e-09,  8.97047561418519e-11,  2.79134349642085e-12,  4.22991122446853e-14,  2.58287523710679e-16,  4.42498921175159e-19,  8.56438345292534e-23
   };
-  int offset = -13;
-  const int ibox0 = static_cast<int>(log(64.0) / log(2.0));
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 13;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 13, 0.5);
-      fill_n(ww+offset, 13, 0.0);
-    } else if (t >= 131072.0) {
-      for (int r = 0; r != 13; ++r) {
-        ww[offset+r] = aw[13-r-1] / t;
-        rr[offset+r] = 1.0 - ax[13-r-1] / t;
-      }
-    } else {
-      assert(t >= 0);
-      int it;
-      double bigT = 0.0;
-      if (t >= 64.0 && t < 131072.0) {
-        bigT = t;
-        it = static_cast<int>(log(bigT) / log(2.0) + 32 - ibox0);
-        t = (t - 1.5 * pow(2.0, it + ibox0 - 32))* 2/pow(2.0, it + ibox0 - 32);
-      } else {
-        it = static_cast<int>(t*   0.500000000000000);
-        t = (t - it *2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      }
-      const double t2 = t * 2.0;
-      for (int j=1; j <=13; ++j) {
-        const int boxof = it*156+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-        if (64.0 <= bigT && bigT < 131072.0) {
-          const int iref = 6708 + (it - 32) * 13 + 13 - j;
-          double rr_infty = x[iref];
-          double ww_infty = w[iref];
-          double Tref = pow(2.0, it + ibox0 + 1 - 32);
-          ww[offset+j-1] = ww[offset+j-1] * ww_infty * Tref / bigT;
-          rr[offset+j-1] = 1.0 + rr[offset+j-1] * (1.0 - rr_infty) * Tref /bigT;
-        }
-      }
-    }
-  }
+  chebyshev_roots_r2(13, ax, aw, x, w, ta, rr, ww, n);
 }
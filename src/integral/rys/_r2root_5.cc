@@ -22,9 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <iostream>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/r2rootlist.h>
 
 using namespace std;
@@ -32,11 +30,11 @@ using namespace bagel;
 
 void R2RootList::r2root5(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[5] = {2.635613251680105e-01,1.413408451087209e+00,3.596439491132585e+00,7.085837038047054e+00,1.264084906963732e+01
+  static constexpr double ax[5] = {2.635613251680105e-01,1.413408451087209e+00,3.596439491132585e+00,7.085837038047054e+00,1.264084906963732e+01
     };
-  constexpr double aw[5] = {2.608788004978083e-01,1.993341659360938e-01,3.797136967832551e-02,1.805886227483284e-03,1.168503075026571e-05
+  static constexpr double aw[5] = {2.608788004978083e-01,1.993341659360938e-01,3.797136967832551e-02,1.805886227483284e-03,1.168503075026571e-05
     };
-  constexpr double x[2635] = {  4.892306114796960e-02,  2.379950964962451e-03,  8.448885794937013e-05,  2.567362812196001e-06,  6.933351127331913e-08,
+  static constexpr double x[2635] = {  4.892306114796960e-02,  2.379950964962451e-03,  8.448885794937013e-05,  2.567362812196001e-06,  6.933351127331913e-08,
   1.664178123710639e-09,  3.425686939377008e-11,  5.346406843597989e-13,  2.509774513752789e-15, -2.413528561238968e-16, -1.278776086656787e-17, -3.984123116620220e-19,
   4.067161416639053e-01,  1.586326163243614e-02,  3.390780937592442e-04,  2.195150671624916e-06, -1.293440315897628e-07, -4.896295431193408e-09, -3.973472285478247e-11,
   2.802005430976117e-12,  1.153059950971823e-13,  9.502848059040343e-16, -7.448261260287429e-17, -2.935246101171009e-18,  9.707411160442166e-01,  2.379301518149794e-02,
@@ -413,7 +411,7 @@ void R2RootList::r2root5(const double* ta, double* rr, double* ww, const int n)
      0.999913730089696,     0.999780484889067,     0.999567503273092,     0.999228443182297,       0.9999919566546,      0.99995686570342,     0.999890244120447,
      0.999783754939019,     0.999614227484126,     0.999995978357991,     0.999978433016302,     0.999945122479052,     0.999891878294767,     0.999807115214477,
      0.999997989186667,     0.999989216549293,     0.999972561344214,     0.999945939353653,     0.999903557975238  };
-  constexpr double w[2635] = {  2.864747031832172e-01, -1.203956709530787e-01,  2.716939055345101e-02, -4.182996896152797e-03,  4.888527208840445e-04,
+  static constexpr double w[2635] = {  2.864747031832172e-01, -1.203956709530787e-01,  2.716939055345101e-02, -4.182996896152797e-03,  4.888527208840445e-04,
  -4.606179117146709e-05,  3.637336400462102e-06, -2.472838158267440e-07,  1.476295220972618e-08, -7.857791840163207e-10,  3.773818518748210e-11, -1.648865351565666e-12,
   2.870363532092418e-01, -1.025847303882611e-01,  2.009396223868561e-02, -2.750758247468436e-03,  2.917257892812096e-04, -2.536451490493593e-05,  1.873756817364840e-06,
  -1.205280986854536e-07,  6.872590312804998e-09, -3.521505008243405e-10,  1.638982647003751e-11, -6.979267866310482e-13,  2.766771109513279e-01, -6.930388644468372e-02,
@@ -790,67 +788,5 @@ void R2RootList::r2root5(const double* ta, double* rr, double* ww, const int n)
   1.21667168322819e-05,  2.31765032407309e-06,  1.10225486074861e-07,  7.13216655358985e-10,  7.96148030260647e-06,  6.08326559736546e-06,  1.15880749681387e-06,
   5.51119041049794e-08,  3.56602911821654e-10,  3.98070977443438e-06,  3.04160959360372e-06,  5.79399330036612e-07,  2.75557420697527e-08,  1.78300098770403e-10,
   1.99034729383704e-06,  1.52079899548411e-06,  2.89698560167889e-07,  1.37778185080207e-08,  8.91497097035653e-11  };
-  int offset = -5;
-  const int ibox0 = static_cast<int>(log(64.0) / log(2.0));
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 5;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 5, 0.5);
-      fill_n(ww+offset, 5, 0.0);
-    } else if (t >= 131072.0) {
-      for (int r = 0; r != 5; ++r) {
-        ww[offset+r] = aw[5-r-1] / t;
-        rr[offset+r] = 1.0 - ax[5-r-1] / t;
-      }
-    } else {
-      assert(t >= 0);
-      int it;
-      double bigT = 0.0;
-      if (t >= 64.0 && t < 131072.0) {
-        bigT = t;
-        it = static_cast<int>(log(bigT) / log(2.0) + 32 - ibox0);
-        t = (t - 1.5 * pow(2.0, it + ibox0 - 32))* 2/pow(2.0, it + ibox0 - 32);
-      } else {
-        it = static_cast<int>(t*   0.500000000000000);
-        t = (t - it *2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      }
-      const double t2 = t * 2.0;
-      for (int j=1; j <=5; ++j) {
-        const int boxof = it*60+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-        if (64.0 <= bigT && bigT < 131072.0) {
-          const int iref = 2580 + (it - 32) * 5 + 5 - j;
-          double rr_infty = x[iref];
-          double ww_infty = w[iref];
-          double Tref = pow(2.0, it + ibox0 + 1 - 32);
-          ww[offset+j-1] = ww[offset+j-1] * ww_infty * Tref / bigT;
-          rr[offset+j-1] = 1.0 + rr[offset+j-1] * (1.0 - rr_infty) * Tref /bigT;
-        }
-      }
-    }
-  }
+  chebyshev_roots_r2(5, ax, aw, x, w, ta, rr, ww, n);
 }
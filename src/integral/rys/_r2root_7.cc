@@ -22,9 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <iostream>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/r2rootlist.h>
 
 using namespace std;
@@ -32,11 +30,11 @@ using namespace bagel;
 
 void R2RootList::r2root7(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[7] = {1.930444130090417e-01,1.026668812009368e+00,2.567886541317060e+00,4.900371779380565e+00,8.182184659880857e+00,
+  static constexpr double ax[7] = {1.930444130090417e-01,1.026668812009368e+00,2.567886541317060e+00,4.900371779380565e+00,8.182184659880857e+00,
     1.273422887416590e+01,1.939580186108440e+01};
-  constexpr double aw[7] = {2.046602566047616e-01,2.109164435183150e-01,7.356345493138189e-02,1.031679658250106e-02,5.370071194458480e-04,
+  static constexpr double aw[7] = {2.046602566047616e-01,2.109164435183150e-01,7.356345493138189e-02,1.031679658250106e-02,5.370071194458480e-04,
     7.932762417987521e-06,1.585163780946268e-08};
-  constexpr double x[3689] = {  2.507351393371736e-02,  8.834010253015928e-04,  2.302936539378776e-05,  5.240722126289678e-07,  1.091306152881189e-08,
+  static constexpr double x[3689] = {  2.507351393371736e-02,  8.834010253015928e-04,  2.302936539378776e-05,  5.240722126289678e-07,  1.091306152881189e-08,
   2.114072699683823e-10,  3.816859319682645e-12,  6.363589451805290e-14,  9.534922406375777e-16,  1.195517073348058e-17,  9.415883463951202e-20, -8.223051893501708e-22,
   2.170994279736083e-01,  6.856752512840586e-03,  1.417608513198876e-04,  2.031445291590015e-06,  1.282580727350529e-08, -3.095779867611269e-10, -1.284127216796173e-11,
  -2.352596819167673e-13, -1.417976503515758e-15,  5.912492588566414e-17,  2.340230264507829e-18,  4.216451929908830e-20,  5.588268525043734e-01,  1.409254740045736e-02,
@@ -564,7 +562,7 @@ void R2RootList::r2root7(const double* ta, double* rr, double* ww, const int n)
      0.999611377725671,     0.999408080322951,     0.999997054364783,     0.999984334217389,     0.999960817011428,     0.999925225975384,     0.999875149293809,
      0.999805690346265,     0.999704042421266,     0.999998527188011,      0.99999216713858,     0.999980408580465,     0.999962613130345,     0.999937574885102,
      0.999902845543868,     0.999852021775352  };
-  constexpr double w[3689] = {  2.058427601107093e-01, -8.837988263641910e-02,  2.035437541773679e-02, -3.190255166322968e-03,  3.786868992215763e-04,
+  static constexpr double w[3689] = {  2.058427601107093e-01, -8.837988263641910e-02,  2.035437541773679e-02, -3.190255166322968e-03,  3.786868992215763e-04,
  -3.617119192804737e-05,  2.890813050016872e-06, -1.986359025037516e-07,  1.197198954537636e-08, -6.426980755115631e-10,  3.110611212868952e-11, -1.368662893579013e-12,
   2.065149188528279e-01, -8.169872373148625e-02,  1.738934840789347e-02, -2.541390407179316e-03,  2.837517482795243e-04, -2.569296688930459e-05,  1.959814387474717e-06,
  -1.292884296856602e-07,  7.519766990465273e-09, -3.913131865394630e-10,  1.843070117722596e-11, -7.919292043959968e-13,  2.060334733700275e-01, -6.838191733258137e-02,
@@ -1092,67 +1090,5 @@ void R2RootList::r2root7(const double* ta, double* rr, double* ww, const int n)
   2.42091459403763e-10,  4.83759106399681e-13,  3.12287959959821e-06,  3.21834179873747e-06,  1.12249352259487e-06,  1.57422423039441e-07,  8.19410958615432e-09,
   1.21044809374184e-10,   2.4187771781813e-13,  1.56143384250459e-06,  1.60916476072933e-06,  5.61244620753341e-07,  7.87109114265523e-08,  4.09703918034247e-09,
   6.05221742094995e-11,   1.2093839881487e-13  };
-  int offset = -7;
-  const int ibox0 = static_cast<int>(log(64.0) / log(2.0));
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 7;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 7, 0.5);
-      fill_n(ww+offset, 7, 0.0);
-    } else if (t >= 131072.0) {
-      for (int r = 0; r != 7; ++r) {
-        ww[offset+r] = aw[7-r-1] / t;
-        rr[offset+r] = 1.0 - ax[7-r-1] / t;
-      }
-    } else {
-      assert(t >= 0);
-      int it;
-      double bigT = 0.0;
-      if (t >= 64.0 && t < 131072.0) {
-        bigT = t;
-        it = static_cast<int>(log(bigT) / log(2.0) + 32 - ibox0);
-        t = (t - 1.5 * pow(2.0, it + ibox0 - 32))* 2/pow(2.0, it + ibox0 - 32);
-      } else {
-        it = static_cast<int>(t*   0.500000000000000);
-        t = (t - it *2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      }
-      const double t2 = t * 2.0;
-      for (int j=1; j <=7; ++j) {
-        const int boxof = it*84+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-        if (64.0 <= bigT && bigT < 131072.0) {
-          const int iref = 3612 + (it - 32) * 7 + 7 - j;
-          double rr_infty = x[iref];
-          double ww_infty = w[iref];
-          double Tref = pow(2.0, it + ibox0 + 1 - 32);
-          ww[offset+j-1] = ww[offset+j-1] * ww_infty * Tref / bigT;
-          rr[offset+j-1] = 1.0 + rr[offset+j-1] * (1.0 - rr_infty) * Tref /bigT;
-        }
-      }
-    }
-  }
+  chebyshev_roots_r2(7, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -22,9 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <iostream>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/r2rootlist.h>
 
 using namespace std;
@@ -32,11 +30,11 @@ using namespace bagel;
 
 void R2RootList::r2root9(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[9] = {8.072231022867195e-01,1.523228088396698e-01,2.005142805245114e+00,3.783488407448686e+00,6.204980450274764e+00,
+  static constexpr double ax[9] = {8.072231022867195e-01,1.523228088396698e-01,2.005142805245114e+00,3.783488407448686e+00,6.204980450274764e+00,
     9.373021010795718e+00,1.346628828726829e+01,1.883366964411048e+01,2.637417251782895e+01};
-  constexpr double aw[9] = {2.056077745591990e-01,1.680638520518385e-01,9.964414277580098e-02,2.373037189135802e-02,2.799823982353893e-03,
+  static constexpr double aw[9] = {2.056077745591990e-01,1.680638520518385e-01,9.964414277580098e-02,2.373037189135802e-02,2.799823982353893e-03,
     1.526254654547909e-04,3.296074076491241e-06,2.055392496864654e-08,1.645443281759665e-11};
-  constexpr double x[4743] = {  1.519406775137123e-02,  4.186612558845981e-04,  8.582408377044060e-06,  1.547309897930941e-07,  2.578992377373183e-09,
+  static constexpr double x[4743] = {  1.519406775137123e-02,  4.186612558845981e-04,  8.582408377044060e-06,  1.547309897930941e-07,  2.578992377373183e-09,
   4.055210846674733e-11,  6.063722583365155e-13,  8.636142460753359e-15,  1.166756368117403e-16,  1.479289442188289e-18,  1.718800572104129e-20,  1.730650158736156e-22,
   1.336748761944815e-01,  3.451789821160458e-03,  6.188642643888667e-05,  8.732095059828386e-07,  9.249617178382145e-09,  4.880922613758920e-11, -7.366411342210074e-13,
  -2.807025356751849e-14, -5.100743591826481e-16, -5.811393675440386e-18, -1.818521591894739e-20,  1.028409374636615e-21,  3.549241095504103e-01,  8.028284150927954e-03,
@@ -714,7 +712,7 @@ void R2RootList::r2root9(const double* ta, double* rr, double* ww, const int n)
      0.999425235432822,     0.999195114910513,     0.999987682705958,     0.999997675729522,     0.999969403832151,     0.999942268328183,     0.999905319150888,
      0.999856978503755,     0.999794519963431,     0.999712619910881,     0.999597560528864,     0.999993841376478,     0.999998837869195,     0.999984701974447,
      0.999971134274235,     0.999952659756086,     0.999928489524759,     0.999897260373785,     0.999856310503814,     0.999798781032426  };
-  constexpr double w[4743] = {  1.606342004371624e-01, -6.969470197134132e-02,  1.622290446851340e-02, -2.567922171457861e-03,  3.075728641087094e-04,
+  static constexpr double w[4743] = {  1.606342004371624e-01, -6.969470197134132e-02,  1.622290446851340e-02, -2.567922171457861e-03,  3.075728641087094e-04,
  -2.962059762324588e-05,  2.385082038020534e-06, -1.650132014362181e-07,  1.000835599602844e-08, -5.404121866191245e-10,  2.629640407706245e-11, -1.162801837264591e-12,
   1.610344316748730e-01, -6.651734413355145e-02,  1.473258773561397e-02, -2.227627069981703e-03,  2.559795861730660e-04, -2.374844126084197e-05,  1.849087247082407e-06,
  -1.241229254138106e-07,  7.326401243811381e-09, -3.860354014949594e-10,  1.837514912540838e-11, -7.966103400835801e-13,  1.613723581947300e-01, -6.011510924165901e-02,
@@ -1392,67 +1390,5 @@ void R2RootList::r2root9(const double* ta, double* rr, double* ww, const int n)
   6.27263148211009e-13,  5.02155138626077e-16,  3.13733763037081e-06,  2.56446065200642e-06,  1.52045475502443e-06,   3.6209811964819e-07,  4.27220863699426e-08,
    2.3288886527043e-09,  5.02942904646128e-11,  3.13629197782051e-13,  2.51075672578785e-16,  1.56866283080444e-06,  1.28222543374511e-06,   7.6022447796479e-07,
   1.81048369532456e-07,  2.13609617794334e-08,  1.16443989147027e-09,  2.51470495337772e-11,  1.56814002751515e-13,  1.25537359753392e-16  };
-  int offset = -9;
-  const int ibox0 = static_cast<int>(log(64.0) / log(2.0));
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 9;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 9, 0.5);
-      fill_n(ww+offset, 9, 0.0);
-    } else if (t >= 131072.0) {
-      for (int r = 0; r != 9; ++r) {
-        ww[offset+r] = aw[9-r-1] / t;
-        rr[offset+r] = 1.0 - ax[9-r-1] / t;
-      }
-    } else {
-      assert(t >= 0);
-      int it;
-      double bigT = 0.0;
-      if (t >= 64.0 && t < 131072.0) {
-        bigT = t;
-        it = static_cast<int>(log(bigT) / log(2.0) + 32 - ibox0);
-        t = (t - 1.5 * pow(2.0, it + ibox0 - 32))* 2/pow(2.0, it + ibox0 - 32);
-      } else {
-        it = static_cast<int>(t*   0.500000000000000);
-        t = (t - it *2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      }
-      const double t2 = t * 2.0;
-      for (int j=1; j <=9; ++j) {
-        const int boxof = it*108+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-        if (64.0 <= bigT && bigT < 131072.0) {
-          const int iref = 4644 + (it - 32) * 9 + 9 - j;
-          double rr_infty = x[iref];
-          double ww_infty = w[iref];
-          double Tref = pow(2.0, it + ibox0 + 1 - 32);
-          ww[offset+j-1] = ww[offset+j-1] * ww_infty * Tref / bigT;
-          rr[offset+j-1] = 1.0 + rr[offset+j-1] * (1.0 - rr_infty) * Tref /bigT;
-        }
-      }
-    }
-  }
+  chebyshev_roots_r2(9, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/spin2rootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void Spin2RootList::spin2root10(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[10] = {1.340082713899064e+00,4.503706126056571e-01,2.697407534140551e+00,4.553249915846232e+00,6.954922092313122e+00,
+  static constexpr double ax[10] = {1.340082713899064e+00,4.503706126056571e-01,2.697407534140551e+00,4.553249915846232e+00,6.954922092313122e+00,
     9.974440034780212e+00,1.372484212198560e+01,1.839665897662831e+01,2.435750272470101e+01,3.255052327310024e+01};
-  constexpr double aw[10] = {2.273449385490049e-01,6.387885277410635e-02,2.388428294200524e-01,1.084346993907713e-01,2.358474554503382e-02,
+  static constexpr double aw[10] = {2.273449385490049e-01,6.387885277410635e-02,2.388428294200524e-01,1.084346993907713e-01,2.358474554503382e-02,
     2.465933306103423e-03,1.160704546409024e-04,2.113813713699647e-06,1.082930556661453e-08,6.836071644043847e-12};
-  constexpr double x[3840] = {  7.555984559787694e-02, -1.583239661708848e-03,  2.389673719445496e-05, -3.022438277992729e-07,  3.278986460779753e-09,
+  static constexpr double x[3840] = {  7.555984559787694e-02, -1.583239661708848e-03,  2.389673719445496e-05, -3.022438277992729e-07,  3.278986460779753e-09,
  -2.942771602154609e-11,  1.840930028913957e-13,  6.823566184497278e-17, -2.605678585643053e-17,  5.291559991680125e-19, -7.335821500927974e-21,  7.719971192632835e-23,
   2.182247086262226e-01, -4.246532713052913e-03,  5.448814136322435e-05, -4.913581380015317e-07,  2.108347118114710e-09,  2.522896635975888e-11, -7.134546777791536e-13,
   8.724302561362886e-15, -4.479443376111848e-17, -5.966511039340738e-19,  1.835479168022670e-20, -2.368258713148873e-22,  4.197157301916614e-01, -7.275370265970495e-03,
@@ -584,7 +583,7 @@ void Spin2RootList::spin2root10(const double* ta, double* rr, double* ww, const
   3.013854445578756e-09, -2.125327993947679e-11,  5.274022560346283e-14,  3.685820276236006e-15, -1.479607667975925e-16,  3.935097031137270e-18, -7.993438544985893e-20,
   1.149765735225503e-21,  1.033479855909702e+00, -8.202652747614857e-03,  6.509194948992148e-05, -5.154148415675703e-07,  4.003996268976999e-09, -2.697624571632588e-11,
   4.969331791114048e-16,  7.782699322797180e-15, -2.961085873380879e-16,  8.132776836383875e-18, -1.778211176362069e-19,  2.991993854830492e-21  };
-  constexpr double w[3840] = {  3.892137711728037e-04, -2.708094787970480e-05,  1.178198150890901e-06, -4.081764338983649e-08,  1.226646072539391e-09,
+  static constexpr double w[3840] = {  3.892137711728037e-04, -2.708094787970480e-05,  1.178198150890901e-06, -4.081764338983649e-08,  1.226646072539391e-09,
  -3.332521479601500e-11,  8.380007228139635e-13, -1.979850643633280e-14,  4.439930027741516e-16, -9.520744382802875e-18,  1.962946672015953e-19, -3.906404068887696e-21,
   2.844441174975575e-03, -2.800076996486012e-04,  1.701420153195039e-05, -8.048812531591202e-07,  3.229154740247860e-08, -1.147515982948470e-09,  3.706635466717444e-11,
  -1.106930235913372e-12,  3.092689957323101e-14, -8.154775428583683e-16,  2.042794866580553e-17, -4.884340989415725e-19,  9.027558233827091e-03, -1.255549775595396e-03,
@@ -1133,51 +1132,5 @@ void Spin2RootList::spin2root10(const double* ta, double* rr, double* ww, const
   2.585585284323528e-20, -3.266343767283841e-22,  5.987766599225417e-24, -1.613027229870330e-25,  4.756288722803390e-27, -1.273886152845227e-28,  2.886732543756675e-30,
  -5.235662555349136e-32,  4.342383687863267e-16, -8.616402498891961e-18,  1.198341222762370e-19, -1.442716161539104e-21,  1.693666460649352e-23, -2.437732996982419e-25,
   5.648494602244414e-27, -1.792110936447204e-28,  5.710807304463519e-30, -1.610969686173576e-31,  3.867344489589388e-33, -7.666369794781990e-35  };
-  int offset = -10;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 10;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 10, 0.5);
-      fill_n(ww+offset, 10, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 10; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=10; ++j) {
-        const int boxof = it*120+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(10, 5, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/spin2rootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void Spin2RootList::spin2root11(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[11] = {1.228656404428239e+00,4.133614840751959e-01,2.468970227713630e+00,4.157560380221757e+00,6.329131509235837e+00,
+  static constexpr double ax[11] = {1.228656404428239e+00,4.133614840751959e-01,2.468970227713630e+00,4.157560380221757e+00,6.329131509235837e+00,
     9.034596893726338e+00,1.234961473959550e+01,1.639136462970140e+01,2.135592744416855e+01,2.762028176062326e+01,3.615053452651031e+01};
-  constexpr double aw[11] = {2.042298206737100e-01,5.346870889797332e-02,2.397505363313079e-01,1.275366664230726e-01,3.448179997208018e-02,
+  static constexpr double aw[11] = {2.042298206737100e-01,5.346870889797332e-02,2.397505363313079e-01,1.275366664230726e-01,3.448179997208018e-02,
     4.847808279860225e-03,3.434460627001003e-04,1.126206465273459e-05,1.448603376823788e-07,5.236471089249789e-10,2.267015586277396e-13};
-  constexpr double x[4224] = {  6.405040805205209e-02, -1.241632252839919e-03,  1.744920262589409e-05, -2.075682350617113e-07,  2.155276774910879e-09,
+  static constexpr double x[4224] = {  6.405040805205209e-02, -1.241632252839919e-03,  1.744920262589409e-05, -2.075682350617113e-07,  2.155276774910879e-09,
  -1.921050233799215e-11,  1.346776587790941e-13, -4.654162361252815e-16, -6.175428323284265e-18,  1.719804674608798e-19, -2.600547457099512e-21,  2.995885048753496e-23,
   1.856283958225036e-01, -3.380555044406864e-03,  4.150580356579074e-05, -3.771347788117756e-07,  2.105430496138172e-09,  5.057630923176073e-12, -3.172435873090006e-13,
   4.643866312209574e-15, -3.810544067118313e-17,  3.780473330210369e-20,  4.572411223222051e-21, -8.575397480195370e-23,  3.589443229296737e-01, -5.932794574791955e-03,
@@ -639,7 +638,7 @@ void Spin2RootList::spin2root11(const double* ta, double* rr, double* ww, const
  -2.392889724100101e-12, -7.509980612181076e-13,  2.754658036544009e-14, -6.592713297759095e-16,  1.028642200684616e-17, -3.736433103934285e-20, -3.618762085626494e-21,
   1.147776563402954e+00, -9.108816247882815e-03,  7.214868784926403e-05, -5.596452333971834e-07,  3.616577732945392e-09,  1.128461462437811e-11, -1.607079445177926e-12,
   5.800879029461788e-14, -1.490522045904256e-15,  2.770049231061256e-17, -2.833605568666760e-19, -3.013954612889662e-21  };
-  constexpr double w[4224] = {  2.592112408570730e-04, -1.636983230508309e-05,  6.462652885834532e-07, -2.033759635188462e-08,  5.560148337459566e-10,
+  static constexpr double w[4224] = {  2.592112408570730e-04, -1.636983230508309e-05,  6.462652885834532e-07, -2.033759635188462e-08,  5.560148337459566e-10,
  -1.376482781420306e-11,  3.159275278930872e-13, -6.823612106014866e-15,  1.401087892277714e-16, -2.754943265162563e-18,  5.215884828378525e-20, -9.545684297557428e-22,
   1.935649564413746e-03, -1.707264739650432e-04,  9.333468892249855e-06, -3.988948377511693e-07,  1.451041328913834e-08, -4.690227236239065e-10,  1.381968401194546e-11,
  -3.774462104018282e-13,  9.668093229638106e-15, -2.342483195522413e-16,  5.403686565607813e-18, -1.192353261174079e-19,  6.338498305660362e-03, -7.849048174940407e-04,
@@ -1243,51 +1242,5 @@ void Spin2RootList::spin2root11(const double* ta, double* rr, double* ww, const
  -4.198669915854047e-23,  1.348719196002245e-24, -4.178272634215456e-26,  1.079440233610822e-27, -2.149375430251484e-29,  2.789027636090282e-31, -2.676211329876246e-34,
   1.440199003680970e-17, -2.861824533481272e-19,  4.037380246324358e-21, -5.379862102617099e-23,  9.689252548155479e-25, -2.953502876232029e-26,  1.084263603925152e-27,
  -3.610209541671010e-29,  1.000897510809062e-30, -2.223920893023265e-32,  3.714862883664100e-34, -3.800984219732757e-36  };
-  int offset = -11;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 11;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 11, 0.5);
-      fill_n(ww+offset, 11, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 11; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=11; ++j) {
-        const int boxof = it*132+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(11, 5, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/spin2rootlist.h>
 
 using namespace std;
@@ -31,13 +30,13 @@ using namespace bagel;
 
 void Spin2RootList::spin2root12(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[12] = {1.134467195048325e+00,3.819881460919284e-01,2.276748747594562e+00,3.826813816328572e+00,5.810974110828223e+00,
+  static constexpr double ax[12] = {1.134467195048325e+00,3.819881460919284e-01,2.276748747594562e+00,3.826813816328572e+00,5.810974110828223e+00,
     8.266798830552723e+00,1.124800012744174e+01,1.483321205593479e+01,1.914317296231067e+01,2.437894713947816e+01,3.092619411073947e+01,3.977268275765083e+01
     };
-  constexpr double aw[12] = {1.836038352743444e-01,4.527360724221062e-02,2.366446214229820e-01,1.436301581705064e-01,4.640569315452939e-02,
+  static constexpr double aw[12] = {1.836038352743444e-01,4.527360724221062e-02,2.366446214229820e-01,1.436301581705064e-01,4.640569315452939e-02,
     8.267585826302408e-03,8.032259452260129e-04,4.049634194549501e-05,9.616636315697198e-07,9.024198635155481e-09,2.368432887140837e-11,7.226294627350485e-15
     };
-  constexpr double x[4608] = {  5.497866052849069e-02, -9.911831126087820e-04,  1.301914851465668e-05, -1.458573622904236e-07,  1.444391748926721e-09,
+  static constexpr double x[4608] = {  5.497866052849069e-02, -9.911831126087820e-04,  1.301914851465668e-05, -1.458573622904236e-07,  1.444391748926721e-09,
  -1.257555278767841e-11,  9.159660297452304e-14, -4.604214078819472e-16, -4.779440529887325e-19,  5.322650698979097e-20, -9.125944666996568e-22,  1.116845267534645e-23,
   1.597748803264850e-01, -2.730520961660954e-03,  3.199130358894769e-05, -2.873492979353482e-07,  1.795329157415374e-09, -2.385173603708768e-12, -1.318581141507526e-13,
   2.315068944145879e-15, -2.310599425188703e-17,  1.194872916032740e-19,  6.811073434310798e-22, -2.549741388385595e-23,  3.102572445272121e-01, -4.882102626266825e-03,
@@ -696,7 +695,7 @@ void Spin2RootList::spin2root12(const double* ta, double* rr, double* ww, const
  -3.511454002631803e-12,  7.121263513613809e-14, -4.813184070657741e-16, -2.394244396866190e-17,  1.022338625646577e-18, -1.818985794604915e-20,  1.262741882300633e+00,
  -1.001203097942652e-02,  7.820947569370575e-05, -5.235807891788181e-07, -1.147750203798740e-09,  2.216911611894179e-10, -7.985744110464255e-12,  1.853153021630203e-13,
  -2.338384499232291e-15, -2.095092828878500e-17,  1.989517210477078e-18, -5.443071665833904e-20  };
-  constexpr double w[4608] = {  1.778800900294314e-04, -1.027497092314416e-05,  3.708711607444326e-07, -1.067816850715478e-08,  2.674133743458445e-10,
+  static constexpr double w[4608] = {  1.778800900294314e-04, -1.027497092314416e-05,  3.708711607444326e-07, -1.067816850715478e-08,  2.674133743458445e-10,
  -6.072249637502298e-12,  1.280086582074457e-13, -2.542824780740356e-15,  4.808115986973848e-17, -8.716998472311230e-19,  1.523514816384128e-20, -2.576996749404428e-22,
   1.351264753084716e-03, -1.076800958239091e-04,  5.336650236804222e-06, -2.074882525695274e-07,  6.887529172488887e-09, -2.037061025583220e-10,  5.505414915053851e-12,
  -1.382266013532156e-13,  3.261473617703728e-15, -7.293271006819639e-17,  1.555611332234449e-18, -3.179535212140114e-20,  4.536424216241372e-03, -5.040925571287432e-04,
@@ -1355,51 +1354,5 @@ void Spin2RootList::spin2root12(const double* ta, double* rr, double* ww, const
   2.482806820817417e-25, -6.042599418896999e-27,  9.959718131712642e-29, -6.474890190230513e-31, -1.502184692473023e-32,  3.104207511219526e-34,  4.595710041859234e-19,
  -9.252168410386716e-21,  1.455189661304289e-22, -3.116953410858288e-24,  1.143206217197660e-25, -4.665106493701900e-27,  1.614770486519759e-28, -4.424512670810779e-30,
   9.291697979333916e-32, -1.451873052585559e-33,  1.913816599358629e-35, -4.722427363522419e-37  };
-  int offset = -12;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 12;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 12, 0.5);
-      fill_n(ww+offset, 12, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 12; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=12; ++j) {
-        const int boxof = it*144+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(12, 5, ax, aw, x, w, ta, rr, ww, n);
 }
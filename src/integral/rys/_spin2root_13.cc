@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/spin2rootlist.h>
 
 using namespace std;
@@ -31,13 +30,13 @@ using namespace bagel;
 
 void Spin2RootList::spin2root13(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[13] = {1.053778449068499e+00,2.112659899939685e+00,3.550515612603487e-01,3.545908105375702e+00,5.374001965904311e+00,
+  static constexpr double ax[13] = {1.053778449068499e+00,2.112659899939685e+00,3.550515612603487e-01,3.545908105375702e+00,5.374001965904311e+00,
     7.625586363900259e+00,1.034046177980882e+01,1.357461255808315e+01,1.740919726636485e+01,2.196810077901239e+01,2.745694644965032e+01,3.426952619644752e+01,
     4.341416862518417e+01};
-  constexpr double aw[13] = {1.653425933230193e-01,2.308063944231524e-01,3.872617185993039e-02,1.566347172501690e-01,5.873863422879316e-02,
+  static constexpr double aw[13] = {1.653425933230193e-01,2.308063944231524e-01,3.872617185993039e-02,1.566347172501690e-01,5.873863422879316e-02,
     1.271411385249187e-02,1.591388592740667e-03,1.119406174603468e-04,4.165594768034293e-06,7.382728502267819e-08,5.187459678940759e-10,1.012024448364900e-12,
     2.226575301122807e-16};
-  constexpr double x[4992] = {  4.770292489621265e-02, -8.035338537316322e-04,  9.900207753903558e-06, -1.046595321614874e-07,  9.871805952427737e-10,
+  static constexpr double x[4992] = {  4.770292489621265e-02, -8.035338537316322e-04,  9.900207753903558e-06, -1.046595321614874e-07,  9.871805952427737e-10,
  -8.323210860456544e-12,  6.089708275874580e-14, -3.493540369866599e-16,  8.767821612031058e-19,  1.432534390861935e-20, -3.163115410601420e-22,  4.131502777535718e-24,
   1.389367662207695e-01, -2.234422232362665e-03,  2.495752387347249e-05, -2.192151420149240e-07,  1.440082978897933e-09, -4.562929762690915e-12, -4.832874178327405e-14,
   1.113013801874982e-15, -1.258872300776392e-17,  8.991507015852257e-20, -1.829109238113246e-22, -6.111221329986177e-24,  2.707047993370168e-01, -4.054418963497051e-03,
@@ -751,7 +750,7 @@ void Spin2RootList::spin2root13(const double* ta, double* rr, double* ww, const
  -4.421527558441761e-14,  4.326950813491382e-15, -8.660826223364446e-17, -6.050049906828001e-19,  7.508370720852255e-20,  1.378075805678044e+00, -1.086618511665374e-02,
   7.868131290383456e-05, -1.308710744739721e-07, -2.051110153150757e-08,  7.822275467714386e-10, -1.544156149408532e-11,  2.655210625128240e-14,  9.162292317005275e-15,
  -3.056663199274780e-16,  3.483802643667124e-18,  9.005459559325242e-20  };
-  constexpr double w[4992] = {  1.252722808568783e-04, -6.662780861693856e-06,  2.213102276301004e-07, -5.866562685139340e-09,  1.353890403762193e-10,
+  static constexpr double w[4992] = {  1.252722808568783e-04, -6.662780861693856e-06,  2.213102276301004e-07, -5.866562685139340e-09,  1.353890403762193e-10,
  -2.836234134087009e-12,  5.522278626369490e-14, -1.014305089340424e-15,  1.775298801176696e-17, -2.982374728729528e-19,  4.834810573096851e-21, -7.593202153716560e-23,
   9.648925498351180e-04, -6.997900842360860e-05,  3.165176893146724e-06, -1.126458117153782e-07,  3.431883464083881e-09, -9.337670640486872e-11,  2.326487507062703e-12,
  -5.395199431701912e-14,  1.177879630611779e-15, -2.441163949225329e-17,  4.833259011877660e-19, -9.184028693252844e-21,  3.305262873711376e-03, -3.319238105179187e-04,
@@ -1465,51 +1464,5 @@ void Spin2RootList::spin2root13(const double* ta, double* rr, double* ww, const
  -4.131098943892708e-28,  4.507006990650179e-30, -1.100150696364266e-31,  6.163264932463817e-33, -2.121497698317138e-34,  1.427462630622797e-20, -3.119390826311415e-22,
   7.546016063106683e-24, -3.160632986487441e-25,  1.453812042523605e-26, -5.466613207682603e-28,  1.612091752477390e-29, -3.918051349906310e-31,  9.305548589078399e-33,
  -2.711519785674393e-34,  9.000829497991167e-36, -2.629228786361668e-37  };
-  int offset = -13;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 13;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 13, 0.5);
-      fill_n(ww+offset, 13, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 13; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=13; ++j) {
-        const int boxof = it*156+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(13, 5, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/spin2rootlist.h>
 
 using namespace std;
@@ -31,9 +30,9 @@ using namespace bagel;
 
 void Spin2RootList::spin2root2(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[2] = {1.629171306613029e+00,5.370828693386970e+00};
-  constexpr double aw[2] = {5.099756785793345e-01,1.546945155102340e-01};
-  constexpr double x[768] = {  7.474864359466880e-01, -3.535658173941201e-02,  5.228416203773162e-04,  2.485061296518964e-05, -1.286755793526887e-06,
+  static constexpr double ax[2] = {1.629171306613029e+00,5.370828693386970e+00};
+  static constexpr double aw[2] = {5.099756785793345e-01,1.546945155102340e-01};
+  static constexpr double x[768] = {  7.474864359466880e-01, -3.535658173941201e-02,  5.228416203773162e-04,  2.485061296518964e-05, -1.286755793526887e-06,
  -1.529060242430627e-08,  2.741924267378731e-09, -2.170087112102099e-11, -4.777430276423512e-12,  1.310467565966167e-13,  6.448120285175643e-15, -3.877042844499765e-16,
   1.684813108292035e+00, -2.160811257381258e-02, -9.040762401469994e-04, -1.988193937228332e-05,  3.272923480604569e-07,  5.094525126797847e-08,  1.950137003038232e-09,
  -7.640653828987848e-13, -3.652771686818833e-12, -1.738281289438803e-13, -1.709254798370944e-15,  2.440919723471047e-16,  6.158162416863208e-01, -3.033308763618646e-02,
@@ -144,7 +143,7 @@ void Spin2RootList::spin2root2(const double* ta, double* rr, double* ww, const i
   5.131910141914227e-23, -4.072944551833229e-25,  1.705239815391031e-01, -1.353450189555217e-03,  1.074234485421626e-05, -8.526207603164891e-08,  6.767257715035484e-10,
  -5.371177798287196e-12,  4.263108064690995e-14, -3.383632241146962e-16,  2.685591584713324e-18, -2.131556163785082e-20,  1.691817805135464e-22, -1.342712541892376e-24
   };
-  constexpr double w[768] = {  8.217044013350129e-02, -2.095080733173159e-02,  3.199747739883691e-03, -3.653041521082034e-04,  3.389664575828230e-05,
+  static constexpr double w[768] = {  8.217044013350129e-02, -2.095080733173159e-02,  3.199747739883691e-03, -3.653041521082034e-04,  3.389664575828230e-05,
  -2.669467244414375e-06,  1.831463935489036e-07, -1.113668023201176e-08,  6.075688894933050e-10, -3.001485043016446e-11,  1.352863514645828e-12, -5.593014156297880e-14,
   1.442177268973693e-01, -5.084892957905012e-02,  9.900478372508317e-03, -1.348561525344196e-03,  1.421188181324683e-04, -1.225235029159208e-05,  8.953682324667308e-07,
  -5.684967421703147e-08,  3.193843843106192e-09, -1.610074496547113e-10,  7.364513155437630e-12, -3.079651222399246e-13,  3.092912429762084e-02, -6.574681913845349e-03,
@@ -255,51 +254,5 @@ void Spin2RootList::spin2root2(const double* ta, double* rr, double* ww, const i
   9.115213559429233e-25, -8.220644789531512e-27,  9.826365766512463e-06, -1.949568295033998e-07,  2.707797705569141e-09, -3.223708304872381e-11,  3.518115709781396e-13,
  -3.630002000516141e-15,  3.601399064404590e-17, -3.470940059827729e-19,  3.271418610775328e-21, -3.029274175469165e-23,  2.764981948456685e-25, -2.493626101483130e-27
   };
-  int offset = -2;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 2;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 2, 0.5);
-      fill_n(ww+offset, 2, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 2; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=2; ++j) {
-        const int boxof = it*24+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(2, 5, ax, aw, x, w, ta, rr, ww, n);
 }
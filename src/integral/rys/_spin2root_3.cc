@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/spin2rootlist.h>
 
 using namespace std;
@@ -31,9 +30,9 @@ using namespace bagel;
 
 void Spin2RootList::spin2root3(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[3] = {1.220402317558884e+00,3.808880721467068e+00,8.470716960974048e+00};
-  constexpr double aw[3] = {3.653189471750080e-01,2.831245503433029e-01,1.622669657125762e-02};
-  constexpr double x[1152] = {  4.693839072042786e-01, -2.050039192295692e-02,  4.697150842322769e-04, -1.599188764002832e-06, -3.231861806253078e-07,
+  static constexpr double ax[3] = {1.220402317558884e+00,3.808880721467068e+00,8.470716960974048e+00};
+  static constexpr double aw[3] = {3.653189471750080e-01,2.831245503433029e-01,1.622669657125762e-02};
+  static constexpr double x[1152] = {  4.693839072042786e-01, -2.050039192295692e-02,  4.697150842322769e-04, -1.599188764002832e-06, -3.231861806253078e-07,
   1.145401827378199e-08, -3.489143347512334e-11, -1.179542257162968e-11,  4.254072037419837e-13,  1.419247830897813e-15, -5.312272886113228e-16,  1.344736589887053e-17,
   1.191937532264912e+00, -2.865147901868704e-02, -2.323864872618429e-04,  1.506306245567615e-05,  3.280526421680721e-07, -1.301662096307454e-08, -5.249342693265764e-10,
   1.155980896451996e-11,  8.146456630329071e-13, -7.124494756311483e-15, -1.123754662005814e-15, -1.418466546214892e-18,  1.820452542596928e+00, -1.011284755213548e-02,
@@ -198,7 +197,7 @@ void Spin2RootList::spin2root3(const double* ta, double* rr, double* ww, const i
   4.799199326489230e-10, -3.809128299437819e-12,  3.023308142506033e-14, -2.399602062357474e-16,  1.904566051556495e-18, -1.511655569423866e-20,  1.199802166404153e-22,
  -9.522237476716402e-25,  2.689455324565930e-01, -2.134622817260070e-03,  1.694251817587912e-05, -1.344729007012283e-07,  1.067312475942498e-09, -8.471267559184192e-12,
   6.723651758527864e-14, -5.336567715086343e-16,  4.235638008558256e-18, -3.361829208047673e-20,  2.668286368319663e-22, -2.117687116172438e-24  };
-  constexpr double w[1152] = {  3.012101073384943e-02, -6.052359451558529e-03,  7.426687986104492e-04, -6.978764236365288e-05,  5.457720545869924e-06,
+  static constexpr double w[1152] = {  3.012101073384943e-02, -6.052359451558529e-03,  7.426687986104492e-04, -6.978764236365288e-05,  5.457720545869924e-06,
  -3.704720502602437e-07,  2.237673528850591e-08, -1.222180501446204e-09,  6.103622807883709e-11, -2.809204053675357e-12,  1.198494696121926e-13, -4.754262962969435e-15,
   1.051655390915495e-01, -3.127841303320419e-02,  5.300540667484792e-03, -6.469781088625642e-04,  6.255626507569962e-05, -5.042780913136892e-06,  3.498541454967330e-07,
  -2.134589088326856e-08,  1.163486968574590e-09, -5.733213381454270e-11,  2.578005147784063e-12, -1.064399287984013e-13,  9.110161720547162e-02, -3.446896442601898e-02,
@@ -363,51 +362,5 @@ void Spin2RootList::spin2root3(const double* ta, double* rr, double* ww, const i
   6.438915595050348e-13, -6.643691799621453e-15,  6.591342216340151e-17, -6.352573913061618e-19,  5.987406342115542e-21, -5.544229454135271e-23,  5.060517307405589e-25,
  -4.563877236694875e-27,  1.030737613195100e-06, -2.045001599708807e-08,  2.840347093088202e-10, -3.381512028714921e-12,  3.690330968548873e-14, -3.807694204364687e-16,
   3.777691126159868e-18, -3.640846023988514e-20,  3.431557803337073e-22, -3.177560164990122e-24,  2.900330604879412e-26, -2.615691756847962e-28  };
-  int offset = -3;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 3;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 3, 0.5);
-      fill_n(ww+offset, 3, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 3; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=3; ++j) {
-        const int boxof = it*36+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(3, 5, ax, aw, x, w, ta, rr, ww, n);
 }
@@ -22,8 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
-#include <cassert>
+#include <src/integral/rys/chebyshevroot.h>
 #include <src/integral/rys/spin2rootlist.h>
 
 using namespace std;
@@ -31,11 +30,11 @@ using namespace bagel;
 
 void Spin2RootList::spin2root9(const double* ta, double* rr, double* ww, const int n) {
 
-  constexpr double ax[9] = {1.474021124075593e+00,4.946915352690749e-01,2.973656939488607e+00,5.036078349072694e+00,7.728623465656647e+00,
+  static constexpr double ax[9] = {1.474021124075593e+00,4.946915352690749e-01,2.973656939488607e+00,5.036078349072694e+00,7.728623465656647e+00,
     1.115932229544608e+01,1.551236039651168e+01,2.114509255962330e+01,2.897615333485633e+01};
-  constexpr double aw[9] = {2.528588711953442e-01,7.732532058348594e-02,2.322651177073763e-01,8.680414559073074e-02,1.436656004370934e-02,
+  static constexpr double aw[9] = {2.528588711953442e-01,7.732532058348594e-02,2.322651177073763e-01,8.680414559073074e-02,1.436656004370934e-02,
     1.022487319404470e-03,2.748467642551893e-05,2.067763821624008e-07,1.967097882902517e-10};
-  constexpr double x[3456] = {  9.046192143052866e-02, -2.061021626986450e-03,  3.354101150862142e-05, -4.511546761448832e-07,  5.073451378048431e-09,
+  static constexpr double x[3456] = {  9.046192143052866e-02, -2.061021626986450e-03,  3.354101150862142e-05, -4.511546761448832e-07,  5.073451378048431e-09,
  -4.431223894947505e-11,  1.962780888699505e-13,  2.676025319564373e-15, -9.140597253049773e-17,  1.590885843996236e-18, -1.998236868290505e-20,  1.702700366023436e-22,
   2.600911729804981e-01, -5.420852867577526e-03,  7.226231903860515e-05, -6.238829831536133e-07,  1.087438290722844e-09,  7.489949945520855e-11, -1.508338360514483e-12,
   1.390905707092456e-14,  2.929603150182266e-17, -3.317470531587862e-18,  5.725251630420324e-20, -4.019152936497961e-22,  4.967514110214928e-01, -8.995343277730045e-03,
@@ -530,7 +529,7 @@ void Spin2RootList::spin2root9(const double* ta, double* rr, double* ww, const i
  -1.543787900976007e-20,  3.569736861121154e-22,  9.199937728561369e-01, -7.301993011941127e-03,  5.795520507093678e-05, -4.599095289173508e-07,  3.643956291867342e-09,
  -2.853324355678103e-11,  2.070638860607256e-13, -8.354259283794948e-16, -2.187880966389385e-17,  1.033040127451565e-18, -3.036221117587026e-20,  7.258650214256719e-22
   };
-  constexpr double w[3456] = {  6.052219858902943e-04, -4.681651985445900e-05,  2.264333979335061e-06, -8.708113127778041e-08,  2.899394369641857e-09,
+  static constexpr double w[3456] = {  6.052219858902943e-04, -4.681651985445900e-05,  2.264333979335061e-06, -8.708113127778041e-08,  2.899394369641857e-09,
  -8.709314366095504e-11,  2.416583871550480e-12, -6.287664311548651e-14,  1.549944988180350e-15, -3.646743358163479e-17,  8.235119278616209e-19, -1.791785831645812e-20,
   4.302331655690900e-03, -4.772238480825293e-04,  3.250869961768858e-05, -1.715587364102560e-06,  7.645388569222245e-08, -3.006482629700976e-09,  1.071006098552018e-10,
  -3.516320605874511e-12,  1.076953271815755e-13, -3.104361374085867e-15,  8.479077070464374e-17, -2.204772427974781e-18,  1.311761393002909e-02, -2.066756333049982e-03,
@@ -1025,51 +1024,5 @@ void Spin2RootList::spin2root9(const double* ta, double* rr, double* ww, const i
   9.614857080485178e-30, -2.312024470109595e-31,  1.249522755128243e-14, -2.479092032253717e-16,  3.443542955054037e-18, -4.102677984233553e-20,  4.502034481651967e-22,
  -4.802649228814730e-24,  5.585767849688346e-26, -8.969858979351999e-28,  2.179696024352933e-29, -6.288928443716431e-31,  1.755363254479545e-32, -4.400536729318722e-34
   };
-  int offset = -9;
-  for (int i = 1; i <= n; ++i) {
-    double t = ta[i-1];
-    offset += 9;
-    if (std::isnan(t)) {
-      fill_n(rr+offset, 9, 0.5);
-      fill_n(ww+offset, 9, 0.0);
-    } else if (t >= 64.0) {
-      t = 1.0/sqrt(t);
-      for (int r = 0; r != 9; ++r) {
-        rr[offset+r] = ax[r]*t*t;
-        ww[offset+r] = aw[r]*t*t*t*t*t;
-      }
-    } else {
-      assert(t >= 0);
-      int it = static_cast<int>(t*   0.500000000000000);
-      t = (t-it*2.000000000000000-   1.000000000000000) *   1.000000000000000;
-      const double t2 = t * 2.0;
-      for (int j=1; j <=9; ++j) {
-        const int boxof = it*108+12*(j-1);
-        double d = x[boxof+11];
-        double e = w[boxof+11];
-        double f = t2*d + x[boxof+10];
-        double g = t2*e + w[boxof+10];
-        d = t2*f - d + x[boxof+9];
-        e = t2*g - e + w[boxof+9];
-        f = t2*d - f + x[boxof+8];
-        g = t2*e - g + w[boxof+8];
-        d = t2*f - d + x[boxof+7];
-        e = t2*g - e + w[boxof+7];
-        f = t2*d - f + x[boxof+6];
-        g = t2*e - g + w[boxof+6];
-        d = t2*f - d + x[boxof+5];
-        e = t2*g - e + w[boxof+5];
-        f = t2*d - f + x[boxof+4];
-        g = t2*e - g + w[boxof+4];
-        d = t2*f - d + x[boxof+3];
-        e = t2*g - e + w[boxof+3];
-        f = t2*d - f + x[boxof+2];
-        g = t2*e - g + w[boxof+2];
-        d = t2*f - d + x[boxof+1];
-        e = t2*g - e + w[boxof+1];
-        rr[offset+j-1] = t*d - f + x[boxof+0]*0.5;
-        ww[offset+j-1] = t*e - g + w[boxof+0]*0.5;
-      }
-    }
-  }
+  chebyshev_roots(9, 5, ax, aw, x, w, ta, rr, ww, n);
 }
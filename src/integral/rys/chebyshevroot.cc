@@ -0,0 +1,135 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: chebyshevroot.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <src/integral/rys/chebyshevroot.h>
+
+using namespace std;
+using namespace bagel;
+using namespace bagel::chebyshev_root;
+
+namespace {
+
+// Clenshaw recurrence for all the roots in a box; xb and wb point to the coefficients of the first root and t is in [-1, 1].
+// Roots and weights are evaluated together so that the two independent recurrences fill the floating-point pipelines.
+inline void clenshaw(const int nroot, const double* xb, const double* wb, const double t, double* rr, double* ww) {
+  const double t2 = t * 2.0;
+  for (int j = 0; j != nroot; ++j, xb += ndeg, wb += ndeg) {
+    double d = xb[11];
+    double e = wb[11];
+    double f = t2*d + xb[10];
+    double g = t2*e + wb[10];
+    for (int k = ndeg-3; k > 1; k -= 2) {
+      d = t2*f - d + xb[k];
+      e = t2*g - e + wb[k];
+      f = t2*d - f + xb[k-1];
+      g = t2*e - g + wb[k-1];
+    }
+    d = t2*f - d + xb[1];
+    e = t2*g - e + wb[1];
+    rr[j] = t*d - f + xb[0]*0.5;
+    ww[j] = t*e - g + wb[0]*0.5;
+  }
+}
+
+}
+
+
+void bagel::chebyshev_roots(const int nroot, const int wpower, const double* ax, const double* aw, const double* x, const double* w,
+                            const double* ta, double* rr, double* ww, const int n) {
+  for (int i = 0; i != n; ++i) {
+    double t = ta[i];
+    double* r = rr + i*nroot;
+    double* v = ww + i*nroot;
+    if (std::isnan(t)) {
+      fill_n(r, nroot, 0.5);
+      fill_n(v, nroot, 0.0);
+    } else if (t >= maxt) {
+      const double s = 1.0/sqrt(t);
+      const double rfac = s*s;
+      double wfac = s;
+      for (int p = 1; p < wpower; ++p)
+        wfac *= s;
+      for (int j = 0; j != nroot; ++j) {
+        r[j] = ax[j]*rfac;
+        v[j] = aw[j]*wfac;
+      }
+    } else {
+      assert(t >= 0);
+      const int it = static_cast<int>(t*0.5);
+      t = t - it*2.0 - 1.0;
+      const size_t boxof = static_cast<size_t>(it)*ndeg*nroot;
+      clenshaw(nroot, x+boxof, w+boxof, t, r, v);
+    }
+  }
+}
+
+
+void bagel::chebyshev_roots_r2(const int nroot, const double* ax, const double* aw, const double* x, const double* w,
+                               const double* ta, double* rr, double* ww, const int n) {
+  // boxes [64*2^k, 64*2^(k+1)) for k < nlog follow the nbox linear ones; the values at their right ends are stored after the coefficients
+  constexpr int nlog = 11;
+  const int ibox0 = static_cast<int>(log(maxt) / log(2.0));
+  const double infty = maxt * (1 << nlog);
+  const size_t refoff = static_cast<size_t>(nbox + nlog) * nroot * ndeg;
+  for (int i = 0; i != n; ++i) {
+    double t = ta[i];
+    double* r = rr + i*nroot;
+    double* v = ww + i*nroot;
+    if (std::isnan(t)) {
+      fill_n(r, nroot, 0.5);
+      fill_n(v, nroot, 0.0);
+    } else if (t >= infty) {
+      for (int j = 0; j != nroot; ++j) {
+        v[j] = aw[nroot-j-1] / t;
+        r[j] = 1.0 - ax[nroot-j-1] / t;
+      }
+    } else {
+      assert(t >= 0);
+      int it;
+      const double bigT = t;
+      if (t >= maxt) {
+        it = static_cast<int>(log(bigT) / log(2.0) + nbox - ibox0);
+        const double width = pow(2.0, it + ibox0 - nbox);
+        t = (t - 1.5 * width) * 2.0 / width;
+      } else {
+        it = static_cast<int>(t*0.5);
+        t = t - it*2.0 - 1.0;
+      }
+      const size_t boxof = static_cast<size_t>(it)*ndeg*nroot;
+      clenshaw(nroot, x+boxof, w+boxof, t, r, v);
+      if (bigT >= maxt) {
+        const double Tref = pow(2.0, it + ibox0 + 1 - nbox);
+        const double* xref = x + refoff + (it - nbox) * nroot;
+        const double* wref = w + refoff + (it - nbox) * nroot;
+        for (int j = 0; j != nroot; ++j) {
+          v[j] = v[j] * wref[nroot-1-j] * Tref / bigT;
+          r[j] = 1.0 + r[j] * (1.0 - xref[nroot-1-j]) * Tref / bigT;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,58 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: chebyshevroot.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __SRC_INTEGRAL_RYS_CHEBYSHEVROOT_H
+#define __SRC_INTEGRAL_RYS_CHEBYSHEVROOT_H
+
+namespace bagel {
+
+/************************************************************************************
+* Evaluation of Rys roots and weights from the generated Chebyshev tables           *
+*   (_eriroot_N.cc, _breitroot_N.cc, _spin2root_N.cc, _r2root_N.cc). All the tables *
+*   share one layout: for each box, the degree-12 expansion coefficients of each    *
+*   root (x) and weight (w) are stored contiguously (box, root, coefficient).       *
+*   The evaluators are shared by all families and all numbers of roots so that the  *
+*   generated files only contain data. For each T, the roots are evaluated one after*
+*   another; the Clenshaw recurrences of a root and its weight are interleaved.     *
+************************************************************************************/
+
+namespace chebyshev_root {
+  // number of coefficients per root in each box
+  constexpr int ndeg = 12;
+  // boxes of width 2 cover 0 <= T < maxt
+  constexpr int nbox = 32;
+  constexpr double maxt = 64.0;
+}
+
+// T >= 64 uses r_i = ax_i / T and w_i = aw_i / T^(wpower/2). wpower is 1 (ERI), 3 (Breit), and 5 (spin-spin).
+void chebyshev_roots(const int nroot, const int wpower, const double* ax, const double* aw, const double* x, const double* w,
+                     const double* ta, double* rr, double* ww, const int n);
+
+// roots and weights for the r^2-weighted (Dawson) family, whose tables have additional boxes in log scale up to T = 64*2^nlog
+void chebyshev_roots_r2(const int nroot, const double* ax, const double* aw, const double* x, const double* w,
+                        const double* ta, double* rr, double* ww, const int n);
+
+}
+
+#endif
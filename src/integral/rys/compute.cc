@@ -25,6 +25,7 @@
 #include <src/integral/carsphlist.h>
 #include <src/integral/sortlist.h>
 #include <src/integral/hrrlist.h>
+#include <src/integral/fusedpost.h>
 #include <src/integral/rys/eribatch.h>
 
 using namespace std;
@@ -67,6 +68,12 @@ void ERIBatch::compute() {
       basisinfo_[3]->contractions(), basisinfo_[3]->contraction_upper(), basisinfo_[3]->contraction_lower(), cont3size_);
   }
 
+  if (fused_post_enabled() && max(basisinfo_[0]->angular_number(), basisinfo_[2]->angular_number()) <= FusedPost::max_angular) {
+    perform_post_fused();
+    stack_->release(size_alloc_, stack_save);
+    return;
+  }
+
   // HRR to indices 01
   // data will be stored in bkup_: cont01{ cont23{ xyzf{ xyzab{ } } } }
   if (basisinfo_[1]->angular_number() != 0) {
@@ -198,3 +205,36 @@ void ERIBatch::compute() {
 }
 
 
+
+
+void ERIBatch::perform_post_fused() {
+  const int ang0 = basisinfo_[0]->angular_number();
+  const int ang1 = basisinfo_[1]->angular_number();
+  const int ang2 = basisinfo_[2]->angular_number();
+  const int ang3 = basisinfo_[3]->angular_number();
+  const int ab = spherical1_ ? (2*ang0+1) * (2*ang1+1) : (ang0+1) * (ang0+2) * (ang1+1) * (ang1+2) / 4;
+  const FusedPost post(stack_);
+
+  double* source = data_;
+  double* target = bkup_;
+
+  // HRR, spherical and transposition for indices 01
+  // data will be stored as cont01{ xyzab{ cont23{ xyzf{ } } } }
+  if (ang0 != 0) {
+    post.bra(source, target, ang0, ang1, spherical1_, AB_, cont0size_ * cont1size_, cont2size_ * cont3size_ * csize_);
+    swap(source, target);
+  }
+
+  // HRR, spherical and sort for indices 23, followed by the transposition of the batch, in which
+  // cont01 and xyzab are sorted at the same time
+  // data will be stored as cont3d{ cont2c{ cont1b{ cont0a{ } } } }
+  if (ang0 != 0) {
+    const vector<int> order = FusedPost::sort_order(ang0, ang1, spherical1_, cont0size_, cont1size_, swap01_);
+    post.ket(source, target, ang2, ang3, spherical2_, CD_, cont0size_ * cont1size_ * ab, cont2size_, cont3size_, swap23_, !swap0123_, order.data());
+  } else {
+    post.ket(source, target, ang2, ang3, spherical2_, CD_, cont0size_ * cont1size_ * ab, cont2size_, cont3size_, swap23_, !swap0123_);
+  }
+  swap(source, target);
+
+  if (source != data_) copy(source, source+size_alloc_, data_);
+}
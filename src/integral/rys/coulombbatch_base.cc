@@ -23,6 +23,7 @@
 //
 
 #include <src/integral/rys/coulombbatch_base.h>
+#include <src/molecule/shellpair.h>
 
 using namespace std;
 using namespace bagel;
@@ -64,6 +65,10 @@ void CoulombBatch_Base<DataType, IntType>::compute_ssss(const double integral_th
   int index = 0;
   vector<shared_ptr<const Atom>> atoms = mol_->atoms();
 
+  // primitive-pair data precomputed for the shell pair, if available
+  bool pair_swapped = false;
+  const ShellPair* pair = IntType == Int_t::Standard ? ShellPair::find({{basisinfo_[0], basisinfo_[1]}}, pair_swapped) : nullptr;
+
   const double onepi2 = 1.0 / (pi__ * pi__);
   const double sqrtpi = sqrt(pi__);
   for (auto expi0 = exp0.begin(); expi0 != exp0.end(); ++expi0) {
@@ -71,9 +76,12 @@ void CoulombBatch_Base<DataType, IntType>::compute_ssss(const double integral_th
       const double cxp = *expi0 + *expi1;
       const double ab = *expi0 * *expi1;
       const double cxp_inv = 1.0 / cxp;
-      const DataType px = get_PQ(basisinfo_[0]->position(0), basisinfo_[1]->position(0), *expi0, *expi1, cxp_inv, 0, 0, swap01_);
-      const DataType py = get_PQ(basisinfo_[0]->position(1), basisinfo_[1]->position(1), *expi0, *expi1, cxp_inv, 0, 1, swap01_);
-      const DataType pz = get_PQ(basisinfo_[0]->position(2), basisinfo_[1]->position(2), *expi0, *expi1, cxp_inv, 0, 2, swap01_);
+      const int ij = pair ? pair->index(expi0 - exp0.begin(), expi1 - exp1.begin(), pair_swapped) : 0;
+      const DataType px = pair ? pair->P(ij)[0] : get_PQ(basisinfo_[0]->position(0), basisinfo_[1]->position(0), *expi0, *expi1, cxp_inv, 0, 0, swap01_);
+      const DataType py = pair ? pair->P(ij)[1] : get_PQ(basisinfo_[0]->position(1), basisinfo_[1]->position(1), *expi0, *expi1, cxp_inv, 0, 1, swap01_);
+      const DataType pz = pair ? pair->P(ij)[2] : get_PQ(basisinfo_[0]->position(2), basisinfo_[1]->position(2), *expi0, *expi1, cxp_inv, 0, 2, swap01_);
+      const double Eab = pair ? pair->K(ij)[0] * pair->K(ij)[1] * pair->K(ij)[2]
+                              : exp(-(AB_[0] * AB_[0] + AB_[1] * AB_[1] + AB_[2] * AB_[2]) * (ab * cxp_inv));
       // For London orbitals, calculate the correction needed for the pre-integral coefficient
       DataType factor_ab;
       if (IntType == Int_t::London) {
@@ -93,7 +101,6 @@ void CoulombBatch_Base<DataType, IntType>::compute_ssss(const double integral_th
         P_[index * 3    ] = px;
         P_[index * 3 + 1] = py;
         P_[index * 3 + 2] = pz;
-        const double Eab = exp(-(AB_[0] * AB_[0] + AB_[1] * AB_[1] + AB_[2] * AB_[2]) * (ab * cxp_inv) );
         const double coeff_real = - 2 * Z * pi__ * cxp_inv * Eab;
         coeff_[index] = coeff_real;
         if (IntType == Int_t::London) coeff_[index] *= exp(factor_ab);
@@ -38,6 +38,9 @@ class ERIBatch : public ERIBatch_base {
     void perform_VRR3();
     void root_weight(const int ps) override;
 
+    // HRR, cartesian-to-spherical transformation and sorting by FusedPost (see fusedpost.h)
+    void perform_post_fused();
+
   public:
 
     // dummy will never be used.
@@ -358,8 +358,7 @@ int main(int argc, char** argv) {
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.\n\
 //\n\
 \n\
-#include <algorithm> \n\
-#include <cassert>" << endl;
+#include <src/integral/rys/chebyshevroot.h>" << endl;
 #ifdef BREIT
 ofs << "#include <src/integral/rys/breitrootlist.h>\n\
 \n\
@@ -394,7 +393,7 @@ void ERIRootList::" << func << nroot << "(const double* ta, double* rr, double*
 #endif
 #endif
   ofs << "\
-  constexpr double ax["<<nroot<<"] = {";
+  static constexpr double ax["<<nroot<<"] = {";
     for (int j=0; j!= nroot; ++j) {
       ofs << scientific << setprecision(15) << setw(20) << aroot[j];
       if (j != nroot-1) ofs << ",";
@@ -402,7 +401,7 @@ void ERIRootList::" << func << nroot << "(const double* ta, double* rr, double*
     }
     ofs << "};" << endl;
     ofs << "\
-  constexpr double aw["<<nroot<<"] = {";
+  static constexpr double aw["<<nroot<<"] = {";
     for (int j=0; j!= nroot; ++j) {
       ofs << scientific << setprecision(15) << setw(20) << aweight[j];
       if (j != nroot-1) ofs << ",";
@@ -495,12 +494,12 @@ void ERIRootList::" << func << nroot << "(const double* ta, double* rr, double*
 #endif
 #ifndef SPIN2
 #ifndef BREIT
-    string tafactor = "t";
+    const int wpower = 1;
 #else
-    string tafactor = "t*t*t";
+    const int wpower = 3;
 #endif
 #else
-    string tafactor = "t*t*t*t*t";
+    const int wpower = 5;
 #endif
 
     int nbox2 = 0;
@@ -516,147 +515,26 @@ void ERIRootList::" << func << nroot << "(const double* ta, double* rr, double*
     }
 #endif
   ofs << "\
-  constexpr double x[" << nroot*nbox1*ndeg + nroot*nbox2 <<"] = {";
+  static constexpr double x[" << nroot*nbox1*ndeg + nroot*nbox2 <<"] = {";
   ofs << listx.str() << "\
   };" << endl;
   ofs << "\
-  constexpr double w[" << nroot*nbox1*ndeg + nroot*nbox2 <<"] = {";
+  static constexpr double w[" << nroot*nbox1*ndeg + nroot*nbox2 <<"] = {";
   ofs << listw.str() << "\
   };" << endl;
 
-  ofs << "\
-  int offset = -" << nroot << ";\n";
+  // the evaluation itself is done by the shared engine in chebyshevroot.cc, which assumes the grid defined at the top of this file
+  static_assert(NGRID == 12 && MAXT == 64 && NBOX == 32, "grid does not match chebyshevroot.h");
 #ifdef DAWSON
+  static_assert(NBOXL == 0 && T_INFTY == 11, "grid does not match chebyshevroot.h");
   ofs << "\
-  const int ibox0 = static_cast<int>(log(" << MAXT << ".0) / log(2.0)); \n";
-#endif
-  ofs << "\
-  for (int i = 1; i <= n; ++i) {\n\
-    double t = ta[i-1];\n\
-    offset += " << nroot << ";\n\
-    if (std::isnan(t)) {\n\
-      fill_n(rr+offset, " << nroot << ", 0.5);\n\
-      fill_n(ww+offset, " << nroot << ", 0.0);\n";
-#ifndef DAWSON
-      ofs << "\
-    } else if (t >= " << MAXT << ".0) {\n\
-      t = 1.0/sqrt(t);\n\
-      for (int r = 0; r != " << nroot << "; ++r) {\n\
-        rr[offset+r] = ax[r]*t*t;\n\
-        ww[offset+r] = aw[r]*" + tafactor + ";\n\
-      }\n\
-    } else {\n\
-      assert(t >= 0);\n\
-      int it = static_cast<int>(t*" << setw(20) << setprecision(15) << fixed << 1.0/stride<< ");\n\
-      t = (t-it*" << stride << "-" << setw(20) << setprecision(15) << fixed << stride/2.0 << ") *" << setw(20) << setprecision(15) << fixed << 2.0/stride << ";\n\
-      \n";
+  chebyshev_roots_r2(" << nroot << ", ax, aw, x, w, ta, rr, ww, n);\n\
+}";
 #else
-      ofs << "\
-    } else if (t >= " << infty << ".0) {\n\
-      for (int r = 0; r != " << nroot << "; ++r) {\n\
-        ww[offset+r] = aw[" << nroot << "-r-1] / t;\n\
-        rr[offset+r] = 1.0 - ax[" << nroot << "-r-1] / t;\n\
-      }\n\
-    } else {\n\
-      assert(t >= 0);\n";
-    if (MAXT < T_INFTY) {
-      ofs << "\
-      vector<double> rr_infty(" << nroot << "); \n\
-      vector<double> ww_infty(" << nroot << "); \n";
-      for (int j = 0; j != nroot; ++j) {
-      ofs << "\
-      ww_infty[" << j << "] = " << setw(20) << setprecision(15) << fixed << dw_infty[j] << "; \n\
-      rr_infty[" << j << "] = " << setw(20) << setprecision(15) << fixed << dx_infty[j] << "; \n";
-      }
-    }
-      ofs << "\
-      int it; \n\
-      double bigT = 0.0; \n";
-      if (NBOXL != 0) {
-      ofs << "\
-      if (" << MAXT << ".0 <= t && t < " << T_ASYM << ".0) { \n\
-        int ka = static_cast<int>((pow((t - " << MAXT << ".0)*6.0, 1.0/3.0) - pow(0.25, 1.0/3.0))/pow(2.0, 1.0/3.0)); \n\
-        int kb = static_cast<int>((pow((t - " << MAXT << ".0)*6.0, 1.0/3.0) - pow(6.0, 1.0/3.0))/pow(2.0, 1.0/3.0)); \n\
-        assert(kb + 1 == ka || kb == ka); \n\
-        it = " << NBOX << " + ka; \n\
-        double a = " << MAXT << ".0 + ka * (ka + 1) * (2*ka + 1)/6.0; \n\
-        double b = " << MAXT << ".0 + (ka + 1) * (ka + 2) * (2*ka + 3)/6.0; \n\
-        t = (t - (a+b)/2) * 2/(a-b);\n\
-      } else if (t >= " << T_ASYM << ".0 && t < " << infty << ".0) { \n";
-      } else {
-      ofs << "\
-      if (t >= " << T_ASYM << ".0 && t < " << infty << ".0) { \n";
-      }
-        ofs << "\
-        bigT = t; \n";
-        if (MAXT < T_INFTY) {
-        ofs << "\
-        it = static_cast<int>(" << NBOX + NBOXL << ");\n\
-        t = (t - (" << T_ASYM << ".0 + " << infty << ".0)/2) * 2/(" << infty << ".0 - " << T_ASYM << ".0);\n";
-        } else {
-        ofs << "\
-        it = static_cast<int>(log(bigT) / log(2.0) + " << NBOX << " - ibox0);\n\
-        t = (t - 1.5 * pow(2.0, it + ibox0 - " << NBOX << "))* 2/pow(2.0, it + ibox0 - " << NBOX << ");\n\
-        cout << \" new t = \" << t << endl; \n";
-        }
-      ofs << "\
-      } else { \n\
-        it = static_cast<int>(t*" << setw(20) << setprecision(15) << fixed << 1.0/stride<< ");\n\
-        t = (t - it *" << stride << "-" << setw(20) << setprecision(15) << fixed << stride/2.0 << ") *" << setw(20) << setprecision(15) << fixed << 2.0/stride << ";\n\
-      } \n";
-#endif
-      ofs << "\
-      const double t2 = t * 2.0;\n\
-      for (int j=1; j <=" << nroot << "; ++j) {\n\
-        const int boxof = it*" << ndeg*nroot << "+" << ndeg << "*(j-1);\n";
-        assert((ndeg/2)*2 == ndeg);
-        for (int i=ndeg; i!=0; --i) {
-          if (i==ndeg) {
-        ofs << "\
-        double d = x[boxof+" << i-1 << "];\n\
-        double e = w[boxof+" << i-1 << "];\n";
-          } else if (i==ndeg-1) {
-        ofs << "\
-        double f = t2*d + x[boxof+" << i-1 << "];\n\
-        double g = t2*e + w[boxof+" << i-1 << "];\n";
-          } else if (i != 1 && ((i/2)*2 == i)) { // odd
-        ofs << "\
-        d = t2*f - d + x[boxof+" << i-1 << "];\n\
-        e = t2*g - e + w[boxof+" << i-1 << "];\n";
-          } else if (i != 1) { // even
-        ofs << "\
-        f = t2*d - f + x[boxof+" << i-1 << "];\n\
-        g = t2*e - g + w[boxof+" << i-1 << "];\n";
-          } else {
-        ofs << "\
-        rr[offset+j-1] = t*d - f + x[boxof+" << i-1 << "]*0.5;\n\
-        ww[offset+j-1] = t*e - g + w[boxof+" << i-1 << "]*0.5;\n";
-#ifdef DAWSON
-            if (MAXT < T_INFTY) {
-        ofs << "\
-        if (" << T_ASYM << ".0 <= bigT && bigT < " << infty << ".0) { \n\
-          ww[offset+j-1] = ww[offset+j-1] * ww_infty[" << nroot << "-j] * " << infty << ".0 / bigT;\n\
-          rr[offset+j-1] = 1.0 + rr[offset+j-1] * (1.0 - rr_infty[" << nroot << "-j]) * " << infty << ".0 /bigT; \n\
-        }\n";
-            } else {
-          ofs << "\
-        if (" << MAXT << ".0 <= bigT && bigT < " << infty << ".0) {\n\
-          const int iref = " << (NBOX + T_INFTY) * nroot * NGRID << " + (it - " << NBOX << ") * " << nroot << " + " << nroot << " - j;\n\
-          double rr_infty = x[iref];\n\
-          double ww_infty = w[iref];\n\
-          double Tref = pow(2.0, it + ibox0 + 1 - " << NBOX << ");\n\
-          ww[offset+j-1] = ww[offset+j-1] * ww_infty * Tref / bigT;\n\
-          rr[offset+j-1] = 1.0 + rr[offset+j-1] * (1.0 - rr_infty) * Tref /bigT;\n\
-        }\n";
-            }
-#endif
-          }
-        }
-      ofs << "\
-      }\n\
-    }\n\
-  }\n\
+  ofs << "\
+  chebyshev_roots(" << nroot << ", " << wpower << ", ax, aw, x, w, ta, rr, ww, n);\n\
 }";
+#endif
 
 ofs.close();
   }
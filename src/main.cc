@@ -35,6 +35,7 @@
 #include <src/util/exception.h>
 #include <src/util/archive.h>
 #include <src/util/io/moldenout.h>
+#include <src/util/parallel/profiler.h>
 
 using namespace std;
 using namespace bagel;
@@ -71,6 +72,7 @@ int main(int argc, char** argv) {
 
       const string title = to_lower(itree->get<string>("title", ""));
       if (title.empty()) throw runtime_error("title is missing in one of the input blocks");
+      ProfileRegion region(title.c_str());
 
       if (title == "molecule") {
         geom = geom ? make_shared<Geometry>(*geom, itree) : make_shared<Geometry>(itree);
@@ -134,7 +136,7 @@ int main(int argc, char** argv) {
 
       } else if (title == "save_ref") {
         const string name = itree->get<string>("file", "reference");
-        OArchive archive(name);
+        OArchive archive(name, itree->get<bool>("compress", false));
         archive << ref;
 #endif
       } else if (title == "dimerize") { // dimerize forms the dimer object, does a scf calculation, and then localizes
@@ -220,11 +222,13 @@ int main(int argc, char** argv) {
     }
 
     print_footer();
+    Profiler::report();
 
   } catch (const Termination& e) {
     cout << "  -- Termination requested --" << endl;
     cout << "  message: " << e.what() << endl;
     print_footer();
+    Profiler::report();
   } catch (const exception& e) {
     resources__->proc()->cout_on();
     if (mpi__->size() > 1)
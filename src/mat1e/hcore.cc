@@ -24,6 +24,7 @@
 
 
 #include <src/mat1e/hcore.h>
+#include <src/mat1e/pointchargenai.h>
 #include <src/integral/os/kineticbatch.h>
 #include <src/integral/os/mmbatch.h>
 #include <src/integral/rys/naibatch.h>
@@ -40,10 +41,22 @@ using namespace bagel;
 
 BOOST_CLASS_EXPORT_IMPLEMENT(Hcore)
 
-Hcore::Hcore(shared_ptr<const Molecule> mol, shared_ptr<const HcoreInfo> hcoreinfo) : Matrix1e(mol), hso_(make_shared<HSO>(mol->nbasis())) {
+Hcore::Hcore(shared_ptr<const Molecule> mol, shared_ptr<const HcoreInfo> hcoreinfo)
+ : Matrix1e(mol), hso_(make_shared<HSO>(mol->nbasis())), charge_thresh_(hcoreinfo->charge_thresh()) {
   if (hcoreinfo->standard() || hcoreinfo->ecp()) {
+    // external point charges are handled by PointChargeNAI
+    vector<shared_ptr<const Atom>> nuclei, charges;
+    for (auto& i : mol->atoms())
+      (i->name() == "q" ? charges : nuclei).push_back(i);
+    if (!charges.empty())
+      nuclei_ = make_shared<const Molecule>(nuclei, vector<shared_ptr<const Atom>>{});
+
     init(mol);
     fill_upper();
+    nuclei_.reset();
+
+    if (!charges.empty())
+      update_charges(mol, charges);
   } else {
     auto hcore = hcoreinfo->compute(mol);
     copy_n(hcore->data(), hcore->size(), data());
@@ -65,12 +78,13 @@ void Hcore::computebatch(const array<shared_ptr<const Shell>,2>& input, const in
   }
 
   {
-    if (mol->natom() < nucleus_blocksize__) {
-      NAIBatch nai(input, mol);
+    shared_ptr<const Molecule> nuclei = nuclei_ ? nuclei_ : mol;
+    if (nuclei->natom() < nucleus_blocksize__) {
+      NAIBatch nai(input, nuclei);
       nai.compute();
       add_block(1.0, offsetb1, offsetb0, dimb1, dimb0, nai.data());
     } else {
-      const vector<shared_ptr<const Molecule>> atom_subsets = mol->split_atoms(nucleus_blocksize__);
+      const vector<shared_ptr<const Molecule>> atom_subsets = nuclei->split_atoms(nucleus_blocksize__);
       for (auto& current_mol : atom_subsets) {
         NAIBatch nai(input, current_mol);
         nai.compute();
@@ -150,3 +164,10 @@ void Hcore::computebatch(const array<shared_ptr<const Shell>,2>& input, const in
 }
 
 
+void Hcore::update_charges(shared_ptr<const Molecule> mol, const vector<shared_ptr<const Atom>>& charges) {
+  auto nai = make_shared<const PointChargeNAI>(mol, charges, charge_thresh_);
+  if (charges_)
+    ax_plus_y(-1.0, charges_);
+  ax_plus_y(1.0, nai);
+  charges_ = nai;
+}
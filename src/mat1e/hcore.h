@@ -35,28 +35,42 @@ namespace bagel {
 class Hcore : public Matrix1e {
   protected:
     std::shared_ptr<HSO> hso_; // for spin-orbit ECP
+    // attraction to the external point charges ("q" atoms), kept separately so that the charges can be updated
+    std::shared_ptr<const Matrix> charges_;
+    // see HcoreInfo::charge_thresh
+    double charge_thresh_;
+    // nuclei used in the NAI during construction
+    std::shared_ptr<const Molecule> nuclei_;
     void computebatch(const std::array<std::shared_ptr<const Shell>,2>&, const int, const int, std::shared_ptr<const Molecule>) override;
 
   private:
     // serialization
     friend class boost::serialization::access;
     template<class Archive>
-    void serialize(Archive& ar, const unsigned int) {
+    void serialize(Archive& ar, const unsigned int version) {
       ar & boost::serialization::base_object<Matrix1e>(*this) & hso_;
+      // version 0 has the point charges in the nuclear attraction
+      if (version > 0)
+        ar & charges_ & charge_thresh_;
     }
 
   public:
-    Hcore() { }
+    Hcore() : charge_thresh_(0.0) { }
     Hcore(std::shared_ptr<const Molecule> mol) : Hcore(mol, std::make_shared<const HcoreInfo>()) { }
     Hcore(std::shared_ptr<const Molecule> mol, std::shared_ptr<const HcoreInfo> hcoreinfo);
 
     std::shared_ptr<HSO> hso() const { return hso_; }
+
+    std::shared_ptr<const Matrix> point_charges() const { return charges_; }
+    // replaces the contribution of the point charges by that of a new set of charges; the rest of hcore is not recomputed
+    void update_charges(std::shared_ptr<const Molecule> mol, const std::vector<std::shared_ptr<const Atom>>& charges);
 };
 
 }
 
 #include <src/util/archive.h>
 BOOST_CLASS_EXPORT_KEY(bagel::Hcore)
+BOOST_CLASS_VERSION(bagel::Hcore, 1)
 
 #endif
 
@@ -29,6 +29,7 @@
 #include <cassert>
 #include <cmath>
 #include <src/mat1e/matrix1e.h>
+#include <src/molecule/shellpair.h>
 #include <src/util/f77.h>
 #include <src/util/parallel/mpi_interface.h>
 #include <src/util/parallel/resources.h>
@@ -54,13 +55,15 @@ template <typename MatType, class Enable = typename std::enable_if<(std::is_same
 class Matrix1eTask_ {
   protected:
     Matrix1e_<MatType>* parent_;
-    size_t ob0, ob1;
-    array<shared_ptr<const Shell>,2> bas;
+    shared_ptr<const ShellPair> pair;
     shared_ptr<const Molecule> mol;
   public:
-    Matrix1eTask_(array<shared_ptr<const Shell>,2> a, size_t b, size_t c, shared_ptr<const Molecule> m, Matrix1e_<MatType>* d)
-      : parent_(d), ob0(b), ob1(c), bas(a), mol(m) { }
-    void compute() const { parent_->computebatch(bas, ob0, ob1, mol); }
+    Matrix1eTask_(shared_ptr<const ShellPair> p, shared_ptr<const Molecule> m, Matrix1e_<MatType>* d)
+      : parent_(d), pair(p), mol(m) { }
+    void compute() const {
+      ShellPairScope scope(pair.get());
+      parent_->computebatch(pair->shells(), pair->offset(1), pair->offset(0), mol);
+    }
 };
 }
 
@@ -69,42 +72,15 @@ template <typename MatType, class Enable>
 void Matrix1e_<MatType, Enable>::init(shared_ptr<const Molecule> mol) {
 
   // CAUTION only lower half will be stored
-  const size_t nshell = accumulate(mol->atoms().begin(), mol->atoms().end(), 0, [](int r, shared_ptr<const Atom> p) { return r+p->nshell(); });
-  TaskQueue<Matrix1eTask_<MatType, Enable>> task(nshell*(nshell+1)/2);
+  // shell pairs with negligible overlap are skipped; their blocks stay zero
+  const vector<shared_ptr<const ShellPair>>& pairs = mol->shellpairs()->pairs();
+  TaskQueue<Matrix1eTask_<MatType, Enable>> task(pairs.size()/mpi__->size()+1);
 
-  size_t oa0 = 0;
   int u = 0;
-  for (auto a0 = mol->atoms().begin(); a0 != mol->atoms().end(); ++a0) {
-    // iatom1 = iatom1;
-    size_t ob0 = oa0;
-    for (auto& b0 : (*a0)->shells()) {
-      size_t ob1 = oa0;
-      for (auto& b1 : (*a0)->shells()) {
-        if (u++ % mpi__->size() == mpi__->rank()) {
-          task.emplace_back(array<shared_ptr<const Shell>,2>{{b1, b0}}, ob0, ob1, mol, this);
-        }
-        ob1 += b1->nbasis();
-      }
-      ob0 += b0->nbasis();
-    }
+  for (auto& p : pairs)
+    if (u++ % mpi__->size() == mpi__->rank())
+      task.emplace_back(p, mol, this);
 
-    auto oa1 = oa0 + (*a0)->nbasis();
-    for (auto a1 = a0+1; a1 != mol->atoms().end(); ++a1) {
-      size_t ob0 = oa0;
-      for (auto& b0 : (*a0)->shells()) {
-        size_t ob1 = oa1;
-        for (auto& b1 : (*a1)->shells()) {
-          if (u++ % mpi__->size() == mpi__->rank()) {
-            task.emplace_back(array<shared_ptr<const Shell>,2>{{b1, b0}}, ob0, ob1, mol, this);
-          }
-          ob1 += b1->nbasis();
-        }
-        ob0 += b0->nbasis();
-      }
-      oa1 += (*a1)->nbasis();
-    }
-    oa0 += (*a0)->nbasis();
-  }
   task.compute();
   allreduce();
 }
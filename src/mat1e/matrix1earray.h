@@ -27,6 +27,7 @@
 #define __SRC_MOLECULE_MATRIX1EARRAY_H
 
 #include <src/mat1e/matrix1e.h>
+#include <src/molecule/shellpair.h>
 #include <src/util/taskqueue.h>
 
 namespace bagel {
@@ -120,42 +121,14 @@ void Matrix1eArray<N, MatType>::init(std::shared_ptr<const Molecule> mol) {
 
   // identical to Matrix1e::init()
   // only lower half will be stored
-  const size_t nshell = accumulate(mol->atoms().begin(), mol->atoms().end(), 0, [](int r, std::shared_ptr<const Atom> p) { return r+p->nshell(); });
-  TaskQueue<Matrix1eArrayTask<N, MatType>> task(nshell*(nshell+1)/2);
+  const std::vector<std::shared_ptr<const ShellPair>>& pairs = mol->shellpairs()->pairs();
+  TaskQueue<Matrix1eArrayTask<N, MatType>> task(pairs.size()/mpi__->size()+1);
 
-  size_t oa0 = 0;
   int u = 0;
-  for (auto a0 = mol->atoms().begin(); a0 != mol->atoms().end(); ++a0) {
-    // iatom1 = iatom1;
-    size_t ob0 = oa0;
-    for (auto& b0 : (*a0)->shells()) {
-      size_t ob1 = oa0;
-      for (auto& b1 : (*a0)->shells()) {
-        if (u++ % mpi__->size() == mpi__->rank()) {
-          task.emplace_back(std::array<std::shared_ptr<const Shell>,2>{{b1, b0}}, ob0, ob1, mol, this);
-        }
-        ob1 += b1->nbasis();
-      }
-      ob0 += b0->nbasis();
-    }
+  for (auto& p : pairs)
+    if (u++ % mpi__->size() == mpi__->rank())
+      task.emplace_back(p, mol, this);
 
-    auto oa1 = oa0 + (*a0)->nbasis();
-    for (auto a1 = a0+1; a1 != mol->atoms().end(); ++a1) {
-      size_t ob0 = oa0;
-      for (auto& b0 : (*a0)->shells()) {
-        size_t ob1 = oa1;
-        for (auto& b1 : (*a1)->shells()) {
-          if (u++ % mpi__->size() == mpi__->rank()) {
-            task.emplace_back(std::array<std::shared_ptr<const Shell>,2>{{b1, b0}}, ob0, ob1, mol, this);
-          }
-          ob1 += b1->nbasis();
-        }
-        ob0 += b0->nbasis();
-      }
-      oa1 += (*a1)->nbasis();
-    }
-    oa0 += (*a0)->nbasis();
-  }
   task.compute();
   for (auto& i : matrices_) i->allreduce();
 
@@ -165,13 +138,20 @@ template <int N, typename MatType = Matrix>
 class Matrix1eArrayTask {
   protected:
     Matrix1eArray<N, MatType>* parent_;
+    std::shared_ptr<const ShellPair> pair;
     size_t ob0, ob1;
     std::array<std::shared_ptr<const Shell>,2> bas;
     std::shared_ptr<const Molecule> mol;
   public:
+    Matrix1eArrayTask<N, MatType>(std::shared_ptr<const ShellPair> p, std::shared_ptr<const Molecule> m, Matrix1eArray<N, MatType>* d)
+      : parent_(d), pair(p), ob0(p->offset(1)), ob1(p->offset(0)), bas(p->shells()), mol(m) { }
+    // used by the derived classes that run over all the shell pairs themselves (e.g., Small1e)
     Matrix1eArrayTask<N, MatType>(std::array<std::shared_ptr<const Shell>,2> a, size_t b, size_t c, std::shared_ptr<const Molecule> m, Matrix1eArray<N, MatType>* d)
       : parent_(d), ob0(b), ob1(c), bas(a), mol(m) { }
-    void compute() const { parent_->computebatch(bas, ob0, ob1, mol); }
+    void compute() const {
+      ShellPairScope scope(pair.get());
+      parent_->computebatch(bas, ob0, ob1, mol);
+    }
 };
 
 }
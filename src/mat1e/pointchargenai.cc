@@ -0,0 +1,282 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: pointchargenai.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#include <limits>
+#include <algorithm>
+#include <src/mat1e/pointchargenai.h>
+#include <src/molecule/shellpair.h>
+#include <src/integral/os/overlapbatch.h>
+#include <src/integral/os/mmbatch.h>
+#include <src/integral/rys/naibatch.h>
+#include <src/util/math/factorial.h>
+
+using namespace std;
+using namespace bagel;
+
+const static Factorial fact;
+
+PointChargeNAI::PointChargeNAI(shared_ptr<const Molecule> mol, const vector<shared_ptr<const Atom>>& charges, const double thresh)
+ : Matrix1e(mol), thresh_(thresh), centre_{{0.0, 0.0, 0.0}}, has_global_(false) {
+
+  // sphere that contains all the shell pairs of the molecule
+  const vector<shared_ptr<const ShellPair>>& pairs = mol->shellpairs()->pairs();
+  for (auto& p : pairs)
+    for (int i = 0; i != 3; ++i)
+      centre_[i] += p->centre(i) / pairs.size();
+  double radius = 0.0;
+  double maxextent = 0.0;
+  for (auto& p : pairs) {
+    const double x = p->centre(0) - centre_[0];
+    const double y = p->centre(1) - centre_[1];
+    const double z = p->centre(2) - centre_[2];
+    radius = max(radius, std::sqrt(x*x + y*y + z*z) + p->extent());
+    maxextent = max(maxextent, p->extent());
+  }
+
+  // Charges beyond rglobal are summed into the Taylor expansion about the centre. Half of the threshold is given to the
+  // truncation of this expansion inside the sphere and of its re-expansion about the centre of a pair (bounded by the sum
+  // of |q|); the other half to the multipoles of the pairs in computebatch.
+  double rglobal = numeric_limits<double>::max();
+  if (thresh_ > 0.0 && radius > 0.0) {
+    double qsum = 0.0;
+    for (auto& c : charges)
+      qsum += fabs(c->atom_charge());
+    auto error = [&](const double r) {
+      return qsum * (pow(radius/r, global_order_+1) / (r-radius) + pow(maxextent/(r-radius), order_+1) / (r-radius-maxextent));
+    };
+    rglobal = 3.0 * radius;
+    while (error(rglobal) > 0.5 * thresh_)
+      rglobal *= 1.2;
+  }
+
+  vector<double> gx, gy, gz, gq;
+  for (auto& c : charges) {
+    const double x = centre_[0] - c->position(0);
+    const double y = centre_[1] - c->position(1);
+    const double z = centre_[2] - c->position(2);
+    if (!pairs.empty() && x*x + y*y + z*z > rglobal*rglobal) {
+      gx.push_back(x);
+      gy.push_back(y);
+      gz.push_back(z);
+      gq.push_back(c->atom_charge());
+    } else {
+      inner_.push_back(c);
+      xyz_.insert(xyz_.end(), c->position().begin(), c->position().end());
+      charge_.push_back(c->atom_charge());
+    }
+  }
+  if (!gq.empty()) {
+    const int lg1 = global_order_ + 1;
+    global_.resize(lg1*lg1*lg1);
+    add_derivatives(gq.size(), gx.data(), gy.data(), gz.data(), gq.data(), global_order_, global_.data());
+    has_global_ = true;
+  }
+
+  init(mol);
+  fill_upper();
+}
+
+
+void PointChargeNAI::add_derivatives(const size_t n, const double* x, const double* y, const double* z, const double* q, const int l, double* out) {
+  // Hermite Coulomb integrals in the point-charge limit, R^m_{tuv}, computed for a batch of charges at a time:
+  //   R^m_{000} = (-1)^m (2m-1)!! / r^{2m+1},  R^m_{t+1,u,v} = t R^{m+1}_{t-1,u,v} + x R^{m+1}_{t,u,v}  (same for u and v)
+  const int l1 = l + 1;
+  const size_t nbatch = max(size_t(1), min(n, size_t(1<<16) / (l1*l1*l1*l1)));
+  vector<double> work(l1*l1*l1*l1*nbatch);
+
+  for (size_t ioff = 0; ioff < n; ioff += nbatch) {
+    const size_t nb = min(nbatch, n - ioff);
+    const double* cx = x + ioff;
+    const double* cy = y + ioff;
+    const double* cz = z + ioff;
+    const double* cq = q + ioff;
+    auto R = [&](const int m, const int t, const int u, const int v) { return work.data() + (((m*l1+t)*l1+u)*l1+v)*nbatch; };
+
+    double* const r0 = R(0,0,0,0);
+    for (size_t i = 0; i != nb; ++i)
+      r0[i] = 1.0 / std::sqrt(cx[i]*cx[i] + cy[i]*cy[i] + cz[i]*cz[i]);
+    for (int m = 1; m <= l; ++m) {
+      const double* prev = R(m-1,0,0,0);
+      double* const current = R(m,0,0,0);
+      const double fac = -(2*m-1);
+      for (size_t i = 0; i != nb; ++i)
+        current[i] = fac * r0[i] * r0[i] * prev[i];
+    }
+
+    for (int k = 1; k <= l; ++k)
+      for (int m = 0; m <= l-k; ++m)
+        for (int t = 0; t <= k; ++t)
+          for (int u = 0; u <= k-t; ++u) {
+            const int v = k-t-u;
+            double* const target = R(m,t,u,v);
+            const double* c;
+            const double* a;
+            const double* b;
+            int fac;
+            if (t > 0) {
+              c = cx; a = R(m+1,t-1,u,v); b = t > 1 ? R(m+1,t-2,u,v) : nullptr; fac = t-1;
+            } else if (u > 0) {
+              c = cy; a = R(m+1,t,u-1,v); b = u > 1 ? R(m+1,t,u-2,v) : nullptr; fac = u-1;
+            } else {
+              c = cz; a = R(m+1,t,u,v-1); b = v > 1 ? R(m+1,t,u,v-2) : nullptr; fac = v-1;
+            }
+            if (b) {
+              for (size_t i = 0; i != nb; ++i)
+                target[i] = c[i] * a[i] + fac * b[i];
+            } else {
+              for (size_t i = 0; i != nb; ++i)
+                target[i] = c[i] * a[i];
+            }
+          }
+
+    for (int t = 0; t <= l; ++t)
+      for (int u = 0; u <= l-t; ++u)
+        for (int v = 0; v <= l-t-u; ++v) {
+          const double* source = R(0,t,u,v);
+          double sum = 0.0;
+          for (size_t i = 0; i != nb; ++i)
+            sum += cq[i] * source[i];
+          out[(t*l1+u)*l1+v] += sum;
+        }
+  }
+}
+
+
+void PointChargeNAI::computebatch(const array<shared_ptr<const Shell>,2>& input, const int offsetb0, const int offsetb1, shared_ptr<const Molecule>) {
+
+  // input = [b1, b0]
+  assert(input.size() == 2);
+  const int dimb1 = input[0]->nbasis();
+  const int dimb0 = input[1]->nbasis();
+
+  bool swapped;
+  const ShellPair* pair = ShellPair::find(input, swapped);
+  shared_ptr<const ShellPair> local;
+  if (!pair) {
+    local = make_shared<const ShellPair>(input, array<int,2>{{offsetb1, offsetb0}}, make_pair(0, 0), "yang", 1.0e-10, false);
+    pair = local.get();
+  }
+  const array<double,3>& p = pair->centre();
+  const double extent = pair->extent();
+  // derivatives of the potential from the charges outside the pair, evaluated at its centre
+  const int l1 = order_ + 1;
+  vector<double> field(l1*l1*l1, 0.0);
+  bool has_field = false;
+
+  if (has_global_) {
+    const int lg1 = global_order_ + 1;
+    vector<double> dx(lg1), dy(lg1), dz(lg1);
+    dx[0] = dy[0] = dz[0] = 1.0;
+    for (int a = 1; a != lg1; ++a) {
+      dx[a] = dx[a-1] * (p[0] - centre_[0]) / a;
+      dy[a] = dy[a-1] * (p[1] - centre_[1]) / a;
+      dz[a] = dz[a-1] * (p[2] - centre_[2]) / a;
+    }
+    for (int t = 0; t <= order_; ++t)
+      for (int u = 0; u <= order_-t; ++u)
+        for (int v = 0; v <= order_-t-u; ++v) {
+          const int rest = global_order_ - t - u - v;
+          double sum = 0.0;
+          for (int a = 0; a <= rest; ++a)
+            for (int b = 0; b <= rest-a; ++b)
+              for (int c = 0; c <= rest-a-b; ++c)
+                sum += global_[((t+a)*lg1+u+b)*lg1+v+c] * dx[a] * dy[b] * dz[c];
+          field[(t*l1+u)*l1+v] += sum;
+        }
+    has_field = true;
+  }
+
+  vector<shared_ptr<const Atom>> near;
+  {
+    // The error of the multipole expansion for a charge q at a distance r from the centre is bounded by
+    // |q| (a/r)^(order+1) / (r-a) with the extent a of the pair. The charges with the smallest bounds are expanded
+    // until their sum reaches half the threshold; the others are computed exactly.
+    const size_t n = charge_.size();
+    vector<std::pair<double,size_t>> bound;
+    bound.reserve(n);
+    for (size_t i = 0; i != n; ++i) {
+      const double x = p[0] - xyz_[3*i];
+      const double y = p[1] - xyz_[3*i+1];
+      const double z = p[2] - xyz_[3*i+2];
+      const double r = std::sqrt(x*x + y*y + z*z);
+      bound.emplace_back(r > extent && thresh_ > 0.0 ? fabs(charge_[i]) * pow(extent/r, order_+1) / (r-extent) : numeric_limits<double>::max(), i);
+    }
+    sort(bound.begin(), bound.end());
+
+    vector<double> fx, fy, fz, fq;
+    fx.reserve(n); fy.reserve(n); fz.reserve(n); fq.reserve(n);
+    double error = 0.0;
+    for (auto& b : bound) {
+      const size_t i = b.second;
+      error += b.first;
+      if (error > 0.5 * thresh_) {
+        near.push_back(inner_[i]);
+      } else {
+        fx.push_back(p[0] - xyz_[3*i]);
+        fy.push_back(p[1] - xyz_[3*i+1]);
+        fz.push_back(p[2] - xyz_[3*i+2]);
+        fq.push_back(charge_[i]);
+      }
+    }
+    if (!fq.empty()) {
+      add_derivatives(fq.size(), fx.data(), fy.data(), fz.data(), fq.data(), order_, field.data());
+      has_field = true;
+    }
+  }
+
+  // charges that penetrate the pair
+  const vector<shared_ptr<const Atom>> empty_aux_atoms;
+  for (size_t i = 0; i < near.size(); i += nucleus_blocksize__) {
+    const size_t n = min(near.size() - i, size_t(nucleus_blocksize__));
+    auto current_mol = make_shared<const Molecule>(vector<shared_ptr<const Atom>>(near.begin() + i, near.begin() + i + n), empty_aux_atoms);
+    NAIBatch nai(input, current_mol);
+    nai.compute();
+    add_block(1.0, offsetb1, offsetb0, dimb1, dimb0, nai.data());
+  }
+
+  // the others through the multipoles of the pair: -\sum_{tuv} M_{tuv} d^{t+u+v}V / (t! u! v!)
+  if (has_field) {
+    const size_t size = dimb0 * dimb1;
+    vector<double> out(size, 0.0);
+
+    OverlapBatch overlap(input);
+    overlap.compute();
+    blas::ax_plus_y_n(-field[0], overlap.data(), size, out.data());
+
+    MMBatch mpole(input, p, order_);
+    mpole.compute();
+    int block = 0;
+    for (int l = 1; l <= order_; ++l)
+      for (int lz = 0; lz <= l; ++lz)
+        for (int ly = 0; ly <= l-lz; ++ly, ++block) {
+          const int lx = l - ly - lz;
+          const double fac = -field[(lx*l1+ly)*l1+lz] / (fact(lx) * fact(ly) * fact(lz));
+          blas::ax_plus_y_n(fac, mpole.data() + mpole.size_block()*block, size, out.data());
+        }
+    assert(block == mpole.num_blocks());
+    add_block(1.0, offsetb1, offsetb0, dimb1, dimb0, out.data());
+  }
+}
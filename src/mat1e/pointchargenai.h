@@ -0,0 +1,67 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: pointchargenai.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef __SRC_MAT1E_POINTCHARGENAI_H
+#define __SRC_MAT1E_POINTCHARGENAI_H
+
+#include <src/mat1e/matrix1e.h>
+
+namespace bagel {
+
+// Attraction integrals for a field of external point charges (the "q" atoms used for QM/MM embedding).
+// With a threshold of zero every charge is computed exactly with NAIBatch. Otherwise charges far from a shell pair enter
+// through the Cartesian multipoles of the pair about its centre, and charges far from the whole molecule are first collected
+// into a single Taylor expansion of their potential, so that the cost per shell pair does not grow with the size of the field.
+// The charges treated this way are chosen such that the estimated truncation error of each integral is below the threshold.
+class PointChargeNAI : public Matrix1e {
+  protected:
+    // order of the multipoles of each shell pair
+    static const int order_ = 4;
+    const double thresh_;
+
+    // charges that are examined for each shell pair
+    std::vector<std::shared_ptr<const Atom>> inner_;
+    std::vector<double> xyz_;
+    std::vector<double> charge_;
+
+    // Taylor expansion of the potential from the remaining charges about centre_
+    static const int global_order_ = 12;
+    std::array<double,3> centre_;
+    std::vector<double> global_;
+    bool has_global_;
+
+    void computebatch(const std::array<std::shared_ptr<const Shell>,2>&, const int, const int, std::shared_ptr<const Molecule>) override;
+
+    // adds \sum_i q_i d^{t+u+v}/dx^t dy^u dz^v (1/r) at r = (x_i, y_i, z_i) to out, which is stored as (t*(l+1)+u)*(l+1)+v
+    static void add_derivatives(const size_t n, const double* x, const double* y, const double* z, const double* q, const int l, double* out);
+
+  public:
+    PointChargeNAI(std::shared_ptr<const Molecule> mol, const std::vector<std::shared_ptr<const Atom>>& charges, const double thresh);
+};
+
+}
+
+#endif
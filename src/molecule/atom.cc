@@ -27,10 +27,18 @@
 #include <src/util/math/quatern.h>
 #include <src/integral/os/overlapbatch.h>
 #include <src/util/atommap.h>
+#include <src/util/input/basislibrary.h>
 
 using namespace std;
 using namespace bagel;
 
+namespace {
+// basis functions of an element; defbas.second (if given) is the parsed basis file of defbas.first
+shared_ptr<const PTree> element_basis(const string& basis, const string& na, const pair<string, shared_ptr<const PTree>>& defbas) {
+  return (basis == defbas.first && defbas.second) ? defbas.second->get_child(na) : BasisLibrary::element(basis, na);
+}
+}
+
 static const AtomMap atommap;
 
 Atom::Atom(shared_ptr<const PTree> inp, const bool spherical, const bool angstrom, const pair<string, shared_ptr<const PTree>> defbas,
@@ -55,10 +63,10 @@ Atom::Atom(shared_ptr<const PTree> inp, const bool spherical, const bool angstro
     nbasis_ = 0;
     lmax_ = 0;
   } else {
-    shared_ptr<const PTree> basisset = (basis_ == defbas.first) ? defbas.second : PTree::read_basis(basis_);
     string na = name_;
     na[0] = toupper(na[0]);
-    (!use_ecp_basis_) ? basis_init(basisset->get_child(na)) : basis_init_ECP(basisset->get_child(na));
+    shared_ptr<const PTree> basisset = element_basis(basis_, na, defbas);
+    (!use_ecp_basis_) ? basis_init(basisset) : basis_init_ECP(basisset);
     if (!use_ecp_basis_ && ecp) {
       ecp_parameters_ = make_shared<const ECP>();
       so_parameters_ = make_shared<const SOECP>();
@@ -88,9 +96,9 @@ Atom::Atom(const Atom& old, const bool spherical, const string bas, const pair<s
         if (name_ == key) basis_ = i->data();
       }
     string na = name_;
-    shared_ptr<const PTree> basisset = (basis_ == defbas.first) ? defbas.second : PTree::read_basis(basis_);
     na[0] = toupper(na[0]);
-    (!use_ecp_basis_) ? basis_init(basisset->get_child(na)) : basis_init_ECP(basisset->get_child(na));
+    shared_ptr<const PTree> basisset = element_basis(basis_, na, defbas);
+    (!use_ecp_basis_) ? basis_init(basisset) : basis_init_ECP(basisset);
   }
 }
 
@@ -262,9 +270,9 @@ Atom::Atom(const bool sph, const string nm, const array<double,3>& p, const stri
 
   string na = name_;
   na[0] = toupper(na[0]);
-  shared_ptr<const PTree> basisset = (basis_ == defbas.first) ? defbas.second : PTree::read_basis(basis_);
+  shared_ptr<const PTree> basisset = element_basis(basis_, na, defbas);
   if (basis_.find("ecp") != string::npos) use_ecp_basis_ = true;
-  (!use_ecp_basis_) ? basis_init(basisset->get_child(na)) : basis_init_ECP(basisset->get_child(na));
+  (!use_ecp_basis_) ? basis_init(basisset) : basis_init_ECP(basisset);
 
   atom_exponent_ = 0.0;
   mass_ = atommap.averaged_mass(name_);
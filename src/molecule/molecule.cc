@@ -22,8 +22,10 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <mutex>
 #include <src/molecule/molecule.h>
 #include <src/molecule/molecule_connect.h>
+#include <src/molecule/shellpair.h>
 #include <src/util/constants.h>
 #include <src/util/atommap.h>
 #include <src/util/math/quatern.h>
@@ -216,6 +218,15 @@ array<double,6> Molecule::quadrupole() const {
 }
 
 
+shared_ptr<const ShellPairList> Molecule::shellpairs() const {
+  static mutex mut;
+  lock_guard<mutex> lock(mut);
+  if (!shellpairs_ || shellpairs_->atoms() != atoms_)
+    shellpairs_ = make_shared<const ShellPairList>(atoms_);
+  return shellpairs_;
+}
+
+
 bool Molecule::has_finite_nucleus() const {
   return any_of(atoms_.begin(), atoms_.end(), [](shared_ptr<const Atom> a) { return a->finite_nucleus(); });
 }
@@ -33,6 +33,8 @@
 
 namespace bagel {
 
+class ShellPairList;
+
 class Molecule {
   protected:
     bool spherical_;
@@ -74,6 +76,9 @@ class Molecule {
     // Constructor helpers
     void common_init1();
 
+    // significant shell pairs for one-electron integrals; built on first use and rebuilt if atoms_ changes
+    mutable std::shared_ptr<const ShellPairList> shellpairs_;
+
   private:
     // serialization
     friend class boost::serialization::access;
@@ -108,7 +113,7 @@ class Molecule {
     const std::string basisfile() const { return basisfile_; }
     const std::string auxfile() const { return auxfile_; }
     virtual double nuclear_repulsion() const { return nuclear_repulsion_; }
-    bool skip_self_interaction() { return skip_self_interaction_; }
+    bool skip_self_interaction() const { return skip_self_interaction_; }
 
     // The position of the specific function in the basis set.
     const std::vector<std::vector<int>>& offsets() const { return offsets_; }
@@ -161,6 +166,8 @@ class Molecule {
 
     std::shared_ptr<Molecule> uncontract() const;
 
+    std::shared_ptr<const ShellPairList> shellpairs() const;
+
 };
 
 }
@@ -24,6 +24,8 @@
 
 
 #include <src/molecule/petite.h>
+#include <src/util/math/matop.h>
+#include <numeric>
 #include <array>
 #include <memory>
 #include <iostream>
@@ -68,72 +70,70 @@ Petite::Petite(const vector<shared_ptr<const Atom>>& atoms, const string sym) :
   nshell_ = vbb.size();
 
   if (sym == c1) {
-    nirrep_ = 1;
+    symop_ = {{1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+  } else if (sym == c2v){
+    SymC2v datc2v;
+    symop_ = datc2v.symop();
+  } else if (sym == d2h) {
+    SymD2h datd2h;
+    symop_ = datd2h.symop();
+  } else if (sym == cs) {
+    SymCs datcs;
+    symop_ = datcs.symop();
+  } else if (sym == ci) {
+    SymCi datci;
+    symop_ = datci.symop();
+  } else if (sym == c2) {
+    SymC2 datc2;
+    symop_ = datc2.symop();
+  } else if (sym == d2) {
+    SymD2 datd2;
+    symop_ = datd2.symop();
+  } else if (sym == c2h) {
+    SymC2h datc2h;
+    symop_ = datc2h.symop();
   } else {
-    if (sym == c2v){
-      SymC2v datc2v;
-      symop_ = datc2v.symop();
-      nirrep_ = datc2v.nirrep();
-    } else if (sym == d2h) {
-      SymD2h datd2h;
-      symop_ = datd2h.symop();
-      nirrep_ = datd2h.nirrep();
-    } else if (sym == cs) {
-      SymCs datcs;
-      symop_ = datcs.symop();
-      nirrep_ = datcs.nirrep();
-    } else if (sym == ci) {
-      SymCi datci;
-      symop_ = datci.symop();
-      nirrep_ = datci.nirrep();
-    } else if (sym == c2) {
-      SymC2 datc2;
-      symop_ = datc2.symop();
-      nirrep_ = datc2.nirrep();
-    } else if (sym == d2) {
-      SymD2 datd2;
-      symop_ = datd2.symop();
-      nirrep_ = datd2.nirrep();
-    } else if (sym == c2h) {
-      SymC2h datc2h;
-      symop_ = datc2h.symop();
-      nirrep_ = datc2h.nirrep();
-    } else {
-      assert(false);
-    }
-    nsymop_ = symop_.size();
+    throw runtime_error("Point group " + sym + " is not supported. Only D2h and its subgroups can be used.");
+  }
+  nsymop_ = symop_.size();
+  init_irreps();
+  nirrep_ = irrep_parity_.size();
+  assert(nirrep_ == nsymop_);
 
-    // making map for atoms
-    for (int iatom = 0; iatom != natom_; ++iatom) {
-      const array<double,3> position = atoms[iatom]->position();
-      vector<int> tmp(nsymop_);
+  // making map for atoms
+  for (int iatom = 0; iatom != natom_; ++iatom) {
+    const array<double,3> position = atoms[iatom]->position();
+    vector<int> tmp(nsymop_);
 
-      for (int iop = 0; iop != nsymop_; ++iop) {
-        const array<double,3> target = matmul33(symop_[iop], position);
-        bool found = false;
-        for (int jatom = 0; jatom != natom_; ++jatom) {
-          const array<double,3> current = atoms[jatom]->position();
-          if (current == target) {
-            found = true;
-            tmp[iop] = jatom;
+    for (int iop = 0; iop != nsymop_; ++iop) {
+      const array<double,3> target = matmul33(symop_[iop], position);
+      bool found = false;
+      for (int jatom = 0; jatom != natom_; ++jatom) {
+        const array<double,3> current = atoms[jatom]->position();
+        if (fabs(current[0]-target[0]) < 1.0e-6 && fabs(current[1]-target[1]) < 1.0e-6 && fabs(current[2]-target[2]) < 1.0e-6) {
+          if (atoms[jatom]->name() != atoms[iatom]->name() || atoms[jatom]->nbasis() != atoms[iatom]->nbasis())
             break;
-          }
+          found = true;
+          tmp[iop] = jatom;
+          break;
         }
-        if (!found)
-          throw logic_error("Petite constructor error");
       }
-      sym_atommap_.push_back(tmp);
+      if (!found)
+        throw runtime_error("The molecule does not have " + sym + " symmetry in the input orientation");
+    }
+    sym_atommap_.push_back(tmp);
 
-      // making map for shells
-      for (int i = 0; i != atoms[iatom]->nshell(); ++i) {
-        vector<int> stmp(nsymop_);
-        for (int iop = 0; iop != nsymop_; ++iop) {
-          stmp[iop] = offset[sym_atommap_[iatom][iop]] + i;
-        }
-        sym_shellmap_.push_back(stmp);
+    // making map for shells
+    for (int i = 0; i != atoms[iatom]->nshell(); ++i) {
+      vector<int> stmp(nsymop_);
+      for (int iop = 0; iop != nsymop_; ++iop) {
+        stmp[iop] = offset[sym_atommap_[iatom][iop]] + i;
       }
-    } // end of atom loop
+      sym_shellmap_.push_back(stmp);
+    }
+  } // end of atom loop
 
+  if (nirrep_ > 1) {
     // now we determine p1 and p2
     p1_.resize(nshell_);
     lambda_.resize(nshell_ * nshell_);
@@ -170,6 +170,196 @@ Petite::Petite(const vector<shared_ptr<const Atom>>& atoms, const string sym) :
 }
 
 
+int Petite::irrep(const int parity) const {
+  for (int i = 0; i != nirrep_; ++i) {
+    bool same = true;
+    for (int iop = 0; iop != nsymop_; ++iop)
+      same &= character(parity, iop) == character(irrep_parity_[i], iop);
+    if (same) return i;
+  }
+  throw logic_error("Petite::irrep failed");
+}
+
+
+vector<int> Petite::parity(const Shell& shell) {
+  const int l = shell.angular_number();
+  // cartesian functions are ordered as x^(l-y-z) y^y z^z with z running slowest
+  vector<int> cart;
+  for (int z = 0; z <= l; ++z)
+    for (int y = 0; y <= l-z; ++y)
+      cart.push_back(((l-y-z)%2 ? 1 : 0) + (y%2 ? 2 : 0) + (z%2 ? 4 : 0));
+
+  vector<int> comp;
+  if (shell.spherical()) {
+    // real solid harmonics are ordered as m = l, -l, l-1, -(l-1), ..., 0;
+    // cos-type (m >= 0) functions are even in y, and sin-type ones are odd in y
+    for (int m = l; m >= 0; --m)
+      for (int sign = 0; sign != (m == 0 ? 1 : 2); ++sign) {
+        const int xodd = sign == 0 ? m%2 : (m+1)%2;
+        comp.push_back(xodd + (sign == 1 ? 2 : 0) + ((l-m)%2 ? 4 : 0));
+      }
+  } else {
+    comp = cart;
+  }
+
+  vector<int> out;
+  for (int i = 0; i != shell.num_contracted(); ++i)
+    out.insert(out.end(), comp.begin(), comp.end());
+  assert(out.size() == shell.nbasis());
+  return out;
+}
+
+
+vector<vector<int>> Petite::shellmap(const vector<shared_ptr<const Atom>>& atoms) const {
+  assert(atoms.size() == natom_);
+  vector<int> offset;
+  int cnt = 0;
+  for (auto& a : atoms) {
+    offset.push_back(cnt);
+    cnt += a->nshell();
+  }
+  vector<vector<int>> out;
+  for (int iatom = 0; iatom != natom_; ++iatom)
+    for (int i = 0; i != atoms[iatom]->nshell(); ++i) {
+      vector<int> tmp(nsymop_);
+      for (int iop = 0; iop != nsymop_; ++iop) {
+        const int jatom = sym_atommap_[iatom][iop];
+        if (atoms[jatom]->nshell() != atoms[iatom]->nshell() || atoms[jatom]->shells()[i]->nbasis() != atoms[iatom]->shells()[i]->nbasis())
+          throw runtime_error("Symmetry-equivalent atoms should have the same basis set");
+        tmp[iop] = offset[jatom] + i;
+      }
+      out.push_back(tmp);
+    }
+  return out;
+}
+
+
+vector<vector<pair<int,int>>> Petite::ao_map(const vector<shared_ptr<const Atom>>& atoms) const {
+  assert(atoms.size() == natom_);
+  vector<int> offset;
+  int cnt = 0;
+  for (auto& a : atoms) {
+    offset.push_back(cnt);
+    cnt += a->nbasis();
+  }
+  vector<vector<pair<int,int>>> out(nsymop_, vector<pair<int,int>>(cnt));
+  for (int iatom = 0; iatom != natom_; ++iatom) {
+    int n = offset[iatom];
+    for (auto& shell : atoms[iatom]->shells()) {
+      const vector<int> par = parity(*shell);
+      for (int iop = 0; iop != nsymop_; ++iop) {
+        const int jatom = sym_atommap_[iatom][iop];
+        for (int i = 0; i != par.size(); ++i)
+          out[iop][n+i] = {offset[jatom] + n + i - offset[iatom], character(par[i], iop)};
+      }
+      n += par.size();
+    }
+  }
+  return out;
+}
+
+
+tuple<shared_ptr<Matrix>, vector<int>> Petite::symmetry_adapted_basis(const vector<shared_ptr<const Atom>>& atoms) const {
+  const vector<vector<pair<int,int>>> map = ao_map(atoms);
+  const int nbasis = map.front().size();
+
+  vector<vector<vector<double>>> salc(nirrep_);
+  for (int i = 0; i != nbasis; ++i) {
+    // only the first function in each orbit generates SALCs
+    bool first = true;
+    for (int iop = 0; iop != nsymop_; ++iop)
+      first &= map[iop][i].first >= i;
+    if (!first) continue;
+
+    for (int ir = 0; ir != nirrep_; ++ir) {
+      vector<double> v(nbasis, 0.0);
+      for (int iop = 0; iop != nsymop_; ++iop)
+        v[map[iop][i].first] += irrep_character(ir, iop) * map[iop][i].second;
+      const double norm = sqrt(inner_product(v.begin(), v.end(), v.begin(), 0.0));
+      if (norm > 1.0e-8) {
+        for (auto& j : v) j /= norm;
+        salc[ir].push_back(v);
+      }
+    }
+  }
+
+  auto out = make_shared<Matrix>(nbasis, nbasis);
+  vector<int> label;
+  for (int ir = 0; ir != nirrep_; ++ir)
+    for (auto& v : salc[ir]) {
+      copy(v.begin(), v.end(), out->element_ptr(0, label.size()));
+      label.push_back(ir);
+    }
+  if (label.size() != nbasis)
+    throw logic_error("Petite::symmetry_adapted_basis failed");
+  return make_tuple(out, label);
+}
+
+
+void Petite::init_irreps() {
+  // irreps are listed in the Cotton order, each with the parity (x=1, y=2, z=4) of a function that transforms as it
+  if (sym_ == "c1") {
+    irrep_parity_ = {0};
+    irrep_name_ = {"a"};
+  } else if (sym_ == "c2v") {
+    irrep_parity_ = {0, 3, 1, 2};
+    irrep_name_ = {"a1", "a2", "b1", "b2"};
+  } else if (sym_ == "d2h") {
+    irrep_parity_ = {0, 3, 5, 6, 7, 4, 2, 1};
+    irrep_name_ = {"ag", "b1g", "b2g", "b3g", "au", "b1u", "b2u", "b3u"};
+  } else if (sym_ == "cs") {
+    irrep_parity_ = {0, 4};
+    irrep_name_ = {"a'", "a\""};
+  } else if (sym_ == "ci") {
+    irrep_parity_ = {0, 7};
+    irrep_name_ = {"ag", "au"};
+  } else if (sym_ == "c2") {
+    irrep_parity_ = {0, 1};
+    irrep_name_ = {"a", "b"};
+  } else if (sym_ == "d2") {
+    irrep_parity_ = {0, 4, 2, 1};
+    irrep_name_ = {"a", "b1", "b2", "b3"};
+  } else if (sym_ == "c2h") {
+    irrep_parity_ = {0, 5, 4, 1};
+    irrep_name_ = {"ag", "bg", "au", "bu"};
+  }
+
+  flip_.clear();
+  for (auto& op : symop_)
+    flip_.push_back((op[0] < 0.0 ? 1 : 0) + (op[4] < 0.0 ? 2 : 0) + (op[8] < 0.0 ? 4 : 0));
+}
+
+
+vector<int> Petite::orbital_irreps(const vector<shared_ptr<const Atom>>& atoms, const Matrix& coeff, const Matrix& overlap) const {
+  const vector<vector<pair<int,int>>> map = ao_map(atoms);
+  const Matrix sc = overlap * coeff;
+
+  vector<int> out(coeff.mdim());
+  for (int i = 0; i != coeff.mdim(); ++i) {
+    // characters of this orbital under each operation
+    vector<double> chi(nsymop_, 0.0);
+    for (int iop = 0; iop != nsymop_; ++iop)
+      for (int j = 0; j != coeff.ndim(); ++j)
+        chi[iop] += sc(map[iop][j].first, i) * map[iop][j].second * coeff(j, i);
+    // weight of the orbital in each irrep (chi[0] is the norm)
+    double max = -1.0;
+    for (int ir = 0; ir != nirrep_; ++ir) {
+      double weight = 0.0;
+      for (int iop = 0; iop != nsymop_; ++iop)
+        weight += irrep_character(ir, iop) * chi[iop];
+      weight /= nsymop_ * chi[0];
+      if (weight > max) {
+        max = weight;
+        out[i] = ir;
+      }
+    }
+    if (max < 1.0 - 1.0e-4)
+      throw runtime_error("Orbital " + to_string(i) + " does not belong to an irrep of " + sym_ + " (largest weight " + to_string(max) + ")");
+  }
+  return out;
+}
+
+
 Petite::~Petite() {
 
 }
@@ -29,6 +29,7 @@
 #include <tuple>
 #include <src/molecule/atom.h>
 #include <src/util/serialization.h>
+#include <boost/serialization/version.hpp>
 
 namespace bagel {
 
@@ -47,16 +48,30 @@ class Petite {
     std::vector<int> p1_;
     std::vector<int> lambda_;
 
+    // all the operations are diagonal; flip_ is the bit mask of the axes (x=1, y=2, z=4) inverted by each operation
+    std::vector<int> flip_;
+    // irreducible representations are labeled by the parity (same bit mask) of a function that transforms as it
+    std::vector<int> irrep_parity_;
+    std::vector<std::string> irrep_name_;
+
   private:
     // serialization
     friend class boost::serialization::access;
 
     template<class Archive>
-    void serialize(Archive& ar, const unsigned int) {
+    void serialize(Archive& ar, const unsigned int version) {
       ar & natom_ & nshell_ & nirrep_ & nsymop_ & sym_ & symop_
          & sym_atommap_ & sym_shellmap_ & p1_ & lambda_;
+      // archives of version 0 do not have the irreps; they are reconstructed from the point group
+      if (version > 0)
+        ar & flip_ & irrep_parity_ & irrep_name_;
+      else if (Archive::is_loading::value)
+        init_irreps();
     }
 
+    // sets irrep_parity_, irrep_name_ and flip_ from sym_ and symop_
+    void init_irreps();
+
   public:
     Petite() { }
     Petite(const std::vector<std::shared_ptr<const Atom>>&, const std::string);
@@ -67,6 +82,7 @@ class Petite {
     std::vector<int> sym_shellmap(const int i) const { return sym_shellmap_[i]; };
     std::vector<int> sym_atommap(const int i) const { return sym_atommap_[i]; };
 
+    const std::string& sym() const { return sym_; }
     int nirrep() const { return nirrep_; };
     int nsymop() const { return nsymop_; };
 
@@ -92,6 +108,29 @@ class Petite {
       return nsymop_ / nijkl;
     };
 
+    // character of a function with a given parity under the operation iop
+    int character(const int parity, const int iop) const { return __builtin_popcount(parity & flip_[iop]) % 2 ? -1 : 1; }
+    int irrep_character(const int irrep, const int iop) const { return character(irrep_parity_[irrep], iop); }
+    int irrep_parity(const int irrep) const { return irrep_parity_[irrep]; }
+    // the irrep to which a function with this parity belongs
+    int irrep(const int parity) const;
+    // direct product of two irreps
+    int product(const int i, const int j) const { return irrep(irrep_parity_[i] ^ irrep_parity_[j]); }
+    const std::string& irrep_name(const int i) const { return irrep_name_[i]; }
+
+    // parities of the basis functions in a shell (in the order of the basis functions)
+    static std::vector<int> parity(const Shell&);
+
+    // images of the shells of "atoms" (or of auxiliary atoms that are placed on them) under each operation; [shell][iop]
+    std::vector<std::vector<int>> shellmap(const std::vector<std::shared_ptr<const Atom>>& atoms) const;
+    // images of the basis functions and the sign they acquire; [iop][function]
+    std::vector<std::vector<std::pair<int,int>>> ao_map(const std::vector<std::shared_ptr<const Atom>>& atoms) const;
+
+    // orthogonal transformation to symmetry-adapted linear combinations of AOs, together with the irrep of each column
+    std::tuple<std::shared_ptr<Matrix>, std::vector<int>> symmetry_adapted_basis(const std::vector<std::shared_ptr<const Atom>>& atoms) const;
+    // irreps of orbitals given in the AO basis
+    std::vector<int> orbital_irreps(const std::vector<std::shared_ptr<const Atom>>& atoms, const Matrix& coeff, const Matrix& overlap) const;
+
 };
 
 
@@ -354,6 +393,8 @@ class SymD2h : public Symmetry {
 
 }
 
+BOOST_CLASS_VERSION(bagel::Petite, 1)
+
 #endif
 
 
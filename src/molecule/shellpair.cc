@@ -33,9 +33,143 @@ using namespace bagel;
 
 const static double pisq__ = pi__ * pi__;
 
-ShellPair::ShellPair(const array<shared_ptr<const Shell>, 2>& sh, const array<int, 2>& ofs, const pair<int, int>& ind, const string ext, const double thr)
- : shells_(sh), offset_(ofs), shell_ind_(ind), extent_type_(ext), thresh_(thr) {
-  init();
+thread_local const ShellPair* ShellPair::current_ = nullptr;
+
+ShellPair::ShellPair(const array<shared_ptr<const Shell>, 2>& sh, const array<int, 2>& ofs, const pair<int, int>& ind, const string ext, const double thr,
+                     const bool schwarz) : shells_(sh), offset_(ofs), shell_ind_(ind), extent_type_(ext), thresh_(thr), schwarz_(0.0) {
+  init_bound();
+  init(schwarz);
+}
+
+
+void ShellPair::init_bound() {
+  const Shell& b0 = *shells_[0];
+  const Shell& b1 = *shells_[1];
+  double rsq = 0.0;
+  for (int i = 0; i != 3; ++i)
+    rsq += pow(b0.position(i) - b1.position(i), 2);
+
+  // contraction vectors are only stored up to the end of their ranges
+  auto maxcoeff = [](const Shell& b, const int j) {
+    double out = 0.0;
+    for (int k = 0; k != b.num_contracted(); ++k)
+      if (j >= b.contraction_ranges(k).first && j < b.contraction_ranges(k).second)
+        out = max(out, fabs(b.contractions()[k][j]));
+    return out;
+  };
+
+  // The ss overlap is (pi/p)^3/2 K; derivative operators bring down at most (1+a0)(1+a1),
+  // and the Coulomb potential of a unit charge at most 2 sqrt(p/pi) relative to the overlap.
+  bound_ = 0.0;
+  for (int i0 = 0; i0 != b0.num_primitive(); ++i0) {
+    const double c0 = maxcoeff(b0, i0);
+    for (int i1 = 0; i1 != b1.num_primitive(); ++i1) {
+      const double a0 = b0.exponents(i0);
+      const double a1 = b1.exponents(i1);
+      const double cxp = a0 + a1;
+      const double ss = pow(pi__/cxp, 1.5) * exp(-a0*a1/cxp*rsq);
+      bound_ += c0 * maxcoeff(b1, i1) * ss * (1.0+a0) * (1.0+a1) * max(1.0, 2.0*sqrt(cxp/pi__));
+    }
+  }
+}
+
+
+void ShellPair::init_primitives() {
+  const Shell& b0 = *shells_[0];
+  const Shell& b1 = *shells_[1];
+  array<double, 3> AB;
+  for (int i = 0; i != 3; ++i)
+    AB[i] = b0.position(i) - b1.position(i);
+
+  const int nprim0 = b0.num_primitive();
+  const int nprim1 = b1.num_primitive();
+  xp_.resize(nprim0*nprim1);
+  P_.resize(3*nprim0*nprim1);
+  K_.resize(3*nprim0*nprim1);
+  for (int i0 = 0, i01 = 0; i0 != nprim0; ++i0) {
+    for (int i1 = 0; i1 != nprim1; ++i1, ++i01) {
+      const double a0 = b0.exponents(i0);
+      const double a1 = b1.exponents(i1);
+      const double cxp = a0 + a1;
+      const double cxp_inv = 1.0 / cxp;
+      xp_[i01] = cxp;
+      for (int i = 0; i != 3; ++i) {
+        P_[3*i01+i] = (b0.position(i)*a0 + b1.position(i)*a1) * cxp_inv;
+        K_[3*i01+i] = exp(-a0*a1*cxp_inv*AB[i]*AB[i]);
+      }
+    }
+  }
+}
+
+
+static tuple<vector<shared_ptr<const Shell>>, vector<int>, vector<int>> flatten_shells(const vector<shared_ptr<const Atom>>& atoms) {
+  // all the shells, their offsets, and the index of the first shell of each atom
+  vector<shared_ptr<const Shell>> shells;
+  vector<int> offsets, start;
+  int offset = 0;
+  for (auto& a : atoms) {
+    start.push_back(shells.size());
+    for (auto& b : a->shells()) {
+      shells.push_back(b);
+      offsets.push_back(offset);
+      offset += b->nbasis();
+    }
+  }
+  start.push_back(shells.size());
+  return make_tuple(shells, offsets, start);
+}
+
+
+ShellPairList::ShellPairList(const vector<shared_ptr<const Atom>>& atoms, const double thresh) : atoms_(atoms), npair_total_(0) {
+  double zmax = 1.0;
+  for (auto& a : atoms)
+    zmax = max(zmax, fabs(a->atom_charge()));
+
+  vector<shared_ptr<const Shell>> shells;
+  vector<int> offsets, start;
+  tie(shells, offsets, start) = flatten_shells(atoms);
+
+  auto add = [&](const int k1, const int k0) {
+    ++npair_total_;
+    auto sp = make_shared<ShellPair>(array<shared_ptr<const Shell>, 2>{{shells[k1], shells[k0]}}, array<int, 2>{{offsets[k1], offsets[k0]}},
+                                     make_pair(0, 0), "yang", 1.0e-10, false);
+    // primitive data only for the pairs that are kept
+    if (sp->bound()*zmax > thresh) {
+      sp->init_primitives();
+      pairs_.push_back(sp);
+      index_.emplace_back(k1, k0);
+    }
+  };
+
+  for (int a0 = 0; a0 != atoms.size(); ++a0) {
+    for (int k0 = start[a0]; k0 != start[a0+1]; ++k0)
+      for (int k1 = start[a0]; k1 != start[a0+1]; ++k1)
+        add(k1, k0);
+
+    for (int a1 = a0+1; a1 != atoms.size(); ++a1)
+      for (int k0 = start[a0]; k0 != start[a0+1]; ++k0)
+        for (int k1 = start[a1]; k1 != start[a1+1]; ++k1)
+          add(k1, k0);
+  }
+}
+
+
+ShellPairList::ShellPairList(const vector<shared_ptr<const Atom>>& atoms, const ShellPairList& o) : atoms_(atoms), index_(o.index_), npair_total_(o.npair_total_) {
+  vector<shared_ptr<const Shell>> shells;
+  vector<int> offsets, start;
+  tie(shells, offsets, start) = flatten_shells(atoms);
+
+  vector<shared_ptr<const Shell>> oshells;
+  tie(oshells, ignore, ignore) = flatten_shells(o.atoms_);
+  if (oshells.size() != shells.size())
+    throw logic_error("ShellPairList can only be reused for the same basis set");
+
+  for (auto& i : index_) {
+    auto sp = make_shared<ShellPair>(array<shared_ptr<const Shell>, 2>{{shells[i.first], shells[i.second]}}, array<int, 2>{{offsets[i.first], offsets[i.second]}},
+                                     make_pair(0, 0), "yang", 1.0e-10, false);
+    sp->init_primitives();
+    pairs_.push_back(sp);
+  }
 }
 
 
@@ -72,7 +206,7 @@ bool ShellPair::is_neighbour(shared_ptr<const ShellPair> sp, const double ws) co
 }
 
 
-void ShellPair::init() {
+void ShellPair::init(const bool schwarz) {
 
   shared_ptr<const Shell> b0 = shells_[0];
   shared_ptr<const Shell> b1 = shells_[1];
@@ -168,6 +302,7 @@ void ShellPair::init() {
 //  extent_ *= scale[b0->angular_number()] * scale[b1->angular_number()];
 
   // schwarz
+  if (!schwarz) return;
   array<shared_ptr<const Shell>,4> input = {{b1, b0, b1, b0}};
 #ifdef LIBINT_INTERFACE
   Libint eribatch(input);
@@ -27,7 +27,8 @@
 #ifndef __SRC_MOLECULE_SHELLPAIR_H
 #define __SRC_MOLECULE_SHELLPAIR_H
 
-#include <src/molecule/shell.h>
+#include <boost/serialization/version.hpp>
+#include <src/molecule/atom.h>
 
 namespace bagel {
 
@@ -44,20 +45,39 @@ class ShellPair {
     double schwarz_;
     std::array<double, 3> centre_;
     double extent_;
-    void init();
+    void init(const bool schwarz);
+
+    // primitive-pair data shared by the one-electron integral codes; pair (i0, i1) is stored at i0*nprim1+i1.
+    // Only the pairs kept by ShellPairList have them.
+    std::vector<double> xp_;
+    std::vector<double> P_;
+    std::vector<double> K_;   // exp(-a0 a1/p AB_i^2) for each direction
+    // upper bound for the one-electron integrals of this pair divided by the charge of the operator (if any)
+    double bound_;
+    void init_bound();
+    void init_primitives();
+
+    static thread_local const ShellPair* current_;
+    friend class ShellPairScope;
+    friend class ShellPairList;
 
   private:
     friend class boost::serialization::access;
     template<class Archive>
-    void serialize(Archive& ar, const unsigned int) {
+    void serialize(Archive& ar, const unsigned int version) {
       ar & shells_ & offset_ & shell_ind_ & extent_type_ & nbasis0_ & nbasis1_
          & thresh_ & schwarz_ & centre_ & extent_;
+      // archives of version 0 do not have the primitive data; the bound is recomputed
+      if (version > 0)
+        ar & xp_ & P_ & K_ & bound_;
+      else if (Archive::is_loading::value)
+        init_bound();
     }
 
   public:
     ShellPair() { }
     ShellPair(const std::array<std::shared_ptr<const Shell>, 2>& shells, const std::array<int, 2>& offset,
-              const std::pair<int, int>& shell_ind, const std::string extent_type = "yang", const double thresh = 1e-10);
+              const std::pair<int, int>& shell_ind, const std::string extent_type = "yang", const double thresh = 1e-10, const bool schwarz = true);
     bool is_neighbour(std::shared_ptr<const ShellPair> sp, const double ws) const;
 
     const std::array<std::shared_ptr<const Shell>, 2>& shells() const { return shells_; }
@@ -74,8 +94,65 @@ class ShellPair {
     int nbasis1() const { return nbasis1_; }
 
     std::vector<std::shared_ptr<const ZMatrix>> multipoles(int lmax = 10, const std::array<double, 3>& Qcentre = {{0,0,0}}) const;
+
+    double bound() const { return bound_; }
+    // index of the primitive pair (i0, i1); when swapped, i0 runs over shell(1) and i1 over shell(0)
+    int index(const int i0, const int i1, const bool swapped) const {
+      return swapped ? i1*shells_[1]->num_primitive()+i0 : i0*shells_[1]->num_primitive()+i1;
+    }
+    double xp(const int i) const { assert(!xp_.empty()); return xp_[i]; }
+    const double* P(const int i) const { return &P_[3*i]; }
+    const double* K(const int i) const { return &K_[3*i]; }
+
+    // The pair that is being computed in this thread (see ShellPairScope), if it consists of the shells in basis.
+    static const ShellPair* find(const std::array<std::shared_ptr<const Shell>,2>& basis, bool& swapped) {
+      if (current_) {
+        if (current_->shells_[0] == basis[0] && current_->shells_[1] == basis[1]) {
+          swapped = false;
+          return current_;
+        } else if (current_->shells_[0] == basis[1] && current_->shells_[1] == basis[0]) {
+          swapped = true;
+          return current_;
+        }
+      }
+      return nullptr;
+    }
+};
+
+
+// Makes the primitive-pair data of a shell pair available to the integral batches constructed in this thread while in scope.
+class ShellPairScope {
+  protected:
+    const ShellPair* previous_;
+  public:
+    ShellPairScope(const ShellPair* p) : previous_(ShellPair::current_) { ShellPair::current_ = p; }
+    ~ShellPairScope() { ShellPair::current_ = previous_; }
+};
+
+
+// Shell pairs of a molecule in the order used by Matrix1e (lower triangle, [b1, b0] with b0 running over the first atom).
+// Pairs whose one-electron integrals are all negligible are not included.
+class ShellPairList {
+  protected:
+    std::vector<std::shared_ptr<const Atom>> atoms_;
+    std::vector<std::shared_ptr<const ShellPair>> pairs_;
+    // indices of the shells [b1, b0] of each pair, counted over the shells of all the atoms
+    std::vector<std::pair<int,int>> index_;
+    size_t npair_total_;
+
+  public:
+    ShellPairList(const std::vector<std::shared_ptr<const Atom>>& atoms, const double thresh = 1.0e-15);
+    // uses the pairs selected in o for a slightly displaced geometry (same atoms and basis), skipping the screening
+    ShellPairList(const std::vector<std::shared_ptr<const Atom>>& atoms, const ShellPairList& o);
+
+    const std::vector<std::shared_ptr<const Atom>>& atoms() const { return atoms_; }
+    const std::vector<std::shared_ptr<const ShellPair>>& pairs() const { return pairs_; }
+    const std::vector<std::pair<int,int>>& index() const { return index_; }
+    size_t npair_total() const { return npair_total_; }
 };
 
 }
 
+BOOST_CLASS_VERSION(bagel::ShellPair, 1)
+
 #endif
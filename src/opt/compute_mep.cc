@@ -111,7 +111,7 @@ void Opt::compute_mep(shared_ptr<XYZFile> mep_start) {
         displ = iterate_displ();
     }
 
-    current_ = make_shared<Geometry>(*current_, displ, make_shared<const PTree>());
+    current_ = make_shared<Geometry>(*current_, displ, displ_geominfo());
     current_->print_atoms();
     if (optinfo()->internal()) {
       if (optinfo()->redundant())
@@ -138,7 +138,7 @@ void Opt::compute_mep(shared_ptr<XYZFile> mep_start) {
           dx = iterate_displ();
       }
 
-      current_ = make_shared<Geometry>(*current_, dx, make_shared<const PTree>());
+      current_ = make_shared<Geometry>(*current_, dx, displ_geominfo());
       current_->print_atoms();
       if (optinfo()->internal()) {
         if (optinfo()->redundant())
@@ -57,7 +57,7 @@ void Opt::compute_optimize() {
     }
 
     prev_displ_.push_back(displ);
-    current_ = make_shared<Geometry>(*current_, displ, make_shared<const PTree>());
+    current_ = make_shared<Geometry>(*current_, displ, displ_geominfo());
     current_->print_atoms();
     if (optinfo()->internal()) {
       if (optinfo()->redundant())
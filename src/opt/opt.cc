@@ -53,8 +53,10 @@ Opt::Opt(shared_ptr<const PTree> idat, shared_ptr<const PTree> inp, shared_ptr<c
     string qmmm_program = to_lower(idat->get<string>("qmmm_program", "tinker"));
     if (qmmm_program == "tinker") {
       qmmm_driver_ = make_shared<const QMMM_Tinker>();
+    } else if (qmmm_program == "internal") {
+      qmmm_driver_ = make_shared<const QMMM_Internal>(idat, geom);
     } else {
-      throw runtime_error("QM/MM optimization is only supported with TINKER program");
+      throw runtime_error("QM/MM optimization is only supported with TINKER program or the internal force field");
     }
   }
 
@@ -110,6 +110,13 @@ class Opt {
 
     std::shared_ptr<XYZFile> iterate_displ() const;
 
+    // input for the Geometry constructed after each displacement
+    std::shared_ptr<const PTree> displ_geominfo() const {
+      auto out = std::make_shared<PTree>();
+      out->put("reuse_thresh", optinfo()->reuse_thresh());
+      return out;
+    }
+
     std::shared_ptr<Matrix> hessian_update() const;
     std::shared_ptr<Matrix> hessian_update_bfgs(std::shared_ptr<const GradFile> y, std::shared_ptr<const GradFile> s, std::shared_ptr<const GradFile> hs) const;
     std::shared_ptr<Matrix> hessian_update_sr1(std::shared_ptr<const GradFile> y, std::shared_ptr<const GradFile> s, std::shared_ptr<const GradFile> z) const;
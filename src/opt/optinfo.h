@@ -138,6 +138,9 @@ class OptInfo : public GradInfo {
     double thresh_displ_;
     double thresh_echange_;
 
+    // screening and integral layouts are reused when interatomic distances change by less than this
+    double reuse_thresh_;
+
     bool scratch_;
     bool numerical_;
 
@@ -192,6 +195,8 @@ class OptInfo : public GradInfo {
         thresh_echange_ = idat->get<double>("maxchange", 0.000001);
       }
 
+      reuse_thresh_ = idat->get<double>("reuse_thresh", 1.0e-2);
+
       adaptive_ = idat->get<bool>("adaptive", algorithm_->is_rfo() ? true : false);
 
       if (opttype_->is_conical()) {
@@ -233,6 +238,7 @@ class OptInfo : public GradInfo {
     double thresh_grad() const { return thresh_grad_; }
     double thresh_displ() const { return thresh_displ_; }
     double thresh_echange() const { return thresh_echange_; }
+    double reuse_thresh() const { return reuse_thresh_; }
 
     bool scratch() const { return scratch_; }
     bool numerical() const { return numerical_; }
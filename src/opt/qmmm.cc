@@ -182,3 +182,278 @@ tuple<double,shared_ptr<GradFile>> QMMM_Tinker::do_grad(const int natom) const {
   // return the energy and gradient
   return tie(mmen, out);
 }
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using Vec3 = array<double,3>;
+
+Vec3 vadd(const Vec3& a, const Vec3& b) { return {{a[0]+b[0], a[1]+b[1], a[2]+b[2]}}; }
+Vec3 vsub(const Vec3& a, const Vec3& b) { return {{a[0]-b[0], a[1]-b[1], a[2]-b[2]}}; }
+Vec3 vscale(const double a, const Vec3& b) { return {{a*b[0], a*b[1], a*b[2]}}; }
+double dot(const Vec3& a, const Vec3& b) { return a[0]*b[0] + a[1]*b[1] + a[2]*b[2]; }
+Vec3 cross(const Vec3& a, const Vec3& b) { return {{a[1]*b[2]-a[2]*b[1], a[2]*b[0]-a[0]*b[2], a[0]*b[1]-a[1]*b[0]}}; }
+
+void add(vector<Vec3>& grad, const int i, const Vec3& g) {
+  for (int k = 0; k != 3; ++k) grad[i][k] += g[k];
+}
+
+// E = k (r - r0)^2
+double bond_term(const vector<Vec3>& pos, const array<int,2>& a, const double k, const double r0, vector<Vec3>& grad) {
+  const Vec3 d = vsub(pos[a[0]], pos[a[1]]);
+  const double r = sqrt(dot(d, d));
+  const double de = 2.0 * k * (r - r0) / r;
+  add(grad, a[0], vscale(de, d));
+  add(grad, a[1], vscale(-de, d));
+  return k * (r - r0) * (r - r0);
+}
+
+// E = k (theta - theta0)^2, where a[1] is the apex
+double angle_term(const vector<Vec3>& pos, const array<int,3>& a, const double k, const double theta0, vector<Vec3>& grad) {
+  const Vec3 u = vsub(pos[a[0]], pos[a[1]]);
+  const Vec3 v = vsub(pos[a[2]], pos[a[1]]);
+  const double ru = sqrt(dot(u, u));
+  const double rv = sqrt(dot(v, v));
+  const double cost = max(-1.0, min(1.0, dot(u, v) / (ru * rv)));
+  const double theta = acos(cost);
+  const double sint = max(sqrt(1.0 - cost*cost), 1.0e-8);
+  // dE/dcos(theta)
+  const double de = - 2.0 * k * (theta - theta0) / sint;
+  const Vec3 gi = vscale(de / ru, vsub(vscale(1.0/rv, v), vscale(cost/ru, u)));
+  const Vec3 gk = vscale(de / rv, vsub(vscale(1.0/ru, u), vscale(cost/rv, v)));
+  add(grad, a[0], gi);
+  add(grad, a[2], gk);
+  add(grad, a[1], vscale(-1.0, vadd(gi, gk)));
+  return k * (theta - theta0) * (theta - theta0);
+}
+
+// E = v (1 + cos(n phi - phase)) for the torsion a[0]-a[1]-a[2]-a[3]
+double dihedral_term(const vector<Vec3>& pos, const array<int,4>& a, const double v, const int n, const double phase, vector<Vec3>& grad) {
+  const Vec3 b1 = vsub(pos[a[1]], pos[a[0]]);
+  const Vec3 b2 = vsub(pos[a[2]], pos[a[1]]);
+  const Vec3 b3 = vsub(pos[a[3]], pos[a[2]]);
+  const Vec3 m = cross(b1, b2);
+  const Vec3 nn = cross(b2, b3);
+  const double rb2 = sqrt(dot(b2, b2));
+  const double m2 = dot(m, m);
+  const double n2 = dot(nn, nn);
+  if (m2 < 1.0e-16 || n2 < 1.0e-16) return v * (1.0 + cos(-phase));  // linear; the torsion is undefined
+  const double phi = atan2(rb2 * dot(b1, nn), dot(m, nn));
+  const double de = - v * n * sin(n * phi - phase);
+
+  // derivatives of phi with respect to the four positions
+  const Vec3 fi = vscale(-rb2 / m2, m);
+  const Vec3 fl = vscale(rb2 / n2, nn);
+  const double p = dot(b1, b2) / (rb2 * rb2);
+  const double q = dot(b3, b2) / (rb2 * rb2);
+  const Vec3 fj = vadd(vscale(-p - 1.0, fi), vscale(q, fl));
+  const Vec3 fk = vadd(vscale(-q - 1.0, fl), vscale(p, fi));
+  add(grad, a[0], vscale(de, fi));
+  add(grad, a[1], vscale(de, fj));
+  add(grad, a[2], vscale(de, fk));
+  add(grad, a[3], vscale(de, fl));
+  return v * (1.0 + cos(n * phi - phase));
+}
+
+}
+
+
+QMMM_Internal::QMMM_Internal(shared_ptr<const PTree> idata, shared_ptr<const Geometry> geom) : QMMM(), natom_(geom->natom()) {
+  auto mm = idata->get_child("mm");
+  // input is in the AMBER convention: kcal/mol, angstrom, and degree; atoms are 1-based
+  const double kcal = kcal2kj__ / au2kjmol__;
+  const double ang = 1.0 / au2angstrom__;
+  const double deg = pi__ / 180.0;
+
+  qm_.resize(natom_);
+  charge_.resize(natom_);
+  for (int i = 0; i != natom_; ++i) {
+    const shared_ptr<const Atom> atom = geom->atoms(i);
+    qm_[i] = !(atom->name() == "q");
+    charge_[i] = qm_[i] ? 0.0 : atom->atom_charge();
+  }
+  if (all_of(qm_.begin(), qm_.end(), [](const bool i) { return i; }))
+    cout << "  * Warning: no point-charge atoms found; the MM region is empty" << endl;
+
+  auto atomindex = [&](const int i) {
+    if (i < 1 || i > natom_) throw runtime_error("atom index in the MM input is out of range");
+    return i-1;
+  };
+
+  sigma_.assign(natom_, 0.0);
+  epsilon_.assign(natom_, 0.0);
+  if (auto lj = mm->get_child_optional("lj"))
+    for (auto& i : *lj)
+      for (auto& j : i->get_vector<int>("atoms")) {
+        sigma_[atomindex(j)] = i->get<double>("sigma") * ang;
+        epsilon_[atomindex(j)] = i->get<double>("epsilon") * kcal;
+      }
+
+  if (auto bonds = mm->get_child_optional("bonds"))
+    for (auto& i : *bonds) {
+      const array<int,2> a = i->get_array<int,2>("atoms");
+      bonds_.push_back({{{atomindex(a[0]), atomindex(a[1])}}, i->get<double>("k") * kcal / (ang*ang), i->get<double>("r0") * ang});
+    }
+  if (auto angles = mm->get_child_optional("angles"))
+    for (auto& i : *angles) {
+      const array<int,3> a = i->get_array<int,3>("atoms");
+      angles_.push_back({{{atomindex(a[0]), atomindex(a[1]), atomindex(a[2])}}, i->get<double>("k") * kcal, i->get<double>("theta0") * deg});
+    }
+  if (auto dihedrals = mm->get_child_optional("dihedrals"))
+    for (auto& i : *dihedrals) {
+      const array<int,4> a = i->get_array<int,4>("atoms");
+      dihedrals_.push_back({{{atomindex(a[0]), atomindex(a[1]), atomindex(a[2]), atomindex(a[3])}}, i->get<double>("v") * kcal, i->get<int>("n"), i->get<double>("phase", 0.0) * deg});
+    }
+
+  // exclusions from the bond topology
+  vector<vector<int>> neighbour(natom_);
+  for (auto& b : bonds_) {
+    neighbour[b.atoms[0]].push_back(b.atoms[1]);
+    neighbour[b.atoms[1]].push_back(b.atoms[0]);
+  }
+  auto key = [&](const int i, const int j) { return static_cast<size_t>(min(i,j))*natom_ + max(i,j); };
+  for (int i = 0; i != natom_; ++i)
+    for (int j : neighbour[i]) {
+      excluded_.insert(key(i, j));
+      for (int k : neighbour[j]) {
+        if (k == i) continue;
+        excluded_.insert(key(i, k));
+        for (int l : neighbour[k])
+          if (l != j && l != i)
+            scaled14_.insert(key(i, l));
+      }
+    }
+  for (auto& i : excluded_)
+    scaled14_.erase(i);
+
+  cutoff_ = mm->get<double>("cutoff", 12.0) * ang;
+  swidth_ = min(mm->get<double>("switch_width", 2.0) * ang, cutoff_);
+  skin_ = mm->get<double>("skin", 2.0) * ang;
+  scale14_lj_ = mm->get<double>("scale14_lj", 0.5);
+  scale14_elec_ = mm->get<double>("scale14_elec", 1.0/1.2);
+  mm_elec_ = geom->skip_self_interaction();
+
+  cout << "  * In-process MM force field: " << bonds_.size() << " bonds, " << angles_.size() << " angles, "
+       << dihedrals_.size() << " dihedrals, cutoff " << cutoff_ * au2angstrom__ << " angstrom" << endl;
+}
+
+
+void QMMM_Internal::build_pair_list(const vector<array<double,3>>& pos) const {
+  pairs_.clear();
+  listpos_ = pos;
+
+  // cell list with the cell size of cutoff + skin
+  const double rlist = cutoff_ + skin_;
+  array<double,3> lo = pos.front(), hi = pos.front();
+  for (auto& p : pos)
+    for (int k = 0; k != 3; ++k) {
+      lo[k] = min(lo[k], p[k]);
+      hi[k] = max(hi[k], p[k]);
+    }
+  array<int,3> ncell;
+  for (int k = 0; k != 3; ++k)
+    ncell[k] = max(1, min(static_cast<int>((hi[k]-lo[k]) / rlist), 100));
+  auto cellindex = [&](const array<double,3>& p, const int k) {
+    return min(ncell[k]-1, static_cast<int>((p[k]-lo[k]) / rlist));
+  };
+
+  vector<vector<int>> cells(ncell[0]*ncell[1]*ncell[2]);
+  for (int i = 0; i != natom_; ++i)
+    cells[cellindex(pos[i], 0) + ncell[0]*(cellindex(pos[i], 1) + ncell[1]*cellindex(pos[i], 2))].push_back(i);
+
+  const double rlist2 = rlist * rlist;
+  for (int i = 0; i != natom_; ++i) {
+    const array<int,3> c = {{cellindex(pos[i], 0), cellindex(pos[i], 1), cellindex(pos[i], 2)}};
+    for (int z = max(0, c[2]-1); z <= min(ncell[2]-1, c[2]+1); ++z)
+      for (int y = max(0, c[1]-1); y <= min(ncell[1]-1, c[1]+1); ++y)
+        for (int x = max(0, c[0]-1); x <= min(ncell[0]-1, c[0]+1); ++x)
+          for (int j : cells[x + ncell[0]*(y + ncell[1]*z)]) {
+            if (j <= i || (qm_[i] && qm_[j])) continue;
+            const size_t key = static_cast<size_t>(i)*natom_ + j;
+            if (excluded_.count(key)) continue;
+            const Vec3 d = vsub(pos[i], pos[j]);
+            if (dot(d, d) < rlist2)
+              pairs_.emplace_back(i, j, scaled14_.count(key) > 0);
+          }
+  }
+}
+
+
+tuple<double,shared_ptr<GradFile>> QMMM_Internal::do_grad(const int natom) const {
+  Timer timer;
+  if (!current_ || natom != natom_ || current_->natom() != natom_)
+    throw logic_error("QMMM_Internal::do_grad called with an inconsistent geometry");
+
+  vector<Vec3> pos(natom_);
+  for (int i = 0; i != natom_; ++i)
+    pos[i] = current_->atoms(i)->position();
+  vector<Vec3> grad(natom_, Vec3{{0.0, 0.0, 0.0}});
+
+  // rebuild the pair list when an atom has moved by more than half the skin
+  bool rebuild = listpos_.size() != pos.size();
+  for (int i = 0; i != natom_ && !rebuild; ++i) {
+    const Vec3 d = vsub(pos[i], listpos_[i]);
+    rebuild = dot(d, d) > 0.25*skin_*skin_;
+  }
+  if (rebuild)
+    build_pair_list(pos);
+
+  // bonded terms that involve at least one MM atom
+  double mmen = 0.0;
+  for (auto& b : bonds_)
+    if (!qm_[b.atoms[0]] || !qm_[b.atoms[1]])
+      mmen += bond_term(pos, b.atoms, b.k, b.r0, grad);
+  for (auto& a : angles_)
+    if (any_of(a.atoms.begin(), a.atoms.end(), [this](const int i) { return !qm_[i]; }))
+      mmen += angle_term(pos, a.atoms, a.k, a.theta0, grad);
+  for (auto& d : dihedrals_)
+    if (any_of(d.atoms.begin(), d.atoms.end(), [this](const int i) { return !qm_[i]; }))
+      mmen += dihedral_term(pos, d.atoms, d.v, d.n, d.phase, grad);
+
+  // non-bonded terms with a switching function between ron and roff
+  const double roff2 = cutoff_ * cutoff_;
+  const double ron2 = (cutoff_ - swidth_) * (cutoff_ - swidth_);
+  const double denom = swidth_ > 0.0 ? 1.0 / pow(roff2 - ron2, 3) : 0.0;
+  for (auto& p : pairs_) {
+    const int i = get<0>(p);
+    const int j = get<1>(p);
+    const Vec3 d = vsub(pos[i], pos[j]);
+    const double r2 = dot(d, d);
+    if (r2 >= roff2) continue;
+    const double r = sqrt(r2);
+
+    double e = 0.0, dedr = 0.0;
+    const double eps = sqrt(epsilon_[i] * epsilon_[j]) * (get<2>(p) ? scale14_lj_ : 1.0);
+    if (eps > 0.0) {
+      const double sigma = 0.5 * (sigma_[i] + sigma_[j]);
+      const double s6 = pow(sigma*sigma / r2, 3);
+      e += 4.0 * eps * (s6*s6 - s6);
+      dedr += 4.0 * eps * (-12.0*s6*s6 + 6.0*s6) / r;
+    }
+    if (mm_elec_ && !qm_[i] && !qm_[j]) {
+      const double qq = charge_[i] * charge_[j] * (get<2>(p) ? scale14_elec_ : 1.0);
+      e += qq / r;
+      dedr -= qq / r2;
+    }
+    if (r2 > ron2) {
+      const double sw = (roff2-r2) * (roff2-r2) * (roff2+2.0*r2-3.0*ron2) * denom;
+      const double dsw = 12.0 * r * (roff2-r2) * (ron2-r2) * denom;
+      dedr = dedr * sw + e * dsw;
+      e *= sw;
+    }
+    mmen += e;
+    add(grad, i, vscale(dedr / r, d));
+    add(grad, j, vscale(-dedr / r, d));
+  }
+
+  auto out = make_shared<GradFile>(natom_);
+  for (int i = 0; i != natom_; ++i)
+    for (int k = 0; k != 3; ++k)
+      out->element(k, i) = grad[i][k];
+
+  stringstream ss; ss << "MM energy = " << setw(10) << setprecision(5) << mmen;
+  timer.tick_print(ss.str());
+  return tie(mmen, out);
+}
@@ -31,6 +31,7 @@
 #include <fstream>
 #include <string>
 #include <algorithm>
+#include <unordered_set>
 #include <src/grad/gradeval.h>
 #include <src/util/timer.h>
 #include <src/util/io/moldenout.h>
@@ -61,5 +62,61 @@ class QMMM_Tinker : public QMMM {
     std::tuple<double,std::shared_ptr<GradFile>> do_grad(const int natom) const override;
 };
 
+
+// In-process AMBER-style force field. Point-charge ("Q") atoms in the geometry are the MM atoms, the rest is the QM region.
+// The QM-MM electrostatics is in the QM Hamiltonian (electrostatic embedding); this class adds the bonded terms that involve
+// at least one MM atom, Lennard-Jones between all pairs except QM-QM, and the MM-MM electrostatics.
+class QMMM_Internal : public QMMM {
+  protected:
+    struct Bond {
+      std::array<int,2> atoms;
+      double k, r0;
+    };
+    struct Angle {
+      std::array<int,3> atoms;
+      double k, theta0;
+    };
+    struct Dihedral {
+      std::array<int,4> atoms;
+      double v;
+      int n;
+      double phase;
+    };
+
+    int natom_;
+    std::vector<bool> qm_;
+    std::vector<double> charge_;
+    std::vector<double> sigma_;
+    std::vector<double> epsilon_;
+    std::vector<Bond> bonds_;
+    std::vector<Angle> angles_;
+    std::vector<Dihedral> dihedrals_;
+    // pairs (i*natom+j, i<j) excluded from the non-bonded terms (1-2 and 1-3) and scaled (1-4)
+    std::unordered_set<size_t> excluded_;
+    std::unordered_set<size_t> scaled14_;
+
+    // non-bonded interactions are switched off between cutoff_-swidth_ and cutoff_; the pair list has a skin of skin_
+    double cutoff_;
+    double swidth_;
+    double skin_;
+    double scale14_lj_;
+    double scale14_elec_;
+    // MM-MM electrostatics is computed in the QM code when the self interaction of point charges is not skipped
+    bool mm_elec_;
+
+    mutable std::shared_ptr<const Geometry> current_;
+    // Verlet pair list (with the 1-4 flag) and the positions at which it was built
+    mutable std::vector<std::tuple<int,int,bool>> pairs_;
+    mutable std::vector<std::array<double,3>> listpos_;
+
+    void build_pair_list(const std::vector<std::array<double,3>>& pos) const;
+
+  public:
+    QMMM_Internal(std::shared_ptr<const PTree> idata, std::shared_ptr<const Geometry> geom);
+
+    void edit_input(std::shared_ptr<const Geometry> current) const override { current_ = current; }
+    std::tuple<double,std::shared_ptr<GradFile>> do_grad(const int natom) const override;
+};
+
 }
 #endif
@@ -984,10 +984,9 @@ void Node::form_df(const string auxfile) {
   }
 
   vector<shared_ptr<const Atom>> aux_atoms;
-  shared_ptr<const PTree> bdata = PTree::read_basis(auxfile);
   int naux =  0;
   for (auto& a : close_atoms) {
-     auto aux_atom = make_shared<const Atom>(*a, a->spherical(), auxfile, make_pair(auxfile, bdata), nullptr);
+     auto aux_atom = make_shared<const Atom>(*a, a->spherical(), auxfile, make_pair(auxfile, nullptr), nullptr);
      aux_atoms.push_back(aux_atom);
      naux += aux_atom->nbasis();
   }
@@ -87,18 +87,18 @@ MOPrint::MOPrint(const shared_ptr<const PTree> idata, const shared_ptr<const Geo
 
   // Determine gridpoints where density will be computed
   const bool angstrom = idata->get<bool>("angstrom", false);
-  array<double,3> start_pos = idata->get_array<double,3>("start_pos", {{-99.0, -99.0, -99.0}});
+  start_pos_ = idata->get_array<double,3>("start_pos", {{-99.0, -99.0, -99.0}});
   inc_size_ = idata->get_array<double,3>("inc_size", {{0.25, 0.25, 0.25}});
 
   if (angstrom) {
     for (int i = 0; i != 3; ++i) {
-      start_pos[i] /= au2angstrom__;
+      start_pos_[i] /= au2angstrom__;
       inc_size_[i] /= au2angstrom__;
     }
   }
 
   // By default, assign positions covering the molecule + 4.0 Bohr on each side
-  if (start_pos == array<double,3>({{-99.0, -99.0, -99.0}})) {
+  if (start_pos_ == array<double,3>({{-99.0, -99.0, -99.0}})) {
     array<double,3> max_pos = geom_->atoms(0)->position();
     array<double,3> min_pos = geom_->atoms(0)->position();
     for (auto& i : geom_->atoms()) {
@@ -112,24 +112,12 @@ MOPrint::MOPrint(const shared_ptr<const PTree> idata, const shared_ptr<const Geo
       }
     }
     for (int i = 0; i != 3; ++i) {
-      start_pos[i] = min_pos[i] - 4.0;
+      start_pos_[i] = min_pos[i] - 4.0;
       ngrid_dim_[i] = static_cast<size_t>((max_pos[i] - min_pos[i] + 8.0) / inc_size_[i]) + 1;
     }
   }
   ngrid_ = ngrid_dim_[0] * ngrid_dim_[1] * ngrid_dim_[2];
 
-  for (int i = 0; i != ngrid_dim_[0]; ++i) {
-    for (int j = 0; j != ngrid_dim_[1]; ++j) {
-      for (int k = 0; k != ngrid_dim_[2]; ++k) {
-        coords_.push_back(start_pos[0]+i*inc_size_[0]);
-        coords_.push_back(start_pos[1]+j*inc_size_[1]);
-        coords_.push_back(start_pos[2]+k*inc_size_[2]);
-      }
-    }
-  }
-
-  assert(ngrid_*3 == coords_.size());
-
   // TODO Reduce redundancy
   // Form density matrices
   if (is_density_) {
@@ -161,6 +149,14 @@ MOPrint::MOPrint(const shared_ptr<const PTree> idata, const shared_ptr<const Geo
     }
   }
 
+  // GIAO basis functions carry a phase and are computed point by point
+  blocked_ = !geom_->london() && !(is_density_ && relativistic_);
+  tilesize_ = idata_->get<int>("tile_size", 256);
+  if (tilesize_ < 1)
+    throw runtime_error("MOPrint: tile_size must be a positive integer.");
+  if (blocked_)
+    form_factor();
+
   const string mtype = relativistic_ ? "relativistic" : "non-relativistic";
   const string stype = paired_ ? "spatial orbital" : "spin-orbital";
   const string griddim = to_string(ngrid_dim_[0]) + " x " + to_string(ngrid_dim_[1]) + " x " + to_string(ngrid_dim_[2]);
@@ -178,54 +174,220 @@ MOPrint::MOPrint(const shared_ptr<const PTree> idata, const shared_ptr<const Geo
 }
 
 
-namespace bagel {
-  class MOPrintTask {
-    protected:
-      MOPrint* parent_;
-      size_t pos_;
+namespace {
+  // radius beyond which all the functions in a shell are below thresh
+  double shell_extent(const Shell& shell, const double thresh = 1.0e-10) {
+    const int l = shell.angular_number();
+    const double nprim = shell.exponents().size();
+    double out = 0.0;
+    for (auto& c : shell.contractions())
+      for (int j = 0; j != c.size(); ++j) {
+        const double coeff = fabs(c[j])*nprim;
+        if (coeff <= thresh) continue;
+        // solve |c| r^l exp(-a r^2) = thresh by fixed-point iteration
+        double r2 = log(coeff/thresh) / shell.exponents(j);
+        for (int iter = 0; iter != 4; ++iter)
+          r2 = (log(coeff/thresh) + 0.5*l*log(max(1.0, r2))) / shell.exponents(j);
+        out = max(out, r2);
+      }
+    return sqrt(out);
+  }
+}
+
+
+void MOPrint::form_factor() {
+  const int nbasis = geom_->nbasis();
+  vector<pair<int,double>> target;
+  vector<vector<double>> columns;
 
-    public:
-      MOPrintTask(size_t pos, MOPrint* par)
-        : parent_(par), pos_(pos) { }
-      void compute() const { parent_->computepoint(pos_); }
+  auto add_column = [&](const int i, const double weight, const complex<double>* coeff) {
+    vector<double> re(nbasis), im(nbasis);
+    for (int j = 0; j != nbasis; ++j) {
+      re[j] = real(coeff[j]);
+      im[j] = imag(coeff[j]);
+    }
+    columns.push_back(re);
+    target.emplace_back(i, weight);
+    if (any_of(im.begin(), im.end(), [](const double& a) { return fabs(a) > numerical_zero__; })) {
+      columns.push_back(im);
+      target.emplace_back(i, weight);
+    }
   };
+
+  auto ref_rel = dynamic_pointer_cast<const RelReference>(ref_);
+  if (is_density_) {
+    // a general density is factored by diagonalization
+    Matrix d = *density_[0]->get_real_part();
+    VectorB eig(nbasis);
+    d.diagonalize(eig);
+    for (int k = 0; k != nbasis; ++k)
+      if (fabs(eig(k)) > numerical_zero__) {
+        columns.emplace_back(d.element_ptr(0, k), d.element_ptr(0, k+1));
+        target.emplace_back(0, eig(k));
+      }
+  } else if (ref_rel) {
+    // large components only; alpha and beta are separate columns
+    auto coeff = ref_rel->relcoeff();
+    const int ncol = paired_ ? 2 : 1;
+    auto add_orbital = [&](const int i, const int orb) {
+      add_column(i, 1.0, coeff->element_ptr(0, orb));
+      add_column(i, 1.0, coeff->element_ptr(nbasis, orb));
+    };
+    for (int i = 0; i != norb_; ++i)
+      for (int j = 0; j != ncol; ++j)
+        add_orbital(i, ncol*orbitals_[i]+j);
+    for (int j = 0; j != 2*coeff->nclosed(); ++j)
+      add_orbital(norb_, j);
+  } else {
+    auto coeff = ref_->coeff();
+    for (int i = 0; i != norb_; ++i) {
+      columns.emplace_back(coeff->element_ptr(0, orbitals_[i]), coeff->element_ptr(0, orbitals_[i]+1));
+      target.emplace_back(i, 2.0);
+    }
+    for (int j = 0; j != ref_->nclosed(); ++j) {
+      columns.emplace_back(coeff->element_ptr(0, j), coeff->element_ptr(0, j+1));
+      target.emplace_back(norb_, 2.0);
+    }
+  }
+
+  factor_ = make_shared<Matrix>(nbasis, columns.size(), true);
+  for (int i = 0; i != columns.size(); ++i)
+    copy_n(columns[i].data(), nbasis, factor_->element_ptr(0, i));
+  factor_target_ = target;
+
+  for (auto& atom : geom_->atoms())
+    for (auto& shell : atom->shells())
+      extent_.push_back(shell_extent(*shell));
+}
+
+
+array<double,3> MOPrint::coordinate(const size_t pos) const {
+  const size_t k = pos % ngrid_dim_[2];
+  const size_t j = (pos / ngrid_dim_[2]) % ngrid_dim_[1];
+  const size_t i = pos / (ngrid_dim_[2] * ngrid_dim_[1]);
+  return {{ start_pos_[0]+i*inc_size_[0], start_pos_[1]+j*inc_size_[1], start_pos_[2]+k*inc_size_[2] }};
 }
 
 
 void MOPrint::compute() {
 
-  assert(!is_density_ && (density_.size() == orbitals_.size()+1 && density_.size() == norb_+1));
-  // The last Task will compute integrated total charge
-  TaskQueue<MOPrintTask> task(ngrid_);
-  points_.resize((ngrid_+1)*(norb_+1), 0.0);
+  assert(density_.size() == norb_+1);
+  computefull();
 
-  for (int i = 0; i != ngrid_; ++i)
-    if (i % mpi__->size() == mpi__->rank())
-      task.emplace_back(i, this);
+  // Tiles are computed in batches that are distributed over processes and threads.
+  // Each batch is reduced and appended to the output files before the next one starts, so the full grid is never stored.
+  const size_t ntile = (ngrid_-1)/tilesize_+1;
+  const size_t nbatch = 4*resources__->max_num_threads()*mpi__->size();
+  vector<shared_ptr<ofstream>> files = open_files();
+  vector<double> density_sum(norb_+1, 0.0);
+
+  for (size_t tstart = 0; tstart < ntile; tstart += nbatch) {
+    const size_t tend = min(ntile, tstart+nbatch);
+    const size_t start = tstart*tilesize_;
+    const size_t end = min(ngrid_, tend*tilesize_);
+    vector<double> buf((end-start)*(norb_+1), 0.0);
+
+    TaskQueue<function<void(void)>> tasks(tend-tstart);
+    for (size_t t = tstart; t != tend; ++t)
+      if (t % mpi__->size() == mpi__->rank()) {
+        const size_t lo = t*tilesize_;
+        const size_t hi = min(ngrid_, lo+tilesize_);
+        double* out = buf.data() + (lo-start)*(norb_+1);
+        tasks.emplace_back([this, lo, hi, out]() {
+          if (blocked_) {
+            compute_tile(lo, hi, out);
+          } else {
+            for (size_t pos = lo; pos != hi; ++pos)
+              computepoint(pos, out + (pos-lo)*(norb_+1));
+          }
+        });
+      }
+    tasks.compute();
+    mpi__->allreduce(buf.data(), buf.size());
 
-  task.compute();
-  mpi__->allreduce(points_.data(), points_.size());
+    print_block(start, end, buf.data(), files, density_sum);
+  }
+  files.clear();
 
-  computefull();
-  cout << "Orbital printout computation finished; generating output files." << endl;
-  print();
+  cout << "Orbital printout computation finished." << endl;
+  cout << fixed;
+  const double scale = inc_size_[0] * inc_size_[1] * inc_size_[2];
+  for (int j = 0; j != norb_; ++j)
+    cout << "Sum of all gridpoints for orbital " << orbitals_[j]+1 << " = " << density_sum[j]*scale << ".  Integrated orbital density = " << integrated_[j] << "." << endl;
+  cout << "Sum of all gridpoints for total density = " << density_sum.back()*scale << ".  Total integrated density = " << integrated_.back() << "." << endl;
+  cout << fixed << setprecision(5);
 }
 
 
-// TODO Reduce redundancy between this and computefull()
-void MOPrint::computepoint(const size_t pos) {
+void MOPrint::compute_tile(const size_t start, const size_t end, double* out) const {
+  const size_t npoint = end - start;
+
+  // bounding box of the tile
+  array<double,3> lo = coordinate(start);
+  array<double,3> hi = lo;
+  for (size_t pos = start+1; pos != end; ++pos) {
+    const array<double,3> r = coordinate(pos);
+    for (int k = 0; k != 3; ++k) {
+      lo[k] = min(lo[k], r[k]);
+      hi[k] = max(hi[k], r[k]);
+    }
+  }
+
+  // shells that reach into the tile
+  vector<tuple<shared_ptr<const Shell>, const Atom*, int>> shells;
+  int nbasis = 0;
+  auto extent = extent_.begin();
+  auto o = geom_->offsets().begin();
+  for (auto a = geom_->atoms().begin(); a != geom_->atoms().end(); ++a, ++o) {
+    double dist2 = 0.0;
+    for (int k = 0; k != 3; ++k) {
+      const double d = max(0.0, max(lo[k]-(*a)->position(k), (*a)->position(k)-hi[k]));
+      dist2 += d*d;
+    }
+    auto offset = o->begin();
+    for (auto b = (*a)->shells().begin(); b != (*a)->shells().end(); ++b, ++offset, ++extent)
+      if (dist2 <= *extent * *extent) {
+        shells.emplace_back(*b, a->get(), *offset);
+        nbasis += (*b)->nbasis();
+      }
+  }
+  if (nbasis == 0) return;
+
+  // basis functions at the gridpoints and the matching rows of the factor
+  Matrix basis(nbasis, npoint, true);
+  Matrix factor(nbasis, factor_->mdim(), true);
+  int row = 0;
+  for (auto& s : shells) {
+    const int n = get<0>(s)->nbasis();
+    for (int i = 0; i != factor_->mdim(); ++i)
+      copy_n(factor_->element_ptr(get<2>(s), i), n, factor.element_ptr(row, i));
+    for (size_t pos = start; pos != end; ++pos) {
+      const array<double,3> r = coordinate(pos);
+      const Atom* atom = get<1>(s);
+      get<0>(s)->compute_grid_value(basis.element_ptr(row, pos-start), nullptr, nullptr, nullptr,
+                                    r[0]-atom->position(0), r[1]-atom->position(1), r[2]-atom->position(2));
+    }
+    row += n;
+  }
+
+  const Matrix amplitude = factor % basis;
+  for (size_t p = 0; p != npoint; ++p)
+    for (int i = 0; i != factor_->mdim(); ++i)
+      out[(norb_+1)*p + factor_target_[i].first] += factor_target_[i].second * amplitude(i, p) * amplitude(i, p);
+}
+
+
+void MOPrint::computepoint(const size_t pos, double* out) const {
   shared_ptr<ZMatrix> ao_density;
   shared_ptr<ZMatrix> input_ovlp;
-  array<double,3> tmp;
+  const array<double,3> tmp = coordinate(pos);
 
   if (!geom_->london()) {
     // Standard basis
-    tmp = {{ coords_[3*pos], coords_[3*pos+1], coords_[3*pos+2] }};
     auto ovlp = make_shared<Overlap_Point>(geom_, tmp);
     input_ovlp = make_shared<ZMatrix>(*ovlp->compute(), 1.0);
   } else {
     // GIAO version
-    tmp = {{ coords_[3*pos], coords_[3*pos+1], coords_[3*pos+2] }};
     auto ovlp = make_shared<Overlap_Point_London>(geom_, tmp);
     input_ovlp = ovlp->compute();
   }
@@ -245,9 +407,9 @@ void MOPrint::computepoint(const size_t pos) {
 
   // Now compute total MO density using AO contributions
   for (int i = 0; i != norb_+1; ++i) {
-    const complex<double> out = density_[i]->dot_product(*ao_density);
-    assert(std::abs(std::imag(out)) < 1.0e-8);
-    points_[(norb_+1)*pos+i] = std::real(out);
+    const complex<double> val = density_[i]->dot_product(*ao_density);
+    assert(std::abs(std::imag(val)) < 1.0e-8);
+    out[i] += std::real(val);
   }
 }
 
@@ -277,90 +439,93 @@ void MOPrint::computefull() {
   }
 
   // Now compute total MO density using AO contributions
+  integrated_.resize(norb_+1);
   for (int i = 0; i != norb_+1; ++i) {
     const complex<double> out = density_[i]->dot_product(*ao_density);
     assert(std::abs(std::imag(out)) < 1.0e-8);
-    points_[(norb_+1)*ngrid_+i] = std::real(out);
+    integrated_[i] = std::real(out);
   }
 }
 
 
-void MOPrint::print() const {
-  vector<double> density_sum = {};
-  density_sum.resize(norb_+1);
-  const bool cube_format = idata_->get<bool>("cube", true);
+vector<shared_ptr<ofstream>> MOPrint::open_files() const {
+  vector<shared_ptr<ofstream>> out;
+  if (!idata_->get<bool>("cube", true)) {
+    string heading = "   x-coord        y-coord        z-coord     ";
+    for (int i = 0; i != norb_; ++i) {
+      heading += "      Orbital " + to_string(orbitals_[i]+1);
+    }
+    heading += "        Total density";
+    cout << heading << endl;
+    return out;
+  }
+  if (mpi__->rank() != 0)
+    return out;
 
   const string mo_filename = idata_->get<string>("mo_filename", "mo");
   const string density_filename = idata_->get<string>("density_filename", "density");
 
-  if (cube_format) {
-    for (int i = 0; i <= norb_; ++i) {
-      const string title = (i == norb_) ? density_filename : mo_filename + "_" + to_string(orbitals_[i]+1);
-      Muffle muffle(title + ".cub");
-      cout << "BAGEL generated cube file." << endl;
-      if (i == norb_)
-        cout << "Full electronic density" << endl;
-      else
-        cout << "Molecular orbital " << orbitals_[i]+1 << endl;
-
-      // Number of atoms, and origin of the volumetric cata
-      cout << fixed << setprecision(6) << setw(5) << geom_->natom() << setw(12) << coords_[0] << setw(12) << coords_[1] << setw(12) << coords_[2] << endl;
-
-      // Three axis vectors, and the number of gridpoints along each
-      // TODO This could be generalized to allow non-perpendicular axis vectors, but probably is not necessary
-      cout << setw(5) << ngrid_dim_[0] << setw(12) << inc_size_[0] << setw(12) << 0.0          << setw(12) << 0.0 << endl;
-      cout << setw(5) << ngrid_dim_[1] << setw(12) << 0.0          << setw(12) << inc_size_[1] << setw(12) << 0.0 << endl;
-      cout << setw(5) << ngrid_dim_[2] << setw(12) << 0.0          << setw(12) << 0.0          << setw(12) << inc_size_[2] << endl;
-
-      // Atomic coordinates
-      for (int j = 0; j != geom_->natom(); ++j) {
-        cout << setw(5) << geom_->atoms(j)->atom_number() << setw(12) << 0.0;
-        for (int k = 0; k != 3; ++k)
-          cout << setw(12) << geom_->atoms(j)->position(k);
-        //cout << setw(12) << geom_->atoms(j)->position(0) << setw(12) << geom_->atoms(j)->position(1) << setw(12) << geom_->atoms(j)->position(2) << endl;
-        cout << endl;
-      }
+  for (int i = 0; i <= norb_; ++i) {
+    const string title = (i == norb_) ? density_filename : mo_filename + "_" + to_string(orbitals_[i]+1);
+    auto file = make_shared<ofstream>(title + ".cub");
+    ofstream& os = *file;
+    os << "BAGEL generated cube file." << endl;
+    if (i == norb_)
+      os << "Full electronic density" << endl;
+    else
+      os << "Molecular orbital " << orbitals_[i]+1 << endl;
+
+    // Number of atoms, and origin of the volumetric cata
+    os << fixed << setprecision(6) << setw(5) << geom_->natom() << setw(12) << start_pos_[0] << setw(12) << start_pos_[1] << setw(12) << start_pos_[2] << endl;
+
+    // Three axis vectors, and the number of gridpoints along each
+    // TODO This could be generalized to allow non-perpendicular axis vectors, but probably is not necessary
+    os << setw(5) << ngrid_dim_[0] << setw(12) << inc_size_[0] << setw(12) << 0.0          << setw(12) << 0.0 << endl;
+    os << setw(5) << ngrid_dim_[1] << setw(12) << 0.0          << setw(12) << inc_size_[1] << setw(12) << 0.0 << endl;
+    os << setw(5) << ngrid_dim_[2] << setw(12) << 0.0          << setw(12) << 0.0          << setw(12) << inc_size_[2] << endl;
+
+    // Atomic coordinates
+    for (int j = 0; j != geom_->natom(); ++j) {
+      os << setw(5) << geom_->atoms(j)->atom_number() << setw(12) << 0.0;
+      for (int k = 0; k != 3; ++k)
+        os << setw(12) << geom_->atoms(j)->position(k);
+      os << endl;
+    }
+    os << scientific << setprecision(5);
+    out.push_back(file);
+  }
+  return out;
+}
 
-      // And now the actual data
-      int cnt = 0;
-      cout << scientific << setprecision(5);
-      for (int j = 0; j != ngrid_; ++j) {
-        cout << setw(13) << points_[(norb_+1)*j + i];
-        density_sum[i] += points_[(norb_+1)*j + i];
-        if (cnt++ % 6 == 5) cout << endl;
-        if (j % ngrid_dim_[2] == ngrid_dim_[2]-1) {
-          cout << endl;
-          cnt = 0;
-        }
+
+void MOPrint::print_block(const size_t start, const size_t end, const double* data, vector<shared_ptr<ofstream>>& files, vector<double>& density_sum) const {
+  for (size_t j = start; j != end; ++j)
+    for (int i = 0; i <= norb_; ++i)
+      density_sum[i] += data[(norb_+1)*(j-start) + i];
+
+  if (idata_->get<bool>("cube", true)) {
+    // six values per line, and a new line for each row along z
+    for (int i = 0; i != files.size(); ++i) {
+      ofstream& os = *files[i];
+      for (size_t j = start; j != end; ++j) {
+        os << setw(13) << data[(norb_+1)*(j-start) + i];
+        const size_t k = j % ngrid_dim_[2];
+        if (k % 6 == 5) os << "\n";
+        if (k == ngrid_dim_[2]-1) os << "\n";
       }
     }
   } else {
     cout << fixed << setprecision(10);
-    string heading = "   x-coord        y-coord        z-coord     ";
-    for (int i = 0; i != norb_; ++i) {
-      heading += "      Orbital " + to_string(orbitals_[i]+1);
-    }
-    heading += "        Total density";
-    cout << heading << endl;
-    for (int i = 0; i != ngrid_; ++i) {
+    for (size_t i = start; i != end; ++i) {
+      const array<double,3> r = coordinate(i);
       string line = "";
       for (int j = 0; j != 3; ++j)
-        line += ((coords_[3*i+j] < 0) ? "" : " ") + to_string(coords_[3*i+j]) + "  ";
+        line += ((r[j] < 0) ? "" : " ") + to_string(r[j]) + "  ";
       for (int j = 0; j <= norb_; ++j) {
-        line += ((points_[(norb_+1)*i+j] < 0) ? "" : " ") + to_string(points_[(norb_+1)*i+j]) + "  ";
-        density_sum[j] += points_[(norb_+1)*i+j];
+        const double val = data[(norb_+1)*(i-start)+j];
+        line += ((val < 0) ? "" : " ") + to_string(val) + "  ";
       }
       cout << line << endl;
     }
   }
-
-
-  cout << fixed;
-  const double scale = inc_size_[0] * inc_size_[1] * inc_size_[2];
-  for (int j = 0; j != norb_; ++j)
-    cout << "Sum of all gridpoints for orbital " << orbitals_[j]+1 << " = " << density_sum[j]*scale << ".  Integrated orbital density = " << points_[(norb_+1)*ngrid_+j] << "." << endl;
-  cout << "Sum of all gridpoints for total density = " << density_sum.back()*scale << ".  Total integrated density = " << points_.back() << "." << endl;
-  cout << fixed << setprecision(5);
-
 }
-
@@ -26,14 +26,13 @@
 #ifndef __SRC_PROP_MOPRINT_H
 #define __SRC_PROP_MOPRINT_H
 
+#include <fstream>
 #include <src/wfn/method.h>
 
 namespace bagel {
 
 class MOPrint : public Method {
 
-  friend class MOPrintTask;
-
   protected:
     bool is_density_;
     bool relativistic_;
@@ -42,20 +41,36 @@ class MOPrint : public Method {
     size_t ngrid_;
     size_t norb_;
 
+    std::array<double,3> start_pos_;
     std::array<double,3> inc_size_;
     std::array<size_t,3> ngrid_dim_;
     std::vector<int> orbitals_;
 
     std::vector<std::shared_ptr<const ZMatrix>> density_;
 
-    std::vector<double> coords_;
+    // Densities in factored form, sum_c weight_c (factor_c . phi)^2, which allows a tile of gridpoints to be done with one GEMM.
+    // Complex coefficients and the two spin components of relativistic orbitals become separate real columns.
+    bool blocked_;
+    size_t tilesize_;
+    std::shared_ptr<Matrix> factor_;
+    std::vector<std::pair<int,double>> factor_target_;
+    // radius beyond which the basis functions of each shell are negligible (ordered as in geom_->atoms())
+    std::vector<double> extent_;
+
+    // integrated density of each orbital and the total density
+    std::vector<double> integrated_;
 
-    // size = ngrid_+1; last entry gives the total integrated charge
-    std::vector<double> points_;
+    std::array<double,3> coordinate(const size_t pos) const;
+    void form_factor();
 
-    void computepoint(const size_t pos);
+    // values at gridpoints [start, end) are added to out, (norb_+1) per gridpoint
+    void compute_tile(const size_t start, const size_t end, double* out) const;
+    void computepoint(const size_t pos, double* out) const;
     void computefull();
-    void print() const;
+
+    std::vector<std::shared_ptr<std::ofstream>> open_files() const;
+    void print_block(const size_t start, const size_t end, const double* data, std::vector<std::shared_ptr<std::ofstream>>& files,
+                     std::vector<double>& density_sum) const;
 
   public:
     MOPrint(const std::shared_ptr<const PTree> idata, const std::shared_ptr<const Geometry> geom, const std::shared_ptr<const Reference> re,
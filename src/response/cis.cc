@@ -55,6 +55,51 @@ CIS::CIS(shared_ptr<const PTree> idata, shared_ptr<const Geometry> geom, shared_
 }
 
 
+vector<shared_ptr<Matrix>> CIS::form_sigma(const vector<shared_ptr<const Matrix>>& amp) const {
+  const int nst = amp.size();
+  vector<shared_ptr<Matrix>> out;
+  if (nst == 0)
+    return out;
+
+  const MatView ocoeff = coeff_->slice(0, nocc_);
+  const MatView vcoeff = coeff_->slice(nocc_, nocc_+nvirt_);
+
+  // trial vectors are stacked as [c_1 c_2 ...] so that the AO back transformation is one GEMM with nst*nocc columns
+  Matrix stacked(nvirt_, nst*nocc_);
+  for (int ist = 0; ist != nst; ++ist)
+    stacked.copy_block(0, ist*nocc_, nvirt_, nocc_, amp[ist]);
+  const Matrix ovcoeff(vcoeff * stacked);
+
+  // J-type term; one batched fitting for all the transition densities
+  vector<shared_ptr<const Matrix>> den;
+  for (int ist = 0; ist != nst; ++ist)
+    den.push_back(make_shared<Matrix>(*ovcoeff.slice_copy(ist*nocc_, (ist+1)*nocc_)->transpose()*2.0));
+  vector<shared_ptr<Matrix>> jop = geom_->df()->compute_Jop(half_, den, false);
+
+  // K-type term; one half transformation of the stacked coefficients
+  auto chalf = geom_->df()->compute_half_transform(ovcoeff);
+  vector<shared_ptr<Matrix>> kop = chalf->form_2index_batch(fulljj_, -1.0, nst);
+
+  Matrix one_occ(coeff_->ndim(), nst*nocc_);
+  for (int ist = 0; ist != nst; ++ist) {
+    *kop[ist] += *jop[ist] * ocoeff;
+    one_occ.copy_block(0, ist*nocc_, coeff_->ndim(), nocc_, kop[ist]);
+  }
+  const Matrix two_body(vcoeff % one_occ);
+
+  for (int ist = 0; ist != nst; ++ist) {
+    shared_ptr<Matrix> tmp = amp[ist]->copy();
+    // one body part
+    for (int i = 0; i != nocc_; ++i)
+      for (int j = 0; j != nvirt_; ++j)
+        (*tmp)(j, i) *= eig_[nocc_+j] - eig_[i];
+    *tmp += *two_body.get_submatrix(0, ist*nocc_, nvirt_, nocc_);
+    out.push_back(tmp);
+  }
+  return out;
+}
+
+
 void CIS::compute() {
   // initial guess
   {
@@ -83,26 +128,16 @@ void CIS::compute() {
   Timer timer;
 
   for (int iter = 0; iter != maxiter_; ++iter) {
+    vector<shared_ptr<const Matrix>> active;
+    for (int ist = 0; ist != nstate_; ++ist)
+      if (!conv[ist])
+        active.push_back(amp_[ist]);
+    vector<shared_ptr<Matrix>> sigma_active = form_sigma(active);
+
     vector<shared_ptr<const Matrix>> sigma;
-    for (int ist = 0; ist != nstate_; ++ist) {
-      if (!conv[ist]) {
-        shared_ptr<Matrix> tmp = amp_[ist]->copy();
-        // one body part
-        for (int i = 0; i != nocc_; ++i)
-          for (int j = 0; j != nvirt_; ++j)
-            (*tmp)(j, i) *= eig_[nocc_+j] - eig_[i];
-        const Matrix ovcoeff(vcoeff * *amp_[ist]);
-        // J-type term
-        Matrix one_occ(*geom_->df()->compute_Jop(half_, make_shared<Matrix>(*ovcoeff.transpose()*2.0), false) * ocoeff);
-        // K-type term
-        auto chalf = geom_->df()->compute_half_transform(ovcoeff);
-        one_occ += *chalf->form_2index(fulljj_, -1.0);
-        *tmp += vcoeff % one_occ;
-        sigma.push_back(tmp);
-      } else {
-        sigma.push_back(nullptr);
-      }
-    }
+    auto iter_sigma = sigma_active.begin();
+    for (int ist = 0; ist != nstate_; ++ist)
+      sigma.push_back(conv[ist] ? nullptr : *iter_sigma++);
     assert(amp_.size() == sigma.size());
 
     energy_ = davidson.compute(amp_, sigma);
@@ -50,6 +50,9 @@ class CIS : public Method {
 
     std::vector<std::shared_ptr<const Matrix>> amp_;
 
+    // sigma vectors of all the given trial vectors with one pass over the 3-index integrals
+    std::vector<std::shared_ptr<Matrix>> form_sigma(const std::vector<std::shared_ptr<const Matrix>>& amp) const;
+
   public:
     CIS(std::shared_ptr<const PTree>, std::shared_ptr<const Geometry>, std::shared_ptr<const Reference>);
 
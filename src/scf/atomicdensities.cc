@@ -40,13 +40,10 @@ AtomicDensities::AtomicDensities(shared_ptr<const Geometry> g) : Matrix(g->nbasi
 
   int offset = 0;
 
-  // read basis file
-  shared_ptr<const PTree> bdata = PTree::read_basis(defbasis);
-
   vector<shared_ptr<const Atom>> aux_atoms;
   if (geom_->auxfile().empty()) {
      for (auto& a : geom_->atoms()) {
-       auto aux_atom = make_shared<const Atom>(*a, a->spherical(), geom_->basisfile(), make_pair(geom_->basisfile(), bdata), nullptr);
+       auto aux_atom = make_shared<const Atom>(*a, a->spherical(), geom_->basisfile(), make_pair(geom_->basisfile(), nullptr), nullptr);
        aux_atoms.push_back(aux_atom);
      }
   } else {
@@ -67,7 +64,7 @@ AtomicDensities::AtomicDensities(shared_ptr<const Geometry> g) : Matrix(g->nbasi
       const string dfbasis = (*ai)->basis();
       geomop->put("df_basis", !dfbasis.empty() ? dfbasis : basis);
 
-      auto atom = make_shared<const Atom>(i->spherical(), i->name(), array<double,3>{{0.0,0.0,0.0}}, basis, make_pair(defbasis, bdata), nullptr);
+      auto atom = make_shared<const Atom>(i->spherical(), i->name(), array<double,3>{{0.0,0.0,0.0}}, basis, make_pair(defbasis, nullptr), nullptr);
       // TODO geometry makes aux atoms, which is ugly
       auto ga = make_shared<const Geometry>(vector<shared_ptr<const Atom>>{atom}, geomop);
       atoms.emplace(make_pair(i->name(),i->basis()), compute_atomic(ga));
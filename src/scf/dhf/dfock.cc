@@ -31,10 +31,14 @@ using namespace bagel;
 const static int batchsize = 250;
 
 DFock::DFock(shared_ptr<const Geometry> a,  shared_ptr<const ZMatrix> hc, const ZMatView coeff, const bool gaunt, const bool breit,
-             const bool store_half, const bool robust, const double scale_exch, const double scale_coulomb, const bool store_half_gaunt)
-  : ZMatrix(*hc), geom_(a), gaunt_(gaunt), breit_(breit), store_half_(store_half), store_half_gaunt_(store_half_gaunt), robust_(robust) {
+             const bool store_half, const bool robust, const double scale_exch, const double scale_coulomb, const bool store_half_gaunt,
+             const bool large_only, const double thresh_small)
+  : ZMatrix(*hc), geom_(a), gaunt_(gaunt), breit_(breit), large_only_(large_only), thresh_small_(thresh_small), nscreened_(0),
+    store_half_(store_half), store_half_gaunt_(store_half_gaunt), robust_(robust) {
 
   assert(breit ? gaunt : true);
+  // half-transformed integrals are stored for all the orbitals
+  assert(!store_half || (!large_only && thresh_small == 0.0));
   two_electron_part(coeff, scale_exch, scale_coulomb);
 }
 
@@ -44,7 +48,7 @@ DFock::DFock(shared_ptr<const Geometry> a,  shared_ptr<const ZMatrix> hc, const
 DFock::DFock(shared_ptr<const Geometry> a, shared_ptr<const ZMatrix> hc, shared_ptr<const ZMatrix> coeff, shared_ptr<const ZMatrix> tcoeff,
              list<shared_ptr<const RelDFHalf>> int1c, list<shared_ptr<const RelDFHalf>> int2c,
              const double scale_exch, const double scale_coulomb)
-  : ZMatrix(*hc), geom_(a), gaunt_(false), breit_(false), store_half_(false), store_half_gaunt_(false), robust_(false) {
+  : ZMatrix(*hc), geom_(a), gaunt_(false), breit_(false), large_only_(false), thresh_small_(0.0), nscreened_(0), store_half_(false), store_half_gaunt_(false), robust_(false) {
 
   // will use the zgemm3m-like algorithm
   for (auto& i : int1c)
@@ -68,20 +72,42 @@ void DFock::two_electron_part(const ZMatView coeff, const double scale_exchange,
 
   assert(geom_->nbasis()*4 == coeff.ndim());
 
-  auto ocoeffall = make_shared<ZMatrix>(coeff);
-  const int nocc = coeff.mdim();
-  const int nbatch = (nocc-1) / batchsize+1;
-  StaticDist dist(nocc, nbatch);
-  vector<pair<size_t, size_t>> table = dist.atable();
-
-  for (auto& itable : table) {
-    // slice of the coefficients
-    auto c = make_shared<ZMatrix>(ocoeffall->slice(itable.first, itable.first+itable.second));
-    driver(c, false, false, scale_exchange, scale_coulomb);
-    if (gaunt_) {
-      driver(c, gaunt_, breit_, scale_exchange, scale_coulomb);
-    }
+  // Both J and K are sums over orbitals. Orbitals with a negligible small-component weight (all of them if large_only_)
+  // are processed with the small-component coefficients set to zero, for which only the (LL| type half-transformed
+  // integrals are needed and the Gaunt and Breit terms vanish.
+  const int n = geom_->nbasis();
+  vector<int> full, large;
+  for (int i = 0; i != coeff.mdim(); ++i) {
+    const double weight = large_only_ ? 0.0 : real(blas::dot_product(coeff.element_ptr(2*n, i), 2*n, coeff.element_ptr(2*n, i)));
+    if (!large_only_ && weight >= thresh_small_)
+      full.push_back(i);
+    else
+      large.push_back(i);
   }
+  nscreened_ = large_only_ ? 0 : large.size();
+
+  auto process = [&](const vector<int>& orbitals, const bool large_only) {
+    if (orbitals.empty()) return;
+    auto ocoeffall = make_shared<ZMatrix>(coeff.ndim(), orbitals.size());
+    for (int i = 0; i != orbitals.size(); ++i)
+      copy_n(coeff.element_ptr(0, orbitals[i]), coeff.ndim(), ocoeffall->element_ptr(0, i));
+
+    const int nocc = orbitals.size();
+    const int nbatch = (nocc-1) / batchsize+1;
+    StaticDist dist(nocc, nbatch);
+    vector<pair<size_t, size_t>> table = dist.atable();
+
+    for (auto& itable : table) {
+      // slice of the coefficients
+      auto c = make_shared<ZMatrix>(ocoeffall->slice(itable.first, itable.first+itable.second));
+      driver(c, false, false, scale_exchange, scale_coulomb, large_only);
+      if (gaunt_ && !large_only) {
+        driver(c, gaunt_, breit_, scale_exchange, scale_coulomb);
+      }
+    }
+  };
+  process(full, false);
+  process(large, true);
 }
 
 
@@ -199,7 +225,7 @@ list<shared_ptr<RelDFHalf>> DFock::make_half_complex(list<shared_ptr<RelDF>> dfd
 }
 
 
-void DFock::driver(shared_ptr<const ZMatrix> coeff, bool gaunt, bool breit, const double scale_exchange, const double scale_coulomb)  {
+void DFock::driver(shared_ptr<const ZMatrix> coeff, bool gaunt, bool breit, const double scale_exchange, const double scale_coulomb, const bool large_only)  {
 
   Timer timer(0);
 
@@ -213,6 +239,11 @@ void DFock::driver(shared_ptr<const ZMatrix> coeff, bool gaunt, bool breit, cons
   }
 
   list<shared_ptr<RelDF>> dfdists = make_dfdists(dfs, gaunt);
+  // without small-component coefficients, only the (LL| block contributes to the half-transformed integrals
+  if (large_only) {
+    assert(!gaunt);
+    dfdists.remove_if([](shared_ptr<RelDF> i) { return i->cartesian().first != Comp::L; });
+  }
   // Note that we are NOT using dagger-ed coefficients! -1 factor for imaginary will be compensated by RelCDMatrix and Exop
   list<shared_ptr<RelDFHalf>> half_complex = make_half_complex(dfdists, coeff);
 
@@ -235,7 +266,7 @@ void DFock::driver(shared_ptr<const ZMatrix> coeff, bool gaunt, bool breit, cons
   }
   half_complex.clear();
 
-  assert(gaunt  || half_complex_exch.size() == 8);
+  assert(gaunt  || large_only || half_complex_exch.size() == 8);
   assert(!gaunt || half_complex_exch.size() == 24);
 
   if (breit) {
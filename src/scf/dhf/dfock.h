@@ -36,12 +36,19 @@ class DFock : public ZMatrix {
     const bool gaunt_;
     const bool breit_;
 
+    // if true, small-component coefficients are neglected in the two-electron part for all the orbitals (no Gaunt and Breit either)
+    const bool large_only_;
+    // orbitals whose small-component weight is below this threshold are treated as if large_only_ were true
+    const double thresh_small_;
+    // number of orbitals that were treated without small-component integrals because of thresh_small_
+    int nscreened_;
+
     void two_electron_part(const ZMatView coeff, const double scale_ex, const double scale_coulomb);
 
 
     void add_Jop_block(std::shared_ptr<const RelDF>, std::list<std::shared_ptr<const RelCDMatrix>>, const double scale);
     void add_Exop_block(std::shared_ptr<const RelDFHalf>, std::shared_ptr<const RelDFHalf>, const double scale, const bool diag = false);
-    void driver(std::shared_ptr<const ZMatrix> coeff, bool gaunt, bool breit, const double scale_exchange, const double scale_coulomb);
+    void driver(std::shared_ptr<const ZMatrix> coeff, bool gaunt, bool breit, const double scale_exchange, const double scale_coulomb, const bool large_only = false);
 
     // when gradient is requested, we store half-transformed integrals
     // TODO want to avoid "mutable" but this lets us discard integrals later to free up memory
@@ -56,11 +63,13 @@ class DFock : public ZMatrix {
 
   public:
     DFock(std::shared_ptr<const Geometry> a,  std::shared_ptr<const ZMatrix> hc, const ZMatView coeff, const bool gaunt, const bool breit,
-          const bool store_half, const bool robust = false, const double scale_exch = 1.0, const double scale_coulomb = 1.0, const bool store_half_gaunt = false);
+          const bool store_half, const bool robust = false, const double scale_exch = 1.0, const double scale_coulomb = 1.0, const bool store_half_gaunt = false,
+          const bool large_only = false, const double thresh_small = 0.0);
     // same as above
     DFock(std::shared_ptr<const Geometry> a, std::shared_ptr<const ZMatrix> hc, std::shared_ptr<const ZMatrix> coeff, const bool gaunt, const bool breit,
-          const bool store_half, const bool robust = false, const double scale_exch = 1.0, const double scale_coulomb = 1.0, const bool store_half_gaunt = false)
-     : DFock(a, hc, *coeff, gaunt, breit, store_half, robust, scale_exch, scale_coulomb, store_half_gaunt) {
+          const bool store_half, const bool robust = false, const double scale_exch = 1.0, const double scale_coulomb = 1.0, const bool store_half_gaunt = false,
+          const bool large_only = false, const double thresh_small = 0.0)
+     : DFock(a, hc, *coeff, gaunt, breit, store_half, robust, scale_exch, scale_coulomb, store_half_gaunt, large_only, thresh_small) {
     }
     // DFock from half-transformed integrals
     DFock(std::shared_ptr<const Geometry> a, std::shared_ptr<const ZMatrix> hc, std::shared_ptr<const ZMatrix> coeff, std::shared_ptr<const ZMatrix> tcoeff,
@@ -83,6 +92,8 @@ class DFock : public ZMatrix {
     static std::list<std::shared_ptr<RelDF>> make_dfdists(std::vector<std::shared_ptr<const DFDist>>, bool);
     static std::list<std::shared_ptr<RelDFHalf>> make_half_complex(std::list<std::shared_ptr<RelDF>>, std::shared_ptr<const ZMatrix>);
 
+    int nscreened() const { return nscreened_; }
+
     std::list<std::shared_ptr<RelDFHalf>> half_coulomb() const { assert(store_half_); return half_coulomb_; }
     std::list<std::shared_ptr<RelDFHalf>> half_gaunt() const { assert(store_half_gaunt_); return half_gaunt_; }
     std::list<std::shared_ptr<RelDFHalf>> half_breit() const { assert(store_half_gaunt_); return half_breit_; }
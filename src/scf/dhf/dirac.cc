@@ -98,6 +98,14 @@ void Dirac::common_init(const shared_ptr<const PTree> idata) {
   assert(s12_->mdim() % 2 == 0);
 
   if (breit_ && !gaunt_) throw runtime_error("Breit cannot be turned on if Gaunt is off");
+
+  approx_start_ = idata->get<bool>("approx_start", false);
+  approx_thresh_ = idata->get<double>("approx_thresh", 1.0e-4);
+  thresh_small_ = idata->get<double>("thresh_small", 0.0);
+  if (do_grad_ && thresh_small_ != 0.0) {
+    cout << "    * Screening of small-component integrals is disabled for gradient calculations" << endl;
+    thresh_small_ = 0.0;
+  }
 }
 
 
@@ -121,18 +129,31 @@ void Dirac::compute() {
   cout << endl;
   cout << indent << "=== Dirac RHF iteration (" + geom_->basisfile() + ", " << (geom_->magnetism() ? "RMB" : "RKB") << ") ===" << endl << indent << endl;
 
-  DIIS<DistZMatrix, ZMatrix> diis(5);
+  auto diis = make_shared<DIIS<DistZMatrix, ZMatrix>>(5);
+
+  bool approx = approx_start_;
+  if (approx)
+    cout << indent << "    * Starting without small-component two-electron integrals." << endl << endl;
+  bool screened_printed = false;
 
   for (int iter = 0; iter != max_iter_; ++iter) {
     Timer ptime(1);
 
-    auto fock = make_shared<DFock>(geom_, hcore_, coeff->matrix()->slice_copy(nneg_, nele_+nneg_), gaunt_, breit_, do_grad_, robust_);
+    auto fock = approx ? make_shared<DFock>(geom_, hcore_, coeff->matrix()->slice_copy(nneg_, nele_+nneg_), false, false, /*store_half*/false, robust_,
+                                            1.0, 1.0, false, /*large_only*/true)
+                       : make_shared<DFock>(geom_, hcore_, coeff->matrix()->slice_copy(nneg_, nele_+nneg_), gaunt_, breit_, do_grad_, robust_,
+                                            1.0, 1.0, false, false, thresh_small_);
 
 // TODO I have a feeling that the code should not need this, but sometimes there are slight errors. still looking on it.
 #if 0
     assert(fock->is_hermitian());
     fock->hermite();
 #endif
+    if (fock->nscreened() > 0 && !screened_printed) {
+      cout << indent << "    * " << fock->nscreened() << " orbitals are treated without small-component integrals." << endl << endl;
+      screened_printed = true;
+    }
+
     // distribute
     shared_ptr<const DistZMatrix> distfock = fock->distmatrix();
 
@@ -152,7 +173,12 @@ void Dirac::compute() {
     cout << indent << setw(5) << iter << setw(20) << fixed << setprecision(8) << energy_
          << "   " << setw(17) << error << setw(15) << setprecision(2) << scftime.tick() << endl;
 
-    if (error < thresh_scf_ && iter > 0) {
+    if (approx && error < approx_thresh_) {
+      // the Fock matrices in the DIIS space are not compatible with the full Hamiltonian
+      cout << indent << endl << indent << "    * Switching on the small-component" << (gaunt_ ? (breit_ ? ", Gaunt and Breit" : " and Gaunt") : "") << " integrals." << endl << endl;
+      approx = false;
+      diis = make_shared<DIIS<DistZMatrix, ZMatrix>>(5);
+    } else if (error < thresh_scf_ && iter > 0 && !approx) {
       cout << indent << endl << indent << "  * SCF iteration converged." << endl << endl;
       // when computing gradient, we store half-transform integrals to avoid recomputation
       if (do_grad_) {
@@ -168,7 +194,7 @@ void Dirac::compute() {
     }
 
     if (iter >= diis_start_) {
-      distfock = diis.extrapolate({distfock, error_vector});
+      distfock = diis->extrapolate({distfock, error_vector});
       ptime.tick_print("DIIS");
     }
 
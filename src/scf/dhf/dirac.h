@@ -49,6 +49,12 @@ class Dirac : public Method {
 
     // for Fock build
     bool robust_;
+    // if true, SCF starts without small-component coefficients in the two-electron part (and without Gaunt and Breit)
+    // until the error falls below approx_thresh_
+    bool approx_start_;
+    double approx_thresh_;
+    // orbitals with smaller small-component weights are treated without small-component integrals
+    double thresh_small_;
 
     int multipole_print_;
     bool conv_ignore_;
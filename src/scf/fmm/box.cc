@@ -37,6 +37,8 @@ using namespace std;
 
 const static Legendre plm;
 const static Factorial f;
+// maximum number of source boxes per batched translation
+const static int batchsize__ = 32;
 
 void Box::init() {
 
@@ -240,16 +242,12 @@ void Box::compute_M2M(shared_ptr<const Matrix> density) {
     }
     tasks.compute();
   } else { // shift children's multipoles
+    vector<pair<const complex<double>*, array<double, 3>>> source;
     for (int n = 0; n != nchild_; ++n) {
       shared_ptr<const Box> c = child_[n].lock();
-      const array<double, 3> r12 = {{c->centre(0) - centre_[0], c->centre(1) - centre_[1], c->centre(2) - centre_[2]}};
-      auto cmultipole = make_shared<ZMatrix>(1, nmult_);
-      copy_n(c->olm()->data(), nmult_, cmultipole->data());
-      shared_ptr<const ZMatrix> tmp = shift_multipolesX(lmax_, cmultipole, r12);
-      auto smoment = make_shared<ZVectorB>(nmult_);
-      copy_n(tmp->data(), nmult_, smoment->data());
-      blas::ax_plus_y_n(1.0, smoment->data(), nmult_, olm_->data());
+      source.emplace_back(c->olm()->data(), array<double, 3>{{c->centre(0) - centre_[0], c->centre(1) - centre_[1], c->centre(2) - centre_[2]}});
     }
+    translate_batch(lmax_, 1, source, &Box::m2m_matrix, olm_->data());
   }
 }
 
@@ -301,12 +299,12 @@ void Box::compute_M2M_X(shared_ptr<const Matrix> ocoeff_sj, shared_ptr<const Mat
     zgemm_("C", "N", icoeff.mdim(), interm.mdim(), nshell0_, 1.0, icoeff.data(), nshell0_, interm.data(), nshell0_, 0.0, olm_ji_->data(), icoeff.mdim());
 
   } else { // shift children's multipoles
+    vector<pair<const complex<double>*, array<double, 3>>> source;
     for (int n = 0; n != nchild_; ++n) {
       shared_ptr<const Box> c = child_[n].lock();
-      const array<double, 3> r12 = {{c->centre(0) - centre_[0], c->centre(1) - centre_[1], c->centre(2) - centre_[2]}};
-      shared_ptr<const ZMatrix> smoment = shift_multipolesX(lmax_k_, c->olm_ji(), r12);
-      blas::ax_plus_y_n(1.0, smoment->data(), olm_ji_->size(), olm_ji_->data());
+      source.emplace_back(c->olm_ji()->data(), array<double, 3>{{c->centre(0) - centre_[0], c->centre(1) - centre_[1], c->centre(2) - centre_[2]}});
     }
+    translate_batch(lmax_k_, olm_ji_->ndim(), source, &Box::m2m_matrix, olm_ji_->data());
   }
 }
 
@@ -344,12 +342,12 @@ void Box::compute_M2L_X() {
   mlm_ji_ = olm_ji_->clone();
 
   // from interaction list
+  vector<pair<const complex<double>*, array<double, 3>>> source;
   for (int i = 0; i != ninter_; ++i) {
     shared_ptr<const Box> it = inter_[i].lock();
-    const array<double, 3> r12 = {{centre_[0] - it->centre(0), centre_[1] - it->centre(1), centre_[2] - it->centre(2)}};
-    shared_ptr<const ZMatrix> slocal = shift_localMX(lmax_k_, it->olm_ji(), r12);
-    blas::ax_plus_y_n(1.0, slocal->data(), mlm_ji_->size(), mlm_ji_->data());
+    source.emplace_back(it->olm_ji()->data(), array<double, 3>{{centre_[0] - it->centre(0), centre_[1] - it->centre(1), centre_[2] - it->centre(2)}});
   }
+  translate_batch(lmax_k_, mlm_ji_->ndim(), source, &Box::m2l_matrix, mlm_ji_->data());
 }
 
 
@@ -357,15 +355,32 @@ void Box::compute_M2L() {
 
   mlm_->fill(0.0);
   // from interaction list
+  vector<pair<const complex<double>*, array<double, 3>>> source;
   for (int i = 0; i != ninter_; ++i) {
     shared_ptr<const Box> it = inter_[i].lock();
-    const array<double, 3> r12 = {{centre_[0] - it->centre(0), centre_[1] - it->centre(1), centre_[2] - it->centre(2)}};
-    auto imultipole = make_shared<ZMatrix>(1, nmult_);
-    copy_n(it->olm()->data(), nmult_, imultipole->data());
-    shared_ptr<const ZMatrix> tmp = shift_localMX(lmax_, imultipole, r12);
-    auto slocal = make_shared<ZVectorB>(nmult_);
-    copy_n(tmp->data(), nmult_, slocal->data());
-    blas::ax_plus_y_n(1.0, slocal->data(), nmult_, mlm_->data());
+    source.emplace_back(it->olm()->data(), array<double, 3>{{centre_[0] - it->centre(0), centre_[1] - it->centre(1), centre_[2] - it->centre(2)}});
+  }
+  translate_batch(lmax_, 1, source, &Box::m2l_matrix, mlm_->data());
+}
+
+
+// Translations into this box are batched: the source moments (nrow x nmult each) are placed side by side and
+// the translation matrices are stacked accordingly, so that each chunk of sources is shifted by one GEMM.
+void Box::translate_batch(const int lmax, const int nrow, const vector<pair<const complex<double>*, array<double, 3>>>& source,
+                          shared_ptr<const ZMatrix> (Box::*trans)(const int, const array<double, 3>&) const, complex<double>* target) const {
+
+  const int nmult = (lmax+1)*(lmax+1);
+  const int nsource = source.size();
+  for (int start = 0; start < nsource; start += batchsize__) {
+    const int n = min(batchsize__, nsource-start);
+    ZMatrix moments(nrow, n*nmult, true);
+    ZMatrix lmjk(nmult, n*nmult, true);
+    for (int i = 0; i != n; ++i) {
+      copy_n(source[start+i].first, nrow*nmult, moments.element_ptr(0, i*nmult));
+      shared_ptr<const ZMatrix> tmp = (this->*trans)(lmax, source[start+i].second);
+      lmjk.copy_block(0, i*nmult, nmult, nmult, tmp->data());
+    }
+    zgemm_("N", "T", nrow, nmult, n*nmult, 1.0, moments.data(), nrow, lmjk.data(), nmult, 1.0, target, nrow);
   }
 }
 
@@ -705,16 +720,14 @@ shared_ptr<const Matrix> Box::compute_exact_ff(shared_ptr<const Matrix> density)
 }
 
 
-// M2M for X
-shared_ptr<const ZMatrix> Box::shift_multipolesX(const int lmax, shared_ptr<const ZMatrix> oa, array<double, 3> rab) const {
+// M2M translation matrix
+shared_ptr<const ZMatrix> Box::m2m_matrix(const int lmax, const array<double, 3>& rab) const {
 
   const double r = sqrt(rab[0]*rab[0] + rab[1]*rab[1] + rab[2]*rab[2]);
   const double ctheta = (r > numerical_zero__) ? rab[2]/r : 0.0;
   const double phi = atan2(rab[1], rab[0]);
   const int nmult = (lmax+1)*(lmax+1);
-  const int olm_size_block = oa->ndim();
 
-  shared_ptr<ZMatrix> ob = oa->clone();
   unique_ptr<double[]> plm0(new double[nmult]);
   for (int l = 0; l != lmax+1; ++l)
     for (int m = 0; m <= 2 * l; ++m) {
@@ -729,7 +742,7 @@ shared_ptr<const ZMatrix> Box::shift_multipolesX(const int lmax, shared_ptr<cons
     for (int j = i; j <= 2*lmax; ++j)
       invfac[j] /= i;
 
-  ZMatrix lmjk(nmult, nmult);
+  auto lmjk = make_shared<ZMatrix>(nmult, nmult);
   for (int l = 0; l <= lmax; ++l) {
     for (int j = 0; j <= lmax; ++j) {
       const int a = l - j;
@@ -742,27 +755,35 @@ shared_ptr<const ZMatrix> Box::shift_multipolesX(const int lmax, shared_ptr<cons
           const int k = m - l - b + j;
           const double prefactor = rr * plm0[a*a+a+b] * invfac[a+abs(b)];
           const complex<double> Oab = polar(prefactor, -b*phi);
-          lmjk.element(l*l+m, j*j+k) = Oab;
+          lmjk->element(l*l+m, j*j+k) = Oab;
         }
       }
     }
   }
-  zgemm_("N", "T", olm_size_block, nmult, nmult, 1.0, oa->data(), olm_size_block, lmjk.data(), nmult, 0.0, ob->data(), olm_size_block);
-
-  return ob;
+  return lmjk;
 }
 
 
 // L2L for X
 shared_ptr<const ZMatrix> Box::shift_localLX(const int lmax, const shared_ptr<const ZMatrix> mr, array<double, 3> rb) const {
 
+  const int nmult = (lmax+1)*(lmax+1);
+  const int olm_size_block = mr->ndim();
+
+  shared_ptr<const ZMatrix> lmjk = l2l_matrix(lmax, rb);
+  shared_ptr<ZMatrix> mrb  = mr->clone();
+  zgemm_("N", "T", olm_size_block, nmult, nmult, 1.0, mr->data(), olm_size_block, lmjk->data(), nmult, 0.0, mrb->data(), olm_size_block);
+  return mrb;
+}
+
+
+shared_ptr<const ZMatrix> Box::l2l_matrix(const int lmax, const array<double, 3>& rb) const {
+
   const double r = sqrt(rb[0]*rb[0] + rb[1]*rb[1] + rb[2]*rb[2]);
   const double ctheta = (r > numerical_zero__) ? rb[2]/r : 0.0;
   const double phi = atan2(rb[1], rb[0]);
   const int nmult = (lmax+1)*(lmax+1);
-  const int olm_size_block = mr->ndim();
 
-  shared_ptr<ZMatrix> mrb  = mr->clone();
   unique_ptr<double[]> plm0(new double[nmult]);
   for (int l = 0; l != lmax+1; ++l)
     for (int m = 0; m <= 2 * l; ++m) {
@@ -777,7 +798,7 @@ shared_ptr<const ZMatrix> Box::shift_localLX(const int lmax, const shared_ptr<co
     for (int j = i; j <= 2*lmax; ++j)
       invfac[j] /= i;
 
-  ZMatrix lmjk(nmult, nmult);
+  auto lmjk = make_shared<ZMatrix>(nmult, nmult);
   for (int l = 0; l <= lmax; ++l) {
     for (int j = 0; j <= lmax; ++j) {
       const int a = j - l;
@@ -790,27 +811,23 @@ shared_ptr<const ZMatrix> Box::shift_localLX(const int lmax, const shared_ptr<co
           const int k = m - l + b + j;
           const double prefactor = rr * plm0[a*a+a+b] * invfac[a+abs(b)];
           const complex<double> Oab = polar(prefactor, -b*phi);
-          lmjk.element(l*l+m, j*j+k) = Oab;
+          lmjk->element(l*l+m, j*j+k) = Oab;
         }
       }
     }
   }
-
-  zgemm_("N", "T", olm_size_block, nmult, nmult, 1.0, mr->data(), olm_size_block, lmjk.data(), nmult, 0.0, mrb->data(), olm_size_block);
-  return mrb;
+  return lmjk;
 }
 
 
-// M2L for X
-shared_ptr<const ZMatrix> Box::shift_localMX(const int lmax, shared_ptr<const ZMatrix> olm, array<double, 3> r12) const {
+// M2L translation matrix
+shared_ptr<const ZMatrix> Box::m2l_matrix(const int lmax, const array<double, 3>& r12) const {
 
   const double r = sqrt(r12[0]*r12[0] + r12[1]*r12[1] + r12[2]*r12[2]);
   const double ctheta = (r > numerical_zero__) ? r12[2]/r : 0.0;
   const double phi = atan2(r12[1], r12[0]);
   const int nmult = (lmax+1)*(lmax+1);
-  const int olm_size_block = olm->ndim();
 
-  shared_ptr<ZMatrix> mb = olm->clone();
   unique_ptr<double[]> plm0(new double[(2*lmax+1)*(2*lmax+1)]);
   for (int l = 0; l != 2*lmax+1; ++l)
     for (int m = 0; m <= 2 * l; ++m) {
@@ -819,7 +836,7 @@ shared_ptr<const ZMatrix> Box::shift_localMX(const int lmax, shared_ptr<const ZM
       plm0[l*l+m] = sign * plm.compute(l, abs(b), ctheta);
     }
 
-  ZMatrix lmjk(nmult, nmult);
+  auto lmjk = make_shared<ZMatrix>(nmult, nmult);
   for (int l = 0; l <= lmax; ++l) {
     const double phase_l = (1-((l&1)<<1));
     for (int j = 0; j <= lmax; ++j) {
@@ -830,14 +847,12 @@ shared_ptr<const ZMatrix> Box::shift_localMX(const int lmax, shared_ptr<const ZM
           const int b = m - l + k - j;
           double prefactor = plm0[a*a+a+b] * rr * f(a-abs(b));
           const complex<double> Mab = phase_l * polar(prefactor, b*phi);
-          lmjk.element(l*l+m, j*j+k) = Mab;
+          lmjk->element(l*l+m, j*j+k) = Mab;
         }
       }
     }
   }
-
-  zgemm_("N", "T", olm_size_block, nmult, nmult, 1.0, olm->data(), olm_size_block, lmjk.data(), nmult, 0.0, mb->data(), olm_size_block);
-  return mb;
+  return lmjk;
 }
 
 
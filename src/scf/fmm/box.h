@@ -76,9 +76,14 @@ class Box {
     void compute_M2L_X();
     void compute_L2L();
     void compute_L2L_X();
-    std::shared_ptr<const ZMatrix> shift_multipolesX(const int lmax, std::shared_ptr<const ZMatrix> oa, std::array<double, 3> rab) const;
     std::shared_ptr<const ZMatrix> shift_localLX(const int lmax, std::shared_ptr<const ZMatrix> mr, std::array<double, 3> rb) const;
-    std::shared_ptr<const ZMatrix> shift_localMX(const int lmax, std::shared_ptr<const ZMatrix> olm, std::array<double, 3> r12) const;
+    // translation matrices (nmult x nmult) for M2M, L2L and M2L
+    std::shared_ptr<const ZMatrix> m2m_matrix(const int lmax, const std::array<double, 3>& rab) const;
+    std::shared_ptr<const ZMatrix> l2l_matrix(const int lmax, const std::array<double, 3>& rb) const;
+    std::shared_ptr<const ZMatrix> m2l_matrix(const int lmax, const std::array<double, 3>& r12) const;
+    // accumulates translated moments from all the sources into target (nrow x nmult) with batched GEMMs
+    void translate_batch(const int lmax, const int nrow, const std::vector<std::pair<const std::complex<double>*, std::array<double, 3>>>& source,
+                         std::shared_ptr<const ZMatrix> (Box::*trans)(const int, const std::array<double, 3>&) const, std::complex<double>* target) const;
 
     std::shared_ptr<const Matrix> compute_exact_ff(std::shared_ptr<const Matrix> density) const; //debug
     std::shared_ptr<const Matrix> compute_Fock_nf(std::shared_ptr<const Matrix> density, std::shared_ptr<const VectorB> max_den) const;
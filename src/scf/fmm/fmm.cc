@@ -24,6 +24,12 @@
 //
 
 
+#include <array>
+#include <deque>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #include <src/scf/fmm/fmm.h>
 #include <src/util/taskqueue.h>
 #include <src/util/parallel/mpi_interface.h>
@@ -237,6 +243,8 @@ void FMM::get_boxes() {
     icnt += nbranch_[ir];
   }
 
+  partition_boxes();
+
   if (debug_) {
     cout << "Centre of Charge: " << setprecision(3) << centre_[0] << "  " << centre_[1] << "  " << centre_[2] << endl;
     cout << "ns_ = " << ns_ << " nbox = " << nbox_ << "  nleaf = " << nleaf << " nsp = " << nsp_ << " ws = " << ws_ << " lmaxJ " << lmax_;
@@ -272,22 +280,19 @@ void FMM::get_boxes() {
 void FMM::M2M(shared_ptr<const Matrix> density, const bool dox) const {
 
   Timer m2mtime;
+  const int nmult = (lmax_+1)*(lmax_+1);
+  // multipoles of the leaves are computed by the owner and communicated in one go
+  ZVectorB olm(nmult*nbranch_[0]);
   for (int i = 0; i != nbranch_[0]; ++i)
-    if (i % mpi__->size() == mpi__->rank())
+    if (owns_box(i)) {
       box_[i]->compute_M2M(density);
-
+      copy_n(box_[i]->olm()->data(), nmult, olm.data()+nmult*i);
+    }
+  mpi__->allreduce(olm.data(), olm.size());
   for (int i = 0; i != nbranch_[0]; ++i)
-    mpi__->broadcast(box_[i]->olm()->data(), box_[i]->olm()->size(), i % mpi__->size());
+    copy_n(olm.data()+nmult*i, nmult, box_[i]->olm()->data());
 
   m2mtime.tick_print("Compute multipoles");
-
-  int icnt = nbranch_[0];
-  for (int i = 1; i != ns_+1; ++i) {
-    for (int j = 0; j != nbranch_[i]; ++j, ++icnt)
-      box_[icnt]->compute_M2M(density);
-  }
-  m2mtime.tick_print("M2M pass");
-  assert(icnt == nbox_);
 }
 
 
@@ -295,67 +300,212 @@ void FMM::M2M_X(shared_ptr<const Matrix> ocoeff_sj, shared_ptr<const Matrix> oco
 
   Timer m2mtime;
 
-  int icnt = 0;
-  for (int i = 0; i != ns_+1; ++i) {
-    for (int j = 0; j != nbranch_[i]; ++j, ++icnt) {
-      box_[icnt]->compute_M2M_X(ocoeff_sj, ocoeff_ui);
-      if (icnt >= nbox_) throw logic_error("Trying to access beyond nbox in M2M_X");
-    }
-  }
-  m2mtime.tick_print("M2M-X pass");
-  assert(icnt == nbox_);
-}
+  for (int i = 0; i != nbranch_[0]; ++i)
+    box_[i]->compute_M2M_X(ocoeff_sj, ocoeff_ui);
 
+  m2mtime.tick_print("Compute multipoles-X");
+}
 
-void FMM::M2L(const bool dox) const {
 
-  Timer m2ltime;
+void FMM::traverse(shared_ptr<const Matrix> ocoeff_sj, shared_ptr<const Matrix> ocoeff_ui) const {
 
-  TaskQueue<function<void(void)>> tasks(nbox_);
-  if (!dox) {
-    for (auto& b : box_)
-      tasks.emplace_back(
-        [this, b]() { b->compute_M2L(); }
-      );
-    tasks.compute();
-    m2ltime.tick_print("M2L pass");
-  } else {
-    for (auto& b : box_)
-      tasks.emplace_back(
-        [this, b]() { b->compute_M2L_X(); }
-      );
-    tasks.compute();
-    m2ltime.tick_print("M2L-X pass");
+  Timer fmmtime;
+  const bool dox = static_cast<bool>(ocoeff_sj);
+  // the exchange pass runs the whole tree (orbital batches are distributed by the caller); the Coulomb pass is distributed over boxes
+  const bool distributed = !dox && mpi__->size() > 1;
+
+  // task graph: M2M, M2L and L2L of each box, and when distributed the reductions of each level and of M2L, chained in the same order on all processes
+  const int nleaf = nbranch_[0];
+  const int nlevel = nbranch_.size();
+  const int nnode = 3*nbox_ + (distributed ? nlevel : 0);
+  auto reduce_m2m = [this](const int level) { return 3*nbox_ + level - 1; };
+  const int reduce_m2l = 3*nbox_ + nlevel - 1;
+
+  vector<vector<int>> target(nnode);
+  vector<int> ndep(nnode, 0);
+  auto add_dep = [&target, &ndep](const int from, const int to) { target[from].push_back(to); ++ndep[to]; };
+
+  // boxes whose L2L is needed on this process
+  vector<bool> needed(nbox_, !distributed);
+  if (distributed)
+    for (int i = 0; i != nleaf; ++i)
+      if (owns_box(i))
+        for (shared_ptr<const Box> b = box_[i]; b && !needed[b->boxid()]; b = b->parent())
+          needed[b->boxid()] = true;
+
+  for (int i = 0; i != nbox_; ++i) {
+    shared_ptr<const Box> b = box_[i];
+    assert(b->boxid() == i);
+    const int level = b->rank();
+    if (!distributed) {
+      for (auto& c : b->child())
+        add_dep(c.lock()->boxid(), i);
+      for (auto& it : b->inter_)
+        add_dep(it.lock()->boxid(), nbox_+i);
+      add_dep(i, nbox_+i);
+      add_dep(nbox_+i, 2*nbox_+i);
+    } else {
+      if (level > 1)
+        add_dep(reduce_m2m(level-1), i);
+      if (level > 0) {
+        add_dep(i, reduce_m2m(level));
+        add_dep(reduce_m2m(level), nbox_+i);
+      }
+      add_dep(nbox_+i, reduce_m2l);
+      add_dep(reduce_m2l, 2*nbox_+i);
+    }
+    if (b->parent())
+      add_dep(2*nbox_+b->parent()->boxid(), 2*nbox_+i);
   }
+  if (distributed)
+    for (int level = 1; level != nlevel; ++level)
+      add_dep(reduce_m2m(level), level+1 == nlevel ? reduce_m2l : reduce_m2m(level+1));
+
+  // sums the moments of the given boxes over processes; boxes that are not owned contribute zero
+  auto reduce = [this](const int start, const int n, shared_ptr<ZVectorB> (Box::*moment)() const) {
+    const int nmult = (lmax_+1)*(lmax_+1);
+    ZVectorB buf(nmult*n);
+    for (int i = start; i != start+n; ++i)
+      if (owns_box(i))
+        copy_n(((*box_[i]).*moment)()->data(), nmult, buf.data()+nmult*(i-start));
+    mpi__->allreduce(buf.data(), buf.size());
+    for (int i = start; i != start+n; ++i)
+      copy_n(buf.data()+nmult*(i-start), nmult, ((*box_[i]).*moment)()->data());
+  };
+
+  auto compute_node = [&](const int n) {
+    if (n >= 3*nbox_) {
+      if (n == reduce_m2l) {
+        reduce(0, nbox_, &Box::mlm);
+      } else {
+        const int level = n - 3*nbox_ + 1;
+        reduce(accumulate(nbranch_.begin(), nbranch_.begin()+level, 0), nbranch_[level], &Box::olm);
+      }
+      return;
+    }
+    const int phase = n / nbox_;
+    const int i = n % nbox_;
+    if (phase == 0) {
+      if (i < nleaf || (distributed && !owns_box(i))) return;
+      if (!dox) box_[i]->compute_M2M(nullptr);
+      else      box_[i]->compute_M2M_X(ocoeff_sj, ocoeff_ui);
+    } else if (phase == 1) {
+      if (distributed && !owns_box(i)) return;
+      if (!dox) box_[i]->compute_M2L();
+      else      box_[i]->compute_M2L_X();
+    } else {
+      if (!needed[i]) return;
+      if (!dox) box_[i]->compute_L2L();
+      else      box_[i]->compute_L2L_X();
+    }
+  };
+
+  deque<int> ready;
+  for (int n = 0; n != nnode; ++n)
+    if (ndep[n] == 0) ready.push_back(n);
+
+  int remaining = nnode;
+  mutex qmutex;
+  condition_variable qcv;
+  // time spent in M2M, M2L and L2L summed over threads (the passes overlap)
+  array<double,3> phase_time{{0.0, 0.0, 0.0}};
+
+  auto worker = [&]() {
+    unique_lock<mutex> lock(qmutex);
+    while (true) {
+      qcv.wait(lock, [&ready, &remaining]() { return !ready.empty() || remaining == 0; });
+      if (ready.empty()) break;
+      const int n = ready.front();
+      ready.pop_front();
+      lock.unlock();
+
+      auto start = chrono::steady_clock::now();
+      compute_node(n);
+      const double time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+      lock.lock();
+      if (n < 3*nbox_)
+        phase_time[n / nbox_] += time;
+      --remaining;
+      for (auto& t : target[n])
+        if (--ndep[t] == 0)
+          ready.push_back(t);
+      qcv.notify_all();
+    }
+  };
+
+#ifdef HAVE_MKL_H
+  const int mkl_num = mkl_get_max_threads();
+  mkl_set_num_threads(1);
+#endif
+  const int nthreads = resources__->max_num_threads();
+  vector<thread> threads;
+  for (int i = 0; i != nthreads; ++i)
+    threads.emplace_back(worker);
+  for (auto& i : threads)
+    i.join();
+#ifdef HAVE_MKL_H
+  mkl_set_num_threads(mkl_num);
+#endif
+  assert(remaining == 0);
+
+  Timer phasetime(1);
+  const string x = dox ? "-X" : "";
+  phasetime.print("M2M pass" + x, phase_time[0]);
+  phasetime.print("M2L pass" + x, phase_time[1]);
+  phasetime.print("L2L pass" + x, phase_time[2]);
+  fmmtime.tick_print("FMM traversal" + x);
 }
 
 
-void FMM::L2L(const bool dox) const {
-
-  Timer l2ltime;
-
-  int icnt = 0;
-  if (!dox) {
-    for (int ir = ns_; ir > -1; --ir) {
-      for (int ib = 0; ib != nbranch_[ir]; ++ib)
-        box_[nbox_-icnt-nbranch_[ir]+ib]->compute_L2L();
-
-      icnt += nbranch_[ir];
+void FMM::partition_boxes() {
+
+  // Boxes of each level are ordered along a Morton curve and assigned to processes in contiguous pieces of
+  // equal cost, so that each process receives a spatially compact part of the tree. The cost of a leaf is
+  // estimated by its near-field work, and that of the other boxes by the number of translations into them.
+  auto morton = [](const array<int, 3>& v) {
+    uint64_t out = 0;
+    for (int bit = 0; bit != 21; ++bit)
+      for (int i = 0; i != 3; ++i)
+        out |= static_cast<uint64_t>((v[i] >> bit) & 1) << (3*bit + i);
+    return out;
+  };
+
+  const int nproc = mpi__->size();
+  box_owner_.resize(nbox_);
+  int start = 0;
+  for (auto& nbranch : nbranch_) {
+    vector<double> cost(nbranch);
+    for (int i = 0; i != nbranch; ++i) {
+      shared_ptr<const Box> b = box_[start+i];
+      if (b->nchild_ == 0) {
+        int nsp_neigh = 0;
+        for (auto& ne : b->neigh_)
+          nsp_neigh += ne.lock()->nsp_;
+        cost[i] = static_cast<double>(b->nsp_) * max(nsp_neigh, 1);
+      } else {
+        cost[i] = b->ninter_ + b->nchild_;
+      }
+    }
+    // without any cost estimate (e.g., no shell pairs in the boxes) the boxes are distributed evenly
+    double total = accumulate(cost.begin(), cost.end(), 0.0);
+    if (total <= 0.0) {
+      fill(cost.begin(), cost.end(), 1.0);
+      total = nbranch;
     }
 
-    l2ltime.tick_print("L2L pass");
-  } else {
-    for (int ir = ns_; ir > -1; --ir) {
-      for (int ib = 0; ib != nbranch_[ir]; ++ib) {
-        const int ibox = nbox_-icnt-nbranch_[ir]+ib;
-        box_[ibox]->compute_L2L_X();
-        if (icnt >= nbox_) throw logic_error("Trying to access beyond nbox in M2M_X");
-      }
+    vector<int> order(nbranch);
+    iota(order.begin(), order.end(), start);
+    sort(order.begin(), order.end(), [this, &morton](const int a, const int b) { return morton(box_[a]->tvec()) < morton(box_[b]->tvec()); });
 
-      icnt += nbranch_[ir];
+    double acc = 0.0;
+    for (auto& i : order) {
+      box_owner_[i] = min(nproc-1, static_cast<int>(acc / total * nproc));
+      acc += cost[i-start];
     }
-    l2ltime.tick_print("L2L-X pass");
+    start += nbranch;
   }
+  assert(start == nbox_);
 }
 
 
@@ -366,8 +516,7 @@ shared_ptr<const Matrix> FMM::compute_Fock_FMM(shared_ptr<const Matrix> density)
 
   Timer fmmtime;
   M2M(density);
-  M2L();
-  L2L();
+  traverse();
 
   Timer nftime;
 
@@ -395,7 +544,7 @@ shared_ptr<const Matrix> FMM::compute_Fock_FMM(shared_ptr<const Matrix> density)
 
     auto ff = make_shared<Matrix>(nbasis_, nbasis_);
     for (int i = 0; i != nbranch_[0]; ++i)
-      if (i % mpi__->size() == mpi__->rank()) {
+      if (owns_box(i)) {
         auto ei = box_[i]->compute_Fock_nf(density, maxden);
         blas::ax_plus_y_n(1.0, ei->data(), nbasis_*nbasis_, out->data());
         auto ffi = box_[i]->compute_Fock_ff(density);
@@ -441,8 +590,7 @@ shared_ptr<const Matrix> FMM::compute_K_ff(shared_ptr<const Matrix> ocoeff, shar
 
       {
         M2M_X(ocoeff_sj, ocoeff_ui);
-        M2L(true);
-        L2L(true);
+        traverse(ocoeff_sj, ocoeff_ui);
       }
       Timer assembletime;
       for (int i = 0; i != nbranch_[0]; ++i) {
@@ -520,7 +668,7 @@ shared_ptr<const Matrix> FMM::compute_Fock_FMM_K(shared_ptr<const Matrix> densit
     }
 
     for (int i = 0; i != nbranch_[0]; ++i)
-      if (i % mpi__->size() == mpi__->rank()) {
+      if (owns_box(i)) {
         auto ei = box_[i]->compute_Fock_nf_K(density, maxden);
         blas::ax_plus_y_n(1.0, ei->data(), nbasis_*nbasis_, out->data());
       }
@@ -543,8 +691,7 @@ shared_ptr<const Matrix> FMM::compute_Fock_FMM_J(shared_ptr<const Matrix> densit
 
   Timer fmmtime;
   M2M(density);
-  M2L();
-  L2L();
+  traverse();
 
   Timer jtime;
 
@@ -572,7 +719,7 @@ shared_ptr<const Matrix> FMM::compute_Fock_FMM_J(shared_ptr<const Matrix> densit
 
     auto ff = make_shared<Matrix>(nbasis_, nbasis_);
     for (int i = 0; i != nbranch_[0]; ++i)
-      if (i % mpi__->size() == mpi__->rank()) {
+      if (owns_box(i)) {
         auto ffi = box_[i]->compute_Fock_ff(density);
         blas::ax_plus_y_n(1.0, ffi->data(), nbasis_*nbasis_, ff->data());
       }
@@ -580,7 +727,7 @@ shared_ptr<const Matrix> FMM::compute_Fock_FMM_J(shared_ptr<const Matrix> densit
     fmmtime.tick_print("FMM-J");
 
     for (int i = 0; i != nbranch_[0]; ++i)
-      if (i % mpi__->size() == mpi__->rank()) {
+      if (owns_box(i)) {
         auto ei = box_[i]->compute_Fock_nf_J(density, maxden);
         blas::ax_plus_y_n(1.0, ei->data(), nbasis_*nbasis_, out->data());
       }
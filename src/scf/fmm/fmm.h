@@ -29,6 +29,7 @@
 
 #include <src/wfn/geometry.h>
 #include <src/scf/fmm/box.h>
+#include <src/util/parallel/mpi_interface.h>
 
 namespace bagel {
 
@@ -47,6 +48,8 @@ class FMM {
     std::shared_ptr<const FMMInfo> geomdata_;
 
     std::vector<std::shared_ptr<Box>> box_;
+    // MPI process that owns each box (contiguous pieces of a Morton-ordered spatial partition of each level)
+    std::vector<int> box_owner_;
     double ws_;
     bool do_exchange_;
     int lmax_k_;
@@ -58,8 +61,11 @@ class FMM {
     void get_boxes();
     void M2M(std::shared_ptr<const Matrix> mat, const bool do_exchange = false) const;
     void M2M_X(std::shared_ptr<const Matrix> ocoeff_sj, std::shared_ptr<const Matrix> ocoeff_ui) const;
-    void M2L(const bool do_exchange = false) const;
-    void L2L(const bool do_exchange = false) const;
+    // dependency-driven M2M (above leaves), M2L and L2L across all levels; leaf multipoles have to be ready.
+    // The exchange variants are used when orbitals are given. The Coulomb pass is distributed over processes.
+    void traverse(std::shared_ptr<const Matrix> ocoeff_sj = nullptr, std::shared_ptr<const Matrix> ocoeff_ui = nullptr) const;
+    void partition_boxes();
+    bool owns_box(const int i) const { return box_owner_[i] == mpi__->rank(); }
 
     // serialization
     friend class boost::serialization::access;
@@ -25,6 +25,7 @@
 #include <src/scf/atomicdensities.h>
 #include <src/scf/hf/rhf.h>
 #include <src/scf/hf/fock.h>
+#include <src/scf/purification.h>
 #include <src/prop/multipole.h>
 #include <src/prop/sphmultipole.h>
 #include <src/scf/dhf/population_analysis.h>
@@ -47,6 +48,97 @@ RHF::RHF(const shared_ptr<const PTree> idata, const shared_ptr<const Geometry> g
     cout << "  level shift : " << setprecision(3) << lshift_ << endl << endl;
     levelshift_ = make_shared<ShiftVirtual<DistMatrix>>(nocc_, lshift_);
   }
+
+  purify_ = idata->get<bool>("purification", false);
+  purify_switch_ = idata->get<double>("purification_switch", 1.0e-3);
+  if (purify_) {
+    stringstream ss; ss << setprecision(1) << scientific << purify_switch_;
+    cout << "  density purification until the error is below " << ss.str() << endl << endl;
+  }
+
+  // symmetry-adapted orthogonal basis; Fock matrices are block diagonal in this basis
+  if (geom_->nirrep() > 1) {
+    shared_ptr<const Petite> plist = geom_->plist();
+    shared_ptr<Matrix> salc;
+    vector<int> label;
+    tie(salc, label) = plist->symmetry_adapted_basis(geom_->atoms());
+
+    vector<shared_ptr<const Matrix>> blocks;
+    cout << indent << "  Symmetry-adapted basis functions:";
+    for (int ir = 0; ir != plist->nirrep(); ++ir) {
+      const int start = find(label.begin(), label.end(), ir) - label.begin();
+      const int size = count(label.begin(), label.end(), ir);
+      cout << "  " << plist->irrep_name(ir) << " " << size;
+      if (size == 0) continue;
+      auto u = salc->slice_copy(start, start+size);
+      auto x = make_shared<Matrix>(*u * *make_shared<Matrix>(*u % *overlap_ * *u)->tildex(thresh_overlap_));
+      blocks.push_back(x);
+      tildex_irrep_.insert(tildex_irrep_.end(), x->mdim(), ir);
+    }
+    cout << endl << endl;
+    auto tildex = make_shared<Matrix>(geom_->nbasis(), tildex_irrep_.size());
+    int n = 0;
+    for (auto& i : blocks) {
+      tildex->copy_block(0, n, i->ndim(), i->mdim(), i);
+      n += i->mdim();
+    }
+    tildex_ = tildex;
+  }
+}
+
+
+void RHF::diagonalize(DistMatrix& mat, vector<int>& irrep) {
+  if (geom_->nirrep() == 1) {
+    mat.diagonalize(eig());
+    return;
+  }
+  assert(irrep.size() == mat.ndim());
+  auto full = make_shared<Matrix>(mat);
+  const int n = full->ndim();
+  vector<tuple<double,int,vector<double>>> out;
+  for (int ir = 0; ir != geom_->nirrep(); ++ir) {
+    vector<int> index;
+    for (int i = 0; i != n; ++i)
+      if (irrep[i] == ir) index.push_back(i);
+    if (index.empty()) continue;
+    Matrix block(index.size(), index.size());
+    for (int j = 0; j != index.size(); ++j)
+      for (int i = 0; i != index.size(); ++i)
+        block(i, j) = full->element(index[i], index[j]);
+    VectorB eig(index.size());
+    block.diagonalize(eig);
+    for (int j = 0; j != index.size(); ++j) {
+      vector<double> v(n, 0.0);
+      for (int i = 0; i != index.size(); ++i)
+        v[index[i]] = block(i, j);
+      out.emplace_back(eig(j), ir, v);
+    }
+  }
+  stable_sort(out.begin(), out.end(), [](const tuple<double,int,vector<double>>& a, const tuple<double,int,vector<double>>& b) { return get<0>(a) < get<0>(b); });
+  for (int j = 0; j != n; ++j) {
+    eig()(j) = get<0>(out[j]);
+    irrep[j] = get<1>(out[j]);
+    copy_n(get<2>(out[j]).begin(), n, full->element_ptr(0, j));
+  }
+  mat = *full->distmatrix();
+}
+
+
+shared_ptr<const DistMatrix> RHF::purify_occupied(const DistMatrix& fock, const DistMatrix& tildex, const DistMatrix& coeff) const {
+  // Fock matrix in the orthogonal basis and its projector onto the nocc lowest states
+  auto forth = make_shared<const DistMatrix>(tildex % fock * tildex);
+  const pair<double, double> bounds = gershgorin_bounds(*forth->matrix());
+  shared_ptr<const DistMatrix> proj = purify_trs4(*forth, nocc_, bounds.first, bounds.second);
+  if (!proj)
+    return nullptr;
+
+  // previous occupied orbitals projected onto the new occupied space and orthonormalized (nocc x nocc problem)
+  auto sc = make_shared<const Matrix>(*overlap_ * coeff.matrix()->slice(0, nocc_));
+  auto occorth = make_shared<const DistMatrix>(*proj * (tildex % *sc->distmatrix()));
+  auto ovl = make_shared<Matrix>(*make_shared<const DistMatrix>(*occorth % *occorth)->matrix());
+  if (!ovl->inverse_half(1.0e-8))
+    return nullptr;
+  return make_shared<const DistMatrix>(tildex * *occorth * *ovl->distmatrix());
 }
 
 
@@ -81,7 +173,8 @@ void RHF::compute() {
         fock = focka->distmatrix();
       }
       DistMatrix intermediate = *tildex % *fock * *tildex;
-      intermediate.diagonalize(eig());
+      mo_irrep_ = tildex_irrep_;
+      diagonalize(intermediate, mo_irrep_);
       coeff = make_shared<const DistMatrix>(*tildex * intermediate);
     } else {
       shared_ptr<const Matrix> focka;
@@ -97,7 +190,8 @@ void RHF::compute() {
         focka = compute_Fock_FMM(aodensity_, make_shared<const Matrix>(coeff_->slice(0, nocc_)));
       }
       DistMatrix intermediate = *tildex % *focka->distmatrix() * *tildex;
-      intermediate.diagonalize(eig());
+      mo_irrep_ = tildex_irrep_;
+      diagonalize(intermediate, mo_irrep_);
       coeff = make_shared<const DistMatrix>(*tildex * intermediate);
     }
     coeff_ = make_shared<const Coeff>(*coeff->matrix());
@@ -112,6 +206,8 @@ void RHF::compute() {
     diis_ = make_shared<DIIS<DistMatrix>>(diis_size_);
   } else {
     coeff = coeff_->distmatrix();
+    if (geom_->nirrep() > 1 && coeff_->mdim() == tildex_->mdim())
+      mo_irrep_ = geom_->plist()->orbital_irreps(geom_->atoms(), *coeff_, *overlap_);
   }
 
   aodensity_ = coeff_->form_density_rhf(nocc_);
@@ -119,6 +215,9 @@ void RHF::compute() {
 
   // starting SCF iteration
   shared_ptr<const Matrix> densitychange = aodensity_;
+  // true when coeff only holds the occupied orbitals from purification (also when restarted from such an iteration);
+  // mo_irrep_ and eig() are then not defined until the next diagonalization in the orthogonal basis
+  bool purified = coeff_->mdim() != tildex_->mdim();
 
   for (int iter = 0; iter != max_iter_; ++iter) {
     Timer pdebug(1);
@@ -168,15 +267,30 @@ void RHF::compute() {
       pdebug.tick_print("DIIS");
     }
 
-    DistMatrix intermediate(*coeff % *fock * *coeff);
+    shared_ptr<const DistMatrix> ocoeff = purify_ && error > purify_switch_ ? purify_occupied(*fock, *tildex, *coeff) : nullptr;
+    if (ocoeff) {
+      // only the occupied orbitals are updated; the full set is recovered by diagonalization when leaving this mode
+      pdebug.tick_print("Purification");
+      coeff = ocoeff;
+      purified = true;
+    } else if (purified) {
+      DistMatrix intermediate(*tildex % *fock * *tildex);
+      mo_irrep_ = tildex_irrep_;
+      diagonalize(intermediate, mo_irrep_);
+      pdebug.tick_print("Diag");
+      coeff = make_shared<const DistMatrix>(*tildex * intermediate);
+      purified = false;
+    } else {
+      DistMatrix intermediate(*coeff % *fock * *coeff);
 
-    if (levelshift_)
-      levelshift_->shift(intermediate);
+      if (levelshift_)
+        levelshift_->shift(intermediate);
 
-    intermediate.diagonalize(eig());
-    pdebug.tick_print("Diag");
+      diagonalize(intermediate, mo_irrep_);
+      pdebug.tick_print("Diag");
 
-    coeff = make_shared<const DistMatrix>(*coeff * intermediate);
+      coeff = make_shared<const DistMatrix>(*coeff * intermediate);
+    }
     coeff_ = make_shared<const Coeff>(*coeff->matrix());
 
     if (!dodf_) {
@@ -189,6 +303,22 @@ void RHF::compute() {
     aodensity = aodensity_->distmatrix();
     pdebug.tick_print("Post process");
   }
+  if (purified) {
+    // recovers the virtual orbitals, the orbital energies and (in the symmetry-blocked diagonalization) the irreps
+    DistMatrix intermediate(*tildex % *previous_fock->distmatrix() * *tildex);
+    mo_irrep_ = tildex_irrep_;
+    diagonalize(intermediate, mo_irrep_);
+    coeff = make_shared<const DistMatrix>(*tildex * intermediate);
+    coeff_ = make_shared<const Coeff>(*coeff->matrix());
+  }
+  assert(coeff_->mdim() == tildex_->mdim() && (geom_->nirrep() == 1 || mo_irrep_.size() == coeff_->mdim()));
+  if (geom_->nirrep() > 1) {
+    cout << indent << "  * Doubly occupied orbitals:";
+    for (int ir = 0; ir != geom_->nirrep(); ++ir)
+      cout << "  " << geom_->plist()->irrep_name(ir) << " " << count(mo_irrep_.begin(), mo_irrep_.begin()+nocc_, ir);
+    cout << endl << endl;
+  }
+
   // by default we compute dipoles
   if (!geom_->external() && multipole_print_) {
     if (dodf_) aodensity_ = aodensity->matrix();
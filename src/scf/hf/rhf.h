@@ -41,6 +41,19 @@ class RHF : public SCF_base {
     bool restarted_;
 
     std::shared_ptr<DIIS<DistMatrix>> diis_;
+
+    // diagonalization-free updates by TRS4 purification while the DIIS error is above purify_switch_
+    bool purify_ = false;
+    double purify_switch_ = 1.0e-3;
+    // returns occupied orbitals (in AO) spanning the projector obtained from the Fock matrix, or nullptr if purification failed
+    std::shared_ptr<const DistMatrix> purify_occupied(const DistMatrix& fock, const DistMatrix& tildex, const DistMatrix& coeff) const;
+
+    // irreps of the columns of tildex_ and of the MOs when point-group symmetry is used
+    std::vector<int> tildex_irrep_;
+    std::vector<int> mo_irrep_;
+    // diagonalizes a matrix that is block diagonal by the irreps of its basis (given in irrep, which is updated to those of eigenvectors)
+    void diagonalize(DistMatrix& mat, std::vector<int>& irrep);
+
     std::shared_ptr<const Matrix> compute_Fock_FMM(std::shared_ptr<const Matrix> density, std::shared_ptr<const Matrix> coeff = nullptr);
 
   private:
@@ -51,14 +64,21 @@ class RHF : public SCF_base {
     void save(Archive& ar, const unsigned int) const {
       ar << boost::serialization::base_object<SCF_base>(*this);
       ar << lshift_ << dodf_ << diis_;
+      ar << purify_ << purify_switch_;
     }
 
     template<class Archive>
-    void load(Archive& ar, const unsigned int) {
+    void load(Archive& ar, const unsigned int version) {
       ar >> boost::serialization::base_object<SCF_base>(*this);
       ar >> lshift_ >> dodf_ >> diis_;
+      // version 0 has no purification
+      if (version > 0)
+        ar >> purify_ >> purify_switch_;
       if (lshift_ != 0.0)
         levelshift_ = std::make_shared<ShiftVirtual<DistMatrix>>(nocc_, lshift_);
+      // the columns of tildex_ are symmetry adapted, one irrep at a time
+      if (geom_->nirrep() > 1)
+        tildex_irrep_ = geom_->plist()->orbital_irreps(geom_->atoms(), *tildex_, *overlap_);
       restarted_ = true;
     }
 
@@ -84,5 +104,6 @@ class RHF : public SCF_base {
 
 #include <src/util/archive.h>
 BOOST_CLASS_EXPORT_KEY(bagel::RHF)
+BOOST_CLASS_VERSION(bagel::RHF, 1)
 
 #endif
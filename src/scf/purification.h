@@ -0,0 +1,116 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: purification.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __BAGEL_SCF_PURIFICATION_H
+#define __BAGEL_SCF_PURIFICATION_H
+
+#include <cmath>
+#include <limits>
+#include <src/util/math/matrix.h>
+#include <src/util/math/matop.h>
+
+/************************************************************************************
+* Diagonalization-free construction of the density matrix (a projector onto the     *
+*   nocc lowest eigenvectors of a Fock matrix in an orthonormal basis) by trace-    *
+*   resetting fourth-order purification (TRS4; Niklasson, Tymczak, and Challacombe, *
+*   J. Chem. Phys. 118, 8611 (2003)). Only matrix multiplications are used so that  *
+*   the cost is that of a few pdgemm calls per step when ScaLAPACK is available.    *
+************************************************************************************/
+
+namespace bagel {
+
+// Gershgorin estimate of the spectral range of a symmetric matrix
+inline std::pair<double, double> gershgorin_bounds(const Matrix& mat) {
+  assert(mat.ndim() == mat.mdim());
+  double emin = std::numeric_limits<double>::max();
+  double emax = std::numeric_limits<double>::lowest();
+  for (int j = 0; j != mat.mdim(); ++j) {
+    double radius = 0.0;
+    for (int i = 0; i != mat.ndim(); ++i)
+      if (i != j) radius += std::fabs(mat(i, j));
+    emin = std::min(emin, mat(j, j) - radius);
+    emax = std::max(emax, mat(j, j) + radius);
+  }
+  return {emin, emax};
+}
+
+
+// Returns nullptr when the idempotency error does not fall below thresh in maxiter steps (e.g., when the HOMO-LUMO gap is tiny);
+// callers should then diagonalize.
+template<class MatType>
+std::shared_ptr<MatType> purify_trs4(const MatType& fock, const int nocc, const double emin, const double emax,
+                                     const double thresh = 1.0e-10, const int maxiter = 100) {
+  assert(fock.ndim() == fock.mdim() && emax > emin);
+  const int n = fock.ndim();
+  if (nocc == 0 || nocc == n) {
+    auto out = fock.clone();
+    out->add_diag(nocc == 0 ? 0.0 : 1.0, 0, n);
+    return out;
+  }
+
+  // initial guess whose eigenvalues are in [0, 1] and in the reverse order of those of fock
+  auto x = std::make_shared<MatType>(fock);
+  x->scale(-1.0/(emax-emin));
+  x->add_diag(emax/(emax-emin), 0, n);
+
+  auto unit = fock.clone();
+  unit->add_diag(1.0, 0, n);
+
+  for (int iter = 0; iter != maxiter; ++iter) {
+    const MatType x2 = *x * *x;
+    // tr(X^k) from Frobenius inner products of symmetric matrices
+    const double t1 = x->dot_product(*unit);
+    const double t2 = x->dot_product(*x);
+    const double t3 = x2.dot_product(*x);
+    const double t4 = x2.dot_product(x2);
+    if (std::fabs(t1 - t2) < thresh && std::fabs(t1 - nocc) < std::sqrt(thresh))
+      return x;
+
+    // F(X) = X^2 (4X - 3X^2) and G(X) = X^2 (1 - X)^2; gamma is chosen so that tr(F + gamma G) = nocc
+    const double trf = 4.0*t3 - 3.0*t4;
+    const double trg = t2 - 2.0*t3 + t4;
+    const double gamma = trg > std::numeric_limits<double>::epsilon() ? (nocc - trf) / trg : (nocc > trf ? 7.0 : -1.0);
+
+    if (gamma > 6.0) {
+      // X <- 2X - X^2 raises the trace
+      x->scale(2.0);
+      x->ax_plus_y(-1.0, x2);
+    } else if (gamma < 0.0) {
+      // X <- X^2 lowers the trace
+      *x = x2;
+    } else {
+      // X <- X^2 (gamma + (4 - 2 gamma) X + (gamma - 3) X^2)
+      MatType poly(x2);
+      poly.scale(gamma - 3.0);
+      poly.ax_plus_y(4.0 - 2.0*gamma, *x);
+      poly.add_diag(gamma, 0, n);
+      *x = x2 * poly;
+    }
+  }
+  return nullptr;
+}
+
+}
+
+#endif
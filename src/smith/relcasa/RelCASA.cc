@@ -255,19 +255,13 @@ vector<shared_ptr<MultiTensor_<complex<double>>>> RelCASA::RelCASA::solve_linear
 
 #ifndef DISABLE_SERIALIZATION
       if (info_->restart() && (conv || (info_->restart_each_iter() && iter > 0))) {
-        string arch = "RelCASA_";
-        if (mpi__->rank() == 0)
-          arch += "t2_" + to_string(i) + (conv ? "_converged" : "_iter_" + to_string(iter));
-        else
-          arch += "temp_trash";
+        // every process writes its own part of the amplitudes
         {
-          OArchive archive(arch);
+          OArchive archive("RelCASA_t2_" + to_string(i) + (conv ? "_converged" : "_iter_" + to_string(iter)));
           archive << t2all_[i];
         }
-        mpi__->barrier();
         if (conv)
           mtimer.tick_print("Save T-amplitude Archive (RelSMITH)");
-        remove("RelCASA_temp_trash.archive");
       }
 #endif
 
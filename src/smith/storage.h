@@ -39,6 +39,7 @@
 #include <src/smith/indexrange.h>
 #include <src/util/parallel/mpi_interface.h>
 #include <src/util/parallel/rmawindow.h>
+#include <src/util/io/arraysection.h>
 
 namespace bagel {
 namespace SMITH {
@@ -119,9 +120,21 @@ class StorageIncore : public RMAWindow<DataType> {
         hashtable_ordered.emplace(i);
       ar << RMAWindow<DataType>::initialized_ << totalsize_ << hashtable_ordered;
 
-      // Process 0 collects and saves tensor's contents, tile by tile
+      // When the archive has an arrays file, every process writes its local block there directly
+      const bool sliced = ArrayWriter::current() != nullptr;
+      ar << sliced;
+      if (sliced) {
+        if (RMAWindow<DataType>::initialized_) {
+          const bool has_local = local_lo_ != std::numeric_limits<size_t>::max();
+          const size_t lo = has_local ? local_lo_ : 0;
+          const size_t hi = has_local ? local_hi_ : 0;
+          const auto* local = reinterpret_cast<const char*>(RMAWindow<DataType>::local_data());
+          const ArrayEntry entry = ArrayWriter::current()->write(local, totalsize_*sizeof(DataType), lo*sizeof(DataType), hi*sizeof(DataType));
+          ar << entry;
+        }
+      // Otherwise process 0 collects and saves tensor's contents, tile by tile
       // Other processes do nothing; this requires them to be writing to a different file from Process 0
-      if (mpi__->rank() == 0) {
+      } else if (mpi__->rank() == 0) {
         for (auto& i : hashtable_ordered) {
           size_t rank, off, size;
           std::tie(rank, off, size) = locate(i.first);
@@ -134,10 +147,14 @@ class StorageIncore : public RMAWindow<DataType> {
     }
 
     template<class Archive>
-    void load(Archive& ar, const unsigned int) {
+    void load(Archive& ar, const unsigned int file_version) {
       std::map<size_t, std::pair<size_t, size_t>> hashtable_ordered;
       bool init;
+      bool sliced = false;
       ar >> init >> totalsize_ >> hashtable_ordered;
+      // version 0 always stores the tiles in the archive
+      if (file_version > 0)
+        ar >> sliced;
 
       // Determine distribution information (assuming mpi__->size() might have changed)
       const size_t blocksize = (totalsize_-1)/mpi__->size()+1;
@@ -165,6 +182,23 @@ class StorageIncore : public RMAWindow<DataType> {
       if (init)
         initialize();
 
+      if (sliced) {
+        // each process maps in its own block
+        if (init) {
+          ArrayEntry entry;
+          ar >> entry;
+          if (!ArrayReader::current() || entry.size != totalsize_*sizeof(DataType))
+            throw std::runtime_error("Array data referenced by the archive cannot be found. The .arrays file may be missing or inconsistent.");
+          // local_data() fences the window, which is collective; every process calls it whether or not it owns a block
+          auto* local = reinterpret_cast<char*>(RMAWindow<DataType>::local_data());
+          if (local_lo_ != std::numeric_limits<size_t>::max())
+            ArrayReader::current()->read(entry, local, local_lo_*sizeof(DataType), local_hi_*sizeof(DataType));
+          RMAWindow<DataType>::fence();
+        }
+        mpi__->barrier();
+        return;
+      }
+
       // All processes read the whole archive, and save the data that belong to them
       for (auto& i : hashtable_ordered) {
         size_t rank, off, size;
@@ -256,7 +290,10 @@ using Storage = StorageIncore<DataType>;
 }
 
 #include <src/util/archive.h>
+#include <boost/serialization/version.hpp>
 BOOST_CLASS_EXPORT_KEY(bagel::SMITH::StorageIncore<double>)
 BOOST_CLASS_EXPORT_KEY(bagel::SMITH::StorageIncore<std::complex<double>>)
+BOOST_CLASS_VERSION(bagel::SMITH::StorageIncore<double>, 1)
+BOOST_CLASS_VERSION(bagel::SMITH::StorageIncore<std::complex<double>>, 1)
 
 #endif
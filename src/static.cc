@@ -31,6 +31,8 @@
 #include <src/util/string.h>
 #include <src/util/parallel/mpi_interface.h>
 #include <src/util/parallel/resources.h>
+#include <src/util/math/eigensolver.h>
+#include <src/util/parallel/profiler.h>
 
 // They are used from other files
 namespace bagel{
@@ -64,6 +66,12 @@ void static_variables() {
     resources__ = resources.get();
   }
 
+  // LAPACK driver for dense eigenproblems
+  set_eigensolver_default(parse_eigensolver(getenv_multiple("BAGEL_EIGENSOLVER")));
+
+  // profile of the run, written to $BAGEL_PROFILE.json and $BAGEL_PROFILE.folded at the end
+  Profiler::enable(getenv_multiple("BAGEL_PROFILE"));
+
   // rounding mode in std::rint, std::lrint, and std::llrint
   fesetround(FE_TONEAREST);
 }
@@ -79,3 +79,5 @@ bool compare(const T a, const T b, const double thr = THRESH) {
 #include <src/testimpl/test_pseudospin.cc>
 #include <src/testimpl/test_smith.cc>
 #include <src/testimpl/test_response.cc>
+#include <src/testimpl/test_profiler.cc>
+#include <src/testimpl/test_eigensolver.cc>
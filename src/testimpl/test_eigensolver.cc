@@ -0,0 +1,115 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: test_eigensolver.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <random>
+#include <src/util/math/eigensolver.h>
+
+using namespace bagel;
+
+double random_element(std::mt19937& gen, std::uniform_real_distribution<double>& dist, const double) { return dist(gen); }
+std::complex<double> random_element(std::mt19937& gen, std::uniform_real_distribution<double>& dist, const std::complex<double>) {
+  const double re = dist(gen);
+  return std::complex<double>(re, dist(gen));
+}
+
+// random symmetric (Hermitian) n x n matrix in column-major order
+template<typename DataType>
+std::vector<DataType> random_hermitian(const int n) {
+  std::mt19937 gen(n);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<DataType> out(n*n);
+  for (int j = 0; j != n; ++j) {
+    out[j+j*n] = dist(gen);
+    for (int i = j+1; i != n; ++i) {
+      out[i+j*n] = random_element(gen, dist, DataType());
+      out[j+i*n] = detail::conj(out[i+j*n]);
+    }
+  }
+  return out;
+}
+
+// eigenpairs istart, ..., iend-1 by the given solver (the full spectrum if istart < 0); returns the largest deviation of
+// the eigenvalues from those by QR and the largest residual |A z - e z|
+template<typename DataType>
+double eigensolver_error(const EigenSolver solver, const int n, const int istart = -1, const int iend = -1, const bool default_range = false) {
+  const std::vector<DataType> a = random_hermitian<DataType>(n);
+
+  std::vector<DataType> ref(a);
+  std::vector<double> eigref(n);
+  syev(EigenSolver::QR, n, ref.data(), n, eigref.data());
+
+  std::vector<DataType> work(a);
+  std::vector<DataType> z;
+  std::vector<double> eig(n);
+  int offset = 0;
+  if (istart < 0) {
+    syev(solver, n, work.data(), n, eig.data());
+    z = work;
+  } else {
+    z.resize(n*(iend-istart));
+    if (default_range)
+      syev_range(n, work.data(), n, eig.data(), z.data(), n, istart, iend);
+    else
+      syev_range(solver, n, work.data(), n, eig.data(), z.data(), n, istart, iend);
+    offset = istart;
+  }
+  const int m = z.size() / n;
+
+  double out = 0.0;
+  for (int k = 0; k != m; ++k) {
+    out = std::max(out, std::fabs(eig[k] - eigref[k+offset]));
+    for (int i = 0; i != n; ++i) {
+      DataType r = -eig[k] * z[i+k*n];
+      for (int j = 0; j != n; ++j)
+        r += a[i+j*n] * z[j+k*n];
+      out = std::max(out, std::abs(r));
+    }
+  }
+  return out;
+}
+
+BOOST_AUTO_TEST_SUITE(TEST_EIGENSOLVER)
+
+BOOST_AUTO_TEST_CASE(FULL) {
+    // 250 is above eigensolver_auto_threshold__, so that Auto uses divide-and-conquer
+    for (const int n : {50, 250})
+      for (const EigenSolver solver : {EigenSolver::QR, EigenSolver::DivideConquer, EigenSolver::MRRR, EigenSolver::Auto}) {
+        BOOST_CHECK(eigensolver_error<double>(solver, n) < 1.0e-10);
+        BOOST_CHECK(eigensolver_error<std::complex<double>>(solver, n) < 1.0e-10);
+      }
+}
+
+BOOST_AUTO_TEST_CASE(RANGE) {
+    const int n = 250;
+    for (const EigenSolver solver : {EigenSolver::QR, EigenSolver::DivideConquer, EigenSolver::MRRR, EigenSolver::Auto}) {
+      BOOST_CHECK(eigensolver_error<double>(solver, n, 0, 10) < 1.0e-10);
+      BOOST_CHECK(eigensolver_error<double>(solver, n, 100, 130) < 1.0e-10);
+      BOOST_CHECK(eigensolver_error<std::complex<double>>(solver, n, 0, 10) < 1.0e-10);
+      BOOST_CHECK(eigensolver_error<std::complex<double>>(solver, n, 100, 130) < 1.0e-10);
+    }
+    BOOST_CHECK(eigensolver_error<double>(EigenSolver::MRRR, n, 240, 250, true) < 1.0e-10);
+    BOOST_CHECK(eigensolver_error<std::complex<double>>(EigenSolver::MRRR, n, 240, 250, true) < 1.0e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
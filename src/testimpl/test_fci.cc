@@ -108,11 +108,14 @@ BOOST_AUTO_TEST_CASE(KNOWLES_HANDY) {
 //  BOOST_CHECK(compare(fci_energy("hf_sto3g_fci_restart"), reference_fci_energy()));
 #endif
     BOOST_CHECK(compare(fci_energy("hhe_svp_fci_kh_trip"), reference_fci_energy2()));
+    BOOST_CHECK(compare(fci_energy("hf_sto3g_fci_spill"), reference_fci_energy()));
+    BOOST_CHECK(compare(fci_energy("hf_sto3g_fci_kh_c2v")[0], reference_fci_energy()[0]));
 }
 
 BOOST_AUTO_TEST_CASE(HARRISON_ZARRABIAN) {
     BOOST_CHECK(compare(fci_energy("hf_sto3g_fci_hz"), reference_fci_energy()));
     BOOST_CHECK(compare(fci_energy("hhe_svp_fci_hz_trip"), reference_fci_energy2()));
+    BOOST_CHECK(compare(fci_energy("hf_sto3g_fci_hz_c2v")[0], reference_fci_energy()[0]));
 }
 
 #ifdef HAVE_MPI_H
@@ -62,6 +62,45 @@ std::vector<double> run_force(std::string filename) {
   std::cout.rdbuf(backup_stream);
   return out;
 }
+
+// maximum deviation of the gradient computed with the Schwarz screening threshold thresh from the unscreened one
+double screening_error(std::string filename, const double thresh) {
+
+  std::string outputname = filename + ".testout";
+  std::string inputname = location__ + filename + ".json";
+  auto ofs = std::make_shared<std::ofstream>(outputname, std::ios::trunc);
+  std::streambuf* backup_stream = std::cout.rdbuf(ofs->rdbuf());
+
+  auto idata = std::make_shared<const PTree>(inputname);
+  auto keys = idata->get_child("bagel");
+  std::shared_ptr<const Geometry> geom, geom0;
+  std::shared_ptr<const Reference> ref;
+
+  double out = -1.0;
+
+  for (auto& itree : *keys) {
+    const std::string method = to_lower(itree->get<std::string>("title", ""));
+
+    if (method == "molecule") {
+      auto screened = std::make_shared<PTree>(*itree);
+      screened->put("schwarz_thresh", thresh);
+      geom = std::make_shared<const Geometry>(screened);
+      auto exact = std::make_shared<PTree>(*itree);
+      exact->put("schwarz_thresh", 0.0);
+      geom0 = std::make_shared<const Geometry>(exact);
+    } else if (method == "force") {
+      std::shared_ptr<const GradFile> grad = std::make_shared<Force>(itree, geom, ref)->compute();
+      std::shared_ptr<const GradFile> grad0 = std::make_shared<Force>(itree, geom0, ref)->compute();
+      for (int i = 0; i != grad->size(); ++i)
+        out = std::max(out, std::fabs(grad->data()[i] - grad0->data()[i]));
+    } else {
+      throw std::logic_error("Not yet implemented (screening_error)");
+    }
+  }
+  assert(out >= 0.0);
+  std::cout.rdbuf(backup_stream);
+  return out;
+}
 std::vector<double> reference_scf_finite_mix() {
   std::vector<double> out(6);
   out[2] = -0.416074;
@@ -116,6 +155,12 @@ BOOST_AUTO_TEST_CASE(Finite_Grad) {
 #endif
 }
 
+BOOST_AUTO_TEST_CASE(Screened_Grad) {
+    // without the derivative factors in the bound the errors are close to the thresholds
+    BOOST_CHECK(screening_error("hf_svp_dfhf_grad", 1.0e-5) < 5.0e-6);
+    BOOST_CHECK(screening_error("hf_svp_dfhf_grad", 1.0e-3) < 1.0e-4);
+}
+
 BOOST_AUTO_TEST_CASE(Hcore_Grad) {
     BOOST_CHECK(compare(run_force("hf_svp_dfhf_dkh_grad"),   reference_dkh_grad(), 1.0e-5));
 }
@@ -76,6 +76,7 @@ BOOST_AUTO_TEST_SUITE(TEST_LOCALIZE)
 
 BOOST_AUTO_TEST_CASE(PML) {
     BOOST_CHECK(compare(localization("benzene_sto3g_pml"),0.7951349703, 0.000001));
+    BOOST_CHECK(compare(localization("benzene_sto3g_pml_qn"),0.7951349703, 0.000001));
     BOOST_CHECK(compare(localization("watertrimer_sto3g_pml_region"),0.9999109690, 0.000001));
 }
 
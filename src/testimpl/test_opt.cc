@@ -23,6 +23,7 @@
 //
 
 #include <src/opt/optimize.h>
+#include <src/opt/qmmm.h>
 #include <src/wfn/reference.h>
 
 std::vector<double> run_opt(std::string filename) {
@@ -57,6 +58,41 @@ std::vector<double> run_opt(std::string filename) {
   return out;
 }
 
+// MM energy of the in-process force field, and the largest deviation of its gradient from central differences
+std::pair<double,double> qmmm_internal(std::string filename) {
+  auto ofs = std::make_shared<std::ofstream>(filename + ".testout", std::ios::trunc);
+  std::streambuf* backup_stream = std::cout.rdbuf(ofs->rdbuf());
+
+  auto idata = std::make_shared<const PTree>(location__ + filename + ".json");
+  auto keys = idata->get_child("bagel");
+  std::shared_ptr<const PTree> mol = *keys->begin();
+  std::shared_ptr<const PTree> opt = *std::next(keys->begin());
+  auto geom = std::make_shared<const Geometry>(mol);
+
+  auto mm = std::make_shared<const QMMM_Internal>(opt, geom);
+  mm->edit_input(geom);
+  double energy;
+  std::shared_ptr<GradFile> grad;
+  std::tie(energy, grad) = mm->do_grad(geom->natom());
+
+  const double h = 1.0e-4;
+  double error = 0.0;
+  for (int i = 0; i != geom->natom(); ++i)
+    for (int k = 0; k != 3; ++k) {
+      std::array<double,2> en;
+      for (int s = 0; s != 2; ++s) {
+        auto displ = std::make_shared<Matrix>(3, geom->natom());
+        displ->element(k, i) = s == 0 ? h : -h;
+        mm->edit_input(std::make_shared<const Geometry>(*geom, displ, mol, false, true));
+        en[s] = std::get<0>(mm->do_grad(geom->natom()));
+      }
+      error = std::max(error, std::fabs((en[0]-en[1])/(2.0*h) - grad->element(k, i)));
+    }
+
+  std::cout.rdbuf(backup_stream);
+  return {energy, error};
+}
+
 std::vector<double> reference_scf_opt() {
   std::vector<double> out(6);
   out[2] = 1.749334;
@@ -145,6 +181,12 @@ std::vector<double> reference_ch2_opt() {
 
 BOOST_AUTO_TEST_SUITE(TEST_OPT)
 
+BOOST_AUTO_TEST_CASE(QMMM_Internal_MM) {
+    const std::pair<double,double> mm = qmmm_internal("hf_svp_dfhf_qmmm_internal");
+    BOOST_CHECK(compare(mm.first, -0.00802805));
+    BOOST_CHECK(mm.second < 1.0e-7);
+}
+
 BOOST_AUTO_TEST_CASE(DF_HF_Opt) {
     BOOST_CHECK(compare(run_opt("hf_svp_dfhf_opt"),       reference_scf_opt(),      1.0e-4));
     BOOST_CHECK(compare(run_opt("hf_svp_dfhf_opt_cart"),  reference_scf_opt_cart(), 1.0e-4));
@@ -0,0 +1,94 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: test_profiler.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <functional>
+#include <src/util/parallel/profiler.h>
+#include <src/util/taskqueue.h>
+
+using namespace bagel;
+
+// returns the region at the given path in the merged tree, or nullptr
+std::shared_ptr<const PTree> profile_region(std::shared_ptr<const PTree> regions, const std::vector<std::string>& path) {
+  std::shared_ptr<const PTree> out;
+  for (auto& name : path) {
+    out.reset();
+    for (auto& i : *regions)
+      if (i->get<std::string>("name") == name) {
+        out = i;
+        break;
+      }
+    if (!out) break;
+    regions = out->get_child("children");
+  }
+  return out;
+}
+
+// runs a TaskQueue twice inside an outer region and returns the calls of {outer, TaskQueue, worker, inner}
+std::vector<size_t> profile_calls(const std::string prefix, const size_t ntask) {
+  auto ofs = std::make_shared<std::ofstream>(prefix + ".testout", std::ios::trunc);
+  std::streambuf* backup_stream = std::cout.rdbuf(ofs->rdbuf());
+
+  // report() disables the profiler; a profile requested with BAGEL_PROFILE is continued afterwards
+  const std::string previous = Profiler::enabled() ? Profiler::prefix() : std::string();
+  Profiler::enable(prefix);
+  {
+    ProfileRegion outer("outer");
+    for (int n = 0; n != 2; ++n) {
+      // the threads of the first queue have exited, so the second one runs on recycled tables
+      TaskQueue<std::function<void(void)>> tasks(ntask);
+      for (size_t i = 0; i != ntask; ++i)
+        tasks.emplace_back([]() { ProfileRegion inner("inner"); });
+      tasks.compute(2);
+    }
+  }
+  Profiler::report();
+  Profiler::enable(previous);
+  mpi__->barrier();
+
+  std::vector<size_t> out;
+  auto regions = std::make_shared<const PTree>(prefix + ".json")->get_child("regions");
+  std::vector<std::string> path;
+  for (auto& name : {"outer", "TaskQueue", "worker", "inner"}) {
+    path.push_back(name);
+    auto region = profile_region(regions, path);
+    out.push_back(region ? region->get<size_t>("calls") : 0);
+  }
+
+  std::cout.rdbuf(backup_stream);
+  return out;
+}
+
+BOOST_AUTO_TEST_SUITE(TEST_PROFILER)
+
+BOOST_AUTO_TEST_CASE(TASKQUEUE) {
+    const size_t nproc = mpi__->size();
+    const size_t ntask = 50;
+    const std::vector<size_t> calls = profile_calls("profile_taskqueue", ntask);
+    BOOST_CHECK(calls[0] == nproc);
+    BOOST_CHECK(calls[1] == 2*nproc);
+    BOOST_CHECK(calls[2] >= 2*nproc);
+    BOOST_CHECK(calls[3] == 2*ntask*nproc);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,7 @@
 
 #include <sstream>
 #include <src/prop/multipole.h>
+#include <src/prop/moprint.h>
 #include <src/scf/hf/rhf.h>
 #include <src/scf/hf/rohf.h>
 #include <src/scf/hf/uhf.h>
@@ -60,6 +61,62 @@ std::vector<double> multipole(std::string filename) {
   return std::vector<double>();
 }
 
+// compares the tiled, screened grid evaluation of MOPrint with the pointwise evaluation using Overlap_Point
+class MOPrintGrid : public MOPrint {
+  public:
+    MOPrintGrid(std::shared_ptr<const PTree> idata, std::shared_ptr<const Geometry> geom, std::shared_ptr<const Reference> ref) : MOPrint(idata, geom, ref) { }
+
+    // largest deviation on the grid after it is displaced by shift along z
+    double max_deviation(const double shift) {
+      start_pos_[2] += shift;
+      double out = 0.0;
+      for (size_t start = 0; start < ngrid_; start += tilesize_) {
+        const size_t end = std::min(ngrid_, start+tilesize_);
+        std::vector<double> tile((end-start)*(norb_+1), 0.0);
+        std::vector<double> point((end-start)*(norb_+1), 0.0);
+        compute_tile(start, end, tile.data());
+        for (size_t pos = start; pos != end; ++pos)
+          computepoint(pos, point.data()+(pos-start)*(norb_+1));
+        for (size_t i = 0; i != tile.size(); ++i)
+          out = std::max(out, std::fabs(tile[i]-point[i]));
+      }
+      start_pos_[2] -= shift;
+      return out;
+    }
+};
+
+double moprint_deviation(std::string filename, const double shift) {
+  auto ofs = std::make_shared<std::ofstream>(filename + ".testout", std::ios::trunc);
+  std::streambuf* backup_stream = std::cout.rdbuf(ofs->rdbuf());
+
+  std::stringstream ss; ss << location__ << filename << ".json";
+  auto idata = std::make_shared<const PTree>(ss.str());
+  auto keys = idata->get_child("bagel");
+  std::shared_ptr<Geometry> geom;
+  std::shared_ptr<const Reference> ref;
+
+  for (auto& itree : *keys) {
+    const std::string method = to_lower(itree->get<std::string>("title", ""));
+
+    if (method == "molecule") {
+      geom = std::make_shared<Geometry>(itree);
+
+    } else if (method == "hf") {
+      auto scf = std::make_shared<RHF>(itree, geom);
+      scf->compute();
+      ref = scf->conv_to_ref();
+
+    } else if (method == "moprint") {
+      MOPrintGrid moprint(itree, geom, ref);
+      const double out = moprint.max_deviation(shift);
+      std::cout.rdbuf(backup_stream);
+      return out;
+    }
+  }
+  assert(false);
+  return 0.0;
+}
+
 static std::vector<double> hf_svp_dfhf_multipole_ref() {
   return std::vector<double>{0.0, 0.0, 1.055510, -4.236243, 0.000000, -4.236243, -0.000000, -0.000000, -1.532119};
 }
@@ -70,4 +127,10 @@ BOOST_AUTO_TEST_CASE(MULTIPOLE) {
     BOOST_CHECK(compare<std::vector<double>>(multipole("hf_svp_dfhf"),        hf_svp_dfhf_multipole_ref(), 1.0e-6));
 }
 
+BOOST_AUTO_TEST_CASE(MOPRINT) {
+    BOOST_CHECK(moprint_deviation("hf_svp_moprint",  0.0) < 1.0e-8);
+    // the grid is moved far enough from the molecule that every tile is screened out
+    BOOST_CHECK(moprint_deviation("hf_svp_moprint", 40.0) < 1.0e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,7 @@
 
 
 #include <src/ci/ras/rasci.h>
+#include <src/ci/ras/distrasci.h>
 
 std::vector<double> ras_energy(std::string inp) {
 
@@ -52,7 +53,12 @@ std::vector<double> ras_energy(std::string inp) {
       scf->compute();
       ref = scf->conv_to_ref();
     } else if (method == "ras") {
-      std::shared_ptr<RASCI> ras = std::make_shared<RASCI>(itree, geom, ref);
+      const std::string algorithm = itree->get<std::string>("algorithm", "");
+      std::shared_ptr<RASCI> ras;
+      if (algorithm == "dist" || algorithm == "parallel")
+        ras = std::make_shared<DistRASCI>(itree, geom, ref);
+      else
+        ras = std::make_shared<RASCI>(itree, geom, ref);
 
       ras->compute();
       std::cout.rdbuf(backup_stream);
@@ -99,6 +105,9 @@ BOOST_AUTO_TEST_CASE(FCI_EQUIVALENT) {
 BOOST_AUTO_TEST_CASE(RESTRICTED) {
     BOOST_CHECK(compare(ras_energy("h2o_sto3g_ras_restricted"), reference_ras_energy_h2o_restricted()));
     BOOST_CHECK(compare(ras_energy("hhe_svp_ras_restricted"), reference_ras_energy_hhe_restricted()));
+#ifdef HAVE_MPI_H
+    BOOST_CHECK(compare(ras_energy("h2o_sto3g_ras_restricted_dist"), reference_ras_energy_h2o_restricted()));
+#endif
 }
 
 BOOST_AUTO_TEST_SUITE_END()
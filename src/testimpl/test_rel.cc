@@ -69,6 +69,8 @@ BOOST_AUTO_TEST_CASE(DIRAC_FOCK) {
     BOOST_CHECK(compare(rel_energy("hf_svp_coulomb"),        -99.93791152));
     BOOST_CHECK(compare(rel_energy("hf_svp_gaunt"),          -99.92699858));
     BOOST_CHECK(compare(rel_energy("hf_svp_breit"),          -99.92755305));
+    BOOST_CHECK(compare(rel_energy("hf_svp_gaunt_approx"),   -99.92699858));
+    BOOST_CHECK(compare(rel_energy("hf_svp_gaunt_thresh_small"), -99.92699858));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -28,6 +28,8 @@
 #include <src/scf/hf/uhf.h>
 #include <src/scf/sohf/soscf.h>
 #include <src/wfn/reference.h>
+#include <src/mat1e/hcore.h>
+#include <src/mat1e/overlap.h>
 
 using namespace bagel;
 
@@ -81,6 +83,52 @@ double scf_energy(std::string filename, std::string extension = ".json") {
   return ref->energy(0);
 }
 
+// largest deviation of hcore from the exact point-charge integrals
+double charge_hcore_error(std::string filename) {
+  std::stringstream ss; ss << location__ << filename << ".json";
+  auto idata = std::make_shared<const PTree>(ss.str());
+  auto geom = std::make_shared<const Geometry>(*idata->get_child("bagel")->begin());
+  auto approx = std::make_shared<const Hcore>(geom, geom->hcoreinfo());
+  auto exact = std::make_shared<const Hcore>(geom);
+  assert(geom->hcoreinfo()->charge_thresh() > 0.0);
+  const Matrix diff = *approx - *exact;
+  return std::abs(*std::max_element(diff.data(), diff.data()+diff.size(), [](const double a, const double b) { return std::abs(a) < std::abs(b); }));
+}
+
+// largest deviation of the fitting coefficients computed within and after mpi__->split() from those computed before it
+double df_split_error(std::string filename) {
+  auto ofs = std::make_shared<std::ofstream>(filename + "_split.testout", std::ios::trunc);
+  std::streambuf* backup_stream = std::cout.rdbuf(ofs->rdbuf());
+
+  std::stringstream ss; ss << location__ << filename << ".json";
+  auto idata = std::make_shared<const PTree>(ss.str());
+  auto geom = std::make_shared<const Geometry>(*idata->get_child("bagel")->begin());
+  auto den = std::make_shared<const Overlap>(geom);
+  std::shared_ptr<const VectorB> ref = geom->df()->compute_cd(den);
+
+  std::vector<std::shared_ptr<VectorB>> cd;
+  mpi__->split(std::max(1, mpi__->size()/2));
+  {
+    // DF objects made within the split live on the node communicator of the group
+    auto geom_split = std::make_shared<const Geometry>(*idata->get_child("bagel")->begin());
+    cd.push_back(geom_split->df()->compute_cd(den));
+    // the one made before the split only sees the blocks of the group; the groups are summed after merge()
+    cd.push_back(geom->df()->compute_cd(den));
+    const double fac = 1.0 / mpi__->size();
+    std::for_each(cd.back()->begin(), cd.back()->end(), [&fac](double& i) { i *= fac; });
+  }
+  mpi__->merge();
+  mpi__->allreduce(cd.back()->data(), cd.back()->size());
+  cd.push_back(geom->df()->compute_cd(den));
+
+  double out = 0.0;
+  for (auto& i : cd)
+    for (size_t j = 0; j != ref->size(); ++j)
+      out = std::max(out, std::abs((*i)(j) - (*ref)(j)));
+  std::cout.rdbuf(backup_stream);
+  return out;
+}
+
 BOOST_AUTO_TEST_SUITE(TEST_SCF)
 
 BOOST_AUTO_TEST_CASE(DF_HF) {
@@ -91,7 +139,15 @@ BOOST_AUTO_TEST_CASE(DF_HF) {
 #endif
     BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_ext"),    -99.83765614));
     BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_cart"),   -99.84911270));
+    BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_c2v"),    -99.84772354));
+    BOOST_CHECK(compare(scf_energy("h2o_svp_dfhf_c2v"),   scf_energy("h2o_svp_dfhf")));
+    BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_purification"), -99.84772354));
+#ifndef DISABLE_SERIALIZATION
+    BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_purification_restart"), -99.84772354));
+#endif
+    BOOST_CHECK(df_split_error("hf_svp_dfhf") < 1.0e-10);
     BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_charge"), -99.78567137));
+    BOOST_CHECK(charge_hcore_error("hf_svp_dfhf_field") < 1.0e-8);
     BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_dkh"),    -99.92869677));
     BOOST_CHECK(compare(scf_energy("hf_mix_dfhf"),        -99.83889193));
     BOOST_CHECK(compare(scf_energy("hf_mix2_dfhf"),       -99.83889193));
@@ -100,6 +156,7 @@ BOOST_AUTO_TEST_CASE(DF_HF) {
     BOOST_CHECK(compare(scf_energy("hf_new_dfhf"),        -99.97989929));
     BOOST_CHECK(compare(scf_energy("hcl_svp_dfhf"),      -459.93784632));
     BOOST_CHECK(compare(scf_energy("cuh2_ecp_hf"),       -196.12254012));
+    BOOST_CHECK(compare(scf_energy("cu2_ecp_hf"),        -389.99658612));
     BOOST_CHECK(compare(scf_energy("hbr_ecp_sohf"),       -13.68431370));
     BOOST_CHECK(compare(scf_energy("h2o_svp_fmm"),        -151.91459783));
 #ifndef DISABLE_SERIALIZATION
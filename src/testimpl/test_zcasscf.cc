@@ -24,6 +24,7 @@
 
 
 #include <src/multi/zcasscf/zcassecond.h>
+#include <src/smith/smith.h>
 
 double relcas_energy(std::string inp) {
 
@@ -74,11 +75,18 @@ double relcas_energy(std::string inp) {
         throw std::logic_error("unknown algorithm");
       }
 
+#ifdef COMPILE_SMITH
+    } else if (method == "relsmith") {
+      auto smith = std::make_shared<RelSmith>(itree, geom, ref);
+      smith->compute();
+      energy = smith->algo()->energy(0);
+#endif
+
 #ifndef DISABLE_SERIALIZATION
     } else if (method == "save_ref") {
       const std::string name = itree->get<std::string>("file", "");
       assert (name != "");
-      OArchive archive(name);
+      OArchive archive(name, itree->get<bool>("compress", false));
       archive << ref;
 
     } else if (method == "load_ref") {
@@ -106,6 +114,9 @@ BOOST_AUTO_TEST_CASE(ZCASSCF) {
   BOOST_CHECK(compare(relcas_energy("o2_svp_triplet_breit"),   -149.56647946));
 #ifndef DISABLE_SERIALIZATION
   BOOST_CHECK(compare(relcas_energy("hf_tzvpp_zcasscf_saveref"), -100.03016820));
+#ifdef COMPILE_SMITH
+  BOOST_CHECK(compare(relcas_energy("hf_svp_relcaspt2_restart"), relcas_energy("hf_svp_relcaspt2")));
+#endif
 #endif
 }
 
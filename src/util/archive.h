@@ -28,29 +28,51 @@
 
 #include <string>
 #include <fstream>
+#include <streambuf>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/serialization/export.hpp>
+#include <src/util/io/arraysection.h>
+#include <src/util/parallel/mpi_interface.h>
 
 namespace bagel {
 
+// discards everything written to it
+class NullBuffer : public std::streambuf {
+  protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Large arrays are written to name.arrays in chunks (compressed with zlib if requested), each process writing its own slice;
+// name.archive holds the rest and is written by process 0. Construction and serialization are therefore collective.
 class OArchive {
   protected:
     std::string filename_;
+    NullBuffer null_;
     std::ofstream os_;
+    std::shared_ptr<ArrayWriter> arrays_;
 
     using Ostream = boost::archive::binary_oarchive;
     std::shared_ptr<Ostream> archive_;
 
   public:
-    OArchive(std::string name) : filename_(name+".archive"), os_(filename_) {
-      if (!os_.is_open())
-        throw std::runtime_error("Error trying to create the file " + filename_ + ".  Possibly the target directory is not accessible.");
+    OArchive(std::string name, const bool compress = false) : filename_(name+".archive") {
+      arrays_ = std::make_shared<ArrayWriter>(name+".arrays", compress);
+      if (mpi__->rank() == 0) {
+        os_.open(filename_);
+        if (!os_.is_open())
+          throw std::runtime_error("Error trying to create the file " + filename_ + ".  Possibly the target directory is not accessible.");
+      } else {
+        // the other processes go through the same motions to take part in writing the arrays
+        os_.std::ios::rdbuf(&null_);
+      }
       archive_ = std::make_shared<Ostream>(os_);
     }
 
     template<typename T>
     OArchive& operator<<(const T& val) {
+      ArrayScope scope(arrays_.get(), nullptr);
       *archive_ << val;
       return *this;
     }
@@ -64,12 +86,13 @@ class IArchive {
   protected:
     std::string filename_;
     std::ifstream is_;
+    std::shared_ptr<ArrayReader> arrays_;
 
     using Istream = boost::archive::binary_iarchive;
     std::shared_ptr<Istream> archive_;
 
   public:
-    IArchive(std::string name) : filename_(name+".archive"), is_(filename_) {
+    IArchive(std::string name) : filename_(name+".archive"), is_(filename_), arrays_(std::make_shared<ArrayReader>(name+".arrays")) {
       if (!is_.is_open())
         throw std::runtime_error("File not found: " + filename_);
       archive_ = std::make_shared<Istream>(is_);
@@ -79,6 +102,7 @@ class IArchive {
     IArchive& operator>>(T& val) {
 
       try {
+        ArrayScope scope(nullptr, arrays_.get());
         *archive_ >> val;
 
       // just to make error messages more user-friendly
@@ -35,6 +35,9 @@ extern "C" {
 
  void daxpy_(const int*, const double*, const double*, const int*, double*, const int*);
  void dsyev_(const char*, const char*, const int*, double*, const int*, double*, double*, const int*, int*);
+ void dsyevd_(const char*, const char*, const int*, double*, const int*, double*, double*, const int*, int*, const int*, int*);
+ void dsyevr_(const char*, const char*, const char*, const int*, double*, const int*, const double*, const double*, const int*, const int*,
+              const double*, int*, double*, double*, const int*, int*, double*, const int*, int*, const int*, int*);
  void dgesv_(const int* n, const int* nrhs, double* a, const int* lda, int* ipiv, double* b, const int* ldb, int* info);
  void dscal_(const int*, const double*, double*, const int*);
  double ddot_(const int*, const double*, const int*, const double*, const int*);
@@ -81,6 +84,10 @@ extern "C" {
  void zgeev_(const char*, const char*, const int*, std::complex<double>*, const int*, std::complex<double>*,
              std::complex<double>*, const int*, std::complex<double>*, const int*, std::complex<double>*, const int*, double*, int*);
  void zheev_(const char*, const char*, const int*, std::complex<double>*, const int*, double*, std::complex<double>*, const int*, double*, int*);
+ void zheevd_(const char*, const char*, const int*, std::complex<double>*, const int*, double*, std::complex<double>*, const int*,
+              double*, const int*, int*, const int*, int*);
+ void zheevr_(const char*, const char*, const char*, const int*, std::complex<double>*, const int*, const double*, const double*, const int*, const int*,
+              const double*, int*, double*, std::complex<double>*, const int*, int*, std::complex<double>*, const int*, double*, const int*, int*, const int*, int*);
  void zhesv_(const char* uplo, const int* n, const int* nrhs, std::complex<double>* a, const int* lda, int* ipiv,
              std::complex<double>* b, const int* ldb, std::complex<double>* work, const int* lwork, int* info);
  void zgesv_(const int* n, const int* nrhs, std::complex<double>* a, const int* lda, int* ipiv,
@@ -121,6 +128,11 @@ namespace {
  void dsyev_(const char* a, const char* b, const int c, std::unique_ptr<double []>& d, const int e,
              std::unique_ptr<double []>& f, std::unique_ptr<double []>& g, const int h, int& i)
              { ::dsyev_(a,b,&c,d.get(),&e,f.get(),g.get(),&h,&i);}
+ void dsyevd_(const char* a, const char* b, const int c, double* d, const int e, double* f, double* g, const int h, int* i, const int j, int& k)
+             { ::dsyevd_(a,b,&c,d,&e,f,g,&h,i,&j,&k); }
+ void dsyevr_(const char* a, const char* b, const char* c, const int d, double* e, const int f, const double g, const double h, const int i, const int j,
+              const double k, int& l, double* m, double* n, const int o, int* p, double* q, const int r, int* s, const int t, int& u)
+             { ::dsyevr_(a,b,c,&d,e,&f,&g,&h,&i,&j,&k,&l,m,n,&o,p,q,&r,s,&t,&u); }
  void dsysv_(const char* uplo, const int n, const int nrhs, double* a, const int lda, int* ipiv,
              double* b, const int ldb, double* work, const int lwork, int& info)
              { ::dsysv_(uplo, &n, &nrhs, a, &lda, ipiv, b, &ldb, work, &lwork, &info);}
@@ -202,6 +214,11 @@ namespace {
  void zheev_(const char* a, const char* b, const int c, std::unique_ptr<std::complex<double> []>& d, const int e,
              std::unique_ptr<double []>& f, std::unique_ptr<std::complex<double> []>& g, const int h, std::unique_ptr<double[]>& i, int& j)
              { ::zheev_(a,b,&c,d.get(),&e,f.get(),g.get(),&h,i.get(),&j); }
+ void zheevd_(const char* a, const char* b, const int c, std::complex<double>* d, const int e, double* f, std::complex<double>* g, const int h,
+              double* i, const int j, int* k, const int l, int& m) { ::zheevd_(a,b,&c,d,&e,f,g,&h,i,&j,k,&l,&m); }
+ void zheevr_(const char* a, const char* b, const char* c, const int d, std::complex<double>* e, const int f, const double g, const double h, const int i, const int j,
+              const double k, int& l, double* m, std::complex<double>* n, const int o, int* p, std::complex<double>* q, const int r, double* s, const int t,
+              int* u, const int v, int& w) { ::zheevr_(a,b,c,&d,e,&f,&g,&h,&i,&j,&k,&l,m,n,&o,p,q,&r,s,&t,u,&v,&w); }
  void zgeev_(const char* a, const char* b, const int c, std::complex<double>* d, const int e, std::complex<double>* f,
              std::complex<double>* g, const int h, std::complex<double>* i, const int j, std::complex<double>* k, const int l, double* m, int& n)
              { ::zgeev_(a,b,&c,d,&e,f,g,&h,i,&j,k,&l,m,&n); }
@@ -0,0 +1,97 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: basisformat.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __SRC_INPUT_BASISFORMAT_H
+#define __SRC_INPUT_BASISFORMAT_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace bagel {
+namespace basis_format {
+
+// Indexed basis-set file (*.bbs), generated from the JSON files at build time:
+//   char[8]   magic "BAGELBAS"
+//   uint32    version
+//   uint32    number of elements
+//   entries   {char[8] element; uint64 offset; uint64 size} for each element
+//   records   compact JSON {"Element" : [...]} for each element (offset is from the beginning of the file)
+// so that only the elements in a molecule need to be parsed.
+static constexpr const char* magic = "BAGELBAS";
+static constexpr uint32_t version = 1;
+static constexpr size_t namelen = 8;
+
+struct Entry {
+  char name[namelen];
+  uint64_t offset;
+  uint64_t size;
+};
+
+inline size_t header_size(const size_t nelem) { return namelen + 2*sizeof(uint32_t) + nelem*sizeof(Entry); }
+
+inline void write(const boost::property_tree::ptree& basis, const std::string& filename) {
+  std::vector<Entry> entries;
+  std::vector<std::string> records;
+  size_t offset = header_size(basis.size());
+  for (auto& elem : basis) {
+    if (elem.first.size() >= namelen)
+      throw std::runtime_error("element name too long in the basis set: " + elem.first);
+    boost::property_tree::ptree wrap;
+    wrap.add_child(elem.first, elem.second);
+    std::stringstream ss;
+    boost::property_tree::json_parser::write_json(ss, wrap, false);
+    records.push_back(ss.str());
+
+    Entry e;
+    std::memset(e.name, 0, namelen);
+    std::strncpy(e.name, elem.first.c_str(), namelen-1);
+    e.offset = offset;
+    e.size = records.back().size();
+    entries.push_back(e);
+    offset += e.size;
+  }
+
+  std::ofstream ofs(filename, std::ios::binary);
+  if (!ofs.is_open())
+    throw std::runtime_error("cannot open " + filename);
+  const uint32_t nelem = entries.size();
+  ofs.write(magic, namelen);
+  ofs.write(reinterpret_cast<const char*>(&version), sizeof(uint32_t));
+  ofs.write(reinterpret_cast<const char*>(&nelem), sizeof(uint32_t));
+  ofs.write(reinterpret_cast<const char*>(entries.data()), entries.size()*sizeof(Entry));
+  for (auto& r : records)
+    ofs.write(r.data(), r.size());
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,155 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: basislibrary.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <map>
+#include <mutex>
+#include <fstream>
+#include <src/util/input/basislibrary.h>
+#include <src/util/input/basisformat.h>
+
+using namespace std;
+using namespace bagel;
+
+namespace {
+
+class BasisFile {
+  protected:
+    string name_;
+    // indexed file
+    int fd_;
+    size_t bytes_;
+    const char* map_;
+    map<string, pair<uint64_t, uint64_t>> index_;
+    // JSON file (used when the indexed file is not available)
+    shared_ptr<const PTree> json_;
+
+    bool open_indexed(const string& file) {
+      fd_ = open(file.c_str(), O_RDONLY);
+      if (fd_ < 0) return false;
+      struct stat st;
+      fstat(fd_, &st);
+      bytes_ = st.st_size;
+      void* map = bytes_ >= basis_format::header_size(0) ? mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd_, 0) : MAP_FAILED;
+      if (map == MAP_FAILED) {
+        close(fd_);
+        return false;
+      }
+      map_ = static_cast<const char*>(map);
+
+      uint32_t version, nelem;
+      memcpy(&version, map_+basis_format::namelen, sizeof(uint32_t));
+      memcpy(&nelem, map_+basis_format::namelen+sizeof(uint32_t), sizeof(uint32_t));
+      if (memcmp(map_, basis_format::magic, basis_format::namelen) || version != basis_format::version || basis_format::header_size(nelem) > bytes_) {
+        munmap(const_cast<char*>(map_), bytes_);
+        close(fd_);
+        map_ = nullptr;
+        return false;
+      }
+      const char* ptr = map_ + basis_format::header_size(0);
+      for (uint32_t i = 0; i != nelem; ++i, ptr += sizeof(basis_format::Entry)) {
+        basis_format::Entry e;
+        memcpy(&e, ptr, sizeof(basis_format::Entry));
+        if (e.offset + e.size > bytes_)
+          throw runtime_error("basis set file " + file + " is corrupted");
+        index_.emplace(string(e.name), make_pair(e.offset, e.size));
+      }
+      return true;
+    }
+
+  public:
+    BasisFile(const string& name, const string& jsonfile) : name_(name), fd_(-1), bytes_(0), map_(nullptr) {
+      // the indexed file is used if it is not older than the JSON file
+      const size_t n = jsonfile.rfind(".json");
+      const string indexed = (n != string::npos && n+5 == jsonfile.size() ? jsonfile.substr(0, n) : jsonfile) + ".bbs";
+      struct stat sj, si;
+      const bool fresh = stat(indexed.c_str(), &si) == 0 && (stat(jsonfile.c_str(), &sj) != 0 || si.st_mtime >= sj.st_mtime);
+      if (!fresh || !open_indexed(indexed))
+        json_ = make_shared<const PTree>(jsonfile);
+    }
+
+    ~BasisFile() {
+      if (map_) {
+        munmap(const_cast<char*>(map_), bytes_);
+        close(fd_);
+      }
+    }
+
+    shared_ptr<const PTree> element(const string& elem) const {
+      if (json_) {
+        auto out = json_->get_child_optional(elem);
+        if (!out)
+          throw runtime_error("element " + elem + " is not found in basis set " + name_);
+        return out;
+      }
+      auto iter = index_.find(elem);
+      if (iter == index_.end())
+        throw runtime_error("element " + elem + " is not found in basis set " + name_);
+      stringstream ss(string(map_ + iter->second.first, iter->second.second));
+      boost::property_tree::ptree tree;
+      boost::property_tree::json_parser::read_json(ss, tree);
+      return make_shared<const PTree>(tree.get_child(elem), elem);
+    }
+};
+
+mutex library_mutex;
+map<string, shared_ptr<const BasisFile>> library_files;
+map<pair<string, string>, shared_ptr<const PTree>> library_elements;
+
+}
+
+
+string BasisLibrary::locate(string name) {
+  // convert name to lowercase so things like cc-pVDZ are read
+  const int split = name.find_last_of("/");
+  name = name.substr(0, split+1) + to_lower(name.substr(split+1));
+
+  // first the absolute path (or current directory), next the standard install location, and last the debug location
+  for (auto& file : {name, string(BASIS_DIR) + "/" + name + ".json", "../../src/basis/" + name + ".json"}) {
+    ifstream fs(file);
+    if (fs.is_open())
+      return file;
+  }
+  throw runtime_error(name + " cannot be opened. Please see if the file is in " + string(BASIS_DIR) + ".\n "
+                           + " You can also specify the full path to the basis file.");
+  return "";
+}
+
+
+shared_ptr<const PTree> BasisLibrary::element(const string& name, const string& elem) {
+  lock_guard<mutex> lock(library_mutex);
+  auto iter = library_elements.find(make_pair(name, elem));
+  if (iter != library_elements.end())
+    return iter->second;
+
+  auto file = library_files.find(name);
+  if (file == library_files.end())
+    file = library_files.emplace(name, make_shared<const BasisFile>(name, locate(name))).first;
+  shared_ptr<const PTree> out = file->second->element(elem);
+  library_elements.emplace(make_pair(name, elem), out);
+  return out;
+}
@@ -0,0 +1,44 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: basislibrary.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __SRC_INPUT_BASISLIBRARY_H
+#define __SRC_INPUT_BASISLIBRARY_H
+
+#include <src/util/input/input.h>
+
+namespace bagel {
+
+// Process-wide cache of basis sets. Only the elements that are requested are decoded, from the indexed file (*.bbs)
+// when one is installed next to the JSON file (memory-mapped), or else from the JSON file that is parsed once per process.
+class BasisLibrary {
+  public:
+    // returns the basis functions of element "elem" (e.g., "C") in the basis set "name"
+    static std::shared_ptr<const PTree> element(const std::string& name, const std::string& elem);
+    // returns the path to the JSON file of the basis set "name"
+    static std::string locate(std::string name);
+};
+
+}
+
+#endif
@@ -98,36 +98,6 @@ void PTree::print() const {
 }
 
 
-shared_ptr<const PTree> PTree::read_basis(string name) {
-  // convert name to lowercase so things like cc-pVDZ are read
-  const int split = name.find_last_of("/");
-  name = name.substr(0, split+1) + to_lower(name.substr(split+1));
-
-  shared_ptr<const PTree> out;
-  // first try the absolute path (or current directory)
-  try {
-    out = make_shared<const PTree>(name);
-  } catch (...) {
-    // next, the standard install location
-    try {
-      const string prefix(BASIS_DIR);
-      const string filename = prefix + "/" + name + ".json";
-      out = make_shared<const PTree>(filename);
-    } catch (...) {
-      // last, the debug location
-      const string filename = "../../src/basis/" + name + ".json";
-      try {
-        out = make_shared<const PTree>(filename);
-      } catch (...) {
-        throw runtime_error(name + " cannot be opened. Please see if the file is in " + string(BASIS_DIR) + ".\n "
-                                 + " You can also specify the full path to the basis file.");
-      }
-    }
-  }
-  return out;
-}
-
-
 shared_ptr<PTree> PTree::get_child(const string& key) const {
   auto out = data_.get_child_optional(key);
   if (!out) {
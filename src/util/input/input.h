@@ -148,9 +148,6 @@ class PTree {
     PTreeReverseIterator rend()   const;
 
     void print() const;
-
-    // static function to read basis files
-    static std::shared_ptr<const PTree> read_basis(std::string name);
 };
 
 template <> void PTree::push_back<std::shared_ptr<PTree>>(const std::shared_ptr<PTree>& pt);
@@ -0,0 +1,207 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: arraysection.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <bagel_config.h>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef HAVE_LIBZ
+ #include <zlib.h>
+#endif
+#include <src/util/io/arraysection.h>
+#include <src/util/taskqueue.h>
+#include <src/util/parallel/mpi_interface.h>
+
+using namespace std;
+using namespace bagel;
+
+ArrayWriter* ArrayWriter::current_ = nullptr;
+ArrayReader* ArrayReader::current_ = nullptr;
+
+
+ArrayWriter::ArrayWriter(const string& filename, const bool compress, const size_t chunksize)
+ : filename_(filename), end_(0), compress_(compress), chunksize_(chunksize) {
+#ifndef HAVE_LIBZ
+  compress_ = false;
+#endif
+  const string error = "Error trying to create the file " + filename_ + ".  Possibly the target directory is not accessible.";
+  // process 0 truncates the file before anyone writes into it; the broadcast also tells the others whether it succeeded
+  size_t created = 0;
+  if (mpi__->rank() == 0) {
+    fd_ = open(filename_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    created = fd_ >= 0 ? 1 : 0;
+  }
+  mpi__->broadcast(&created, 1, 0);
+  if (!created)
+    throw runtime_error(error);
+
+  if (mpi__->rank() != 0)
+    fd_ = open(filename_.c_str(), O_WRONLY);
+  // all processes throw if any of them cannot open the file
+  int failed = fd_ < 0 ? 1 : 0;
+  mpi__->allreduce(&failed, 1);
+  if (failed) {
+    if (fd_ >= 0)
+      close(fd_);
+    throw runtime_error(error);
+  }
+}
+
+
+ArrayWriter::~ArrayWriter() {
+  close(fd_);
+  mpi__->barrier();
+}
+
+
+ArrayEntry ArrayWriter::write(const char* data, const size_t n) {
+  const size_t lo = n / mpi__->size() * mpi__->rank() + min(n % mpi__->size(), static_cast<size_t>(mpi__->rank()));
+  const size_t hi = lo + n / mpi__->size() + (static_cast<size_t>(mpi__->rank()) < n % mpi__->size() ? 1 : 0);
+  return write(data + lo, n, lo, hi);
+}
+
+
+ArrayEntry ArrayWriter::write(const char* data, const size_t n, const size_t lo, const size_t hi) {
+  // chunk the local slice and (optionally) compress the chunks in threads
+  const size_t nchunk = (hi - lo + chunksize_ - 1) / chunksize_;
+  vector<size_t> start(nchunk), length(nchunk);
+  vector<vector<unsigned char>> buf(compress_ ? nchunk : 0);
+  TaskQueue<function<void(void)>> tasks(nchunk);
+  for (size_t i = 0; i != nchunk; ++i) {
+    start[i] = lo + i*chunksize_;
+    length[i] = min(chunksize_, hi - start[i]);
+#ifdef HAVE_LIBZ
+    if (compress_)
+      tasks.emplace_back([&, i]() {
+        uLongf len = compressBound(length[i]);
+        buf[i].resize(len);
+        if (compress2(reinterpret_cast<Bytef*>(buf[i].data()), &len, reinterpret_cast<const Bytef*>(data + start[i] - lo), length[i], 1) == Z_OK && len < length[i])
+          length[i] = len;
+        else
+          buf[i].clear();
+      });
+#endif
+  }
+  tasks.compute();
+
+  // exchange the chunk table so that every process can compute the file offsets
+  vector<size_t> counts(mpi__->size());
+  mpi__->allgather(&nchunk, 1, counts.data(), 1);
+  const size_t nmax = *max_element(counts.begin(), counts.end());
+  vector<size_t> send(2*nmax, 0), recv(2*nmax*mpi__->size());
+  for (size_t i = 0; i != nchunk; ++i) {
+    send[2*i] = start[i];
+    send[2*i+1] = length[i];
+  }
+  mpi__->allgather(send.data(), send.size(), recv.data(), send.size());
+
+  // chunks are placed in the order of their position in the array
+  vector<pair<size_t, size_t>> table;
+  for (size_t i = 0; i != recv.size(); i += 2)
+    if (recv[i+1])
+      table.emplace_back(recv[i], recv[i+1]);
+  sort(table.begin(), table.end());
+
+  ArrayEntry out;
+  out.size = n;
+  for (auto& i : table) {
+    out.start.push_back(i.first);
+    out.offset.push_back(end_);
+    out.length.push_back(i.second);
+    end_ += i.second;
+  }
+
+  // each process writes its own chunks
+  for (size_t i = 0; i != nchunk; ++i) {
+    const size_t j = lower_bound(out.start.begin(), out.start.end(), start[i]) - out.start.begin();
+    const char* source = compress_ && !buf[i].empty() ? reinterpret_cast<const char*>(buf[i].data()) : data + start[i] - lo;
+    for (size_t done = 0; done < length[i]; ) {
+      const ssize_t w = pwrite(fd_, source + done, length[i] - done, out.offset[j] + done);
+      if (w < 0)
+        throw runtime_error("Error writing to " + filename_);
+      done += w;
+    }
+  }
+  return out;
+}
+
+
+ArrayReader::ArrayReader(const string& filename) : filename_(filename), map_(nullptr), mapsize_(0) {
+  // the file is optional; archives without large arrays do not have one
+  const int fd = open(filename_.c_str(), O_RDONLY);
+  if (fd < 0) return;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    mapsize_ = st.st_size;
+    void* map = mmap(nullptr, mapsize_, PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+      close(fd);
+      throw runtime_error("Failed to map " + filename_);
+    }
+    map_ = static_cast<const char*>(map);
+  }
+  close(fd);
+}
+
+
+ArrayReader::~ArrayReader() {
+  if (map_)
+    munmap(const_cast<char*>(map_), mapsize_);
+}
+
+
+void ArrayReader::read(const ArrayEntry& entry, char* data, const size_t lo, const size_t hi) const {
+  for (size_t i = 0; i != entry.start.size(); ++i) {
+    const size_t clo = entry.start[i];
+    const size_t chi = clo + entry.raw_length(i);
+    if (chi <= lo || clo >= hi) continue;
+    if (entry.offset[i] + entry.length[i] > mapsize_)
+      throw runtime_error("The file " + filename_ + " is truncated.");
+
+    const char* source = map_ + entry.offset[i];
+    const size_t olo = max(lo, clo);
+    const size_t ohi = min(hi, chi);
+    if (entry.length[i] == chi - clo) {
+      copy_n(source + olo - clo, ohi - olo, data + olo - lo);
+    } else {
+#ifdef HAVE_LIBZ
+      // inflate straight into the destination unless only part of the chunk is requested
+      const bool whole = olo == clo && ohi == chi;
+      vector<Bytef> tmp(whole ? 0 : chi - clo);
+      Bytef* target = whole ? reinterpret_cast<Bytef*>(data + clo - lo) : tmp.data();
+      uLongf len = chi - clo;
+      if (uncompress(target, &len, reinterpret_cast<const Bytef*>(source), entry.length[i]) != Z_OK || len != chi - clo)
+        throw runtime_error("Corrupted compressed data in " + filename_);
+      if (!whole)
+        copy_n(tmp.data() + olo - clo, ohi - olo, data + olo - lo);
+#else
+      throw runtime_error("The file " + filename_ + " contains compressed data, but BAGEL was compiled without zlib.");
+#endif
+    }
+  }
+}
@@ -0,0 +1,194 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: arraysection.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __SRC_UTIL_IO_ARRAYSECTION_H
+#define __SRC_UTIL_IO_ARRAYSECTION_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <complex>
+#include <type_traits>
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/wrapper.hpp>
+#include <boost/serialization/split_member.hpp>
+
+namespace bagel {
+
+// Location of one array in the ".arrays" file that accompanies an archive.
+// The array is stored in chunks; a chunk whose stored length equals its raw length is not compressed.
+struct ArrayEntry {
+  uint64_t size;
+  std::vector<uint64_t> start;   // byte offset of each chunk within the array
+  std::vector<uint64_t> offset;  // byte offset of each chunk within the file
+  std::vector<uint64_t> length;  // stored length of each chunk
+
+  uint64_t raw_length(const size_t i) const { return (i+1 == start.size() ? size : start[i+1]) - start[i]; }
+
+  template<class Archive>
+  void serialize(Archive& ar, const unsigned int) { ar & size & start & offset & length; }
+};
+
+
+// Writes large arrays to "name.arrays". Construction, destruction and write are collective:
+// every process writes its own slice of each array to the shared file.
+class ArrayWriter {
+  friend class ArrayScope;
+  protected:
+    std::string filename_;
+    int fd_;
+    uint64_t end_;
+    bool compress_;
+    size_t chunksize_;
+
+    static ArrayWriter* current_;
+
+  public:
+    // arrays smaller than this (in bytes) stay in the archive itself
+    static const size_t threshold = 1lu << 16;
+
+    ArrayWriter(const std::string& filename, const bool compress, const size_t chunksize = 1lu << 22);
+    ~ArrayWriter();
+
+    ArrayWriter(const ArrayWriter&) = delete;
+    ArrayWriter& operator=(const ArrayWriter&) = delete;
+
+    // data points to bytes [lo, hi) of an array of n bytes. Slices from all processes have to cover the array without overlap.
+    ArrayEntry write(const char* data, const size_t n, const size_t lo, const size_t hi);
+    // the array is replicated; each process writes an equal share
+    ArrayEntry write(const char* data, const size_t n);
+
+    static ArrayWriter* current() { return current_; }
+};
+
+
+// Memory-maps "name.arrays" and copies (or inflates) the requested sections straight into their destination.
+class ArrayReader {
+  friend class ArrayScope;
+  protected:
+    std::string filename_;
+    const char* map_;
+    size_t mapsize_;
+
+    static ArrayReader* current_;
+
+  public:
+    ArrayReader(const std::string& filename);
+    ~ArrayReader();
+
+    ArrayReader(const ArrayReader&) = delete;
+    ArrayReader& operator=(const ArrayReader&) = delete;
+
+    // copies bytes [lo, hi) of the array to data
+    void read(const ArrayEntry& entry, char* data, const size_t lo, const size_t hi) const;
+    void read(const ArrayEntry& entry, char* data) const { read(entry, data, 0, entry.size); }
+
+    static ArrayReader* current() { return current_; }
+};
+
+
+// Makes a writer and/or reader the target of array sections while in scope (used by OArchive and IArchive).
+class ArrayScope {
+  protected:
+    ArrayWriter* writer_;
+    ArrayReader* reader_;
+  public:
+    ArrayScope(ArrayWriter* w, ArrayReader* r) : writer_(ArrayWriter::current_), reader_(ArrayReader::current_) {
+      ArrayWriter::current_ = w;
+      ArrayReader::current_ = r;
+    }
+    ~ArrayScope() {
+      ArrayWriter::current_ = writer_;
+      ArrayReader::current_ = reader_;
+    }
+};
+
+
+namespace array_section {
+  // inline fallback; complex numbers are stored as pairs of reals as in bagel::make_array
+  template <typename T>
+  auto inline_array(T* data, const size_t n) -> decltype(boost::serialization::make_array(data, n)) {
+    return boost::serialization::make_array(data, n);
+  }
+  template <typename T>
+  auto inline_array(std::complex<T>* data, const size_t n) -> decltype(boost::serialization::make_array(reinterpret_cast<T*>(data), 2*n)) {
+    return boost::serialization::make_array(reinterpret_cast<T*>(data), 2*n);
+  }
+  template <typename T>
+  auto inline_array(const std::complex<T>* data, const size_t n) -> decltype(boost::serialization::make_array(reinterpret_cast<const T*>(data), 2*n)) {
+    return boost::serialization::make_array(reinterpret_cast<const T*>(data), 2*n);
+  }
+}
+
+
+// Serialization wrapper for a replicated array. Large arrays go to the ".arrays" file when an ArrayWriter
+// is active; otherwise (and for small arrays) this is equivalent to boost::serialization::make_array.
+template<typename T>
+class ArraySection : public boost::serialization::wrapper_traits<const ArraySection<T>> {
+  protected:
+    T* data_;
+    size_t n_;
+
+  private:
+    friend class boost::serialization::access;
+    template<class Archive>
+    void save(Archive& ar, const unsigned int) const {
+      ArrayWriter* writer = ArrayWriter::current();
+      const bool external = std::is_trivially_copyable<T>::value && writer && n_*sizeof(T) >= ArrayWriter::threshold;
+      ar << external;
+      if (external) {
+        const ArrayEntry entry = writer->write(reinterpret_cast<const char*>(data_), n_*sizeof(T));
+        ar << entry;
+      } else {
+        ar << array_section::inline_array(data_, n_);
+      }
+    }
+    template<class Archive>
+    void load(Archive& ar, const unsigned int) {
+      bool external;
+      ar >> external;
+      if (external) {
+        ArrayEntry entry;
+        ar >> entry;
+        if (!ArrayReader::current() || entry.size != n_*sizeof(T))
+          throw std::runtime_error("Array data referenced by the archive cannot be found. The .arrays file may be missing or inconsistent.");
+        ArrayReader::current()->read(entry, reinterpret_cast<char*>(data_));
+      } else {
+        ar >> array_section::inline_array(data_, n_);
+      }
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+  public:
+    ArraySection(T* data, const size_t n) : data_(data), n_(n) { }
+};
+
+template<typename T>
+const ArraySection<T> make_section(T* data, const size_t n) { return ArraySection<T>(data, n); }
+
+}
+
+#endif
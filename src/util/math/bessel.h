@@ -29,6 +29,7 @@
 
 #include <iostream>
 #include <cmath>
+#include <limits>
 #include <vector>
 #include <src/util/math/factorial.h>
 
@@ -9,6 +9,8 @@
 #include <boost/serialization/split_free.hpp>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/collection_size_type.hpp>
+#include <boost/serialization/version.hpp>
+#include <src/util/io/arraysection.h>
 
 namespace bagel {
 
@@ -99,6 +101,8 @@ private:
    };
    _M_impl data_;
    size_type capacity_;
+   // false when the array is a view of memory owned by someone else (e.g., a node-shared window)
+   bool owner_ = true;
 
    allocator_type& alloc() { return static_cast<allocator_type&>(*this); }
    const allocator_type& alloc() const { return static_cast<const allocator_type&>(*this); }
@@ -119,6 +123,10 @@ public:
      deallocate();
    }
 
+   // wraps external memory without taking ownership; the memory has to outlive this object
+   varray (pointer p, size_type n) : allocator_type(), data_(p, p+n), capacity_(0), owner_(false)
+   { }
+
    explicit
    varray (size_type n, const allocator_type& a = allocator_type()) : allocator_type(a), capacity_(0)
    {
@@ -166,8 +174,9 @@ public:
    }
 
    varray (varray&& x)
-   : allocator_type(std::move(static_cast<allocator_type&&>(x))), data_(std::move(x.data_)), capacity_(x.capacity_)
+   : allocator_type(std::move(static_cast<allocator_type&&>(x))), data_(std::move(x.data_)), capacity_(x.capacity_), owner_(x.owner_)
    {
+     x.owner_ = true;
    }
 
    template <typename U, class = typename std::enable_if< std::is_convertible<U, value_type>::value >::type >
@@ -182,7 +191,8 @@ public:
 
    varray& operator= (const varray& x) {
      const auto n = x.size();
-     if (n != data_.size()) {
+     // assignment never writes into external memory
+     if (n != data_.size() || !owner_) {
        deallocate();
        if (n > 0)
          allocate(n);
@@ -204,7 +214,7 @@ public:
    varray& operator= (std::initializer_list<U> il)
    {
        const auto n = il.size();
-       if (n != data_.size()) {
+       if (n != data_.size() || !owner_) {
          deallocate();
          if (n > 0)
            allocate(n);
@@ -274,8 +284,8 @@ public:
 
    void resize (size_type n)
    {
-     if (size() != n) {
-       if (n > capacity_) {
+     if (size() != n || !owner_) {
+       if (n > capacity_ || !owner_) {
          if (!empty()) {
            deallocate();
          }
@@ -328,7 +338,11 @@ public:
    { return data_.data(); }
 
    void swap (varray& x)
-   { data_.swap(x.data_); }
+   {
+     data_.swap(x.data_);
+     std::swap(capacity_, x.capacity_);
+     std::swap(owner_, x.owner_);
+   }
 
    void clear ()
    {
@@ -347,10 +361,11 @@ public:
    }
 
    void deallocate() {
-     if (!data_.empty())
+     if (!data_.empty() && owner_)
        allocator_traits::deallocate(alloc(), data_._M_start, capacity_);
      data_._M_start = data_._M_finish = nullptr;
      capacity_ = 0;
+     owner_ = true;
    }
 
    void reinterpret(size_type n) {
@@ -421,7 +436,7 @@ namespace boost {
       const boost::serialization::collection_size_type count(x.size());
       ar << BOOST_SERIALIZATION_NVP(count);
       if (count != 0)
-        ar << boost::serialization::make_array(x.data(), count);
+        ar << bagel::make_section(x.data(), count);
   }
   template<class Archive, typename T>
   void load (Archive& ar, bagel::varray<T>& x, const unsigned int version)
@@ -429,10 +444,23 @@ namespace boost {
       boost::serialization::collection_size_type count;
       ar >> BOOST_SERIALIZATION_NVP(count);
       x.resize(count);
-      if (count != 0)
-        ar >> boost::serialization::make_array(x.data(), count);
+      // version 0 (archives written before the .arrays file was introduced) stores the data inline
+      if (count != 0) {
+        if (version == 0)
+          ar >> boost::serialization::make_array(x.data(), count);
+        else
+          ar >> bagel::make_section(x.data(), count);
+      }
   }
 
+  /// version 1: the data are written through bagel::make_section
+  template<typename T, typename A>
+  struct version<bagel::varray<T,A>> {
+    typedef mpl::int_<1> type;
+    typedef mpl::integral_c_tag tag;
+    BOOST_STATIC_CONSTANT(int, value = version::type::value);
+  };
+
   } // namespace serialization
 } // namespace boost
 
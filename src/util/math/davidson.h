@@ -25,6 +25,7 @@
 // T should have
 //  - double dot_product(const T&)
 //  - void ax_plus_y(double, const T&) // added to self
+// Basis pairs can be spilled to memory-mapped files (see set_spill) if T and U expose their local data through data() and size().
 
 #ifndef __BAGEL_UTIL_DAVIDSON
 #define __BAGEL_UTIL_DAVIDSON
@@ -32,6 +33,7 @@
 #include <vector>
 #include <src/util/math/algo.h>
 #include <src/util/math/matrix.h>
+#include <src/util/math/mappedvector.h>
 #include <src/util/f77.h>
 #include <src/util/serialization.h>
 
@@ -44,8 +46,12 @@ class DavidsonDiag_ {
       public:
         std::shared_ptr<const T> cc;
         std::shared_ptr<const U> sigma;
+        // cc and sigma are released when spilled to files
+        std::shared_ptr<const MappedVector<T>> cc_file;
+        std::shared_ptr<const MappedVector<U>> sigma_file;
         BasisPair() { }
         BasisPair(std::shared_ptr<const T> a, std::shared_ptr<const U> b) : cc(a), sigma(b) { }
+        bool spilled() const { return !cc; }
       private:
         // serialization
         friend class boost::serialization::access;
@@ -68,21 +74,71 @@ class DavidsonDiag_ {
     // overlap matrix
     std::shared_ptr<MatType> overlap_;
 
+    // number of basis pairs kept in memory (negative means all), precision and location of the spilled ones
+    int nresident_;
+    bool single_;
+    std::string scratch_;
+
+    // returns vectors of a basis pair, read from the files if spilled. The first pair is always in memory.
+    std::shared_ptr<const T> basis_cc(const BasisPair& b) const {
+      return b.cc ? b.cc : SpillVector<T>::read(b.cc_file, *basis_.front()->cc);
+    }
+    std::shared_ptr<const U> basis_sigma(const BasisPair& b) const {
+      return b.sigma ? b.sigma : SpillVector<U>::read(b.sigma_file, *basis_.front()->sigma);
+    }
+
+    // keeps the current best guesses and the most recent pairs in memory and spills the others
+    void spill() {
+      if (nresident_ < 0 || !SpillVector<T>::value || !SpillVector<U>::value) return;
+      const int nkeep = std::max(nresident_, nstate_);
+      for (int i = nstate_; i < size_-(nkeep-nstate_); ++i) {
+        BasisPair& b = *basis_[i];
+        if (b.spilled()) continue;
+        b.cc_file = SpillVector<T>::write(*b.cc, scratch_, single_);
+        b.sigma_file = SpillVector<U>::write(*b.sigma, scratch_, single_);
+        b.cc.reset();
+        b.sigma.reset();
+      }
+    }
+
   private:
     // serialization
     friend class boost::serialization::access;
     template<class Archive>
-    void serialize(Archive& ar, const unsigned int) {
-      ar & nstate_ & max_ & size_ & basis_ & mat_ & vec_ & eig_ & overlap_;
+    void save(Archive& ar, const unsigned int) const {
+      // spilled pairs are stored as ordinary vectors
+      std::vector<std::shared_ptr<BasisPair>> basis;
+      for (auto& b : basis_)
+        basis.push_back(b->spilled() ? std::make_shared<BasisPair>(basis_cc(*b), basis_sigma(*b)) : b);
+      ar << nstate_ << max_ << size_ << basis << mat_ << vec_ << eig_ << overlap_;
+    }
+    template<class Archive>
+    void load(Archive& ar, const unsigned int) {
+      ar >> nstate_ >> max_ >> size_ >> basis_ >> mat_ >> vec_ >> eig_ >> overlap_;
+    }
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned int version) {
+      boost::serialization::split_member(ar, *this, version);
     }
 
   public:
     // Davidson with periodic collapse of the subspace
-    DavidsonDiag_() { }
-    DavidsonDiag_(int n, int max) : nstate_(n), max_((max+1)*n), size_(0), vec_(max_) {
+    DavidsonDiag_() : nresident_(-1), single_(false) { }
+    DavidsonDiag_(int n, int max) : nstate_(n), max_((max+1)*n), size_(0), vec_(max_), nresident_(-1), single_(false) {
       if (max < 2) throw std::runtime_error("Davidson diagonalization requires at least two trial vectors per root.");
     }
 
+    // Keeps at most nresident basis pairs in memory (negative for all). Older pairs are written to memory-mapped
+    // files in directory, in single precision if requested. This is a no-op if T or U cannot be spilled.
+    // Single-precision pairs limit the attainable residual norm (float epsilon is 1.2e-7), hence the check against thresh.
+    void set_spill(const int nresident, const bool single, const std::string directory, const double thresh) {
+      if (nresident >= 0 && single && thresh < 1.0e-6)
+        throw std::runtime_error("Davidson vectors spilled in single precision cannot be converged below 1.0e-6. Increase the threshold or turn off davidson_single.");
+      nresident_ = nresident;
+      single_ = single;
+      scratch_ = directory;
+    }
+
     double compute(std::shared_ptr<const T> cc, std::shared_ptr<const U> cs) {
       assert(nstate_ == 1);
       return compute(std::vector<std::shared_ptr<const T>>{cc},
@@ -111,18 +167,19 @@ class DavidsonDiag_ {
         overlap_ = overlap_ ? overlap_->resize(size_+n, size_+n) : std::make_shared<MatType>(n, n);
       }
 
+      // each (possibly spilled) trial vector is read once and contracted with all the new pairs
+      const int nold = size_;
       basis_.insert(basis_.end(), newbasis.begin(), newbasis.end());
-      for (auto& ib : newbasis) {
-        ++size_;
-        int i = 0;
-        for (auto& b : basis_) {
-          if (i > size_-1) break;
-          mat_->element(i, size_-1) = b->cc->dot_product(ib->sigma);
-          mat_->element(size_-1, i) = detail::conj(mat_->element(i, size_-1));
-
-          overlap_->element(i, size_-1) = b->cc->dot_product(ib->cc);
-          overlap_->element(size_-1, i) = detail::conj(overlap_->element(i, size_-1));
-          ++i;
+      size_ = basis_.size();
+      for (int i = 0; i != size_; ++i) {
+        std::shared_ptr<const T> bcc = basis_cc(*basis_[i]);
+        for (int j = std::max(i, nold); j < size_; ++j) {
+          BasisPair& ib = *basis_[j];
+          mat_->element(i, j) = bcc->dot_product(ib.sigma);
+          mat_->element(j, i) = detail::conj(mat_->element(i, j));
+
+          overlap_->element(i, j) = bcc->dot_product(ib.cc);
+          overlap_->element(j, i) = detail::conj(overlap_->element(i, j));
         }
       }
 
@@ -135,9 +192,9 @@ class DavidsonDiag_ {
         throw std::runtime_error("Too much linear dependency in guess vectors provided to DavidsonDiag; cannot obtain the requested number of states.");
 
       // diagonalize matrix to get
+      // only the lowest nstate_ eigenpairs of the subspace matrix are needed
       eig_ = std::make_shared<MatType>(*ovlp_scr % *mat_ * *ovlp_scr);
-      eig_->diagonalize(vec_);
-      eig_ = std::make_shared<MatType>(*ovlp_scr * eig_->slice(0,nstate_));
+      eig_ = std::make_shared<MatType>(*ovlp_scr * *eig_->diagonalize_lowest(vec_, nstate_));
       eig_->synchronize();
 
       // first basis vector is always the current best guess
@@ -196,25 +253,33 @@ class DavidsonDiag_ {
       mat_->synchronize();
       overlap_->synchronize();
 
+      spill();
+
       return std::vector<double>(vec_.begin(), vec_.begin()+nstate_);
     }
 
     // perhaps can be cleaner.
+    // The loops run over the basis first so that each spilled vector is read only once.
     std::vector<std::shared_ptr<U>> residual() {
       std::vector<std::shared_ptr<U>> out;
-      for (int i = 0; i != nstate_; ++i) {
-        auto tmp = basis_.front()->sigma->clone();
-        int k = 0;
-        for (auto& iv : basis_) {
-          if (std::abs(eig_->element(k++,i)) > 1.0e-16)
-            tmp->ax_plus_y(-vec_(i)*eig_->element(k-1,i), iv->cc);
-        }
-        k = 0;
-        for (auto& iv : basis_) {
-          if (std::abs(eig_->element(k++,i)) > 1.0e-16)
-            tmp->ax_plus_y(eig_->element(k-1,i), iv->sigma);
-        }
-        out.push_back(tmp);
+      for (int i = 0; i != nstate_; ++i)
+        out.push_back(basis_.front()->sigma->clone());
+
+      int k = 0;
+      for (auto& iv : basis_) {
+        std::shared_ptr<const T> ivcc = basis_cc(*iv);
+        for (int i = 0; i != nstate_; ++i)
+          if (std::abs(eig_->element(k,i)) > 1.0e-16)
+            out[i]->ax_plus_y(-vec_(i)*eig_->element(k,i), ivcc);
+        ++k;
+      }
+      k = 0;
+      for (auto& iv : basis_) {
+        std::shared_ptr<const U> ivsigma = basis_sigma(*iv);
+        for (int i = 0; i != nstate_; ++i)
+          if (std::abs(eig_->element(k,i)) > 1.0e-16)
+            out[i]->ax_plus_y(eig_->element(k,i), ivsigma);
+        ++k;
       }
       return out;
     }
@@ -222,30 +287,36 @@ class DavidsonDiag_ {
     // returns ci vector
     std::vector<std::shared_ptr<T>> civec() {
       std::vector<std::shared_ptr<T>> out;
-      for (int i = 0; i != nstate_; ++i) {
-        auto tmp = basis_.front()->cc->clone();
-        int k = 0;
-        for (auto& iv : basis_) {
-          tmp->ax_plus_y(eig_->element(k++,i), iv->cc);
-        }
-        tmp->synchronize();
-        out.push_back(tmp);
+      for (int i = 0; i != nstate_; ++i)
+        out.push_back(basis_.front()->cc->clone());
+
+      int k = 0;
+      for (auto& iv : basis_) {
+        std::shared_ptr<const T> ivcc = basis_cc(*iv);
+        for (int i = 0; i != nstate_; ++i)
+          out[i]->ax_plus_y(eig_->element(k,i), ivcc);
+        ++k;
       }
+      for (auto& i : out)
+        i->synchronize();
       return out;
     }
 
     // return sigma vector
     std::vector<std::shared_ptr<U>> sigmavec() {
       std::vector<std::shared_ptr<U>> out;
-      for (int i = 0; i != nstate_; ++i) {
-        auto tmp = basis_.front()->sigma->clone();
-        int k = 0;
-        for (auto& iv : basis_) {
-          tmp->ax_plus_y(eig_->element(k++,i), iv->sigma);
-        }
-        tmp->synchronize();
-        out.push_back(tmp);
+      for (int i = 0; i != nstate_; ++i)
+        out.push_back(basis_.front()->sigma->clone());
+
+      int k = 0;
+      for (auto& iv : basis_) {
+        std::shared_ptr<const U> ivsigma = basis_sigma(*iv);
+        for (int i = 0; i != nstate_; ++i)
+          out[i]->ax_plus_y(eig_->element(k,i), ivsigma);
+        ++k;
       }
+      for (auto& i : out)
+        i->synchronize();
       return out;
     }
 
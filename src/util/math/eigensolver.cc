@@ -0,0 +1,203 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: eigensolver.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <src/util/f77.h>
+#include <src/util/string.h>
+#include <src/util/math/eigensolver.h>
+
+using namespace std;
+using namespace bagel;
+
+namespace {
+  EigenSolver default_solver = EigenSolver::QR;
+
+  EigenSolver resolve(const EigenSolver solver, const int n) {
+    if (solver != EigenSolver::Auto)
+      return solver;
+    return n <= eigensolver_auto_threshold__ ? EigenSolver::QR : EigenSolver::DivideConquer;
+  }
+}
+
+
+EigenSolver bagel::eigensolver_default() {
+  return default_solver;
+}
+
+
+void bagel::set_eigensolver_default(const EigenSolver solver) {
+  default_solver = solver;
+}
+
+
+EigenSolver bagel::parse_eigensolver(string name) {
+  name = to_lower(name);
+  if (name == "auto")
+    return EigenSolver::Auto;
+  else if (name == "qr" || name == "syev" || name.empty())
+    return EigenSolver::QR;
+  else if (name == "dc" || name == "syevd" || name == "divide_conquer")
+    return EigenSolver::DivideConquer;
+  else if (name == "mrrr" || name == "syevr")
+    return EigenSolver::MRRR;
+  throw runtime_error("unknown eigensolver " + name);
+}
+
+
+void bagel::syev(EigenSolver solver, const int n, double* a, const int lda, double* eig) {
+  if (n == 0) return;
+  int info = 0;
+  switch (resolve(solver, n)) {
+    case EigenSolver::QR: {
+      const int lwork = max(n*6, 1);
+      unique_ptr<double[]> work(new double[lwork]);
+      dsyev_("V", "L", n, a, lda, eig, work.get(), lwork, info);
+      break;
+    }
+    case EigenSolver::DivideConquer: {
+      double wsize;
+      int iwsize;
+      dsyevd_("V", "L", n, a, lda, eig, &wsize, -1, &iwsize, -1, info);
+      const int lwork = static_cast<int>(wsize);
+      unique_ptr<double[]> work(new double[lwork]);
+      unique_ptr<int[]> iwork(new int[iwsize]);
+      dsyevd_("V", "L", n, a, lda, eig, work.get(), lwork, iwork.get(), iwsize, info);
+      break;
+    }
+    case EigenSolver::MRRR: {
+      unique_ptr<double[]> z(new double[static_cast<size_t>(n)*n]);
+      syev_range(n, a, lda, eig, z.get(), n, 0, n);
+      for (int j = 0; j != n; ++j)
+        copy_n(z.get()+static_cast<size_t>(j)*n, n, a+static_cast<size_t>(j)*lda);
+      return;
+    }
+    default:
+      assert(false);
+  }
+  if (info) throw runtime_error("dsyev/dsyevd failed in syev");
+}
+
+
+void bagel::syev(EigenSolver solver, const int n, complex<double>* a, const int lda, double* eig) {
+  if (n == 0) return;
+  int info = 0;
+  switch (resolve(solver, n)) {
+    case EigenSolver::QR: {
+      const int lwork = max(n*6, 1);
+      unique_ptr<complex<double>[]> work(new complex<double>[lwork]);
+      unique_ptr<double[]> rwork(new double[max(3*n-2, 1)]);
+      zheev_("V", "L", n, a, lda, eig, work.get(), lwork, rwork.get(), info);
+      break;
+    }
+    case EigenSolver::DivideConquer: {
+      complex<double> wsize;
+      double rwsize;
+      int iwsize;
+      zheevd_("V", "L", n, a, lda, eig, &wsize, -1, &rwsize, -1, &iwsize, -1, info);
+      const int lwork = static_cast<int>(wsize.real());
+      const int lrwork = static_cast<int>(rwsize);
+      unique_ptr<complex<double>[]> work(new complex<double>[lwork]);
+      unique_ptr<double[]> rwork(new double[lrwork]);
+      unique_ptr<int[]> iwork(new int[iwsize]);
+      zheevd_("V", "L", n, a, lda, eig, work.get(), lwork, rwork.get(), lrwork, iwork.get(), iwsize, info);
+      break;
+    }
+    case EigenSolver::MRRR: {
+      unique_ptr<complex<double>[]> z(new complex<double>[static_cast<size_t>(n)*n]);
+      syev_range(n, a, lda, eig, z.get(), n, 0, n);
+      for (int j = 0; j != n; ++j)
+        copy_n(z.get()+static_cast<size_t>(j)*n, n, a+static_cast<size_t>(j)*lda);
+      return;
+    }
+    default:
+      assert(false);
+  }
+  if (info) throw runtime_error("zheev/zheevd failed in syev");
+}
+
+
+void bagel::syev_range(const int n, double* a, const int lda, double* eig, double* z, const int ldz, const int istart, const int iend) {
+  if (istart < 0 || iend > n || istart >= iend) throw logic_error("illegal range in syev_range");
+  int info = 0;
+  int m;
+  // isuppz has 2*max(1,m) elements
+  vector<int> isuppz(2*n);
+  double wsize;
+  int iwsize;
+  dsyevr_("V", "I", "L", n, a, lda, 0.0, 0.0, istart+1, iend, 0.0, m, eig, z, ldz, isuppz.data(), &wsize, -1, &iwsize, -1, info);
+  const int lwork = static_cast<int>(wsize);
+  unique_ptr<double[]> work(new double[lwork]);
+  unique_ptr<int[]> iwork(new int[iwsize]);
+  dsyevr_("V", "I", "L", n, a, lda, 0.0, 0.0, istart+1, iend, 0.0, m, eig, z, ldz, isuppz.data(), work.get(), lwork, iwork.get(), iwsize, info);
+  if (info || m != iend-istart) throw runtime_error("dsyevr failed in syev_range");
+}
+
+
+void bagel::syev_range(const int n, complex<double>* a, const int lda, double* eig, complex<double>* z, const int ldz, const int istart, const int iend) {
+  if (istart < 0 || iend > n || istart >= iend) throw logic_error("illegal range in syev_range");
+  int info = 0;
+  int m;
+  vector<int> isuppz(2*n);
+  complex<double> wsize;
+  double rwsize;
+  int iwsize;
+  zheevr_("V", "I", "L", n, a, lda, 0.0, 0.0, istart+1, iend, 0.0, m, eig, z, ldz, isuppz.data(), &wsize, -1, &rwsize, -1, &iwsize, -1, info);
+  const int lwork = static_cast<int>(wsize.real());
+  const int lrwork = static_cast<int>(rwsize);
+  unique_ptr<complex<double>[]> work(new complex<double>[lwork]);
+  unique_ptr<double[]> rwork(new double[lrwork]);
+  unique_ptr<int[]> iwork(new int[iwsize]);
+  zheevr_("V", "I", "L", n, a, lda, 0.0, 0.0, istart+1, iend, 0.0, m, eig, z, ldz, isuppz.data(), work.get(), lwork, rwork.get(), lrwork, iwork.get(), iwsize, info);
+  if (info || m != iend-istart) throw runtime_error("zheevr failed in syev_range");
+}
+
+
+namespace {
+  template<typename DataType>
+  void syev_range_solver(const EigenSolver solver, const int n, DataType* a, const int lda, double* eig, DataType* z, const int ldz, const int istart, const int iend) {
+    if (resolve(solver, n) == EigenSolver::MRRR) {
+      syev_range(n, a, lda, eig, z, ldz, istart, iend);
+      return;
+    }
+    if (istart < 0 || iend > n || istart >= iend) throw logic_error("illegal range in syev_range");
+    syev(solver, n, a, lda, eig);
+    for (int j = istart; j != iend; ++j)
+      copy_n(a+static_cast<size_t>(j)*lda, n, z+static_cast<size_t>(j-istart)*ldz);
+    copy_n(eig+istart, iend-istart, eig);
+  }
+}
+
+
+void bagel::syev_range(EigenSolver solver, const int n, double* a, const int lda, double* eig, double* z, const int ldz, const int istart, const int iend) {
+  syev_range_solver(solver, n, a, lda, eig, z, ldz, istart, iend);
+}
+
+
+void bagel::syev_range(EigenSolver solver, const int n, complex<double>* a, const int lda, double* eig, complex<double>* z, const int ldz, const int istart, const int iend) {
+  syev_range_solver(solver, n, a, lda, eig, z, ldz, istart, iend);
+}
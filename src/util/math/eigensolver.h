@@ -0,0 +1,62 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: eigensolver.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __SRC_MATH_EIGENSOLVER_H
+#define __SRC_MATH_EIGENSOLVER_H
+
+#include <string>
+#include <complex>
+
+namespace bagel {
+
+// LAPACK drivers for dense symmetric (Hermitian) eigenproblems that are solved in a single process.
+//   QR            : dsyev/zheev (the original driver)
+//   DivideConquer : dsyevd/zheevd; the back transformation is dominated by level-3 BLAS and is threaded
+//   MRRR          : dsyevr/zheevr; O(n^2) per eigenvector and the only one that can compute part of the spectrum
+//   Auto          : QR for small matrices, DivideConquer above eigensolver_auto_threshold__
+enum class EigenSolver { Auto, QR, DivideConquer, MRRR };
+
+static constexpr int eigensolver_auto_threshold__ = 200;
+
+// the process-wide default; initialized from BAGEL_EIGENSOLVER ("qr", "dc", "mrrr" or "auto") in static_variables().
+// QR unless set, so that results do not depend on the size of the matrix
+EigenSolver eigensolver_default();
+void set_eigensolver_default(const EigenSolver solver);
+EigenSolver parse_eigensolver(std::string name);
+
+// full spectrum in ascending order; a (lda >= n) is overwritten by the eigenvectors
+void syev(EigenSolver solver, const int n, double* a, const int lda, double* eig);
+void syev(EigenSolver solver, const int n, std::complex<double>* a, const int lda, double* eig);
+
+// eigenpairs istart, ..., iend-1 (0-based, ascending) by MRRR. a is destroyed. eig should have n elements (LAPACK uses them);
+// the selected eigenvalues are returned in the first iend-istart elements and the eigenvectors in z (n x (iend-istart))
+void syev_range(const int n, double* a, const int lda, double* eig, double* z, const int ldz, const int istart, const int iend);
+void syev_range(const int n, std::complex<double>* a, const int lda, double* eig, std::complex<double>* z, const int ldz, const int istart, const int iend);
+// the same with the given solver; only MRRR computes part of the spectrum, the other drivers compute all of it and it is sliced
+void syev_range(EigenSolver solver, const int n, double* a, const int lda, double* eig, double* z, const int ldz, const int istart, const int iend);
+void syev_range(EigenSolver solver, const int n, std::complex<double>* a, const int lda, double* eig, std::complex<double>* z, const int ldz, const int istart, const int iend);
+
+}
+
+#endif
@@ -51,7 +51,7 @@ void JacobiDiag::subsweep(vector<pair<int,int>>& pairlist) {
 
 void JacobiDiag::rotate(const int k, const int l) {
   const double kl = A_->element(k,l);
-  if (fabs(k) < numerical_zero__) return;
+  if (fabs(kl) < numerical_zero__) return;
 
   const double kk = A_->element(k,k);
   const double ll = A_->element(l,l);
@@ -60,7 +60,10 @@ void JacobiDiag::rotate(const int k, const int l) {
   const double t = copysign(1.0,beta)/(fabs(beta) + sqrt(beta*beta + 1.0));
   const double c = 1.0/(sqrt(t*t + 1.0));
   const double s = c*t;
-  const double rho = (1.0 - c)/s;
+
+  // A <- J^T A J, applied to the columns and then to the rows of k and l; the 2x2 block is set afterwards
+  drot_(nbasis_, A_->element_ptr(0,k), 1, A_->element_ptr(0,l), 1, c, -s);
+  drot_(nbasis_, A_->element_ptr(k,0), A_->ndim(), A_->element_ptr(l,0), A_->ndim(), c, -s);
 
   A_->element(k,k) = kk - t * kl;
   A_->element(l,l) = ll + t * kl;
@@ -68,27 +71,6 @@ void JacobiDiag::rotate(const int k, const int l) {
   A_->element(k,l) = 0.0;
   A_->element(l,k) = 0.0;
 
-  // I'm afraid of overwriting data, thus copying some stuff
-  unique_ptr<double[]> k_column(new double[nbasis_]);
-  double* k_column_data = k_column.get();
-  copy_n(A_->element_ptr(0,k), nbasis_, k_column_data);
-  unique_ptr<double[]> l_column(new double[nbasis_]);
-  double* l_column_data = l_column.get();
-  copy_n(A_->element_ptr(0,l), nbasis_, l_column_data);
-
-  for(int i = 0; i < nbasis_; ++i) {
-    if (i == k || i == l) continue;
-
-    const double ik = k_column_data[i];
-    const double il = l_column_data[i];
-
-    double new_ik = ik - s * (il + rho * ik);
-    double new_il = il + s * (ik - rho * il);
-
-    A_->element(i,k) = new_ik; A_->element(k,i) = new_ik;
-    A_->element(i,l) = new_il; A_->element(l,i) = new_il;
-  }
-
   Q_->rotate(k, l, acos(c));
 }
 
@@ -101,42 +83,38 @@ void JacobiPM::subsweep(vector<pair<int,int>>& pairlist) {
   tie(pstart, pend) = dist.range(mpi__->rank());
   const size_t psize = pend - pstart;
 
-  auto right = make_shared<Matrix>(nbasis_, 2*psize, true);
-  for (size_t ip = 0; ip < psize; ++ip) {
-    copy_n(SQ_->element_ptr(0, pairlist[ip + pstart].first), nbasis_, right->element_ptr(0, 2*ip));
-    copy_n(SQ_->element_ptr(0, pairlist[ip + pstart].second), nbasis_, right->element_ptr(0, 2*ip+1));
-  }
-
-  shared_ptr<Matrix> left = ( lowdin_ ? right : make_shared<Matrix>(nbasis_, 2*psize, true) );
-  if (!lowdin_) {
-    for (size_t ip = 0; ip < psize; ++ip) {
-      copy_n(Q_->element_ptr(0, pairlist[ip + pstart].first), nbasis_, left->element_ptr(0, 2*ip));
-      copy_n(Q_->element_ptr(0, pairlist[ip + pstart].second), nbasis_, left->element_ptr(0, 2*ip+1));
-    }
-  }
-
-  Matrix P_A(2*psize, 2*psize, true);
-
   vector<double> AA(npairs, 0.0);
   vector<double> BB(npairs, 0.0);
 
-  for (auto& ibounds : atom_bounds_) {
-    const int natombasis = ibounds.second - ibounds.first;
-    const int boundstart = ibounds.first;
-
-    for (int ip = 0; ip < psize; ++ip) {
-      dgemm_("T", "N", 2, 2, natombasis, 1.0, left->element_ptr(boundstart, 2*ip), left->ndim(),
-          right->element_ptr(boundstart, 2*ip), right->ndim(), 0.0, P_A.element_ptr(2*ip,2*ip), P_A.ndim());
-
-      const int kk = 2*ip;
-      const int ll = 2*ip+1;
-
-      const double Qkl_A = 0.5 * (P_A(kk,ll) + P_A(ll,kk));
-      const double Qkminusl_A = P_A(kk,kk) - P_A(ll,ll);
-
-      AA[ip + pstart] += Qkl_A*Qkl_A - 0.25*Qkminusl_A*Qkminusl_A;
-      BB[ip + pstart] += Qkl_A*Qkminusl_A;
+  // the pairs in a subsweep are disjoint, and are evaluated concurrently within a node
+  shared_ptr<const Matrix> left = lowdin_ ? SQ_ : Q_;
+  auto evaluate = [this, &pairlist, &left, &AA, &BB](const int ipair) {
+    const int kk = pairlist[ipair].first;
+    const int ll = pairlist[ipair].second;
+    for (auto& ibounds : atom_bounds_) {
+      const int natombasis = ibounds.second - ibounds.first;
+      const int boundstart = ibounds.first;
+      const double* lk = left->element_ptr(boundstart, kk);
+      const double* lr = left->element_ptr(boundstart, ll);
+      const double* rk = SQ_->element_ptr(boundstart, kk);
+      const double* rl = SQ_->element_ptr(boundstart, ll);
+
+      const double Qkl_A = lowdin_ ? ddot_(natombasis, lk, 1, rl, 1) : 0.5 * (ddot_(natombasis, lk, 1, rl, 1) + ddot_(natombasis, lr, 1, rk, 1));
+      const double Qkminusl_A = ddot_(natombasis, lk, 1, rk, 1) - ddot_(natombasis, lr, 1, rl, 1);
+
+      AA[ipair] += Qkl_A*Qkl_A - 0.25*Qkminusl_A*Qkminusl_A;
+      BB[ipair] += Qkl_A*Qkminusl_A;
     }
+  };
+
+  if (psize > 6*resources__->max_num_threads()) {
+    TaskQueue<function<void(void)>> tq(psize);
+    for (int ipair = pstart; ipair < pend; ++ipair)
+      tq.emplace_back([&evaluate, ipair] { evaluate(ipair); });
+    tq.compute();
+  } else {
+    for (int ipair = pstart; ipair < pend; ++ipair)
+      evaluate(ipair);
   }
 
   mpi__->allreduce(AA.data(), AA.size());
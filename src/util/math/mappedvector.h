@@ -0,0 +1,141 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: mappedvector.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __SRC_MATH_MAPPEDVECTOR_H
+#define __SRC_MATH_MAPPEDVECTOR_H
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cassert>
+#include <cstdlib>
+#include <complex>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+
+namespace bagel {
+
+// T is spillable if it exposes its (local) data as a contiguous array through data() and size()
+template<typename T>
+struct is_spillable {
+  protected:
+    template<class V> static auto __data(V* p) -> decltype(*p->data() = *p->data(), p->size(), std::true_type());
+    template<class  > static std::false_type __data(...);
+  public:
+    static constexpr const bool value = std::is_same<std::true_type, decltype(__data<T>(0))>::value;
+};
+
+
+// Holds the local data of a vector in a memory-mapped scratch file, optionally in single precision.
+// The file is unlinked upon creation so that it disappears with the process.
+template<typename T>
+class MappedVector {
+  public:
+    using DataType = typename std::remove_cv<typename std::remove_pointer<decltype(std::declval<T>().data())>::type>::type;
+    using SingleType = typename std::conditional<std::is_same<DataType, double>::value, float, std::complex<float>>::type;
+
+  protected:
+    size_t size_;
+    bool single_;
+    int fd_;
+    size_t bytes_;
+    void* map_;
+
+  public:
+    MappedVector(const T& v, const std::string& directory, const bool single) : size_(v.size()), single_(single) {
+      std::string name = directory + "/bagel_vector_XXXXXX";
+      fd_ = mkstemp(&name[0]);
+      if (fd_ < 0)
+        throw std::runtime_error("MappedVector could not create a scratch file in " + directory);
+      unlink(name.c_str());
+
+      bytes_ = std::max<size_t>(1, size_ * (single_ ? sizeof(SingleType) : sizeof(DataType)));
+      if (ftruncate(fd_, bytes_) != 0)
+        throw std::runtime_error("MappedVector could not allocate " + std::to_string(bytes_) + " bytes in " + directory);
+      map_ = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+      if (map_ == MAP_FAILED)
+        throw std::runtime_error("MappedVector failed in mmap");
+
+      if (single_)
+        std::transform(v.data(), v.data()+size_, static_cast<SingleType*>(map_), [](const DataType& a) { return static_cast<SingleType>(a); });
+      else
+        std::copy_n(v.data(), size_, static_cast<DataType*>(map_));
+      // pages are written back in the background and can be evicted under memory pressure
+      msync(map_, bytes_, MS_ASYNC);
+    }
+
+    MappedVector(const MappedVector<T>&) = delete;
+    MappedVector<T>& operator=(const MappedVector<T>&) = delete;
+
+    ~MappedVector() {
+      munmap(map_, bytes_);
+      close(fd_);
+    }
+
+    size_t size() const { return size_; }
+    bool single() const { return single_; }
+
+    // returns a vector with the stored data. shape is used to construct an object of the right dimension.
+    template<typename S>
+    std::shared_ptr<T> load(const S& shape) const {
+      std::shared_ptr<T> out = shape.clone();
+      assert(out->size() == size_);
+      if (single_)
+        std::transform(static_cast<const SingleType*>(map_), static_cast<const SingleType*>(map_)+size_, out->data(), [](const SingleType& a) { return static_cast<DataType>(a); });
+      else
+        std::copy_n(static_cast<const DataType*>(map_), size_, out->data());
+      return out;
+    }
+};
+
+
+// dispatches spilling depending on whether T can be spilled
+template<typename T, bool = is_spillable<T>::value>
+struct SpillVector {
+  static constexpr const bool value = false;
+  static std::shared_ptr<const MappedVector<T>> write(const T&, const std::string&, const bool) {
+    throw std::logic_error("SpillVector::write called for a type that cannot be spilled");
+  }
+  static std::shared_ptr<const T> read(std::shared_ptr<const MappedVector<T>>, const T&) {
+    throw std::logic_error("SpillVector::read called for a type that cannot be spilled");
+  }
+};
+
+template<typename T>
+struct SpillVector<T, true> {
+  static constexpr const bool value = true;
+  static std::shared_ptr<const MappedVector<T>> write(const T& v, const std::string& directory, const bool single) {
+    return std::make_shared<const MappedVector<T>>(v, directory, single);
+  }
+  static std::shared_ptr<const T> read(std::shared_ptr<const MappedVector<T>> f, const T& shape) {
+    return f->load(shape);
+  }
+};
+
+}
+
+#endif
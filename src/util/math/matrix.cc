@@ -30,6 +30,7 @@
 #include <src/util/f77.h>
 #include <src/util/math/algo.h>
 #include <src/util/math/matrix.h>
+#include <src/util/math/eigensolver.h>
 #include <src/util/math/matop.h>
 #include <cassert>
 #include <cmath>
@@ -47,6 +48,10 @@ Matrix::Matrix(const int n, const int m , const bool loc) : Matrix_base<double>(
 }
 
 
+Matrix::Matrix(const int n, const int m, double* external, const bool loc) : Matrix_base<double>(n,m,external,loc), std::enable_shared_from_this<Matrix>() {
+}
+
+
 Matrix::Matrix(const Matrix& o) : Matrix_base<double>(o), std::enable_shared_from_this<Matrix>() {
 }
 
@@ -108,8 +113,8 @@ void Matrix::diagonalize(VecView eig) {
 #ifdef HAVE_SCALAPACK
   if (localized_ || n <= blocksize__) {
 #endif
-    unique_ptr<double[]> work(new double[n*6]);
-    dsyev_("V", "L", n, data(), n, eig.data(), work.get(), n*6, info);
+    info = 0;
+    syev(eigensolver_default(), n, data(), n, eig.data());
     mpi__->broadcast(data(), n*n, 0);
     mpi__->broadcast(eig.data(), n, 0);
 #ifdef HAVE_SCALAPACK
@@ -138,6 +143,20 @@ void Matrix::diagonalize(VecView eig) {
 }
 
 
+shared_ptr<Matrix> Matrix::diagonalize_range(VecView eig, const int istart, const int iend) const {
+  assert(ndim() == mdim());
+  assert(eig.size() >= ndim());
+  const int n = ndim();
+  auto out = make_shared<Matrix>(n, iend-istart, localized_);
+  // the matrix is replicated; solved on every process and synchronized as in diagonalize
+  Matrix tmp(*this);
+  syev_range(eigensolver_default(), n, tmp.data(), n, eig.data(), out->data(), n, istart, iend);
+  mpi__->broadcast(out->data(), out->size(), 0);
+  mpi__->broadcast(eig.data(), iend-istart, 0);
+  return out;
+}
+
+
 tuple<shared_ptr<Matrix>, shared_ptr<Matrix>> Matrix::svd(double* sing) {
   auto U = make_shared<Matrix>(ndim(), ndim());
   auto V = make_shared<Matrix>(mdim(), mdim());
@@ -61,6 +61,9 @@ class Matrix : public Matrix_base<double>, public std::enable_shared_from_this<M
     Matrix(Matrix&&);
     Matrix() { }
     virtual ~Matrix() { }
+  protected:
+    Matrix(const int n, const int m, double* external, const bool localized);
+  public:
 
     std::shared_ptr<Matrix> cut(const int nstart, const int nend) const { return get_submatrix(nstart, 0, nend-nstart, mdim()); }
     std::shared_ptr<Matrix> slice_copy(const int mstart, const int mend) const { return get_submatrix(0, mstart, ndim(), mend-mstart); }
@@ -72,6 +75,9 @@ class Matrix : public Matrix_base<double>, public std::enable_shared_from_this<M
 
     // diagonalize this matrix (overwritten by a coefficient matrix)
     void diagonalize(VecView vec) override;
+    // eigenpairs istart, ..., iend-1 in ascending order (this is not modified) by the default eigensolver; returns the eigenvectors as columns
+    std::shared_ptr<Matrix> diagonalize_range(VecView vec, const int istart, const int iend) const;
+    std::shared_ptr<Matrix> diagonalize_lowest(VecView vec, const int nroot) const { return diagonalize_range(vec, 0, nroot); }
     std::shared_ptr<Matrix> diagonalize_blocks(VectorB& eig, std::vector<int> blocks) { return diagonalize_blocks_impl<Matrix>(eig, blocks); }
     std::tuple<std::shared_ptr<Matrix>, std::shared_ptr<Matrix>> svd(double* sing = nullptr);
     // compute S^-1. Assumes positive definite matrix
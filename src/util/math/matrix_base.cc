@@ -40,6 +40,18 @@ Matrix_base<DataType>::Matrix_base(const size_t n, const size_t m, const bool lo
 }
 
 
+template<typename DataType>
+Matrix_base<DataType>::Matrix_base(const size_t n, const size_t m, DataType* external, const bool local)
+ : btas::Tensor2<DataType>(typename btas::Tensor2<DataType>::range_type(n, m), varray<DataType>(external, n*m)), localized_(local) {
+#ifdef HAVE_SCALAPACK
+  if (!localized_) {
+    desc_ = mpi__->descinit(ndim(), mdim());
+    localsize_ = mpi__->numroc(ndim(), mdim());
+  }
+#endif
+}
+
+
 template<typename DataType>
 Matrix_base<DataType>::Matrix_base(const Matrix_base& o) : btas::Tensor2<DataType>(o.ndim(), o.mdim()), localized_(o.localized_) {
 #ifdef HAVE_SCALAPACK
@@ -93,6 +93,10 @@ class Matrix_base : public btas::Tensor2<DataType> {
     Matrix_base(const MatView_<DataType>& o);
     Matrix_base(Matrix_base&& o);
     Matrix_base() : localized_(true) { }
+  protected:
+    // a matrix whose elements live in external memory (not owned; see SharedMatrix)
+    Matrix_base(const size_t n, const size_t m, DataType* external, const bool local);
+  public:
 
     virtual ~Matrix_base() { }
 
@@ -0,0 +1,167 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: permute.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef __SRC_UTIL_MATH_PERMUTE_H
+#define __SRC_UTIL_MATH_PERMUTE_H
+
+#include <array>
+#include <algorithm>
+#include <cstddef>
+
+namespace bagel {
+namespace blas {
+
+namespace detail {
+
+constexpr static int permute_tile = 16;
+
+// out[y] (y contiguous) <- in[x] (x contiguous) for an nx x ny tile pair with strides sy (in) and sx (out)
+template<bool accumulate, typename T>
+inline void permute_transpose(const T* in, T* out, const size_t nx, const size_t ny, const size_t sy, const size_t sx, const T afac, const T fac) {
+  for (size_t y0 = 0; y0 < ny; y0 += permute_tile) {
+    const size_t yend = std::min(ny, y0 + permute_tile);
+    for (size_t x0 = 0; x0 < nx; x0 += permute_tile) {
+      const size_t xend = std::min(nx, x0 + permute_tile);
+#ifdef __GNUC__
+      // the rows of the next tile
+      if (xend < nx)
+        for (size_t y = y0; y < yend; ++y)
+          __builtin_prefetch(in + xend + y*sy);
+#endif
+      for (size_t x = x0; x < xend; ++x) {
+        const T* source = in + x;
+        T* target = out + x*sx;
+        if (accumulate) {
+          for (size_t y = y0; y < yend; ++y)
+            target[y] = afac*target[y] + fac*source[y*sy];
+        } else {
+          for (size_t y = y0; y < yend; ++y)
+            target[y] = fac*source[y*sy];
+        }
+      }
+    }
+  }
+}
+
+template<bool accumulate, typename T>
+inline void permute_copy(const T* in, T* out, const size_t n, const T afac, const T fac) {
+  if (accumulate) {
+    for (size_t x = 0; x < n; ++x)
+      out[x] = afac*out[x] + fac*in[x];
+  } else {
+    for (size_t x = 0; x < n; ++x)
+      out[x] = fac*in[x];
+  }
+}
+
+}
+
+
+// Index permutation of a dense tensor with the conventions of sort_indices in src/util/prim_op.h:
+// dim[q] is the extent of the q-th index of in (q = 0 runs fastest), and the p-th index of out is the o[p]-th index of in.
+// out = afac*out + fac*in if accumulate, out = fac*in otherwise.
+// Indices that stay adjacent are fused; the remaining work is a set of contiguous copies when the fastest index is unchanged,
+// or of tiled transposes between the fastest indices of in and out.
+template<int N, bool accumulate, typename T>
+void permute(const T* in, T* out, const std::array<int,N>& o, const std::array<int,N>& dim, const T afac, const T fac) {
+  static_assert(N > 0, "permute requires at least one index");
+
+  // strides of each input index in in and out
+  std::array<size_t,N> istride, ostride;
+  {
+    size_t s = 1;
+    for (int q = 0; q != N; ++q) {
+      istride[q] = s;
+      s *= dim[q];
+    }
+    s = 1;
+    for (int p = 0; p != N; ++p) {
+      ostride[o[p]] = s;
+      s *= dim[o[p]];
+    }
+    if (s == 0)
+      return;
+  }
+
+  // fuse indices that are adjacent in both, and drop those of extent one
+  std::array<size_t,N> fdim, fis, fos;
+  int n = 0;
+  for (int q = 0; q != N; ++q) {
+    if (dim[q] == 1) continue;
+    if (n > 0 && fis[n-1]*fdim[n-1] == istride[q] && fos[n-1]*fdim[n-1] == ostride[q]) {
+      fdim[n-1] *= dim[q];
+    } else {
+      fdim[n] = dim[q];
+      fis[n] = istride[q];
+      fos[n] = ostride[q];
+      ++n;
+    }
+  }
+  if (n == 0) {
+    detail::permute_copy<accumulate>(in, out, 1, afac, fac);
+    return;
+  }
+
+  // the fastest index of in is fused index 0; that of out is the one with unit stride
+  const int b = std::find(fos.begin(), fos.begin()+n, 1) - fos.begin();
+  const bool contiguous = b == 0;
+
+  // the other indices are run with an odometer
+  std::array<size_t,N> rdim, ris, ros, cnt;
+  int nr = 0;
+  for (int q = 1; q != n; ++q) {
+    if (q == b) continue;
+    rdim[nr] = fdim[q];
+    ris[nr] = fis[q];
+    ros[nr] = fos[q];
+    cnt[nr] = 0;
+    ++nr;
+  }
+
+  size_t ioff = 0, ooff = 0;
+  while (true) {
+    if (contiguous)
+      detail::permute_copy<accumulate>(in + ioff, out + ooff, fdim[0], afac, fac);
+    else
+      detail::permute_transpose<accumulate>(in + ioff, out + ooff, fdim[0], fdim[b], fis[b], fos[0], afac, fac);
+
+    int r = 0;
+    for (; r != nr; ++r) {
+      ioff += ris[r];
+      ooff += ros[r];
+      if (++cnt[r] != rdim[r]) break;
+      ioff -= ris[r]*rdim[r];
+      ooff -= ros[r]*rdim[r];
+      cnt[r] = 0;
+    }
+    if (r == nr) break;
+  }
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,231 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: sort_bench.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+// Microbenchmark of sort_indices against the element-wise loop it used to be implemented with.
+// Build with "make sort_bench" in this directory.
+
+#include <chrono>
+#include <complex>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+#include <src/util/prim_op.h>
+
+using namespace std;
+using namespace bagel;
+
+namespace {
+
+// the previous implementation of the generic templates
+template<int i, int j, int an, int fn, class T>
+void reference(const T* unsorted, T* sorted, const int b, const int a) {
+  const T afac = an;
+  const T factor = fn;
+  int id[2];
+  int jd[2] = {b, a};
+  long iall=0;
+  for(int j0=0;j0<a;++j0){
+    id[1]=j0;
+    for(int j1=0;j1<b;++j1,++iall){
+      id[0]=j1;
+      long ib=id[i]+jd[i]*id[j];
+      if (an != 0)
+        sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
+      else
+        sorted[ib]=unsorted[iall]*factor;
+    }
+  }
+}
+
+template<int i, int j, int k, int an, int fn, class T>
+void reference(const T* unsorted, T* sorted, const int d, const int c, const int b) {
+  const T afac = an;
+  const T factor = fn;
+  int id[3];
+  int jd[3] = {d, c, b};
+  long iall=0;
+  for(int j1=0;j1<b;++j1){
+    id[2]=j1;
+    for(int j2=0;j2<c;++j2){
+      id[1]=j2;
+      for (int j3=0;j3<d;++j3,++iall){
+        id[0]=j3;
+        long ib=id[i]+jd[i]*(id[j]+jd[j]*id[k]);
+        if (an != 0)
+          sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
+        else
+          sorted[ib]=unsorted[iall]*factor;
+      }
+    }
+  }
+}
+
+template<int i, int j, int k, int l, int an, int fn, class T>
+void reference(const T* unsorted, T* sorted, const int d, const int c, const int b, const int a) {
+  const T afac = an;
+  const T factor = fn;
+  int id[4];
+  int jd[4] = {d, c, b, a};
+  long iall=0;
+  for(int j0=0;j0<a;++j0){
+    id[3]=j0;
+    for(int j1=0;j1<b;++j1){
+      id[2]=j1;
+      for(int j2=0;j2<c;++j2){
+        id[1]=j2;
+        for(int j3=0;j3<d;++j3,++iall){
+          id[0]=j3;
+          long ib=id[i]+jd[i]*(id[j]+jd[j]*(id[k]+jd[k]*id[l]));
+          if (an != 0)
+            sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
+          else
+            sorted[ib]=unsorted[iall]*factor;
+        }
+      }
+    }
+  }
+}
+
+template<int i, int j, int k, int l, int m, int n, int an, int fn, class T>
+void reference(const T* unsorted, T* sorted, const int f, const int e, const int d, const int c, const int b, const int a) {
+  const T afac = an;
+  const T factor = fn;
+  int id[6];
+  int jd[6] = {f, e, d, c, b, a};
+  long iall=0;
+  for(int j0=0;j0<a;++j0){
+    id[5]=j0;
+    for(int j1=0;j1<b;++j1){
+      id[4]=j1;
+      for(int j2=0;j2<c;++j2){
+        id[3]=j2;
+        for(int j3=0;j3<d;++j3){
+          id[2]=j3;
+          for(int j4=0;j4<e;++j4){
+            id[1]=j4;
+            for(int j5=0;j5<f;++j5,++iall){
+              id[0]=j5;
+              long ib=id[i]+jd[i]*(id[j]+jd[j]*(id[k]+jd[k]*(id[l]+jd[l]*(id[m]+jd[m]*id[n]))));
+              if (an != 0)
+                sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
+              else
+                sorted[ib]=unsorted[iall]*factor;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+template<typename Func>
+double timing(Func f, const int nrepeat) {
+  auto start = chrono::high_resolution_clock::now();
+  for (int i = 0; i != nrepeat; ++i)
+    f();
+  return chrono::duration<double>(chrono::high_resolution_clock::now() - start).count() / nrepeat;
+}
+
+template<typename T, int an, int fn, int... perm>
+struct Bench {
+  static void run(const vector<int>& dim, const int nrepeat) {
+    static_assert(sizeof...(perm) >= 2 && sizeof...(perm) <= 6, "Bench supports 2 to 6 indices");
+    const vector<int> o{perm...};
+    long size = 1;
+    for (auto& i : dim) size *= i;
+
+    mt19937 gen(11);
+    uniform_real_distribution<double> dist(-1.0, 1.0);
+    vector<T> in(size), out0(size), out1(size);
+    for (auto& i : in) i = dist(gen);
+    for (long i = 0; i != size; ++i) out0[i] = out1[i] = dist(gen);
+
+    const double tref = timing([&]() { call(in.data(), out0.data(), dim, true); }, nrepeat);
+    const double tnew = timing([&]() { call(in.data(), out1.data(), dim, false); }, nrepeat);
+
+    double err = 0.0;
+    for (long i = 0; i != size; ++i)
+      err = max(err, abs(out0[i] - out1[i]));
+    if (err > 1.0e-10)
+      throw logic_error("sort_bench: sort_indices disagrees with the reference");
+
+    cout << "  <";
+    for (auto& i : o) cout << i << (&i != &o.back() ? "," : "");
+    cout << "> " << (an ? "acc " : "set ") << (sizeof(T) == sizeof(double) ? "real " : "cplx ") << setw(10) << size
+         << setw(12) << setprecision(3) << fixed << tref*1.0e3 << " ms" << setw(12) << tnew*1.0e3 << " ms"
+         << setw(8) << setprecision(2) << tref/tnew << "x" << endl;
+  }
+
+  static void call(const T* in, T* out, const vector<int>& d, const bool ref) {
+    sort(in, out, d, ref, integral_constant<int, sizeof...(perm)>());
+  }
+  static void sort(const T* in, T* out, const vector<int>& d, const bool ref, integral_constant<int,2>) {
+    if (ref) reference<perm..., an,fn>(in, out, d[0], d[1]);
+    else     sort_indices<perm..., an,1,fn,1>(in, out, d[0], d[1]);
+  }
+  static void sort(const T* in, T* out, const vector<int>& d, const bool ref, integral_constant<int,3>) {
+    if (ref) reference<perm..., an,fn>(in, out, d[0], d[1], d[2]);
+    else     sort_indices<perm..., an,1,fn,1>(in, out, d[0], d[1], d[2]);
+  }
+  static void sort(const T* in, T* out, const vector<int>& d, const bool ref, integral_constant<int,4>) {
+    if (ref) reference<perm..., an,fn>(in, out, d[0], d[1], d[2], d[3]);
+    else     sort_indices<perm..., an,1,fn,1>(in, out, d[0], d[1], d[2], d[3]);
+  }
+  static void sort(const T* in, T* out, const vector<int>& d, const bool ref, integral_constant<int,6>) {
+    if (ref) reference<perm..., an,fn>(in, out, d[0], d[1], d[2], d[3], d[4], d[5]);
+    else     sort_indices<perm..., an,1,fn,1>(in, out, d[0], d[1], d[2], d[3], d[4], d[5]);
+  }
+};
+
+}
+
+
+int main() {
+  using complex = std::complex<double>;
+  const int nrepeat = 5;
+  cout << "  permutation                  size   reference    sort_indices" << endl;
+
+  Bench<double,0,2, 1,0>::run({2000, 1500}, nrepeat);
+  Bench<double,1,2, 1,0>::run({2000, 1500}, nrepeat);
+  Bench<complex,0,2, 1,0>::run({1000, 1000}, nrepeat);
+
+  Bench<double,0,1, 2,1,0>::run({120, 110, 100}, nrepeat);
+  Bench<double,1,1, 1,2,0>::run({120, 110, 100}, nrepeat);
+  Bench<complex,0,1, 2,0,1>::run({80, 70, 60}, nrepeat);
+
+  Bench<double,0,1, 1,0,3,2>::run({40, 36, 32, 30}, nrepeat);
+  Bench<double,0,1, 2,3,0,1>::run({40, 36, 32, 30}, nrepeat);
+  Bench<double,1,2, 3,2,1,0>::run({40, 36, 32, 30}, nrepeat);
+  Bench<complex,0,1, 0,2,1,3>::run({30, 28, 26, 24}, nrepeat);
+
+  Bench<double,0,1, 1,0,3,2,5,4>::run({12, 11, 10, 9, 8, 7}, nrepeat);
+  Bench<double,0,1, 5,4,3,2,1,0>::run({12, 11, 10, 9, 8, 7}, nrepeat);
+  Bench<double,1,1, 0,3,4,1,2,5>::run({12, 11, 10, 9, 8, 7}, nrepeat);
+  Bench<complex,0,1, 3,4,5,0,1,2>::run({9, 8, 8, 7, 7, 6}, nrepeat);
+
+  return 0;
+}
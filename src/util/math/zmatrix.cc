@@ -29,6 +29,7 @@
 #include <src/util/taskqueue.h>
 #include <src/util/constants.h>
 #include <src/util/math/zmatrix.h>
+#include <src/util/math/eigensolver.h>
 #include <src/util/math/matop.h>
 
 using namespace std;
@@ -116,9 +117,8 @@ void ZMatrix::diagonalize(VecView eig) {
 #ifdef HAVE_SCALAPACK
   if (localized_  || n <= blocksize__) {
 #endif
-    unique_ptr<complex<double>[]> work(new complex<double>[n*6]);
-    unique_ptr<double[]> rwork(new double[3*ndim()]);
-    zheev_("V", "L", n, data(), n, eig.data(), work.get(), n*6, rwork.get(), info);
+    info = 0;
+    syev(eigensolver_default(), n, data(), n, eig.data());
     mpi__->broadcast(data(), n*n, 0);
 #ifdef HAVE_SCALAPACK
   } else {
@@ -149,6 +149,19 @@ void ZMatrix::diagonalize(VecView eig) {
 }
 
 
+shared_ptr<ZMatrix> ZMatrix::diagonalize_range(VecView eig, const int istart, const int iend) const {
+  if (ndim() != mdim()) throw logic_error("illegal call of ZMatrix::diagonalize_range");
+  assert(eig.size() >= ndim());
+  const int n = ndim();
+  auto out = make_shared<ZMatrix>(n, iend-istart, localized_);
+  ZMatrix tmp(*this);
+  syev_range(eigensolver_default(), n, tmp.data(), n, eig.data(), out->data(), n, istart, iend);
+  mpi__->broadcast(out->data(), out->size(), 0);
+  mpi__->broadcast(eig.data(), iend-istart, 0);
+  return out;
+}
+
+
 tuple<shared_ptr<ZMatrix>, shared_ptr<ZMatrix>> ZMatrix::svd(double* sing) {
   auto U = make_shared<ZMatrix>(ndim(), ndim());
   auto V = make_shared<ZMatrix>(mdim(), mdim());
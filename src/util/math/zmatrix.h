@@ -71,6 +71,9 @@ class ZMatrix : public Matrix_base<std::complex<double>>, public std::enable_sha
 
     // diagonalize this matrix (overwritten by a coefficient matrix)
     virtual void diagonalize(VecView vec);
+    // eigenpairs istart, ..., iend-1 in ascending order (this is not modified) by the default eigensolver; returns the eigenvectors as columns
+    std::shared_ptr<ZMatrix> diagonalize_range(VecView vec, const int istart, const int iend) const;
+    std::shared_ptr<ZMatrix> diagonalize_lowest(VecView vec, const int nroot) const { return diagonalize_range(vec, 0, nroot); }
 
     std::shared_ptr<ZMatrix> diagonalize_blocks(VectorB& eig, std::vector<int> blocks) { return diagonalize_blocks_impl<ZMatrix>(eig, blocks); }
 
@@ -32,12 +32,13 @@
 #include <src/util/constants.h>
 #include <src/util/parallel/scalapack.h>
 #include <src/util/parallel/mpi_interface.h>
+#include <src/util/parallel/profiler.h>
 
 using namespace std;
 using namespace bagel;
 
 MPI_Interface::MPI_Interface()
- : cnt_(0), nprow_(0), npcol_(0), context_(0), myprow_(0), mypcol_(0), mpimutex_() {
+ : cnt_(0), nprow_(0), npcol_(0), context_(0), myprow_(0), mypcol_(0), node_rank_(0), node_size_(1), nnode_(1), mpimutex_() {
 
 #ifdef HAVE_MPI_H
   int provided;
@@ -85,6 +86,13 @@ MPI_Interface::MPI_Interface()
 
   // set MPI_COMM_WORLD to mpi_comm_
   mpi_comm_ = MPI_COMM_WORLD;
+
+  // node-local communicators
+  node_comm_ = MPI_COMM_NULL;
+  leader_comm_ = MPI_COMM_NULL;
+  init_node_comm();
+  if (rank() == 0 && node_size_ > 1)
+    cout << "  * " << nnode_ << (nnode_ > 1 ? " nodes" : " node") << " detected; node-local reductions will be used" << endl << endl;
 #else
   world_rank_ = 0;
   world_size_ = 1;
@@ -96,6 +104,7 @@ MPI_Interface::MPI_Interface()
 
 MPI_Interface::~MPI_Interface() {
 #ifdef HAVE_MPI_H
+  free_node_comm();
 #ifndef HAVE_SCALAPACK
   MPI_Finalize();
 #else
@@ -106,8 +115,35 @@ MPI_Interface::~MPI_Interface() {
 }
 
 
+void MPI_Interface::init_node_comm() {
+#ifdef HAVE_MPI_H
+  MPI_Comm_split_type(mpi_comm_, MPI_COMM_TYPE_SHARED, rank_, MPI_INFO_NULL, &node_comm_);
+  MPI_Comm_rank(node_comm_, &node_rank_);
+  MPI_Comm_size(node_comm_, &node_size_);
+  // the process with the lowest rank on each node is the leader (hence rank 0 is always a leader)
+  MPI_Comm_split(mpi_comm_, node_rank_ == 0 ? 0 : MPI_UNDEFINED, rank_, &leader_comm_);
+  nnode_ = node_rank_ == 0 ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &nnode_, 1, MPI_INT, MPI_SUM, mpi_comm_);
+#endif
+}
+
+
+void MPI_Interface::free_node_comm() {
+#ifdef HAVE_MPI_H
+  if (node_comm_ != MPI_COMM_NULL)
+    MPI_Comm_free(&node_comm_);
+  if (leader_comm_ != MPI_COMM_NULL)
+    MPI_Comm_free(&leader_comm_);
+  node_rank_ = 0;
+  node_size_ = 1;
+  nnode_ = 1;
+#endif
+}
+
+
 void MPI_Interface::barrier() const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::barrier");
   MPI_Barrier(mpi_comm_);
 #endif
 }
@@ -115,6 +151,7 @@ void MPI_Interface::barrier() const {
 
 void MPI_Interface::allreduce(double* a, const size_t size) const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::allreduce");
   assert(size != 0);
   const int nbatch = (size-1)/bsize  + 1;
   for (int i = 0; i != nbatch; ++i)
@@ -123,8 +160,54 @@ void MPI_Interface::allreduce(double* a, const size_t size) const {
 }
 
 
+#ifdef HAVE_MPI_H
+namespace {
+template<typename DataType>
+void node_allreduce_impl(DataType* a, const size_t size, const size_t bsize, MPI_Datatype type, const int node_rank, const MPI_Comm& node_comm, const MPI_Comm& leader_comm) {
+  const int nbatch = (size-1)/bsize  + 1;
+  for (int i = 0; i != nbatch; ++i) {
+    void* buf = static_cast<void*>(a+i*bsize);
+    const int n = i+1 == nbatch ? size-i*bsize : bsize;
+    if (node_rank == 0) {
+      MPI_Reduce(MPI_IN_PLACE, buf, n, type, MPI_SUM, 0, node_comm);
+      MPI_Allreduce(MPI_IN_PLACE, buf, n, type, MPI_SUM, leader_comm);
+    } else {
+      MPI_Reduce(buf, nullptr, n, type, MPI_SUM, 0, node_comm);
+    }
+    MPI_Bcast(buf, n, type, 0, node_comm);
+  }
+}
+}
+#endif
+
+
+void MPI_Interface::node_allreduce(double* a, const size_t size) const {
+#ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::node_allreduce");
+  assert(size != 0);
+  if (node_size_ == 1)
+    allreduce(a, size);
+  else
+    node_allreduce_impl(a, size, bsize, MPI_DOUBLE, node_rank_, node_comm_, leader_comm_);
+#endif
+}
+
+
+void MPI_Interface::node_allreduce(complex<double>* a, const size_t size) const {
+#ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::node_allreduce");
+  assert(size != 0);
+  if (node_size_ == 1)
+    allreduce(a, size);
+  else
+    node_allreduce_impl(a, size, bsize, MPI_CXX_DOUBLE_COMPLEX, node_rank_, node_comm_, leader_comm_);
+#endif
+}
+
+
 void MPI_Interface::allreduce(int* a, const size_t size) const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::allreduce");
   assert(size != 0);
   const int nbatch = (size-1)/bsize  + 1;
   for (int i = 0; i != nbatch; ++i)
@@ -135,6 +218,7 @@ void MPI_Interface::allreduce(int* a, const size_t size) const {
 
 void MPI_Interface::allreduce(complex<double>* a, const size_t size) const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::allreduce");
   assert(size != 0);
   const int nbatch = (size-1)/bsize  + 1;
   for (int i = 0; i != nbatch; ++i)
@@ -145,6 +229,7 @@ void MPI_Interface::allreduce(complex<double>* a, const size_t size) const {
 
 void MPI_Interface::broadcast(size_t* a, const size_t size, const int root) const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::broadcast");
   static_assert(sizeof(size_t) == sizeof(unsigned long long), "size_t is assumed to be the same size as unsigned long long");
   assert(size != 0);
   const int nbatch = (size-1)/bsize  + 1;
@@ -156,6 +241,7 @@ void MPI_Interface::broadcast(size_t* a, const size_t size, const int root) cons
 
 void MPI_Interface::broadcast(double* a, const size_t size, const int root) const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::broadcast");
   assert(size != 0);
   const int nbatch = (size-1)/bsize  + 1;
   for (int i = 0; i != nbatch; ++i)
@@ -166,6 +252,7 @@ void MPI_Interface::broadcast(double* a, const size_t size, const int root) cons
 
 void MPI_Interface::broadcast(complex<double>* a, const size_t size, const int root) const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::broadcast");
   assert(size != 0);
   const int nbatch = (size-1)/bsize  + 1;
   for (int i = 0; i != nbatch; ++i)
@@ -176,6 +263,7 @@ void MPI_Interface::broadcast(complex<double>* a, const size_t size, const int r
 
 void MPI_Interface::allgather(const double* send, const size_t ssize, double* rec, const size_t rsize) const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::allgather");
   // I hate const_cast. Blame the MPI C binding
   MPI_Allgather(const_cast<void*>(static_cast<const void*>(send)), ssize, MPI_DOUBLE, static_cast<void*>(rec), rsize, MPI_DOUBLE, mpi_comm_);
 #else
@@ -187,6 +275,7 @@ void MPI_Interface::allgather(const double* send, const size_t ssize, double* re
 
 void MPI_Interface::allgather(const complex<double>* send, const size_t ssize, complex<double>* rec, const size_t rsize) const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::allgather");
   // I hate const_cast. Blame the MPI C binding
   MPI_Allgather(const_cast<void*>(static_cast<const void*>(send)), ssize, MPI_CXX_DOUBLE_COMPLEX, static_cast<void*>(rec), rsize, MPI_CXX_DOUBLE_COMPLEX, mpi_comm_);
 #else
@@ -198,6 +287,7 @@ void MPI_Interface::allgather(const complex<double>* send, const size_t ssize, c
 
 void MPI_Interface::allgather(const size_t* send, const size_t ssize, size_t* rec, const size_t rsize) const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::allgather");
   static_assert(sizeof(size_t) == sizeof(unsigned long long), "size_t is assumed to be the same size as unsigned long long");
   // I hate const_cast. Blame the MPI C binding
   MPI_Allgather(const_cast<void*>(static_cast<const void*>(send)), ssize, MPI_UNSIGNED_LONG_LONG, static_cast<void*>(rec), rsize, MPI_UNSIGNED_LONG_LONG, mpi_comm_);
@@ -210,6 +300,7 @@ void MPI_Interface::allgather(const size_t* send, const size_t ssize, size_t* re
 
 void MPI_Interface::allgather(const int* send, const size_t ssize, int* rec, const size_t rsize) const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::allgather");
   // I hate const_cast. Blame the MPI C binding
   MPI_Allgather(const_cast<void*>(static_cast<const void*>(send)), ssize, MPI_INT, static_cast<void*>(rec), rsize, MPI_INT, mpi_comm_);
 #else
@@ -346,6 +437,7 @@ int MPI_Interface::request_recv(size_t* rbuf, const size_t size, const int origi
 
 void MPI_Interface::wait(const int rq) {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("MPI::wait");
   lock_guard<mutex> lock(mpimutex_);
   auto i = request_.find(rq);
   assert(i != request_.end());
@@ -397,6 +489,8 @@ void MPI_Interface::split(const int n) {
   mpi_comm_ = new_comm;
   MPI_Comm_rank(mpi_comm_, &rank_);
   MPI_Comm_size(mpi_comm_, &size_);
+  free_node_comm();
+  init_node_comm();
 #ifdef HAVE_SCALAPACK
   blacs_gridexit_(context_);
   tie(nprow_, npcol_) = numgrid(size_);
@@ -417,6 +511,8 @@ void MPI_Interface::merge() {
   mpi_comm_ = MPI_COMM_WORLD;
   rank_ = world_rank_;
   size_ = world_size_;
+  free_node_comm();
+  init_node_comm();
 #ifdef HAVE_SCALAPACK
   blacs_gridexit_(context_);
   tie(nprow_, npcol_) = numgrid(size_);
@@ -49,6 +49,9 @@ class MPI_Interface {
     // request handles
 #ifdef HAVE_MPI_H
     MPI_Comm mpi_comm_;
+    // processes that share memory with this process, and the node leaders (MPI_COMM_NULL on non-leaders)
+    MPI_Comm node_comm_;
+    MPI_Comm leader_comm_;
     std::map<int, std::vector<MPI_Request>> request_;
 #endif
     int nprow_;
@@ -57,6 +60,13 @@ class MPI_Interface {
     int myprow_;
     int mypcol_;
 
+    // node-local layout of the current communicator
+    int node_rank_;
+    int node_size_;
+    int nnode_;
+    void init_node_comm();
+    void free_node_comm();
+
     // maximum size of the MPI buffer
     static constexpr size_t bsize = 100000000LU;
 
@@ -75,6 +85,9 @@ class MPI_Interface {
     int rank() const { return rank_; }
     int size() const { return size_; }
     bool last() const { return rank() == size()-1; }
+    int node_rank() const { return node_rank_; }
+    int node_size() const { return node_size_; }
+    int nnode() const { return nnode_; }
 
     // collective functions
     // barrier
@@ -83,6 +96,9 @@ class MPI_Interface {
     void allreduce(int*, const size_t size) const;
     void allreduce(double*, const size_t size) const;
     void allreduce(std::complex<double>*, const size_t size) const;
+    // hierarchical allreduce: reduced within a node first, so that only one process per node communicates across nodes
+    void node_allreduce(double*, const size_t size) const;
+    void node_allreduce(std::complex<double>*, const size_t size) const;
     // broadcast
     void broadcast(size_t*, const size_t size, const int root) const;
     void broadcast(double*, const size_t size, const int root) const;
@@ -113,6 +129,7 @@ class MPI_Interface {
 #ifdef HAVE_MPI_H
     // communicators. n is the number of processes per communicator.
     const MPI_Comm& mpi_comm() const { return mpi_comm_; }
+    const MPI_Comm& node_comm() const { return node_comm_; }
 #endif
     void split(const int n);
     void merge();
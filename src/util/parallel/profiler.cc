@@ -0,0 +1,331 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: profiler.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <set>
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <cassert>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <src/util/parallel/profiler.h>
+#include <src/util/parallel/mpi_interface.h>
+
+using namespace std;
+using namespace bagel;
+
+bool Profiler::enabled_ = false;
+string Profiler::prefix_;
+mutex Profiler::mutex_;
+vector<unique_ptr<Profiler::ThreadData>> Profiler::threads_;
+vector<Profiler::ThreadData*> Profiler::free_;
+
+namespace bagel {
+// returns the table of an exiting thread to the pool, so that short-lived threads do not accumulate tables
+struct ThreadHandle {
+  Profiler::ThreadData* data = nullptr;
+  ~ThreadHandle() {
+    if (data) {
+      lock_guard<mutex> lock(Profiler::mutex_);
+      data->stack.clear();
+      Profiler::free_.push_back(data);
+    }
+  }
+};
+static thread_local ThreadHandle handle__;
+}
+
+
+void Profiler::enable(const string& prefix) {
+  prefix_ = prefix;
+  enabled_ = !prefix.empty();
+}
+
+
+Profiler::ThreadData& Profiler::local() {
+  if (!handle__.data) {
+    lock_guard<mutex> lock(mutex_);
+    if (free_.empty()) {
+      threads_.emplace_back(new ThreadData());
+      handle__.data = threads_.back().get();
+    } else {
+      handle__.data = free_.back();
+      free_.pop_back();
+    }
+  }
+  return *handle__.data;
+}
+
+
+string Profiler::path(const string& parent, const char* name) {
+  string out(name);
+  replace_if(out.begin(), out.end(), [](const char c) { return c == ';' || c == '\n'; }, ',');
+  return parent.empty() ? out : parent + ";" + out;
+}
+
+
+string Profiler::current() {
+  if (!enabled_)
+    return string();
+  const ThreadData& data = local();
+  return data.stack.empty() ? string() : data.stack.back();
+}
+
+
+void Profiler::push(const char* name, const string& parent) {
+  ThreadData& data = local();
+  data.stack.push_back(path(parent, name));
+}
+
+
+void Profiler::pop(const double seconds) {
+  ThreadData& data = local();
+  assert(!data.stack.empty());
+  data.stat[data.stack.back()].add(seconds);
+  data.stack.pop_back();
+}
+
+
+void Profiler::add(const string& name, const double seconds) {
+  if (!enabled_)
+    return;
+  ThreadData& data = local();
+  Stat& stat = data.stat[path(data.stack.empty() ? string() : data.stack.back(), name.c_str())];
+  stat.segment = true;
+  stat.add(seconds);
+}
+
+
+namespace {
+
+// statistics of a region after reduction over threads and processes
+struct Summary {
+  bool segment = false;
+  size_t calls = 0;
+  double time = 0.0;
+  array<double,3> call{{0.0, 0.0, 0.0}};
+  array<double,3> thread{{0.0, 0.0, 0.0}};
+  array<double,3> process{{0.0, 0.0, 0.0}};
+};
+
+struct Node {
+  string name;
+  Summary summary;
+  map<string, unique_ptr<Node>> children;
+
+  Node(const string& n) : name(n) { }
+
+  vector<const Node*> sorted() const {
+    vector<const Node*> out;
+    for (auto& i : children)
+      out.push_back(i.second.get());
+    sort(out.begin(), out.end(), [](const Node* a, const Node* b) { return a->summary.time > b->summary.time; });
+    return out;
+  }
+};
+
+string escape(const string& in) {
+  string out;
+  for (auto& c : in) {
+    if (c == '"' || c == '\\')
+      out += string("\\") + c;
+    else if (static_cast<unsigned char>(c) >= 0x20)
+      out += c;
+  }
+  return out;
+}
+
+void write_json(ostream& os, const Node& node, const int indent) {
+  const string pad(indent, ' ');
+  auto triple = [](const array<double,3>& a) {
+    stringstream ss;
+    ss << scientific << setprecision(6) << "{\"min\": " << a[0] << ", \"avg\": " << a[1] << ", \"max\": " << a[2] << "}";
+    return ss.str();
+  };
+  const Summary& s = node.summary;
+  os << pad << "{\"name\": \"" << escape(node.name) << "\", \"calls\": " << s.calls << ", \"time\": "
+     << scientific << setprecision(6) << s.time << ", \"segment\": " << (s.segment ? "true" : "false")
+     << ", \"call\": " << triple(s.call) << ", \"thread\": " << triple(s.thread) << ", \"process\": " << triple(s.process)
+     << ", \"children\": [";
+  const vector<const Node*> children = node.sorted();
+  if (!children.empty()) {
+    os << endl;
+    for (auto i = children.begin(); i != children.end(); ++i) {
+      write_json(os, **i, indent+2);
+      os << (i+1 == children.end() ? "" : ",") << endl;
+    }
+    os << pad;
+  }
+  os << "]}";
+}
+
+// folded stacks in microseconds of self time; segments overlap with regions and are left out
+void write_folded(ostream& os, const Node& node, const string& stack) {
+  double self = node.summary.time;
+  for (auto& i : node.children)
+    if (!i.second->summary.segment) {
+      self -= i.second->summary.time;
+      write_folded(os, *i.second, stack + ";" + i.second->name);
+    }
+  const long long usec = llround(max(self, 0.0) * 1.0e6);
+  if (usec > 0)
+    os << stack << " " << usec << endl;
+}
+
+}
+
+
+void Profiler::report() {
+  if (!enabled_)
+    return;
+  // the reduction below goes through instrumented collectives
+  enabled_ = false;
+
+  // merge the tables of this process; the time of a region in a process is that of its slowest thread
+  enum { Present, Calls, Time, ThreadMin, ThreadSum, NThread, CallMin, CallMax, Segment, NValue };
+  map<string, array<double,NValue>> local;
+  {
+    lock_guard<mutex> lock(mutex_);
+    for (auto& t : threads_)
+      for (auto& i : t->stat) {
+        const Stat& s = i.second;
+        auto iter = local.find(i.first);
+        if (iter == local.end())
+          iter = local.emplace(i.first, array<double,NValue>{{1.0, 0.0, 0.0, s.total, 0.0, 0.0, s.min, 0.0, s.segment ? 1.0 : 0.0}}).first;
+        array<double,NValue>& v = iter->second;
+        v[Calls] += s.count;
+        v[Time] = max(v[Time], s.total);
+        v[ThreadMin] = min(v[ThreadMin], s.total);
+        v[ThreadSum] += s.total;
+        v[NThread] += 1.0;
+        v[CallMin] = min(v[CallMin], s.min);
+        v[CallMax] = max(v[CallMax], s.max);
+      }
+  }
+
+  // union of the region paths over processes, exchanged as characters
+  const int nproc = mpi__->size();
+  string names;
+  for (auto& i : local)
+    names += i.first + "\n";
+  const int length = names.size();
+  vector<int> lengths(nproc);
+  mpi__->allgather(&length, 1, lengths.data(), 1);
+  const int maxlength = max(1, *max_element(lengths.begin(), lengths.end()));
+  vector<int> sendc(maxlength, 0);
+  copy(names.begin(), names.end(), sendc.begin());
+  vector<int> recvc(maxlength*nproc);
+  mpi__->allgather(sendc.data(), maxlength, recvc.data(), maxlength);
+  set<string> paths;
+  for (int p = 0; p != nproc; ++p) {
+    string current;
+    for (int i = 0; i != lengths[p]; ++i) {
+      const char c = static_cast<char>(recvc[p*maxlength+i]);
+      if (c == '\n') {
+        paths.insert(current);
+        current.clear();
+      } else {
+        current += c;
+      }
+    }
+  }
+
+  const size_t n = paths.size() * NValue;
+  vector<double> sendv(max(n, size_t(1)), 0.0);
+  auto v = sendv.begin();
+  for (auto& p : paths) {
+    auto iter = local.find(p);
+    if (iter != local.end())
+      copy(iter->second.begin(), iter->second.end(), v);
+    v += NValue;
+  }
+  vector<double> recvv(sendv.size()*nproc);
+  mpi__->allgather(sendv.data(), sendv.size(), recvv.data(), sendv.size());
+
+  if (mpi__->rank() == 0) {
+    Node root("all");
+    int ip = 0;
+    for (auto& p : paths) {
+      // walk down the tree, creating the enclosing regions as needed
+      Node* node = &root;
+      size_t begin = 0;
+      while (begin <= p.size()) {
+        const size_t end = min(p.find(';', begin), p.size());
+        const string name = p.substr(begin, end-begin);
+        auto& child = node->children[name];
+        if (!child)
+          child = unique_ptr<Node>(new Node(name));
+        node = child.get();
+        begin = end+1;
+      }
+
+      Summary& s = node->summary;
+      double threadsum = 0.0, nthread = 0.0, nrank = 0.0;
+      for (int r = 0; r != nproc; ++r) {
+        const double* d = &recvv[r*sendv.size() + ip*NValue];
+        if (d[Present] == 0.0)
+          continue;
+        const bool first = nrank == 0.0;
+        s.segment = d[Segment] != 0.0;
+        s.calls += static_cast<size_t>(d[Calls]);
+        s.call[0] = first ? d[CallMin] : min(s.call[0], d[CallMin]);
+        s.call[2] = max(s.call[2], d[CallMax]);
+        s.thread[0] = first ? d[ThreadMin] : min(s.thread[0], d[ThreadMin]);
+        s.thread[2] = max(s.thread[2], d[Time]);
+        s.process[0] = first ? d[Time] : min(s.process[0], d[Time]);
+        s.process[2] = max(s.process[2], d[Time]);
+        s.time += d[Time];
+        threadsum += d[ThreadSum];
+        nthread += d[NThread];
+        nrank += 1.0;
+      }
+      s.time /= nrank;
+      s.call[1] = threadsum / s.calls;
+      s.thread[1] = threadsum / nthread;
+      s.process[1] = s.time;
+      ++ip;
+    }
+    ofstream json(prefix_ + ".json");
+    ofstream folded(prefix_ + ".folded");
+    if (!json.is_open() || !folded.is_open())
+      throw runtime_error("could not open the profile files with prefix " + prefix_);
+    json << "{\"processes\": " << nproc << "," << endl
+         << " \"note\": \"thread min/avg/max are over per-thread tables, which are reused by threads started after others exited;"
+         << " the imbalance between TaskQueue workers is in the call statistics of the worker regions\"," << endl
+         << " \"regions\": [" << endl;
+    const vector<const Node*> top = root.sorted();
+    for (auto i = top.begin(); i != top.end(); ++i) {
+      write_json(json, **i, 2);
+      json << (i+1 == top.end() ? "" : ",") << endl;
+    }
+    json << "]}" << endl;
+    for (auto& i : root.children)
+      if (!i.second->summary.segment)
+        write_folded(folded, *i.second, i.second->name);
+    cout << "  * profile written to " << prefix_ << ".json and " << prefix_ << ".folded" << endl;
+  }
+}
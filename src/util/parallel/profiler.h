@@ -0,0 +1,133 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: profiler.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __SRC_UTIL_PARALLEL_PROFILER_H
+#define __SRC_UTIL_PARALLEL_PROFILER_H
+
+#include <chrono>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace bagel {
+
+// Wall-time statistics of named, nested regions. Every thread records into its own table, so that nothing is locked
+// while timing; the tables are merged over threads and MPI processes at the end of a run by report(), which writes
+// <prefix>.json (the region tree with per-call, per-table and per-process min/avg/max) and <prefix>.folded (stacks
+// for flamegraph.pl). Profiling is off unless the environment variable BAGEL_PROFILE gives the prefix.
+// TaskQueue starts new threads for every call, and the table of an exited thread is reused by the next new thread.
+// The "thread" statistics therefore compare table slots, each of which may have served several threads. The load
+// imbalance between the workers of a TaskQueue is in the "call" statistics of its "worker" region.
+class Profiler {
+  public:
+    struct Stat {
+      size_t count = 0;
+      double total = 0.0;
+      double min = std::numeric_limits<double>::max();
+      double max = 0.0;
+      // intervals from Timer::tick_print; they may overlap with regions at the same level
+      bool segment = false;
+
+      void add(const double t) {
+        ++count;
+        total += t;
+        min = std::min(min, t);
+        max = std::max(max, t);
+      }
+    };
+
+  private:
+    // a region path is the names of the enclosing regions joined by ';'
+    struct ThreadData {
+      std::vector<std::string> stack;
+      std::map<std::string, Stat> stat;
+    };
+    friend struct ThreadHandle;
+
+    static bool enabled_;
+    static std::string prefix_;
+    static std::mutex mutex_;
+    static std::vector<std::unique_ptr<ThreadData>> threads_;
+    // tables of threads that have exited, reused by new threads
+    static std::vector<ThreadData*> free_;
+
+    static ThreadData& local();
+    static std::string path(const std::string& parent, const char* name);
+
+  public:
+    static bool enabled() { return enabled_; }
+    static void enable(const std::string& prefix);
+    static const std::string& prefix() { return prefix_; }
+
+    // path of the innermost region of the calling thread (empty at top level or when disabled)
+    static std::string current();
+
+    static void push(const char* name, const std::string& parent);
+    static void pop(const double seconds);
+    // records an interval that has already elapsed as a segment of the innermost region
+    static void add(const std::string& name, const double seconds);
+
+    // collective over mpi__; writes the files on rank 0 and disables the profiler
+    static void report();
+};
+
+
+// Times the enclosing scope as a region named "name". Threads started inside a region have no enclosing region of their
+// own; they pass the path of the spawning thread (Profiler::current()) as "parent" so that their time nests below it.
+class ProfileRegion {
+  protected:
+    const bool active_;
+    std::chrono::steady_clock::time_point start_;
+
+  public:
+    // the path of the enclosing region is only looked up when profiling is on
+    ProfileRegion(const char* name) : active_(Profiler::enabled()) {
+      if (active_) {
+        Profiler::push(name, Profiler::current());
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+    ProfileRegion(const char* name, const std::string& parent) : active_(Profiler::enabled()) {
+      if (active_) {
+        Profiler::push(name, parent);
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~ProfileRegion() {
+      if (active_)
+        Profiler::pop(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count());
+    }
+
+    ProfileRegion(const ProfileRegion&) = delete;
+    ProfileRegion& operator=(const ProfileRegion&) = delete;
+};
+
+}
+
+#endif
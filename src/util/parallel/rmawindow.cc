@@ -27,6 +27,7 @@
 #include <src/util/math/algo.h>
 #include <src/util/parallel/rmawindow.h>
 #include <src/util/parallel/mpi_interface.h>
+#include <src/util/parallel/profiler.h>
 
 using namespace std;
 using namespace bagel;
@@ -35,6 +36,7 @@ using namespace bagel;
 template<typename DataType>
 void RMATask<DataType>::wait() {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("RMATask::wait");
   MPI_Wait(&tag, MPI_STATUS_IGNORE);
 #endif
 }
@@ -127,6 +129,7 @@ RMAWindow<DataType>& RMAWindow<DataType>::operator=(const RMAWindow<DataType>& o
 template<typename DataType>
 void RMAWindow<DataType>::fence() const {
 #ifdef HAVE_MPI_H
+  ProfileRegion region("RMAWindow::fence");
   assert(initialized_);
   MPI_Win_flush_all(win_);
   mpi__->barrier();
@@ -202,6 +205,7 @@ template<typename DataType>
 void RMAWindow<DataType>::rma_get(DataType* data, const size_t rank, const size_t off, const size_t size) const {
   assert(initialized_);
 #ifdef HAVE_MPI_H
+  ProfileRegion region("RMAWindow::rma_get");
   auto type = is_same<double,DataType>::value ? MPI_DOUBLE : MPI_CXX_DOUBLE_COMPLEX;
   MPI_Request req;
   MPI_Rget(data, size, type, rank, off, size, type, win_, &req);
@@ -223,6 +227,7 @@ template<typename DataType>
 void RMAWindow<DataType>::rma_put(const DataType* dat, const size_t rank, const size_t off, const size_t size) {
   assert(initialized_);
 #ifdef HAVE_MPI_H
+  ProfileRegion region("RMAWindow::rma_put");
   auto type = is_same<double,DataType>::value ? MPI_DOUBLE : MPI_CXX_DOUBLE_COMPLEX;
   MPI_Request req;
   MPI_Rput(dat, size, type, rank, off, size, type, win_, &req);
@@ -244,6 +249,7 @@ template<typename DataType>
 void RMAWindow<DataType>::rma_add(const DataType* dat, const size_t rank, const size_t off, const size_t size) {
   assert(initialized_);
 #ifdef HAVE_MPI_H
+  ProfileRegion region("RMAWindow::rma_add");
   auto type = is_same<double,DataType>::value ? MPI_DOUBLE : MPI_CXX_DOUBLE_COMPLEX;
   MPI_Request req;
   MPI_Raccumulate(dat, size, type, rank, off, size, type, MPI_SUM, win_, &req);
@@ -85,6 +85,7 @@ class RMAWindow {
     DataType dot_product(std::shared_ptr<const RMAWindow<DataType>> o) const { return dot_product(*o); }
 
     const DataType* local_data() const { fence(); return win_base_; }
+    DataType* local_data() { fence(); return win_base_; }
 
     // Blocking
     std::unique_ptr<DataType[]> rma_get(const size_t key) const;
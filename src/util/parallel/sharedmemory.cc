@@ -0,0 +1,95 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: sharedmemory.cc
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <cassert>
+#include <src/util/parallel/sharedmemory.h>
+#include <src/util/parallel/mpi_interface.h>
+
+using namespace std;
+using namespace bagel;
+
+
+template<typename DataType>
+SharedMemory<DataType>::SharedMemory(const size_t size) : size_(size), node_rank_(0), node_size_(1) {
+#ifdef HAVE_MPI_H
+  MPI_Comm_dup(mpi__->node_comm(), &comm_);
+  MPI_Comm_rank(comm_, &node_rank_);
+  MPI_Comm_size(comm_, &node_size_);
+  // only the leader contributes memory; the others map the leader's segment
+  const MPI_Aint lsize = node_rank_ == 0 ? size*sizeof(DataType) : 0;
+  DataType* base;
+  MPI_Win_allocate_shared(lsize, sizeof(DataType), MPI_INFO_NULL, comm_, &base, &win_);
+  MPI_Aint qsize;
+  int disp;
+  MPI_Win_shared_query(win_, 0, &qsize, &disp, &data_);
+  assert(qsize == static_cast<MPI_Aint>(size*sizeof(DataType)));
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+#else
+  local_ = unique_ptr<DataType[]>(new DataType[size]);
+  data_ = local_.get();
+#endif
+}
+
+
+template<typename DataType>
+SharedMemory<DataType>::~SharedMemory() {
+#ifdef HAVE_MPI_H
+  MPI_Win_unlock_all(win_);
+  MPI_Win_free(&win_);
+  MPI_Comm_free(&comm_);
+#endif
+}
+
+
+template<typename DataType>
+bool SharedMemory<DataType>::current() const {
+#ifdef HAVE_MPI_H
+  int result;
+  MPI_Comm_compare(comm_, mpi__->node_comm(), &result);
+  return result == MPI_IDENT || result == MPI_CONGRUENT;
+#else
+  return true;
+#endif
+}
+
+
+template<typename DataType>
+void SharedMemory<DataType>::sync() const {
+#ifdef HAVE_MPI_H
+  MPI_Win_sync(win_);
+  MPI_Barrier(comm_);
+  MPI_Win_sync(win_);
+#endif
+}
+
+
+template class SharedMemory<double>;
+template class SharedMemory<complex<double>>;
+
+
+SharedMatrix::SharedMatrix(const Matrix& o, shared_ptr<SharedMemory<double>> memory) : Matrix(o.ndim(), o.mdim(), memory->data(), true), memory_(memory) {
+  if (memory_->node_rank() == 0)
+    copy_n(o.data(), o.size(), data());
+  memory_->sync();
+}
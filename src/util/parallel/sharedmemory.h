@@ -0,0 +1,96 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: sharedmemory.h
+// Copyright (C) 2018 Shiozaki group
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __SRC_PARALLEL_SHAREDMEMORY_H
+#define __SRC_PARALLEL_SHAREDMEMORY_H
+
+#include <bagel_config.h>
+#include <complex>
+#include <memory>
+#ifdef HAVE_MPI_H
+ #include <mpi.h>
+#endif
+#include <src/util/math/matrix.h>
+
+namespace bagel {
+
+// Buffer that is shared by all the processes on a node (MPI-3 shared-memory window on mpi__->node_comm()).
+// The memory is physically allocated once per node by the node leader. Construction and destruction are collective within a node.
+// The window keeps a copy of the node communicator it was created on, since mpi__->split() and merge() replace that of mpi__;
+// its destruction is collective over the processes that created it.
+template<typename DataType>
+class SharedMemory {
+  protected:
+#ifdef HAVE_MPI_H
+    MPI_Win win_;
+    MPI_Comm comm_;
+#else
+    std::unique_ptr<DataType[]> local_;
+#endif
+    DataType* data_;
+    size_t size_;
+    int node_rank_;
+    int node_size_;
+
+  public:
+    SharedMemory(const size_t size);
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory<DataType>&) = delete;
+    SharedMemory<DataType>& operator=(const SharedMemory<DataType>&) = delete;
+
+    DataType* data() { return data_; }
+    const DataType* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // layout of the node when the buffer was created
+    int node_rank() const { return node_rank_; }
+    int node_size() const { return node_size_; }
+    // true if the node communicator of mpi__ has the same processes as the one the buffer was created on
+    bool current() const;
+
+    // makes local stores visible to the other processes on the node (collective within a node)
+    void sync() const;
+};
+
+extern template class SharedMemory<double>;
+extern template class SharedMemory<std::complex<double>>;
+
+
+// Replicated (localized) matrix whose elements are held once per node in a SharedMemory buffer.
+// It is meant to be read only; construction and destruction are collective within a node.
+class SharedMatrix : public Matrix {
+  protected:
+    std::shared_ptr<SharedMemory<double>> memory_;
+
+    SharedMatrix(const Matrix& o, std::shared_ptr<SharedMemory<double>> memory);
+
+  public:
+    // the node leader copies o into the node-shared buffer
+    SharedMatrix(const Matrix& o) : SharedMatrix(o, std::make_shared<SharedMemory<double>>(o.size())) { }
+};
+
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include <vector>
 #include <cassert>
 #include <src/util/math/algo.h>
+#include <src/util/math/permute.h>
 #include <src/util/f77.h>
 
 #define USE_SPECIALIZATION_SORT_INDICES
@@ -76,23 +77,10 @@ void sort_indices(const T* unsorted, T* sorted, const int b, const int a) { // a
   static_assert(ad != 0 && fd != 0, "sort_indices, prefactor");
   const T afac = static_cast<T>(an) /static_cast<T>(ad);
   const T factor = static_cast<T>(fn) /static_cast<T>(fd);
-  {
-    int id[2];
-    int jd[2] = {b, a};
-    long iall=0;
-    for(int j0=0;j0<(int)a;++j0){
-      id[1]=j0;
-      for(int j1=0;j1<(int)b;++j1,++iall){
-        id[0]=j1;
-        long ib=id[i]+jd[i]*id[j];
-        if (an != 0)
-          sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
-        else
-          sorted[ib]=unsorted[iall]*factor;
-      }
-    }
-    assert(iall == b*a);
-  }
+  if (an != 0)
+    blas::permute<2,true>(unsorted, sorted, {{i, j}}, {{b, a}}, afac, factor);
+  else
+    blas::permute<2,false>(unsorted, sorted, {{i, j}}, {{b, a}}, afac, factor);
 }
 
 #ifdef USE_SPECIALIZATION_SORT_INDICES
@@ -161,24 +149,10 @@ void sort_indices(const T* const unsorted, T* const sorted,
   static_assert(ad != 0 && fd != 0, "sort_indices, prefactor");
   const T afac = static_cast<T>(an) /static_cast<T>(ad);
   const T factor = static_cast<T>(fn) /static_cast<T>(fd);
-  int id[3];
-  int jd[3] = {d, c, b};
-
-  long iall=0;
-  for(int j1=0;j1<b;++j1){
-    id[2]=j1;
-    for(int j2=0;j2<c;++j2){
-      id[1]=j2;
-      for (int j3=0;j3<d;++j3,++iall){
-        id[0]=j3;
-        long ib=id[i]+jd[i]*(id[j]+jd[j]*id[k]);
-        if (an != 0)
-          sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
-        else
-          sorted[ib]=unsorted[iall]*factor;
-      }
-    }
-  }
+  if (an != 0)
+    blas::permute<3,true>(unsorted, sorted, {{i, j, k}}, {{d, c, b}}, afac, factor);
+  else
+    blas::permute<3,false>(unsorted, sorted, {{i, j, k}}, {{d, c, b}}, afac, factor);
 }
 
 #ifdef USE_SPECIALIZATION_SORT_INDICES
@@ -339,27 +313,10 @@ void sort_indices(const T* unsorted, T* sorted,
   static_assert(ad != 0 && fd != 0, "sort_indices, prefactor");
   const T afac = static_cast<T>(an) /static_cast<T>(ad);
   const T factor = static_cast<T>(fn) /static_cast<T>(fd);
-  int id[4];
-  int jd[4] = {d, c, b, a};
-
-  long iall=0;
-  for(int j0=0;j0<a;++j0){
-    id[3]=j0;
-    for(int j1=0;j1<b;++j1){
-      id[2]=j1;
-      for(int j2=0;j2<c;++j2){
-        id[1]=j2;
-        for(int j3=0;j3<d;++j3,++iall){
-          id[0]=j3;
-          long ib=id[i]+jd[i]*(id[j]+jd[j]*(id[k]+jd[k]*id[l]));
-          if (an != 0)
-            sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
-          else
-            sorted[ib]=unsorted[iall]*factor;
-        }
-      }
-    }
-  }
+  if (an != 0)
+    blas::permute<4,true>(unsorted, sorted, {{i, j, k, l}}, {{d, c, b, a}}, afac, factor);
+  else
+    blas::permute<4,false>(unsorted, sorted, {{i, j, k, l}}, {{d, c, b, a}}, afac, factor);
 }
 
 #ifdef USE_SPECIALIZATION_SORT_INDICES
@@ -737,30 +694,10 @@ void sort_indices(const T* unsorted, T* sorted,
   static_assert(ad != 0 && fd != 0, "sort_indices, prefactor");
   const T afac = static_cast<T>(an) /static_cast<T>(ad);
   const T factor = static_cast<T>(fn) /static_cast<T>(fd);
-  int id[5];
-  int jd[5] = {e, d, c, b, a};
-
-  long iall=0;
-  for(int j0=0;j0<a;++j0){
-    id[4]=j0;
-    for(int j1=0;j1<b;++j1){
-      id[3]=j1;
-      for(int j2=0;j2<c;++j2){
-        id[2]=j2;
-        for(int j3=0;j3<d;++j3){
-          id[1]=j3;
-          for(int j4=0;j4<e;++j4,++iall){
-            id[0]=j4;
-            long ib=id[i]+jd[i]*(id[j]+jd[j]*(id[k]+jd[k]*(id[l]+jd[l]*id[m])));
-            if (an != 0)
-              sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
-            else
-              sorted[ib]=unsorted[iall]*factor;
-          }
-        }
-      }
-    }
-  }
+  if (an != 0)
+    blas::permute<5,true>(unsorted, sorted, {{i, j, k, l, m}}, {{e, d, c, b, a}}, afac, factor);
+  else
+    blas::permute<5,false>(unsorted, sorted, {{i, j, k, l, m}}, {{e, d, c, b, a}}, afac, factor);
 }
 
 
@@ -777,33 +714,10 @@ void sort_indices(const T* unsorted, T* sorted,
   static_assert(ad != 0 && fd != 0, "sort_indices, prefactor");
   const T afac = static_cast<T>(an) /static_cast<T>(ad);
   const T factor = static_cast<T>(fn) /static_cast<T>(fd);
-  int id[6];
-  int jd[6] = {f, e, d, c, b, a};
-
-  long iall=0;
-  for(int j0=0;j0<a;++j0){
-    id[5]=j0;
-    for(int j1=0;j1<b;++j1){
-      id[4]=j1;
-      for(int j2=0;j2<c;++j2){
-        id[3]=j2;
-        for(int j3=0;j3<d;++j3){
-          id[2]=j3;
-          for(int j4=0;j4<e;++j4){
-            id[1]=j4;
-            for (int j5=0;j5<f;++j5,++iall){
-              id[0]=j5;
-              long ib=id[i]+jd[i]*(id[j]+jd[j]*(id[k]+jd[k]*(id[l]+jd[l]*(id[m]+jd[m]*(id[n])))));
-              if (an != 0)
-                sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
-              else
-                sorted[ib]=unsorted[iall]*factor;
-            }
-          }
-        }
-      }
-    }
-  }
+  if (an != 0)
+    blas::permute<6,true>(unsorted, sorted, {{i, j, k, l, m, n}}, {{f, e, d, c, b, a}}, afac, factor);
+  else
+    blas::permute<6,false>(unsorted, sorted, {{i, j, k, l, m, n}}, {{f, e, d, c, b, a}}, afac, factor);
 }
 
 
@@ -820,36 +734,10 @@ void sort_indices(const T* unsorted, T* sorted,
   static_assert(ad != 0 && fd != 0, "sort_indices, prefactor");
   const T afac = static_cast<T>(an) /static_cast<T>(ad);
   const T factor = static_cast<T>(fn) /static_cast<T>(fd);
-  int id[7];
-  int jd[7] = {g, f, e, d, c, b, a};
-
-  long iall=0;
-  for(int j0=0;j0<a;++j0){
-    id[6]=j0;
-    for(int j1=0;j1<b;++j1){
-      id[5]=j1;
-      for(int j2=0;j2<c;++j2){
-        id[4]=j2;
-        for(int j3=0;j3<d;++j3){
-          id[3]=j3;
-          for(int j4=0;j4<e;++j4){
-            id[2]=j4;
-            for(int j5=0;j5<f;++j5){
-              id[1]=j5;
-              for (int j6=0;j6<g;++j6,++iall){
-                id[0]=j6;
-                long ib=id[i]+jd[i]*(id[j]+jd[j]*(id[k]+jd[k]*(id[l]+jd[l]*(id[m]+jd[m]*(id[n]+jd[n]*(id[o]))))));
-                if (an != 0)
-                  sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
-                else
-                  sorted[ib]=unsorted[iall]*factor;
-              }
-            }
-          }
-        }
-      }
-    }
-  }
+  if (an != 0)
+    blas::permute<7,true>(unsorted, sorted, {{i, j, k, l, m, n, o}}, {{g, f, e, d, c, b, a}}, afac, factor);
+  else
+    blas::permute<7,false>(unsorted, sorted, {{i, j, k, l, m, n, o}}, {{g, f, e, d, c, b, a}}, afac, factor);
 }
 
 #ifdef USE_SPECIALIZATION_SORT_INDICES
@@ -929,39 +817,10 @@ void sort_indices(const T* unsorted, T* sorted,
   static_assert(ad != 0 && fd != 0, "sort_indices, prefactor");
   const T afac = static_cast<T>(an) /static_cast<T>(ad);
   const T factor = static_cast<T>(fn) /static_cast<T>(fd);
-  int id[8];
-  int jd[8] = {h, g, f, e, d, c, b, a};
-
-  long iall=0;
-  for(int j0=0;j0<a;++j0){
-    id[7]=j0;
-    for(int j1=0;j1<b;++j1){
-      id[6]=j1;
-      for(int j2=0;j2<c;++j2){
-        id[5]=j2;
-        for(int j3=0;j3<d;++j3){
-          id[4]=j3;
-          for(int j4=0;j4<e;++j4){
-            id[3]=j4;
-            for (int j5=0;j5<f;++j5){
-              id[2]=j5;
-              for (int j6=0;j6<g;++j6){
-                id[1]=j6;
-                for (int j7=0;j7<h;++j7,++iall){
-                  id[0]=j7;
-                  long ib=id[i]+jd[i]*(id[j]+jd[j]*(id[k]+jd[k]*(id[l]+jd[l]*(id[m]+jd[m]*(id[n]+jd[n]*(id[o]+jd[o]*(id[p])))))));
-                  if (an != 0)
-                    sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
-                  else
-                    sorted[ib]=unsorted[iall]*factor;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-  }
+  if (an != 0)
+    blas::permute<8,true>(unsorted, sorted, {{i, j, k, l, m, n, o, p}}, {{h, g, f, e, d, c, b, a}}, afac, factor);
+  else
+    blas::permute<8,false>(unsorted, sorted, {{i, j, k, l, m, n, o, p}}, {{h, g, f, e, d, c, b, a}}, afac, factor);
 }
 
 #ifdef USE_SPECIALIZATION_SORT_INDICES
@@ -1011,42 +870,10 @@ void sort_indices(const T* unsorted, T* sorted,
   static_assert(ad != 0 && fd != 0, "sort_indices, prefactor");
   const T afac = static_cast<T>(an) /static_cast<T>(ad);
   const T factor = static_cast<T>(fn) /static_cast<T>(fd);
-  int id[9];
-  int jd[9] = {ia, h, g, f, e, d, c, b, a};
-
-  long iall=0;
-  for(int j0=0;j0<a;++j0){
-    id[8]=j0;
-    for(int j1=0;j1<b;++j1){
-      id[7]=j1;
-      for(int j2=0;j2<c;++j2){
-        id[6]=j2;
-        for(int j3=0;j3<d;++j3){
-          id[5]=j3;
-          for(int j4=0;j4<e;++j4){
-            id[4]=j4;
-            for(int j5=0;j5<f;++j5){
-              id[3]=j5;
-              for (int j6=0;j6<g;++j6){
-                id[2]=j6;
-                for (int j7=0;j7<h;++j7){
-                  id[1]=j7;
-                  for (int j8=0;j8<ia;++j8,++iall){
-                    id[0]=j8;
-                    long ib=id[i]+jd[i]*(id[j]+jd[j]*(id[k]+jd[k]*(id[l]+jd[l]*(id[m]+jd[m]*(id[n]+jd[n]*(id[o]+jd[o]*(id[p]+jd[p]*(id[q]))))))));
-                    if (an != 0)
-                      sorted[ib]=afac*sorted[ib]+unsorted[iall]*factor;
-                    else
-                      sorted[ib]=unsorted[iall]*factor;
-                  }
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-  }
+  if (an != 0)
+    blas::permute<9,true>(unsorted, sorted, {{i, j, k, l, m, n, o, p, q}}, {{ia, h, g, f, e, d, c, b, a}}, afac, factor);
+  else
+    blas::permute<9,false>(unsorted, sorted, {{i, j, k, l, m, n, o, p, q}}, {{ia, h, g, f, e, d, c, b, a}}, afac, factor);
 }
 
 template<int i, int j, int k, int l, int m, int n, int o, int p, int q, int an, int ad, int fn, int fd, class T>
@@ -41,6 +41,7 @@
   #include "mkl_service.h"
 #endif
 #include <src/util/parallel/resources.h>
+#include <src/util/parallel/profiler.h>
 
 namespace bagel {
 
@@ -77,8 +78,11 @@ class TaskQueue {
     template<typename ...args>
     void emplace_back(args&&... a) { task_.emplace_back(std::forward<args>(a)...); }
 
+    // the busy time of each thread is profiled as "worker" below the queue, which shows the load imbalance
     void compute(const int num_threads = resources__->max_num_threads()) {
       if (task_.empty()) return;
+      ProfileRegion region("TaskQueue");
+      const std::string parent = Profiler::current();
 #ifdef HAVE_MKL_H
       const int mkl_num = mkl_get_max_threads();
       mkl_set_num_threads(1);
@@ -88,20 +92,25 @@ class TaskQueue {
       std::for_each(flag_.begin(), flag_.end(), [](std::atomic_flag& i){ i.clear(); });
       std::list<std::thread> threads;
       for (int i = 0; i != num_threads; ++i)
-        threads.emplace_back(&TaskQueue<T>::compute_one_thread, this);
+        threads.emplace_back(&TaskQueue<T>::compute_one_thread, this, parent);
       std::for_each(threads.begin(), threads.end(), [](std::thread& i){ i.join(); });
 #else
       const size_t n = task_.size();
-      #pragma omp parallel for schedule(dynamic,chunck_)
-      for (size_t i = 0; i < n; ++i)
-        call_compute(task_[i]);
+      #pragma omp parallel
+      {
+        ProfileRegion worker("worker", parent);
+        #pragma omp for schedule(dynamic,chunck_) nowait
+        for (size_t i = 0; i < n; ++i)
+          call_compute(task_[i]);
+      }
 #endif
 #ifdef HAVE_MKL_H
       mkl_set_num_threads(mkl_num);
 #endif
     }
 
-    void compute_one_thread() {
+    void compute_one_thread(const std::string parent = std::string()) {
+      ProfileRegion worker("worker", parent);
       int j = 0;
       for (auto i = flag_.begin(); i != flag_.end(); ++i, j += chunck_)
         if (!i->test_and_set()) {
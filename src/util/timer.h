@@ -31,6 +31,7 @@
 #include <string>
 #include <algorithm>
 #include <src/util/string.h>
+#include <src/util/parallel/profiler.h>
 #include <bagel_config.h>
 
 namespace bagel {
@@ -51,19 +52,28 @@ class Timer {
       return out;
     }
 
-    // print out timing
+    // print out timing. Every interval is also recorded in the profile (see Profiler), including those that are not
+    // printed; level -1 is not, as it is used for input blocks that are profiled as regions in main.cc.
     void tick_print(std::string title) {
+      print(title, tick());
+    }
+
+    // the same for an interval that has been measured elsewhere (e.g., summed over threads)
+    void print(std::string title, const double time) const {
+      if (level_ != -1)
+        Profiler::add(title, time);
+
       if (level_ == 0) {
         // top level printout
-        std::cout << "       - " << std::left << std::setw(36) << title << std::right << std::setw(10) << std::fixed << std::setprecision(2) << tick() << std::endl;
+        std::cout << "       - " << std::left << std::setw(36) << title << std::right << std::setw(10) << std::fixed << std::setprecision(2) << time << std::endl;
       } else if (level_ == -1) {
         title = to_upper(title);
-        std::cout << "    * " << std::left << std::setw(39) << title << std::right << std::setw(10) << std::fixed << std::setprecision(2) << tick() << std::endl;
+        std::cout << "    * " << std::left << std::setw(39) << title << std::right << std::setw(10) << std::fixed << std::setprecision(2) << time << std::endl;
 #ifdef HAVE_MPI_H
-      } else if (level_ >= 1 && level_ < 3) { // TODO for the time being suppressing the level 3 output
+      } else if (level_ >= 1 && level_ < 3) { // level 3 is only recorded in the profile
         const std::string indent(13+2*level_, ' ');
         const std::string mark = (level_ == 1 ? "o" : (level_ == 2 ? "*" : "-"));
-        std::cout << indent << std::left << mark << " " << std::setw(35) << title << std::right << std::setw(13) << std::fixed << std::setprecision(2) << tick() << std::endl;
+        std::cout << indent << std::left << mark << " " << std::setw(35) << title << std::right << std::setw(13) << std::fixed << std::setprecision(2) << time << std::endl;
 #endif
       }
     }
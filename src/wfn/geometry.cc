@@ -98,14 +98,12 @@ Geometry::Geometry(shared_ptr<const PTree> geominfo) : magnetism_(false), do_per
     hcoreinfo_ = make_shared<const HcoreInfo>(geominfo);
   } else {
 
-    // read the default basis file
-    shared_ptr<const PTree> bdata = PTree::read_basis(basisfile_);
     shared_ptr<const PTree> elem = geominfo->get_child_optional("_basis");
 
     auto atoms = geominfo->get_child("geometry");
     hcoreinfo_ = make_shared<const HcoreInfo>(geominfo);
     for (auto& a : *atoms)
-      atoms_.push_back(make_shared<const Atom>(a, spherical_, angstrom, make_pair(basisfile_, bdata), elem, false, hcoreinfo_->ecp(), use_finite_));
+      atoms_.push_back(make_shared<const Atom>(a, spherical_, angstrom, make_pair(basisfile_, nullptr), elem, false, hcoreinfo_->ecp(), use_finite_));
   }
   if (atoms_.empty()) throw runtime_error("No atoms specified at all");
 
@@ -113,13 +111,11 @@ Geometry::Geometry(shared_ptr<const PTree> geominfo) : magnetism_(false), do_per
   auxfile_ = geominfo->get<string>("df_basis", "");  // default value for non-DF HF.
   if (!auxfile_.empty()) {
     if (!primitive_vectors_.empty()) do_periodic_df_ = true;
-    // read the default aux basis file
-    shared_ptr<const PTree> bdata = PTree::read_basis(auxfile_);
     shared_ptr<const PTree> elem = geominfo->get_child_optional("_df_basis");
     if (basisfile_ == "molden") {
       for(auto& iatom : atoms_) {
         if (!iatom->dummy()) {
-          aux_atoms_.push_back(make_shared<const Atom>(spherical_, iatom->name(), iatom->position(), auxfile_, make_pair(auxfile_, bdata), elem));
+          aux_atoms_.push_back(make_shared<const Atom>(spherical_, iatom->name(), iatom->position(), auxfile_, make_pair(auxfile_, nullptr), elem));
         } else {
           // we need a dummy atom here to be consistent in gradient computations
           aux_atoms_.push_back(iatom);
@@ -128,7 +124,7 @@ Geometry::Geometry(shared_ptr<const PTree> geominfo) : magnetism_(false), do_per
     } else {
       auto atoms = geominfo->get_child("geometry");
       for (auto& a : *atoms)
-        aux_atoms_.push_back(make_shared<const Atom>(a, spherical_, angstrom, make_pair(auxfile_, bdata), elem, true));
+        aux_atoms_.push_back(make_shared<const Atom>(a, spherical_, angstrom, make_pair(auxfile_, nullptr), elem, true));
     }
   }
 
@@ -139,6 +135,8 @@ Geometry::Geometry(shared_ptr<const PTree> geominfo) : magnetism_(false), do_per
 
   print_atoms();
 
+  set_symmetry(to_lower(geominfo->get<string>("symmetry", "c1")));
+
   common_init2(true, overlap_thresh_);
   get_electric_field(geominfo);
 
@@ -149,7 +147,7 @@ Geometry::Geometry(shared_ptr<const PTree> geominfo) : magnetism_(false), do_per
 }
 
 
-void Geometry::common_init2(const bool print, const double thresh, const bool nodf) {
+void Geometry::common_init2(const bool print, const double thresh, const bool nodf, shared_ptr<const DFLayout> layout) {
 
   if (london_ || nonzero_magnetic_field()) init_magnetism();
 
@@ -160,7 +158,7 @@ void Geometry::common_init2(const bool print, const double thresh, const bool no
     cout << "    o Being stored without compression. Storage requirement is "
          << setprecision(3) << static_cast<size_t>(naux_)*nbasis()*nbasis()*scale*8.e-9 << " GB" << endl;
     Timer timer;
-    compute_integrals(thresh);
+    compute_integrals(thresh, layout);
     cout << "        elapsed time:  " << setw(10) << setprecision(2) << timer.tick() << " sec." << endl << endl;
   }
 
@@ -181,7 +179,26 @@ Geometry::Geometry(const Geometry& o, shared_ptr<const Matrix> displ, shared_ptr
 
   overlap_thresh_ = geominfo->get<double>("thresh_overlap", 1.0e-8);
   set_london(geominfo);
-  common_init2(false, overlap_thresh_, nodf);
+  // symmetry is kept if the displacement preserves it
+  if (o.plist_)
+    set_symmetry(o.plist_->sym(), false);
+
+  // When no interatomic distance changes by more than reuse_thresh, the screening of the shell pairs and the layout of the
+  // 3-index integrals are taken from o; only the integrals themselves are recomputed.
+  shared_ptr<const DFLayout> layout;
+  const double reuse_thresh = geominfo->get<double>("reuse_thresh", 0.0);
+  if (reuse_thresh > 0.0 && !london_ && !o.magnetism()) {
+    double change = 0.0;
+    for (int i = 0; i != natom(); ++i)
+      for (int j = 0; j != i; ++j)
+        change = max(change, fabs(atoms_[i]->distance(atoms_[j]) - o.atoms_[i]->distance(o.atoms_[j])));
+    if (change < reuse_thresh) {
+      shellpairs_ = make_shared<const ShellPairList>(atoms_, *o.shellpairs());
+      if (o.df_ && !plist_)
+        layout = o.df_->layout();
+    }
+  }
+  common_init2(false, overlap_thresh_, nodf, layout);
   if (o.magnetism())
     throw logic_error("Geometry optimization in a magnetic field has not been set up or verified; use caution.");
 }
@@ -262,36 +279,41 @@ Geometry::Geometry(const Geometry& o, shared_ptr<const PTree> geominfo, const bo
   // if so, construct atoms
   if (prevbasis != basisfile_ || atoms || newfield) {
     atoms_.clear();
-    shared_ptr<const PTree> bdata = PTree::read_basis(basisfile_);
     shared_ptr<const PTree> elem = geominfo->get_child_optional("_basis");
     hcoreinfo_ = make_shared<const HcoreInfo>(geominfo);
     if (atoms) {
       const bool angstrom = geominfo->get<bool>("angstrom", false);
       for (auto& a : *atoms)
-        atoms_.push_back(make_shared<const Atom>(a, spherical_, angstrom, make_pair(basisfile_, bdata), elem, false, hcoreinfo_->ecp(), use_finite_));
+        atoms_.push_back(make_shared<const Atom>(a, spherical_, angstrom, make_pair(basisfile_, nullptr), elem, false, hcoreinfo_->ecp(), use_finite_));
     } else {
       for (auto& a : o.atoms_)
-        atoms_.push_back(make_shared<const Atom>(*a, spherical_, basisfile_, make_pair(basisfile_, bdata), elem));
+        atoms_.push_back(make_shared<const Atom>(*a, spherical_, basisfile_, make_pair(basisfile_, nullptr), elem));
     }
   }
   const string prevaux = auxfile_;
   auxfile_ = geominfo->get<string>("df_basis", auxfile_);
   if (!auxfile_.empty() && (prevaux != auxfile_ || atoms)) {
     aux_atoms_.clear();
-    shared_ptr<const PTree> bdata = PTree::read_basis(auxfile_);
     shared_ptr<const PTree> elem = geominfo->get_child_optional("_df_basis");
     if (atoms) {
       const bool angstrom = geominfo->get<bool>("angstrom", false);
       for (auto& a : *atoms)
-        aux_atoms_.push_back(make_shared<const Atom>(a, spherical_, angstrom, make_pair(auxfile_, bdata), elem));
+        aux_atoms_.push_back(make_shared<const Atom>(a, spherical_, angstrom, make_pair(auxfile_, nullptr), elem));
     } else {
       for (auto& a : o.atoms_)
-        aux_atoms_.push_back(make_shared<const Atom>(*a, spherical_, auxfile_, make_pair(auxfile_, bdata), elem));
+        aux_atoms_.push_back(make_shared<const Atom>(*a, spherical_, auxfile_, make_pair(auxfile_, nullptr), elem));
     }
   }
 
   common_init1();
 
+  const string prevsym = o.plist_ ? o.plist_->sym() : "c1";
+  const string sym = to_lower(geominfo->get<string>("symmetry", prevsym));
+  if (o.basisfile_ != basisfile_ || o.auxfile_ != auxfile_ || atoms || sym != prevsym)
+    set_symmetry(sym);
+  else
+    plist_ = o.plist_;
+
   if (o.basisfile_ != basisfile_ || o.auxfile_ != auxfile_ || atoms || newfield) {
     // discard the previous one before we compute the new one. Note that df_'s are mutable... too bad, I know..
     if (discard)
@@ -396,16 +418,14 @@ Geometry::Geometry(const vector<shared_ptr<const Atom>> atoms, shared_ptr<const
   // basis
   auxfile_ = geominfo->get<string>("df_basis", "");
   if (!auxfile_.empty()) {
-    // read the default basis file
-    shared_ptr<const PTree> bdata = PTree::read_basis(auxfile_);
     shared_ptr<const PTree> elem = geominfo->get_child_optional("_df_basis");
     if (atomlist) {
       for (auto& i : *atomlist)
-        aux_atoms_.push_back(make_shared<const Atom>(i, spherical_, angstrom, make_pair(auxfile_, bdata), elem, true));
+        aux_atoms_.push_back(make_shared<const Atom>(i, spherical_, angstrom, make_pair(auxfile_, nullptr), elem, true));
     } else {
       // in the molden case
       for (auto& i : atoms_)
-        aux_atoms_.push_back(make_shared<const Atom>(i->spherical(), i->name(), i->position(), auxfile_, make_pair(auxfile_, bdata), elem));
+        aux_atoms_.push_back(make_shared<const Atom>(i->spherical(), i->name(), i->position(), auxfile_, make_pair(auxfile_, nullptr), elem));
     }
   }
 
@@ -523,9 +543,8 @@ shared_ptr<const Geometry> Geometry::periodic(vector<shared_ptr<const Atom>> ato
 
   vector<shared_ptr<const Atom>> aux_atoms;
   if (!auxfile_.empty()) {
-    shared_ptr<const PTree> bdata = PTree::read_basis(auxfile_);
     for (auto& a : atoms)
-      aux_atoms.push_back(make_shared<const Atom>(*a, spherical_, auxfile_, make_pair(auxfile_, bdata), nullptr));
+      aux_atoms.push_back(make_shared<const Atom>(*a, spherical_, auxfile_, make_pair(auxfile_, nullptr), nullptr));
   }
   out->atoms_ = atoms;
   out->aux_atoms_ = aux_atoms;
@@ -596,19 +615,42 @@ void Geometry::set_london(shared_ptr<const PTree>& geominfo) {
 }
 
 
-void Geometry::compute_integrals(const double thresh) const {
+void Geometry::compute_integrals(const double thresh, shared_ptr<const DFLayout> layout) const {
+  // symmetry-unique 3-index integrals are computed when symmetry is used
+  const shared_ptr<const Petite> plist = nirrep() > 1 ? plist_ : nullptr;
 #ifdef LIBINT_INTERFACE
   if (!magnetism_)
-    df_ = form_fit<DFDist_ints<Libint>>(thresh, true); // true means we construct J^-1/2
+    df_ = make_shared<DFDist_ints<Libint>>(nbasis(), naux(), atoms(), aux_atoms(), thresh, true, 0.0, false, nullptr, false, plist, layout, shellpairs()); // true means we construct J^-1/2
 #else
   if (!magnetism_)
-    df_ = form_fit<DFDist_ints<ERIBatch>>(thresh, true); // true means we construct J^-1/2
+    df_ = make_shared<DFDist_ints<ERIBatch>>(nbasis(), naux(), atoms(), aux_atoms(), thresh, true, 0.0, false, nullptr, false, plist, layout, shellpairs()); // true means we construct J^-1/2
 #endif
   else
     df_ = form_fit<ComplexDFDist_ints<ComplexERIBatch>>(thresh, true); // true means we construct J^-1/2
 }
 
 
+void Geometry::set_symmetry(const string sym, const bool strict) {
+  plist_.reset();
+  if (sym == "c1")
+    return;
+  try {
+    auto plist = make_shared<const Petite>(atoms_, sym);
+    // auxiliary basis functions are placed on the same atoms
+    if (!aux_atoms_.empty()) {
+      if (aux_atoms_.size() != atoms_.size())
+        throw runtime_error("The auxiliary basis set is not compatible with symmetry");
+      plist->shellmap(aux_atoms_);
+    }
+    plist_ = plist;
+    cout << "  Point group " << sym << " (" << plist_->nirrep() << " irreducible representations) is used" << endl << endl;
+  } catch (const runtime_error& e) {
+    if (strict) throw;
+    cout << "  " << e.what() << "; point-group symmetry is not used" << endl << endl;
+  }
+}
+
+
 void Geometry::init_magnetism() {
   magnetism_ = true;
 
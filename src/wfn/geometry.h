@@ -29,6 +29,7 @@
 #include <src/df/df.h>
 #include <src/util/input/input.h>
 #include <src/molecule/molecule.h>
+#include <src/molecule/petite.h>
 #include <src/wfn/hcoreinfo.h>
 #include <src/wfn/fmminfo.h>
 
@@ -48,8 +49,8 @@ class Geometry : public Molecule {
     mutable std::shared_ptr<DFDist> dfsl_;
 
     // Constructor helpers
-    void common_init2(const bool print, const double thresh, const bool nodf = false);
-    void compute_integrals(const double thresh) const;
+    void common_init2(const bool print, const double thresh, const bool nodf = false, std::shared_ptr<const DFLayout> layout = nullptr);
+    void compute_integrals(const double thresh, std::shared_ptr<const DFLayout> layout = nullptr) const;
     void get_electric_field(std::shared_ptr<const PTree>& geominfo);
     void set_london(std::shared_ptr<const PTree>& geominfo);
     void init_magnetism();
@@ -69,6 +70,11 @@ class Geometry : public Molecule {
     // FMM
     std::shared_ptr<const FMMInfo> fmm_;
 
+    // point-group symmetry (D2h and its subgroups); nullptr if C1
+    std::shared_ptr<const Petite> plist_;
+    // if strict is false, falls back to C1 when the molecule does not have the symmetry
+    void set_symmetry(const std::string sym, const bool strict = true);
+
   private:
     // serialization
     friend class boost::serialization::access;
@@ -76,7 +82,7 @@ class Geometry : public Molecule {
     template<class Archive>
     void save(Archive& ar, const unsigned int) const {
       ar << boost::serialization::base_object<Molecule>(*this);
-      ar << schwarz_thresh_ << overlap_thresh_ << magnetism_ << london_ << use_finite_ << do_periodic_df_ << hcoreinfo_ << fmm_;
+      ar << schwarz_thresh_ << overlap_thresh_ << magnetism_ << london_ << use_finite_ << do_periodic_df_ << hcoreinfo_ << fmm_ << plist_;
       const size_t dfindex = !df_ ? 0 : std::hash<DFDist*>()(df_.get());
       ar << dfindex;
       const bool do_rel   = !!dfs_;
@@ -85,9 +91,14 @@ class Geometry : public Molecule {
     }
 
     template<class Archive>
-    void load(Archive& ar, const unsigned int) {
+    void load(Archive& ar, const unsigned int version) {
       ar >> boost::serialization::base_object<Molecule>(*this);
       ar >> schwarz_thresh_ >> overlap_thresh_ >> magnetism_ >> london_ >> use_finite_ >> do_periodic_df_ >> hcoreinfo_ >> fmm_;
+      // archives of version 0 were written without point-group symmetry
+      if (version > 0)
+        ar >> plist_;
+      else
+        set_symmetry("c1");
       size_t dfindex;
       ar >> dfindex;
       static std::map<size_t, std::weak_ptr<DFDist>> dfmap;
@@ -163,11 +174,16 @@ class Geometry : public Molecule {
 
     // FMM
     std::shared_ptr<const FMMInfo> fmm() const { return fmm_; }
+
+    // Symmetry
+    std::shared_ptr<const Petite> plist() const { return plist_; }
+    int nirrep() const { return plist_ ? plist_->nirrep() : 1; }
 };
 
 }
 
 #include <src/util/archive.h>
 BOOST_CLASS_EXPORT_KEY(bagel::Geometry)
+BOOST_CLASS_VERSION(bagel::Geometry, 1)
 
 #endif
@@ -31,6 +31,7 @@
 #include <src/ci/fci/harrison.h>
 #include <src/ci/fci/knowles.h>
 #include <src/ci/ras/rasci.h>
+#include <src/ci/ras/distrasci.h>
 #include <src/ci/zfci/relfci.h>
 #include <src/ci/zfci/fci_london.h>
 #include <src/response/cis.h>
@@ -92,8 +93,7 @@ get_energy(const string title, shared_ptr<const PTree> itree, shared_ptr<const G
       const string algorithm = itree->get<string>("algorithm", "");
       if ( algorithm == "local" || algorithm == "" ) { auto m = make_shared<RASCI>(itree, geom, ref); m->compute(); out = m->energy(target); ref = m->conv_to_ref(); }
 #ifdef HAVE_MPI_H
-      else if ( algorithm == "dist" || algorithm == "parallel" )
-        throw logic_error("Parallel RASCI not implemented");
+      else if ( algorithm == "dist" || algorithm == "parallel" ) { auto m = make_shared<DistRASCI>(itree, geom, ref); m->compute(); out = m->energy(target); ref = m->conv_to_ref(); }
 #endif
       else
         throw runtime_error("unknown RASCI algorithm specified. " + algorithm);
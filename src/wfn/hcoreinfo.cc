@@ -23,6 +23,8 @@
 //
 
 
+#include <iomanip>
+#include <sstream>
 #include <src/mat1e/hcore.h>
 #include <src/mat1e/dkhcore.h>
 #include <src/wfn/hcoreinfo.h>
@@ -32,6 +34,11 @@ using namespace bagel;
 
 
 HcoreInfo::HcoreInfo(shared_ptr<const PTree> idata) : type_(HcoreType::standard) {
+  // point charges far from a shell pair may be included through multipoles (zero means exact)
+  charge_thresh_ = idata->get<double>("charge_thresh", 0.0);
+  if (charge_thresh_ < 0.0)
+    throw runtime_error("charge_thresh should not be negative");
+
   // DKH
   const bool dkh = idata->get<bool>("dkh", false);
   if (dkh)
@@ -68,4 +75,8 @@ shared_ptr<Matrix> HcoreInfo::compute(shared_ptr<const Molecule> current) const
 void HcoreInfo::print() const {
   if (dkh())
     cout << "      - Using DKHcore" << endl;
+  if (charge_thresh_ > 0.0) {
+    stringstream ss; ss << setprecision(1) << scientific << charge_thresh_;
+    cout << "      - Point charges through multipoles with a threshold of " << ss.str() << endl;
+  }
 }
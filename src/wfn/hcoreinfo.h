@@ -26,6 +26,7 @@
 #ifndef __SRC_WFN_HCOREINFO_H
 #define __SRC_WFN_HCOREINFO_H
 
+#include <boost/serialization/version.hpp>
 #include <src/molecule/molecule.h>
 
 // Contains info on Hcore.
@@ -42,23 +43,30 @@ enum HcoreType { standard, dkh, ecp };
 class HcoreInfo {
   protected:
     HcoreType type_;
+    // error allowed in the multipole treatment of the external point charges; they are computed exactly if zero
+    double charge_thresh_;
 
   private:
     // serialization
     friend class boost::serialization::access;
 
     template<class Archive>
-    void serialize(Archive& ar, const unsigned int) {
+    void serialize(Archive& ar, const unsigned int version) {
       ar & type_;
+      if (version > 0)
+        ar & charge_thresh_;
+      else
+        charge_thresh_ = 0.0;
     }
 
   public:
-    HcoreInfo() : type_(HcoreType::standard) { }
+    HcoreInfo() : type_(HcoreType::standard), charge_thresh_(0.0) { }
     HcoreInfo(std::shared_ptr<const PTree> idata);
 
     bool dkh() const { return type_ == HcoreType::dkh; }
     bool ecp() const { return type_ == HcoreType::ecp; }
     bool standard() const { return type_ == HcoreType::standard; }
+    double charge_thresh() const { return charge_thresh_; }
     void print() const;
 
     // DKH specific
@@ -70,4 +78,6 @@ class HcoreInfo {
 
 }
 
+BOOST_CLASS_VERSION(bagel::HcoreInfo, 1)
+
 #endif
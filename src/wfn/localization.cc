@@ -23,6 +23,7 @@
 //
 
 #include <algorithm>
+#include <list>
 #include <src/mat1e/overlap.h>
 #include <src/util/math/jacobi.h>
 #include <src/wfn/localization.h>
@@ -246,8 +247,12 @@ void PMLocalization::common_init(vector<int> sizes) {
   max_iter_ = input_->get<int>("max_iter", 50);
   thresh_ = input_->get<double>("thresh", 1.0e-6);
   lowdin_ = input_->get<bool>("lowdin", true);
+  optimizer_ = to_lower(input_->get<string>("optimizer", "jacobi"));
+  if (optimizer_ != "jacobi" && optimizer_ != "qn")
+    throw runtime_error("Unrecognized optimizer for PM localization: \"" + optimizer_ + "\"");
 
-  cout << endl << "  Localization threshold: " << setprecision(2) << setw(6) << scientific << thresh_ << endl << endl;
+  cout << endl << "  Localization threshold: " << setprecision(2) << setw(6) << scientific << thresh_ << endl;
+  cout << "  Optimizer:              " << (optimizer_ == "qn" ? "quasi-Newton" : "Jacobi sweeps") << endl << endl;
 
   S_ = make_shared<Overlap>(geom_);
   if (lowdin_) S_->sqrt();
@@ -291,6 +296,10 @@ void PMLocalization::common_init(vector<int> sizes) {
 }
 
 shared_ptr<Matrix> PMLocalization::localize_space(shared_ptr<const Matrix> coeff) {
+  return optimizer_ == "qn" ? localize_space_qn(coeff) : localize_space_jacobi(coeff);
+}
+
+shared_ptr<Matrix> PMLocalization::localize_space_jacobi(shared_ptr<const Matrix> coeff) {
   Timer pmtime;
   auto out = make_shared<Matrix>(*coeff);
   const int norb = out->mdim();
@@ -324,6 +333,98 @@ shared_ptr<Matrix> PMLocalization::localize_space(shared_ptr<const Matrix> coeff
   return out;
 }
 
+shared_ptr<Matrix> PMLocalization::localize_space_qn(shared_ptr<const Matrix> coeff) {
+  Timer pmtime;
+  auto out = make_shared<Matrix>(*coeff);
+  const int norb = out->mdim();
+
+  cout << setw(6) << "iter" << setw(20) << "P_A^2" << setw(27) << "delta P_A^2" << setw(22) << "time" << endl;
+  cout << "----------------------------------------------------------------------------------------------" << endl;
+
+  double L;
+  shared_ptr<Matrix> grad, hess;
+  tie(L, grad, hess) = calc_gradient(out);
+  double P = std::sqrt(L/norb);
+  cout << setw(5) << 0 << fixed << setw(24) << setprecision(10) << P << endl;
+
+  // limited-memory BFGS on -L, with the diagonal Hessian as the initial guess; steps are bounded by a trust radius
+  const int maxhist = 10;
+  double radius = 0.3;
+  list<pair<shared_ptr<const Matrix>, shared_ptr<const Matrix>>> history;
+
+  for (int iter = 0; iter < max_iter_; ++iter) {
+    auto denom = hess->copy();
+    for (auto& i : *denom) i = max(fabs(i), 1.0e-4);
+
+    auto step = make_shared<Matrix>(*grad);
+    vector<double> alpha;
+    for (auto i = history.rbegin(); i != history.rend(); ++i) {
+      alpha.push_back(i->first->dot_product(*step) / i->second->dot_product(*i->first));
+      step->ax_plus_y(-alpha.back(), *i->second);
+    }
+    *step /= *denom;
+    for (auto i = history.begin(); i != history.end(); ++i) {
+      const double beta = i->second->dot_product(*step) / i->second->dot_product(*i->first);
+      step->ax_plus_y(alpha[history.size()-1-distance(history.begin(), i)] - beta, *i->first);
+    }
+
+    double tmp_L = L;
+    shared_ptr<Matrix> tmp_grad, tmp_hess, expa;
+    bool accepted = false;
+    while (true) {
+      const double maxrot = *max_element(step->begin(), step->end(), [](const double a, const double b) { return fabs(a) < fabs(b); });
+      if (fabs(maxrot) > radius)
+        *step *= radius/fabs(maxrot);
+
+      // exp(step) by scaling and squaring
+      int nsquare = 0;
+      for (double norm = step->norm(); norm > 0.5; norm *= 0.5) ++nsquare;
+      expa = (*step * std::pow(0.5, nsquare)).exp(6);
+      for (int i = 0; i != nsquare; ++i)
+        *expa = *expa * *expa;
+      expa->purify_unitary();
+
+      tie(tmp_L, tmp_grad, tmp_hess) = calc_gradient(make_shared<Matrix>(*out * *expa));
+      accepted = tmp_L > L - numerical_zero__;
+      if (accepted || radius < 1.0e-6) break;
+      // rejected; shrink the trust radius and restart the quasi-Newton history
+      radius *= 0.5;
+      history.clear();
+      *step = *grad / *denom;
+    }
+    // no step within the smallest trust radius increases P_A^2; the orbitals are left as they are
+    if (!accepted) {
+      cout << "No further improvement within the trust radius. Stopping." << endl;
+      break;
+    }
+    radius = min(1.5*radius, 0.5);
+
+    auto y = make_shared<Matrix>(*grad - *tmp_grad);
+    if (y->dot_product(*step) > numerical_zero__) {
+      history.emplace_back(step, y);
+      if (history.size() > maxhist) history.pop_front();
+    }
+
+    *out *= *expa;
+    tie(L, grad, hess) = make_tuple(tmp_L, tmp_grad, tmp_hess);
+
+    const double tmp_P = std::sqrt(L/norb);
+    const double dP = tmp_P - P;
+    cout << setw(5) << iter+1 << fixed << setw(24) << setprecision(10) << tmp_P
+                              << fixed << setw(24) << setprecision(10) << dP
+                              << fixed << setw(24) << setprecision(6)  << pmtime.tick() << endl;
+    P = tmp_P;
+    if (fabs(dP) < thresh_) {
+      cout << "Converged!" << endl;
+      break;
+    }
+  }
+  cout << endl;
+
+  mpi__->broadcast(out->data(), out->size(), 0);
+  return out;
+}
+
 double PMLocalization::calc_P(shared_ptr<const Matrix> coeff, const int nstart, const int norb) const {
   const int nbasis = coeff->ndim();
 
@@ -332,25 +433,56 @@ double PMLocalization::calc_P(shared_ptr<const Matrix> coeff, const int nstart,
 
   dgemm_("N", "N", nbasis, norb, nbasis, 1.0, S_->data(), nbasis, coeff->element_ptr(0, nstart), nbasis, 0.0, mos->data(), nbasis);
 
-  auto P_A = make_shared<Matrix>(norb, norb);
-
+  // only the diagonal of the population matrices is needed
   for (auto& ibounds : region_bounds_) {
     const int natombasis = ibounds.second - ibounds.first;
 
-    if (lowdin_)
-      dgemm_("T", "N", norb, norb, natombasis, 1.0, mos->element_ptr(ibounds.first, 0), nbasis,
-                              mos->element_ptr(ibounds.first, 0), nbasis, 0.0, P_A->data(), norb);
-    else
-      dgemm_("T", "N", norb, norb, natombasis, 1.0, mos->element_ptr(ibounds.first, 0), nbasis,
-                              coeff->element_ptr(ibounds.first, nstart), nbasis, 0.0, P_A->data(), norb);
-
-    for (int imo = 0; imo < norb; ++imo)
-      out += P_A->element(imo, imo) * P_A->element(imo, imo);
+    for (int imo = 0; imo < norb; ++imo) {
+      const double* left = lowdin_ ? mos->element_ptr(ibounds.first, imo) : coeff->element_ptr(ibounds.first, nstart + imo);
+      const double P_A = ddot_(natombasis, mos->element_ptr(ibounds.first, imo), 1, left, 1);
+      out += P_A * P_A;
+    }
   }
 
   return std::sqrt(out/static_cast<double>(norb));
 }
 
+tuple<double, shared_ptr<Matrix>, shared_ptr<Matrix>> PMLocalization::calc_gradient(shared_ptr<const Matrix> coeff) const {
+  const int nbasis = coeff->ndim();
+  const int norb = coeff->mdim();
+
+  auto mos = make_shared<Matrix>(*S_ * *coeff);
+  shared_ptr<const Matrix> left = lowdin_ ? mos : coeff;
+
+  // for a pair k < l the rotation angle is stored in (l,k), and the matrices are antisymmetric (gradient) or symmetric (Hessian)
+  double value = 0.0;
+  auto grad = make_shared<Matrix>(norb, norb);
+  auto hess = make_shared<Matrix>(norb, norb);
+  Matrix P_A(norb, norb);
+  for (auto& ibounds : region_bounds_) {
+    const int natombasis = ibounds.second - ibounds.first;
+    dgemm_("T", "N", norb, norb, natombasis, 1.0, left->element_ptr(ibounds.first, 0), nbasis,
+                            mos->element_ptr(ibounds.first, 0), nbasis, 0.0, P_A.data(), norb);
+    if (!lowdin_)
+      P_A.symmetrize();
+
+    for (int k = 0; k < norb; ++k) {
+      value += P_A(k,k) * P_A(k,k);
+      for (int l = k+1; l < norb; ++l) {
+        const double Qkminusl_A = P_A(k,k) - P_A(l,l);
+        grad->element(l,k) += 4.0 * P_A(l,k) * Qkminusl_A;
+        hess->element(l,k) += 16.0 * (P_A(l,k) * P_A(l,k) - 0.25 * Qkminusl_A * Qkminusl_A);
+      }
+    }
+  }
+  for (int k = 0; k < norb; ++k)
+    for (int l = k+1; l < norb; ++l) {
+      grad->element(k,l) = -grad->element(l,k);
+      hess->element(k,l) = hess->element(l,k);
+    }
+  return make_tuple(value, grad, hess);
+}
+
 double PMLocalization::metric() const {
   return calc_P(coeff_, 0, geom_->nele()/2);
 }
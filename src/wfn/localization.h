@@ -26,6 +26,7 @@
 #ifndef __BAGEL_WFN_LOCALIZE_H
 #define __BAGEL_WFN_LOCALIZE_H
 
+#include <tuple>
 #include <vector>
 
 #include <src/wfn/reference.h>
@@ -87,8 +88,12 @@ class PMLocalization : public OrbitalLocalization {
     int max_iter_;
     double thresh_;
     bool lowdin_;
+    // "jacobi" sweeps or "qn" (quasi-Newton with a trust radius)
+    std::string optimizer_;
 
     std::shared_ptr<Matrix> localize_space(std::shared_ptr<const Matrix> coeff) override;
+    std::shared_ptr<Matrix> localize_space_jacobi(std::shared_ptr<const Matrix> coeff);
+    std::shared_ptr<Matrix> localize_space_qn(std::shared_ptr<const Matrix> coeff);
 
   public:
     PMLocalization(std::shared_ptr<const PTree> input, std::shared_ptr<const Geometry> geom, std::shared_ptr<const Matrix> coeff,
@@ -99,6 +104,8 @@ class PMLocalization : public OrbitalLocalization {
 
   private:
     double calc_P(std::shared_ptr<const Matrix> coeff, const int nstart, const int norb) const;
+    // sum of squared populations, its gradient and diagonal Hessian with respect to the pair rotations of Matrix::rotate
+    std::tuple<double, std::shared_ptr<Matrix>, std::shared_ptr<Matrix>> calc_gradient(std::shared_ptr<const Matrix> coeff) const;
     void common_init(std::vector<int> sizes);
 };
 